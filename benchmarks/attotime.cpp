@@ -0,0 +1,34 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+#include "benchmark/benchmark_api.h"
+#include "osdcomm.h"
+#include "eminline.h"
+#include "attotime.h"
+
+// the scheduler walks its timer list comparing expiration times, and
+// advances each timer by its period whenever it fires
+static void BM_attotime_compare(benchmark::State& state) {
+	attotime a(0, ATTOSECONDS_IN_USEC(1));
+	attotime b(0, ATTOSECONDS_IN_USEC(2));
+	attotime step(0, 12345);
+	int count = 0;
+	while (state.KeepRunning()) {
+		count += (a < b) ? 1 : 0;
+		a += step;
+		benchmark::DoNotOptimize(count);
+	}
+}
+BENCHMARK(BM_attotime_compare);
+
+static void BM_attotime_add(benchmark::State& state) {
+	attotime now(0, 0);
+	attotime period = attotime::from_nsec(16683333);
+	while (state.KeepRunning()) {
+		now = now + period;
+		if (now.seconds() > 1000)
+			now = attotime(0, 0);
+		benchmark::DoNotOptimize(now);
+	}
+}
+BENCHMARK(BM_attotime_add);
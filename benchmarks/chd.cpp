@@ -0,0 +1,121 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+#include "benchmark/benchmark_api.h"
+#include "osdcore.h"
+#include "chd.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+static const UINT32 BENCH_HUNK_BYTES = 4096;
+static const UINT32 BENCH_HUNK_COUNT = 256;
+static const UINT64 BENCH_LOGICAL_BYTES = UINT64(BENCH_HUNK_BYTES) * BENCH_HUNK_COUNT;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// compressor fed from a synthetic, moderately compressible pattern
+class bench_chd_compressor : public chd_file_compressor
+{
+protected:
+	virtual UINT32 read_data(void *dest, UINT64 offset, UINT32 length) override
+	{
+		fill_pattern((UINT8 *)dest, offset, length);
+		return length;
+	}
+
+public:
+	static void fill_pattern(UINT8 *dest, UINT64 offset, UINT32 length)
+	{
+		for (UINT32 index = 0; index < length; index++)
+		{
+			UINT64 pos = offset + index;
+			dest[index] = ((pos >> 4) & 7) ? UINT8(pos >> 9) : UINT8(pos * 0x9d);
+		}
+	}
+};
+
+
+//-------------------------------------------------
+//  create_bench_chd - build a temporary CHD with
+//  the given compression
+//-------------------------------------------------
+
+static bool create_bench_chd(const char *filename, chd_codec_type codec)
+{
+	chd_codec_type compression[4] = { codec, CHD_CODEC_NONE, CHD_CODEC_NONE, CHD_CODEC_NONE };
+
+	// uncompressed CHDs are written directly a hunk at a time
+	if (codec == CHD_CODEC_NONE)
+	{
+		chd_file chd;
+		if (chd.create(filename, BENCH_LOGICAL_BYTES, BENCH_HUNK_BYTES, BENCH_HUNK_BYTES, compression) != CHDERR_NONE)
+			return false;
+		dynamic_buffer buffer(BENCH_HUNK_BYTES);
+		for (UINT32 hunknum = 0; hunknum < BENCH_HUNK_COUNT; hunknum++)
+		{
+			bench_chd_compressor::fill_pattern(&buffer[0], UINT64(hunknum) * BENCH_HUNK_BYTES, BENCH_HUNK_BYTES);
+			if (chd.write_hunk(hunknum, &buffer[0]) != CHDERR_NONE)
+				return false;
+		}
+		return true;
+	}
+
+	// compressed CHDs have to go through the compressor
+	bench_chd_compressor chd;
+	if (chd.create(filename, BENCH_LOGICAL_BYTES, BENCH_HUNK_BYTES, BENCH_HUNK_BYTES, compression) != CHDERR_NONE)
+		return false;
+	chd.compress_begin();
+	double complete, ratio;
+	chd_error err;
+	while ((err = chd.compress_continue(complete, ratio)) == CHDERR_WALKING_PARENT || err == CHDERR_COMPRESSING) { }
+	return (err == CHDERR_NONE);
+}
+
+
+//-------------------------------------------------
+//  bench_read_hunk - read every hunk of a CHD in
+//  a stride that defeats the hunk cache
+//-------------------------------------------------
+
+static void bench_read_hunk(benchmark::State& state, const char *filename, chd_codec_type codec)
+{
+	chd_file chd;
+	if (!create_bench_chd(filename, codec) || chd.open(filename) != CHDERR_NONE)
+	{
+		while (state.KeepRunning()) { }
+		state.SetLabel("unable to create CHD");
+		osd_rmfile(filename);
+		return;
+	}
+
+	dynamic_buffer buffer(BENCH_HUNK_BYTES);
+	UINT32 hunknum = 0;
+	while (state.KeepRunning())
+	{
+		chd.read_hunk(hunknum, &buffer[0]);
+		hunknum = (hunknum + 37) % BENCH_HUNK_COUNT;
+	}
+	state.SetBytesProcessed(size_t(state.iterations()) * BENCH_HUNK_BYTES);
+
+	chd.close();
+	osd_rmfile(filename);
+}
+
+static void BM_chd_read_hunk_uncompressed(benchmark::State& state) {
+	bench_read_hunk(state, "bench_raw.chd", CHD_CODEC_NONE);
+}
+BENCHMARK(BM_chd_read_hunk_uncompressed);
+
+static void BM_chd_read_hunk_zlib(benchmark::State& state) {
+	bench_read_hunk(state, "bench_zlib.chd", CHD_CODEC_ZLIB);
+}
+BENCHMARK(BM_chd_read_hunk_zlib);
@@ -0,0 +1,112 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+#include "benchmark/benchmark_api.h"
+#include "osdcomm.h"
+#include "resampler.h"
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+// Stream rate conversion as sound_stream::generate_resampled_data does it,
+// one 100ms update at a time.  The label carries two quality figures for
+// the rate pair: "sinad" is the residual after removing a clean in-band
+// tone, which covers both aliasing and imaging, and "stop" is what is left
+// of a tone the output rate can't represent (decimation only).  Both are
+// in dB below the tone; lower is better.
+
+static const double BENCH_AMPLITUDE = 16000.0;
+
+// a sine at freq Hz sampled at rate, padded for the sinc history and lookahead
+static std::vector<INT32> make_tone(UINT32 rate, double freq, UINT32 length)
+{
+	std::vector<INT32> tone(length + 2 * sinc_resampler::MAX_TAPS);
+	for (UINT32 sample = 0; sample < tone.size(); sample++)
+		tone[sample] = INT32(floor(BENCH_AMPLITUDE * sin(2.0 * M_PI * freq * sample / rate) + 0.5));
+	return tone;
+}
+
+static UINT32 resample_step(UINT32 input_rate, UINT32 output_rate)
+{
+	return (UINT64(input_rate) << RESAMPLE_FRAC_BITS) / output_rate;
+}
+
+template<bool Sinc>
+static void run_resampler(const sinc_resampler &sinc, const std::vector<INT32> &source, UINT32 step, std::vector<INT32> &dest)
+{
+	if (Sinc)
+		sinc.resample(&source[sinc_resampler::MAX_TAPS], 0, step, &dest[0], dest.size(), 0x100);
+	else
+		resample_linear(&source[sinc_resampler::MAX_TAPS], 0, step, &dest[0], dest.size(), 0x100);
+}
+
+// energy left after a least-squares fit of a tone at freq, relative to the tone
+static double residual_db(const std::vector<INT32> &output, UINT32 rate, double freq)
+{
+	// skip the start, where a linear path with a box filter is still settling
+	const UINT32 start = output.size() / 8;
+	double sinsum = 0, cossum = 0, count = output.size() - start;
+	for (UINT32 sample = start; sample < output.size(); sample++)
+	{
+		sinsum += output[sample] * sin(2.0 * M_PI * freq * sample / rate);
+		cossum += output[sample] * cos(2.0 * M_PI * freq * sample / rate);
+	}
+	double a = 2.0 * sinsum / count, b = 2.0 * cossum / count;
+	double residual = 0;
+	for (UINT32 sample = start; sample < output.size(); sample++)
+	{
+		double err = output[sample] - a * sin(2.0 * M_PI * freq * sample / rate) - b * cos(2.0 * M_PI * freq * sample / rate);
+		residual += err * err;
+	}
+	return 10.0 * log10(MAX(residual / count, 1e-3) / (BENCH_AMPLITUDE * BENCH_AMPLITUDE / 2));
+}
+
+// energy of the whole output relative to the tone that went in
+static double energy_db(const std::vector<INT32> &output)
+{
+	const UINT32 start = output.size() / 8;
+	double energy = 0;
+	for (UINT32 sample = start; sample < output.size(); sample++)
+		energy += double(output[sample]) * output[sample];
+	return 10.0 * log10(MAX(energy / (output.size() - start), 1e-3) / (BENCH_AMPLITUDE * BENCH_AMPLITUDE / 2));
+}
+
+template<bool Sinc>
+static void BM_resample(benchmark::State& state)
+{
+	const UINT32 input_rate = state.range_x();
+	const UINT32 output_rate = state.range_y();
+	const UINT32 step = resample_step(input_rate, output_rate);
+	const UINT32 numsamples = output_rate / 10;
+	const UINT32 length = UINT64(numsamples) * step / RESAMPLE_FRAC_ONE + 2;
+	sinc_resampler sinc(input_rate, output_rate);
+	std::vector<INT32> dest(numsamples);
+
+	// quality figures first, on their own tones
+	double inband = 0.2 * MIN(input_rate, output_rate);
+	run_resampler<Sinc>(sinc, make_tone(input_rate, inband, length), step, dest);
+	char label[64];
+	int chars = snprintf(label, sizeof(label), "sinad=%.1fdB", residual_db(dest, output_rate, inband));
+	if (input_rate > output_rate)
+	{
+		// halfway between the two Nyquist rates, so it folds back into the audible band
+		double stop = 0.25 * (input_rate + output_rate);
+		run_resampler<Sinc>(sinc, make_tone(input_rate, stop, length), step, dest);
+		snprintf(&label[chars], sizeof(label) - chars, " stop=%.1fdB", energy_db(dest));
+	}
+	state.SetLabel(label);
+
+	// then throughput on mixed content
+	std::vector<INT32> source = make_tone(input_rate, inband, length);
+	while (state.KeepRunning())
+	{
+		run_resampler<Sinc>(sinc, source, step, dest);
+		benchmark::DoNotOptimize(dest[0]);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * numsamples);
+}
+
+// AY/YM clock/72 down to 48kHz, the same chip at clock/2, a 22kHz sample
+// player up to 48kHz, and a common 44.1kHz to 48kHz conversion
+BENCHMARK_TEMPLATE(BM_resample, false)->ArgPair(49716, 48000)->ArgPair(1789772, 48000)->ArgPair(22050, 48000)->ArgPair(44100, 48000);
+BENCHMARK_TEMPLATE(BM_resample, true)->ArgPair(49716, 48000)->ArgPair(1789772, 48000)->ArgPair(22050, 48000)->ArgPair(44100, 48000);
@@ -0,0 +1,158 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+#include "benchmark/benchmark_api.h"
+#include "osdcomm.h"
+#include "tilerast.h"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Full-screen tilemap blits as tilemap_t::draw_instance does them: one
+// rasterizer call per row, from a scrolled 1024x512 pixmap, with the
+// priority bitmap updated.  About a quarter of the flags map is
+// transparent, in runs of 8 pixels like a layer with empty tiles.  Each
+// kernel is timed against the per-pixel loops it replaced; the label
+// notes any frame that came out different.
+
+static const int PIXMAP_WIDTH = 1024;
+static const int PIXMAP_HEIGHT = 512;
+static const UINT32 PRIORITY_CODE = (0x100 << 16) | 0x0002;
+static const UINT8 LAYER_ALPHA = 0xa0;
+
+enum
+{
+	KERNEL_OPAQUE_IND16,
+	KERNEL_MASKED_IND16,
+	KERNEL_OPAQUE_RGB32,
+	KERNEL_MASKED_RGB32,
+	KERNEL_OPAQUE_RGB32_ALPHA,
+	KERNEL_MASKED_RGB32_ALPHA
+};
+
+static UINT32 reference_blend(UINT32 d, UINT32 s, UINT8 level)
+{
+	int alphad = 256 - level;
+	return ((((s & 0x0000ff) * level + (d & 0x0000ff) * alphad) >> 8)) |
+			((((s & 0x00ff00) * level + (d & 0x00ff00) * alphad) >> 8) & 0x00ff00) |
+			((((s & 0xff0000) * level + (d & 0xff0000) * alphad) >> 8) & 0xff0000);
+}
+
+// the per-pixel loops the rasterizers started from
+template<int Kernel>
+static void reference_row(UINT16 *dest16, UINT32 *dest32, const UINT16 *source, const UINT8 *maskptr, int count, const rgb_t *pens, UINT8 *pri)
+{
+	const bool masked = (Kernel == KERNEL_MASKED_IND16 || Kernel == KERNEL_MASKED_RGB32 || Kernel == KERNEL_MASKED_RGB32_ALPHA);
+	const UINT32 pal = PRIORITY_CODE >> 16;
+	for (int i = 0; i < count; i++)
+		if (!masked || (maskptr[i] & 0x10) == 0x10)
+		{
+			switch (Kernel)
+			{
+				case KERNEL_OPAQUE_IND16:
+				case KERNEL_MASKED_IND16:       dest16[i] = source[i] + pal; break;
+				case KERNEL_OPAQUE_RGB32:
+				case KERNEL_MASKED_RGB32:       dest32[i] = pens[pal + source[i]]; break;
+				default:                        dest32[i] = reference_blend(dest32[i], pens[pal + source[i]], LAYER_ALPHA); break;
+			}
+			pri[i] = (pri[i] & (PRIORITY_CODE >> 8)) | PRIORITY_CODE;
+		}
+}
+
+template<int Kernel>
+static void kernel_row(UINT16 *dest16, UINT32 *dest32, const UINT16 *source, const UINT8 *maskptr, int count, const rgb_t *pens, UINT8 *pri)
+{
+	switch (Kernel)
+	{
+		case KERNEL_OPAQUE_IND16:       scanline_draw_opaque_ind16(dest16, source, count, pri, PRIORITY_CODE); break;
+		case KERNEL_MASKED_IND16:       scanline_draw_masked_ind16(dest16, source, maskptr, 0x10, 0x10, count, pri, PRIORITY_CODE); break;
+		case KERNEL_OPAQUE_RGB32:       scanline_draw_opaque_rgb32(dest32, source, count, pens, pri, PRIORITY_CODE); break;
+		case KERNEL_MASKED_RGB32:       scanline_draw_masked_rgb32(dest32, source, maskptr, 0x10, 0x10, count, pens, pri, PRIORITY_CODE); break;
+		case KERNEL_OPAQUE_RGB32_ALPHA: scanline_draw_opaque_rgb32_alpha(dest32, source, count, pens, pri, PRIORITY_CODE, LAYER_ALPHA); break;
+		case KERNEL_MASKED_RGB32_ALPHA: scanline_draw_masked_rgb32_alpha(dest32, source, maskptr, 0x10, 0x10, count, pens, pri, PRIORITY_CODE, LAYER_ALPHA); break;
+	}
+}
+
+struct tilemap_frame
+{
+	tilemap_frame(int width, int height)
+		: m_width(width), m_height(height),
+			m_pixmap(PIXMAP_WIDTH * PIXMAP_HEIGHT), m_flagsmap(PIXMAP_WIDTH * PIXMAP_HEIGHT), m_pens(0x10000),
+			m_dest16(width * height), m_dest32(width * height), m_priority(width * height)
+	{
+		srand(1);
+		for (auto &pen : m_pixmap)
+			pen = rand() & 0x3ff;
+		for (int run = 0; run < PIXMAP_WIDTH * PIXMAP_HEIGHT; run += 8)
+			memset(&m_flagsmap[run], ((rand() & 3) != 0) ? 0x10 : 0x00, 8);
+		for (auto &pen : m_pens)
+			pen = rgb_t(rand() & 0xff, rand() & 0xff, rand() & 0xff);
+		reset();
+	}
+
+	void reset()
+	{
+		for (int pixel = 0; pixel < m_width * m_height; pixel++)
+		{
+			m_dest16[pixel] = pixel;
+			m_dest32[pixel] = pixel * 0x010101;
+			m_priority[pixel] = pixel;
+		}
+	}
+
+	template<bool Reference, int Kernel>
+	void draw(int scrollx, int scrolly)
+	{
+		for (int y = 0; y < m_height; y++)
+		{
+			int srcoffs = ((y + scrolly) % PIXMAP_HEIGHT) * PIXMAP_WIDTH + scrollx;
+			if (Reference)
+				reference_row<Kernel>(&m_dest16[y * m_width], &m_dest32[y * m_width], &m_pixmap[srcoffs], &m_flagsmap[srcoffs], m_width, &m_pens[0], &m_priority[y * m_width]);
+			else
+				kernel_row<Kernel>(&m_dest16[y * m_width], &m_dest32[y * m_width], &m_pixmap[srcoffs], &m_flagsmap[srcoffs], m_width, &m_pens[0], &m_priority[y * m_width]);
+		}
+	}
+
+	int m_width, m_height;
+	std::vector<UINT16> m_pixmap;
+	std::vector<UINT8> m_flagsmap;
+	std::vector<rgb_t> m_pens;
+	std::vector<UINT16> m_dest16;
+	std::vector<UINT32> m_dest32;
+	std::vector<UINT8> m_priority;
+};
+
+template<bool Reference, int Kernel>
+static void BM_tilemap(benchmark::State& state)
+{
+	tilemap_frame frame(state.range_x(), state.range_y());
+
+	// compare a frame against the reference loops first, with an odd scroll
+	// so the rows start unaligned
+	tilemap_frame check(state.range_x(), state.range_y());
+	frame.draw<Reference, Kernel>(3, 5);
+	check.draw<true, Kernel>(3, 5);
+	if (frame.m_dest16 != check.m_dest16 || frame.m_dest32 != check.m_dest32 || frame.m_priority != check.m_priority)
+		state.SetLabel("MISMATCH");
+	frame.reset();
+
+	int scroll = 0;
+	while (state.KeepRunning())
+	{
+		frame.draw<Reference, Kernel>(scroll & 0xff, scroll);
+		benchmark::DoNotOptimize(frame.m_priority[0]);
+		scroll++;
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * frame.m_width * frame.m_height);
+}
+
+#define TILEMAP_BENCHMARK(kernel) \
+	BENCHMARK_TEMPLATE2(BM_tilemap, true, kernel)->ArgPair(320, 240)->ArgPair(640, 480); \
+	BENCHMARK_TEMPLATE2(BM_tilemap, false, kernel)->ArgPair(320, 240)->ArgPair(640, 480);
+
+TILEMAP_BENCHMARK(KERNEL_OPAQUE_IND16)
+TILEMAP_BENCHMARK(KERNEL_MASKED_IND16)
+TILEMAP_BENCHMARK(KERNEL_OPAQUE_RGB32)
+TILEMAP_BENCHMARK(KERNEL_MASKED_RGB32)
+TILEMAP_BENCHMARK(KERNEL_OPAQUE_RGB32_ALPHA)
+TILEMAP_BENCHMARK(KERNEL_MASKED_RGB32_ALPHA)
@@ -0,0 +1,193 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+#include "benchmark/benchmark_api.h"
+#include "osdcomm.h"
+#include "eminline.h"
+#include "attotime.h"
+#include "coretmpl.h"
+
+// Scheduling cost of 1000 active timers: the intrusive heap used by
+// device_scheduler against the sorted linked list it replaced.
+
+static const int BENCH_TIMERS = 1000;
+
+struct bench_timer
+{
+	bench_timer *   m_next;
+	bench_timer *   m_prev;
+	int             m_heapindex;
+	UINT64          m_sequence;
+	attotime        m_expire;
+	attotime        m_period;
+
+	bool heap_before(const bench_timer &other) const { return (m_expire < other.m_expire) || (m_expire == other.m_expire && m_sequence < other.m_sequence); }
+};
+
+// periods spread over 1us to ~1ms, like a mix of sound chip and serial timers
+static void init_timers(std::vector<bench_timer> &timers)
+{
+	timers.resize(BENCH_TIMERS);
+	for (int index = 0; index < BENCH_TIMERS; index++)
+	{
+		bench_timer &timer = timers[index];
+		timer.m_next = timer.m_prev = nullptr;
+		timer.m_heapindex = -1;
+		timer.m_sequence = 0;
+		timer.m_period = attotime(0, ATTOSECONDS_IN_USEC(1 + (index * 7919) % 1000));
+		timer.m_expire = timer.m_period;
+	}
+}
+
+
+//**************************************************************************
+//  HEAP
+//**************************************************************************
+
+class bench_heap
+{
+public:
+	void schedule(bench_timer &timer)
+	{
+		timer.m_sequence = m_sequence++;
+		if (m_heap.contains(timer))
+			m_heap.update(timer);
+		else
+			m_heap.insert(timer);
+	}
+
+	bench_timer &next() { return *m_heap.top(); }
+
+private:
+	intrusive_heap<bench_timer> m_heap;
+	UINT64 m_sequence = 0;
+};
+
+static void BM_timer_heap_fire(benchmark::State& state) {
+	std::vector<bench_timer> timers;
+	init_timers(timers);
+	bench_heap heap;
+	for (bench_timer &timer : timers)
+		heap.schedule(timer);
+
+	while (state.KeepRunning()) {
+		bench_timer &timer = heap.next();
+		timer.m_expire += timer.m_period;
+		heap.schedule(timer);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_timer_heap_fire);
+
+static void BM_timer_heap_adjust(benchmark::State& state) {
+	std::vector<bench_timer> timers;
+	init_timers(timers);
+	bench_heap heap;
+	for (bench_timer &timer : timers)
+		heap.schedule(timer);
+
+	int index = 0;
+	attotime now(0, 0);
+	while (state.KeepRunning()) {
+		bench_timer &timer = timers[index];
+		now += attotime(0, ATTOSECONDS_IN_NSEC(10));
+		timer.m_expire = now + timer.m_period;
+		heap.schedule(timer);
+		index = (index + 389) % BENCH_TIMERS;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_timer_heap_adjust);
+
+
+//**************************************************************************
+//  SORTED LIST
+//**************************************************************************
+
+class bench_list
+{
+public:
+	void schedule(bench_timer &timer)
+	{
+		if (timer.m_heapindex >= 0)
+			remove(timer);
+		insert(timer);
+	}
+
+	bench_timer &next() { return *m_head; }
+
+private:
+	void insert(bench_timer &timer)
+	{
+		bench_timer *prevtimer = nullptr;
+		for (bench_timer *curtimer = m_head; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->m_next)
+			if (curtimer->m_expire > timer.m_expire)
+			{
+				timer.m_prev = curtimer->m_prev;
+				timer.m_next = curtimer;
+				if (curtimer->m_prev != nullptr)
+					curtimer->m_prev->m_next = &timer;
+				else
+					m_head = &timer;
+				curtimer->m_prev = &timer;
+				timer.m_heapindex = 0;
+				return;
+			}
+
+		if (prevtimer != nullptr)
+			prevtimer->m_next = &timer;
+		else
+			m_head = &timer;
+		timer.m_prev = prevtimer;
+		timer.m_next = nullptr;
+		timer.m_heapindex = 0;
+	}
+
+	void remove(bench_timer &timer)
+	{
+		if (timer.m_prev != nullptr)
+			timer.m_prev->m_next = timer.m_next;
+		else
+			m_head = timer.m_next;
+		if (timer.m_next != nullptr)
+			timer.m_next->m_prev = timer.m_prev;
+	}
+
+	bench_timer *m_head = nullptr;
+};
+
+static void BM_timer_list_fire(benchmark::State& state) {
+	std::vector<bench_timer> timers;
+	init_timers(timers);
+	bench_list list;
+	for (bench_timer &timer : timers)
+		list.schedule(timer);
+
+	while (state.KeepRunning()) {
+		bench_timer &timer = list.next();
+		timer.m_expire += timer.m_period;
+		list.schedule(timer);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_timer_list_fire);
+
+static void BM_timer_list_adjust(benchmark::State& state) {
+	std::vector<bench_timer> timers;
+	init_timers(timers);
+	bench_list list;
+	for (bench_timer &timer : timers)
+		list.schedule(timer);
+
+	int index = 0;
+	attotime now(0, 0);
+	while (state.KeepRunning()) {
+		bench_timer &timer = timers[index];
+		now += attotime(0, ATTOSECONDS_IN_NSEC(10));
+		timer.m_expire = now + timer.m_period;
+		list.schedule(timer);
+		index = (index + 389) % BENCH_TIMERS;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_timer_list_adjust);
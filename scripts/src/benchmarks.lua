@@ -59,16 +59,51 @@ project("benchmarks")
 
 	links {
 		"benchmark",
+		"utils",
+		"expat",
+		"7z",
+		"ocore_" .. _OPTIONS["osd"],
 	}
 
+	if _OPTIONS["with-bundled-zlib"] then
+		links {
+			"zlib",
+		}
+	else
+		links {
+			"z",
+		}
+	end
+
+	if _OPTIONS["with-bundled-flac"] then
+		links {
+			"flac",
+		}
+	else
+		links {
+			"FLAC",
+		}
+	end
+
 	includedirs {
 		MAME_DIR .. "3rdparty/benchmark/include",
 		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/lib/util",
+		MAME_DIR .. "3rdparty",
 	}
 
 	files {
 		MAME_DIR .. "benchmarks/main.cpp",
 		MAME_DIR .. "benchmarks/eminline_native.cpp",
 		MAME_DIR .. "benchmarks/eminline_noasm.cpp",
+		MAME_DIR .. "benchmarks/attotime.cpp",
+		MAME_DIR .. "benchmarks/chd.cpp",
+		MAME_DIR .. "benchmarks/timer.cpp",
+		MAME_DIR .. "benchmarks/resampler.cpp",
+		MAME_DIR .. "benchmarks/tilemap.cpp",
+		MAME_DIR .. "src/emu/attotime.cpp",
+		MAME_DIR .. "src/emu/resampler.cpp",
+		MAME_DIR .. "src/emu/tilerast.cpp",
 	}
 
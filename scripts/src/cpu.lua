@@ -21,18 +21,24 @@ files {
 -- Dynamic recompiler objects
 --------------------------------------------------
 
-if (CPUS["SH2"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RSP"]~=null or CPUS["ARM7"]~=null) then
+if (CPUS["SH2"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RSP"]~=null or CPUS["ARM7"]~=null or CPUS["I386"]~=null or CPUS["SH4"]~=null or CPUS["M680X0"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/drcbec.cpp",
 		MAME_DIR .. "src/devices/cpu/drcbec.h",
 		MAME_DIR .. "src/devices/cpu/drcbeut.cpp",
 		MAME_DIR .. "src/devices/cpu/drcbeut.h",
+		MAME_DIR .. "src/devices/cpu/drcbetest.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbetest.h",
 		MAME_DIR .. "src/devices/cpu/drccache.cpp",
 		MAME_DIR .. "src/devices/cpu/drccache.h",
 		MAME_DIR .. "src/devices/cpu/drcfe.cpp",
 		MAME_DIR .. "src/devices/cpu/drcfe.h",
+		MAME_DIR .. "src/devices/cpu/drcpersist.cpp",
+		MAME_DIR .. "src/devices/cpu/drcpersist.h",
 		MAME_DIR .. "src/devices/cpu/drcuml.cpp",
 		MAME_DIR .. "src/devices/cpu/drcuml.h",
+		MAME_DIR .. "src/devices/cpu/drcumlopt.cpp",
+		MAME_DIR .. "src/devices/cpu/drcumlopt.h",
 		MAME_DIR .. "src/devices/cpu/uml.cpp",
 		MAME_DIR .. "src/devices/cpu/uml.h",
 		MAME_DIR .. "src/devices/cpu/i386/i386dasm.cpp",
@@ -665,6 +671,8 @@ if (CPUS["SH4"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/sh4/sh4.cpp",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4.h",
+		MAME_DIR .. "src/devices/cpu/sh4/sh4fe.cpp",
+		--MAME_DIR .. "src/devices/cpu/sh4/sh4drc.cpp",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4comn.cpp",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4comn.h",
 		MAME_DIR .. "src/devices/cpu/sh4/sh3comn.cpp",
@@ -917,6 +925,9 @@ if (CPUS["I386"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/i386/i386.cpp",
 		MAME_DIR .. "src/devices/cpu/i386/i386.h",
+		--MAME_DIR .. "src/devices/cpu/i386/i386drc.cpp",
+		MAME_DIR .. "src/devices/cpu/i386/i386fe.cpp",
+		MAME_DIR .. "src/devices/cpu/i386/i386fe.h",
 		MAME_DIR .. "src/devices/cpu/i386/cycles.h",
 		MAME_DIR .. "src/devices/cpu/i386/i386op16.inc",
 		MAME_DIR .. "src/devices/cpu/i386/i386op32.inc",
@@ -1376,6 +1387,9 @@ if (CPUS["M680X0"]~=null) then
 		MAME_DIR .. "src/devices/cpu/m68000/m68kfpu.inc",
 		--MAME_DIR .. "src/devices/cpu/m68000/m68kmake.cpp",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kmmu.h",
+		--MAME_DIR .. "src/devices/cpu/m68000/m68kdrc.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kfe.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kfe.h",
 		--MAME_DIR .. "src/devices/cpu/m68000/m68k_in.cpp",
 	}
 end
@@ -37,6 +37,11 @@ if _OPTIONS["with-bundled-lua"] then
 		MAME_DIR .. "3rdparty/lua/src",
 	}
 end
+if _OPTIONS["with-bundled-zlib"] then
+	includedirs {
+		MAME_DIR .. "3rdparty/zlib",
+	}
+end
 
 files {
 	MAME_DIR .. "src/emu/emu.h",
@@ -108,6 +113,7 @@ files {
 	MAME_DIR .. "src/emu/drawgfx.cpp",
 	MAME_DIR .. "src/emu/drawgfx.h",
 	MAME_DIR .. "src/emu/drawgfxm.h",
+	MAME_DIR .. "src/emu/drawgfxt.h",
 	MAME_DIR .. "src/emu/driver.cpp",
 	MAME_DIR .. "src/emu/driver.h",
 	MAME_DIR .. "src/emu/drivenum.cpp",
@@ -161,6 +167,8 @@ files {
 	MAME_DIR .. "src/emu/rendlay.h",
 	MAME_DIR .. "src/emu/rendutil.cpp",
 	MAME_DIR .. "src/emu/rendutil.h",
+	MAME_DIR .. "src/emu/resampler.cpp",
+	MAME_DIR .. "src/emu/resampler.h",
 	MAME_DIR .. "src/emu/romload.cpp",
 	MAME_DIR .. "src/emu/romload.h",
 	MAME_DIR .. "src/emu/save.cpp",
@@ -179,6 +187,8 @@ files {
 	MAME_DIR .. "src/emu/sprite.h",
 	MAME_DIR .. "src/emu/tilemap.cpp",
 	MAME_DIR .. "src/emu/tilemap.h",
+	MAME_DIR .. "src/emu/tilerast.cpp",
+	MAME_DIR .. "src/emu/tilerast.h",
 	MAME_DIR .. "src/emu/timer.cpp",
 	MAME_DIR .. "src/emu/timer.h",
 	MAME_DIR .. "src/emu/uiinput.cpp",
@@ -2711,6 +2711,15 @@ files {
 
 createMESSProjects(_target, _subtarget, "test")
 files {
+	MAME_DIR .. "src/mame/includes/drccomp.h",
+	MAME_DIR .. "src/mame/machine/drccomp.cpp",
+	MAME_DIR .. "src/mame/drivers/test_bench.cpp",
+	MAME_DIR .. "src/mame/drivers/test_drc.cpp",
+	MAME_DIR .. "src/mame/drivers/test_gfx.cpp",
+	MAME_DIR .. "src/mame/drivers/test_i386drc.cpp",
+	MAME_DIR .. "src/mame/drivers/test_m68kdrc.cpp",
+	MAME_DIR .. "src/mame/drivers/test_memory.cpp",
+	MAME_DIR .. "src/mame/drivers/test_sh4drc.cpp",
 	MAME_DIR .. "src/mame/drivers/test_t400.cpp",
 	MAME_DIR .. "src/mame/drivers/zexall.cpp",
 }
@@ -203,6 +203,23 @@ enum
 #define FLAGS64_NZCV_ADD(r,a,b)     (FLAGS64_NZ(r) | FLAGS64_C_ADD(a,b) | FLAGS64_V_ADD(r,a,b))
 #define FLAGS64_NZCV_SUB(r,a,b)     (FLAGS64_NZ(r) | FLAGS64_C_SUB(a,b) | FLAGS64_V_SUB(r,a,b))
 
+// saturate a 32-bit value to a signed 16-bit lane
+#define SATURATE16(v)               ((v) < -32768 ? -32768 : ((v) > 32767 ? 32767 : (v)))
+
+// apply an expression of s1 and s2 to each 16-bit lane of two vector operands;
+// the result is built in vtemp so the destination may alias either source
+#define VECTOR_OP(expr) \
+do { \
+	const INT16 *vsrc1 = inst[1].pint16; \
+	const INT16 *vsrc2 = inst[2].pint16; \
+	for (int lane = 0; lane < 8; lane++) \
+	{ \
+		INT32 s1 = vsrc1[lane], s2 = vsrc2[lane]; \
+		vtemp[lane] = (INT16)(expr); \
+	} \
+	memcpy(inst[0].v, vtemp, sizeof(vtemp)); \
+} while (0)
+
 
 
 //**************************************************************************
@@ -473,6 +490,17 @@ bool drcbe_c::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  hash_unlink - remove the code for the given
+//  mode/pc from the hash table
+//-------------------------------------------------
+
+void drcbe_c::hash_unlink(UINT32 mode, UINT32 pc)
+{
+	m_hash.unlink(mode, pc);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -501,6 +529,7 @@ int drcbe_c::execute(code_handle &entry)
 	const drcbec_instruction *newinst;
 	UINT32 temp32;
 	UINT64 temp64;
+	INT16 vtemp[8];
 	int shift;
 	UINT8 flags = 0;
 	UINT8 sp = 0;
@@ -917,6 +946,7 @@ int drcbe_c::execute(code_handle &entry)
 					else
 						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
 				}
+				flags = (flags & ~FLAG_V) | FLAGS32_V_ADD(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
@@ -942,10 +972,10 @@ int drcbe_c::execute(code_handle &entry)
 				else
 				{
 					flags = FLAGS32_NZCV_SUB(temp32, PARAM1 - (flags & FLAG_C), PARAM2);
-					flags &= ~(FLAG_C | FLAG_V);
+					flags &= ~FLAG_C;
 					flags |= ((temp64>>32) & 1) ? FLAG_C : 0;
-					flags |= (((PARAM1) ^ (PARAM2)) & ((PARAM1) ^ (temp64)) & 0x80000000) ? FLAG_V : 0;
 				}
+				flags = (flags & ~FLAG_V) | FLAGS32_V_SUB(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
@@ -978,8 +1008,7 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_MULS, 4, 1):
 				temp64 = (INT64)(INT32)PARAM2 * (INT64)(INT32)PARAM3;
-				temp32 = (INT32)temp64;
-				flags = FLAGS32_NZ(temp32);
+				flags = FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				if (temp64 != (INT32)temp64)
@@ -1079,9 +1108,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 1):
-				temp32 = PARAM1;
+				temp32 = FLIPENDIAN_INT32(PARAM1);
 				flags = FLAGS32_NZ(temp32);
-				PARAM0 = FLIPENDIAN_INT32(temp32);
+				PARAM0 = temp32;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SHL, 4, 0):       // SHL     dst,src,count[,f]
@@ -1151,6 +1180,8 @@ int drcbe_c::execute(code_handle &entry)
 					PARAM0 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
 				else if (shift == 1)
 					PARAM0 = (PARAM1 << shift) | (flags & FLAG_C);
+				else
+					PARAM0 = PARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 1):
@@ -1182,15 +1213,17 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_RORC, 4, 0):      // RORC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					PARAM0 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					PARAM0 = (PARAM1 >> shift) | ((((UINT32)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
 					PARAM0 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
+				else
+					PARAM0 = PARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_RORC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					temp32 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					temp32 = (PARAM1 >> shift) | ((((UINT32)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
 					temp32 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
 				else
@@ -1451,7 +1484,7 @@ int drcbe_c::execute(code_handle &entry)
 				m_space[PARAM3]->write_qword(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 0):     // DCARRY  src,bitnum
+			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 1):     // DCARRY  src,bitnum
 				flags = (flags & ~FLAG_C) | ((DPARAM0 >> (DPARAM1 & 63)) & FLAG_C);
 				break;
 
@@ -1541,7 +1574,8 @@ int drcbe_c::execute(code_handle &entry)
 				if (DPARAM2 + 1 != 0)
 					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
 				else
-					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1 + (flags & FLAG_C), DPARAM2);
+					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1 + (flags & FLAG_C), DPARAM2) | (flags & FLAG_C);
+				flags = (flags & ~FLAG_V) | FLAGS64_V_ADD(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
@@ -1564,7 +1598,8 @@ int drcbe_c::execute(code_handle &entry)
 				if (DPARAM2 + 1 != 0)
 					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
 				else
-					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1 - (flags & FLAG_C), DPARAM2);
+					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1 - (flags & FLAG_C), DPARAM2) | (flags & FLAG_C);
+				flags = (flags & ~FLAG_V) | FLAGS64_V_SUB(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
@@ -1642,7 +1677,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_TEST, 8, 1):      // DTEST   src1,src2[,f]
-				temp64 = DPARAM1 & DPARAM2;
+				temp64 = DPARAM0 & DPARAM1;
 				flags = FLAGS64_NZ(temp64);
 				break;
 
@@ -1688,9 +1723,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 1):
-				temp64 = DPARAM1;
+				temp64 = FLIPENDIAN_INT64(DPARAM1);
 				flags = FLAGS64_NZ(temp64);
-				DPARAM0 = FLIPENDIAN_INT64(temp64);
+				DPARAM0 = temp64;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SHL, 8, 0):       // DSHL    dst,src,count[,f]
@@ -1723,14 +1758,14 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_SAR, 8, 1):
 				shift = DPARAM2 & 63;
-				temp64 = (INT32)DPARAM1 >> shift;
+				temp64 = (INT64)DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
 				DPARAM0 = temp64;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROL, 8, 0):       // DROL    dst,src,count[,f]
-				shift = DPARAM2 & 31;
+				shift = DPARAM2 & 63;
 				DPARAM0 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
 				break;
 
@@ -1745,15 +1780,17 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 0):      // DROLC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					DPARAM0 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					DPARAM0 = (DPARAM1 << shift) | (((UINT64)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 << shift) | (flags & FLAG_C);
+				else
+					DPARAM0 = DPARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					temp64 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					temp64 = (DPARAM1 << shift) | (((UINT64)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					temp64 = (DPARAM1 << shift) | (flags & FLAG_C);
 				else
@@ -1782,6 +1819,8 @@ int drcbe_c::execute(code_handle &entry)
 					DPARAM0 = (DPARAM1 >> shift) | ((((UINT64)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 >> shift) | (((UINT64)flags & FLAG_C) << 63);
+				else
+					DPARAM0 = DPARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_RORC, 8, 1):
@@ -2071,6 +2110,71 @@ int drcbe_c::execute(code_handle &entry)
 				FDPARAM0 = 1.0 / sqrt(FDPARAM1);
 				break;
 
+
+			// ----------------------- 128-Bit Vector Operations -----------------------
+
+			case MAKE_OPCODE_SHORT(OP_VMOV, 4, 0):      // VMOV    dst,src1
+				memmove(inst[0].v, inst[1].v, 16);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VSHUF, 4, 0):     // VSHUF   dst,src1,sel
+				for (int lane = 0; lane < 8; lane++)
+					vtemp[lane] = inst[1].pint16[(PARAM2 >> (4 * lane)) & 7];
+				memcpy(inst[0].v, vtemp, sizeof(vtemp));
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VADDW, 4, 0):     // VADDW   dst,src1,src2
+				VECTOR_OP(s1 + s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VADDSW, 4, 0):    // VADDSW  dst,src1,src2
+				VECTOR_OP(SATURATE16(s1 + s2));
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VSUBW, 4, 0):     // VSUBW   dst,src1,src2
+				VECTOR_OP(s1 - s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VSUBSW, 4, 0):    // VSUBSW  dst,src1,src2
+				VECTOR_OP(SATURATE16(s1 - s2));
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VMINSW, 4, 0):    // VMINSW  dst,src1,src2
+				VECTOR_OP((s1 < s2) ? s1 : s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VMAXSW, 4, 0):    // VMAXSW  dst,src1,src2
+				VECTOR_OP((s1 > s2) ? s1 : s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VCMPGTW, 4, 0):   // VCMPGTW dst,src1,src2
+				VECTOR_OP((s1 > s2) ? -1 : 0);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VAND, 4, 0):      // VAND    dst,src1,src2
+				VECTOR_OP(s1 & s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VOR, 4, 0):       // VOR     dst,src1,src2
+				VECTOR_OP(s1 | s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VXOR, 4, 0):      // VXOR    dst,src1,src2
+				VECTOR_OP(s1 ^ s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VMULLW, 4, 0):    // VMULLW  dst,src1,src2
+				VECTOR_OP(s1 * s2);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VMULHW, 4, 0):    // VMULHW  dst,src1,src2
+				VECTOR_OP((s1 * s2) >> 16);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VSATW, 4, 0):     // VSATW   dst,lo,hi
+				VECTOR_OP(SATURATE16((INT32)(((UINT32)s2 << 16) | (UINT16)s1)));
+				break;
+
 			default:
 				fatalerror("Unexpected opcode!\n");
 		}
@@ -2223,7 +2327,7 @@ int drcbe_c::dmulu(UINT64 &dstlo, UINT64 &dsthi, UINT64 src1, UINT64 src2, int f
 	// store the results
 	dsthi = hi;
 	dstlo = lo;
-	return ((hi >> 60) & FLAG_S) | ((dsthi != 0) << 1);
+	return ((hi >> 60) & FLAG_S) | ((hi != 0) << 1);
 }
 
 
@@ -2274,5 +2378,5 @@ int drcbe_c::dmuls(UINT64 &dstlo, UINT64 &dsthi, INT64 src1, INT64 src2, int fla
 	// store the results
 	dsthi = hi;
 	dstlo = lo;
-	return ((hi >> 60) & FLAG_S) | ((dsthi != ((INT64)lo >> 63)) << 1);
+	return ((hi >> 60) & FLAG_S) | ((hi != ((INT64)lo >> 63)) << 1);
 }
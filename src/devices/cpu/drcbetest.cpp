@@ -0,0 +1,1530 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbetest.cpp
+
+    Conformance tests comparing UML back-ends against each other.
+
+****************************************************************************
+
+    Each test restores a known machine state, runs a short sequence of
+    UML instructions, captures the flags the sequence is defined to
+    produce and saves the machine state again.  The same sequence is
+    run through the portable C back-end and through the native back-end
+    for this host, and any difference in registers, defined flags or
+    internal registers is reported.
+
+    Only results the UML defines are compared: after a 32-bit operation
+    the upper half of an integer register is undefined, and flags the
+    opcode does not produce are masked off.  Some results are left to
+    the back-end and not compared either: S and Z after a rotate, all
+    flags after a shift or rotate by zero, S and Z from a multiply that
+    only keeps the low half of its result, Z and C after an unordered
+    floating point compare, float-to-integer rounding
+    ties, FRECIP/FRSQRT precision and whether arithmetic honours FMOD.
+    Tests therefore run with round-to-nearest and avoid ties.
+
+    Besides the edge-value tests, run_fuzz() builds random blocks that
+    chain instructions together.  The generator tracks which flags are
+    defined at each point and only emits conditions and carry-in
+    operations that read defined flags, so any difference is a real
+    divergence.  A failing block is dumped in full so that it can be
+    reproduced with the same seed.
+
+    run_optimizer_fuzz() builds the same kind of blocks with memory
+    operands added and runs each one twice on the same back-end, once
+    with the UML optimizer off and once with all or some of its passes
+    on, so that a pass which changes the result of a block is caught
+    even though both back-ends would run the same rewritten code.
+
+    test_invalidation() checks that each back-end unlinks exactly the
+    hash entries drcuml_state::invalidate_code() asks it to.
+
+    test_linking() checks that a HASHJMP to a fixed PC reaches code
+    generated after it, follows the entry when a newer block takes it
+    over, and falls back to its exception handler once it is unlinked,
+    which the x64 back-end does by patching the jump directly.
+
+    run_benchmark() times a tight loop of typical recompiler output on
+    both back-ends to give a rough measure of generated code speed.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcbetest.h"
+#include "drcumlsh.h"
+
+#include <math.h>
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// size of the code cache given to each back-end
+const size_t CACHE_SIZE = 4 * 1024 * 1024;
+
+// longest random block generated by the fuzzer
+const int FUZZ_MAX_INSTRUCTIONS = 24;
+
+// memory available to random blocks as operands, kept small so that
+// locations are reused
+const int FUZZ_SCRATCH_QWORDS = 4;
+
+// 16-bit lanes of destination, first and second source for the vector tests
+const int VECTOR_LANES = 3 * 8;
+
+// edge values for 32-bit integer operands
+static const UINT64 s_values32[] =
+{
+	0x00000000, 0x00000001, 0x00000002, 0x0000007f, 0x7fffffff, 0x80000000, 0xfffffffe, 0xffffffff, 0x12345678
+};
+
+// edge values for 64-bit integer operands
+static const UINT64 s_values64[] =
+{
+	U64(0x0000000000000000), U64(0x0000000000000001), U64(0x00000000ffffffff), U64(0x0000000100000000),
+	U64(0x7fffffffffffffff), U64(0x8000000000000000), U64(0xfffffffffffffffe), U64(0xffffffffffffffff),
+	U64(0x123456789abcdef0)
+};
+
+// shift and rotate counts, including ones that need masking
+static const UINT64 s_shifts[] =
+{
+	0, 1, 4, 15, 31, 32, 33, 63, 64
+};
+
+// masks for ROLAND and ROLINS
+static const UINT64 s_masks[] =
+{
+	U64(0x00000000000000ff), U64(0x00000000ffff0000), U64(0x0ff00ff00ff00ff0), U64(0xffffffffffffffff)
+};
+
+// edge values for floating point operands
+static const double s_fvalues[] =
+{
+	0.0, -0.0, 1.0, -1.5, 2.75, 1.0e10, -3.0e-5, HUGE_VAL
+};
+
+// vector operands mixing saturation edges with ordinary values
+static const INT16 s_vvalues[][8] =
+{
+	{ 0, 1, -1, 0x7fff, -0x8000, 0x4000, -0x4001, 0x1234 },
+	{ 0x7fff, 0x7fff, -0x8000, 1, -1, 0x4000, -0x4000, -0x5678 },
+	{ -0x8000, 0x0100, 0x00ff, -0x7fff, 0x7ffe, 0, -2, 0x6543 }
+};
+
+// shuffle selectors: identity, within each half, broadcasts from each half,
+// and a pattern that crosses halves
+static const UINT32 s_vshuffles[] =
+{
+	0x76543210, 0x66442200, 0x44440000, 0x22222222, 0x55555555, 0x01234567, 0x13572460
+};
+
+// values for float-to-integer conversion; in range for both sizes and
+// never exactly halfway between two integers
+static const double s_ftoint_values[] =
+{
+	0.0, 1.25, -1.75, 100.6, -2047.3, 65535.9
+};
+
+// conditions that depend only on integer flags
+static const condition_t s_int_conditions[] =
+{
+	COND_Z, COND_NZ, COND_S, COND_NS, COND_C, COND_NC, COND_V, COND_NV,
+	COND_A, COND_BE, COND_G, COND_LE, COND_L, COND_GE
+};
+
+// conditions that are meaningful after a floating point compare
+static const condition_t s_float_conditions[] =
+{
+	COND_Z, COND_NZ, COND_C, COND_NC, COND_U, COND_NU, COND_A, COND_BE
+};
+
+// flags read by each condition
+struct condition_info
+{
+	condition_t     cond;
+	UINT8           flags;
+};
+
+static const condition_info s_condition_flags[] =
+{
+	{ COND_Z,  FLAG_Z },                    { COND_NZ, FLAG_Z },
+	{ COND_S,  FLAG_S },                    { COND_NS, FLAG_S },
+	{ COND_C,  FLAG_C },                    { COND_NC, FLAG_C },
+	{ COND_V,  FLAG_V },                    { COND_NV, FLAG_V },
+	{ COND_U,  FLAG_U },                    { COND_NU, FLAG_U },
+	{ COND_A,  FLAG_C | FLAG_Z },           { COND_BE, FLAG_C | FLAG_Z },
+	{ COND_G,  FLAG_S | FLAG_V | FLAG_Z },  { COND_LE, FLAG_S | FLAG_V | FLAG_Z },
+	{ COND_L,  FLAG_S | FLAG_V },           { COND_GE, FLAG_S | FLAG_V }
+};
+
+// divisors for random signed divides, which must never be -1
+static const INT64 s_fuzz_divisors[] =
+{
+	1, 2, 3, 7, -5, 0x1234, -0x10000
+};
+
+
+
+//**************************************************************************
+//  OPCODE TABLES
+//**************************************************************************
+
+typedef void (instruction::*binary_func)(parameter, parameter, parameter);
+typedef void (instruction::*compare_func)(parameter, parameter);
+typedef void (instruction::*unary_func)(parameter, parameter);
+typedef void (instruction::*muldiv_func)(parameter, parameter, parameter, parameter);
+typedef void (instruction::*rotmask_func)(parameter, parameter, parameter, parameter);
+
+// integer operations of the form dst,src1,src2
+struct binary_op
+{
+	const char *    name;
+	binary_func     op32;
+	binary_func     op64;
+	UINT8           inflags;            // flags consumed by the operation
+	UINT8           outflags;           // flags defined by the operation
+	bool            shift;              // src2 is a shift count
+};
+
+static const binary_op s_binary_ops[] =
+{
+	{ "add",  &instruction::add,  &instruction::dadd,  0,      FLAG_S | FLAG_Z | FLAG_V | FLAG_C, false },
+	{ "addc", &instruction::addc, &instruction::daddc, FLAG_C, FLAG_S | FLAG_Z | FLAG_V | FLAG_C, false },
+	{ "sub",  &instruction::sub,  &instruction::dsub,  0,      FLAG_S | FLAG_Z | FLAG_V | FLAG_C, false },
+	{ "subb", &instruction::subb, &instruction::dsubb, FLAG_C, FLAG_S | FLAG_Z | FLAG_V | FLAG_C, false },
+	{ "and",  &instruction::_and, &instruction::dand,  0,      FLAG_S | FLAG_Z,                   false },
+	{ "or",   &instruction::_or,  &instruction::dor,   0,      FLAG_S | FLAG_Z,                   false },
+	{ "xor",  &instruction::_xor, &instruction::dxor,  0,      FLAG_S | FLAG_Z,                   false },
+	{ "shl",  &instruction::shl,  &instruction::dshl,  0,      FLAG_S | FLAG_Z | FLAG_C,          true },
+	{ "shr",  &instruction::shr,  &instruction::dshr,  0,      FLAG_S | FLAG_Z | FLAG_C,          true },
+	{ "sar",  &instruction::sar,  &instruction::dsar,  0,      FLAG_S | FLAG_Z | FLAG_C,          true },
+	{ "rol",  &instruction::rol,  &instruction::drol,  0,      FLAG_C,                            true },
+	{ "rolc", &instruction::rolc, &instruction::drolc, FLAG_C, FLAG_C,                            true },
+	{ "ror",  &instruction::ror,  &instruction::dror,  0,      FLAG_C,                            true },
+	{ "rorc", &instruction::rorc, &instruction::drorc, FLAG_C, FLAG_C,                            true }
+};
+
+// integer operations of the form src1,src2 that only produce flags
+struct compare_op
+{
+	const char *    name;
+	compare_func    op32;
+	compare_func    op64;
+	UINT8           outflags;
+};
+
+static const compare_op s_compare_ops[] =
+{
+	{ "cmp",  &instruction::cmp,  &instruction::dcmp,  FLAG_S | FLAG_Z | FLAG_V | FLAG_C },
+	{ "test", &instruction::test, &instruction::dtest, FLAG_S | FLAG_Z }
+};
+
+// integer operations of the form dst,src
+struct unary_op
+{
+	const char *    name;
+	unary_func      op32;
+	unary_func      op64;
+	UINT8           outflags;
+};
+
+static const unary_op s_unary_ops[] =
+{
+	{ "lzcnt", &instruction::lzcnt, &instruction::dlzcnt, FLAG_S | FLAG_Z },
+	{ "bswap", &instruction::bswap, &instruction::dbswap, FLAG_S | FLAG_Z }
+};
+
+// integer operations of the form dst,edst,src1,src2
+struct muldiv_op
+{
+	const char *    name;
+	muldiv_func     op32;
+	muldiv_func     op64;
+	bool            divide;
+	bool            is_signed;
+};
+
+static const muldiv_op s_muldiv_ops[] =
+{
+	{ "mulu", &instruction::mulu, &instruction::dmulu, false, false },
+	{ "muls", &instruction::muls, &instruction::dmuls, false, true },
+	{ "divu", &instruction::divu, &instruction::ddivu, true,  false },
+	{ "divs", &instruction::divs, &instruction::ddivs, true,  true }
+};
+
+// integer operations of the form dst,src,shift,mask
+struct rotmask_op
+{
+	const char *    name;
+	rotmask_func    op32;
+	rotmask_func    op64;
+};
+
+static const rotmask_op s_rotmask_ops[] =
+{
+	{ "roland", &instruction::roland, &instruction::droland },
+	{ "rolins", &instruction::rolins, &instruction::drolins }
+};
+
+// floating point operations of the form dst,src1,src2
+struct float_binary_op
+{
+	const char *    name;
+	binary_func     ops;
+	binary_func     opd;
+};
+
+static const float_binary_op s_float_binary_ops[] =
+{
+	{ "add", &instruction::fsadd, &instruction::fdadd },
+	{ "sub", &instruction::fssub, &instruction::fdsub },
+	{ "mul", &instruction::fsmul, &instruction::fdmul },
+	{ "div", &instruction::fsdiv, &instruction::fddiv }
+};
+
+// floating point operations of the form dst,src
+struct float_unary_op
+{
+	const char *    name;
+	unary_func      ops;
+	unary_func      opd;
+};
+
+static const float_unary_op s_float_unary_ops[] =
+{
+	{ "mov",  &instruction::fsmov,  &instruction::fdmov },
+	{ "neg",  &instruction::fsneg,  &instruction::fdneg },
+	{ "abs",  &instruction::fsabs,  &instruction::fdabs },
+	{ "sqrt", &instruction::fssqrt, &instruction::fdsqrt }
+};
+
+// 128-bit vector operations with two sources
+typedef void (instruction::*vector_func)(void *, const void *, const void *);
+
+struct vector_op
+{
+	const char *    name;
+	vector_func     op;
+};
+
+static const vector_op s_vector_ops[] =
+{
+	{ "vaddw",   &instruction::vaddw },
+	{ "vaddsw",  &instruction::vaddsw },
+	{ "vsubw",   &instruction::vsubw },
+	{ "vsubsw",  &instruction::vsubsw },
+	{ "vminsw",  &instruction::vminsw },
+	{ "vmaxsw",  &instruction::vmaxsw },
+	{ "vcmpgtw", &instruction::vcmpgtw },
+	{ "vand",    &instruction::vand },
+	{ "vor",     &instruction::vor },
+	{ "vxor",    &instruction::vxor },
+	{ "vmullw",  &instruction::vmullw },
+	{ "vmulhw",  &instruction::vmulhw },
+	{ "vsatw",   &instruction::vsatw }
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  float_bits - return the raw bits of a floating
+//  point register at the given size
+//-------------------------------------------------
+
+static inline UINT64 float_bits(const drcuml_freg &reg, int size)
+{
+	if (size == 4)
+	{
+		UINT32 bits;
+		memcpy(&bits, &reg.s.l, sizeof(bits));
+		return bits;
+	}
+	UINT64 bits;
+	memcpy(&bits, &reg.d, sizeof(bits));
+	return bits;
+}
+
+
+//-------------------------------------------------
+//  float_matches - compare two floating point
+//  registers at the given size, treating all
+//  NaNs as equal
+//-------------------------------------------------
+
+static inline bool float_matches(const drcuml_freg &ref, const drcuml_freg &nat, int size)
+{
+	if (size == 4)
+		return (isnan(ref.s.l) && isnan(nat.s.l)) || float_bits(ref, size) == float_bits(nat, size);
+	return (isnan(ref.d) && isnan(nat.d)) || float_bits(ref, size) == float_bits(nat, size);
+}
+
+
+//-------------------------------------------------
+//  set_float - load a floating point register
+//  with a value at the given size
+//-------------------------------------------------
+
+static inline void set_float(drcuml_freg &reg, double value, int size)
+{
+	if (size == 4)
+		reg.s.l = float(value);
+	else
+		reg.d = value;
+}
+
+
+
+//**************************************************************************
+//  BACK-END UNDER TEST
+//**************************************************************************
+
+//-------------------------------------------------
+//  backend - constructor
+//-------------------------------------------------
+
+drcbe_conformance::backend::backend(device_t &device, UINT32 flags)
+	: m_cache(CACHE_SIZE),
+		m_drcuml(device, m_cache, flags, 1, 32, 0),
+		m_entry(m_drcuml.handle_alloc("test_entry")),
+		m_input(*(drcuml_machine_state *)m_cache.alloc_near(sizeof(m_input))),
+		m_output(*(drcuml_machine_state *)m_cache.alloc_near(sizeof(m_output))),
+		m_outflags(*(UINT32 *)m_cache.alloc_near(sizeof(m_outflags))),
+		m_scratch((UINT64 *)m_cache.alloc_near(sizeof(*m_scratch) * FUZZ_SCRATCH_QWORDS)),
+		m_vectors((INT16 *)m_cache.alloc_near(sizeof(*m_vectors) * (VECTOR_LANES + 1)) + 1)
+{
+}
+
+
+
+//**************************************************************************
+//  CONFORMANCE TESTER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcbe_conformance - constructor
+//-------------------------------------------------
+
+drcbe_conformance::drcbe_conformance(device_t &device)
+	: m_device(device),
+		m_reference(device, DRCUML_OPTION_USE_C),
+		m_native(device, DRCUML_OPTION_USE_NATIVE),
+		m_tests(0),
+		m_failures(0),
+		m_fuzzseed(1),
+		m_fuzzmemory(nullptr)
+{
+}
+
+
+//-------------------------------------------------
+//  ~drcbe_conformance - destructor
+//-------------------------------------------------
+
+drcbe_conformance::~drcbe_conformance()
+{
+}
+
+
+//-------------------------------------------------
+//  run_all - run every test suite
+//-------------------------------------------------
+
+void drcbe_conformance::run_all()
+{
+	test_integer_binary();
+	test_integer_unary();
+	test_compare();
+	test_multiply_divide();
+	test_rotate_mask();
+	test_float_binary();
+	test_float_unary();
+	test_float_convert();
+	test_vector();
+	test_invalidation(m_reference, "C");
+	test_invalidation(m_native, "native");
+	test_linking(m_reference, "C");
+	test_linking(m_native, "native");
+}
+
+
+//-------------------------------------------------
+//  init_state - fill a machine state with a
+//  recognizable pattern
+//-------------------------------------------------
+
+void drcbe_conformance::init_state(drcuml_machine_state &state, UINT8 flags)
+{
+	memset(&state, 0, sizeof(state));
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		state.r[regnum].d = U64(0xa5a5a5a500000000) | (regnum * 0x01010101);
+	for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+		state.f[regnum].d = 1000.0 + regnum;
+	state.exp = 0x12345678;
+	state.fmod = ROUND_ROUND;
+	state.flags = flags;
+}
+
+
+//-------------------------------------------------
+//  execute - generate and run a test block on a
+//  single back-end
+//-------------------------------------------------
+
+void drcbe_conformance::execute(backend &be, const drcuml_machine_state &input, const test_body &body, UINT8 flagmask, drcuml_machine_state &result, UINT32 &flags)
+{
+	// start from an empty cache so every test is generated fresh
+	be.m_drcuml.reset();
+
+	drcuml_block *block = be.m_drcuml.begin_block(32);
+	UML_HANDLE(block, *be.m_entry);
+	UML_RESTORE(block, &be.m_input);
+	body(*block);
+	UML_GETFLGS(block, mem(&be.m_outflags), flagmask);
+	UML_SAVE(block, &be.m_output);
+	UML_EXIT(block, 0);
+	block->end();
+
+	be.m_input = input;
+	be.m_outflags = 0;
+	be.m_drcuml.execute(*be.m_entry);
+	result = be.m_output;
+	flags = be.m_outflags;
+}
+
+
+//-------------------------------------------------
+//  run_test - run a test on both back-ends and
+//  report any differences; returns true if the
+//  results matched
+//-------------------------------------------------
+
+bool drcbe_conformance::run_test(const char *name, const drcuml_machine_state &input, int size, UINT8 flagmask, const test_body &body)
+{
+	drcuml_machine_state refstate, natstate;
+	UINT32 refflags, natflags;
+
+	execute(m_reference, input, body, flagmask, refstate, refflags);
+	execute(m_native, input, body, flagmask, natstate, natflags);
+	m_tests++;
+
+	int errors = compare_results(name, size, refstate, refflags, natstate, natflags);
+	if (errors != 0)
+		m_failures++;
+	return (errors == 0);
+}
+
+
+//-------------------------------------------------
+//  compare_results - report differences between
+//  two machine states; returns the number found
+//-------------------------------------------------
+
+int drcbe_conformance::compare_results(const char *name, int size, const drcuml_machine_state &expected, UINT32 expflags, const drcuml_machine_state &actual, UINT32 actflags)
+{
+	// only the low half of an integer register is defined after a 32-bit operation
+	UINT64 regmask = (size == 4) ? U64(0x00000000ffffffff) : U64(0xffffffffffffffff);
+	int errors = 0;
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		if (((expected.r[regnum].d ^ actual.r[regnum].d) & regmask) != 0)
+		{
+			osd_printf_error("%s: I%d = %016" I64FMT "X, expected %016" I64FMT "X\n", name, regnum, actual.r[regnum].d, expected.r[regnum].d);
+			errors++;
+		}
+	for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+		if (!float_matches(expected.f[regnum], actual.f[regnum], size))
+		{
+			osd_printf_error("%s: F%d = %" I64FMT "X, expected %" I64FMT "X\n", name, regnum, float_bits(actual.f[regnum], size), float_bits(expected.f[regnum], size));
+			errors++;
+		}
+	if (expflags != actflags)
+	{
+		osd_printf_error("%s: flags = %02X, expected %02X\n", name, actflags, expflags);
+		errors++;
+	}
+	if (expected.exp != actual.exp || expected.fmod != actual.fmod)
+	{
+		osd_printf_error("%s: exp/fmod = %08X/%d, expected %08X/%d\n", name, actual.exp, actual.fmod, expected.exp, expected.fmod);
+		errors++;
+	}
+	return errors;
+}
+
+
+//-------------------------------------------------
+//  test_integer_binary - ALU, shift and rotate
+//  operations with register, immediate and
+//  aliased operands
+//-------------------------------------------------
+
+void drcbe_conformance::test_integer_binary()
+{
+	for (const binary_op &op : s_binary_ops)
+		for (int size = 4; size <= 8; size += 4)
+		{
+			const UINT64 *values = (size == 4) ? s_values32 : s_values64;
+			int numvalues = (size == 4) ? ARRAY_LENGTH(s_values32) : ARRAY_LENGTH(s_values64);
+			const UINT64 *src2values = op.shift ? s_shifts : values;
+			int numsrc2 = op.shift ? ARRAY_LENGTH(s_shifts) : numvalues;
+			binary_func func = (size == 4) ? op.op32 : op.op64;
+
+			for (int carry = 0; carry <= ((op.inflags & FLAG_C) ? 1 : 0); carry++)
+				for (int index1 = 0; index1 < numvalues; index1++)
+					for (int index2 = 0; index2 < numsrc2; index2++)
+					{
+						UINT64 src1 = values[index1];
+						UINT64 src2 = src2values[index2];
+						drcuml_machine_state input;
+						init_state(input, carry ? FLAG_C : 0);
+						input.r[1].d = src1;
+						input.r[2].d = src2;
+
+						// flags after a shift by zero are left to the back-end
+						UINT8 outflags = (op.shift && (src2 & (size * 8 - 1)) == 0) ? 0 : op.outflags;
+
+						std::string name = strformat("%s%s %" I64FMT "X,%" I64FMT "X C=%d", (size == 4) ? "" : "d", op.name, src1, src2, carry);
+						run_test((name + " [reg]").c_str(), input, size, outflags, [=](drcuml_block &block) { (block.append().*func)(I0, I1, I2); });
+						run_test((name + " [imm]").c_str(), input, size, outflags, [=](drcuml_block &block) { (block.append().*func)(I0, I1, src2); });
+						run_test((name + " [alias]").c_str(), input, size, outflags, [=](drcuml_block &block) { (block.append().*func)(I1, I1, I2); });
+					}
+		}
+}
+
+
+//-------------------------------------------------
+//  test_integer_unary - LZCNT, BSWAP, SEXT and
+//  CARRY
+//-------------------------------------------------
+
+void drcbe_conformance::test_integer_unary()
+{
+	for (int size = 4; size <= 8; size += 4)
+	{
+		const UINT64 *values = (size == 4) ? s_values32 : s_values64;
+		int numvalues = (size == 4) ? ARRAY_LENGTH(s_values32) : ARRAY_LENGTH(s_values64);
+
+		for (int index = 0; index < numvalues; index++)
+		{
+			UINT64 src = values[index];
+			drcuml_machine_state input;
+			init_state(input);
+			input.r[1].d = src;
+
+			for (const unary_op &op : s_unary_ops)
+			{
+				unary_func func = (size == 4) ? op.op32 : op.op64;
+				std::string name = strformat("%s%s %" I64FMT "X", (size == 4) ? "" : "d", op.name, src);
+				run_test(name.c_str(), input, size, op.outflags, [=](drcuml_block &block) { (block.append().*func)(I0, I1); });
+			}
+
+			for (operand_size srcsize = SIZE_BYTE; srcsize < ((size == 4) ? SIZE_DWORD : SIZE_QWORD); srcsize = operand_size(srcsize + 1))
+			{
+				std::string name = strformat("%ssext %" I64FMT "X,%d", (size == 4) ? "" : "d", src, 1 << srcsize);
+				if (size == 4)
+					run_test(name.c_str(), input, size, FLAG_S | FLAG_Z, [=](drcuml_block &block) { block.append().sext(I0, I1, srcsize); });
+				else
+					run_test(name.c_str(), input, size, FLAG_S | FLAG_Z, [=](drcuml_block &block) { block.append().dsext(I0, I1, srcsize); });
+			}
+
+			for (UINT64 bitnum : s_shifts)
+			{
+				std::string name = strformat("%scarry %" I64FMT "X,%d", (size == 4) ? "" : "d", src, int(bitnum));
+				if (size == 4)
+					run_test(name.c_str(), input, size, FLAG_C, [=](drcuml_block &block) { block.append().carry(I1, bitnum); });
+				else
+					run_test(name.c_str(), input, size, FLAG_C, [=](drcuml_block &block) { block.append().dcarry(I1, bitnum); });
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  test_compare - CMP and TEST flags, and every
+//  integer condition through SET and MOV
+//-------------------------------------------------
+
+void drcbe_conformance::test_compare()
+{
+	for (int size = 4; size <= 8; size += 4)
+	{
+		const UINT64 *values = (size == 4) ? s_values32 : s_values64;
+		int numvalues = (size == 4) ? ARRAY_LENGTH(s_values32) : ARRAY_LENGTH(s_values64);
+
+		for (int index1 = 0; index1 < numvalues; index1++)
+			for (int index2 = 0; index2 < numvalues; index2++)
+			{
+				UINT64 src1 = values[index1];
+				UINT64 src2 = values[index2];
+				drcuml_machine_state input;
+				init_state(input);
+				input.r[1].d = src1;
+				input.r[2].d = src2;
+
+				for (const compare_op &op : s_compare_ops)
+				{
+					compare_func func = (size == 4) ? op.op32 : op.op64;
+					std::string name = strformat("%s%s %" I64FMT "X,%" I64FMT "X", (size == 4) ? "" : "d", op.name, src1, src2);
+					run_test(name.c_str(), input, size, op.outflags, [=](drcuml_block &block) { (block.append().*func)(I1, I2); });
+				}
+
+				for (condition_t cond : s_int_conditions)
+				{
+					std::string name = strformat("%sset/mov cond=%02X %" I64FMT "X,%" I64FMT "X", (size == 4) ? "" : "d", cond, src1, src2);
+					if (size == 4)
+						run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().cmp(I1, I2); block.append().set(cond, I0); block.append().mov(cond, I3, I1); });
+					else
+						run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().dcmp(I1, I2); block.append().dset(cond, I0); block.append().dmov(cond, I3, I1); });
+				}
+			}
+	}
+}
+
+
+//-------------------------------------------------
+//  test_multiply_divide - MULU, MULS, DIVU and
+//  DIVS including division by zero
+//-------------------------------------------------
+
+void drcbe_conformance::test_multiply_divide()
+{
+	for (const muldiv_op &op : s_muldiv_ops)
+		for (int size = 4; size <= 8; size += 4)
+		{
+			const UINT64 *values = (size == 4) ? s_values32 : s_values64;
+			int numvalues = (size == 4) ? ARRAY_LENGTH(s_values32) : ARRAY_LENGTH(s_values64);
+			UINT64 minint = (size == 4) ? 0x80000000 : U64(0x8000000000000000);
+			UINT64 minus1 = (size == 4) ? 0xffffffff : U64(0xffffffffffffffff);
+			muldiv_func func = (size == 4) ? op.op32 : op.op64;
+
+			for (int index1 = 0; index1 < numvalues; index1++)
+				for (int index2 = 0; index2 < numvalues; index2++)
+				{
+					UINT64 src1 = values[index1];
+					UINT64 src2 = values[index2];
+
+					// the most negative number divided by -1 traps on the host
+					if (op.divide && op.is_signed && src1 == minint && src2 == minus1)
+						continue;
+
+					drcuml_machine_state input;
+					init_state(input);
+					input.r[1].d = src1;
+					input.r[2].d = src2;
+
+					std::string name = strformat("%s%s %" I64FMT "X,%" I64FMT "X", (size == 4) ? "" : "d", op.name, src1, src2);
+					run_test(name.c_str(), input, size, FLAG_S | FLAG_Z | FLAG_V, [=](drcuml_block &block) { (block.append().*func)(I0, I3, I1, I2); });
+					run_test((name + " [lo]").c_str(), input, size, op.divide ? (FLAG_S | FLAG_Z | FLAG_V) : FLAG_V, [=](drcuml_block &block) { (block.append().*func)(I0, I0, I1, I2); });
+				}
+		}
+}
+
+
+//-------------------------------------------------
+//  test_rotate_mask - ROLAND and ROLINS
+//-------------------------------------------------
+
+void drcbe_conformance::test_rotate_mask()
+{
+	for (const rotmask_op &op : s_rotmask_ops)
+		for (int size = 4; size <= 8; size += 4)
+		{
+			const UINT64 *values = (size == 4) ? s_values32 : s_values64;
+			int numvalues = (size == 4) ? ARRAY_LENGTH(s_values32) : ARRAY_LENGTH(s_values64);
+			UINT64 sizemask = (size == 4) ? 0xffffffff : U64(0xffffffffffffffff);
+			rotmask_func func = (size == 4) ? op.op32 : op.op64;
+
+			for (int index = 0; index < numvalues; index++)
+				for (UINT64 shift : s_shifts)
+					for (UINT64 mask : s_masks)
+					{
+						UINT64 src = values[index];
+						drcuml_machine_state input;
+						init_state(input);
+						input.r[1].d = src;
+						input.r[2].d = shift;
+
+						std::string name = strformat("%s%s %" I64FMT "X,%d,%" I64FMT "X", (size == 4) ? "" : "d", op.name, src, int(shift), mask & sizemask);
+						run_test(name.c_str(), input, size, FLAG_S | FLAG_Z, [=](drcuml_block &block) { (block.append().*func)(I0, I1, shift, mask & sizemask); });
+						run_test((name + " [reg]").c_str(), input, size, FLAG_S | FLAG_Z, [=](drcuml_block &block) { (block.append().*func)(I0, I1, I2, mask & sizemask); });
+					}
+		}
+}
+
+
+//-------------------------------------------------
+//  test_float_binary - floating point arithmetic
+//  and FCMP flags and conditions
+//-------------------------------------------------
+
+void drcbe_conformance::test_float_binary()
+{
+	for (int size = 4; size <= 8; size += 4)
+		for (double src1 : s_fvalues)
+			for (double src2 : s_fvalues)
+			{
+				drcuml_machine_state input;
+				init_state(input);
+				set_float(input.f[1], src1, size);
+				set_float(input.f[2], src2, size);
+
+				for (const float_binary_op &op : s_float_binary_ops)
+				{
+					binary_func func = (size == 4) ? op.ops : op.opd;
+					std::string name = strformat("f%s%s %g,%g", (size == 4) ? "s" : "d", op.name, src1, src2);
+					run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { (block.append().*func)(F0, F1, F2); });
+					run_test((name + " [alias]").c_str(), input, size, 0, [=](drcuml_block &block) { (block.append().*func)(F1, F1, F2); });
+				}
+
+				std::string name = strformat("f%scmp %g,%g", (size == 4) ? "s" : "d", src1, src2);
+				if (size == 4)
+					run_test(name.c_str(), input, size, FLAG_U | FLAG_Z | FLAG_C, [=](drcuml_block &block) { block.append().fscmp(F1, F2); });
+				else
+					run_test(name.c_str(), input, size, FLAG_U | FLAG_Z | FLAG_C, [=](drcuml_block &block) { block.append().fdcmp(F1, F2); });
+
+				for (condition_t cond : s_float_conditions)
+				{
+					std::string condname = strformat("%s set cond=%02X", name.c_str(), cond);
+					if (size == 4)
+						run_test(condname.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().fscmp(F1, F2); block.append().set(cond, I0); block.append().fsmov(cond, F3, F1); });
+					else
+						run_test(condname.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().fdcmp(F1, F2); block.append().dset(cond, I0); block.append().fdmov(cond, F3, F1); });
+				}
+			}
+}
+
+
+//-------------------------------------------------
+//  test_float_unary - FMOV, FNEG, FABS and FSQRT
+//-------------------------------------------------
+
+void drcbe_conformance::test_float_unary()
+{
+	for (int size = 4; size <= 8; size += 4)
+		for (double src : s_fvalues)
+		{
+			drcuml_machine_state input;
+			init_state(input);
+			set_float(input.f[1], src, size);
+
+			for (const float_unary_op &op : s_float_unary_ops)
+			{
+				unary_func func = (size == 4) ? op.ops : op.opd;
+				std::string name = strformat("f%s%s %g", (size == 4) ? "s" : "d", op.name, src);
+				run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { (block.append().*func)(F0, F1); });
+			}
+		}
+}
+
+
+//-------------------------------------------------
+//  test_float_convert - FTOINT, FFRINT, FFRFLT
+//  and FRNDS
+//-------------------------------------------------
+
+void drcbe_conformance::test_float_convert()
+{
+	static const float_rounding_mode rounding[] = { ROUND_TRUNC, ROUND_ROUND, ROUND_CEIL, ROUND_FLOOR };
+
+	for (int size = 4; size <= 8; size += 4)
+	{
+		// float to integer, at both integer sizes and every explicit rounding mode
+		for (double src : s_ftoint_values)
+		{
+			drcuml_machine_state input;
+			init_state(input);
+			set_float(input.f[1], src, size);
+
+			for (operand_size intsize = SIZE_DWORD; intsize <= SIZE_QWORD; intsize = operand_size(intsize + 1))
+				for (float_rounding_mode round : rounding)
+				{
+					std::string name = strformat("f%stoint %g,%d,%d", (size == 4) ? "s" : "d", src, 1 << intsize, round);
+					if (size == 4)
+						run_test(name.c_str(), input, 1 << intsize, 0, [=](drcuml_block &block) { block.append().fstoint(I0, F1, intsize, round); });
+					else
+						run_test(name.c_str(), input, 1 << intsize, 0, [=](drcuml_block &block) { block.append().fdtoint(I0, F1, intsize, round); });
+				}
+		}
+
+		// integer to float, from both integer sizes
+		for (int index = 0; index < ARRAY_LENGTH(s_values64); index++)
+		{
+			drcuml_machine_state input;
+			init_state(input);
+			input.r[1].d = s_values64[index];
+
+			for (operand_size intsize = SIZE_DWORD; intsize <= SIZE_QWORD; intsize = operand_size(intsize + 1))
+			{
+				std::string name = strformat("f%sfrint %" I64FMT "X,%d", (size == 4) ? "s" : "d", s_values64[index], 1 << intsize);
+				if (size == 4)
+					run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().fsfrint(F0, I1, intsize); });
+				else
+					run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().fdfrint(F0, I1, intsize); });
+			}
+		}
+
+		// float to float of the other size, and rounding to single precision
+		for (double src : s_fvalues)
+		{
+			drcuml_machine_state input;
+			init_state(input);
+			set_float(input.f[1], src, 12 - size);
+
+			std::string name = strformat("f%sfrflt %g", (size == 4) ? "s" : "d", src);
+			if (size == 4)
+				run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().fsfrflt(F0, F1, SIZE_QWORD); });
+			else
+			{
+				run_test(name.c_str(), input, size, 0, [=](drcuml_block &block) { block.append().fdfrflt(F0, F1, SIZE_DWORD); });
+
+				set_float(input.f[1], src / 3.0, size);
+				run_test(strformat("fdrnds %g", src / 3.0).c_str(), input, size, 0, [=](drcuml_block &block) { block.append().fdrnds(F0, F1); });
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  run_vector_test - run a vector test on both
+//  back-ends and compare every lane of operand
+//  memory afterwards
+//-------------------------------------------------
+
+bool drcbe_conformance::run_vector_test(const char *name, const INT16 *src1, const INT16 *src2, const vector_body &body)
+{
+	backend *const backends[] = { &m_reference, &m_native };
+	INT16 lanes[2][VECTOR_LANES];
+	for (int benum = 0; benum < 2; benum++)
+	{
+		backend &be = *backends[benum];
+		INT16 *vectors = be.m_vectors;
+		memset(vectors, 0, sizeof(*vectors) * 8);
+		memcpy(&vectors[8], src1, sizeof(*vectors) * 8);
+		memcpy(&vectors[16], src2, sizeof(*vectors) * 8);
+
+		drcuml_machine_state input, result;
+		UINT32 flags;
+		init_state(input);
+		execute(be, input, [&](drcuml_block &block) { body(block, &vectors[0], &vectors[8], &vectors[16]); }, 0, result, flags);
+		memcpy(lanes[benum], vectors, sizeof(lanes[benum]));
+	}
+	m_tests++;
+
+	int errors = 0;
+	for (int lane = 0; lane < VECTOR_LANES; lane++)
+		if (lanes[0][lane] != lanes[1][lane])
+		{
+			osd_printf_error("%s: lane %d = %04X, expected %04X\n", name, lane, (UINT16)lanes[1][lane], (UINT16)lanes[0][lane]);
+			errors++;
+		}
+	if (errors != 0)
+		m_failures++;
+	return (errors == 0);
+}
+
+
+//-------------------------------------------------
+//  test_vector - 128-bit vector operations on
+//  misaligned operands, including a destination
+//  that aliases a source
+//-------------------------------------------------
+
+void drcbe_conformance::test_vector()
+{
+	for (const INT16 *src1 : s_vvalues)
+	{
+		for (const INT16 *src2 : s_vvalues)
+			for (const vector_op &op : s_vector_ops)
+			{
+				vector_func func = op.op;
+				std::string name = strformat("%s %04X,%04X", op.name, (UINT16)src1[0], (UINT16)src2[0]);
+				run_vector_test(name.c_str(), src1, src2, [=](drcuml_block &block, INT16 *dst, INT16 *vs1, INT16 *vs2) { (block.append().*func)(dst, vs1, vs2); });
+				run_vector_test((name + " [alias]").c_str(), src1, src2, [=](drcuml_block &block, INT16 *dst, INT16 *vs1, INT16 *vs2) { (block.append().*func)(vs2, vs1, vs2); });
+			}
+
+		run_vector_test(strformat("vmov %04X", (UINT16)src1[0]).c_str(), src1, src1, [](drcuml_block &block, INT16 *dst, INT16 *vs1, INT16 *vs2) { block.append().vmov(dst, vs1); });
+		for (UINT32 sel : s_vshuffles)
+		{
+			std::string name = strformat("vshuf %04X,%08X", (UINT16)src1[0], sel);
+			run_vector_test(name.c_str(), src1, src1, [=](drcuml_block &block, INT16 *dst, INT16 *vs1, INT16 *vs2) { block.append().vshuf(dst, vs1, sel); });
+			run_vector_test((name + " [alias]").c_str(), src1, src1, [=](drcuml_block &block, INT16 *dst, INT16 *vs1, INT16 *vs2) { block.append().vshuf(vs1, vs1, sel); });
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  test_invalidation - check that invalidating a
+//  source range unlinks exactly the hash entries
+//  owned by blocks built from it
+//-------------------------------------------------
+
+void drcbe_conformance::test_invalidation(backend &be, const char *name)
+{
+	drcuml_state &drcuml = be.m_drcuml;
+	drcuml.reset();
+
+	// three blocks: the third takes over the first one's entry from another page
+	static const struct { offs_t pc, source; } blocks[] = { { 0x1000, 0x1000 }, { 0x3000, 0x3ffe }, { 0x1000, 0x5000 } };
+	for (auto &cur : blocks)
+	{
+		drcuml_block *block = drcuml.begin_block(8);
+		UML_HASH(block, 0, cur.pc);
+		UML_EXIT(block, 0);
+		block->add_source(cur.source, 4);
+		block->end();
+	}
+
+	// each step invalidates a range and lists the entries that must remain
+	static const struct { offs_t start, end; int unlinked; bool exists1000, exists3000; } steps[] =
+	{
+		{ 0x1000, 0x1fff, 1, true,  true  },    // the entry now belongs to the third block
+		{ 0x4000, 0x4003, 1, true,  false },    // the second block straddles two pages
+		{ 0x5ffc, 0x6fff, 1, false, false },
+		{ 0x0000, 0xffff, 0, false, false }
+	};
+	for (auto &step : steps)
+	{
+		int unlinked = drcuml.invalidate_code(step.start, step.end);
+		m_tests++;
+		if (unlinked != step.unlinked || drcuml.hash_exists(0, 0x1000) != step.exists1000 || drcuml.hash_exists(0, 0x3000) != step.exists3000)
+		{
+			osd_printf_error("%s invalidate %04X-%04X: unlinked %d blocks, entries %d/%d\n", name, step.start, step.end,
+					unlinked, drcuml.hash_exists(0, 0x1000), drcuml.hash_exists(0, 0x3000));
+			m_failures++;
+		}
+	}
+}
+
+
+
+//-------------------------------------------------
+//  test_linking - check that a HASHJMP to a fixed
+//  PC follows its target as it is generated,
+//  replaced and unlinked
+//-------------------------------------------------
+
+void drcbe_conformance::test_linking(backend &be, const char *name)
+{
+	drcuml_state &drcuml = be.m_drcuml;
+	drcuml.reset();
+
+	// the exception handler and the jump are generated before the target exists
+	code_handle &nocode = *drcuml.handle_alloc("test_nocode");
+	drcuml_block *block = drcuml.begin_block(8);
+	UML_HANDLE(block, nocode);
+	UML_MOV(block, mem(&be.m_outflags), 0xff);
+	UML_EXIT(block, 0);
+	block->end();
+
+	block = drcuml.begin_block(8);
+	UML_HANDLE(block, *be.m_entry);
+	UML_HASHJMP(block, 0, 0x2000, nocode);
+	block->end();
+
+	// each step generates a new target, or invalidates it if value is 0, then runs the jump
+	static const struct { UINT32 value, expected; } steps[] =
+	{
+		{ 0, 0xff },        // nothing there yet
+		{ 1, 1 },           // generated after the jump
+		{ 2, 2 },           // a newer block takes over the entry
+		{ 0, 0xff },        // unlinked
+		{ 3, 3 }            // generated again
+	};
+	for (auto &step : steps)
+	{
+		if (step.value == 0)
+			drcuml.invalidate_code(0x2000, 0x2003);
+		else
+		{
+			block = drcuml.begin_block(8);
+			UML_HASH(block, 0, 0x2000);
+			UML_MOV(block, mem(&be.m_outflags), step.value);
+			UML_EXIT(block, 0);
+			block->add_source(0x2000, 4);
+			block->end();
+		}
+
+		be.m_outflags = 0;
+		drcuml.execute(*be.m_entry);
+		m_tests++;
+		if (be.m_outflags != step.expected)
+		{
+			osd_printf_error("%s linking: jump reached %02X, expected %02X\n", name, be.m_outflags, step.expected);
+			m_failures++;
+		}
+	}
+}
+
+
+//**************************************************************************
+//  RANDOM BLOCKS
+//**************************************************************************
+
+//-------------------------------------------------
+//  run_fuzz - run randomly generated blocks on
+//  both back-ends
+//-------------------------------------------------
+
+void drcbe_conformance::run_fuzz(UINT32 seed, int blocks)
+{
+	m_fuzzseed = (seed != 0) ? seed : 1;
+
+	for (int blocknum = 0; blocknum < blocks; blocknum++)
+	{
+		std::vector<instruction> insts;
+		drcuml_machine_state input;
+		UINT8 defined;
+		int size = fuzz_block(insts, input, defined);
+
+		std::string name = strformat("fuzz seed %u block %d", seed, blocknum);
+		if (!run_test(name.c_str(), input, size, defined, [insts](drcuml_block &block) { for (const instruction &inst : insts) block.append() = inst; }))
+			for (const instruction &inst : insts)
+				osd_printf_error("    %s\n", inst.disasm(&m_reference.m_drcuml).c_str());
+	}
+}
+
+
+//-------------------------------------------------
+//  run_optimizer_fuzz - run random blocks with
+//  memory operands through each back-end with
+//  and without the UML optimizer
+//-------------------------------------------------
+
+void drcbe_conformance::run_optimizer_fuzz(UINT32 seed, int blocks)
+{
+	backend *const backends[] = { &m_reference, &m_native };
+	for (backend *be : backends)
+	{
+		const char *bename = (be == &m_reference) ? "C" : "native";
+		drcuml_optimizer &optimizer = be->m_drcuml.optimizer();
+		UINT32 passes = optimizer.passes();
+		m_fuzzseed = (seed != 0) ? seed : 1;
+		m_fuzzmemory = be->m_scratch;
+
+		for (int blocknum = 0; blocknum < blocks; blocknum++)
+		{
+			std::vector<instruction> insts;
+			drcuml_machine_state input;
+			UINT8 defined;
+			int size = fuzz_block(insts, input, defined);
+			UINT64 memory[FUZZ_SCRATCH_QWORDS];
+			for (UINT64 &value : memory)
+				value = ((UINT64)fuzz_random(0x10000) << 48) ^ ((UINT64)fuzz_random(0x10000) << 24) ^ fuzz_random(0x1000000);
+
+			// half of the blocks run every pass, the rest a random selection
+			UINT32 enabled = (fuzz_random(2) != 0) ? drcuml_optimizer::PASS_ALL : fuzz_random(drcuml_optimizer::PASS_ALL + 1);
+			test_body body = [&insts](drcuml_block &block) { for (const instruction &inst : insts) block.append() = inst; };
+
+			drcuml_machine_state expected, actual;
+			UINT32 expflags, actflags;
+			UINT64 expmemory[FUZZ_SCRATCH_QWORDS];
+			optimizer.set_passes(0);
+			memcpy(be->m_scratch, memory, sizeof(memory));
+			execute(*be, input, body, defined, expected, expflags);
+			memcpy(expmemory, be->m_scratch, sizeof(expmemory));
+			optimizer.set_passes(enabled);
+			memcpy(be->m_scratch, memory, sizeof(memory));
+			execute(*be, input, body, defined, actual, actflags);
+			m_tests++;
+
+			std::string name = strformat("optimizer %s seed %u block %d passes %X", bename, seed, blocknum, enabled);
+			int errors = compare_results(name.c_str(), size, expected, expflags, actual, actflags);
+			for (int index = 0; index < FUZZ_SCRATCH_QWORDS; index++)
+				if (be->m_scratch[index] != expmemory[index])
+				{
+					osd_printf_error("%s: memory %d = %016" I64FMT "X, expected %016" I64FMT "X\n", name.c_str(), index, be->m_scratch[index], expmemory[index]);
+					errors++;
+				}
+			if (errors != 0)
+			{
+				m_failures++;
+				for (const instruction &inst : insts)
+					osd_printf_error("    %s\n", inst.disasm(&be->m_drcuml).c_str());
+			}
+		}
+		optimizer.set_passes(passes);
+	}
+	m_fuzzmemory = nullptr;
+
+	osd_printf_info("%s", m_native.m_drcuml.optimizer().stats_string().c_str());
+}
+
+
+//-------------------------------------------------
+//  fuzz_block - build a random block and a random
+//  starting state for it; returns the operation
+//  size and sets the flags defined at the end
+//-------------------------------------------------
+
+int drcbe_conformance::fuzz_block(std::vector<instruction> &insts, drcuml_machine_state &input, UINT8 &defined)
+{
+	int size = (fuzz_random(2) != 0) ? 8 : 4;
+
+	// RESTORE loads every flag, so all of them start out defined
+	defined = FLAG_C | FLAG_V | FLAG_Z | FLAG_S | FLAG_U;
+	insts.resize(1 + fuzz_random(FUZZ_MAX_INSTRUCTIONS));
+	for (instruction &inst : insts)
+		defined = fuzz_instruction(inst, size, defined);
+
+	// start from random register contents and flags
+	init_state(input, fuzz_random(0x20));
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		input.r[regnum].d = ((UINT64)fuzz_random(0x10000) << 48) ^ ((UINT64)fuzz_random(0x10000) << 24) ^ fuzz_random(0x1000000);
+	for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+		set_float(input.f[regnum], (double)((INT32)fuzz_random(2000000) - 1000000) / 1000.0, size);
+	return size;
+}
+
+
+//-------------------------------------------------
+//  fuzz_random - return a pseudo-random number
+//  in the range 0..range-1
+//-------------------------------------------------
+
+UINT32 drcbe_conformance::fuzz_random(UINT32 range)
+{
+	// xorshift32, so blocks are reproducible from the seed alone
+	m_fuzzseed ^= m_fuzzseed << 13;
+	m_fuzzseed ^= m_fuzzseed >> 17;
+	m_fuzzseed ^= m_fuzzseed << 5;
+	return m_fuzzseed % range;
+}
+
+
+//-------------------------------------------------
+//  fuzz_ireg/fuzz_freg - pick a random integer
+//  or floating point register
+//-------------------------------------------------
+
+parameter drcbe_conformance::fuzz_ireg()
+{
+	return parameter::make_ireg(REG_I0 + fuzz_random(REG_I_COUNT));
+}
+
+parameter drcbe_conformance::fuzz_freg()
+{
+	return parameter::make_freg(REG_F0 + fuzz_random(REG_F_COUNT));
+}
+
+
+//-------------------------------------------------
+//  fuzz_idst - pick a random integer destination,
+//  sometimes in memory if the generator has any
+//-------------------------------------------------
+
+parameter drcbe_conformance::fuzz_idst(int size)
+{
+	if (m_fuzzmemory != nullptr && fuzz_random(4) == 0)
+		return fuzz_memory(size);
+	return fuzz_ireg();
+}
+
+
+//-------------------------------------------------
+//  fuzz_isrc - pick a random integer source,
+//  mostly registers with some immediates and,
+//  if the generator has any, memory
+//-------------------------------------------------
+
+parameter drcbe_conformance::fuzz_isrc(int size)
+{
+	if (m_fuzzmemory != nullptr && fuzz_random(4) == 0)
+		return fuzz_memory(size);
+
+	switch (fuzz_random(8))
+	{
+		case 0:
+			return (size == 4) ? s_values32[fuzz_random(ARRAY_LENGTH(s_values32))] : s_values64[fuzz_random(ARRAY_LENGTH(s_values64))];
+
+		case 1:
+			return ((UINT64)fuzz_random(0x10000) << 48) | ((UINT64)fuzz_random(0x1000000) << 24) | fuzz_random(0x1000000);
+
+		default:
+			return fuzz_ireg();
+	}
+}
+
+
+//-------------------------------------------------
+//  fuzz_memory - pick a random memory operand of
+//  the given size; 32-bit operands may overlap
+//  either half of a 64-bit one
+//-------------------------------------------------
+
+parameter drcbe_conformance::fuzz_memory(int size)
+{
+	if (size == 4)
+		return mem(reinterpret_cast<UINT32 *>(m_fuzzmemory) + fuzz_random(FUZZ_SCRATCH_QWORDS * 2));
+	return mem(&m_fuzzmemory[fuzz_random(FUZZ_SCRATCH_QWORDS)]);
+}
+
+
+//-------------------------------------------------
+//  fuzz_condition - pick a random condition that
+//  only reads defined flags, or COND_ALWAYS if
+//  there is none
+//-------------------------------------------------
+
+condition_t drcbe_conformance::fuzz_condition(UINT8 defined)
+{
+	condition_t eligible[ARRAY_LENGTH(s_condition_flags)];
+	int count = 0;
+	for (const condition_info &info : s_condition_flags)
+		if ((info.flags & ~defined) == 0)
+			eligible[count++] = info.cond;
+	return (count != 0) ? eligible[fuzz_random(count)] : COND_ALWAYS;
+}
+
+
+//-------------------------------------------------
+//  fuzz_instruction - fill in a random instruction
+//  that only consumes defined flags; returns the
+//  flags defined after it
+//-------------------------------------------------
+
+UINT8 drcbe_conformance::fuzz_instruction(instruction &inst, int size, UINT8 defined)
+{
+	// flags the instruction defines; cleared below for results left to the back-end
+	bool trust_outflags = true;
+
+	switch (fuzz_random(10))
+	{
+		// ALU, shift and rotate
+		case 0:
+		case 1:
+		{
+			const binary_op *op;
+			do
+				op = &s_binary_ops[fuzz_random(ARRAY_LENGTH(s_binary_ops))];
+			while ((op->inflags & ~defined) != 0);
+			binary_func func = (size == 4) ? op->op32 : op->op64;
+
+			if (!op->shift)
+				(inst.*func)(fuzz_idst(size), fuzz_isrc(size), fuzz_isrc(size));
+			else if (fuzz_random(2) != 0)
+				(inst.*func)(fuzz_idst(size), fuzz_isrc(size), 1 + fuzz_random(size * 8 - 1));
+			else
+			{
+				// the count might be zero after masking
+				(inst.*func)(fuzz_idst(size), fuzz_isrc(size), fuzz_ireg());
+				trust_outflags = false;
+			}
+			if (trust_outflags)
+				return (defined & ~inst.modified_flags()) | op->outflags;
+			break;
+		}
+
+		// compares
+		case 2:
+		{
+			const compare_op &op = s_compare_ops[fuzz_random(ARRAY_LENGTH(s_compare_ops))];
+			(inst.*((size == 4) ? op.op32 : op.op64))(fuzz_isrc(size), fuzz_isrc(size));
+			break;
+		}
+
+		// LZCNT, BSWAP, SEXT and CARRY
+		case 3:
+			switch (fuzz_random(4))
+			{
+				case 0:
+				case 1:
+				{
+					const unary_op &op = s_unary_ops[fuzz_random(ARRAY_LENGTH(s_unary_ops))];
+					(inst.*((size == 4) ? op.op32 : op.op64))(fuzz_idst(size), fuzz_isrc(size));
+					break;
+				}
+
+				case 2:
+				{
+					operand_size srcsize = operand_size(SIZE_BYTE + fuzz_random((size == 4) ? 2 : 3));
+					if (size == 4)
+						inst.sext(fuzz_idst(size), fuzz_isrc(size), srcsize);
+					else
+						inst.dsext(fuzz_idst(size), fuzz_isrc(size), srcsize);
+					break;
+				}
+
+				default:
+					if (size == 4)
+						inst.carry(fuzz_isrc(size), fuzz_random(32));
+					else
+						inst.dcarry(fuzz_isrc(size), fuzz_random(64));
+					break;
+			}
+			break;
+
+		// multiply and divide
+		case 4:
+		{
+			const muldiv_op &op = s_muldiv_ops[fuzz_random(ARRAY_LENGTH(s_muldiv_ops))];
+			parameter dst = fuzz_idst(size);
+			parameter edst = fuzz_idst(size);
+
+			// the most negative number divided by -1 traps on the host
+			parameter src2 = (op.divide && op.is_signed) ? parameter(UINT64(s_fuzz_divisors[fuzz_random(ARRAY_LENGTH(s_fuzz_divisors))])) : fuzz_isrc(size);
+			(inst.*((size == 4) ? op.op32 : op.op64))(dst, edst, fuzz_isrc(size), src2);
+
+			// only V is defined when a multiply keeps just the low half
+			if (!op.divide && dst == edst)
+				return (defined & ~inst.modified_flags()) | FLAG_V;
+			break;
+		}
+
+		// ROLAND and ROLINS
+		case 5:
+		{
+			const rotmask_op &op = s_rotmask_ops[fuzz_random(ARRAY_LENGTH(s_rotmask_ops))];
+			parameter shift = (fuzz_random(2) != 0) ? parameter(fuzz_random(size * 8)) : fuzz_ireg();
+			UINT64 mask = s_masks[fuzz_random(ARRAY_LENGTH(s_masks))] & ((size == 4) ? 0xffffffff : U64(0xffffffffffffffff));
+			(inst.*((size == 4) ? op.op32 : op.op64))(fuzz_idst(size), fuzz_isrc(size), shift, mask);
+			break;
+		}
+
+		// conditional moves and SET
+		case 6:
+		{
+			condition_t cond = fuzz_condition(defined);
+			if (fuzz_random(2) != 0)
+			{
+				if (size == 4)
+					inst.mov(cond, fuzz_idst(size), fuzz_isrc(size));
+				else
+					inst.dmov(cond, fuzz_idst(size), fuzz_isrc(size));
+			}
+			else if (cond != COND_ALWAYS)
+			{
+				if (size == 4)
+					inst.set(cond, fuzz_idst(size));
+				else
+					inst.dset(cond, fuzz_idst(size));
+			}
+			else if (size == 4)
+				inst.fsmov(fuzz_freg(), fuzz_freg());
+			else
+				inst.fdmov(fuzz_freg(), fuzz_freg());
+			break;
+		}
+
+		// floating point arithmetic
+		case 7:
+		{
+			const float_binary_op &op = s_float_binary_ops[fuzz_random(ARRAY_LENGTH(s_float_binary_ops))];
+			(inst.*((size == 4) ? op.ops : op.opd))(fuzz_freg(), fuzz_freg(), fuzz_freg());
+			break;
+		}
+
+		// floating point unary operations and conditional moves
+		case 8:
+			if (fuzz_random(4) != 0)
+			{
+				const float_unary_op &op = s_float_unary_ops[fuzz_random(ARRAY_LENGTH(s_float_unary_ops))];
+				(inst.*((size == 4) ? op.ops : op.opd))(fuzz_freg(), fuzz_freg());
+			}
+			else if (size == 4)
+				inst.fsmov(fuzz_condition(defined), fuzz_freg(), fuzz_freg());
+			else
+				inst.fdmov(fuzz_condition(defined), fuzz_freg(), fuzz_freg());
+			break;
+
+		// floating point compares and integer conversion
+		default:
+			if (fuzz_random(2) != 0)
+			{
+				if (size == 4)
+					inst.fscmp(fuzz_freg(), fuzz_freg());
+				else
+					inst.fdcmp(fuzz_freg(), fuzz_freg());
+
+				// Z and C are left to the back-end if either operand is a NaN
+				return (defined & ~inst.modified_flags()) | FLAG_U;
+			}
+			else
+			{
+				// the upper half of an integer register is undefined in a 32-bit block
+				operand_size intsize = (size == 4 || fuzz_random(2) != 0) ? SIZE_DWORD : SIZE_QWORD;
+				if (size == 4)
+					inst.fsfrint(fuzz_freg(), fuzz_isrc(size), intsize);
+				else
+					inst.fdfrint(fuzz_freg(), fuzz_isrc(size), intsize);
+			}
+			break;
+	}
+
+	return (defined & ~inst.modified_flags()) | (trust_outflags ? inst.output_flags() : 0);
+}
+
+
+
+//**************************************************************************
+//  BENCHMARKING
+//**************************************************************************
+
+//-------------------------------------------------
+//  run_benchmark - report the speed of generated
+//  code on both back-ends
+//-------------------------------------------------
+
+void drcbe_conformance::run_benchmark(int iterations)
+{
+	double reference = measure_throughput(m_reference, iterations);
+	double native = measure_throughput(m_native, iterations);
+
+	osd_printf_info("C back-end:      %8.1f million UML instructions/second\n", reference / 1000000.0);
+	osd_printf_info("native back-end: %8.1f million UML instructions/second (%.1fx)\n", native / 1000000.0, native / reference);
+}
+
+
+//-------------------------------------------------
+//  measure_throughput - time a loop of typical
+//  recompiler output; returns UML instructions
+//  executed per second
+//-------------------------------------------------
+
+double drcbe_conformance::measure_throughput(backend &be, int iterations)
+{
+	// roughly what a front-end emits for a few guest ALU and FPU instructions;
+	// generating the block is included in the time but is negligible
+	static const int LOOP_INSTRUCTIONS = 16;
+	test_body body = [iterations](drcuml_block &block)
+	{
+		block.append().mov(I0, iterations);
+		block.append().label(1);
+		block.append().add(I1, I1, I2);
+		block.append()._and(I3, I1, 0xff);
+		block.append().shl(I4, I3, 2);
+		block.append().dxor(I5, I5, I4);
+		block.append().roland(I6, I1, 8, 0xff00);
+		block.append().cmp(I1, I6);
+		block.append().mov(COND_A, I7, I1);
+		block.append()._or(I8, I7, I3);
+		block.append().sub(I9, I9, I8);
+		block.append().mulu(I2, I2, I2, 0x41c64e6d);
+		block.append().fsadd(F0, F0, F1);
+		block.append().fsmul(F2, F0, F3);
+		block.append().fdsub(F4, F4, F5);
+		block.append().fdmov(F6, F4);
+		block.append().sub(I0, I0, 1);
+		block.append().jmp(COND_NZ, 1);
+	};
+
+	drcuml_machine_state input, result;
+	UINT32 flags;
+	init_state(input);
+	osd_ticks_t start = osd_ticks();
+	execute(be, input, body, 0, result, flags);
+	osd_ticks_t elapsed = osd_ticks() - start;
+
+	return (double)iterations * LOOP_INSTRUCTIONS * (double)osd_ticks_per_second() / (double)((elapsed != 0) ? elapsed : 1);
+}
@@ -0,0 +1,115 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbetest.h
+
+    Conformance tests comparing UML back-ends against each other.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCBETEST_H__
+#define __DRCBETEST_H__
+
+#include "drcuml.h"
+
+#include <functional>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> drcbe_conformance
+
+// runs UML blocks through the C back-end and the native back-end and
+// compares the resulting machine state
+class drcbe_conformance
+{
+public:
+	// construction/destruction
+	drcbe_conformance(device_t &device);
+	~drcbe_conformance();
+
+	// getters
+	int tests() const { return m_tests; }
+	int failures() const { return m_failures; }
+
+	// test execution
+	void run_all();
+	void run_fuzz(UINT32 seed, int blocks);
+	void run_optimizer_fuzz(UINT32 seed, int blocks);
+	void run_benchmark(int iterations);
+
+private:
+	// a test body appends UML between restoring and saving the machine state
+	typedef std::function<void (drcuml_block &block)> test_body;
+
+	// a vector test body is handed its back-end's destination and source operands
+	typedef std::function<void (drcuml_block &block, INT16 *dst, INT16 *src1, INT16 *src2)> vector_body;
+
+	// one back-end under test, with its own code cache; the state the
+	// generated code touches lives in the near cache like a CPU core's
+	class backend
+	{
+	public:
+		backend(device_t &device, UINT32 flags);
+
+		drc_cache               m_cache;            // code cache for this back-end
+		drcuml_state            m_drcuml;           // UML state feeding the back-end
+		uml::code_handle *      m_entry;            // entry point of the block under test
+		drcuml_machine_state &  m_input;            // state restored at the start of each block
+		drcuml_machine_state &  m_output;           // state saved at the end of each block
+		UINT32 &                m_outflags;         // flags captured at the end of each block
+		UINT64 *                m_scratch;          // memory operands for random blocks
+		INT16 *                 m_vectors;          // vector operands, deliberately misaligned
+	};
+
+	// test helpers
+	void init_state(drcuml_machine_state &state, UINT8 flags = 0);
+	void execute(backend &be, const drcuml_machine_state &input, const test_body &body, UINT8 flagmask, drcuml_machine_state &result, UINT32 &flags);
+	bool run_test(const char *name, const drcuml_machine_state &input, int size, UINT8 flagmask, const test_body &body);
+	bool run_vector_test(const char *name, const INT16 *src1, const INT16 *src2, const vector_body &body);
+	int compare_results(const char *name, int size, const drcuml_machine_state &expected, UINT32 expflags, const drcuml_machine_state &actual, UINT32 actflags);
+
+	// test suites
+	void test_integer_binary();
+	void test_integer_unary();
+	void test_compare();
+	void test_multiply_divide();
+	void test_rotate_mask();
+	void test_float_binary();
+	void test_float_unary();
+	void test_float_convert();
+	void test_vector();
+	void test_invalidation(backend &be, const char *name);
+	void test_linking(backend &be, const char *name);
+
+	// random block generation
+	UINT32 fuzz_random(UINT32 range);
+	uml::parameter fuzz_ireg();
+	uml::parameter fuzz_freg();
+	uml::parameter fuzz_idst(int size);
+	uml::parameter fuzz_isrc(int size);
+	uml::parameter fuzz_memory(int size);
+	int fuzz_block(std::vector<uml::instruction> &insts, drcuml_machine_state &input, UINT8 &defined);
+	uml::condition_t fuzz_condition(UINT8 defined);
+	UINT8 fuzz_instruction(uml::instruction &inst, int size, UINT8 defined);
+
+	// benchmarking
+	double measure_throughput(backend &be, int iterations);
+
+	// internal state
+	device_t &              m_device;           // device that owns the back-ends
+	backend                 m_reference;        // C back-end, used as the reference
+	backend                 m_native;           // native back-end being checked
+	int                     m_tests;            // number of tests run
+	int                     m_failures;         // number of mismatches found
+	UINT32                  m_fuzzseed;         // state of the random block generator
+	UINT64 *                m_fuzzmemory;       // memory operands for the generator, or nullptr for none
+};
+
+
+#endif /* __DRCBETEST_H__ */
@@ -188,6 +188,19 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 }
 
 
+//-------------------------------------------------
+//  unlink - point the given mode/pc back at the
+//  missing code handler
+//-------------------------------------------------
+
+void drc_hash_table::unlink(UINT32 mode, UINT32 pc)
+{
+	// an entry with code always lives in tables of its own, never the shared empty ones
+	if (code_exists(mode, pc))
+		m_base[mode][(pc >> m_l1shift) & m_l1mask][(pc >> m_l2shift) & m_l2mask] = m_nocodeptr;
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
@@ -149,6 +149,19 @@
     Entry stack:
         [rsp]      - return
 
+    Block linking:
+        A HASHJMP to a fixed mode and PC is a 6-byte call site.  While
+        the target has no code it calls through the hash table entry,
+        [rbp+disp32], so the missing code handler returns to it.  Once
+        the target is generated the site is patched into a direct call
+        rel32 followed by a NOP, and it is patched back whenever the
+        entry is unlinked or taken over by a newer block.  Both forms
+        have the same length, so the return address never moves.
+
+    Profiling:
+        With -drc_profile, every HASH entry point increments a 64-bit
+        counter in the cache, using RAX so that the flags survive.
+
     Runtime stack:
         [rsp]      - r9 home
         [rsp+8]    - r8 home
@@ -183,6 +196,8 @@ using namespace x64emit;
 
 #define LOG_HASHJMPS            (0)
 
+#define USE_BLOCK_LINKING       (1)
+
 #define USE_RCPSS_FOR_SINGLES   (0)
 #define USE_RSQRTSS_FOR_SINGLES (0)
 #define USE_RCPSS_FOR_DOUBLES   (0)
@@ -194,6 +209,9 @@ using namespace x64emit;
 //  CONSTANTS
 //**************************************************************************
 
+// size of a patchable HASHJMP call site
+const int LINK_SITE_SIZE = 6;
+
 const UINT32 PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
 const UINT32 PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
 const UINT32 PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
@@ -388,7 +406,24 @@ const drcbe_x64::opcode_table_entry drcbe_x64::s_opcode_table_source[] =
 	{ uml::OP_FABS,    &drcbe_x64::op_fabs },       // FABS    dst,src1
 	{ uml::OP_FSQRT,   &drcbe_x64::op_fsqrt },      // FSQRT   dst,src1
 	{ uml::OP_FRECIP,  &drcbe_x64::op_frecip },     // FRECIP  dst,src1
-	{ uml::OP_FRSQRT,  &drcbe_x64::op_frsqrt }      // FRSQRT  dst,src1
+	{ uml::OP_FRSQRT,  &drcbe_x64::op_frsqrt },     // FRSQRT  dst,src1
+
+	// Vector Operations
+	{ uml::OP_VMOV,    &drcbe_x64::op_vmov },       // VMOV    dst,src1
+	{ uml::OP_VSHUF,   &drcbe_x64::op_vshuf },      // VSHUF   dst,src1,sel
+	{ uml::OP_VADDW,   &drcbe_x64::op_varith },     // VADDW   dst,src1,src2
+	{ uml::OP_VADDSW,  &drcbe_x64::op_varith },     // VADDSW  dst,src1,src2
+	{ uml::OP_VSUBW,   &drcbe_x64::op_varith },     // VSUBW   dst,src1,src2
+	{ uml::OP_VSUBSW,  &drcbe_x64::op_varith },     // VSUBSW  dst,src1,src2
+	{ uml::OP_VMINSW,  &drcbe_x64::op_varith },     // VMINSW  dst,src1,src2
+	{ uml::OP_VMAXSW,  &drcbe_x64::op_varith },     // VMAXSW  dst,src1,src2
+	{ uml::OP_VCMPGTW, &drcbe_x64::op_varith },     // VCMPGTW dst,src1,src2
+	{ uml::OP_VAND,    &drcbe_x64::op_varith },     // VAND    dst,src1,src2
+	{ uml::OP_VOR,     &drcbe_x64::op_varith },     // VOR     dst,src1,src2
+	{ uml::OP_VXOR,    &drcbe_x64::op_varith },     // VXOR    dst,src1,src2
+	{ uml::OP_VMULLW,  &drcbe_x64::op_varith },     // VMULLW  dst,src1,src2
+	{ uml::OP_VMULHW,  &drcbe_x64::op_varith },     // VMULHW  dst,src1,src2
+	{ uml::OP_VSATW,   &drcbe_x64::op_vsatw }       // VSATW   dst,lo,hi
 };
 
 
@@ -588,8 +623,12 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, U
 		m_labels(cache),
 		m_log(nullptr),
 		m_sse41(false),
-		m_absmask32((UINT32 *)cache.alloc_near(16*2 + 15)),
+		m_profile(device.machine().options().drc_profile()),
+		m_nextcounter(0),
+		m_absmask32((UINT32 *)cache.alloc_near(16*4 + 15)),
 		m_absmask64(nullptr),
+		m_negmask32(nullptr),
+		m_negmask64(nullptr),
 		m_rbpvalue(cache.near() + 0x80),
 		m_entry(nullptr),
 		m_exit(nullptr),
@@ -616,6 +655,12 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, U
 	m_absmask64 = (UINT64 *)&m_absmask32[4];
 	m_absmask64[0] = m_absmask64[1] = U64(0x7fffffffffffffff);
 
+	// and matching sign masks for negation
+	m_negmask32 = &m_absmask32[8];
+	m_negmask32[0] = m_negmask32[1] = m_negmask32[2] = m_negmask32[3] = 0x80000000;
+	m_negmask64 = (UINT64 *)&m_absmask32[12];
+	m_negmask64[0] = m_negmask64[1] = U64(0x8000000000000000);
+
 	// get pointers to C functions we need to call
 	m_near.debug_cpu_instruction_hook = (x86code *)debugger_instruction_hook;
 	if (LOG_HASHJMPS)
@@ -751,6 +796,10 @@ void drcbe_x64::reset()
 	// reset our hash tables
 	m_hash.reset();
 	m_hash.set_default_codeptr(m_nocode);
+
+	// all code, and so every link site and counter, is gone
+	m_linksites.clear();
+	m_counters.clear();
 }
 
 
@@ -776,6 +825,21 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, UINT3
 	m_hash.block_begin(block, instlist, numinst);
 	m_labels.block_begin(block);
 	m_map.block_begin(block);
+	m_pendingsites.clear();
+	m_pendinghashes.clear();
+
+	// allocate counters for the entry points up front, since nothing can be allocated while generating
+	m_nextcounter = m_counters.size();
+	if (m_profile)
+		for (int inum = 0; inum < numinst; inum++)
+			if (instlist[inum].opcode() == OP_HASH)
+			{
+				UINT64 *counter = (UINT64 *)m_cache.alloc(sizeof(*counter));
+				if (counter == nullptr)
+					block.abort();
+				*counter = 0;
+				m_counters.push_back(profile_counter{ UINT32(instlist[inum].param(0).immediate()), UINT32(instlist[inum].param(1).immediate()), counter });
+			}
 
 	// begin codegen; fail if we can't
 	drccodeptr *cachetop = m_cache.begin_codegen(numinst * 8 * 4);
@@ -825,6 +889,15 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, UINT3
 	m_hash.block_end(block);
 	m_labels.block_end(block);
 	m_map.block_end(block);
+
+	// link the new call sites, then point every site that targets one of our entries at the new code
+	for (auto &site : m_pendingsites)
+	{
+		m_linksites[site.first].push_back(site.second);
+		patch_link_site(site.second, site.first >> 32, UINT32(site.first));
+	}
+	for (UINT64 hash : m_pendinghashes)
+		relink(hash);
 }
 
 
@@ -839,6 +912,76 @@ bool drcbe_x64::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  hash_unlink - remove the code for the given
+//  mode/pc from the hash table
+//-------------------------------------------------
+
+void drcbe_x64::hash_unlink(UINT32 mode, UINT32 pc)
+{
+	m_hash.unlink(mode, pc);
+	relink((UINT64(mode) << 32) | pc);
+}
+
+
+//-------------------------------------------------
+//  get_profile - return the entry counts of all
+//  code generated since the last reset
+//-------------------------------------------------
+
+void drcbe_x64::get_profile(std::vector<drcbe_profile_entry> &entries)
+{
+	entries.clear();
+	for (auto &counter : m_counters)
+		entries.push_back(drcbe_profile_entry{ counter.mode, counter.pc, *counter.counter });
+}
+
+
+//-------------------------------------------------
+//  patch_link_site - point a HASHJMP call site
+//  directly at the code for its mode/pc, or at
+//  the hash table entry if there is none
+//-------------------------------------------------
+
+void drcbe_x64::patch_link_site(x86code *site, UINT32 mode, UINT32 pc)
+{
+	drccodeptr code = m_hash.get_codeptr(mode, pc);
+	x86code *dst = site;
+
+	if (code != nullptr && code != m_nocode)
+	{
+		INT64 delta = (x86code *)code - (site + 5);
+		assert_always((INT32)delta == delta, "patch_link_site: delta out of range");
+		emit_byte(dst, 0xe8);                                                           // call  code
+		emit_dword(dst, delta);
+		emit_byte(dst, 0x90);                                                           // nop
+	}
+	else
+	{
+		UINT32 l1val = (pc >> m_hash.l1shift()) & m_hash.l1mask();
+		UINT32 l2val = (pc >> m_hash.l2shift()) & m_hash.l2mask();
+		emit_byte(dst, 0xff);                                                           // call  hash[mode][l1val][l2val]
+		emit_byte(dst, 0x95);
+		emit_dword(dst, offset_from_rbp(&m_hash.base()[mode][l1val][l2val]));
+	}
+	assert(dst == site + LINK_SITE_SIZE);
+}
+
+
+//-------------------------------------------------
+//  relink - repatch every call site that targets
+//  the given mode/pc
+//-------------------------------------------------
+
+void drcbe_x64::relink(UINT64 hash)
+{
+	auto sites = m_linksites.find(hash);
+	if (sites != m_linksites.end())
+		for (x86code *site : sites->second)
+			patch_link_site(site, hash >> 32, UINT32(hash));
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -2027,7 +2170,7 @@ void drcbe_x64::emit_test_m64_p64(x86code *&dst, x86_memref memref, const be_par
 {
 	if (param.is_immediate() && short_immediate(param.immediate()))
 		emit_test_m64_imm(dst, memref, param.immediate());                          // test  [dest],param
-	else if (param.is_memory())
+	else if (param.is_memory() || param.is_immediate())
 	{
 		emit_mov_r64_p64(dst, REG_EAX, param);                                          // mov   reg,param
 		emit_test_m64_r64(dst, memref, REG_EAX);                                        // test  [dest],reg
@@ -2104,7 +2247,7 @@ void drcbe_x64::emit_xor_r64_p64(x86code *&dst, UINT8 reg, const be_parameter &p
 	{
 		if (inst.flags() != 0 || param.immediate() != 0)
 		{
-			if (param.immediate() == U64(0xffffffffffffffff))
+			if (inst.flags() == 0 && param.immediate() == U64(0xffffffffffffffff))
 				emit_not_r64(dst, reg);                                                 // not   reg
 			else if (short_immediate(param.immediate()))
 				emit_xor_r64_imm(dst, reg, param.immediate());                          // xor   reg,param
@@ -2133,7 +2276,7 @@ void drcbe_x64::emit_xor_m64_p64(x86code *&dst, x86_memref memref, const be_para
 	{
 		if (inst.flags() != 0 || param.immediate() != 0)
 		{
-			if (param.immediate() == U64(0xffffffffffffffff))
+			if (inst.flags() == 0 && param.immediate() == U64(0xffffffffffffffff))
 				emit_not_m64(dst, memref);                                          // not   [mem]
 			else if (short_immediate(param.immediate()))
 				emit_xor_m64_imm(dst, memref, param.immediate());                   // xor   [mem],param
@@ -2680,6 +2823,16 @@ void drcbe_x64::op_hash(x86code *&dst, const instruction &inst)
 
 	// register the current pointer for the mode/PC
 	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), dst);
+	m_pendinghashes.push_back((inst.param(0).immediate() << 32) | UINT32(inst.param(1).immediate()));
+
+	// count the entry without touching the flags
+	if (m_profile)
+	{
+		UINT64 *counter = m_counters[m_nextcounter++].counter;
+		emit_mov_r64_m64(dst, REG_RAX, MABS(counter));                                  // mov   rax,[counter]
+		emit_lea_r64_m64(dst, REG_RAX, MBD(REG_RAX, 1));                                // lea   rax,[rax+1]
+		emit_mov_m64_r64(dst, MABS(counter), REG_RAX);                                  // mov   [counter],rax
+	}
 }
 
 
@@ -2831,8 +2984,14 @@ void drcbe_x64::op_hashjmp(x86code *&dst, const instruction &inst)
 	// fixed mode cases
 	if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
 	{
-		// a straight immediate jump is direct, though we need the PC in EAX in case of failure
-		if (pcp.is_immediate())
+		// a straight immediate jump is direct, and is linked straight to the code once it exists
+		if (pcp.is_immediate() && USE_BLOCK_LINKING)
+		{
+			m_pendingsites.push_back(std::make_pair((modep.immediate() << 32) | UINT32(pcp.immediate()), dst));
+			patch_link_site(dst, modep.immediate(), pcp.immediate());                   // call  hash[modep][l1val][l2val]
+			dst += LINK_SITE_SIZE;
+		}
+		else if (pcp.is_immediate())
 		{
 			UINT32 l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
 			UINT32 l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
@@ -4134,6 +4293,15 @@ void drcbe_x64::op_sext(x86code *&dst, const instruction &inst)
 			else if (sizep.size() == SIZE_DWORD)
 				emit_mov_r32_r32(dst, dstreg, srcp.ireg());                             // mov   dstreg,srcp
 		}
+		else if (srcp.is_immediate())
+		{
+			if (sizep.size() == SIZE_BYTE)
+				emit_mov_r32_imm(dst, dstreg, (INT8)srcp.immediate());                  // mov   dstreg,(INT8)srcp
+			else if (sizep.size() == SIZE_WORD)
+				emit_mov_r32_imm(dst, dstreg, (INT16)srcp.immediate());                 // mov   dstreg,(INT16)srcp
+			else if (sizep.size() == SIZE_DWORD)
+				emit_mov_r32_imm(dst, dstreg, srcp.immediate());                        // mov   dstreg,srcp
+		}
 		emit_mov_p32_r32(dst, dstp, dstreg);                                            // mov   dstp,dstreg
 		if (inst.flags() != 0)
 			emit_test_r32_r32(dst, dstreg, dstreg);                                     // test  dstreg,dstreg
@@ -4165,6 +4333,17 @@ void drcbe_x64::op_sext(x86code *&dst, const instruction &inst)
 			else if (sizep.size() == SIZE_QWORD)
 				emit_mov_r64_r64(dst, dstreg, srcp.ireg());                             // mov   dstreg,srcp
 		}
+		else if (srcp.is_immediate())
+		{
+			if (sizep.size() == SIZE_BYTE)
+				emit_mov_r64_imm(dst, dstreg, (INT8)srcp.immediate());                  // mov   dstreg,(INT8)srcp
+			else if (sizep.size() == SIZE_WORD)
+				emit_mov_r64_imm(dst, dstreg, (INT16)srcp.immediate());                 // mov   dstreg,(INT16)srcp
+			else if (sizep.size() == SIZE_DWORD)
+				emit_mov_r64_imm(dst, dstreg, (INT32)srcp.immediate());                 // mov   dstreg,(INT32)srcp
+			else if (sizep.size() == SIZE_QWORD)
+				emit_mov_r64_imm(dst, dstreg, srcp.immediate());                        // mov   dstreg,srcp
+		}
 		emit_mov_p64_r64(dst, dstp, dstreg);                                            // mov   dstp,dstreg
 		if (inst.flags() != 0)
 			emit_test_r64_r64(dst, dstreg, dstreg);                                     // test  dstreg,dstreg
@@ -4737,6 +4916,11 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 				emit_imul_r32_m32(dst, REG_EAX, MABS(src2p.memory()));                  // imul  eax,[src2p]
 			else if (src2p.is_int_register())
 				emit_imul_r32_r32(dst, REG_EAX, src2p.ireg());                          // imul  eax,src2p
+			else if (src2p.is_immediate())
+			{
+				emit_mov_r32_imm(dst, REG_EDX, src2p.immediate());                      // mov   edx,src2p
+				emit_imul_r32_r32(dst, REG_EAX, REG_EDX);                               // imul  eax,edx
+			}
 			emit_mov_p32_r32(dst, dstp, REG_EAX);                                       // mov   dstp,eax
 		}
 
@@ -4815,6 +4999,11 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 				emit_imul_r64_m64(dst, REG_RAX, MABS(src2p.memory()));                  // imul  rax,[src2p]
 			else if (src2p.is_int_register())
 				emit_imul_r64_r64(dst, REG_RAX, src2p.ireg());                          // imul  rax,src2p
+			else if (src2p.is_immediate())
+			{
+				emit_mov_r64_imm(dst, REG_RDX, src2p.immediate());                      // mov   rdx,src2p
+				emit_imul_r64_r64(dst, REG_RAX, REG_RDX);                               // imul  rax,rdx
+			}
 			emit_mov_p64_r64(dst, dstp, REG_RAX);                                       // mov   dstp,rax
 		}
 
@@ -6480,22 +6669,16 @@ void drcbe_x64::op_fneg(x86code *&dst, const instruction &inst)
 	// 32-bit form
 	if (inst.size() == 4)
 	{
-		emit_xorps_r128_r128(dst, dstreg, dstreg);                                      // xorps dstreg,dstreg
-		if (srcp.is_memory())
-			emit_subss_r128_m32(dst, dstreg, MABS(srcp.memory()));                      // subss dstreg,[srcp]
-		else if (srcp.is_float_register())
-			emit_subss_r128_r128(dst, dstreg, srcp.freg());                             // subss dstreg,srcp
+		emit_movss_r128_p32(dst, dstreg, srcp);                                         // movss dstreg,srcp
+		emit_xorps_r128_m128(dst, dstreg, MABS(m_negmask32));                           // xorps dstreg,[negmask32]
 		emit_movss_p32_r128(dst, dstp, dstreg);                                         // movss dstp,dstreg
 	}
 
 	// 64-bit form
 	else if (inst.size() == 8)
 	{
-		emit_xorpd_r128_r128(dst, dstreg, dstreg);                                      // xorpd dstreg,dstreg
-		if (srcp.is_memory())
-			emit_subsd_r128_m64(dst, dstreg, MABS(srcp.memory()));                      // subsd dstreg,[srcp]
-		else if (srcp.is_float_register())
-			emit_subsd_r128_r128(dst, dstreg, srcp.freg());                             // subsd dstreg,srcp
+		emit_movsd_r128_p64(dst, dstreg, srcp);                                         // movsd dstreg,srcp
+		emit_xorpd_r128_m128(dst, dstreg, MABS(m_negmask64));                           // xorpd dstreg,[negmask64]
 		emit_movsd_p64_r128(dst, dstp, dstreg);                                         // movsd dstp,dstreg
 	}
 }
@@ -6707,3 +6890,166 @@ void drcbe_x64::op_frsqrt(x86code *&dst, const instruction &inst)
 		emit_movsd_p64_r128(dst, dstp, dstreg);                                         // movsd dstp,dstreg
 	}
 }
+
+
+
+/***************************************************************************
+    VECTOR OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  vector_memref - return a memory reference to
+//  a vector operand; operands such as a CPU
+//  core's register file needn't be near the
+//  cache, so far ones are reached through reg
+//-------------------------------------------------
+
+x86_memref drcbe_x64::vector_memref(x86code *&dst, const void *ptr, UINT8 reg)
+{
+	INT32 offset;
+	int basereg = get_base_register_and_offset(dst, const_cast<void *>(ptr), reg, offset);
+	return MBD(basereg, offset);
+}
+
+
+//-------------------------------------------------
+//  op_vmov - process a VMOV opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vmov(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// vector operands carry no alignment guarantee, so always go through movdqu
+	emit_movdqu_r128_m128(dst, REG_XMM0, vector_memref(dst, inst.param(1).memory(), REG_RDX));    // movdqu xmm0,[src1]
+	emit_movdqu_m128_r128(dst, vector_memref(dst, inst.param(0).memory(), REG_RCX), REG_XMM0);    // movdqu [dst],xmm0
+}
+
+
+//-------------------------------------------------
+//  op_vshuf - process a VSHUF opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vshuf(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// lane n of the result comes from lane (sel >> 4n) & 7 of the source
+	UINT32 sel = inst.param(2).immediate();
+	int lanes[8];
+	bool halves = true, broadcast = true;
+	UINT8 shuflo = 0, shufhi = 0;
+	for (int lane = 0; lane < 8; lane++)
+	{
+		lanes[lane] = (sel >> (4 * lane)) & 7;
+		if ((lanes[lane] >> 2) != (lane >> 2))
+			halves = false;
+		if (lanes[lane] != lanes[0])
+			broadcast = false;
+		if (lane < 4)
+			shuflo |= (lanes[lane] & 3) << (2 * lane);
+		else
+			shufhi |= (lanes[lane] & 3) << (2 * (lane - 4));
+	}
+
+	INT32 srcoffs;
+	int srcreg = get_base_register_and_offset(dst, inst.param(1).memory(), REG_RDX, srcoffs);
+
+	// each half selects from itself: one shuffle per half
+	if (halves)
+	{
+		emit_movdqu_r128_m128(dst, REG_XMM0, MBD(srcreg, srcoffs));                     // movdqu xmm0,[src1]
+		if (shuflo != 0xe4)
+			emit_pshuflw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, shuflo);                // pshuflw xmm0,xmm0,shuflo
+		if (shufhi != 0xe4)
+			emit_pshufhw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, shufhi);                // pshufhw xmm0,xmm0,shufhi
+	}
+
+	// one lane everywhere: spread it across its dword, then the dword everywhere
+	else if (broadcast)
+	{
+		emit_movdqu_r128_m128(dst, REG_XMM0, MBD(srcreg, srcoffs));                     // movdqu xmm0,[src1]
+		if (lanes[0] < 4)
+		{
+			emit_pshuflw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, lanes[0] * 0x55);       // pshuflw xmm0,xmm0,lane*0x55
+			emit_pshufd_r128_r128_imm(dst, REG_XMM0, REG_XMM0, 0x00);                   // pshufd xmm0,xmm0,0x00
+		}
+		else
+		{
+			emit_pshufhw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, (lanes[0] - 4) * 0x55); // pshufhw xmm0,xmm0,lane*0x55
+			emit_pshufd_r128_r128_imm(dst, REG_XMM0, REG_XMM0, 0xff);                   // pshufd xmm0,xmm0,0xff
+		}
+	}
+
+	// anything else gathers one lane at a time straight from memory
+	else
+	{
+		for (int lane = 0; lane < 8; lane++)
+			emit_pinsrw_r128_m16_imm(dst, REG_XMM0, MBD(srcreg, srcoffs + 2 * lanes[lane]), lane);  // pinsrw xmm0,[src1+2*sel],lane
+	}
+	emit_movdqu_m128_r128(dst, vector_memref(dst, inst.param(0).memory(), REG_RCX), REG_XMM0);    // movdqu [dst],xmm0
+}
+
+
+//-------------------------------------------------
+//  op_varith - process a two-source VADDW,
+//  VADDSW, VSUBW, VSUBSW, VMINSW, VMAXSW, VCMPGTW,
+//  VAND, VOR, VXOR, VMULLW or VMULHW opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_varith(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// both sources come in through registers; legacy SSE memory operands must be aligned
+	emit_movdqu_r128_m128(dst, REG_XMM0, vector_memref(dst, inst.param(1).memory(), REG_RDX));    // movdqu xmm0,[src1]
+	emit_movdqu_r128_m128(dst, REG_XMM1, vector_memref(dst, inst.param(2).memory(), REG_RCX));    // movdqu xmm1,[src2]
+	switch (inst.opcode())
+	{
+		case uml::OP_VADDW:     emit_paddw_r128_r128(dst, REG_XMM0, REG_XMM1);      break;  // paddw xmm0,xmm1
+		case uml::OP_VADDSW:    emit_paddsw_r128_r128(dst, REG_XMM0, REG_XMM1);     break;  // paddsw xmm0,xmm1
+		case uml::OP_VSUBW:     emit_psubw_r128_r128(dst, REG_XMM0, REG_XMM1);      break;  // psubw xmm0,xmm1
+		case uml::OP_VSUBSW:    emit_psubsw_r128_r128(dst, REG_XMM0, REG_XMM1);     break;  // psubsw xmm0,xmm1
+		case uml::OP_VMINSW:    emit_pminsw_r128_r128(dst, REG_XMM0, REG_XMM1);     break;  // pminsw xmm0,xmm1
+		case uml::OP_VMAXSW:    emit_pmaxsw_r128_r128(dst, REG_XMM0, REG_XMM1);     break;  // pmaxsw xmm0,xmm1
+		case uml::OP_VCMPGTW:   emit_pcmpgtw_r128_r128(dst, REG_XMM0, REG_XMM1);    break;  // pcmpgtw xmm0,xmm1
+		case uml::OP_VAND:      emit_pand_r128_r128(dst, REG_XMM0, REG_XMM1);       break;  // pand  xmm0,xmm1
+		case uml::OP_VOR:       emit_por_r128_r128(dst, REG_XMM0, REG_XMM1);        break;  // por   xmm0,xmm1
+		case uml::OP_VXOR:      emit_pxor_r128_r128(dst, REG_XMM0, REG_XMM1);       break;  // pxor  xmm0,xmm1
+		case uml::OP_VMULLW:    emit_pmullw_r128_r128(dst, REG_XMM0, REG_XMM1);     break;  // pmullw xmm0,xmm1
+		case uml::OP_VMULHW:    emit_pmulhw_r128_r128(dst, REG_XMM0, REG_XMM1);     break;  // pmulhw xmm0,xmm1
+		default:                assert(false);                                      break;
+	}
+	emit_movdqu_m128_r128(dst, vector_memref(dst, inst.param(0).memory(), REG_RDX), REG_XMM0);    // movdqu [dst],xmm0
+}
+
+
+//-------------------------------------------------
+//  op_vsatw - process a VSATW opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vsatw(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// interleave into 32-bit lanes and pack them back down with signed saturation
+	emit_movdqu_r128_m128(dst, REG_XMM0, vector_memref(dst, inst.param(1).memory(), REG_RDX));    // movdqu xmm0,[lo]
+	emit_movdqu_r128_m128(dst, REG_XMM1, vector_memref(dst, inst.param(2).memory(), REG_RCX));    // movdqu xmm1,[hi]
+	emit_movdqa_r128_r128(dst, REG_XMM2, REG_XMM0);                                     // movdqa xmm2,xmm0
+	emit_punpcklwd_r128_r128(dst, REG_XMM0, REG_XMM1);                                  // punpcklwd xmm0,xmm1
+	emit_punpckhwd_r128_r128(dst, REG_XMM2, REG_XMM1);                                  // punpckhwd xmm2,xmm1
+	emit_packssdw_r128_r128(dst, REG_XMM0, REG_XMM2);                                   // packssdw xmm0,xmm2
+	emit_movdqu_m128_r128(dst, vector_memref(dst, inst.param(0).memory(), REG_RDX), REG_XMM0);    // movdqu [dst],xmm0
+}
@@ -40,8 +40,10 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual void hash_unlink(UINT32 mode, UINT32 pc) override;
 	virtual void get_info(drcbe_info &info) override;
 	virtual bool logging() const override { return m_log != nullptr; }
+	virtual void get_profile(std::vector<drcbe_profile_entry> &entries) override;
 
 private:
 	// a be_parameter is similar to a uml::parameter but maps to native registers/memory
@@ -116,6 +118,8 @@ private:
 	x86_memref MABS(const void *ptr);
 	bool short_immediate(INT64 immediate) const { return (INT32)immediate == immediate; }
 	void normalize_commutative(be_parameter &inner, be_parameter &outer);
+	void patch_link_site(x86code *site, UINT32 mode, UINT32 pc);
+	void relink(UINT64 hash);
 	INT32 offset_from_rbp(const void *ptr);
 	int get_base_register_and_offset(x86code *&dst, void *target, UINT8 reg, INT32 &offset);
 	void emit_smart_call_r64(x86code *&dst, x86code *target, UINT8 reg);
@@ -208,6 +212,12 @@ private:
 	void op_frecip(x86code *&dst, const uml::instruction &inst);
 	void op_frsqrt(x86code *&dst, const uml::instruction &inst);
 
+	x86_memref vector_memref(x86code *&dst, const void *ptr, UINT8 reg);
+	void op_vmov(x86code *&dst, const uml::instruction &inst);
+	void op_vshuf(x86code *&dst, const uml::instruction &inst);
+	void op_varith(x86code *&dst, const uml::instruction &inst);
+	void op_vsatw(x86code *&dst, const uml::instruction &inst);
+
 	// 32-bit code emission helpers
 	void emit_mov_r32_p32(x86code *&dst, UINT8 reg, const be_parameter &param);
 	void emit_movsx_r64_p32(x86code *&dst, UINT8 reg, const be_parameter &param);
@@ -297,8 +307,25 @@ private:
 	x86log_context *        m_log;                  // logging
 	bool                    m_sse41;                // do we have SSE4.1 support?
 
+	// an entry point counter, for profiling
+	struct profile_counter
+	{
+		UINT32              mode;                   // mode of the entry
+		UINT32              pc;                     // PC of the entry
+		UINT64 *            counter;                // counter in the cache
+	};
+
+	bool                    m_profile;              // count entries to each block?
+	std::vector<profile_counter> m_counters;        // counters for all code since the last reset
+	size_t                  m_nextcounter;          // next counter for the block being generated
+	std::unordered_map<UINT64, std::vector<x86code *>> m_linksites; // HASHJMP call sites for each mode/pc
+	std::vector<std::pair<UINT64, x86code *>> m_pendingsites; // call sites in the block being generated
+	std::vector<UINT64>     m_pendinghashes;        // mode/pc entries defined by the block being generated
+
 	UINT32 *                m_absmask32;            // absolute value mask (32-bit)
 	UINT64 *                m_absmask64;            // absolute value mask (32-bit)
+	UINT32 *                m_negmask32;            // sign bit mask (32-bit)
+	UINT64 *                m_negmask64;            // sign bit mask (64-bit)
 	UINT8 *                 m_rbpvalue;             // value of RBP
 
 	x86_entry_point_func    m_entry;                // entry point
@@ -270,7 +270,24 @@ const drcbe_x86::opcode_table_entry drcbe_x86::s_opcode_table_source[] =
 	{ uml::OP_FABS,    &drcbe_x86::op_fabs },       // FABS    dst,src1
 	{ uml::OP_FSQRT,   &drcbe_x86::op_fsqrt },      // FSQRT   dst,src1
 	{ uml::OP_FRECIP,  &drcbe_x86::op_frecip },     // FRECIP  dst,src1
-	{ uml::OP_FRSQRT,  &drcbe_x86::op_frsqrt }      // FRSQRT  dst,src1
+	{ uml::OP_FRSQRT,  &drcbe_x86::op_frsqrt },     // FRSQRT  dst,src1
+
+	// Vector Operations
+	{ uml::OP_VMOV,    &drcbe_x86::op_vector },    // VMOV    dst,src1
+	{ uml::OP_VSHUF,   &drcbe_x86::op_vector },    // VSHUF   dst,src1,sel
+	{ uml::OP_VADDW,   &drcbe_x86::op_vector },    // VADDW   dst,src1,src2
+	{ uml::OP_VADDSW,  &drcbe_x86::op_vector },    // VADDSW  dst,src1,src2
+	{ uml::OP_VSUBW,   &drcbe_x86::op_vector },    // VSUBW   dst,src1,src2
+	{ uml::OP_VSUBSW,  &drcbe_x86::op_vector },    // VSUBSW  dst,src1,src2
+	{ uml::OP_VMINSW,  &drcbe_x86::op_vector },    // VMINSW  dst,src1,src2
+	{ uml::OP_VMAXSW,  &drcbe_x86::op_vector },    // VMAXSW  dst,src1,src2
+	{ uml::OP_VCMPGTW, &drcbe_x86::op_vector },    // VCMPGTW dst,src1,src2
+	{ uml::OP_VAND,    &drcbe_x86::op_vector },    // VAND    dst,src1,src2
+	{ uml::OP_VOR,     &drcbe_x86::op_vector },    // VOR     dst,src1,src2
+	{ uml::OP_VXOR,    &drcbe_x86::op_vector },    // VXOR    dst,src1,src2
+	{ uml::OP_VMULLW,  &drcbe_x86::op_vector },    // VMULLW  dst,src1,src2
+	{ uml::OP_VMULHW,  &drcbe_x86::op_vector },    // VMULHW  dst,src1,src2
+	{ uml::OP_VSATW,   &drcbe_x86::op_vector }     // VSATW   dst,lo,hi
 };
 
 
@@ -822,6 +839,17 @@ bool drcbe_x86::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  hash_unlink - remove the code for the given
+//  mode/pc from the hash table
+//-------------------------------------------------
+
+void drcbe_x86::hash_unlink(UINT32 mode, UINT32 pc)
+{
+	m_hash.unlink(mode, pc);
+}
+
+
 //-------------------------------------------------
 //  drcbex86_get_info - return information about
 //  the back-end implementation
@@ -6449,6 +6477,37 @@ void drcbe_x86::op_frsqrt(x86code *&dst, const instruction &inst)
 
 
 
+//**************************************************************************
+//  VECTOR OPERATIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  op_vector - process any vector opcode; SSE2
+//  isn't guaranteed on x86 hosts, so every one
+//  goes through vector_op
+//-------------------------------------------------
+
+void drcbe_x86::op_vector(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// the third parameter is a source vector, a shuffle selector, or absent for VMOV
+	FPTR src2 = 0;
+	if (inst.numparams() > 2)
+		src2 = inst.param(2).is_immediate() ? (FPTR)inst.param(2).immediate() : (FPTR)inst.param(2).memory();
+
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 12), src2);                                     // mov   [esp+12],src2
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 8), (FPTR)inst.param(1).memory());              // mov   [esp+8],src1
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 4), (FPTR)inst.param(0).memory());              // mov   [esp+4],dst
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 0), inst.opcode());                             // mov   [esp],opcode
+	emit_call(dst, (x86code *)vector_op);                                              // call  vector_op
+}
+
+
+
 //**************************************************************************
 //  MISCELLAENOUS FUNCTIONS
 //**************************************************************************
@@ -6585,3 +6644,50 @@ int drcbe_x86::ddivs(UINT64 &dstlo, UINT64 &dsthi, INT64 src1, INT64 src2)
 		dsthi = src1 % src2;
 	return ((dstlo == 0) << 2) | ((dstlo >> 60) & FLAG_S);
 }
+
+
+//-------------------------------------------------
+//  vector_op - perform one vector opcode on
+//  eight 16-bit lanes
+//-------------------------------------------------
+
+void drcbe_x86::vector_op(UINT32 opcode, INT16 *dst, const INT16 *src1, FPTR src2)
+{
+	const INT16 *vsrc2 = reinterpret_cast<const INT16 *>(src2);
+	INT16 result[8];
+
+	for (int lane = 0; lane < 8; lane++)
+	{
+		INT32 s1 = src1[lane];
+		INT32 s2 = (opcode != uml::OP_VMOV && opcode != uml::OP_VSHUF) ? vsrc2[lane] : 0;
+		INT32 r;
+
+		switch (opcode)
+		{
+			case uml::OP_VMOV:      r = s1;                             break;
+			case uml::OP_VSHUF:     r = src1[(src2 >> (4 * lane)) & 7]; break;
+			case uml::OP_VADDW:     r = s1 + s2;                        break;
+			case uml::OP_VADDSW:    r = s1 + s2;                        break;
+			case uml::OP_VSUBW:     r = s1 - s2;                        break;
+			case uml::OP_VSUBSW:    r = s1 - s2;                        break;
+			case uml::OP_VMINSW:    r = (s1 < s2) ? s1 : s2;            break;
+			case uml::OP_VMAXSW:    r = (s1 > s2) ? s1 : s2;            break;
+			case uml::OP_VCMPGTW:   r = (s1 > s2) ? -1 : 0;             break;
+			case uml::OP_VAND:      r = s1 & s2;                        break;
+			case uml::OP_VOR:       r = s1 | s2;                        break;
+			case uml::OP_VXOR:      r = s1 ^ s2;                        break;
+			case uml::OP_VMULLW:    r = s1 * s2;                        break;
+			case uml::OP_VMULHW:    r = (s1 * s2) >> 16;                break;
+			case uml::OP_VSATW:     r = (INT32)(((UINT32)s2 << 16) | (UINT16)s1); break;
+			default:                r = 0; assert(false);               break;
+		}
+
+		// the saturating forms clamp to the signed 16-bit range
+		if (opcode == uml::OP_VADDSW || opcode == uml::OP_VSUBSW || opcode == uml::OP_VSATW)
+			r = (r < -32768) ? -32768 : (r > 32767) ? 32767 : r;
+		result[lane] = r;
+	}
+
+	// write the result last so dst may alias either source
+	memcpy(dst, result, sizeof(result));
+}
@@ -40,6 +40,7 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual void hash_unlink(UINT32 mode, UINT32 pc) override;
 	virtual void get_info(drcbe_info &info) override;
 	virtual bool logging() const override { return m_log != nullptr; }
 
@@ -209,6 +210,8 @@ private:
 	void op_frecip(x86code *&dst, const uml::instruction &inst);
 	void op_frsqrt(x86code *&dst, const uml::instruction &inst);
 
+	void op_vector(x86code *&dst, const uml::instruction &inst);
+
 	// 32-bit code emission helpers
 	void emit_mov_r32_p32(x86code *&dst, UINT8 reg, const be_parameter &param);
 	void emit_mov_r32_p32_keepflags(x86code *&dst, UINT8 reg, const be_parameter &param);
@@ -286,6 +289,7 @@ private:
 	static int dmuls(UINT64 &dstlo, UINT64 &dsthi, INT64 src1, INT64 src2, int flags);
 	static int ddivu(UINT64 &dstlo, UINT64 &dsthi, UINT64 src1, UINT64 src2);
 	static int ddivs(UINT64 &dstlo, UINT64 &dsthi, INT64 src1, INT64 src2);
+	static void vector_op(UINT32 opcode, INT16 *dst, const INT16 *src1, FPTR src2);
 
 	// internal state
 	drc_hash_table          m_hash;                 // hash table state
@@ -49,6 +49,8 @@ public:
 	drccodeptr near() const { return m_near; }
 	drccodeptr base() const { return m_base; }
 	drccodeptr top() const { return m_top; }
+	size_t size() const { return m_size; }
+	size_t bytes_free() const { return m_end - m_top; }
 
 	// pointer checking
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
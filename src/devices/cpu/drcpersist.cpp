@@ -0,0 +1,310 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcpersist.cpp
+
+    Persistent list of compiled blocks for recompiling CPU cores.
+
+****************************************************************************
+
+    With -drc_persist, every block a CPU core compiles is recorded by
+    mode and starting PC, together with a checksum of the opcodes the
+    front-end described for it.  The list is written to the NVRAM
+    directory when the CPU stops, and read back on the next run.
+
+    The generated UML itself is not stored: it refers to the CPU state,
+    code handles and C callbacks by host address, none of which survive
+    to the next run.  Instead, blocks from the list are recompiled ahead
+    of time while the core is running.  Each time the core exits for
+    missing code it compiles the missing block as usual, and at doubling
+    intervals it then walks the pending list, describes each block again
+    and compiles it if the checksum of its opcodes still matches.  Blocks
+    whose code has not been loaded yet are retried on later passes and
+    eventually dropped.  Blocks from a different front-end version or
+    CPU type are never reused.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcpersist.h"
+#include "coreutil.h"
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// file header magic and format version
+static const char FILE_MAGIC[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'C', 0 };
+static const UINT32 FILE_VERSION = 1;
+
+// size of the header and of each entry in the file
+static const int HEADER_BYTES = 8 + 4 * 4;
+static const int ENTRY_BYTES = 3 * 4;
+
+// most blocks written to a single file
+static const UINT32 MAX_ENTRIES = 65536;
+
+// replay passes a block may fail before it is dropped
+static const UINT8 MAX_ATTEMPTS = 8;
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  put_le32/get_le32 - little-endian helpers for
+//  the file format
+//-------------------------------------------------
+
+static inline void put_le32(UINT8 *dest, UINT32 value)
+{
+	dest[0] = value;
+	dest[1] = value >> 8;
+	dest[2] = value >> 16;
+	dest[3] = value >> 24;
+}
+
+static inline UINT32 get_le32(const UINT8 *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | (UINT32(src[3]) << 24);
+}
+
+
+//-------------------------------------------------
+//  checksum_desc - accumulate the checksum of a
+//  single opcode description
+//-------------------------------------------------
+
+static UINT32 checksum_desc(UINT32 crc, const opcode_desc &desc)
+{
+	UINT8 header[4 * 3 + 1];
+	put_le32(&header[0], desc.pc);
+	put_le32(&header[4], desc.physpc);
+	put_le32(&header[8], desc.flags);
+	header[12] = desc.length;
+	crc = core_crc32(crc, header, sizeof(header));
+	return core_crc32(crc, desc.opptr.b, MIN(desc.length, sizeof(desc.opptr.b)));
+}
+
+
+
+//**************************************************************************
+//  PERSISTENT CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_persistent_cache - constructor
+//-------------------------------------------------
+
+drc_persistent_cache::drc_persistent_cache(device_t &device, drcuml_state &drcuml, drc_frontend &frontend, UINT32 version, compile_delegate compile)
+	: m_device(device),
+		m_drcuml(drcuml),
+		m_frontend(frontend),
+		m_compile(compile),
+		m_version(version),
+		m_enabled(device.machine().options().drc_persist()),
+		m_replaying(false),
+		m_misses(0),
+		m_nextreplay(1)
+{
+	if (m_enabled)
+		load();
+}
+
+
+//-------------------------------------------------
+//  ~drc_persistent_cache - destructor
+//-------------------------------------------------
+
+drc_persistent_cache::~drc_persistent_cache()
+{
+}
+
+
+//-------------------------------------------------
+//  record - note a block that has just been
+//  compiled
+//-------------------------------------------------
+
+void drc_persistent_cache::record(UINT8 mode, const opcode_desc *desclist)
+{
+	if (!m_enabled || desclist == nullptr)
+		return;
+	m_compiled[key(mode, desclist->pc)] = checksum(desclist);
+}
+
+
+//-------------------------------------------------
+//  block_missing - called after the core has
+//  compiled a missing block; replays pending
+//  blocks at doubling intervals
+//-------------------------------------------------
+
+void drc_persistent_cache::block_missing(UINT8 mode)
+{
+	// nothing to do if disabled, empty, or called from within a replay
+	if (!m_enabled || m_pending.empty() || m_replaying)
+		return;
+
+	// only replay on every power of two misses, so that blocks whose code
+	// isn't there yet cost little
+	if (++m_misses < m_nextreplay)
+		return;
+	m_nextreplay = m_misses * 2;
+
+	// leave a quarter of the cache for code that wasn't in the list, so that
+	// replaying never causes a flush
+	drc_cache &cache = m_drcuml.cache();
+	size_t reserve = cache.size() / 4;
+
+	m_replaying = true;
+	size_t keep = 0;
+	for (size_t index = 0; index < m_pending.size(); index++)
+	{
+		entry &cur = m_pending[index];
+
+		// blocks for other modes have to wait until the core is in that mode
+		if (cur.m_mode != mode || cache.bytes_free() < reserve)
+		{
+			m_pending[keep++] = cur;
+			continue;
+		}
+
+		// skip blocks that have been compiled already
+		if (m_drcuml.hash_exists(cur.m_mode, cur.m_pc))
+			continue;
+
+		// compile the block only if its opcodes still match
+		if (checksum(m_frontend.describe_code(cur.m_pc)) == cur.m_crc)
+			m_compile(cur.m_mode, cur.m_pc);
+		else if (++cur.m_attempts < MAX_ATTEMPTS)
+			m_pending[keep++] = cur;
+	}
+	m_pending.resize(keep);
+	m_replaying = false;
+}
+
+
+//-------------------------------------------------
+//  checksum - compute the checksum of a block's
+//  source opcodes
+//-------------------------------------------------
+
+UINT32 drc_persistent_cache::checksum(const opcode_desc *desclist)
+{
+	UINT32 crc = 0;
+	for (const opcode_desc *desc = desclist; desc != nullptr; desc = desc->next())
+	{
+		crc = checksum_desc(crc, *desc);
+		for (const opcode_desc *delay = desc->delay.first(); delay != nullptr; delay = delay->next())
+			crc = checksum_desc(crc, *delay);
+	}
+	return crc;
+}
+
+
+//-------------------------------------------------
+//  filename - build the name of the file for
+//  this device
+//-------------------------------------------------
+
+std::string drc_persistent_cache::filename() const
+{
+	std::string tag(m_device.tag());
+	tag.erase(0, 1);
+	strreplacechr(tag, ':', '_');
+	return std::string(m_device.machine().basename()).append(PATH_SEPARATOR).append(tag).append(".drc");
+}
+
+
+//-------------------------------------------------
+//  load - read the blocks compiled in a previous
+//  run
+//-------------------------------------------------
+
+void drc_persistent_cache::load()
+{
+	emu_file file(m_device.machine().options().nvram_directory(), OPEN_FLAG_READ);
+	if (file.open(filename().c_str()) != FILERR_NONE)
+		return;
+
+	// validate the header; a file from another version or CPU type is ignored
+	UINT8 header[HEADER_BYTES];
+	if (file.read(header, sizeof(header)) != sizeof(header) || memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+		return;
+	const char *shortname = m_device.shortname();
+	if (get_le32(&header[8]) != FILE_VERSION || get_le32(&header[12]) != m_version ||
+		get_le32(&header[16]) != core_crc32(0, (const UINT8 *)shortname, strlen(shortname)))
+		return;
+	UINT32 count = get_le32(&header[20]);
+	if (count > MAX_ENTRIES || file.size() != HEADER_BYTES + UINT64(count) * ENTRY_BYTES)
+		return;
+
+	// read the entries
+	dynamic_buffer buffer(count * ENTRY_BYTES);
+	if (count != 0 && file.read(&buffer[0], buffer.size()) != buffer.size())
+		return;
+	m_pending.resize(count);
+	for (UINT32 index = 0; index < count; index++)
+	{
+		const UINT8 *src = &buffer[index * ENTRY_BYTES];
+		entry &cur = m_pending[index];
+		cur.m_pc = get_le32(&src[0]);
+		cur.m_crc = get_le32(&src[4]);
+		cur.m_mode = src[8];
+		cur.m_attempts = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  save - write the blocks compiled in this run,
+//  plus any from the previous run that never came
+//  up
+//-------------------------------------------------
+
+void drc_persistent_cache::save()
+{
+	if (!m_enabled)
+		return;
+
+	// blocks compiled in this run come first, then those still pending
+	dynamic_buffer buffer;
+	UINT32 count = 0;
+	auto append = [&buffer, &count](UINT8 mode, offs_t pc, UINT32 crc)
+	{
+		UINT8 data[ENTRY_BYTES] = { 0 };
+		put_le32(&data[0], pc);
+		put_le32(&data[4], crc);
+		data[8] = mode;
+		buffer.insert(buffer.end(), data, data + ENTRY_BYTES);
+		count++;
+	};
+	for (auto &block : m_compiled)
+		if (count < MAX_ENTRIES)
+			append(block.first >> 32, offs_t(block.first), block.second);
+	for (entry &cur : m_pending)
+		if (count < MAX_ENTRIES && m_compiled.find(key(cur.m_mode, cur.m_pc)) == m_compiled.end())
+			append(cur.m_mode, cur.m_pc, cur.m_crc);
+
+	// build the header
+	UINT8 header[HEADER_BYTES];
+	const char *shortname = m_device.shortname();
+	memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+	put_le32(&header[8], FILE_VERSION);
+	put_le32(&header[12], m_version);
+	put_le32(&header[16], core_crc32(0, (const UINT8 *)shortname, strlen(shortname)));
+	put_le32(&header[20], count);
+
+	emu_file file(m_device.machine().options().nvram_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(filename().c_str()) != FILERR_NONE)
+		return;
+	file.write(header, sizeof(header));
+	if (count != 0)
+		file.write(&buffer[0], buffer.size());
+}
@@ -0,0 +1,83 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcpersist.h
+
+    Persistent list of compiled blocks for recompiling CPU cores.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCPERSIST_H__
+#define __DRCPERSIST_H__
+
+#include "drcuml.h"
+#include "drcfe.h"
+
+#include <unordered_map>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> drc_persistent_cache
+
+// remembers which blocks a CPU core compiled in a previous run, and
+// recompiles them ahead of time once the source code is in place again
+class drc_persistent_cache
+{
+public:
+	// compiles a block of the given mode at the given pc
+	typedef delegate<void (UINT8, offs_t)> compile_delegate;
+
+	// construction/destruction
+	drc_persistent_cache(device_t &device, drcuml_state &drcuml, drc_frontend &frontend, UINT32 version, compile_delegate compile);
+	~drc_persistent_cache();
+
+	// getters
+	bool enabled() const { return m_enabled; }
+
+	// block tracking
+	void record(UINT8 mode, const opcode_desc *desclist);
+	void block_missing(UINT8 mode);
+
+	// file management
+	void save();
+
+	// helpers
+	static UINT32 checksum(const opcode_desc *desclist);
+
+private:
+	// a block compiled in a previous run
+	struct entry
+	{
+		UINT8               m_mode;             // mode the block was compiled in
+		offs_t              m_pc;               // starting pc of the block
+		UINT32              m_crc;              // checksum of the source opcodes
+		UINT8               m_attempts;         // replay attempts with mismatched source
+	};
+
+	// internal helpers
+	void load();
+	std::string filename() const;
+	static UINT64 key(UINT8 mode, offs_t pc) { return (UINT64(mode) << 32) | pc; }
+
+	// internal state
+	device_t &              m_device;           // CPU device the blocks belong to
+	drcuml_state &          m_drcuml;           // UML state of the CPU core
+	drc_frontend &          m_frontend;         // front-end used to describe blocks
+	compile_delegate        m_compile;          // compiles a block in the CPU core
+	UINT32                  m_version;          // front-end version the blocks must match
+	bool                    m_enabled;          // true if -drc_persist is on
+	bool                    m_replaying;        // true while replaying blocks
+	UINT32                  m_misses;           // missing code exits seen so far
+	UINT32                  m_nextreplay;       // miss count of the next replay pass
+	std::vector<entry>      m_pending;          // blocks from the file not yet recompiled
+	std::unordered_map<UINT64, UINT32> m_compiled; // blocks compiled in this run, and their checksums
+};
+
+
+#endif /* __DRCPERSIST_H__ */
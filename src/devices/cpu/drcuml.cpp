@@ -10,9 +10,6 @@
 
     Future improvements/changes:
 
-    * UML optimizer:
-        - constant folding
-
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
         - checks behavior of all opcodes
@@ -35,11 +32,16 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "debug/debugcmd.h"
+#include "debug/debugcon.h"
+#include "debug/debugcpu.h"
 #include "drcuml.h"
 #include "drcbec.h"
 #include "drcbex86.h"
 #include "drcbex64.h"
 
+#include <algorithm>
+
 using namespace uml;
 
 
@@ -53,6 +55,21 @@ using namespace uml;
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// granularity of source tracking for code invalidation
+const int CODE_PAGE_SHIFT = 12;
+
+// number of times the optimizer passes are repeated over a hot block
+const int HOT_BLOCK_ROUNDS = 3;
+
+// number of blocks the debugger commands act on by default
+const int DEFAULT_HOT_BLOCKS = 16;
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -69,6 +86,16 @@ struct bevalidate_test
 
 
 
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// the live UML states of each running machine, so the debugger commands can
+// find the one for a CPU without seeing states that belong to another machine
+static std::unordered_map<running_machine *, std::vector<drcuml_state *>> s_states;
+
+
+
 //**************************************************************************
 //  DRC BACKEND INTERFACE
 //**************************************************************************
@@ -114,6 +141,34 @@ drcbe_interface::~drcbe_interface()
 //  DRCUML STATE
 //**************************************************************************
 
+//-------------------------------------------------
+//  use_c_backend - return true if the C back-end
+//  should be used in place of the native one
+//-------------------------------------------------
+
+static bool use_c_backend(device_t &device, UINT32 flags)
+{
+	if (flags & DRCUML_OPTION_USE_C)
+		return true;
+	if (flags & DRCUML_OPTION_USE_NATIVE)
+		return false;
+	return device.machine().options().drc_use_c();
+}
+
+
+//-------------------------------------------------
+//  direct_iregs - return the number of integer
+//  registers a back-end maps to host registers
+//-------------------------------------------------
+
+static int direct_iregs(drcbe_interface &beintf)
+{
+	drcbe_info info;
+	beintf.get_info(info);
+	return info.direct_iregs;
+}
+
+
 //-------------------------------------------------
 //  drcuml_state - constructor
 //-------------------------------------------------
@@ -121,18 +176,36 @@ drcbe_interface::~drcbe_interface()
 drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits)
 	: m_device(device),
 		m_cache(cache),
-		m_drcbe_interface(device.machine().options().drc_use_c() ?
+		m_drcbe_interface(use_c_backend(device, flags) ?
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_c>(*this, device, cache, flags, modes, addrbits, ignorebits) } :
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_native>(*this, device, cache, flags, modes, addrbits, ignorebits) }),
 		m_beintf(*m_drcbe_interface.get()),
-		m_umllog(nullptr)
+		m_umllog(nullptr),
+		m_optimizer(direct_iregs(m_beintf))
 {
+	// turn off any optimization passes we were asked to
+	std::string badpasses;
+	m_optimizer.set_passes(drcuml_optimizer::PASS_ALL & ~drcuml_optimizer::parse_pass_list(device.machine().options().drc_disable_passes(), badpasses));
+	if (!badpasses.empty())
+		osd_printf_warning("Unknown UML optimizer passes: %s\n", badpasses.c_str());
+
 	// if we're to log, create the logfile
 	if (device.machine().options().drc_log_uml())
 	{
 		std::string filename = std::string("drcuml_").append(m_device.shortname()).append(".asm");
 		m_umllog = fopen(filename.c_str(), "w");
 	}
+
+	// the profiling commands are shared by every recompiling CPU in the machine
+	running_machine &machine = device.machine();
+	std::vector<drcuml_state *> &states = s_states[&machine];
+	bool first = states.empty();
+	states.push_back(this);
+	if (first && (machine.debug_flags & DEBUG_FLAG_ENABLED) != 0 && machine.phase() == MACHINE_PHASE_INIT)
+	{
+		debug_console_register_command(machine, "drchot", CMDFLAG_NONE, 0, 0, 2, execute_drchot);
+		debug_console_register_command(machine, "drcreopt", CMDFLAG_NONE, 0, 0, 2, execute_drcreopt);
+	}
 }
 
 
@@ -142,9 +215,27 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 
 drcuml_state::~drcuml_state()
 {
+	// report what the optimizer did
+	if (m_optimizer.blocks() != 0)
+	{
+		std::string stats = m_optimizer.stats_string();
+		osd_printf_verbose("%s: %s", m_device.tag(), stats.c_str());
+		log_printf("%s", stats.c_str());
+	}
+
 	// close any files
 	if (m_umllog != nullptr)
 		fclose(m_umllog);
+
+	// forget the machine entirely once its last state is gone
+	auto machine_states = s_states.find(&m_device.machine());
+	if (machine_states != s_states.end())
+	{
+		std::vector<drcuml_state *> &states = machine_states->second;
+		states.erase(std::remove(states.begin(), states.end(), this), states.end());
+		if (states.empty())
+			s_states.erase(machine_states);
+	}
 }
 
 
@@ -168,6 +259,11 @@ void drcuml_state::reset()
 		// call the backend to reset
 		m_beintf.reset();
 
+		// forget all tracked blocks; hot entries stay hot when they are recompiled
+		m_blocks.clear();
+		m_pageblocks.clear();
+		m_hashowner.clear();
+
 		// do a one-time validation if requested
 /*      if (VALIDATE_BACKEND)
         {
@@ -208,6 +304,239 @@ drcuml_block *drcuml_state::begin_block(UINT32 maxinst)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - unlink every block built
+//  from source in the given range, so that it is
+//  recompiled the next time it is reached;
+//  returns the number of blocks unlinked
+//-------------------------------------------------
+
+int drcuml_state::invalidate_code(offs_t start, offs_t end)
+{
+	UINT32 startpage = start >> CODE_PAGE_SHIFT;
+	UINT32 endpage = end >> CODE_PAGE_SHIFT;
+	int unlinked = 0;
+
+	// walk whichever is smaller: the pages in the range or the pages with code
+	std::vector<UINT32> pages;
+	if (UINT64(endpage) - startpage < m_pageblocks.size())
+	{
+		for (UINT64 page = startpage; page <= endpage; page++)
+			if (m_pageblocks.find(page) != m_pageblocks.end())
+				pages.push_back(page);
+	}
+	else
+	{
+		for (auto &entry : m_pageblocks)
+			if (entry.first >= startpage && entry.first <= endpage)
+				pages.push_back(entry.first);
+	}
+
+	for (UINT32 page : pages)
+	{
+		for (UINT32 blocknum : m_pageblocks[page])
+		{
+			tracked_block &block = m_blocks[blocknum];
+			if (!block.m_linked)
+				continue;
+
+			// point every hash entry that still belongs to this block back at the
+			// missing code handler; entries since taken over by a newer block stay
+			for (UINT64 hash : block.m_hashes)
+			{
+				auto owner = m_hashowner.find(hash);
+				if (owner != m_hashowner.end() && owner->second == blocknum)
+				{
+					m_beintf.hash_unlink(hash >> 32, UINT32(hash));
+					m_hashowner.erase(owner);
+				}
+			}
+			block.m_hashes.clear();
+			block.m_linked = false;
+			unlinked++;
+		}
+		m_pageblocks.erase(page);
+	}
+
+	if (logging() && unlinked != 0)
+		log_printf("Unlinked %d blocks from %08X-%08X\n", unlinked, start, end);
+	return unlinked;
+}
+
+
+//-------------------------------------------------
+//  get_hot_blocks - fill in the most frequently
+//  reached hash entries, most frequent first;
+//  returns the total count over all entries, or
+//  0 if the back-end doesn't profile
+//-------------------------------------------------
+
+UINT64 drcuml_state::get_hot_blocks(std::vector<drcbe_profile_entry> &entries, int maxcount)
+{
+	m_beintf.get_profile(entries);
+
+	// an entry compiled more than once appears once per compile
+	std::sort(entries.begin(), entries.end(), [](const drcbe_profile_entry &a, const drcbe_profile_entry &b) { return (a.mode != b.mode) ? (a.mode < b.mode) : (a.pc < b.pc); });
+	UINT64 total = 0;
+	size_t merged = 0;
+	for (size_t index = 0; index < entries.size(); index++)
+	{
+		total += entries[index].count;
+		if (merged != 0 && entries[merged - 1].mode == entries[index].mode && entries[merged - 1].pc == entries[index].pc)
+			entries[merged - 1].count += entries[index].count;
+		else
+			entries[merged++] = entries[index];
+	}
+	entries.resize(merged);
+
+	std::stable_sort(entries.begin(), entries.end(), [](const drcbe_profile_entry &a, const drcbe_profile_entry &b) { return a.count > b.count; });
+	while (!entries.empty() && (entries.size() > size_t(maxcount) || entries.back().count == 0))
+		entries.pop_back();
+	return total;
+}
+
+
+//-------------------------------------------------
+//  reoptimize_hot_blocks - unlink the most
+//  frequently reached hash entries so that they
+//  are recompiled with the optimizer passes
+//  repeated; returns the number unlinked
+//-------------------------------------------------
+
+int drcuml_state::reoptimize_hot_blocks(int maxcount)
+{
+	std::vector<drcbe_profile_entry> entries;
+	get_hot_blocks(entries, maxcount);
+
+	int unlinked = 0;
+	for (auto &entry : entries)
+		if (hash_exists(entry.mode, entry.pc))
+		{
+			UINT64 hash = (UINT64(entry.mode) << 32) | entry.pc;
+			m_hotblocks.insert(hash);
+			m_beintf.hash_unlink(entry.mode, entry.pc);
+			m_hashowner.erase(hash);
+			unlinked++;
+		}
+
+	if (logging() && unlinked != 0)
+		log_printf("Unlinked %d hot blocks for reoptimization\n", unlinked);
+	return unlinked;
+}
+
+
+//-------------------------------------------------
+//  track_block - note the source pages and hash
+//  entries of a block that has just been
+//  generated
+//-------------------------------------------------
+
+void drcuml_state::track_block(const std::vector<UINT32> &pages, const instruction *instructions, UINT32 count)
+{
+	UINT32 blocknum = m_blocks.size();
+	m_blocks.emplace_back();
+	tracked_block &block = m_blocks.back();
+	block.m_linked = true;
+
+	// the block now owns every hash entry it defined
+	for (UINT32 inum = 0; inum < count; inum++)
+		if (instructions[inum].opcode() == OP_HASH)
+		{
+			UINT64 hash = (UINT64(instructions[inum].param(0).immediate()) << 32) | UINT32(instructions[inum].param(1).immediate());
+			block.m_hashes.push_back(hash);
+			m_hashowner[hash] = blocknum;
+		}
+
+	for (UINT32 page : pages)
+		m_pageblocks[page].push_back(blocknum);
+}
+
+
+//-------------------------------------------------
+//  is_hot_block - return true if any hash entry
+//  defined by a block was marked hot
+//-------------------------------------------------
+
+bool drcuml_state::is_hot_block(const instruction *instructions, UINT32 count) const
+{
+	if (m_hotblocks.empty())
+		return false;
+	for (UINT32 inum = 0; inum < count; inum++)
+		if (instructions[inum].opcode() == OP_HASH)
+		{
+			UINT64 hash = (UINT64(instructions[inum].param(0).immediate()) << 32) | UINT32(instructions[inum].param(1).immediate());
+			if (m_hotblocks.find(hash) != m_hotblocks.end())
+				return true;
+		}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  find_state - find the UML state for the CPU
+//  named by a debugger parameter
+//-------------------------------------------------
+
+drcuml_state *drcuml_state::find_state(running_machine &machine, const char *param)
+{
+	device_t *cpu;
+	if (!debug_command_parameter_cpu(machine, param, &cpu))
+		return nullptr;
+
+	auto machine_states = s_states.find(&machine);
+	if (machine_states != s_states.end())
+		for (drcuml_state *state : machine_states->second)
+			if (&state->m_device == cpu)
+				return state;
+	debug_console_printf(machine, "%s is not using a recompiler\n", cpu->tag());
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  execute_drchot - list the most frequently
+//  reached blocks of a CPU
+//-------------------------------------------------
+
+void drcuml_state::execute_drchot(running_machine &machine, int ref, int params, const char **param)
+{
+	UINT64 count = DEFAULT_HOT_BLOCKS;
+	drcuml_state *drcuml = find_state(machine, (params > 0) ? param[0] : nullptr);
+	if (drcuml == nullptr || (params > 1 && !debug_command_parameter_number(machine, param[1], &count)))
+		return;
+
+	std::vector<drcbe_profile_entry> entries;
+	UINT64 total = drcuml->get_hot_blocks(entries, count);
+	if (total == 0)
+	{
+		debug_console_printf(machine, "No profile counts; run with -drc_profile on the x64 back-end\n");
+		return;
+	}
+
+	debug_console_printf(machine, "Mode  PC        Count             Share\n");
+	for (auto &entry : entries)
+		debug_console_printf(machine, "%4d  %08X  %16" I64FMT "u  %5.1f%%\n", entry.mode, entry.pc, entry.count, 100.0 * entry.count / total);
+}
+
+
+//-------------------------------------------------
+//  execute_drcreopt - recompile the most
+//  frequently reached blocks of a CPU with more
+//  optimization
+//-------------------------------------------------
+
+void drcuml_state::execute_drcreopt(running_machine &machine, int ref, int params, const char **param)
+{
+	UINT64 count = DEFAULT_HOT_BLOCKS;
+	drcuml_state *drcuml = find_state(machine, (params > 0) ? param[0] : nullptr);
+	if (drcuml == nullptr || (params > 1 && !debug_command_parameter_number(machine, param[1], &count)))
+		return;
+
+	int unlinked = drcuml->reoptimize_hot_blocks(count);
+	debug_console_printf(machine, "%d blocks will be recompiled when next reached\n", unlinked);
+}
+
+
 //-------------------------------------------------
 //  handle_alloc - allocate a new handle
 //-------------------------------------------------
@@ -318,6 +647,7 @@ void drcuml_block::begin()
 	// set up the block information and return it
 	m_inuse = true;
 	m_nextinst = 0;
+	m_pages.clear();
 }
 
 
@@ -340,6 +670,10 @@ void drcuml_block::end()
 	// generate the code via the back-end
 	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
 
+	// if the front-end told us where the code came from, remember it
+	if (!m_pages.empty())
+		m_drcuml.track_block(m_pages, &m_inst[0], m_nextinst);
+
 	// block is no longer in use
 	m_inuse = false;
 }
@@ -401,6 +735,24 @@ void drcuml_block::append_comment(const char *format, ...)
 }
 
 
+//-------------------------------------------------
+//  add_source - note that part of the block was
+//  built from the given range of source code
+//-------------------------------------------------
+
+void drcuml_block::add_source(offs_t start, UINT32 length)
+{
+	UINT32 endpage = (start + MAX(length, 1) - 1) >> CODE_PAGE_SHIFT;
+	for (UINT32 page = start >> CODE_PAGE_SHIFT; ; page++)
+	{
+		if (std::find(m_pages.begin(), m_pages.end(), page) == m_pages.end())
+			m_pages.push_back(page);
+		if (page == endpage)
+			break;
+	}
+}
+
+
 //-------------------------------------------------
 //  optimize - apply various optimizations to a
 //  block of code
@@ -445,6 +797,9 @@ void drcuml_block::optimize()
 		// now that flags are correct, simplify the instruction
 		inst.simplify();
 	}
+
+	// then run the optimization passes over the whole block
+	m_drcuml.optimizer().optimize(&m_inst[0], m_nextinst, m_maxinst, m_drcuml.is_hot_block(&m_inst[0], m_nextinst) ? HOT_BLOCK_ROUNDS : 1);
 }
 
 
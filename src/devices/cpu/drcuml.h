@@ -15,6 +15,10 @@
 
 #include "drccache.h"
 #include "uml.h"
+#include "drcumlopt.h"
+
+#include <unordered_map>
+#include <unordered_set>
 
 
 //**************************************************************************
@@ -22,7 +26,8 @@
 //**************************************************************************
 
 // these options are passed into drcuml_alloc() and control global behaviors
-
+const UINT32 DRCUML_OPTION_USE_C        = 0x0001;   // always use the C back-end
+const UINT32 DRCUML_OPTION_USE_NATIVE   = 0x0002;   // always use the native back-end
 
 
 //**************************************************************************
@@ -86,6 +91,15 @@ struct drcbe_info
 };
 
 
+// execution count of a hash entry, from a back-end that profiles its code
+struct drcbe_profile_entry
+{
+	UINT32              mode;               // mode of the entry
+	UINT32              pc;                 // PC of the entry
+	UINT64              count;              // number of times the entry was reached
+};
+
+
 // a drcuml_block describes a basic block of instructions
 class drcuml_block
 {
@@ -110,6 +124,9 @@ public:
 	uml::instruction &append();
 	void append_comment(const char *format, ...) ATTR_PRINTF(2,3);
 
+	// source tracking
+	void add_source(offs_t start, UINT32 length);
+
 	// this class is thrown if abort() is called
 	class abort_compilation : public emu_exception
 	{
@@ -130,6 +147,7 @@ private:
 	UINT32                  m_maxinst;          // maximum number of instructions
 	std::vector<uml::instruction> m_inst;     // pointer to the instruction list
 	bool                    m_inuse;            // this block is in use
+	std::vector<UINT32>     m_pages;            // source pages the block was built from
 };
 
 
@@ -146,9 +164,13 @@ public:
 	virtual int execute(uml::code_handle &entry) = 0;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) = 0;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) = 0;
+	virtual void hash_unlink(UINT32 mode, UINT32 pc) = 0;
 	virtual void get_info(drcbe_info &info) = 0;
 	virtual bool logging() const { return false; }
 
+	// optional overrides
+	virtual void get_profile(std::vector<drcbe_profile_entry> &entries) { entries.clear(); }
+
 protected:
 	// internal state
 	drcuml_state &          m_drcuml;           // pointer back to our owner
@@ -184,6 +206,16 @@ public:
 	bool hash_exists(UINT32 mode, UINT32 pc) { return m_beintf.hash_exists(mode, pc); }
 	void generate(drcuml_block &block, uml::instruction *instructions, UINT32 count) { m_beintf.generate(block, instructions, count); }
 
+	// code invalidation
+	int invalidate_code(offs_t start, offs_t end);
+
+	// optimization
+	drcuml_optimizer &optimizer() { return m_optimizer; }
+
+	// profiling
+	UINT64 get_hot_blocks(std::vector<drcbe_profile_entry> &entries, int maxcount);
+	int reoptimize_hot_blocks(int maxcount);
+
 	// handle management
 	uml::code_handle *handle_alloc(const char *name);
 
@@ -223,15 +255,37 @@ private:
 		std::string             m_name;             // name of the symbol
 	};
 
+	// a generated block, and the hash entries it defined
+	struct tracked_block
+	{
+		std::vector<UINT64>     m_hashes;           // mode/pc of each hash entry, mode in the upper half
+		bool                    m_linked;           // false once the block has been unlinked
+	};
+
+	// internal helpers
+	friend class drcuml_block;
+	void track_block(const std::vector<UINT32> &pages, const uml::instruction *instructions, UINT32 count);
+	bool is_hot_block(const uml::instruction *instructions, UINT32 count) const;
+
+	// debugger commands
+	static drcuml_state *find_state(running_machine &machine, const char *param);
+	static void execute_drchot(running_machine &machine, int ref, int params, const char **param);
+	static void execute_drcreopt(running_machine &machine, int ref, int params, const char **param);
+
 	// internal state
 	device_t &                  m_device;           // CPU device we are associated with
 	drc_cache &                 m_cache;            // pointer to the codegen cache
 	std::unique_ptr<drcbe_interface> m_drcbe_interface;
 	drcbe_interface &           m_beintf;           // backend interface pointer
 	FILE *                      m_umllog;           // handle to the UML logfile
+	drcuml_optimizer            m_optimizer;        // optimization passes run on each block
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
+	std::vector<tracked_block>  m_blocks;           // blocks generated since the last reset
+	std::unordered_map<UINT32, std::vector<UINT32>> m_pageblocks; // blocks built from each source page
+	std::unordered_map<UINT64, UINT32> m_hashowner; // block that each hash entry currently points into
+	std::unordered_set<UINT64>  m_hotblocks;        // hash entries to optimize harder when next compiled
 };
 
 
@@ -0,0 +1,869 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcumlopt.cpp
+
+    Optimization passes over UML blocks.
+
+****************************************************************************
+
+    These passes run after drcuml_block::optimize() has worked out which
+    flags each instruction must produce, resolved map variables and
+    simplified constant operations.  They only ever replace operands,
+    turn instructions into NOPs or add moves that leave the flags alone,
+    so the flag requirements computed there stay valid.
+
+    Every pass works on straight-line code.  Labels, handles and hash
+    entries can be reached from elsewhere, so nothing learned before
+    them is trusted afterwards.  Anything that leaves the block or calls
+    out (JMP, EXIT, HASHJMP, RET, CALLH, EXH, CALLC, DEBUG, SAVE) is
+    assumed to read every register and all memory, and calls are also
+    assumed to change them.  READ and WRITE go through memory handlers
+    that may touch the CPU state, and LOAD and STORE index memory the
+    passes cannot see, so those end what is known about memory.
+
+    constprop
+        Tracks integer registers set by unconditional MOVs of immediates
+        or other registers, substitutes the constant or the original
+        register into later reads and lets instruction::simplify() fold
+        the result.  A 32-bit MOV only says something about the low half
+        of the register, so it is never used for a 64-bit read.
+
+    memforward
+        Tracks memory operands written by unconditional MOVs or loaded
+        into registers by them.  Later reads of the same location and
+        size use the register or immediate instead, stores of the value
+        a location already holds are dropped, and a MOV to memory that
+        is overwritten before anything can read it is removed.
+
+    regalloc
+        Linear scan over regions between the instructions above.  A
+        memory operand used often enough within a region is given one of
+        the integer registers the back-end maps onto a host register,
+        provided that register is not referenced over the live range of
+        the operand and is overwritten before it is read again.  The
+        value is loaded before its first use and written back after its
+        last write.  Back-ends without direct-mapped registers gain
+        nothing from this and skip it.
+
+    deadcode
+        Removes code that follows an unconditional JMP, EXIT, HASHJMP or
+        RET up to the next label, handle or hash, then walks each block
+        backwards and removes instructions whose only effect is to write
+        registers that are overwritten before being read and whose flags
+        nobody needs.  After a 32-bit write the upper half of a register
+        is undefined, so such a write counts as overwriting it.
+
+    The -drc_disable_passes option turns individual passes off, which is
+    the quickest way to find out whether one of them is responsible for
+    a problem in generated code.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcumlopt.h"
+
+#include <algorithm>
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// how an instruction interacts with the state the passes track
+const UINT8 EFFECT_ENTRY        = 0x01;     // code may arrive here from elsewhere
+const UINT8 EFFECT_EXIT         = 0x02;     // may leave straight-line code; reads all registers and memory
+const UINT8 EFFECT_READMEM      = 0x04;     // reads memory the passes can't see
+const UINT8 EFFECT_WRITEMEM     = 0x08;     // writes memory the passes can't see
+const UINT8 EFFECT_WRITEREGS    = 0x10;     // may change any register
+const UINT8 EFFECT_PURE         = 0x20;     // no effects beyond its operands and flags
+const UINT8 EFFECT_END          = 0x40;     // never falls through when unconditional
+
+// instructions that end a region for register allocation
+const UINT8 EFFECT_BOUNDARY     = EFFECT_ENTRY | EFFECT_EXIT | EFFECT_READMEM | EFFECT_WRITEMEM | EFFECT_WRITEREGS;
+
+// a memory operand must save at least this many accesses to be promoted
+const int REGALLOC_MIN_SAVINGS = 2;
+
+// bitmask covering every integer and floating point register
+const UINT32 ALL_REGISTERS = (1 << (REG_I_COUNT + REG_F_COUNT)) - 1;
+
+// pass names, as used by -drc_disable_passes
+static const char *const s_pass_names[drcuml_optimizer::PASS_COUNT] =
+{
+	"constprop",
+	"memforward",
+	"regalloc",
+	"deadcode"
+};
+
+// what the statistics for each pass count
+static const char *const s_pass_units[drcuml_optimizer::PASS_COUNT] =
+{
+	"operands propagated",
+	"memory accesses removed",
+	"memory operands promoted",
+	"instructions removed"
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  opcode_effects - return the EFFECT_* flags
+//  for an instruction
+//-------------------------------------------------
+
+static UINT8 opcode_effects(const instruction &inst)
+{
+	switch (inst.opcode())
+	{
+		case OP_NOP:
+		case OP_COMMENT:
+		case OP_MAPVAR:
+			return 0;
+
+		case OP_HANDLE:
+		case OP_HASH:
+		case OP_LABEL:
+			return EFFECT_ENTRY;
+
+		case OP_JMP:
+		case OP_EXIT:
+		case OP_HASHJMP:
+		case OP_RET:
+			return EFFECT_EXIT | EFFECT_END;
+
+		case OP_DEBUG:
+		case OP_EXH:
+		case OP_CALLH:
+		case OP_CALLC:
+		case OP_SAVE:
+		case OP_RESTORE:
+			return EFFECT_EXIT | EFFECT_READMEM | EFFECT_WRITEMEM | EFFECT_WRITEREGS;
+
+		case OP_READ:
+		case OP_READM:
+		case OP_WRITE:
+		case OP_WRITEM:
+		case OP_FREAD:
+		case OP_FWRITE:
+			return EFFECT_READMEM | EFFECT_WRITEMEM;
+
+		// vector operands are 16 bytes wide, which the passes don't track
+		case OP_VMOV:
+		case OP_VSHUF:
+		case OP_VADDW:
+		case OP_VADDSW:
+		case OP_VSUBW:
+		case OP_VSUBSW:
+		case OP_VMINSW:
+		case OP_VMAXSW:
+		case OP_VCMPGTW:
+		case OP_VAND:
+		case OP_VOR:
+		case OP_VXOR:
+		case OP_VMULLW:
+		case OP_VMULHW:
+		case OP_VSATW:
+			return EFFECT_READMEM | EFFECT_WRITEMEM;
+
+		case OP_LOAD:
+		case OP_LOADS:
+		case OP_FLOAD:
+			return EFFECT_READMEM | EFFECT_PURE;
+
+		case OP_STORE:
+		case OP_FSTORE:
+			return EFFECT_WRITEMEM;
+
+		case OP_RECOVER:
+		case OP_SETFMOD:
+			return 0;
+
+		default:
+			return EFFECT_PURE;
+	}
+}
+
+
+//-------------------------------------------------
+//  memory_operand - return true if a parameter
+//  is a memory operand, along with its location
+//  and size
+//-------------------------------------------------
+
+static inline bool memory_operand(const instruction &inst, int pnum, const UINT8 *&base, UINT8 &bytes)
+{
+	if (!inst.param(pnum).is_memory() || inst.param_is_pointer(pnum))
+		return false;
+	base = reinterpret_cast<const UINT8 *>(inst.param(pnum).memory());
+	bytes = 1 << inst.param_size(pnum);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  overlaps - return true if two memory operands
+//  share any bytes
+//-------------------------------------------------
+
+static inline bool overlaps(const UINT8 *base1, UINT8 bytes1, const UINT8 *base2, UINT8 bytes2)
+{
+	return (base1 < base2 + bytes2 && base2 < base1 + bytes1);
+}
+
+
+//-------------------------------------------------
+//  register_bit - return the liveness bit for a
+//  register parameter, or 0 for anything else
+//-------------------------------------------------
+
+static inline UINT32 register_bit(const parameter &param)
+{
+	if (param.is_int_register())
+		return 1 << (param.ireg() - REG_I0);
+	if (param.is_float_register())
+		return 1 << (REG_I_COUNT + param.freg() - REG_F0);
+	return 0;
+}
+
+
+//-------------------------------------------------
+//  is_live - return true if an instruction is
+//  anything but a placeholder
+//-------------------------------------------------
+
+static inline bool is_live(const instruction &inst)
+{
+	return (inst.opcode() != OP_NOP && inst.opcode() != OP_COMMENT && inst.opcode() != OP_MAPVAR);
+}
+
+
+//-------------------------------------------------
+//  writes_always - return true if an instruction
+//  always writes its outputs; DIVU and DIVS leave
+//  them alone when dividing by zero
+//-------------------------------------------------
+
+static inline bool writes_always(const instruction &inst)
+{
+	return (inst.condition() == COND_ALWAYS && inst.opcode() != OP_DIVU && inst.opcode() != OP_DIVS);
+}
+
+
+//-------------------------------------------------
+//  insert_instruction - insert an instruction
+//  into a block, shifting the rest down
+//-------------------------------------------------
+
+static void insert_instruction(instruction *inst, UINT32 &count, UINT32 index, const instruction &newinst)
+{
+	for (UINT32 inum = count; inum > index; inum--)
+		inst[inum] = inst[inum - 1];
+	inst[index] = newinst;
+	count++;
+}
+
+
+
+//**************************************************************************
+//  UML OPTIMIZER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcuml_optimizer - constructor
+//-------------------------------------------------
+
+drcuml_optimizer::drcuml_optimizer(int direct_iregs, UINT32 passes)
+	: m_direct_iregs(MIN(direct_iregs, REG_I_COUNT)),
+		m_passes(passes & PASS_ALL),
+		m_blocks(0),
+		m_instin(0),
+		m_instout(0)
+{
+	memset(m_changes, 0, sizeof(m_changes));
+}
+
+
+//-------------------------------------------------
+//  optimize - run the enabled passes over a
+//  block; count is updated if instructions are
+//  added, up to maxcount; with more than one
+//  round the passes other than regalloc are
+//  repeated until they stop finding changes
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize(instruction *inst, UINT32 &count, UINT32 maxcount, int rounds)
+{
+	m_blocks++;
+	for (UINT32 inum = 0; inum < count; inum++)
+		m_instin += is_live(inst[inum]);
+
+	for (int round = 0; round < rounds; round++)
+	{
+		UINT64 before = total_changes();
+		if (m_passes & (1 << PASS_CONSTPROP))
+			constprop(inst, count);
+		if (m_passes & (1 << PASS_MEMFORWARD))
+			memforward(inst, count);
+		if (round == 0 && (m_passes & (1 << PASS_REGALLOC)))
+			regalloc(inst, count, maxcount);
+		if (m_passes & (1 << PASS_DEADCODE))
+			deadcode(inst, count);
+		if (total_changes() == before)
+			break;
+	}
+
+	for (UINT32 inum = 0; inum < count; inum++)
+		m_instout += is_live(inst[inum]);
+}
+
+
+//-------------------------------------------------
+//  pass_name/pass_units - return the name of a
+//  pass and what its statistics count
+//-------------------------------------------------
+
+const char *drcuml_optimizer::pass_name(int pass)
+{
+	assert(pass < PASS_COUNT);
+	return s_pass_names[pass];
+}
+
+const char *drcuml_optimizer::pass_units(int pass)
+{
+	assert(pass < PASS_COUNT);
+	return s_pass_units[pass];
+}
+
+
+//-------------------------------------------------
+//  parse_pass_list - convert a comma-separated
+//  list of pass names into a mask; unknown names
+//  are added to errors
+//-------------------------------------------------
+
+UINT32 drcuml_optimizer::parse_pass_list(const char *list, std::string &errors)
+{
+	UINT32 mask = 0;
+	std::string remaining(list);
+	while (!remaining.empty())
+	{
+		size_t comma = remaining.find(',');
+		std::string name = remaining.substr(0, comma);
+		remaining = (comma == std::string::npos) ? "" : remaining.substr(comma + 1);
+		strtrimspace(name);
+		if (name.empty())
+			continue;
+
+		if (core_stricmp(name.c_str(), "all") == 0)
+			mask |= PASS_ALL;
+		else
+		{
+			int pass;
+			for (pass = 0; pass < PASS_COUNT; pass++)
+				if (core_stricmp(name.c_str(), s_pass_names[pass]) == 0)
+					break;
+			if (pass < PASS_COUNT)
+				mask |= 1 << pass;
+			else
+				errors.append(errors.empty() ? "" : ", ").append(name);
+		}
+	}
+	return mask;
+}
+
+
+//-------------------------------------------------
+//  stats_string - return a summary of what the
+//  passes have done so far
+//-------------------------------------------------
+
+std::string drcuml_optimizer::stats_string() const
+{
+	std::string result = strformat("UML optimizer: %u blocks, %u instructions reduced to %u\n", UINT32(m_blocks), UINT32(m_instin), UINT32(m_instout));
+	for (int pass = 0; pass < PASS_COUNT; pass++)
+		result.append(strformat("  %-10s %10u %s%s\n", s_pass_names[pass], UINT32(m_changes[pass]), s_pass_units[pass], (m_passes & (1 << pass)) ? "" : " (disabled)"));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  constprop - propagate constants and copies
+//  held in integer registers
+//-------------------------------------------------
+
+void drcuml_optimizer::constprop(instruction *inst, UINT32 count)
+{
+	// what is known about each integer register; a copy refers to the
+	// register it was copied from, which is forgotten when that one changes
+	struct register_value
+	{
+		UINT8       bytes;                  // bytes known, or 0 if nothing is known
+		bool        isconst;                // true for a constant, false for a copy
+		UINT64      value;                  // constant value or register copied
+	};
+	register_value known[REG_I_COUNT];
+	memset(known, 0, sizeof(known));
+
+	auto forget = [&known](int regnum)
+	{
+		known[regnum].bytes = 0;
+		for (register_value &reg : known)
+			if (reg.bytes != 0 && !reg.isconst && reg.value == regnum)
+				reg.bytes = 0;
+	};
+
+	for (UINT32 inum = 0; inum < count; inum++)
+	{
+		instruction &cur = inst[inum];
+		UINT8 effects = opcode_effects(cur);
+		if (effects & EFFECT_ENTRY)
+			memset(known, 0, sizeof(known));
+
+		// substitute what we know into registers that are only read
+		int changes = 0;
+		for (int pnum = 0; pnum < cur.numparams(); pnum++)
+		{
+			const parameter &param = cur.param(pnum);
+			if (!param.is_int_register() || !cur.param_is_input(pnum) || cur.param_is_output(pnum))
+				continue;
+
+			// a read of more bytes than are known gets nothing
+			register_value &reg = known[param.ireg() - REG_I0];
+			UINT8 bytes = 1 << cur.param_size(pnum);
+			if (reg.bytes < bytes)
+				continue;
+
+			if (reg.isconst && cur.param_allows(pnum, parameter::PTYPE_IMMEDIATE))
+			{
+				cur.set_param(pnum, (bytes == 8) ? reg.value : (reg.value & 0xffffffff));
+				changes++;
+			}
+			else if (!reg.isconst)
+			{
+				cur.set_param(pnum, parameter::make_ireg(REG_I0 + reg.value));
+				changes++;
+			}
+		}
+		if (changes != 0)
+		{
+			m_changes[PASS_CONSTPROP] += changes;
+			cur.simplify();
+		}
+
+		// forget registers the instruction writes, conditionally or not
+		if (effects & EFFECT_WRITEREGS)
+			memset(known, 0, sizeof(known));
+		else
+			for (int pnum = 0; pnum < cur.numparams(); pnum++)
+				if (cur.param(pnum).is_int_register() && cur.param_is_output(pnum))
+					forget(cur.param(pnum).ireg() - REG_I0);
+
+		// remember the result of an unconditional move into a register
+		if (cur.opcode() == OP_MOV && cur.condition() == COND_ALWAYS && cur.param(0).is_int_register())
+		{
+			register_value &dst = known[cur.param(0).ireg() - REG_I0];
+			const parameter &src = cur.param(1);
+			if (src.is_immediate())
+			{
+				dst.bytes = cur.size();
+				dst.isconst = true;
+				dst.value = (cur.size() == 8) ? src.immediate() : (src.immediate() & 0xffffffff);
+			}
+			else if (src.is_int_register() && src != cur.param(0))
+			{
+				dst.bytes = cur.size();
+				dst.isconst = false;
+				dst.value = src.ireg() - REG_I0;
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  memforward - forward stored and loaded values
+//  to later reads of the same memory, and remove
+//  redundant and dead stores
+//-------------------------------------------------
+
+void drcuml_optimizer::memforward(instruction *inst, UINT32 count)
+{
+	m_values.clear();
+	m_stores.clear();
+
+	for (UINT32 inum = 0; inum < count; inum++)
+	{
+		instruction &cur = inst[inum];
+		UINT8 effects = opcode_effects(cur);
+		if (effects & EFFECT_ENTRY)
+		{
+			m_values.clear();
+			m_stores.clear();
+		}
+
+		// substitute known values for memory that is only read
+		const UINT8 *base;
+		UINT8 bytes;
+		int changes = 0;
+		for (int pnum = 0; pnum < cur.numparams(); pnum++)
+			if (memory_operand(cur, pnum, base, bytes) && !cur.param_is_output(pnum))
+				for (const memory_value &value : m_values)
+					if (value.m_base == base && value.m_bytes == bytes)
+					{
+						if (value.m_isreg && cur.param_allows(pnum, parameter::PTYPE_INT_REGISTER))
+						{
+							cur.set_param(pnum, parameter::make_ireg(REG_I0 + value.m_value));
+							changes++;
+						}
+						else if (!value.m_isreg && cur.param_allows(pnum, parameter::PTYPE_IMMEDIATE))
+						{
+							cur.set_param(pnum, value.m_value);
+							changes++;
+						}
+						break;
+					}
+		if (changes != 0)
+		{
+			m_changes[PASS_MEMFORWARD] += changes;
+			cur.simplify();
+		}
+
+		// a store of the value the location already holds does nothing
+		bool ismov = (cur.opcode() == OP_MOV && cur.condition() == COND_ALWAYS);
+		if (ismov && memory_operand(cur, 0, base, bytes) && (cur.param(1).is_immediate() || cur.param(1).is_int_register()))
+		{
+			bool isreg = cur.param(1).is_int_register();
+			UINT64 newvalue = isreg ? cur.param(1).ireg() - REG_I0 : (bytes == 8) ? cur.param(1).immediate() : (cur.param(1).immediate() & 0xffffffff);
+			bool redundant = false;
+			for (const memory_value &value : m_values)
+				if (value.m_base == base && value.m_bytes == bytes && value.m_isreg == isreg && value.m_value == newvalue)
+					redundant = true;
+			if (redundant)
+			{
+				cur.nop();
+				m_changes[PASS_MEMFORWARD]++;
+				continue;
+			}
+		}
+
+		// anything read keeps pending stores to it
+		if (effects & (EFFECT_EXIT | EFFECT_READMEM))
+			m_stores.clear();
+		for (int pnum = 0; pnum < cur.numparams(); pnum++)
+			if (memory_operand(cur, pnum, base, bytes) && cur.param_is_input(pnum))
+				for (size_t snum = 0; snum < m_stores.size(); )
+				{
+					if (overlaps(m_stores[snum].m_base, m_stores[snum].m_bytes, base, bytes))
+						m_stores.erase(m_stores.begin() + snum);
+					else
+						snum++;
+				}
+
+		// anything written makes a pending store to the same place dead, and
+		// forgets what we knew about it
+		if (effects & EFFECT_WRITEMEM)
+			m_values.clear();
+		for (int pnum = 0; pnum < cur.numparams(); pnum++)
+			if (memory_operand(cur, pnum, base, bytes) && cur.param_is_output(pnum))
+			{
+				for (size_t snum = 0; snum < m_stores.size(); )
+				{
+					pending_store &store = m_stores[snum];
+					if (!overlaps(store.m_base, store.m_bytes, base, bytes))
+						snum++;
+					else
+					{
+						if (store.m_base == base && store.m_bytes == bytes && writes_always(cur) && !cur.param_is_input(pnum))
+						{
+							inst[store.m_inst].nop();
+							m_changes[PASS_MEMFORWARD]++;
+						}
+						m_stores.erase(m_stores.begin() + snum);
+					}
+				}
+				for (size_t vnum = 0; vnum < m_values.size(); )
+				{
+					if (overlaps(m_values[vnum].m_base, m_values[vnum].m_bytes, base, bytes))
+						m_values.erase(m_values.begin() + vnum);
+					else
+						vnum++;
+				}
+			}
+
+		// forget values held in registers the instruction writes
+		for (size_t vnum = 0; vnum < m_values.size(); )
+		{
+			bool clobbered = false;
+			if (m_values[vnum].m_isreg)
+			{
+				if (effects & EFFECT_WRITEREGS)
+					clobbered = true;
+				for (int pnum = 0; pnum < cur.numparams(); pnum++)
+					if (cur.param(pnum).is_int_register() && cur.param_is_output(pnum) && cur.param(pnum).ireg() - REG_I0 == m_values[vnum].m_value)
+						clobbered = true;
+			}
+			if (clobbered)
+				m_values.erase(m_values.begin() + vnum);
+			else
+				vnum++;
+		}
+
+		// remember what an unconditional move leaves behind
+		if (ismov)
+		{
+			const parameter &src = cur.param(1);
+			memory_value value;
+			if (memory_operand(cur, 0, value.m_base, value.m_bytes))
+			{
+				pending_store store = { value.m_base, value.m_bytes, inum };
+				m_stores.push_back(store);
+				if (src.is_int_register() || src.is_immediate())
+				{
+					value.m_isreg = src.is_int_register();
+					value.m_value = value.m_isreg ? src.ireg() - REG_I0 : (value.m_bytes == 8) ? src.immediate() : (src.immediate() & 0xffffffff);
+					m_values.push_back(value);
+				}
+			}
+			else if (cur.param(0).is_int_register() && memory_operand(cur, 1, value.m_base, value.m_bytes))
+			{
+				value.m_isreg = true;
+				value.m_value = cur.param(0).ireg() - REG_I0;
+				m_values.push_back(value);
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  regalloc - promote frequently used memory
+//  operands to direct-mapped registers that are
+//  free over their live range
+//-------------------------------------------------
+
+void drcuml_optimizer::regalloc(instruction *inst, UINT32 &count, UINT32 maxcount)
+{
+	if (m_direct_iregs == 0)
+		return;
+
+	for (UINT32 start = 0; start < count; )
+	{
+		// find the end of the region
+		UINT32 end = start;
+		while (end < count && (opcode_effects(inst[end]) & EFFECT_BOUNDARY) == 0)
+			end++;
+
+		// promote one operand at a time until nothing more pays off
+		for (int promoted = 0; promoted < m_direct_iregs; promoted++)
+			if (!promote_one(inst, count, maxcount, start, end))
+				break;
+		start = end + 1;
+	}
+}
+
+
+//-------------------------------------------------
+//  promote_one - promote the most used memory
+//  operand in the region [start,end) that has a
+//  free register; returns false if there is none
+//-------------------------------------------------
+
+bool drcuml_optimizer::promote_one(instruction *inst, UINT32 &count, UINT32 maxcount, UINT32 start, UINT32 &end)
+{
+	// gather the memory operands used in the region
+	m_candidates.clear();
+	for (UINT32 inum = start; inum < end; inum++)
+	{
+		const instruction &cur = inst[inum];
+		const UINT8 *base;
+		UINT8 bytes;
+		for (int pnum = 0; pnum < cur.numparams(); pnum++)
+			if (memory_operand(cur, pnum, base, bytes))
+			{
+				// only operands that are always accessed the same way, with no
+				// overlapping neighbours, can live in a register
+				bool usable = ((bytes == 4 || bytes == 8) && cur.param_allows(pnum, parameter::PTYPE_INT_REGISTER));
+				candidate *found = nullptr;
+				for (candidate &cand : m_candidates)
+					if (cand.m_base == base && cand.m_bytes == bytes)
+						found = &cand;
+					else if (overlaps(cand.m_base, cand.m_bytes, base, bytes))
+					{
+						cand.m_usable = false;
+						usable = false;
+					}
+				if (found == nullptr)
+				{
+					candidate cand = { base, bytes, true, false, 0, inum, inum };
+					m_candidates.push_back(cand);
+					found = &m_candidates.back();
+				}
+				found->m_usable &= usable;
+				found->m_written |= cur.param_is_output(pnum);
+				found->m_uses++;
+				found->m_last = inum;
+			}
+	}
+
+	// try the candidates from most to least used
+	std::sort(m_candidates.begin(), m_candidates.end(), [](const candidate &a, const candidate &b) { return a.m_uses > b.m_uses; });
+	for (const candidate &cand : m_candidates)
+	{
+		if (!cand.m_usable)
+			continue;
+
+		// the value has to be loaded first unless the first use overwrites it
+		const instruction &first = inst[cand.m_first];
+		bool needload = !writes_always(first);
+		for (int pnum = 0; pnum < first.numparams(); pnum++)
+			if (first.param(pnum).is_memory() && first.param(pnum).memory() == cand.m_base && first.param_is_input(pnum))
+				needload = true;
+		int extra = (needload ? 1 : 0) + (cand.m_written ? 1 : 0);
+		if (cand.m_uses - extra < REGALLOC_MIN_SAVINGS)
+			break;
+		if (count + extra > maxcount)
+			return false;
+
+		for (int regnum = 0; regnum < m_direct_iregs; regnum++)
+		{
+			parameter reg = parameter::make_ireg(REG_I0 + regnum);
+
+			// the register must not be referenced over the live range...
+			bool used = false;
+			for (UINT32 inum = cand.m_first; inum <= cand.m_last && !used; inum++)
+				for (int pnum = 0; pnum < inst[inum].numparams(); pnum++)
+					if (inst[inum].param(pnum) == reg)
+						used = true;
+			if (used)
+				continue;
+
+			// ...and must be overwritten before it is read again
+			bool dead = false;
+			for (UINT32 inum = cand.m_last + 1; inum < count; inum++)
+			{
+				const instruction &cur = inst[inum];
+				if (opcode_effects(cur) & (EFFECT_ENTRY | EFFECT_EXIT | EFFECT_WRITEREGS))
+					break;
+				bool reads = false, writes = false;
+				for (int pnum = 0; pnum < cur.numparams(); pnum++)
+					if (cur.param(pnum) == reg)
+					{
+						reads |= cur.param_is_input(pnum);
+						writes |= cur.param_is_output(pnum);
+					}
+				if (reads || writes)
+				{
+					dead = (!reads && writes_always(cur));
+					break;
+				}
+			}
+			if (!dead)
+				continue;
+
+			// rewrite the uses, then add the write-back and the load
+			for (UINT32 inum = cand.m_first; inum <= cand.m_last; inum++)
+				for (int pnum = 0; pnum < inst[inum].numparams(); pnum++)
+					if (inst[inum].param(pnum).is_memory() && inst[inum].param(pnum).memory() == cand.m_base && !inst[inum].param_is_pointer(pnum))
+						inst[inum].set_param(pnum, reg);
+
+			instruction mov;
+			if (cand.m_written)
+			{
+				if (cand.m_bytes == 4)
+					mov.mov(parameter::make_memory(cand.m_base), reg);
+				else
+					mov.dmov(parameter::make_memory(cand.m_base), reg);
+				insert_instruction(inst, count, cand.m_last + 1, mov);
+			}
+			if (needload)
+			{
+				if (cand.m_bytes == 4)
+					mov.mov(reg, parameter::make_memory(cand.m_base));
+				else
+					mov.dmov(reg, parameter::make_memory(cand.m_base));
+				insert_instruction(inst, count, cand.m_first, mov);
+			}
+			end += extra;
+			m_changes[PASS_REGALLOC]++;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  deadcode - remove unreachable instructions and
+//  writes to registers that are never read
+//-------------------------------------------------
+
+void drcuml_optimizer::deadcode(instruction *inst, UINT32 count)
+{
+	// nothing after an unconditional jump is reachable until the next entry point
+	bool reachable = true;
+	for (UINT32 inum = 0; inum < count; inum++)
+	{
+		instruction &cur = inst[inum];
+		UINT8 effects = opcode_effects(cur);
+		if (effects & EFFECT_ENTRY)
+			reachable = true;
+		else if (!reachable && is_live(cur))
+		{
+			cur.nop();
+			m_changes[PASS_DEADCODE]++;
+		}
+		else if ((effects & EFFECT_END) && cur.condition() == COND_ALWAYS)
+			reachable = false;
+	}
+
+	// walk backwards tracking which registers are live; everything is live at
+	// the end of the block and wherever control can leave
+	UINT32 live = ALL_REGISTERS;
+	for (UINT32 inum = count; inum-- > 0; )
+	{
+		instruction &cur = inst[inum];
+		UINT8 effects = opcode_effects(cur);
+		if (effects & (EFFECT_EXIT | EFFECT_WRITEREGS))
+		{
+			live = ALL_REGISTERS;
+			continue;
+		}
+
+		UINT32 inputs = 0, outputs = 0;
+		bool sideeffects = !(effects & EFFECT_PURE);
+		for (int pnum = 0; pnum < cur.numparams(); pnum++)
+		{
+			const parameter &param = cur.param(pnum);
+			if (cur.param_is_input(pnum))
+				inputs |= register_bit(param);
+			if (cur.param_is_output(pnum))
+			{
+				outputs |= register_bit(param);
+				if (param.is_memory())
+					sideeffects = true;
+			}
+		}
+
+		// an instruction that only writes dead registers can go
+		if (!sideeffects && cur.flags() == 0 && (outputs & live) == 0)
+		{
+			cur.nop();
+			m_changes[PASS_DEADCODE]++;
+			continue;
+		}
+
+		if (writes_always(cur))
+			live &= ~outputs;
+		live |= inputs;
+	}
+}
@@ -0,0 +1,118 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcumlopt.h
+
+    Optimization passes over UML blocks.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCUMLOPT_H__
+#define __DRCUMLOPT_H__
+
+#include "uml.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> drcuml_optimizer
+
+// rewrites the instructions of a block before they are handed to the
+// back-end; each pass can be switched off to bisect code generation problems
+class drcuml_optimizer
+{
+public:
+	// optimization passes, in the order they run
+	enum
+	{
+		PASS_CONSTPROP = 0,                     // constant and copy propagation through registers
+		PASS_MEMFORWARD,                        // redundant memory load and store elimination
+		PASS_REGALLOC,                          // hot memory operands promoted to free registers
+		PASS_DEADCODE,                          // unreachable code and dead register writes
+		PASS_COUNT
+	};
+
+	// bitmask with every pass enabled
+	static const UINT32 PASS_ALL = (1 << PASS_COUNT) - 1;
+
+	// construction/destruction
+	drcuml_optimizer(int direct_iregs, UINT32 passes = PASS_ALL);
+
+	// getters
+	UINT32 passes() const { return m_passes; }
+	UINT64 changes(int pass) const { assert(pass < PASS_COUNT); return m_changes[pass]; }
+	UINT64 blocks() const { return m_blocks; }
+	UINT64 instructions_in() const { return m_instin; }
+	UINT64 instructions_out() const { return m_instout; }
+
+	// setters
+	void set_passes(UINT32 passes) { m_passes = passes & PASS_ALL; }
+
+	// optimization
+	void optimize(uml::instruction *inst, UINT32 &count, UINT32 maxcount, int rounds = 1);
+
+	// helpers
+	static const char *pass_name(int pass);
+	static const char *pass_units(int pass);
+	static UINT32 parse_pass_list(const char *list, std::string &errors);
+	std::string stats_string() const;
+
+private:
+	// a value known to be held in a memory location
+	struct memory_value
+	{
+		const UINT8 *       m_base;             // start of the location
+		UINT8               m_bytes;            // size of the location
+		bool                m_isreg;            // true if the value is held in a register
+		UINT64              m_value;            // immediate value or register number
+	};
+
+	// a store that is dead if overwritten before being read
+	struct pending_store
+	{
+		const UINT8 *       m_base;             // start of the location
+		UINT8               m_bytes;            // size of the location
+		UINT32              m_inst;             // index of the storing instruction
+	};
+
+	// a memory operand that might be promoted to a register
+	struct candidate
+	{
+		const UINT8 *       m_base;             // start of the location
+		UINT8               m_bytes;            // size of the location
+		bool                m_usable;           // false if it can't live in a register
+		bool                m_written;          // true if it is written in the region
+		int                 m_uses;             // number of operands referring to it
+		UINT32              m_first;            // index of the first instruction using it
+		UINT32              m_last;             // index of the last instruction using it
+	};
+
+	// the passes
+	void constprop(uml::instruction *inst, UINT32 count);
+	void memforward(uml::instruction *inst, UINT32 count);
+	void regalloc(uml::instruction *inst, UINT32 &count, UINT32 maxcount);
+	void deadcode(uml::instruction *inst, UINT32 count);
+
+	// internal helpers
+	UINT64 total_changes() const { UINT64 total = 0; for (UINT64 changes : m_changes) total += changes; return total; }
+	bool promote_one(uml::instruction *inst, UINT32 &count, UINT32 maxcount, UINT32 start, UINT32 &end);
+
+	// internal state
+	int                 m_direct_iregs;         // integer registers the back-end maps to host registers
+	UINT32              m_passes;               // mask of enabled passes
+	UINT64              m_blocks;               // blocks optimized
+	UINT64              m_instin;               // instructions before optimization
+	UINT64              m_instout;              // live instructions after optimization
+	UINT64              m_changes[PASS_COUNT];  // changes made by each pass
+	std::vector<memory_value> m_values;         // scratch list of known memory values
+	std::vector<pending_store> m_stores;        // scratch list of pending stores
+	std::vector<candidate> m_candidates;        // scratch list of promotion candidates
+};
+
+
+#endif /* __DRCUMLOPT_H__ */
@@ -180,5 +180,22 @@
 #define UML_FDRECIP(block, dst, src1)                       do { block->append().fdrecip(dst, src1); } while (0)
 #define UML_FDRSQRT(block, dst, src1)                       do { block->append().fdrsqrt(dst, src1); } while (0)
 
+/* ----- 128-bit Vector Operations ----- */
+#define UML_VMOV(block, dst, src1)                          do { block->append().vmov(dst, src1); } while (0)
+#define UML_VSHUF(block, dst, src1, sel)                    do { block->append().vshuf(dst, src1, sel); } while (0)
+#define UML_VADDW(block, dst, src1, src2)                   do { block->append().vaddw(dst, src1, src2); } while (0)
+#define UML_VADDSW(block, dst, src1, src2)                  do { block->append().vaddsw(dst, src1, src2); } while (0)
+#define UML_VSUBW(block, dst, src1, src2)                   do { block->append().vsubw(dst, src1, src2); } while (0)
+#define UML_VSUBSW(block, dst, src1, src2)                  do { block->append().vsubsw(dst, src1, src2); } while (0)
+#define UML_VMINSW(block, dst, src1, src2)                  do { block->append().vminsw(dst, src1, src2); } while (0)
+#define UML_VMAXSW(block, dst, src1, src2)                  do { block->append().vmaxsw(dst, src1, src2); } while (0)
+#define UML_VCMPGTW(block, dst, src1, src2)                 do { block->append().vcmpgtw(dst, src1, src2); } while (0)
+#define UML_VAND(block, dst, src1, src2)                    do { block->append().vand(dst, src1, src2); } while (0)
+#define UML_VOR(block, dst, src1, src2)                     do { block->append().vor(dst, src1, src2); } while (0)
+#define UML_VXOR(block, dst, src1, src2)                    do { block->append().vxor(dst, src1, src2); } while (0)
+#define UML_VMULLW(block, dst, src1, src2)                  do { block->append().vmullw(dst, src1, src2); } while (0)
+#define UML_VMULHW(block, dst, src1, src2)                  do { block->append().vmulhw(dst, src1, src2); } while (0)
+#define UML_VSATW(block, dst, lo, hi)                       do { block->append().vsatw(dst, lo, hi); } while (0)
+
 
 #endif /* __DRCUMLSH_H__ */
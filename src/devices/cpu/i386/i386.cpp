@@ -21,12 +21,29 @@
 #include "debugger.h"
 #include "i386priv.h"
 #include "i386.h"
+#include "i386fe.h"
 
 #include "debug/debugcpu.h"
 
 /* seems to be defined on mingw-gcc */
 #undef i386
 
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                  (32 * 1024 * 1024)
+
+/* version of the persisted block list */
+#define DRC_PERSIST_VERSION         1
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES     128
+#define COMPILE_FORWARDS_BYTES      512
+#define COMPILE_MAX_SEQUENCE        64
+
 const device_type I386 = &device_creator<i386_device>;
 const device_type I386SX = &device_creator<i386SX_device>;
 const device_type I486 = &device_creator<i486_device>;
@@ -44,9 +61,21 @@ i386_device::i386_device(const machine_config &mconfig, const char *tag, device_
 	, m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, 32, 16, 0)
 	, m_smiact(*this)
+	, m_cache(CACHE_SIZE + sizeof(internal_i386_state))
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_fault(nullptr)
+	, m_tlb_mismatch(nullptr)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
+
+	memset(m_read, 0, sizeof(m_read));
+	memset(m_write, 0, sizeof(m_write));
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_i386() && !mconfig.m_force_no_drc) ? true : false;
 }
 
 
@@ -55,9 +84,21 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
 	, m_smiact(*this)
+	, m_cache(CACHE_SIZE + sizeof(internal_i386_state))
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_fault(nullptr)
+	, m_tlb_mismatch(nullptr)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
+
+	memset(m_read, 0, sizeof(m_read));
+	memset(m_write, 0, sizeof(m_write));
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_i386() && !mconfig.m_force_no_drc) ? true : false;
 }
 
 i386SX_device::i386SX_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
@@ -3289,7 +3330,47 @@ void i386_device::i386_common_init(int tlbsize)
 
 	m_smiact.resolve_safe();
 
-	m_icountptr = &m_cycles;
+	/* allocate the state that compiled code accesses directly */
+	m_i386_state = (internal_i386_state *)m_cache.alloc_near(sizeof(internal_i386_state));
+	memset(m_i386_state, 0, sizeof(internal_i386_state));
+
+	/* initialize the UML generator; one mode for each combination of paging and user privilege,
+	   and no ignored address bits since instructions can start at any byte */
+	UINT32 flags = 0;
+	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 4, 32, 0);
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_i386_state->eip, sizeof(m_i386_state->eip), "eip");
+	m_drcuml->symbol_add(&m_i386_state->icount, sizeof(m_i386_state->icount), "icount");
+	for (int regnum = 0; regnum < 8; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		m_drcuml->symbol_add(&m_i386_state->r[regnum], sizeof(m_i386_state->r[regnum]), buf);
+	}
+	m_drcuml->symbol_add(&m_i386_state->cf, sizeof(m_i386_state->cf), "cf");
+	m_drcuml->symbol_add(&m_i386_state->zf, sizeof(m_i386_state->zf), "zf");
+	m_drcuml->symbol_add(&m_i386_state->sf, sizeof(m_i386_state->sf), "sf");
+	m_drcuml->symbol_add(&m_i386_state->of, sizeof(m_i386_state->of), "of");
+
+	/* initialize the front-end helper */
+	m_drcfe = std::make_unique<i386_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	/* initialize the persisted block list */
+	m_drcpersist = std::make_unique<drc_persistent_cache>(*this, *m_drcuml, *m_drcfe, DRC_PERSIST_VERSION, drc_persistent_cache::compile_delegate(FUNC(i386_device::code_compile_block), this));
+
+	/* compute the register parameters; EAX goes in a host register if there is one to spare */
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_regmap[regnum] = uml::mem(&m_i386_state->r[regnum]);
+	drcbe_info beinfo;
+	m_drcuml->get_backend_info(beinfo);
+	if (beinfo.direct_iregs > 4)
+		m_regmap[0] = uml::I4;
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
+
+	m_icountptr = m_isdrc ? &m_i386_state->icount : &m_cycles;
 }
 
 void i386_device::device_start()
@@ -3618,6 +3699,7 @@ void i386_device::build_opcode_table(UINT32 features)
 
 void i386_device::zero_state()
 {
+	m_cache_dirty = TRUE;
 	memset( &m_reg, 0, sizeof(m_reg) );
 	memset( m_sreg, 0, sizeof(m_sreg) );
 	m_eip = 0;
@@ -3695,6 +3777,12 @@ void i386_device::zero_state()
 	m_opcode_bytes_length = 0;
 }
 
+void i386_device::device_stop()
+{
+	if (m_drcpersist != nullptr)
+		m_drcpersist->save();
+}
+
 void i386_device::device_reset()
 {
 	zero_state();
@@ -3891,10 +3979,64 @@ void i386_device::i386_set_a20_line(int state)
 	}
 	// TODO: how does A20M and the tlb interact
 	vtlb_flush_dynamic(m_vtlb);
+
+	// compiled memory accessors have the mask built in
+	m_cache_dirty = TRUE;
+}
+
+void i386_device::i386_execute_one()
+{
+	i386_check_irq_line();
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
+
+	m_ext = 1;
+	int old_tf = m_TF;
+
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
+
+	debugger_instruction_hook(this, m_pc);
+
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
+#ifdef DEBUG_MISSING_OPCODE
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
+#endif
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
+		{
+			m_prev_eip = m_eip;
+			m_ext = 1;
+			i386_trap(1,0,0);
+		}
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
+	}
+	catch(UINT64 e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+	}
 }
 
 void i386_device::execute_run()
 {
+	if (m_isdrc)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	int cycles = m_cycles;
 	m_base_cycles = cycles;
 	CHANGE_PC(m_eip);
@@ -3907,49 +4049,7 @@ void i386_device::execute_run()
 	}
 
 	while( m_cycles > 0 )
-	{
-		i386_check_irq_line();
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
-
-		m_ext = 1;
-		int old_tf = m_TF;
-
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
-
-		debugger_instruction_hook(this, m_pc);
-
-		if(m_delayed_interrupt_enable != 0)
-		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
-#ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
-#endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(UINT64 e)
-		{
-			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
-		}
-	}
+		i386_execute_one();
 	m_tsc += (cycles - m_cycles);
 }
 
@@ -4520,3 +4620,5 @@ void pentium4_device::device_reset()
 
 	CHANGE_PC(m_eip);
 }
+
+#include "i386drc.cpp"
@@ -9,6 +9,9 @@
 #include "softfloat/softfloat.h"
 #include "debug/debugcpu.h"
 #include "cpu/vtlb.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
+#include "cpu/drcuml.h"
 
 
 #define INPUT_LINE_A20      1
@@ -22,10 +25,22 @@
 #define MCFG_I386_SMIACT(_devcb) \
 	i386_device::set_smiact(*device, DEVCB_##_devcb);
 
+#define MCFG_I386_FORCE_INTERPRETER() \
+	i386_device::set_force_interpreter(*device);
+
+/* use the recompiler whenever -drc is on, without needing -drc_i386 */
+#define MCFG_I386_ALLOW_RECOMPILER() \
+	i386_device::set_allow_recompiler(*device);
+
 #define X86_NUM_CPUS        4
 
+class i386_frontend;
+struct i386_insn;
+
 class i386_device : public cpu_device
 {
+	friend class i386_frontend;
+
 public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -33,6 +48,8 @@ public:
 
 	// static configuration helpers
 	template<class _Object> static devcb_base &set_smiact(device_t &device, _Object object) { return downcast<i386_device &>(device).m_smiact.set_callback(object); }
+	static void set_force_interpreter(device_t &device) { downcast<i386_device &>(device).m_isdrc = false; }
+	static void set_allow_recompiler(device_t &device) { downcast<i386_device &>(device).m_isdrc = (device.mconfig().options().drc() && !device.mconfig().m_force_no_drc) ? true : false; }
 
 	UINT64 debug_segbase(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_seglimit(symbol_table &table, int params, const UINT64 *param);
@@ -43,6 +60,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 	virtual void device_debug_setup() override;
 
 	// device_execute_interface overrides
@@ -288,6 +306,56 @@ struct I386_CALL_GATE
 
 	UINT64 m_debugger_temp;
 
+	// Data that needs to be stored close to the generated DRC code
+	struct internal_i386_state
+	{
+		UINT32  r[8];               // general registers
+		UINT32  eip;                // instruction pointer
+		UINT32  cf;                 // carry flag
+		UINT32  zf;                 // zero flag
+		UINT32  sf;                 // sign flag
+		UINT32  of;                 // overflow flag
+		UINT32  pfres;              // low byte of the last result, for PF
+		UINT32  af;                 // AF in bit 4
+		UINT32  mode;               // block mode being executed
+		UINT32  irqcheck;           // nonzero to leave compiled code after an interpreted instruction
+		UINT32  arg0;               // parameters to C helpers
+		UINT32  arg1;
+		UINT32  fault;              // set by a C helper if its access faulted
+		int     icount;
+	};
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           mode;                       /* block mode */
+		UINT8           flagsvalid;                 /* x86 flags held in the host flags after this instruction */
+		UINT8           lastflags;                  /* x86 flags held in the host flags before this instruction */
+		uml::code_label labelnum;                   /* index for local labels */
+	};
+
+	bool m_isdrc;
+
+	drc_cache           m_cache;                  /* pointer to the DRC code cache */
+	std::unique_ptr<drcuml_state>      m_drcuml;                 /* DRC UML generator state */
+	std::unique_ptr<i386_frontend>     m_drcfe;                  /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_persistent_cache> m_drcpersist;          /* persisted list of compiled blocks */
+	internal_i386_state *m_i386_state;
+	UINT8               m_cache_dirty;                /* true if we need to flush the cache */
+
+	/* register mappings */
+	uml::parameter      m_regmap[8];                  /* parameter to register mappings for all 8 integer registers */
+
+	/* subroutines */
+	uml::code_handle *  m_entry;                      /* entry point */
+	uml::code_handle *  m_nocode;                     /* nocode */
+	uml::code_handle *  m_out_of_cycles;              /* out of cycles exception handler */
+	uml::code_handle *  m_fault;                      /* memory fault handler */
+	uml::code_handle *  m_tlb_mismatch;               /* code page remapped handler */
+	uml::code_handle *  m_read[4][3];                 /* read byte/word/dword, per mode */
+	uml::code_handle *  m_write[4][3];                /* write byte/word/dword, per mode */
+
 	void register_state_i386();
 	void register_state_i386_x87();
 	void register_state_i386_x87_xmm();
@@ -1416,7 +1484,58 @@ struct I386_CALL_GATE
 	void pentium_smi();
 	void zero_state();
 	void i386_set_a20_line(int state);
+	void i386_execute_one();
+
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	inline void load_fast_iregs(drcuml_block *block);
+	inline void save_fast_iregs(drcuml_block *block);
+
+	UINT8 drc_mode() const;
+	bool drc_flat_segment(int segment) const;
+	bool drc_can_run() const;
+	bool drc_translate_fetch(offs_t &address);
+	void drc_state_load();
+	void drc_state_store();
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_fault_handler();
+	void static_generate_tlb_mismatch();
+	void static_generate_memory_accessor(int mode, int size, int iswrite, const char *name, uml::code_handle **handleptr);
+	void log_add_disasm_comment(drcuml_block *block, UINT32 pc, const UINT8 *oprom);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_validate_tlb(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_ea(drcuml_block *block, const i386_insn &insn);
+	void generate_load_reg(drcuml_block *block, int regnum, int size, uml::parameter dst);
+	void generate_store_reg(drcuml_block *block, compiler_state *compiler, int regnum, int size, uml::parameter src);
+	void generate_load_rm(drcuml_block *block, compiler_state *compiler, const i386_insn &insn, int size, uml::parameter dst);
+	void generate_store_rm(drcuml_block *block, compiler_state *compiler, const i386_insn &insn, int size, uml::parameter src);
+	void generate_push(drcuml_block *block, compiler_state *compiler, uml::parameter value);
+	void generate_pop(drcuml_block *block, compiler_state *compiler, UINT32 extra);
+	void generate_alu(drcuml_block *block, compiler_state *compiler, int aluop, int size, bool memdest, UINT32 req);
+	void generate_shift(drcuml_block *block, compiler_state *compiler, const i386_insn &insn, UINT32 count, UINT32 req);
+	void generate_imul(drcuml_block *block, compiler_state *compiler, int regnum, UINT32 req);
+	uml::condition_t generate_condition(drcuml_block *block, compiler_state *compiler, int cond);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int extracycles);
+	void generate_conditional_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::condition_t cond, int extracycles);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	int generate_twobyte(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, const i386_insn &insn);
 
+public:
+	void func_interpret();
+	void func_read8();
+	void func_read16();
+	void func_read32();
+	void func_write8();
+	void func_write16();
+	void func_write32();
+	void func_tlb_fill();
 };
 
 
@@ -1526,6 +1645,27 @@ protected:
 };
 
 
+class i386_frontend : public drc_frontend
+{
+public:
+	i386_frontend(i386_device *i386, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	bool describe_interpreted(opcode_desc &desc);
+	int describe_modrm(opcode_desc &desc, const i386_insn &insn, int size, bool read, bool write, int regcycles, int memcycles);
+	void describe_reg(opcode_desc &desc, int regnum, int size, bool read, bool write);
+	void describe_stack(opcode_desc &desc, bool write);
+	void describe_condition(opcode_desc &desc, int cond);
+	bool describe_onebyte(opcode_desc &desc, const i386_insn &insn);
+	bool describe_twobyte(opcode_desc &desc, const i386_insn &insn);
+
+	i386_device *m_i386;
+};
+
+
 extern const device_type I386;
 extern const device_type I386SX;
 extern const device_type I486;
@@ -0,0 +1,1834 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Philip Bennett
+/***************************************************************************
+
+    i386drc.cpp
+    Universal machine language-based i386 emulator.
+
+    Only 32-bit protected mode code running with flat code, data and
+    stack segments is compiled.  Anything else -- real and virtual 8086
+    mode, 16-bit code, segment arithmetic, string and system instructions,
+    the FPU and the SIMD extensions -- is handed to the interpreter one
+    instruction at a time, so it keeps exactly its existing behavior.
+
+    Flags are kept as separate words in the near state, as the
+    interpreter does.  PF and AF are evaluated lazily: pfres holds the
+    low byte of the last result, and af holds the XOR of the operands
+    and result, from which AF is bit 4.
+
+    A compiled instruction never commits any state before its last
+    memory access, so a fault can be handled by throwing away the
+    instruction and running it again in the interpreter, which then
+    raises the exception exactly as it always has.
+
+***************************************************************************/
+
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* map variables */
+#define MAPVAR_PC                   M0
+#define MAPVAR_CYCLES               M1
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES       0
+#define EXECUTE_MISSING_CODE        1
+#define EXECUTE_UNMAPPED_CODE       2
+#define EXECUTE_RESET_CACHE         3
+#define EXECUTE_INTERPRET           4
+
+/* block modes */
+#define MODE_PAGING                 1
+#define MODE_USER                   2
+
+/* ALU operations, numbered as in the opcode map */
+#define ALU_ADD                     0
+#define ALU_OR                      1
+#define ALU_ADC                     2
+#define ALU_SBB                     3
+#define ALU_AND                     4
+#define ALU_SUB                     5
+#define ALU_XOR                     6
+#define ALU_CMP                     7
+#define ALU_TEST                    8
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)        m_regmap[reg]
+
+#define SIZE_INDEX(size)    (((size) == 1) ? 0 : ((size) == 2) ? 1 : 2)
+#define SIZE_MASK(size)     (((size) == 1) ? 0xff : ((size) == 2) ? 0xffff : 0xffffffff)
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void i386_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == nullptr)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    load_fast_iregs - load any fast integer
+    registers
+-------------------------------------------------*/
+
+void i386_device::load_fast_iregs(drcuml_block *block)
+{
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+		if (m_regmap[regnum].is_int_register())
+			UML_MOV(block, uml::parameter::make_ireg(m_regmap[regnum].ireg()), mem(&m_i386_state->r[regnum]));
+}
+
+
+/*-------------------------------------------------
+    save_fast_iregs - save any fast integer
+    registers
+-------------------------------------------------*/
+
+void i386_device::save_fast_iregs(drcuml_block *block)
+{
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+		if (m_regmap[regnum].is_int_register())
+			UML_MOV(block, mem(&m_i386_state->r[regnum]), uml::parameter::make_ireg(m_regmap[regnum].ireg()));
+}
+
+
+/*-------------------------------------------------
+    drc_mode - return the block mode for the
+    current paging and privilege state
+-------------------------------------------------*/
+
+UINT8 i386_device::drc_mode() const
+{
+	return ((m_cr[0] & 0x80000000) ? MODE_PAGING : 0) | ((m_CPL == 3) ? MODE_USER : 0);
+}
+
+
+/*-------------------------------------------------
+    drc_flat_segment - return true if a segment
+    covers the whole linear address space
+-------------------------------------------------*/
+
+bool i386_device::drc_flat_segment(int segment) const
+{
+	/* expand-down data segments invert the limit check */
+	const I386_SREG &seg = m_sreg[segment];
+	return seg.valid && seg.base == 0 && seg.limit == 0xffffffff && !((seg.flags & 0x18) == 0x10 && (seg.flags & 0x04));
+}
+
+
+/*-------------------------------------------------
+    drc_can_run - return true if the current
+    state can be run by compiled code
+-------------------------------------------------*/
+
+bool i386_device::drc_can_run() const
+{
+	/* protected mode, no single-stepping or pending prefix state */
+	if (!PROTECTED_MODE || V8086_MODE || m_TF || m_lock || m_delayed_interrupt_enable || m_halted)
+		return false;
+
+	/* interrupts are only taken by the interpreter */
+	if ((m_irq_state && m_IF) || (m_smi && !m_smm))
+		return false;
+
+	/* 32-bit code and stack, flat CS, DS, ES and SS; DS, ES and SS must be writable data */
+	if (!m_sreg[CS].d || !m_sreg[SS].d)
+		return false;
+	if (!drc_flat_segment(CS) || !drc_flat_segment(DS) || !drc_flat_segment(ES) || !drc_flat_segment(SS))
+		return false;
+	if ((m_sreg[DS].flags & 0x0a) != 0x02 || (m_sreg[ES].flags & 0x0a) != 0x02 || (m_sreg[SS].flags & 0x0a) != 0x02)
+		return false;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    drc_translate_fetch - translate a linear
+    code address to a physical one for the
+    front-end; only pages already in the TLB are
+    used, so that compiling never touches the
+    accessed bits of pages that are not executed
+-------------------------------------------------*/
+
+bool i386_device::drc_translate_fetch(offs_t &address)
+{
+	if (m_cr[0] & 0x80000000)
+	{
+		vtlb_entry entry = vtlb_table(m_vtlb)[address >> 12];
+		if (!(entry & VTLB_FLAG_VALID) || !(entry & ((m_CPL == 3) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED)))
+			return false;
+		address = (entry & 0xfffff000) | (address & 0xfff);
+	}
+	address &= m_a20_mask;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    drc_state_load - copy the interpreter state
+    into the near state used by compiled code
+-------------------------------------------------*/
+
+void i386_device::drc_state_load()
+{
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_i386_state->r[regnum] = m_reg.d[regnum];
+	m_i386_state->eip = m_eip;
+	m_i386_state->cf = m_CF;
+	m_i386_state->zf = m_ZF;
+	m_i386_state->sf = m_SF;
+	m_i386_state->of = m_OF;
+	m_i386_state->pfres = m_PF ? 0 : 1;
+	m_i386_state->af = m_AF ? 0x10 : 0;
+}
+
+
+/*-------------------------------------------------
+    drc_state_store - copy the near state back
+    to the interpreter
+-------------------------------------------------*/
+
+void i386_device::drc_state_store()
+{
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_reg.d[regnum] = m_i386_state->r[regnum];
+	m_eip = m_i386_state->eip;
+	m_CF = m_i386_state->cf;
+	m_ZF = m_i386_state->zf;
+	m_SF = m_i386_state->sf;
+	m_OF = m_i386_state->of;
+	m_PF = i386_parity_table[m_i386_state->pfres & 0xff];
+	m_AF = (m_i386_state->af >> 4) & 1;
+	CHANGE_PC(m_eip);
+}
+
+
+/*-------------------------------------------------
+    cfunc_interpret - run a single instruction
+    in the interpreter
+-------------------------------------------------*/
+
+static void cfunc_interpret(void *param)
+{
+	((i386_device *)param)->func_interpret();
+}
+
+void i386_device::func_interpret()
+{
+	drc_state_store();
+	int cycles = m_cycles = m_i386_state->icount;
+	i386_execute_one();
+	m_i386_state->icount -= cycles - m_cycles;
+	drc_state_load();
+
+	/* leave compiled code if we ran out of cycles or the instruction changed anything it depends on */
+	m_i386_state->irqcheck = (m_i386_state->icount <= 0 || !drc_can_run() || drc_mode() != m_i386_state->mode || m_cache_dirty) ? 1 : 0;
+}
+
+
+/*-------------------------------------------------
+    cfunc_readN/writeN - slow paths for memory
+    accesses that miss the TLB or are misaligned
+-------------------------------------------------*/
+
+static void cfunc_read8(void *param)    { ((i386_device *)param)->func_read8(); }
+static void cfunc_read16(void *param)   { ((i386_device *)param)->func_read16(); }
+static void cfunc_read32(void *param)   { ((i386_device *)param)->func_read32(); }
+static void cfunc_write8(void *param)   { ((i386_device *)param)->func_write8(); }
+static void cfunc_write16(void *param)  { ((i386_device *)param)->func_write16(); }
+static void cfunc_write32(void *param)  { ((i386_device *)param)->func_write32(); }
+
+void i386_device::func_read8()
+{
+	try { m_i386_state->arg0 = READ8(m_i386_state->arg0); }
+	catch (UINT64) { m_i386_state->fault = 1; }
+}
+
+void i386_device::func_read16()
+{
+	try { m_i386_state->arg0 = READ16(m_i386_state->arg0); }
+	catch (UINT64) { m_i386_state->fault = 1; }
+}
+
+void i386_device::func_read32()
+{
+	try { m_i386_state->arg0 = READ32(m_i386_state->arg0); }
+	catch (UINT64) { m_i386_state->fault = 1; }
+}
+
+void i386_device::func_write8()
+{
+	try { WRITE8(m_i386_state->arg0, m_i386_state->arg1); }
+	catch (UINT64) { m_i386_state->fault = 1; }
+}
+
+void i386_device::func_write16()
+{
+	try { WRITE16(m_i386_state->arg0, m_i386_state->arg1); }
+	catch (UINT64) { m_i386_state->fault = 1; }
+}
+
+void i386_device::func_write32()
+{
+	try { WRITE32(m_i386_state->arg0, m_i386_state->arg1); }
+	catch (UINT64) { m_i386_state->fault = 1; }
+}
+
+
+/*-------------------------------------------------
+    cfunc_tlb_fill - reload the TLB entry for a
+    code page
+-------------------------------------------------*/
+
+static void cfunc_tlb_fill(void *param)
+{
+	((i386_device *)param)->func_tlb_fill();
+}
+
+void i386_device::func_tlb_fill()
+{
+	UINT32 address = m_i386_state->arg0, error;
+	translate_address(m_CPL, TRANSLATE_FETCH, &address, &error);
+}
+
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void i386_device::code_flush_cache()
+{
+	static const char *const s_read_names[4][3] =
+	{
+		{ "read8",    "read16",    "read32" },
+		{ "read8p",   "read16p",   "read32p" },
+		{ "read8u",   "read16u",   "read32u" },
+		{ "read8pu",  "read16pu",  "read32pu" }
+	};
+	static const char *const s_write_names[4][3] =
+	{
+		{ "write8",   "write16",   "write32" },
+		{ "write8p",  "write16p",  "write32p" },
+		{ "write8u",  "write16u",  "write32u" },
+		{ "write8pu", "write16pu", "write32pu" }
+	};
+
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and exception handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_fault_handler();
+		static_generate_tlb_mismatch();
+		static_generate_entry_point();
+
+		/* add subroutines for memory accesses in each mode */
+		for (int mode = 0; mode < 4; mode++)
+			for (int sizeindex = 0; sizeindex < 3; sizeindex++)
+			{
+				static_generate_memory_accessor(mode, 1 << sizeindex, FALSE, s_read_names[mode][sizeindex], &m_read[mode][sizeindex]);
+				static_generate_memory_accessor(mode, 1 << sizeindex, TRUE, s_write_names[mode][sizeindex], &m_write[mode][sizeindex]);
+			}
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate i386 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - execute cycles using
+    compiled code, falling back to the
+    interpreter whenever the state can't be
+    compiled
+-------------------------------------------------*/
+
+void i386_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	int cycles = m_i386_state->icount;
+	m_base_cycles = cycles;
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+
+	/* execute */
+	drc_state_load();
+	while (m_i386_state->icount > 0)
+	{
+		if (m_halted)
+		{
+			m_i386_state->icount = 0;
+			break;
+		}
+
+		/* the debugger, interrupts and anything outside the compiled subset go through the interpreter */
+		if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0 || !drc_can_run())
+			func_interpret();
+		else
+		{
+			/* run as much as we can */
+			m_i386_state->mode = drc_mode();
+			m_i386_state->irqcheck = 0;
+			int execute_result = drcuml->execute(*m_entry);
+
+			/* if we need to recompile, do it */
+			if (execute_result == EXECUTE_MISSING_CODE)
+			{
+				code_compile_block(m_i386_state->mode, m_i386_state->eip);
+				m_drcpersist->block_missing(m_i386_state->mode);
+			}
+			else if (execute_result == EXECUTE_INTERPRET)
+				func_interpret();
+			else if (execute_result == EXECUTE_RESET_CACHE)
+				code_flush_cache();
+		}
+
+		/* reset the cache if something invalidated it */
+		if (m_cache_dirty)
+			code_flush_cache();
+	}
+	drc_state_store();
+	m_tsc += cycles - m_i386_state->icount;
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void i386_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	compiler_state compiler = { 0 };
+	compiler.mode = mode;
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* make sure the page we are about to run from is in the TLB; a fault is left for the interpreter */
+	if ((mode & MODE_PAGING) && pc == m_i386_state->eip)
+	{
+		UINT32 address = pc, error;
+		translate_address(m_CPL, TRANSLATE_FETCH, &address, &error);
+	}
+
+	/* get a description of this sequence */
+	desclist = m_drcfe->describe_code(pc);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			block = drcuml->begin_block(8192);
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP) && m_program->get_write_ptr(seqhead->physpc) != nullptr)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* the validation code leaves nothing useful in the flags */
+				compiler.flagsvalid = 0;
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                    // <subtract cycles>
+
+				/* if the next instruction isn't the start of the next sequence, jump there */
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* note where the code came from so that it can be invalidated */
+			for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+				block->add_source(curdesc->physpc, curdesc->length);
+
+			/* end the sequence */
+			block->end();
+			m_drcpersist->record(mode, desclist);
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void i386_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* load fast integer registers */
+	load_fast_iregs(block);
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, mem(&m_i386_state->mode), mem(&m_i386_state->eip), *m_nocode);
+																					// hashjmp <mode>,<eip>,nocode
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void i386_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_i386_state->eip), I0);                                    // mov     [eip],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void i386_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_i386_state->eip), I0);                                    // mov     [eip],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_fault_handler - generate a
+    handler for memory accesses that fault; the
+    instruction is abandoned and rerun by the
+    interpreter, which raises the exception
+-------------------------------------------------*/
+
+void i386_device::static_generate_fault_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	alloc_handle(drcuml, &m_fault, "fault");
+	UML_HANDLE(block, *m_fault);                                                    // handle  fault
+	UML_MOV(block, mem(&m_i386_state->fault), 0);                                   // mov     [fault],0
+	UML_RECOVER(block, I0, MAPVAR_PC);                                              // recover i0,PC
+	UML_MOV(block, mem(&m_i386_state->eip), I0);                                    // mov     [eip],i0
+	UML_RECOVER(block, I1, MAPVAR_CYCLES);                                          // recover i1,CYCLES
+	UML_SUB(block, mem(&m_i386_state->icount), mem(&m_i386_state->icount), I1);    // sub     icount,icount,i1
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_INTERPRET);                                             // exit    EXECUTE_INTERPRET
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_tlb_mismatch - generate a
+    handler for code pages whose mapping no
+    longer matches the one they were compiled
+    with
+-------------------------------------------------*/
+
+void i386_device::static_generate_tlb_mismatch()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	alloc_handle(drcuml, &m_tlb_mismatch, "tlb_mismatch");
+	UML_HANDLE(block, *m_tlb_mismatch);                                             // handle  tlb_mismatch
+	UML_RECOVER(block, I0, MAPVAR_PC);                                              // recover i0,PC
+	UML_MOV(block, mem(&m_i386_state->eip), I0);                                    // mov     [eip],i0
+	UML_RECOVER(block, I1, MAPVAR_CYCLES);                                          // recover i1,CYCLES
+	UML_SUB(block, mem(&m_i386_state->icount), mem(&m_i386_state->icount), I1);    // sub     icount,icount,i1
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor
+------------------------------------------------------------------*/
+
+void i386_device::static_generate_memory_accessor(int mode, int size, int iswrite, const char *name, code_handle **handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I0-I3 */
+	static void (*const s_slow_path[2][3])(void *) =
+	{
+		{ cfunc_read8, cfunc_read16, cfunc_read32 },
+		{ cfunc_write8, cfunc_write16, cfunc_write32 }
+	};
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+	int slow = 1;
+
+	/* begin generating */
+	block = drcuml->begin_block(1024);
+
+	/* add a global entry for this */
+	alloc_handle(drcuml, handleptr, name);
+	UML_HANDLE(block, **handleptr);                                                 // handle  *handleptr
+
+	/* misaligned accesses are split up by the interpreter's handlers */
+	if (size > 1)
+	{
+		UML_TEST(block, I0, size - 1);                                              // test    i0,size-1
+		UML_JMPc(block, COND_NZ, slow);                                             // jnz     slow
+	}
+
+	/* with paging on, look up the TLB and take the slow path if it misses or lacks permission */
+	if (mode & MODE_PAGING)
+	{
+		UINT32 mask = VTLB_FLAG_VALID;
+		if (iswrite)
+			mask |= VTLB_FLAG_DIRTY | ((mode & MODE_USER) ? VTLB_USER_WRITE_ALLOWED : VTLB_WRITE_ALLOWED);
+		else
+			mask |= (mode & MODE_USER) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED;
+
+		UML_SHR(block, I3, I0, 12);                                                 // shr     i3,i0,12
+		UML_LOAD(block, I3, (void *)vtlb_table(m_vtlb), I3, SIZE_DWORD, SCALE_x4);  // load    i3,[vtlb],i3,dword
+		UML_AND(block, I2, I3, mask);                                               // and     i2,i3,mask
+		UML_CMP(block, I2, mask);                                                   // cmp     i2,mask
+		UML_JMPc(block, COND_NE, slow);                                             // jne     slow
+		UML_ROLINS(block, I0, I3, 0, 0xfffff000);                                   // rolins  i0,i3,0,0xfffff000
+	}
+
+	/* the interpreter doesn't apply the A20 mask to aligned dword writes; match it */
+	if (!iswrite || size != 4)
+		UML_AND(block, I0, I0, m_a20_mask);                                         // and     i0,i0,a20_mask
+
+	if (!iswrite)
+		UML_READ(block, I0, I0, (size == 1) ? SIZE_BYTE : (size == 2) ? SIZE_WORD : SIZE_DWORD, SPACE_PROGRAM);
+																					// read    i0,i0,size,program
+	else
+		UML_WRITE(block, I0, I1, (size == 1) ? SIZE_BYTE : (size == 2) ? SIZE_WORD : SIZE_DWORD, SPACE_PROGRAM);
+																					// write   i0,i1,size,program
+	UML_RET(block);                                                                 // ret
+
+	/* slow path: let the interpreter's handlers do the work and catch any fault */
+	UML_LABEL(block, slow);                                                         // slow:
+	UML_MOV(block, mem(&m_i386_state->arg0), I0);                                   // mov     [arg0],i0
+	if (iswrite)
+		UML_MOV(block, mem(&m_i386_state->arg1), I1);                               // mov     [arg1],i1
+	UML_CALLC(block, s_slow_path[iswrite ? 1 : 0][SIZE_INDEX(size)], this);         // callc   slow_path
+	UML_CMP(block, mem(&m_i386_state->fault), 0);                                   // cmp     [fault],0
+	UML_EXHc(block, COND_NE, *m_fault, 0);                                          // exne    fault,0
+	if (!iswrite)
+		UML_MOV(block, I0, mem(&m_i386_state->arg0));                               // mov     i0,[arg0]
+	UML_RET(block);                                                                 // ret
+
+	block->end();
+}
+
+
+
+/***************************************************************************
+    CODE LOGGING HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an i386 instruction
+-------------------------------------------------*/
+
+void i386_device::log_add_disasm_comment(drcuml_block *block, UINT32 pc, const UINT8 *oprom)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[100];
+		i386_dasm_one(buffer, pc, oprom, 32);
+		block->append_comment("%08X: %s", pc, buffer);                              // comment
+	}
+}
+
+
+
+/***************************************************************************
+    CODEGEN HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void i386_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_SUB(block, mem(&m_i386_state->icount), mem(&m_i386_state->icount), compiler->cycles);
+																					// sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);                       // exh     out_of_cycles,param
+	}
+	compiler->cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void i386_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* the instructions in a sequence are contiguous; gather their bytes */
+	UINT8 bytes[16 * COMPILE_MAX_SEQUENCE];
+	UINT32 length = 0;
+	for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+		if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
+		{
+			memcpy(&bytes[length], curdesc->opptr.b, curdesc->length);
+			length += curdesc->length;
+		}
+
+	/* sum them up a page at a time, skipping anything not in RAM */
+	UINT32 sum = 0;
+	bool first = true;
+	for (UINT32 offs = 0; offs < length; )
+	{
+		offs_t physpc = seqhead->pc + offs;
+		UINT32 chunk = std::min<UINT32>(length - offs, 0x1000 - (physpc & 0xfff));
+		if (drc_translate_fetch(physpc) && m_program->get_write_ptr(physpc) != nullptr)
+			for (UINT32 pos = 0; pos < chunk; )
+			{
+				UINT32 size = (chunk - pos >= 4) ? 4 : (chunk - pos >= 2) ? 2 : 1;
+				void *base = m_direct->read_ptr(physpc + pos);
+				UML_LOAD(block, first ? I0 : I1, base, 0, (size == 4) ? SIZE_DWORD : (size == 2) ? SIZE_WORD : SIZE_BYTE, SCALE_x1);
+																					// load    i1,base,size
+				if (!first)
+					UML_ADD(block, I0, I0, I1);                                     // add     i0,i0,i1
+				for (UINT32 byte = 0; byte < size; byte++)
+					sum += bytes[offs + pos + byte] << (8 * byte);
+				first = false;
+				pos += size;
+			}
+		offs += chunk;
+	}
+
+	if (!first)
+	{
+		UML_CMP(block, I0, sum);                                                    // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_validate_tlb - generate code to
+    check that the pages an instruction is
+    fetched from are still mapped as they were
+    when it was compiled
+-------------------------------------------------*/
+
+void i386_device::generate_validate_tlb(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	const vtlb_entry *table = vtlb_table(m_vtlb);
+	UINT32 mask = 0xfffff000 | VTLB_FLAG_VALID | ((compiler->mode & MODE_USER) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED);
+	UINT32 firstpage = desc->pc >> 12;
+	UINT32 lastpage = (desc->pc + std::max<UINT32>(desc->length, 1) - 1) >> 12;
+
+	for (UINT32 page = firstpage; ; page = (page + 1) & 0xfffff)
+	{
+		code_label skip = compiler->labelnum++;
+		UINT32 expected = table[page] & mask;
+
+		/* a miss may just mean the entry was evicted; reload it before giving up */
+		UML_LOAD(block, I0, (void *)table, page, SIZE_DWORD, SCALE_x4);             // load    i0,[vtlb],page,dword
+		UML_AND(block, I0, I0, mask);                                               // and     i0,i0,mask
+		UML_CMP(block, I0, expected);                                               // cmp     i0,expected
+		UML_JMPc(block, COND_E, skip);                                              // je      skip
+		UML_MOV(block, mem(&m_i386_state->arg0), page << 12);                       // mov     [arg0],page << 12
+		UML_CALLC(block, cfunc_tlb_fill, this);                                     // callc   tlb_fill
+		UML_LOAD(block, I0, (void *)table, page, SIZE_DWORD, SCALE_x4);             // load    i0,[vtlb],page,dword
+		UML_AND(block, I0, I0, mask);                                               // and     i0,i0,mask
+		UML_CMP(block, I0, expected);                                               // cmp     i0,expected
+		UML_EXHc(block, COND_NE, *m_tlb_mismatch, desc->pc);                        // exne    tlb_mismatch,desc->pc
+		UML_LABEL(block, skip);                                                     // skip:
+
+		if (page == lastpage)
+			break;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate code to hand a
+    single instruction to the interpreter
+-------------------------------------------------*/
+
+void i386_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	code_label skip = compiler->labelnum++;
+
+	/* the interpreter counts its own cycles */
+	generate_update_cycles(block, compiler, desc->pc, FALSE);                      // <subtract cycles>
+	save_fast_iregs(block);
+	UML_MOV(block, mem(&m_i386_state->eip), desc->pc);                              // mov     [eip],desc->pc
+	UML_CALLC(block, cfunc_interpret, this);                                        // callc   interpret
+	load_fast_iregs(block);
+
+	/* leave if the state can no longer be run here */
+	UML_CMP(block, mem(&m_i386_state->irqcheck), 0);                                // cmp     [irqcheck],0
+	UML_EXHc(block, COND_NE, *m_out_of_cycles, mem(&m_i386_state->eip));           // exne    out_of_cycles,[eip]
+
+	/* continue here if it fell through, otherwise go wherever it went */
+	UML_CMP(block, mem(&m_i386_state->eip), desc->pc + desc->length);               // cmp     [eip],nextpc
+	UML_JMPc(block, COND_E, skip);                                                  // je      skip
+	UML_HASHJMP(block, compiler->mode, mem(&m_i386_state->eip), *m_nocode);         // hashjmp <mode>,[eip],nocode
+	UML_LABEL(block, skip);                                                         // skip:
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void i386_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.b);
+
+	/* set the PC map variable, and the cycles spent before this instruction for faults */
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                         // mapvar  PC,desc->pc
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* remember which flags the previous instruction left in the host flags */
+	compiler->lastflags = compiler->flagsvalid;
+	compiler->flagsvalid = 0;
+
+	/* validate our TLB entries at this PC; if we fail, we need to recompile */
+	if ((desc->flags & OPFLAG_VALIDATE_TLB) && (compiler->mode & MODE_PAGING) && !(desc->flags & OPFLAG_COMPILER_PAGE_FAULT))
+	{
+		generate_validate_tlb(block, compiler, desc);
+		compiler->lastflags = 0;
+	}
+
+	/* if this page couldn't be fetched, recompile once it can and let the interpreter raise any fault */
+	if (desc->flags & OPFLAG_COMPILER_PAGE_FAULT)
+	{
+		if (compiler->mode & MODE_PAGING)
+		{
+			UINT32 perm = VTLB_FLAG_VALID | ((compiler->mode & MODE_USER) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED);
+			UML_LOAD(block, I0, (void *)vtlb_table(m_vtlb), desc->pc >> 12, SIZE_DWORD, SCALE_x4);
+																					// load    i0,[vtlb],page,dword
+			UML_AND(block, I0, I0, perm);                                           // and     i0,i0,perm
+			UML_CMP(block, I0, perm);                                               // cmp     i0,perm
+			UML_EXHc(block, COND_E, *m_tlb_mismatch, desc->pc);                     // exe     tlb_mismatch,desc->pc
+		}
+		generate_interpret(block, compiler, desc);
+	}
+
+	/* instructions we don't compile go to the interpreter */
+	else if (desc->flags & I386OPFLAG_INTERPRET)
+		generate_interpret(block, compiler, desc);
+
+	/* otherwise, compile the instruction */
+	else
+	{
+		compiler->cycles += desc->cycles;
+		if (!generate_opcode(block, compiler, desc))
+			fatalerror("i386drc: unimplemented opcode at %08X\n", desc->pc);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_ea - generate code to compute the
+    effective address of a memory operand into I5
+-------------------------------------------------*/
+
+void i386_device::generate_ea(drcuml_block *block, const i386_insn &insn)
+{
+	if (insn.index >= 0)
+	{
+		if (insn.scale != 0)
+			UML_SHL(block, I5, R32(insn.index), insn.scale);                        // shl     i5,index,scale
+		else
+			UML_MOV(block, I5, R32(insn.index));                                    // mov     i5,index
+		if (insn.base >= 0)
+			UML_ADD(block, I5, I5, R32(insn.base));                                 // add     i5,i5,base
+		if (insn.disp != 0)
+			UML_ADD(block, I5, I5, insn.disp);                                      // add     i5,i5,disp
+	}
+	else if (insn.base >= 0)
+	{
+		if (insn.disp != 0)
+			UML_ADD(block, I5, R32(insn.base), insn.disp);                          // add     i5,base,disp
+		else
+			UML_MOV(block, I5, R32(insn.base));                                     // mov     i5,base
+	}
+	else
+		UML_MOV(block, I5, insn.disp);                                              // mov     i5,disp
+}
+
+
+/*-------------------------------------------------
+    generate_load_reg - load a general register
+    of the given size, zero-extended
+-------------------------------------------------*/
+
+void i386_device::generate_load_reg(drcuml_block *block, int regnum, int size, uml::parameter dst)
+{
+	if (size == 4)
+		UML_MOV(block, dst, R32(regnum));                                           // mov     dst,reg
+	else if (size == 2)
+		UML_AND(block, dst, R32(regnum), 0xffff);                                   // and     dst,reg,0xffff
+	else if (regnum < 4)
+		UML_AND(block, dst, R32(regnum), 0xff);                                     // and     dst,reg,0xff
+	else
+		UML_ROLAND(block, dst, R32(regnum & 3), 24, 0xff);                          // roland  dst,reg,24,0xff
+}
+
+
+/*-------------------------------------------------
+    generate_store_reg - store to a general
+    register of the given size
+-------------------------------------------------*/
+
+void i386_device::generate_store_reg(drcuml_block *block, compiler_state *compiler, int regnum, int size, uml::parameter src)
+{
+	if (size == 4)
+	{
+		UML_MOV(block, R32(regnum), src);                                           // mov     reg,src
+		return;
+	}
+
+	/* partial stores go through ROLINS, which changes the flags */
+	if (size == 2)
+		UML_ROLINS(block, R32(regnum), src, 0, 0xffff);                             // rolins  reg,src,0,0xffff
+	else if (regnum < 4)
+		UML_ROLINS(block, R32(regnum), src, 0, 0xff);                               // rolins  reg,src,0,0xff
+	else
+		UML_ROLINS(block, R32(regnum & 3), src, 8, 0xff00);                         // rolins  reg,src,8,0xff00
+	compiler->flagsvalid = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_load_rm - load the r/m operand of an
+    instruction; the address of a memory operand
+    must already be in I5
+-------------------------------------------------*/
+
+void i386_device::generate_load_rm(drcuml_block *block, compiler_state *compiler, const i386_insn &insn, int size, uml::parameter dst)
+{
+	if (insn.flags & I386INSN_MEMORY)
+	{
+		UML_MOV(block, I0, I5);                                                     // mov     i0,i5
+		UML_CALLH(block, *m_read[compiler->mode][SIZE_INDEX(size)]);                // callh   read
+		UML_MOV(block, dst, I0);                                                    // mov     dst,i0
+	}
+	else
+		generate_load_reg(block, insn.rm, size, dst);
+}
+
+
+/*-------------------------------------------------
+    generate_store_rm - store to the r/m operand
+    of an instruction; the address of a memory
+    operand must already be in I5
+-------------------------------------------------*/
+
+void i386_device::generate_store_rm(drcuml_block *block, compiler_state *compiler, const i386_insn &insn, int size, uml::parameter src)
+{
+	if (insn.flags & I386INSN_MEMORY)
+	{
+		UML_MOV(block, I0, I5);                                                     // mov     i0,i5
+		UML_MOV(block, I1, src);                                                    // mov     i1,src
+		UML_CALLH(block, *m_write[compiler->mode][SIZE_INDEX(size)]);               // callh   write
+	}
+	else
+		generate_store_reg(block, compiler, insn.rm, size, src);
+}
+
+
+/*-------------------------------------------------
+    generate_push - push a dword; ESP is only
+    updated once the write has succeeded
+-------------------------------------------------*/
+
+void i386_device::generate_push(drcuml_block *block, compiler_state *compiler, uml::parameter value)
+{
+	UML_SUB(block, I0, R32(4), 4);                                                  // sub     i0,esp,4
+	UML_MOV(block, I1, value);                                                      // mov     i1,value
+	UML_CALLH(block, *m_write[compiler->mode][2]);                                  // callh   write32
+	UML_SUB(block, R32(4), R32(4), 4);                                              // sub     esp,esp,4
+}
+
+
+/*-------------------------------------------------
+    generate_pop - pop a dword into I0
+-------------------------------------------------*/
+
+void i386_device::generate_pop(drcuml_block *block, compiler_state *compiler, UINT32 extra)
+{
+	UML_MOV(block, I0, R32(4));                                                     // mov     i0,esp
+	UML_CALLH(block, *m_read[compiler->mode][2]);                                   // callh   read32
+	UML_ADD(block, R32(4), R32(4), 4 + extra);                                      // add     esp,esp,4+extra
+}
+
+
+/*-------------------------------------------------
+    generate_alu - generate one of the basic ALU
+    operations on I6 and I7, leaving the result
+    in I8 and capturing the flags in req; for a
+    memory destination the result is written to
+    [I5] before any flag is committed
+-------------------------------------------------*/
+
+void i386_device::generate_alu(drcuml_block *block, compiler_state *compiler, int aluop, int size, bool memdest, UINT32 req)
+{
+	bool logic = (aluop == ALU_OR || aluop == ALU_AND || aluop == ALU_XOR || aluop == ALU_TEST);
+	bool carryin = (aluop == ALU_ADC || aluop == ALU_SBB);
+	int shift = 32 - 8 * size;
+
+	if (logic)
+		req &= ~REGFLAG_AF;
+	bool fast = (size == 4 && !memdest && !(req & REGFLAG_AF));
+
+	/* 32-bit register operations produce the result and the flags in one go */
+	if (fast)
+	{
+		if (carryin)
+			UML_CARRY(block, mem(&m_i386_state->cf), 0);                            // carry   [cf],0
+		switch (aluop)
+		{
+			case ALU_ADD:   UML_ADD(block, I8, I6, I7);     break;                  // add     i8,i6,i7
+			case ALU_OR:    UML_OR(block, I8, I6, I7);      break;                  // or      i8,i6,i7
+			case ALU_ADC:   UML_ADDC(block, I8, I6, I7);    break;                  // addc    i8,i6,i7
+			case ALU_SBB:   UML_SUBB(block, I8, I6, I7);    break;                  // subb    i8,i6,i7
+			case ALU_AND:   UML_AND(block, I8, I6, I7);     break;                  // and     i8,i6,i7
+			case ALU_SUB:   UML_SUB(block, I8, I6, I7);     break;                  // sub     i8,i6,i7
+			case ALU_XOR:   UML_XOR(block, I8, I6, I7);     break;                  // xor     i8,i6,i7
+			case ALU_CMP:
+				if (req & REGFLAG_PF)
+					UML_SUB(block, I8, I6, I7);                                     // sub     i8,i6,i7
+				else
+					UML_CMP(block, I6, I7);                                         // cmp     i6,i7
+				break;
+			case ALU_TEST:
+				if (req & REGFLAG_PF)
+					UML_AND(block, I8, I6, I7);                                     // and     i8,i6,i7
+				else
+					UML_TEST(block, I6, I7);                                        // test    i6,i7
+				break;
+		}
+	}
+
+	/* otherwise compute the result, store it, then redo the operation for the flags */
+	else
+	{
+		if (carryin)
+			UML_CARRY(block, mem(&m_i386_state->cf), 0);                            // carry   [cf],0
+		switch (aluop)
+		{
+			case ALU_ADD:   UML_ADD(block, I8, I6, I7);     break;                  // add     i8,i6,i7
+			case ALU_OR:    UML_OR(block, I8, I6, I7);      break;                  // or      i8,i6,i7
+			case ALU_ADC:   UML_ADDC(block, I8, I6, I7);    break;                  // addc    i8,i6,i7
+			case ALU_SBB:   UML_SUBB(block, I8, I6, I7);    break;                  // subb    i8,i6,i7
+			case ALU_AND:
+			case ALU_TEST:  UML_AND(block, I8, I6, I7);     break;                  // and     i8,i6,i7
+			case ALU_SUB:
+			case ALU_CMP:   UML_SUB(block, I8, I6, I7);     break;                  // sub     i8,i6,i7
+			case ALU_XOR:   UML_XOR(block, I8, I6, I7);     break;                  // xor     i8,i6,i7
+		}
+		if (size != 4 && !logic)
+			UML_AND(block, I8, I8, SIZE_MASK(size));                                // and     i8,i8,mask
+		if (req & REGFLAG_AF)
+		{
+			UML_XOR(block, I9, I6, I7);                                             // xor     i9,i6,i7
+			UML_XOR(block, mem(&m_i386_state->af), I9, I8);                         // xor     [af],i9,i8
+		}
+		if (memdest)
+		{
+			UML_MOV(block, I0, I5);                                                 // mov     i0,i5
+			UML_MOV(block, I1, I8);                                                 // mov     i1,i8
+			UML_CALLH(block, *m_write[compiler->mode][SIZE_INDEX(size)]);           // callh   write
+		}
+
+		/* narrow operations are done at the top of the register so the flags come out right */
+		if (req & (REGFLAG_CF | REGFLAG_ZF | REGFLAG_SF | REGFLAG_OF))
+		{
+			if (size != 4)
+			{
+				UML_SHL(block, I0, I6, shift);                                      // shl     i0,i6,shift
+				UML_SHL(block, I1, I7, shift);                                      // shl     i1,i7,shift
+			}
+			else
+			{
+				UML_MOV(block, I0, I6);                                             // mov     i0,i6
+				UML_MOV(block, I1, I7);                                             // mov     i1,i7
+			}
+			if (carryin)
+				UML_CARRY(block, mem(&m_i386_state->cf), 0);                        // carry   [cf],0
+			switch (aluop)
+			{
+				case ALU_ADD:   UML_ADD(block, I0, I0, I1);     break;              // add     i0,i0,i1
+				case ALU_OR:    UML_OR(block, I0, I0, I1);      break;              // or      i0,i0,i1
+				case ALU_ADC:   UML_ADDC(block, I0, I0, I1);    break;              // addc    i0,i0,i1
+				case ALU_SBB:   UML_SUBB(block, I0, I0, I1);    break;              // subb    i0,i0,i1
+				case ALU_AND:   UML_AND(block, I0, I0, I1);     break;              // and     i0,i0,i1
+				case ALU_TEST:  UML_TEST(block, I0, I1);        break;              // test    i0,i1
+				case ALU_SUB:   UML_SUB(block, I0, I0, I1);     break;              // sub     i0,i0,i1
+				case ALU_CMP:   UML_CMP(block, I0, I1);         break;              // cmp     i0,i1
+				case ALU_XOR:   UML_XOR(block, I0, I0, I1);     break;              // xor     i0,i0,i1
+			}
+		}
+	}
+
+	/* capture the flags; SET and MOV leave the host flags alone */
+	if (req & REGFLAG_CF)
+	{
+		if (logic)
+			UML_MOV(block, mem(&m_i386_state->cf), 0);                              // mov     [cf],0
+		else
+			UML_SETc(block, COND_C, mem(&m_i386_state->cf));                        // setc    [cf],C
+	}
+	if (req & REGFLAG_ZF)
+		UML_SETc(block, COND_Z, mem(&m_i386_state->zf));                            // setc    [zf],Z
+	if (req & REGFLAG_SF)
+		UML_SETc(block, COND_S, mem(&m_i386_state->sf));                            // setc    [sf],S
+	if (req & REGFLAG_OF)
+	{
+		if (logic)
+			UML_MOV(block, mem(&m_i386_state->of), 0);                              // mov     [of],0
+		else
+			UML_SETc(block, COND_V, mem(&m_i386_state->of));                        // setc    [of],V
+	}
+	if (req & REGFLAG_PF)
+		UML_MOV(block, mem(&m_i386_state->pfres), I8);                              // mov     [pfres],i8
+
+	/* the host flags now describe this operation, unless nothing recomputed them after the write */
+	if (!fast && !(req & (REGFLAG_CF | REGFLAG_ZF | REGFLAG_SF | REGFLAG_OF)))
+		compiler->flagsvalid = 0;
+	else if (logic)
+		compiler->flagsvalid = REGFLAG_ZF | REGFLAG_SF;
+	else
+		compiler->flagsvalid = REGFLAG_CF | REGFLAG_ZF | REGFLAG_SF | REGFLAG_OF;
+}
+
+
+/*-------------------------------------------------
+    generate_shift - generate SHL, SHR or SAR of
+    a dword by a constant
+-------------------------------------------------*/
+
+void i386_device::generate_shift(drcuml_block *block, compiler_state *compiler, const i386_insn &insn, UINT32 count, UINT32 req)
+{
+	int shiftop = insn.reg;
+
+	generate_load_rm(block, compiler, insn, 4, I6);
+
+	/* memory destinations are written before the flags are computed again */
+	for (int pass = (insn.flags & I386INSN_MEMORY) ? 0 : 1; pass < 2; pass++)
+	{
+		if (shiftop == 4)
+			UML_SHL(block, I8, I6, count);                                          // shl     i8,i6,count
+		else if (shiftop == 5)
+			UML_SHR(block, I8, I6, count);                                          // shr     i8,i6,count
+		else
+			UML_SAR(block, I8, I6, count);                                          // sar     i8,i6,count
+		if (pass == 0)
+			generate_store_rm(block, compiler, insn, 4, I8);
+	}
+
+	if (req & REGFLAG_CF)
+		UML_SETc(block, COND_C, mem(&m_i386_state->cf));                            // setc    [cf],C
+	if (req & REGFLAG_ZF)
+		UML_SETc(block, COND_Z, mem(&m_i386_state->zf));                            // setc    [zf],Z
+	if (req & REGFLAG_SF)
+		UML_SETc(block, COND_S, mem(&m_i386_state->sf));                            // setc    [sf],S
+	if (req & REGFLAG_PF)
+		UML_MOV(block, mem(&m_i386_state->pfres), I8);                              // mov     [pfres],i8
+	if (!(insn.flags & I386INSN_MEMORY))
+		UML_MOV(block, R32(insn.rm), I8);                                           // mov     rm,i8
+	compiler->flagsvalid = REGFLAG_CF | REGFLAG_ZF | REGFLAG_SF;
+
+	/* a single-bit shift also defines OF */
+	if (count == 1 && (req & REGFLAG_OF))
+	{
+		if (shiftop == 4)
+		{
+			UML_XOR(block, I0, I6, I8);                                             // xor     i0,i6,i8
+			UML_SHR(block, mem(&m_i386_state->of), I0, 31);                         // shr     [of],i0,31
+		}
+		else if (shiftop == 5)
+			UML_SHR(block, mem(&m_i386_state->of), I6, 31);                         // shr     [of],i6,31
+		else
+			UML_MOV(block, mem(&m_i386_state->of), 0);                              // mov     [of],0
+		if (shiftop != 7)
+			compiler->flagsvalid = 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_condition - generate code to test an
+    x86 condition code, returning the UML
+    condition that is true when it holds
+-------------------------------------------------*/
+
+uml::condition_t i386_device::generate_condition(drcuml_block *block, compiler_state *compiler, int cond)
+{
+	static const UINT8 s_needed[8] =
+	{
+		REGFLAG_OF, REGFLAG_CF, REGFLAG_ZF, REGFLAG_CF | REGFLAG_ZF,
+		REGFLAG_SF, 0, REGFLAG_SF | REGFLAG_OF, REGFLAG_ZF | REGFLAG_SF | REGFLAG_OF
+	};
+	static const uml::condition_t s_fused[8] =
+	{
+		COND_V, COND_C, COND_Z, COND_BE, COND_S, COND_ALWAYS, COND_L, COND_LE
+	};
+	int base = (cond >> 1) & 7;
+	uml::condition_t result;
+
+	/* if the previous instruction left these flags in the host flags, use them directly */
+	if (s_needed[base] != 0 && (compiler->lastflags & s_needed[base]) == s_needed[base])
+		result = s_fused[base];
+
+	/* otherwise test the saved flags */
+	else
+	{
+		switch (base)
+		{
+			case 0:
+				UML_CMP(block, mem(&m_i386_state->of), 0);                          // cmp     [of],0
+				result = COND_NZ;
+				break;
+
+			case 1:
+				UML_CMP(block, mem(&m_i386_state->cf), 0);                          // cmp     [cf],0
+				result = COND_NZ;
+				break;
+
+			case 2:
+				UML_CMP(block, mem(&m_i386_state->zf), 0);                          // cmp     [zf],0
+				result = COND_NZ;
+				break;
+
+			case 3:
+				UML_OR(block, I0, mem(&m_i386_state->cf), mem(&m_i386_state->zf));   // or      i0,[cf],[zf]
+				result = COND_NZ;
+				break;
+
+			case 4:
+				UML_CMP(block, mem(&m_i386_state->sf), 0);                          // cmp     [sf],0
+				result = COND_NZ;
+				break;
+
+			case 5:
+				UML_AND(block, I0, mem(&m_i386_state->pfres), 0xff);                // and     i0,[pfres],0xff
+				UML_LOAD(block, I0, i386_parity_table, I0, SIZE_DWORD, SCALE_x4);    // load    i0,parity,i0,dword
+				UML_CMP(block, I0, 0);                                              // cmp     i0,0
+				result = COND_NZ;
+				break;
+
+			case 6:
+				UML_CMP(block, mem(&m_i386_state->sf), mem(&m_i386_state->of));     // cmp     [sf],[of]
+				result = COND_NE;
+				break;
+
+			default:
+				UML_XOR(block, I0, mem(&m_i386_state->sf), mem(&m_i386_state->of));  // xor     i0,[sf],[of]
+				UML_OR(block, I0, I0, mem(&m_i386_state->zf));                      // or      i0,i0,[zf]
+				result = COND_NZ;
+				break;
+		}
+	}
+
+	/* odd condition codes are the inverse; UML conditions come in inverse pairs */
+	return (cond & 1) ? uml::condition_t(result ^ 1) : result;
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate code to count off
+    cycles and jump to the branch target of an
+    instruction, which may be dynamic (in I8)
+-------------------------------------------------*/
+
+void i386_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int extracycles)
+{
+	compiler_state compiler_temp = *compiler;
+
+	/* conditional branches count the extra cycles only on the taken path */
+	compiler_temp.cycles += extracycles;
+	if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+	{
+		generate_update_cycles(block, &compiler_temp, I8, TRUE);                   // <subtract cycles>
+		UML_HASHJMP(block, compiler->mode, I8, *m_nocode);                          // hashjmp <mode>,i8,nocode
+	}
+	else
+	{
+		generate_update_cycles(block, &compiler_temp, desc->targetpc, TRUE);       // <subtract cycles>
+		if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+			UML_JMP(block, desc->targetpc | 0x80000000);                            // jmp     desc->targetpc | 0x80000000
+		else
+			UML_HASHJMP(block, compiler->mode, desc->targetpc, *m_nocode);          // hashjmp <mode>,desc->targetpc,nocode
+	}
+
+	/* unconditional branches end the sequence, so their cycles are spent */
+	compiler->labelnum = compiler_temp.labelnum;
+	if (desc->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		compiler->cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_conditional_branch - generate code
+    for a branch taken when cond holds
+-------------------------------------------------*/
+
+void i386_device::generate_conditional_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::condition_t cond, int extracycles)
+{
+	code_label skip = compiler->labelnum++;
+
+	UML_JMPc(block, uml::condition_t(cond ^ 1), skip);                              // jmp     skip,!cond
+	generate_branch(block, compiler, desc, extracycles);
+	UML_LABEL(block, skip);                                                         // skip:
+}
+
+
+
+/***************************************************************************
+    OPCODE CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a
+    specific opcode
+-------------------------------------------------*/
+
+int i386_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	i386_insn insn;
+	if (!i386_decode_insn(desc->opptr.b, desc->length, insn))
+		return FALSE;
+	if (insn.flags & I386INSN_MEMORY)
+	{
+		/* the address arithmetic clobbers any flags left in the host flags */
+		generate_ea(block, insn);
+		compiler->lastflags = 0;
+	}
+	if (insn.flags & I386INSN_TWOBYTE)
+		return generate_twobyte(block, compiler, desc, insn);
+
+	UINT8 op = insn.opcode;
+	int opsize = (insn.flags & I386INSN_OPSIZE) ? 2 : 4;
+	int size = (op & 1) ? opsize : 1;
+	bool memory = (insn.flags & I386INSN_MEMORY) != 0;
+	UINT32 req = desc->regreq[1];
+
+	switch (op)
+	{
+		/* ALU ops between r/m and a register */
+		case 0x00: case 0x01: case 0x08: case 0x09: case 0x10: case 0x11: case 0x18: case 0x19:
+		case 0x20: case 0x21: case 0x28: case 0x29: case 0x30: case 0x31: case 0x38: case 0x39:
+		{
+			int aluop = (op >> 3) & 7;
+			generate_load_rm(block, compiler, insn, size, I6);
+			generate_load_reg(block, insn.reg, size, I7);
+			generate_alu(block, compiler, aluop, size, memory && aluop != ALU_CMP, req);
+			if (!memory && aluop != ALU_CMP)
+				generate_store_reg(block, compiler, insn.rm, size, I8);
+			return TRUE;
+		}
+
+		case 0x02: case 0x03: case 0x0a: case 0x0b: case 0x12: case 0x13: case 0x1a: case 0x1b:
+		case 0x22: case 0x23: case 0x2a: case 0x2b: case 0x32: case 0x33: case 0x3a: case 0x3b:
+		{
+			int aluop = (op >> 3) & 7;
+			generate_load_reg(block, insn.reg, size, I6);
+			generate_load_rm(block, compiler, insn, size, I7);
+			generate_alu(block, compiler, aluop, size, false, req);
+			if (aluop != ALU_CMP)
+				generate_store_reg(block, compiler, insn.reg, size, I8);
+			return TRUE;
+		}
+
+		/* ALU ops on the accumulator with an immediate */
+		case 0x04: case 0x05: case 0x0c: case 0x0d: case 0x14: case 0x15: case 0x1c: case 0x1d:
+		case 0x24: case 0x25: case 0x2c: case 0x2d: case 0x34: case 0x35: case 0x3c: case 0x3d:
+		{
+			int aluop = (op >> 3) & 7;
+			generate_load_reg(block, 0, size, I6);
+			UML_MOV(block, I7, insn.imm & SIZE_MASK(size));                         // mov     i7,imm
+			generate_alu(block, compiler, aluop, size, false, req);
+			if (aluop != ALU_CMP)
+				generate_store_reg(block, compiler, 0, size, I8);
+			return TRUE;
+		}
+
+		/* ALU ops on r/m with an immediate */
+		case 0x80: case 0x81: case 0x83:
+		{
+			int aluop = insn.reg;
+			generate_load_rm(block, compiler, insn, size, I6);
+			UML_MOV(block, I7, insn.imm & SIZE_MASK(size));                         // mov     i7,imm
+			generate_alu(block, compiler, aluop, size, memory && aluop != ALU_CMP, req);
+			if (!memory && aluop != ALU_CMP)
+				generate_store_reg(block, compiler, insn.rm, size, I8);
+			return TRUE;
+		}
+
+		/* TEST */
+		case 0x84: case 0x85:
+			generate_load_rm(block, compiler, insn, size, I6);
+			generate_load_reg(block, insn.reg, size, I7);
+			generate_alu(block, compiler, ALU_TEST, size, false, req);
+			return TRUE;
+
+		case 0xa8: case 0xa9:
+			generate_load_reg(block, 0, size, I6);
+			UML_MOV(block, I7, insn.imm & SIZE_MASK(size));                         // mov     i7,imm
+			generate_alu(block, compiler, ALU_TEST, size, false, req);
+			return TRUE;
+
+		/* INC/DEC reg */
+		case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:
+		case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:
+			generate_load_reg(block, op & 7, opsize, I6);
+			UML_MOV(block, I7, 1);                                                  // mov     i7,1
+			generate_alu(block, compiler, (op & 8) ? ALU_SUB : ALU_ADD, opsize, false, req & ~REGFLAG_CF);
+			compiler->flagsvalid &= ~REGFLAG_CF;
+			generate_store_reg(block, compiler, op & 7, opsize, I8);
+			return TRUE;
+
+		/* PUSH/POP reg */
+		case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:
+			generate_push(block, compiler, R32(op & 7));
+			return TRUE;
+
+		case 0x58: case 0x59: case 0x5a: case 0x5b: case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+			generate_pop(block, compiler, 0);
+			UML_MOV(block, R32(op & 7), I0);                                        // mov     reg,i0
+			return TRUE;
+
+		/* PUSH imm */
+		case 0x68: case 0x6a:
+			generate_push(block, compiler, insn.imm);
+			return TRUE;
+
+		/* IMUL reg, r/m, imm */
+		case 0x69: case 0x6b:
+			generate_load_rm(block, compiler, insn, 4, I6);
+			UML_MOV(block, I7, insn.imm);                                           // mov     i7,imm
+			generate_imul(block, compiler, insn.reg, req);
+			return TRUE;
+
+		/* Jcc rel8 */
+		case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+		case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+			generate_conditional_branch(block, compiler, desc, generate_condition(block, compiler, op & 15),
+					m_cycle_table_pm[CYCLES_JCC_DISP8] - m_cycle_table_pm[CYCLES_JCC_DISP8_NOBRANCH]);
+			return TRUE;
+
+		/* MOV */
+		case 0x88: case 0x89:
+			generate_load_reg(block, insn.reg, size, I8);
+			generate_store_rm(block, compiler, insn, size, I8);
+			return TRUE;
+
+		case 0x8a: case 0x8b:
+			generate_load_rm(block, compiler, insn, size, I8);
+			generate_store_reg(block, compiler, insn.reg, size, I8);
+			return TRUE;
+
+		/* LEA */
+		case 0x8d:
+			UML_MOV(block, R32(insn.reg), I5);                                      // mov     reg,i5
+			return TRUE;
+
+		/* XCHG r/m, reg; the register is written last */
+		case 0x86: case 0x87:
+			generate_load_rm(block, compiler, insn, size, I8);
+			generate_load_reg(block, insn.reg, size, I7);
+			generate_store_rm(block, compiler, insn, size, I7);
+			generate_store_reg(block, compiler, insn.reg, size, I8);
+			return TRUE;
+
+		/* NOP */
+		case 0x90:
+			return TRUE;
+
+		/* XCHG eax, reg */
+		case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97:
+			generate_load_reg(block, 0, opsize, I8);
+			generate_load_reg(block, op & 7, opsize, I7);
+			generate_store_reg(block, compiler, 0, opsize, I7);
+			generate_store_reg(block, compiler, op & 7, opsize, I8);
+			return TRUE;
+
+		/* CWDE/CDQ */
+		case 0x98:
+			UML_SEXT(block, R32(0), R32(0), SIZE_WORD);                             // sext    eax,eax,word
+			return TRUE;
+
+		case 0x99:
+			UML_SAR(block, R32(2), R32(0), 31);                                     // sar     edx,eax,31
+			return TRUE;
+
+		/* MOV acc, moffs */
+		case 0xa0: case 0xa1:
+			UML_MOV(block, I0, insn.disp);                                          // mov     i0,disp
+			UML_CALLH(block, *m_read[compiler->mode][SIZE_INDEX(size)]);            // callh   read
+			generate_store_reg(block, compiler, 0, size, I0);
+			return TRUE;
+
+		case 0xa2: case 0xa3:
+			UML_MOV(block, I0, insn.disp);                                          // mov     i0,disp
+			generate_load_reg(block, 0, size, I1);
+			UML_CALLH(block, *m_write[compiler->mode][SIZE_INDEX(size)]);           // callh   write
+			return TRUE;
+
+		/* MOV reg, imm */
+		case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
+			generate_store_reg(block, compiler, op & 7, 1, insn.imm & 0xff);
+			return TRUE;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+			generate_store_reg(block, compiler, op & 7, opsize, insn.imm & SIZE_MASK(opsize));
+			return TRUE;
+
+		/* shifts by an immediate or by 1 */
+		case 0xc1: case 0xd1:
+			generate_shift(block, compiler, insn, (op == 0xd1) ? 1 : (insn.imm & 0xff), req);
+			return TRUE;
+
+		/* RET near */
+		case 0xc2: case 0xc3:
+			generate_pop(block, compiler, (op == 0xc2) ? (INT16)insn.imm : 0);
+			UML_MOV(block, I8, I0);                                                 // mov     i8,i0
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		/* MOV r/m, imm */
+		case 0xc6: case 0xc7:
+			generate_store_rm(block, compiler, insn, size, insn.imm & SIZE_MASK(size));
+			return TRUE;
+
+		/* LEAVE */
+		case 0xc9:
+			UML_MOV(block, I0, R32(5));                                             // mov     i0,ebp
+			UML_CALLH(block, *m_read[compiler->mode][2]);                           // callh   read32
+			UML_ADD(block, R32(4), R32(5), 4);                                      // add     esp,ebp,4
+			UML_MOV(block, R32(5), I0);                                             // mov     ebp,i0
+			return TRUE;
+
+		/* LOOP/JECXZ */
+		case 0xe2:
+			UML_SUB(block, R32(1), R32(1), 1);                                      // sub     ecx,ecx,1
+			generate_conditional_branch(block, compiler, desc, COND_NZ, 0);
+			return TRUE;
+
+		case 0xe3:
+			UML_CMP(block, R32(1), 0);                                              // cmp     ecx,0
+			generate_conditional_branch(block, compiler, desc, COND_Z,
+					m_cycle_table_pm[CYCLES_JCXZ] - m_cycle_table_pm[CYCLES_JCXZ_NOBRANCH]);
+			return TRUE;
+
+		/* CALL/JMP rel */
+		case 0xe8:
+			generate_push(block, compiler, desc->pc + desc->length);
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		case 0xe9: case 0xeb:
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		/* group 3 */
+		case 0xf6: case 0xf7:
+			switch (insn.reg)
+			{
+				case 0:
+					/* unlike the other forms of TEST, this one clears AF */
+					generate_load_rm(block, compiler, insn, size, I6);
+					UML_MOV(block, I7, insn.imm & SIZE_MASK(size));                 // mov     i7,imm
+					generate_alu(block, compiler, ALU_TEST, size, false, req);
+					if (req & REGFLAG_AF)
+						UML_MOV(block, mem(&m_i386_state->af), 0);                  // mov     [af],0
+					return TRUE;
+
+				case 2:
+					generate_load_rm(block, compiler, insn, 4, I6);
+					UML_XOR(block, I8, I6, 0xffffffff);                             // xor     i8,i6,~0
+					generate_store_rm(block, compiler, insn, 4, I8);
+					return TRUE;
+
+				case 3:
+					generate_load_rm(block, compiler, insn, 4, I7);
+					UML_MOV(block, I6, 0);                                          // mov     i6,0
+					generate_alu(block, compiler, ALU_SUB, 4, memory, req);
+					if (!memory)
+						generate_store_reg(block, compiler, insn.rm, 4, I8);
+					return TRUE;
+			}
+			return FALSE;
+
+		/* INC/DEC r/m8 */
+		case 0xfe:
+			generate_load_rm(block, compiler, insn, 1, I6);
+			UML_MOV(block, I7, 1);                                                  // mov     i7,1
+			generate_alu(block, compiler, (insn.reg == 1) ? ALU_SUB : ALU_ADD, 1, memory, req & ~REGFLAG_CF);
+			compiler->flagsvalid &= ~REGFLAG_CF;
+			if (!memory)
+				generate_store_reg(block, compiler, insn.rm, 1, I8);
+			return TRUE;
+
+		/* group 5 */
+		case 0xff:
+			switch (insn.reg)
+			{
+				case 0:
+				case 1:
+					generate_load_rm(block, compiler, insn, 4, I6);
+					UML_MOV(block, I7, 1);                                          // mov     i7,1
+					generate_alu(block, compiler, (insn.reg == 1) ? ALU_SUB : ALU_ADD, 4, memory, req & ~REGFLAG_CF);
+					compiler->flagsvalid &= ~REGFLAG_CF;
+					if (!memory)
+						generate_store_reg(block, compiler, insn.rm, 4, I8);
+					return TRUE;
+
+				case 2:
+					generate_load_rm(block, compiler, insn, 4, I8);
+					generate_push(block, compiler, desc->pc + desc->length);
+					generate_branch(block, compiler, desc, 0);
+					return TRUE;
+
+				case 4:
+					generate_load_rm(block, compiler, insn, 4, I8);
+					generate_branch(block, compiler, desc, 0);
+					return TRUE;
+
+				case 6:
+					generate_load_rm(block, compiler, insn, 4, I8);
+					generate_push(block, compiler, I8);
+					return TRUE;
+			}
+			return FALSE;
+	}
+
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    generate_twobyte - generate code for a
+    0x0f-prefixed opcode
+-------------------------------------------------*/
+
+int i386_device::generate_twobyte(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, const i386_insn &insn)
+{
+	UINT8 op = insn.opcode;
+	UINT32 req = desc->regreq[1];
+
+	switch (op)
+	{
+		/* Jcc rel32 */
+		case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:
+		case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+			generate_conditional_branch(block, compiler, desc, generate_condition(block, compiler, op & 15),
+					m_cycle_table_pm[CYCLES_JCC_FULL_DISP] - m_cycle_table_pm[CYCLES_JCC_FULL_DISP_NOBRANCH]);
+			return TRUE;
+
+		/* SETcc r/m8 */
+		case 0x90: case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97:
+		case 0x98: case 0x99: case 0x9a: case 0x9b: case 0x9c: case 0x9d: case 0x9e: case 0x9f:
+		{
+			/* the condition may emit a compare, which must precede the setc */
+			uml::condition_t cond = generate_condition(block, compiler, op & 15);
+			UML_SETc(block, cond, I8);                                              // setc    i8,cond
+			generate_store_rm(block, compiler, insn, 1, I8);
+			return TRUE;
+		}
+
+		/* IMUL reg, r/m */
+		case 0xaf:
+			generate_load_reg(block, insn.reg, 4, I6);
+			generate_load_rm(block, compiler, insn, 4, I7);
+			generate_imul(block, compiler, insn.reg, req);
+			return TRUE;
+
+		/* MOVZX/MOVSX */
+		case 0xb6: case 0xb7: case 0xbe: case 0xbf:
+			generate_load_rm(block, compiler, insn, (op & 1) ? 2 : 1, I8);
+			if (op >= 0xbe)
+				UML_SEXT(block, I8, I8, (op & 1) ? SIZE_WORD : SIZE_BYTE);          // sext    i8,i8,size
+			UML_MOV(block, R32(insn.reg), I8);                                      // mov     reg,i8
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    generate_imul - generate a 32x32 signed
+    multiply of I6 and I7 into a register; CF
+    and OF are set if the product doesn't fit
+-------------------------------------------------*/
+
+void i386_device::generate_imul(drcuml_block *block, compiler_state *compiler, int regnum, UINT32 req)
+{
+	UML_MULS(block, I8, I9, I6, I7);                                                // muls    i8,i9,i6,i7
+	if (req & (REGFLAG_CF | REGFLAG_OF))
+	{
+		UML_SAR(block, I0, I8, 31);                                                 // sar     i0,i8,31
+		UML_CMP(block, I0, I9);                                                     // cmp     i0,i9
+		if (req & REGFLAG_CF)
+			UML_SETc(block, COND_NE, mem(&m_i386_state->cf));                       // setc    [cf],NE
+		if (req & REGFLAG_OF)
+			UML_SETc(block, COND_NE, mem(&m_i386_state->of));                       // setc    [of],NE
+	}
+	UML_MOV(block, R32(regnum), I8);                                                // mov     reg,i8
+}
@@ -0,0 +1,862 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Philip Bennett
+/***************************************************************************
+
+    i386fe.cpp
+
+    Front-end for i386 recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i386.h"
+#include "i386fe.h"
+#include "cycles.h"
+
+
+//**************************************************************************
+//  INSTRUCTION DECODER
+//**************************************************************************
+
+// operand layout table entries: low 3 bits are the immediate type
+#define __  0x00        // no immediate
+#define IB  0x01        // 8-bit immediate, sign-extended
+#define IZ  0x02        // 16 or 32-bit immediate, depending on operand size
+#define IW  0x03        // 16-bit immediate
+#define IE  0x04        // 16-bit immediate followed by an 8-bit immediate
+#define IF  0x05        // far pointer (offset plus selector)
+#define MO  0x06        // memory offset, depending on address size
+#define XX  0x07        // prefix, escape or unknown opcode
+#define M   0x08        // mod r/m byte present
+
+static const UINT8 s_onebyte_layout[256] =
+{
+/*         x0    x1    x2    x3    x4    x5    x6    x7    x8    x9    xA    xB    xC    xD    xE    xF */
+/* 0x */   M,    M,    M,    M,    IB,   IZ,   __,   __,   M,    M,    M,    M,    IB,   IZ,   __,   XX,
+/* 1x */   M,    M,    M,    M,    IB,   IZ,   __,   __,   M,    M,    M,    M,    IB,   IZ,   __,   __,
+/* 2x */   M,    M,    M,    M,    IB,   IZ,   XX,   __,   M,    M,    M,    M,    IB,   IZ,   XX,   __,
+/* 3x */   M,    M,    M,    M,    IB,   IZ,   XX,   __,   M,    M,    M,    M,    IB,   IZ,   XX,   __,
+/* 4x */   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,
+/* 5x */   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,
+/* 6x */   __,   __,   M,    M,    XX,   XX,   XX,   XX,   IZ,   M|IZ, IB,   M|IB, __,   __,   __,   __,
+/* 7x */   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,
+/* 8x */   M|IB, M|IZ, M|IB, M|IB, M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* 9x */   __,   __,   __,   __,   __,   __,   __,   __,   __,   __,   IF,   __,   __,   __,   __,   __,
+/* Ax */   MO,   MO,   MO,   MO,   __,   __,   __,   __,   IB,   IZ,   __,   __,   __,   __,   __,   __,
+/* Bx */   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,
+/* Cx */   M|IB, M|IB, IW,   __,   M,    M,    M|IB, M|IZ, IE,   __,   IW,   __,   __,   IB,   __,   __,
+/* Dx */   M,    M,    M,    M,    IB,   IB,   __,   __,   M,    M,    M,    M,    M,    M,    M,    M,
+/* Ex */   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IB,   IZ,   IZ,   IF,   IB,   __,   __,   __,   __,
+/* Fx */   XX,   __,   XX,   XX,   __,   __,   M,    M,    __,   __,   __,   __,   __,   __,   M,    M
+};
+
+static const UINT8 s_twobyte_layout[256] =
+{
+/*         x0    x1    x2    x3    x4    x5    x6    x7    x8    x9    xA    xB    xC    xD    xE    xF */
+/* 0x */   M,    M,    M,    M,    XX,   XX,   __,   XX,   __,   __,   XX,   __,   XX,   M,    XX,   XX,
+/* 1x */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* 2x */   M,    M,    M,    M,    M,    XX,   M,    XX,   M,    M,    M,    M,    M,    M,    M,    M,
+/* 3x */   __,   __,   __,   __,   __,   __,   XX,   XX,   XX,   XX,   XX,   XX,   XX,   XX,   XX,   XX,
+/* 4x */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* 5x */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* 6x */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* 7x */   M|IB, M|IB, M|IB, M|IB, M,    M,    M,    __,   XX,   XX,   XX,   XX,   M,    M,    M,    M,
+/* 8x */   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,   IZ,
+/* 9x */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* Ax */   __,   __,   __,   M,    M|IB, M,    XX,   XX,   __,   __,   __,   M,    M|IB, M,    M,    M,
+/* Bx */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M|IB, M,    M,    M,    M,    M,
+/* Cx */   M,    M,    M|IB, M,    M|IB, M|IB, M|IB, M,    __,   __,   __,   __,   __,   __,   __,   __,
+/* Dx */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* Ex */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+/* Fx */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M
+};
+
+#undef __
+#undef IB
+#undef IZ
+#undef IW
+#undef IE
+#undef IF
+#undef MO
+#undef XX
+#undef M
+
+
+//-------------------------------------------------
+//  alu_flags - return the flags written by one
+//  of the eight basic ALU operations; the logical
+//  ones leave AF alone
+//-------------------------------------------------
+
+static inline UINT32 alu_flags(int aluop)
+{
+	return (aluop == 1 || aluop == 4 || aluop == 6) ? (REGFLAG_ARITH & ~REGFLAG_AF) : REGFLAG_ARITH;
+}
+
+
+//-------------------------------------------------
+//  fetch_operand - fetch a little-endian operand
+//  of the given size, failing if it runs past
+//  the available bytes
+//-------------------------------------------------
+
+static inline bool fetch_operand(const UINT8 *oprom, int avail, int &pos, int size, UINT32 &result)
+{
+	if (pos + size > avail)
+		return false;
+	result = 0;
+	for (int byte = 0; byte < size; byte++)
+		result |= oprom[pos + byte] << (8 * byte);
+	pos += size;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  i386_decode_insn - decode the prefixes,
+//  operands and length of a single instruction
+//  executing in a 32-bit code segment; returns
+//  false if the instruction cannot be sized
+//-------------------------------------------------
+
+bool i386_decode_insn(const UINT8 *oprom, int avail, i386_insn &insn)
+{
+	int pos = 0;
+	UINT32 value;
+
+	memset(&insn, 0, sizeof(insn));
+	insn.base = insn.index = -1;
+
+	// consume prefixes
+	for (;;)
+	{
+		if (pos >= avail)
+			return false;
+		switch (oprom[pos])
+		{
+			case 0x66:  insn.flags |= I386INSN_OPSIZE;      break;
+			case 0x67:  insn.flags |= I386INSN_ADDRSIZE;    break;
+			case 0xf0:  insn.flags |= I386INSN_LOCK;        break;
+			case 0xf2:
+			case 0xf3:  insn.flags |= I386INSN_REP;         break;
+			case 0x26:  insn.flags |= I386INSN_SEGMENT;     insn.segment = 0;   break;  // ES
+			case 0x2e:  insn.flags |= I386INSN_SEGMENT;     insn.segment = 1;   break;  // CS
+			case 0x36:  insn.flags |= I386INSN_SEGMENT;     insn.segment = 2;   break;  // SS
+			case 0x3e:  insn.flags |= I386INSN_SEGMENT;     insn.segment = 3;   break;  // DS
+			case 0x64:  insn.flags |= I386INSN_SEGMENT;     insn.segment = 4;   break;  // FS
+			case 0x65:  insn.flags |= I386INSN_SEGMENT;     insn.segment = 5;   break;  // GS
+			default:    goto prefixes_done;
+		}
+		pos++;
+	}
+
+prefixes_done:
+	// fetch the opcode and look up its layout
+	UINT8 layout;
+	insn.opcode = oprom[pos++];
+	if (insn.opcode == 0x0f)
+	{
+		if (pos >= avail)
+			return false;
+		insn.flags |= I386INSN_TWOBYTE;
+		insn.opcode = oprom[pos++];
+		if (insn.opcode == 0x38 || insn.opcode == 0x3a)
+		{
+			// three-byte opcodes; only the length matters to us
+			if (pos++ >= avail)
+				return false;
+			layout = 0x08 | ((insn.opcode == 0x3a) ? 0x01 : 0x00);
+		}
+		else
+			layout = s_twobyte_layout[insn.opcode];
+	}
+	else
+		layout = s_onebyte_layout[insn.opcode];
+	if ((layout & 0x07) == 0x07)
+		return false;
+
+	// decode the mod r/m byte and any SIB and displacement
+	if (layout & 0x08)
+	{
+		if (pos >= avail)
+			return false;
+		UINT8 modrm = oprom[pos++];
+		insn.flags |= I386INSN_MODRM;
+		insn.mod = modrm >> 6;
+		insn.reg = (modrm >> 3) & 7;
+		insn.rm = modrm & 7;
+
+		if (insn.mod != 3)
+		{
+			insn.flags |= I386INSN_MEMORY;
+
+			// 16-bit addressing is never compiled, so only the length is needed
+			if (insn.flags & I386INSN_ADDRSIZE)
+			{
+				int dispsize = (insn.mod == 1) ? 1 : (insn.mod == 2 || (insn.mod == 0 && insn.rm == 6)) ? 2 : 0;
+				if (!fetch_operand(oprom, avail, pos, dispsize, insn.disp))
+					return false;
+			}
+			else
+			{
+				int dispsize = (insn.mod == 1) ? 1 : (insn.mod == 2) ? 4 : 0;
+				insn.base = insn.rm;
+				if (insn.rm == 4)
+				{
+					if (!fetch_operand(oprom, avail, pos, 1, value))
+						return false;
+					insn.scale = value >> 6;
+					insn.index = ((value >> 3) & 7) == 4 ? -1 : ((value >> 3) & 7);
+					insn.base = value & 7;
+					if (insn.base == 5 && insn.mod == 0)
+					{
+						insn.base = -1;
+						dispsize = 4;
+					}
+				}
+				else if (insn.rm == 5 && insn.mod == 0)
+				{
+					insn.base = -1;
+					dispsize = 4;
+				}
+				if (!fetch_operand(oprom, avail, pos, dispsize, insn.disp))
+					return false;
+				if (dispsize == 1)
+					insn.disp = (INT8)insn.disp;
+			}
+		}
+	}
+
+	// group 3 only carries an immediate for TEST
+	if (!(insn.flags & I386INSN_TWOBYTE) && (insn.opcode == 0xf6 || insn.opcode == 0xf7) && insn.reg < 2)
+		layout |= (insn.opcode == 0xf6) ? 0x01 : 0x02;
+
+	// fetch any immediates
+	int opsize = (insn.flags & I386INSN_OPSIZE) ? 2 : 4;
+	switch (layout & 0x07)
+	{
+		case 0x01:
+			if (!fetch_operand(oprom, avail, pos, 1, insn.imm))
+				return false;
+			insn.imm = (INT8)insn.imm;
+			break;
+
+		case 0x02:
+			if (!fetch_operand(oprom, avail, pos, opsize, insn.imm))
+				return false;
+			if (opsize == 2)
+				insn.imm = (INT16)insn.imm;
+			break;
+
+		case 0x03:
+			if (!fetch_operand(oprom, avail, pos, 2, insn.imm))
+				return false;
+			break;
+
+		case 0x04:
+			if (!fetch_operand(oprom, avail, pos, 2, insn.imm) || !fetch_operand(oprom, avail, pos, 1, insn.imm2))
+				return false;
+			break;
+
+		case 0x05:
+			if (!fetch_operand(oprom, avail, pos, opsize, insn.imm) || !fetch_operand(oprom, avail, pos, 2, insn.imm2))
+				return false;
+			break;
+
+		case 0x06:
+			if (!fetch_operand(oprom, avail, pos, (insn.flags & I386INSN_ADDRSIZE) ? 2 : 4, insn.disp))
+				return false;
+			break;
+	}
+
+	// the architectural limit is 15 bytes
+	if (pos > 15)
+		return false;
+	insn.length = pos;
+	return true;
+}
+
+
+
+//**************************************************************************
+//  I386 FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  i386_frontend - constructor
+//-------------------------------------------------
+
+i386_frontend::i386_frontend(i386_device *i386, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*i386, window_start, window_end, max_sequence),
+		m_i386(i386)
+{
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	// compute the physical PC; the linear address is the PC in flat mode
+	offs_t physpc = desc.pc;
+	if (!m_i386->drc_translate_fetch(physpc))
+	{
+		// a page fault; leave the description empty and let the interpreter raise it
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_VIRTUAL_NOOP | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+	desc.physpc = physpc;
+
+	// code running from I/O space is left to the interpreter
+	if (m_i386->m_program->get_read_ptr(physpc) == nullptr)
+	{
+		desc.flags |= OPFLAG_COMPILER_UNMAPPED | OPFLAG_END_SEQUENCE;
+		desc.length = 1;
+		return describe_interpreted(desc);
+	}
+
+	// fetch up to 15 bytes; the tail may sit on a different physical page
+	int avail;
+	for (avail = 0; avail < 15; avail++)
+	{
+		if (avail != 0 && ((desc.pc + avail) & 0xfff) == 0)
+		{
+			physpc = desc.pc + avail;
+			if (!m_i386->drc_translate_fetch(physpc) || m_i386->m_program->get_read_ptr(physpc) == nullptr)
+				break;
+		}
+		desc.opptr.b[avail] = m_i386->m_direct->read_byte(physpc++);
+	}
+
+	// if we can't even size the instruction, interpret it and stop here
+	i386_insn insn;
+	if (!i386_decode_insn(desc.opptr.b, avail, insn))
+	{
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		desc.length = 1;
+		return describe_interpreted(desc);
+	}
+	desc.length = insn.length;
+
+	// anything with prefixes we don't model goes to the interpreter
+	if (insn.flags & (I386INSN_LOCK | I386INSN_REP | I386INSN_ADDRSIZE))
+		return describe_interpreted(desc);
+	if ((insn.flags & I386INSN_SEGMENT) && insn.segment != 0 && insn.segment != 2 && insn.segment != 3)
+		return describe_interpreted(desc);
+
+	if (insn.flags & I386INSN_TWOBYTE)
+		return describe_twobyte(desc, insn);
+	return describe_onebyte(desc, insn);
+}
+
+
+//-------------------------------------------------
+//  describe_interpreted - describe an
+//  instruction that is handed to the interpreter
+//-------------------------------------------------
+
+bool i386_frontend::describe_interpreted(opcode_desc &desc)
+{
+	// the interpreter may read or write anything, and charges its own cycles
+	desc.regin[0] |= REGFLAG_ALLREGS;
+	desc.regout[0] |= REGFLAG_ALLREGS;
+	desc.regin[1] |= REGFLAG_ARITH;
+	desc.regout[1] |= REGFLAG_ARITH;
+	desc.flags |= I386OPFLAG_INTERPRET | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+	desc.cycles = 0;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  describe_modrm - account for the r/m operand
+//  of an instruction; returns the number of
+//  cycles appropriate for the operand type
+//-------------------------------------------------
+
+int i386_frontend::describe_modrm(opcode_desc &desc, const i386_insn &insn, int size, bool read, bool write, int regcycles, int memcycles)
+{
+	if (insn.flags & I386INSN_MEMORY)
+	{
+		if (insn.base >= 0)
+			desc.regin[0] |= REGFLAG_R(insn.base);
+		if (insn.index >= 0)
+			desc.regin[0] |= REGFLAG_R(insn.index);
+
+		// a faulting access exposes every flag in the exception frame
+		desc.regin[1] |= REGFLAG_ARITH;
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+		if (read)
+			desc.flags |= OPFLAG_READS_MEMORY;
+		if (write)
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+		return m_i386->m_cycle_table_pm[memcycles];
+	}
+
+	// register operand; byte registers 4-7 are the high bytes of 0-3
+	int regnum = (size == 1) ? (insn.rm & 3) : insn.rm;
+	if (read || size != 4)
+		desc.regin[0] |= REGFLAG_R(regnum);
+	if (write)
+		desc.regout[0] |= REGFLAG_R(regnum);
+	return m_i386->m_cycle_table_pm[regcycles];
+}
+
+
+//-------------------------------------------------
+//  describe_reg - account for a register operand
+//-------------------------------------------------
+
+void i386_frontend::describe_reg(opcode_desc &desc, int regnum, int size, bool read, bool write)
+{
+	if (size == 1)
+		regnum &= 3;
+	if (read || size != 4)
+		desc.regin[0] |= REGFLAG_R(regnum);
+	if (write)
+		desc.regout[0] |= REGFLAG_R(regnum);
+}
+
+
+//-------------------------------------------------
+//  describe_stack - account for a stack access
+//-------------------------------------------------
+
+void i386_frontend::describe_stack(opcode_desc &desc, bool write)
+{
+	desc.regin[0] |= REGFLAG_R(4);
+	desc.regout[0] |= REGFLAG_R(4);
+	desc.regin[1] |= REGFLAG_ARITH;
+	desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | (write ? OPFLAG_WRITES_MEMORY : OPFLAG_READS_MEMORY);
+}
+
+
+//-------------------------------------------------
+//  describe_condition - account for the flags
+//  read by a condition code
+//-------------------------------------------------
+
+void i386_frontend::describe_condition(opcode_desc &desc, int cond)
+{
+	static const UINT8 s_condition_flags[8] =
+	{
+		REGFLAG_OF,
+		REGFLAG_CF,
+		REGFLAG_ZF,
+		REGFLAG_CF | REGFLAG_ZF,
+		REGFLAG_SF,
+		REGFLAG_PF,
+		REGFLAG_SF | REGFLAG_OF,
+		REGFLAG_ZF | REGFLAG_SF | REGFLAG_OF
+	};
+	desc.regin[1] |= s_condition_flags[(cond >> 1) & 7];
+}
+
+
+//-------------------------------------------------
+//  describe_onebyte - build a description of a
+//  single-byte opcode
+//-------------------------------------------------
+
+bool i386_frontend::describe_onebyte(opcode_desc &desc, const i386_insn &insn)
+{
+	UINT8 op = insn.opcode;
+	int opsize = (insn.flags & I386INSN_OPSIZE) ? 2 : 4;
+	int size = (op & 1) ? opsize : 1;
+
+	switch (op)
+	{
+		// ALU ops: add, or, adc, sbb, and, sub, xor, cmp
+		case 0x00: case 0x01: case 0x08: case 0x09: case 0x10: case 0x11: case 0x18: case 0x19:
+		case 0x20: case 0x21: case 0x28: case 0x29: case 0x30: case 0x31: case 0x38: case 0x39:
+		case 0x02: case 0x03: case 0x0a: case 0x0b: case 0x12: case 0x13: case 0x1a: case 0x1b:
+		case 0x22: case 0x23: case 0x2a: case 0x2b: case 0x32: case 0x33: case 0x3a: case 0x3b:
+		{
+			int aluop = (op >> 3) & 7;
+			bool tomem = !(op & 2);
+			if ((aluop == 2 || aluop == 3) && size != 4)
+				return describe_interpreted(desc);
+			if (aluop == 2 || aluop == 3)
+				desc.regin[1] |= REGFLAG_CF;
+			desc.regout[1] |= alu_flags(aluop);
+			if (tomem)
+			{
+				desc.cycles = describe_modrm(desc, insn, size, true, aluop != 7, (aluop == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG, (aluop == 7) ? CYCLES_CMP_REG_MEM : CYCLES_ALU_REG_MEM);
+				describe_reg(desc, insn.reg, size, true, false);
+			}
+			else
+			{
+				desc.cycles = describe_modrm(desc, insn, size, true, false, (aluop == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG, (aluop == 7) ? CYCLES_CMP_MEM_REG : CYCLES_ALU_MEM_REG);
+				describe_reg(desc, insn.reg, size, true, aluop != 7);
+			}
+			return true;
+		}
+
+		// ALU ops on the accumulator with an immediate
+		case 0x04: case 0x05: case 0x0c: case 0x0d: case 0x14: case 0x15: case 0x1c: case 0x1d:
+		case 0x24: case 0x25: case 0x2c: case 0x2d: case 0x34: case 0x35: case 0x3c: case 0x3d:
+		{
+			int aluop = (op >> 3) & 7;
+			if ((aluop == 2 || aluop == 3) && size != 4)
+				return describe_interpreted(desc);
+			if (aluop == 2 || aluop == 3)
+				desc.regin[1] |= REGFLAG_CF;
+			desc.regout[1] |= alu_flags(aluop);
+			describe_reg(desc, 0, size, true, aluop != 7);
+			desc.cycles = m_i386->m_cycle_table_pm[(aluop == 7) ? CYCLES_CMP_IMM_ACC : CYCLES_ALU_IMM_ACC];
+			return true;
+		}
+
+		// ALU ops on r/m with an immediate
+		case 0x80: case 0x81: case 0x83:
+		{
+			int aluop = insn.reg;
+			if ((aluop == 2 || aluop == 3) && size != 4)
+				return describe_interpreted(desc);
+			if (aluop == 2 || aluop == 3)
+				desc.regin[1] |= REGFLAG_CF;
+			desc.regout[1] |= alu_flags(aluop);
+			desc.cycles = describe_modrm(desc, insn, size, true, aluop != 7, (aluop == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG, (aluop == 7) ? CYCLES_CMP_REG_MEM : CYCLES_ALU_REG_MEM);
+			return true;
+		}
+
+		// TEST r/m, reg
+		case 0x84: case 0x85:
+			desc.regout[1] |= REGFLAG_ARITH & ~REGFLAG_AF;
+			desc.cycles = describe_modrm(desc, insn, size, true, false, CYCLES_TEST_REG_REG, CYCLES_TEST_REG_MEM);
+			describe_reg(desc, insn.reg, size, true, false);
+			return true;
+
+		// TEST acc, imm
+		case 0xa8: case 0xa9:
+			desc.regout[1] |= REGFLAG_ARITH & ~REGFLAG_AF;
+			describe_reg(desc, 0, size, true, false);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_TEST_IMM_ACC];
+			return true;
+
+		// INC/DEC reg
+		case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:
+		case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:
+			desc.regout[1] |= REGFLAG_ARITH & ~REGFLAG_CF;
+			describe_reg(desc, op & 7, opsize, true, true);
+			desc.cycles = m_i386->m_cycle_table_pm[(op & 8) ? CYCLES_DEC_REG : CYCLES_INC_REG];
+			return true;
+
+		// PUSH reg
+		case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_reg(desc, op & 7, 4, true, false);
+			describe_stack(desc, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_PUSH_REG_SHORT];
+			return true;
+
+		// POP reg
+		case 0x58: case 0x59: case 0x5a: case 0x5b: case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_reg(desc, op & 7, 4, false, true);
+			describe_stack(desc, false);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_POP_REG_SHORT];
+			return true;
+
+		// PUSH imm
+		case 0x68: case 0x6a:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_stack(desc, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_PUSH_IMM];
+			return true;
+
+		// IMUL reg, r/m, imm
+		case 0x69: case 0x6b:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			desc.regout[1] |= REGFLAG_CF | REGFLAG_OF;
+			desc.cycles = describe_modrm(desc, insn, 4, true, false, CYCLES_IMUL32_REG_IMM_REG, CYCLES_IMUL32_MEM_IMM_REG);
+			describe_reg(desc, insn.reg, 4, false, true);
+			return true;
+
+		// Jcc rel8
+		case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+		case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+			describe_condition(desc, op & 15);
+			desc.targetpc = desc.pc + insn.length + insn.imm;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_JCC_DISP8_NOBRANCH];
+			return true;
+
+		// MOV r/m, reg
+		case 0x88: case 0x89:
+			desc.cycles = describe_modrm(desc, insn, size, false, true, CYCLES_MOV_REG_REG, CYCLES_MOV_REG_MEM);
+			describe_reg(desc, insn.reg, size, true, false);
+			return true;
+
+		// MOV reg, r/m
+		case 0x8a: case 0x8b:
+			desc.cycles = describe_modrm(desc, insn, size, true, false, CYCLES_MOV_REG_REG, CYCLES_MOV_MEM_REG);
+			describe_reg(desc, insn.reg, size, false, true);
+			return true;
+
+		// LEA reg, mem
+		case 0x8d:
+			if (opsize != 4 || !(insn.flags & I386INSN_MEMORY))
+				return describe_interpreted(desc);
+			if (insn.base >= 0)
+				desc.regin[0] |= REGFLAG_R(insn.base);
+			if (insn.index >= 0)
+				desc.regin[0] |= REGFLAG_R(insn.index);
+			describe_reg(desc, insn.reg, 4, false, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_LEA];
+			return true;
+
+		// XCHG r/m, reg
+		case 0x86: case 0x87:
+			desc.cycles = describe_modrm(desc, insn, size, true, true, CYCLES_XCHG_REG_REG, CYCLES_XCHG_REG_MEM);
+			describe_reg(desc, insn.reg, size, true, true);
+			return true;
+
+		// NOP
+		case 0x90:
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_NOP];
+			return true;
+
+		// XCHG eax, reg
+		case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97:
+			describe_reg(desc, 0, opsize, true, true);
+			describe_reg(desc, op & 7, opsize, true, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_XCHG_REG_REG];
+			return true;
+
+		// CWDE
+		case 0x98:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_reg(desc, 0, 4, true, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_CBW];
+			return true;
+
+		// CDQ
+		case 0x99:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_reg(desc, 0, 4, true, false);
+			describe_reg(desc, 2, 4, false, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_CWD];
+			return true;
+
+		// MOV acc, moffs
+		case 0xa0: case 0xa1:
+			describe_reg(desc, 0, size, false, true);
+			desc.regin[1] |= REGFLAG_ARITH;
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_READS_MEMORY;
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_MOV_MEM_ACC];
+			return true;
+
+		// MOV moffs, acc
+		case 0xa2: case 0xa3:
+			describe_reg(desc, 0, size, true, false);
+			desc.regin[1] |= REGFLAG_ARITH;
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_WRITES_MEMORY;
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_MOV_ACC_MEM];
+			return true;
+
+		// MOV reg, imm
+		case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
+			describe_reg(desc, op & 7, 1, false, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_MOV_IMM_REG];
+			return true;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+			describe_reg(desc, op & 7, opsize, false, true);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_MOV_IMM_REG];
+			return true;
+
+		// shift r/m32 by an immediate or by 1
+		case 0xc1: case 0xd1:
+		{
+			UINT32 count = (op == 0xd1) ? 1 : insn.imm & 0xff;
+			if (opsize != 4 || (insn.reg != 4 && insn.reg != 5 && insn.reg != 7) || count == 0 || count > 31)
+				return describe_interpreted(desc);
+			desc.regout[1] |= REGFLAG_CF | REGFLAG_SZPF | ((count == 1) ? REGFLAG_OF : 0);
+			desc.cycles = describe_modrm(desc, insn, 4, true, true, CYCLES_ROTATE_REG, CYCLES_ROTATE_MEM);
+			return true;
+		}
+
+		// RET near
+		case 0xc2: case 0xc3:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_stack(desc, false);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.cycles = m_i386->m_cycle_table_pm[(op == 0xc2) ? CYCLES_RET_IMM : CYCLES_RET];
+			return true;
+
+		// MOV r/m, imm
+		case 0xc6: case 0xc7:
+			if (insn.reg != 0)
+				return describe_interpreted(desc);
+			desc.cycles = describe_modrm(desc, insn, size, false, true, CYCLES_MOV_IMM_REG, CYCLES_MOV_IMM_MEM);
+			return true;
+
+		// LEAVE
+		case 0xc9:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			desc.regin[0] |= REGFLAG_R(5);
+			desc.regout[0] |= REGFLAG_R(5);
+			describe_stack(desc, false);
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_LEAVE];
+			return true;
+
+		// LOOP / JECXZ
+		case 0xe2: case 0xe3:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			desc.regin[0] |= REGFLAG_R(1);
+			if (op == 0xe2)
+				desc.regout[0] |= REGFLAG_R(1);
+			desc.targetpc = desc.pc + insn.length + insn.imm;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.cycles = m_i386->m_cycle_table_pm[(op == 0xe2) ? CYCLES_LOOP : CYCLES_JCXZ_NOBRANCH];
+			return true;
+
+		// CALL rel32
+		case 0xe8:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_stack(desc, true);
+			desc.targetpc = desc.pc + insn.length + insn.imm;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_CALL];
+			return true;
+
+		// JMP rel32 / rel8
+		case 0xe9: case 0xeb:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			desc.targetpc = desc.pc + insn.length + insn.imm;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.cycles = m_i386->m_cycle_table_pm[(op == 0xeb) ? CYCLES_JMP_SHORT : CYCLES_JMP];
+			return true;
+
+		// group 3: TEST, NOT, NEG
+		case 0xf6: case 0xf7:
+			switch (insn.reg)
+			{
+				case 0:
+					desc.regout[1] |= REGFLAG_ARITH;
+					desc.cycles = describe_modrm(desc, insn, size, true, false, CYCLES_TEST_IMM_REG, CYCLES_TEST_IMM_MEM);
+					return true;
+
+				case 2:
+					if (size != 4)
+						return describe_interpreted(desc);
+					desc.cycles = describe_modrm(desc, insn, 4, true, true, CYCLES_NOT_REG, CYCLES_NOT_MEM);
+					return true;
+
+				case 3:
+					if (size != 4)
+						return describe_interpreted(desc);
+					desc.regout[1] |= REGFLAG_ARITH;
+					desc.cycles = describe_modrm(desc, insn, 4, true, true, CYCLES_NEG_REG, CYCLES_NEG_MEM);
+					return true;
+			}
+			return describe_interpreted(desc);
+
+		// group 4: INC/DEC r/m8
+		case 0xfe:
+			if (insn.reg > 1)
+				return describe_interpreted(desc);
+			desc.regout[1] |= REGFLAG_ARITH & ~REGFLAG_CF;
+			desc.cycles = describe_modrm(desc, insn, 1, true, true, (insn.reg == 0) ? CYCLES_INC_REG : CYCLES_DEC_REG, (insn.reg == 0) ? CYCLES_INC_MEM : CYCLES_DEC_MEM);
+			return true;
+
+		// group 5: INC, DEC, CALL, JMP, PUSH
+		case 0xff:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			switch (insn.reg)
+			{
+				case 0:
+				case 1:
+					desc.regout[1] |= REGFLAG_ARITH & ~REGFLAG_CF;
+					desc.cycles = describe_modrm(desc, insn, 4, true, true, (insn.reg == 0) ? CYCLES_INC_REG : CYCLES_DEC_REG, (insn.reg == 0) ? CYCLES_INC_MEM : CYCLES_DEC_MEM);
+					return true;
+
+				case 2:
+					desc.cycles = describe_modrm(desc, insn, 4, true, false, CYCLES_CALL_REG, CYCLES_CALL_MEM);
+					describe_stack(desc, true);
+					desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+					return true;
+
+				case 4:
+					desc.cycles = describe_modrm(desc, insn, 4, true, false, CYCLES_JMP_REG, CYCLES_JMP_MEM);
+					desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+					return true;
+
+				case 6:
+					desc.cycles = describe_modrm(desc, insn, 4, true, false, CYCLES_PUSH_RM, CYCLES_PUSH_RM);
+					describe_stack(desc, true);
+					return true;
+			}
+			return describe_interpreted(desc);
+	}
+
+	return describe_interpreted(desc);
+}
+
+
+//-------------------------------------------------
+//  describe_twobyte - build a description of a
+//  0x0f-prefixed opcode
+//-------------------------------------------------
+
+bool i386_frontend::describe_twobyte(opcode_desc &desc, const i386_insn &insn)
+{
+	UINT8 op = insn.opcode;
+	int opsize = (insn.flags & I386INSN_OPSIZE) ? 2 : 4;
+
+	switch (op)
+	{
+		// Jcc rel32
+		case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:
+		case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			describe_condition(desc, op & 15);
+			desc.targetpc = desc.pc + insn.length + insn.imm;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.cycles = m_i386->m_cycle_table_pm[CYCLES_JCC_FULL_DISP_NOBRANCH];
+			return true;
+
+		// SETcc r/m8
+		case 0x90: case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97:
+		case 0x98: case 0x99: case 0x9a: case 0x9b: case 0x9c: case 0x9d: case 0x9e: case 0x9f:
+			describe_condition(desc, op & 15);
+			desc.cycles = describe_modrm(desc, insn, 1, false, true, CYCLES_SETCC_REG, CYCLES_SETCC_MEM);
+			return true;
+
+		// IMUL reg, r/m
+		case 0xaf:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			desc.regout[1] |= REGFLAG_CF | REGFLAG_OF;
+			desc.cycles = describe_modrm(desc, insn, 4, true, false, CYCLES_IMUL32_REG_REG, CYCLES_IMUL32_REG_REG);
+			describe_reg(desc, insn.reg, 4, true, true);
+			return true;
+
+		// MOVZX/MOVSX reg32, r/m8 / r/m16
+		case 0xb6: case 0xb7: case 0xbe: case 0xbf:
+			if (opsize != 4)
+				return describe_interpreted(desc);
+			desc.cycles = describe_modrm(desc, insn, (op & 1) ? 2 : 1, true, false, (op < 0xbe) ? CYCLES_MOVZX_REG_REG : CYCLES_MOVSX_REG_REG, (op < 0xbe) ? CYCLES_MOVZX_MEM_REG : CYCLES_MOVSX_MEM_REG);
+			describe_reg(desc, insn.reg, 4, false, true);
+			return true;
+	}
+
+	return describe_interpreted(desc);
+}
@@ -0,0 +1,84 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Philip Bennett
+/***************************************************************************
+
+    i386fe.h
+
+    Front-end for i386 recompiler
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __I386FE_H__
+#define __I386FE_H__
+
+
+//**************************************************************************
+//  MACROS
+//**************************************************************************
+
+// register flags 0
+#define REGFLAG_R(n)                    (1 << (n))
+#define REGFLAG_ALLREGS                 0x000000ff
+
+// register flags 1
+#define REGFLAG_CF                      (1 << 0)
+#define REGFLAG_PF                      (1 << 1)
+#define REGFLAG_AF                      (1 << 2)
+#define REGFLAG_ZF                      (1 << 3)
+#define REGFLAG_SF                      (1 << 4)
+#define REGFLAG_OF                      (1 << 5)
+#define REGFLAG_SZPF                    (REGFLAG_SF | REGFLAG_ZF | REGFLAG_PF)
+#define REGFLAG_ARITH                   (REGFLAG_CF | REGFLAG_PF | REGFLAG_AF | REGFLAG_ZF | REGFLAG_SF | REGFLAG_OF)
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// decoded instruction flags
+const UINT32 I386INSN_MODRM         = 0x0001;   // instruction has a mod r/m byte
+const UINT32 I386INSN_MEMORY        = 0x0002;   // mod r/m refers to memory
+const UINT32 I386INSN_OPSIZE        = 0x0004;   // 0x66 operand size prefix
+const UINT32 I386INSN_ADDRSIZE      = 0x0008;   // 0x67 address size prefix
+const UINT32 I386INSN_LOCK          = 0x0010;   // 0xf0 lock prefix
+const UINT32 I386INSN_REP           = 0x0020;   // 0xf2/0xf3 repeat prefix
+const UINT32 I386INSN_SEGMENT       = 0x0040;   // segment override prefix
+const UINT32 I386INSN_TWOBYTE       = 0x0080;   // 0x0f escape
+
+// opcode flags
+const UINT32 I386OPFLAG_INTERPRET   = 0x80000000;   // instruction is handed to the interpreter
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// a single decoded instruction, as seen by 32-bit code
+struct i386_insn
+{
+	UINT32      flags;                  // I386INSN_* flags
+	UINT8       length;                 // total length in bytes, including prefixes
+	UINT8       opcode;                 // primary opcode (second byte if I386INSN_TWOBYTE)
+	UINT8       segment;                // segment from the override prefix
+	UINT8       mod;                    // mod field of the mod r/m byte
+	UINT8       reg;                    // reg field of the mod r/m byte
+	UINT8       rm;                     // r/m field of the mod r/m byte
+	INT8        base;                   // base register of a memory operand, or -1
+	INT8        index;                  // index register of a memory operand, or -1
+	UINT8       scale;                  // log2 of the index scale
+	UINT32      disp;                   // displacement of a memory operand
+	UINT32      imm;                    // immediate or relative operand, sign-extended if applicable
+	UINT32      imm2;                   // second immediate (ENTER, far pointers)
+};
+
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+bool i386_decode_insn(const UINT8 *oprom, int avail, i386_insn &insn);
+
+
+#endif /* __I386FE_H__ */
@@ -10,6 +10,9 @@
 
 #include "softfloat/milieu.h"
 #include "softfloat/softfloat.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
+#include "cpu/drcuml.h"
 
 
 /* MMU constants */
@@ -19,6 +22,15 @@
 #define M68K_IC_SIZE 128
 
 
+/* use the interpreter even when the recompiler is enabled (68020 and 68030 variants only) */
+#define MCFG_M68K_FORCE_INTERPRETER() \
+	m68000_base_device::set_force_interpreter(*device);
+
+/* use the recompiler whenever -drc is on, without needing -drc_m68k */
+#define MCFG_M68K_ALLOW_RECOMPILER() \
+	m68000_base_device::set_allow_recompiler(*device);
+
+
 
 
 #define m68ki_check_address_error(m68k, ADDR, WRITE_MODE, FC) \
@@ -116,6 +128,9 @@ enum
 unsigned int m68k_disassemble_raw(char* str_buff, unsigned int pc, const unsigned char* opdata, const unsigned char* argdata, unsigned int cpu_type);
 
 class m68000_base_device;
+class m68k_frontend;
+struct m68k_insn;
+struct m68k_operand;
 
 
 extern const device_type M68K;
@@ -179,6 +194,10 @@ public:
 	void set_instruction_hook(read32_delegate ihook);
 	void set_buserror_details(UINT32 fault_addr, UINT8 rw, UINT8 fc);
 
+	// static configuration helpers
+	static void set_force_interpreter(device_t &device) { downcast<m68000_base_device &>(device).m_isdrc = false; }
+	static void set_allow_recompiler(device_t &device) { downcast<m68000_base_device &>(device).m_isdrc = (device.mconfig().options().drc() && !device.mconfig().m_force_no_drc) ? true : false; }
+
 public:
 
 
@@ -368,6 +387,49 @@ public:
 	read32_delegate instruction_hook;
 
 
+	// Data that needs to be stored close to the generated DRC code
+	struct internal_m68k_state
+	{
+		UINT32  dar[16];            // data and address registers
+		UINT32  pc;                 // program counter
+		UINT32  ccr;                // X N Z V C, laid out as in the status register
+		UINT32  mode;               // block mode being executed
+		UINT32  irqcheck;           // nonzero to leave compiled code after an interpreted instruction
+		UINT32  arg0;               // parameters to C helpers
+		UINT32  arg1;
+		UINT32  fault;              // set if a bus error was signalled during an access
+		int     icount;
+	};
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           mode;                       /* block mode */
+		uml::code_label labelnum;                   /* index for local labels */
+		UINT8           pending[2];                 /* address registers updated by the current instruction, or 0xff */
+	};
+
+	bool m_isdrc;                                   /* recompiler requested by the configuration */
+	bool m_drc_running;                             /* true while compiled code is executing */
+	int  m_drc_table;                               /* opcode table index for the front-end */
+
+	std::unique_ptr<drc_cache>         m_cache;                  /* pointer to the DRC code cache */
+	std::unique_ptr<drcuml_state>      m_drcuml;                 /* DRC UML generator state */
+	std::unique_ptr<m68k_frontend>     m_drcfe;                  /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_persistent_cache> m_drcpersist;          /* persisted list of compiled blocks */
+	internal_m68k_state *m_m68k_state;
+	UINT8               m_cache_dirty;                /* true if we need to flush the cache */
+
+	/* subroutines */
+	uml::code_handle *  m_entry;                      /* entry point */
+	uml::code_handle *  m_nocode;                     /* nocode */
+	uml::code_handle *  m_out_of_cycles;              /* out of cycles exception handler */
+	uml::code_handle *  m_fault;                      /* bus error handler */
+	uml::code_handle *  m_read[3];                    /* read byte/word/long */
+	uml::code_handle *  m_write[3];                   /* write byte/word/long */
+
+
 
 	void init_cpu_common(void);
 	void init_cpu_m68000(void);
@@ -391,8 +453,55 @@ public:
 	void m68ki_exception_interrupt(m68000_base_device *m68k, UINT32 int_level);
 
 	void reset_cpu(void);
+	bool process_address_error();
+	bool execute_enter();
+	inline void execute_one();
 	inline void cpu_execute(void);
 
+	void drc_init(int table);
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	UINT8 drc_mode() const;
+	bool drc_can_run() const;
+	void drc_state_load();
+	void drc_state_store();
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_fault_handler();
+	void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle **handleptr);
+	void log_add_disasm_comment(drcuml_block *block, UINT32 pc, const UINT16 *words);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	uml::parameter generate_areg(compiler_state *compiler, int regnum);
+	uml::parameter generate_pending(drcuml_block *block, compiler_state *compiler, int regnum);
+	void generate_ea(drcuml_block *block, compiler_state *compiler, const m68k_operand &op, int size);
+	void generate_load(drcuml_block *block, compiler_state *compiler, const m68k_operand &op, int size, uml::parameter dst);
+	void generate_store(drcuml_block *block, compiler_state *compiler, const m68k_operand &op, int size, uml::parameter src);
+	void generate_commit(drcuml_block *block, compiler_state *compiler);
+	void generate_read(drcuml_block *block, int size, uml::parameter address, uml::parameter dst);
+	void generate_write(drcuml_block *block, int size, uml::parameter address, uml::parameter src);
+	void generate_logic_flags(drcuml_block *block, int size, uml::parameter value);
+	void generate_arith_flags(drcuml_block *block, bool setx);
+	uml::condition_t generate_condition(drcuml_block *block, int cond);
+	void generate_idle_check(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, bool dynamic);
+	void generate_push(drcuml_block *block, uml::parameter value);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int extracycles);
+	void generate_conditional_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int cond, int extracycles);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	int generate_alu(drcuml_block *block, compiler_state *compiler, const m68k_insn &insn);
+	int generate_movem(drcuml_block *block, compiler_state *compiler, const m68k_insn &insn);
+
+	void func_interpret();
+	void func_read16();
+	void func_read32();
+	void func_write16();
+	void func_write32();
+
 	// device_state_interface overrides
 	virtual void state_import(const device_state_entry &entry) override;
 	virtual void state_export(const device_state_entry &entry) override;
@@ -404,6 +513,25 @@ public:
 
 
 
+class m68k_frontend : public drc_frontend
+{
+public:
+	m68k_frontend(m68000_base_device *m68k, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	bool describe_interpreted(opcode_desc &desc);
+	void describe_operand(opcode_desc &desc, const m68k_operand &op, int size, bool read, bool write);
+	void describe_condition(opcode_desc &desc, int cond);
+	bool describe_insn(opcode_desc &desc, const m68k_insn &insn);
+
+	m68000_base_device *m_m68k;
+};
+
+
+
 class m68000_device : public m68000_base_device
 {
 public:
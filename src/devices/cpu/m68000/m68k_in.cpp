@@ -92,9 +92,26 @@ M68KMAKE_PROTOTYPE_HEADER
 XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 M68KMAKE_PROTOTYPE_FOOTER
 
+#define NUM_CPU_TYPES 7
+
+/* This is used to generate the opcode handler jump table */
+struct opcode_handler_struct
+{
+	void (*opcode_handler)(m68000_base_device *m68k);        /* handler function */
+	unsigned int  mask;                  /* mask on opcode */
+	unsigned int  match;                 /* what to match after masking */
+	unsigned short family;               /* instruction family (M68KOP_xxx) */
+	unsigned char size;                  /* operation size in bits, 0 if unsized */
+	unsigned char ea;                    /* specified EA mode (M68KEA_xxx) */
+	unsigned char cycles[NUM_CPU_TYPES]; /* cycles each cpu type takes */
+};
+
 /* Build the opcode handler table */
 void m68ki_build_opcode_table(void);
 
+/* Find the table entry that handles an opcode (nullptr if illegal) */
+const opcode_handler_struct *m68ki_get_opcode_entry(int cpu_type_index, UINT16 opcode);
+
 extern void (*m68ki_instruction_jump_table[][0x10000])(m68000_base_device *m68k); /* opcode handler jump table */
 extern unsigned char m68ki_cycles[][0x10000];
 
@@ -115,32 +132,22 @@ M68KMAKE_TABLE_HEADER
 
 #include "m68kops.h"
 
-#define NUM_CPU_TYPES 7
-
 void (*m68ki_instruction_jump_table[NUM_CPU_TYPES][0x10000])(m68000_base_device *m68k); /* opcode handler jump table */
 unsigned char m68ki_cycles[NUM_CPU_TYPES][0x10000]; /* Cycles used by CPU type */
-
-/* This is used to generate the opcode handler jump table */
-struct opcode_handler_struct
-{
-	void (*opcode_handler)(m68000_base_device *m68k);        /* handler function */
-	unsigned int  mask;                  /* mask on opcode */
-	unsigned int  match;                 /* what to match after masking */
-	unsigned char cycles[NUM_CPU_TYPES]; /* cycles each cpu type takes */
-};
+static UINT16 m68ki_opcode_entry[NUM_CPU_TYPES][0x10000]; /* Table entry by CPU type, 0xffff if illegal */
 
 
 /* Opcode handler table */
 static const opcode_handler_struct m68k_opcode_handler_table[] =
 {
-/*   function                      mask    match    000  010  020  040 */
+/*   function                      mask    match   family             size  ea              000  010  020  040 */
 
 
 
 XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 M68KMAKE_TABLE_FOOTER
 
-	{nullptr, 0, 0, {0, 0, 0, 0, 0}}
+	{nullptr, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0}}
 };
 
 
@@ -152,9 +159,16 @@ static void m68ki_set_one(unsigned short opcode, const opcode_handler_struct *s)
 		if(s->cycles[i] != 0xff) {
 			m68ki_cycles[i][opcode] = s->cycles[i];
 			m68ki_instruction_jump_table[i][opcode] = s->opcode_handler;
+			m68ki_opcode_entry[i][opcode] = s - m68k_opcode_handler_table;
 		}
 }
 
+const opcode_handler_struct *m68ki_get_opcode_entry(int cpu_type_index, UINT16 opcode)
+{
+	UINT16 index = m68ki_opcode_entry[cpu_type_index][opcode];
+	return (index != 0xffff) ? &m68k_opcode_handler_table[index] : nullptr;
+}
+
 void m68ki_build_opcode_table(void)
 {
 	const opcode_handler_struct *ostruct;
@@ -169,6 +183,7 @@ void m68ki_build_opcode_table(void)
 		{
 			m68ki_instruction_jump_table[k][i] = m68000_base_device_ops::m68k_op_illegal;
 			m68ki_cycles[k][i] = 0;
+			m68ki_opcode_entry[k][i] = 0xffff;
 		}
 	}
 
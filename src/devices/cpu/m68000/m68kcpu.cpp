@@ -28,6 +28,7 @@ static const char copyright_notice[] =
 #include "debugger.h"
 #include "m68kcpu.h"
 #include "m68kops.h"
+#include "m68kfe.h"
 
 #include "m68kfpu.inc"
 #include "m68kmmu.h"
@@ -36,6 +37,21 @@ extern void m68040_fpu_op0(m68000_base_device *m68k);
 extern void m68040_fpu_op1(m68000_base_device *m68k);
 extern void m68881_mmu_ops(m68000_base_device *m68k);
 
+/* ======================================================================== */
+/* =============================== CONSTANTS ============================== */
+/* ======================================================================== */
+
+/* size of the execution code cache */
+#define CACHE_SIZE                  (32 * 1024 * 1024)
+
+/* version of the persisted block list */
+#define DRC_PERSIST_VERSION         1
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES     128
+#define COMPILE_FORWARDS_BYTES      512
+#define COMPILE_MAX_SEQUENCE        64
+
 /* ======================================================================== */
 /* ================================= DATA ================================= */
 /* ======================================================================== */
@@ -780,172 +796,194 @@ bool m68000_base_device::memory_translate(address_spacenum space, int intention,
 
 
 
-inline void m68000_base_device::cpu_execute(void)
+/* process a pending address error; returns false if the CPU ended up stopped */
+bool m68000_base_device::process_address_error()
 {
-	initial_cycles = remaining_cycles;
+	while (m_address_error == 1)
+	{
+		m_address_error = 0;
+		try {
+			m68ki_exception_address_error(this);
+		}
+		catch(int error)
+		{
+			if (error==10)
+			{
+				m_address_error = 1;
+				REG_PPC(this) = REG_PC(this);
+				continue;
+			}
+			else
+				throw;
+		}
+		if(stopped)
+		{
+			if (remaining_cycles > 0)
+				remaining_cycles = 0;
+			return false;
+		}
+	}
+	return true;
+}
 
+/* get ready to run a timeslice; returns false if there is nothing to execute */
+bool m68000_base_device::execute_enter()
+{
 	/* eat up any reset cycles */
 	if (reset_cycles) {
 		int rc = reset_cycles;
 		reset_cycles = 0;
 		remaining_cycles -= rc;
 
-		if (remaining_cycles <= 0) return;
+		if (remaining_cycles <= 0) return false;
 	}
 
 	/* See if interrupts came in */
 	m68ki_check_interrupts(this);
 
 	/* Make sure we're not stopped */
-	if(!stopped)
+	if(stopped)
 	{
-		/* Return point if we had an address error */
-		check_address_error:
-		if (m_address_error==1)
-		{
-			m_address_error = 0;
-			try {
-				m68ki_exception_address_error(this);
-			}
-			catch(int error)
-			{
-				if (error==10)
-				{
-					m_address_error = 1;
-					REG_PPC(this) = REG_PC(this);
-					goto check_address_error;
-				}
-				else
-					throw;
-			}
-			if(stopped)
-			{
-				if (remaining_cycles > 0)
-					remaining_cycles = 0;
-				return;
-			}
-		}
+		if (remaining_cycles > 0)
+			remaining_cycles = 0;
+		return false;
+	}
 
+	/* Take any address error left over from the last timeslice */
+	return process_address_error();
+}
 
-		/* Main loop.  Keep going until we run out of clock cycles */
-		while (remaining_cycles > 0)
-		{
-			/* Set tracing accodring to T1. (T0 is done inside instruction) */
-			m68ki_trace_t1(this); /* auto-disable (see m68kcpu.h) */
+/* execute a single instruction; an address error is left pending in m_address_error */
+inline void m68000_base_device::execute_one()
+{
+	/* Set tracing accodring to T1. (T0 is done inside instruction) */
+	m68ki_trace_t1(this); /* auto-disable (see m68kcpu.h) */
 
-			/* Call external hook to peek at CPU */
-			debugger_instruction_hook(this, REG_PC(this));
+	/* Call external hook to peek at CPU */
+	debugger_instruction_hook(this, REG_PC(this));
 
-			/* call external instruction hook (independent of debug mode) */
-			if (!instruction_hook.isnull())
-				instruction_hook(*program, REG_PC(this), 0xffffffff);
+	/* call external instruction hook (independent of debug mode) */
+	if (!instruction_hook.isnull())
+		instruction_hook(*program, REG_PC(this), 0xffffffff);
 
-			/* Record previous program counter */
-			REG_PPC(this) = REG_PC(this);
+	/* Record previous program counter */
+	REG_PPC(this) = REG_PC(this);
 
-			try
-			{
-			if (!pmmu_enabled)
-			{
-				run_mode = RUN_MODE_NORMAL;
-				/* Read an instruction and call its handler */
-				ir = m68ki_read_imm_16(this);
-				jump_table[ir](this);
-				remaining_cycles -= cyc_instruction[ir];
-			}
-			else
-			{
-				run_mode = RUN_MODE_NORMAL;
-				// save CPU address registers values at start of instruction
-				int i;
-				UINT32 tmp_dar[16];
+	try
+	{
 
-				for (i = 15; i >= 0; i--)
-				{
-					tmp_dar[i] = REG_DA(this)[i];
-				}
+	if (!pmmu_enabled)
+	{
+		run_mode = RUN_MODE_NORMAL;
+		/* Read an instruction and call its handler */
+		ir = m68ki_read_imm_16(this);
+		jump_table[ir](this);
+		remaining_cycles -= cyc_instruction[ir];
+	}
+	else
+	{
+		run_mode = RUN_MODE_NORMAL;
+		// save CPU address registers values at start of instruction
+		int i;
+		UINT32 tmp_dar[16];
+
+		for (i = 15; i >= 0; i--)
+		{
+			tmp_dar[i] = REG_DA(this)[i];
+		}
 
-				mmu_tmp_buserror_occurred = 0;
+		mmu_tmp_buserror_occurred = 0;
 
-				/* Read an instruction and call its handler */
-				ir = m68ki_read_imm_16(this);
+		/* Read an instruction and call its handler */
+		ir = m68ki_read_imm_16(this);
 
-				if (!mmu_tmp_buserror_occurred)
-				{
-					jump_table[ir](this);
-					remaining_cycles -= cyc_instruction[ir];
-				}
+		if (!mmu_tmp_buserror_occurred)
+		{
+			jump_table[ir](this);
+			remaining_cycles -= cyc_instruction[ir];
+		}
 
-				if (mmu_tmp_buserror_occurred)
-				{
-					UINT32 sr;
+		if (mmu_tmp_buserror_occurred)
+		{
+			UINT32 sr;
 
-					mmu_tmp_buserror_occurred = 0;
+			mmu_tmp_buserror_occurred = 0;
 
-					// restore cpu address registers to value at start of instruction
-					for (i = 15; i >= 0; i--)
-					{
-						if (REG_DA(this)[i] != tmp_dar[i])
-						{
+			// restore cpu address registers to value at start of instruction
+			for (i = 15; i >= 0; i--)
+			{
+				if (REG_DA(this)[i] != tmp_dar[i])
+				{
 //                          logerror("PMMU: pc=%08x sp=%08x bus error: fixed %s[%d]: %08x -> %08x\n",
 //                                  REG_PPC(this), REG_A(this)[7], i < 8 ? "D" : "A", i & 7, REG_DA(this)[i], tmp_dar[i]);
-							REG_DA(this)[i] = tmp_dar[i];
-						}
-					}
-
-					sr = m68ki_init_exception(this);
-
-					run_mode = RUN_MODE_BERR_AERR_RESET;
-
-					if (!CPU_TYPE_IS_020_PLUS(cpu_type))
-					{
-						/* Note: This is implemented for 68000 only! */
-						m68ki_stack_frame_buserr(this, sr);
-					}
-					else if(!CPU_TYPE_IS_040_PLUS(cpu_type)) {
-						if (mmu_tmp_buserror_address == REG_PPC(this))
-						{
-							m68ki_stack_frame_1010(this, sr, EXCEPTION_BUS_ERROR, REG_PPC(this), mmu_tmp_buserror_address);
-						}
-						else
-						{
-							m68ki_stack_frame_1011(this, sr, EXCEPTION_BUS_ERROR, REG_PPC(this), mmu_tmp_buserror_address);
-						}
-					}
-					else
-					{
-						m68ki_stack_frame_0111(this, sr, EXCEPTION_BUS_ERROR, REG_PPC(this), mmu_tmp_buserror_address, true);
-					}
-
-					m68ki_jump_vector(this, EXCEPTION_BUS_ERROR);
-
-					// TODO:
-					/* Use up some clock cycles and undo the instruction's cycles */
-					// remaining_cycles -= cyc_exception[EXCEPTION_BUS_ERROR] - cyc_instruction[ir];
+					REG_DA(this)[i] = tmp_dar[i];
 				}
 			}
-			}
-			catch (int error)
+
+			sr = m68ki_init_exception(this);
+
+			run_mode = RUN_MODE_BERR_AERR_RESET;
+
+			if (!CPU_TYPE_IS_020_PLUS(cpu_type))
 			{
-				if (error==10)
+				/* Note: This is implemented for 68000 only! */
+				m68ki_stack_frame_buserr(this, sr);
+			}
+			else if(!CPU_TYPE_IS_040_PLUS(cpu_type)) {
+				if (mmu_tmp_buserror_address == REG_PPC(this))
 				{
-					m_address_error = 1;
-					goto check_address_error;
+					m68ki_stack_frame_1010(this, sr, EXCEPTION_BUS_ERROR, REG_PPC(this), mmu_tmp_buserror_address);
 				}
 				else
-					throw;
+				{
+					m68ki_stack_frame_1011(this, sr, EXCEPTION_BUS_ERROR, REG_PPC(this), mmu_tmp_buserror_address);
+				}
+			}
+			else
+			{
+				m68ki_stack_frame_0111(this, sr, EXCEPTION_BUS_ERROR, REG_PPC(this), mmu_tmp_buserror_address, true);
 			}
 
+			m68ki_jump_vector(this, EXCEPTION_BUS_ERROR);
 
-			/* Trace m68k_exception, if necessary */
-			m68ki_exception_if_trace(this); /* auto-disable (see m68kcpu.h) */
+			// TODO:
+			/* Use up some clock cycles and undo the instruction's cycles */
+			// remaining_cycles -= cyc_exception[EXCEPTION_BUS_ERROR] - cyc_instruction[ir];
+		}
+	}
+	}
+	catch (int error)
+	{
+		if (error==10)
+		{
+			m_address_error = 1;
+			return;
 		}
+		else
+			throw;
+	}
+
+	/* Trace m68k_exception, if necessary */
+	m68ki_exception_if_trace(this); /* auto-disable (see m68kcpu.h) */
+}
+
+inline void m68000_base_device::cpu_execute(void)
+{
+	initial_cycles = remaining_cycles;
+
+	if (!execute_enter())
+		return;
 
-		/* set previous PC to current PC for the next entry into the loop */
-		REG_PPC(this) = REG_PC(this);
+	/* Main loop.  Keep going until we run out of clock cycles */
+	while (remaining_cycles > 0)
+	{
+		execute_one();
+		if (m_address_error == 1 && !process_address_error())
+			return;
 	}
-	else if (remaining_cycles > 0)
-		remaining_cycles = 0;
+
+	/* set previous PC to current PC for the next entry into the loop */
+	REG_PPC(this) = REG_PC(this);
 }
 
 
@@ -1033,6 +1071,45 @@ void m68000_base_device::init_cpu_common(void)
 
 }
 
+/* set up the recompiler for the 68020 and 68030 variants; table is their opcode table index */
+void m68000_base_device::drc_init(int table)
+{
+	if (!m_isdrc)
+		return;
+	m_drc_table = table;
+
+	/* allocate the cache and the state that compiled code accesses directly */
+	m_cache = std::make_unique<drc_cache>(CACHE_SIZE + sizeof(internal_m68k_state));
+	m_m68k_state = (internal_m68k_state *)m_cache->alloc_near(sizeof(internal_m68k_state));
+	memset(m_m68k_state, 0, sizeof(internal_m68k_state));
+
+	/* initialize the UML generator; one mode each for user and supervisor code */
+	UINT32 flags = 0;
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_cache, flags, 2, 32, 1);
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_m68k_state->pc, sizeof(m_m68k_state->pc), "pc");
+	m_drcuml->symbol_add(&m_m68k_state->icount, sizeof(m_m68k_state->icount), "icount");
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "%c%d", (regnum < 8) ? 'd' : 'a', regnum & 7);
+		m_drcuml->symbol_add(&m_m68k_state->dar[regnum], sizeof(m_m68k_state->dar[regnum]), buf);
+	}
+	m_drcuml->symbol_add(&m_m68k_state->ccr, sizeof(m_m68k_state->ccr), "ccr");
+
+	/* initialize the front-end helper */
+	m_drcfe = std::make_unique<m68k_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	/* initialize the persisted block list */
+	m_drcpersist = std::make_unique<drc_persistent_cache>(*this, *m_drcuml, *m_drcfe, DRC_PERSIST_VERSION, drc_persistent_cache::compile_delegate(FUNC(m68000_base_device::code_compile_block), this));
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
+
+	m_icountptr = &m_m68k_state->icount;
+}
+
 void m68000_base_device::reset_cpu(void)
 {
 	/* Disable the PMMU/HMMU on reset, if any */
@@ -1881,6 +1958,8 @@ void m68000_base_device::init_cpu_m68020(void)
 	cyc_shift        = 0;
 	cyc_reset        = 518;
 
+	drc_init(2);
+
 	define_state();
 }
 
@@ -1940,6 +2019,8 @@ void m68000_base_device::init_cpu_m68ec020(void)
 	has_pmmu         = 0;
 	has_fpu          = 0;
 
+	drc_init(2);
+
 	define_state();
 }
 
@@ -1969,6 +2050,8 @@ void m68000_base_device::init_cpu_m68030(void)
 	has_pmmu         = 1;
 	has_fpu          = 1;
 
+	drc_init(3);
+
 	define_state();
 }
 
@@ -1999,6 +2082,8 @@ void m68000_base_device::init_cpu_m68ec030(void)
 	has_pmmu         = 0;     /* EC030 lacks the PMMU and is effectively a die-shrink 68020 */
 	has_fpu          = 1;
 
+	drc_init(3);
+
 	define_state();
 }
 
@@ -2302,6 +2387,7 @@ m68000_base_device::m68000_base_device(const machine_config &mconfig, const char
 		m_oprogram_config("decrypted_opcodes", ENDIANNESS_BIG, 16, 24)
 {
 	clear_all();
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_m68k() && !mconfig.m_force_no_drc) ? true : false;
 }
 
 
@@ -2314,6 +2400,7 @@ m68000_base_device::m68000_base_device(const machine_config &mconfig, const char
 		m_oprogram_config("decrypted_opcodes", ENDIANNESS_BIG, prg_data_width, prg_address_bits, 0, internal_map)
 {
 	clear_all();
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_m68k() && !mconfig.m_force_no_drc) ? true : false;
 }
 
 
@@ -2324,6 +2411,7 @@ m68000_base_device::m68000_base_device(const machine_config &mconfig, const char
 		m_oprogram_config("decrypted_opcodes", ENDIANNESS_BIG, prg_data_width, prg_address_bits)
 {
 	clear_all();
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_m68k() && !mconfig.m_force_no_drc) ? true : false;
 }
 
 void m68000_base_device::clear_all()
@@ -2451,11 +2539,28 @@ void m68000_base_device::clear_all()
 	}
 
 	internal = nullptr;
+
+	m_drc_running = false;
+	m_drc_table = 0;
+	m_m68k_state = nullptr;
+	m_cache_dirty = TRUE;
+	m_entry = nullptr;
+	m_nocode = nullptr;
+	m_out_of_cycles = nullptr;
+	m_fault = nullptr;
+	for (int i = 0; i < 3; i++)
+		m_read[i] = m_write[i] = nullptr;
 }
 
 
 void m68000_base_device::execute_run()
 {
+	if (m_drcuml != nullptr)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	cpu_execute();
 }
 
@@ -2465,11 +2570,14 @@ void m68000_base_device::device_start()
 
 void m68000_base_device::device_reset()
 {
+	m_cache_dirty = TRUE;
 	reset_cpu();
 }
 
 void m68000_base_device::device_stop()
 {
+	if (m_drcpersist != nullptr)
+		m_drcpersist->save();
 }
 
 
@@ -2495,7 +2603,11 @@ void m68000_base_device::execute_set_input(int inputnum, int state)
 		case M68K_LINE_BUSERROR:
 			if (state == ASSERT_LINE)
 			{
-				m68k_cause_bus_error(this);
+				/* compiled code abandons the instruction; the interpreter reruns it and takes the bus error */
+				if (m_drc_running)
+					m_m68k_state->fault = 1;
+				else
+					m68k_cause_bus_error(this);
 			}
 			break;
 	}
@@ -2775,3 +2887,5 @@ void mcf5206e_device::device_start()
 {
 	init_cpu_coldfire();
 }
+
+#include "m68kdrc.cpp"
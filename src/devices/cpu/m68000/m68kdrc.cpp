@@ -0,0 +1,1573 @@
+// license:BSD-3-Clause
+// copyright-holders:Karl Stenerud
+/***************************************************************************
+
+    m68kdrc.cpp
+    Universal machine language-based 68020/68030 emulator.
+
+    Only the integer core of the 68EC020, 68020, 68EC030 and 68030 is
+    compiled, and only while tracing and the MMUs are off.  Instructions
+    are identified through the interpreter's own opcode table, so
+    anything the front-end does not decode -- privileged and system
+    instructions, bit fields, multiply and divide, the extended
+    arithmetic forms, the FPU and full format index words -- is handed
+    to the interpreter one instruction at a time and keeps exactly its
+    existing behavior.  Reads through the PC go via the instruction
+    fetch path and are interpreted as well.
+
+    The CCR is kept as a single word in the near state, laid out as in
+    the status register.
+
+    A compiled instruction updates address registers only after its last
+    memory access, so a bus error can be handled by throwing away the
+    instruction and running it again in the interpreter, which then
+    takes the exception exactly as it always has.
+
+***************************************************************************/
+
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* map variables */
+#define MAPVAR_PC                   M0
+#define MAPVAR_CYCLES               M1
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES       0
+#define EXECUTE_MISSING_CODE        1
+#define EXECUTE_UNMAPPED_CODE       2
+#define EXECUTE_RESET_CACHE         3
+#define EXECUTE_INTERPRET           4
+
+/* block modes; supervisor code is kept apart because accesses carry a different function code */
+#define MODE_SUPERVISOR             1
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define DREG(reg)       mem(&m_m68k_state->dar[reg])
+#define AREG(reg)       mem(&m_m68k_state->dar[8 + (reg)])
+#define DAREG(reg)      mem(&m_m68k_state->dar[reg])
+#define CCR             mem(&m_m68k_state->ccr)
+
+#define SIZE_INDEX(size)    (((size) == 1) ? 0 : ((size) == 2) ? 1 : 2)
+#define SIZE_MASK(size)     (((size) == 1) ? 0xff : ((size) == 2) ? 0xffff : 0xffffffff)
+#define SIZE_SHIFT(size)    (32 - 8 * (size))
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void m68000_base_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == nullptr)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    drc_mode - return the block mode for the
+    current privilege state
+-------------------------------------------------*/
+
+UINT8 m68000_base_device::drc_mode() const
+{
+	return s_flag ? MODE_SUPERVISOR : 0;
+}
+
+
+/*-------------------------------------------------
+    drc_can_run - return true if the current
+    state can be run by compiled code
+-------------------------------------------------*/
+
+bool m68000_base_device::drc_can_run() const
+{
+	/* tracing, the MMUs and anything that watches every instruction need the interpreter */
+	if (t1_flag || t0_flag || stopped || pmmu_enabled || hmmu_enabled || m_address_error || !instruction_hook.isnull())
+		return false;
+
+	/* odd PCs raise address errors */
+	return (m_m68k_state->pc & 1) == 0;
+}
+
+
+/*-------------------------------------------------
+    drc_state_load - copy the interpreter state
+    into the near state used by compiled code
+-------------------------------------------------*/
+
+void m68000_base_device::drc_state_load()
+{
+	for (int regnum = 0; regnum < 16; regnum++)
+		m_m68k_state->dar[regnum] = REG_DA(this)[regnum];
+	m_m68k_state->pc = REG_PC(this);
+	m_m68k_state->ccr = m68ki_get_ccr(this);
+
+	/* compiled accesses don't set the function code, so leave it at what they would use */
+	mmu_tmp_fc = s_flag | FUNCTION_CODE_USER_DATA;
+}
+
+
+/*-------------------------------------------------
+    drc_state_store - copy the near state back
+    to the interpreter
+-------------------------------------------------*/
+
+void m68000_base_device::drc_state_store()
+{
+	for (int regnum = 0; regnum < 16; regnum++)
+		REG_DA(this)[regnum] = m_m68k_state->dar[regnum];
+	REG_PC(this) = m_m68k_state->pc;
+	m68ki_set_ccr(this, m_m68k_state->ccr);
+
+	/* the prefetched word may be stale after compiled code has run */
+	pref_addr = ~0;
+}
+
+
+/*-------------------------------------------------
+    cfunc_interpret - run a single instruction
+    in the interpreter
+-------------------------------------------------*/
+
+static void cfunc_interpret(void *param)
+{
+	((m68000_base_device *)param)->func_interpret();
+}
+
+void m68000_base_device::func_interpret()
+{
+	/* bus errors raised from here on are the interpreter's to take */
+	bool running = m_drc_running;
+	m_drc_running = false;
+
+	drc_state_store();
+	int cycles = remaining_cycles = m_m68k_state->icount;
+	execute_one();
+	if (m_address_error == 1)
+		process_address_error();
+	m_m68k_state->icount -= cycles - remaining_cycles;
+	drc_state_load();
+
+	m_drc_running = running;
+
+	/* leave compiled code if we ran out of cycles or the instruction changed anything it depends on */
+	m_m68k_state->irqcheck = (m_m68k_state->icount <= 0 || !drc_can_run() || drc_mode() != m_m68k_state->mode || m_cache_dirty) ? 1 : 0;
+}
+
+
+/*-------------------------------------------------
+    cfunc_readN/writeN - slow paths for
+    misaligned memory accesses
+-------------------------------------------------*/
+
+static void cfunc_read16(void *param)   { ((m68000_base_device *)param)->func_read16(); }
+static void cfunc_read32(void *param)   { ((m68000_base_device *)param)->func_read32(); }
+static void cfunc_write16(void *param)  { ((m68000_base_device *)param)->func_write16(); }
+static void cfunc_write32(void *param)  { ((m68000_base_device *)param)->func_write32(); }
+
+void m68000_base_device::func_read16()
+{
+	m_m68k_state->arg0 = m68ki_read_16(this, m_m68k_state->arg0);
+}
+
+void m68000_base_device::func_read32()
+{
+	m_m68k_state->arg0 = m68ki_read_32(this, m_m68k_state->arg0);
+}
+
+void m68000_base_device::func_write16()
+{
+	m68ki_write_16(this, m_m68k_state->arg0, m_m68k_state->arg1);
+}
+
+void m68000_base_device::func_write32()
+{
+	m68ki_write_32(this, m_m68k_state->arg0, m_m68k_state->arg1);
+}
+
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void m68000_base_device::code_flush_cache()
+{
+	static const char *const s_read_names[3] = { "read8", "read16", "read32" };
+	static const char *const s_write_names[3] = { "write8", "write16", "write32" };
+
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and exception handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_fault_handler();
+		static_generate_entry_point();
+
+		/* add subroutines for memory accesses */
+		for (int sizeindex = 0; sizeindex < 3; sizeindex++)
+		{
+			static_generate_memory_accessor(1 << sizeindex, FALSE, s_read_names[sizeindex], &m_read[sizeindex]);
+			static_generate_memory_accessor(1 << sizeindex, TRUE, s_write_names[sizeindex], &m_write[sizeindex]);
+		}
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate 68020 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - execute cycles using
+    recompiled code
+-------------------------------------------------*/
+
+void m68000_base_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+
+	/* reset cycles, interrupts and leftover address errors are taken as the interpreter takes them */
+	int cycles = remaining_cycles = m_m68k_state->icount;
+	initial_cycles = cycles;
+	bool run = execute_enter();
+	m_m68k_state->icount -= cycles - remaining_cycles;
+	if (!run)
+		return;
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+
+	/* execute */
+	drc_state_load();
+	while (m_m68k_state->icount > 0)
+	{
+		if (stopped)
+		{
+			m_m68k_state->icount = 0;
+			break;
+		}
+
+		/* the debugger and anything outside the compiled subset go through the interpreter */
+		if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0 || !drc_can_run())
+			func_interpret();
+		else
+		{
+			/* run as much as we can */
+			m_m68k_state->mode = drc_mode();
+			m_m68k_state->irqcheck = 0;
+			m_drc_running = true;
+			int execute_result = drcuml->execute(*m_entry);
+			m_drc_running = false;
+
+			/* if we need to recompile, do it */
+			if (execute_result == EXECUTE_MISSING_CODE)
+			{
+				code_compile_block(m_m68k_state->mode, m_m68k_state->pc);
+				m_drcpersist->block_missing(m_m68k_state->mode);
+			}
+			else if (execute_result == EXECUTE_INTERPRET)
+				func_interpret();
+			else if (execute_result == EXECUTE_RESET_CACHE)
+				code_flush_cache();
+		}
+
+		/* reset the cache if something invalidated it */
+		if (m_cache_dirty)
+			code_flush_cache();
+	}
+	drc_state_store();
+
+	/* set previous PC to current PC for the next entry into the loop */
+	REG_PPC(this) = REG_PC(this);
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void m68000_base_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	compiler_state compiler = { 0 };
+	compiler.mode = mode;
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	desclist = m_drcfe->describe_code(pc);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			block = drcuml->begin_block(8192);
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP) && m_ospace->get_write_ptr(seqhead->physpc) != nullptr)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                    // <subtract cycles>
+
+				/* if the next instruction isn't the start of the next sequence, jump there */
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* note where the code came from so that it can be invalidated */
+			for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+				block->add_source(curdesc->physpc, curdesc->length);
+
+			/* end the sequence */
+			block->end();
+			m_drcpersist->record(mode, desclist);
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void m68000_base_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, mem(&m_m68k_state->mode), mem(&m_m68k_state->pc), *m_nocode);
+																					// hashjmp <mode>,<pc>,nocode
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void m68000_base_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_m68k_state->pc), I0);                                     // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void m68000_base_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_m68k_state->pc), I0);                                     // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_fault_handler - generate a
+    handler for accesses that signal a bus error;
+    the instruction is abandoned and rerun by the
+    interpreter, which takes the exception
+-------------------------------------------------*/
+
+void m68000_base_device::static_generate_fault_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	alloc_handle(drcuml, &m_fault, "fault");
+	UML_HANDLE(block, *m_fault);                                                    // handle  fault
+	UML_MOV(block, mem(&m_m68k_state->fault), 0);                                   // mov     [fault],0
+	UML_RECOVER(block, I0, MAPVAR_PC);                                              // recover i0,PC
+	UML_MOV(block, mem(&m_m68k_state->pc), I0);                                     // mov     [pc],i0
+	UML_RECOVER(block, I1, MAPVAR_CYCLES);                                          // recover i1,CYCLES
+	UML_SUB(block, mem(&m_m68k_state->icount), mem(&m_m68k_state->icount), I1);     // sub     icount,icount,i1
+	UML_EXIT(block, EXECUTE_INTERPRET);                                             // exit    EXECUTE_INTERPRET
+
+	block->end();
+}
+
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor
+------------------------------------------------------------------*/
+
+void m68000_base_device::static_generate_memory_accessor(int size, int iswrite, const char *name, code_handle **handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I0-I1 */
+	static void (*const s_slow_path[2][3])(void *) =
+	{
+		{ nullptr, cfunc_read16, cfunc_read32 },
+		{ nullptr, cfunc_write16, cfunc_write32 }
+	};
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+	int slow = 1;
+
+	/* begin generating */
+	block = drcuml->begin_block(1024);
+
+	/* add a global entry for this */
+	alloc_handle(drcuml, handleptr, name);
+	UML_HANDLE(block, **handleptr);                                                 // handle  *handleptr
+
+	/* misaligned accesses are split up by the interpreter's handlers */
+	if (size > 1)
+	{
+		UML_TEST(block, I0, size - 1);                                              // test    i0,size-1
+		UML_JMPc(block, COND_NZ, slow);                                             // jnz     slow
+	}
+
+	if (!iswrite)
+		UML_READ(block, I0, I0, (size == 1) ? SIZE_BYTE : (size == 2) ? SIZE_WORD : SIZE_DWORD, SPACE_PROGRAM);
+																					// read    i0,i0,size,program
+	else
+		UML_WRITE(block, I0, I1, (size == 1) ? SIZE_BYTE : (size == 2) ? SIZE_WORD : SIZE_DWORD, SPACE_PROGRAM);
+																					// write   i0,i1,size,program
+
+	/* a handler may have signalled a bus error */
+	UML_CMP(block, mem(&m_m68k_state->fault), 0);                                   // cmp     [fault],0
+	UML_EXHc(block, COND_NE, *m_fault, 0);                                          // exne    fault,0
+	UML_RET(block);                                                                 // ret
+
+	/* slow path: let the interpreter's handlers do the work and catch any fault */
+	if (size > 1)
+	{
+		UML_LABEL(block, slow);                                                     // slow:
+		UML_MOV(block, mem(&m_m68k_state->arg0), I0);                               // mov     [arg0],i0
+		if (iswrite)
+			UML_MOV(block, mem(&m_m68k_state->arg1), I1);                           // mov     [arg1],i1
+		UML_CALLC(block, s_slow_path[iswrite ? 1 : 0][SIZE_INDEX(size)], this);     // callc   slow_path
+		UML_CMP(block, mem(&m_m68k_state->fault), 0);                               // cmp     [fault],0
+		UML_EXHc(block, COND_NE, *m_fault, 0);                                      // exne    fault,0
+		if (!iswrite)
+			UML_MOV(block, I0, mem(&m_m68k_state->arg0));                           // mov     i0,[arg0]
+		UML_RET(block);                                                             // ret
+	}
+
+	block->end();
+}
+
+
+
+/***************************************************************************
+    CODE LOGGING HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of a 68k instruction
+-------------------------------------------------*/
+
+void m68000_base_device::log_add_disasm_comment(drcuml_block *block, UINT32 pc, const UINT16 *words)
+{
+	if (m_drcuml->logging())
+	{
+		UINT8 bytes[16];
+		char buffer[256];
+		for (int word = 0; word < 8; word++)
+		{
+			bytes[2 * word + 0] = words[word] >> 8;
+			bytes[2 * word + 1] = words[word];
+		}
+		m68k_disassemble_raw(buffer, pc, bytes, bytes, (m_drc_table == 3) ? M68K_CPU_TYPE_68030 : M68K_CPU_TYPE_68020);
+		block->append_comment("%08X: %s", pc, buffer);                              // comment
+	}
+}
+
+
+
+/***************************************************************************
+    CODEGEN HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void m68000_base_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_SUB(block, mem(&m_m68k_state->icount), mem(&m_m68k_state->icount), compiler->cycles);
+																					// sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);                       // exh     out_of_cycles,param
+	}
+	compiler->cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void m68000_base_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* sum up the opcode words, skipping anything not in RAM */
+	UINT32 sum = 0;
+	bool first = true;
+	for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+		if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP) && !(curdesc->pc & 1))
+			for (int word = 0; word < curdesc->length / 2; word++)
+			{
+				offs_t address = curdesc->physpc + 2 * word;
+				if (m_ospace->get_write_ptr(address) == nullptr)
+					continue;
+				void *base = m_odirect->read_ptr(address, opcode_xor);
+				UML_LOAD(block, first ? I0 : I1, base, 0, SIZE_WORD, SCALE_x2);     // load    i1,base,word
+				if (!first)
+					UML_ADD(block, I0, I0, I1);                                     // add     i0,i0,i1
+				sum += curdesc->opptr.w[word];
+				first = false;
+			}
+
+	if (!first)
+	{
+		UML_CMP(block, I0, sum);                                                    // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate code to hand a
+    single instruction to the interpreter
+-------------------------------------------------*/
+
+void m68000_base_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	code_label skip = compiler->labelnum++;
+
+	/* the interpreter counts its own cycles */
+	generate_update_cycles(block, compiler, desc->pc, FALSE);                      // <subtract cycles>
+	UML_MOV(block, mem(&m_m68k_state->pc), desc->pc);                               // mov     [pc],desc->pc
+	UML_CALLC(block, cfunc_interpret, this);                                        // callc   interpret
+
+	/* leave if the state can no longer be run here */
+	UML_CMP(block, mem(&m_m68k_state->irqcheck), 0);                                // cmp     [irqcheck],0
+	UML_EXHc(block, COND_NE, *m_out_of_cycles, mem(&m_m68k_state->pc));             // exne    out_of_cycles,[pc]
+
+	/* continue here if it fell through, otherwise go wherever it went */
+	UML_CMP(block, mem(&m_m68k_state->pc), desc->pc + desc->length);                // cmp     [pc],nextpc
+	UML_JMPc(block, COND_E, skip);                                                  // je      skip
+	UML_HASHJMP(block, compiler->mode, mem(&m_m68k_state->pc), *m_nocode);          // hashjmp <mode>,[pc],nocode
+	UML_LABEL(block, skip);                                                         // skip:
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void m68000_base_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.w);
+
+	/* set the PC map variable, and the cycles spent before this instruction for faults */
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                         // mapvar  PC,desc->pc
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* instructions we don't compile go to the interpreter */
+	if (desc->flags & M68KOPFLAG_INTERPRET)
+		generate_interpret(block, compiler, desc);
+
+	/* otherwise, compile the instruction */
+	else
+	{
+		compiler->cycles += desc->cycles;
+		if (!generate_opcode(block, compiler, desc))
+			fatalerror("m68kdrc: unimplemented opcode at %08X\n", desc->pc);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_areg - return where the current
+    value of an address register lives; one
+    updated by this instruction is held in I7
+    or I8 until it is committed
+-------------------------------------------------*/
+
+uml::parameter m68000_base_device::generate_areg(compiler_state *compiler, int regnum)
+{
+	if (compiler->pending[0] == regnum)
+		return I7;
+	if (compiler->pending[1] == regnum)
+		return I8;
+	return AREG(regnum);
+}
+
+
+/*-------------------------------------------------
+    generate_pending - make an address register
+    pending, so that it can be updated before
+    the instruction's memory accesses are done
+-------------------------------------------------*/
+
+uml::parameter m68000_base_device::generate_pending(drcuml_block *block, compiler_state *compiler, int regnum)
+{
+	if (compiler->pending[0] == regnum)
+		return I7;
+	if (compiler->pending[1] == regnum)
+		return I8;
+
+	int slot = (compiler->pending[0] == 0xff) ? 0 : 1;
+	assert(compiler->pending[slot] == 0xff);
+	compiler->pending[slot] = regnum;
+	UML_MOV(block, slot ? I8 : I7, AREG(regnum));                                   // mov     slot,areg
+	return slot ? I8 : I7;
+}
+
+
+/*-------------------------------------------------
+    generate_commit - write back any address
+    registers updated by the instruction
+-------------------------------------------------*/
+
+void m68000_base_device::generate_commit(drcuml_block *block, compiler_state *compiler)
+{
+	for (int slot = 0; slot < 2; slot++)
+		if (compiler->pending[slot] != 0xff)
+		{
+			UML_MOV(block, AREG(compiler->pending[slot]), slot ? I8 : I7);          // mov     areg,slot
+			compiler->pending[slot] = 0xff;
+		}
+}
+
+
+/*-------------------------------------------------
+    generate_ea - generate code to compute the
+    effective address of a memory operand into I4
+-------------------------------------------------*/
+
+void m68000_base_device::generate_ea(drcuml_block *block, compiler_state *compiler, const m68k_operand &op, int size)
+{
+	/* byte accesses through A7 keep the stack word aligned */
+	int step = (size == 1 && op.reg == 7) ? 2 : size;
+
+	switch (op.mode)
+	{
+		case M68KEA_AI:
+			UML_MOV(block, I4, generate_areg(compiler, op.reg));                    // mov     i4,areg
+			break;
+
+		case M68KEA_DI:
+			UML_ADD(block, I4, generate_areg(compiler, op.reg), op.disp);           // add     i4,areg,disp
+			break;
+
+		case M68KEA_PI:
+		{
+			uml::parameter reg = generate_pending(block, compiler, op.reg);
+			UML_MOV(block, I4, reg);                                                // mov     i4,areg
+			UML_ADD(block, reg, reg, step);                                         // add     areg,areg,step
+			break;
+		}
+
+		case M68KEA_PD:
+		{
+			uml::parameter reg = generate_pending(block, compiler, op.reg);
+			UML_SUB(block, reg, reg, step);                                         // sub     areg,areg,step
+			UML_MOV(block, I4, reg);                                                // mov     i4,areg
+			break;
+		}
+
+		case M68KEA_IX:
+		case M68KEA_PCIX:
+		{
+			uml::parameter index = (op.index < 8) ? DREG(op.index) : generate_areg(compiler, op.index - 8);
+			if (op.indexlong)
+				UML_MOV(block, I4, index);                                          // mov     i4,index
+			else
+				UML_SEXT(block, I4, index, SIZE_WORD);                              // sext    i4,index,word
+			if (op.scale != 0)
+				UML_SHL(block, I4, I4, op.scale);                                   // shl     i4,i4,scale
+			if (op.mode == M68KEA_IX)
+				UML_ADD(block, I4, I4, generate_areg(compiler, op.reg));            // add     i4,i4,areg
+			if (op.disp != 0)
+				UML_ADD(block, I4, I4, op.disp);                                    // add     i4,i4,disp
+			break;
+		}
+
+		case M68KEA_AW:
+		case M68KEA_AL:
+		case M68KEA_PCDI:
+			UML_MOV(block, I4, op.disp);                                            // mov     i4,disp
+			break;
+
+		default:
+			fatalerror("m68kdrc: unexpected addressing mode %d\n", op.mode);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_read - read memory into dst through
+    the accessor of the given size
+-------------------------------------------------*/
+
+void m68000_base_device::generate_read(drcuml_block *block, int size, uml::parameter address, uml::parameter dst)
+{
+	UML_MOV(block, I0, address);                                                    // mov     i0,address
+	UML_CALLH(block, *m_read[SIZE_INDEX(size)]);                                    // callh   read
+	UML_MOV(block, dst, I0);                                                        // mov     dst,i0
+}
+
+
+/*-------------------------------------------------
+    generate_write - write src to memory through
+    the accessor of the given size
+-------------------------------------------------*/
+
+void m68000_base_device::generate_write(drcuml_block *block, int size, uml::parameter address, uml::parameter src)
+{
+	UML_MOV(block, I0, address);                                                    // mov     i0,address
+	UML_MOV(block, I1, src);                                                        // mov     i1,src
+	UML_CALLH(block, *m_write[SIZE_INDEX(size)]);                                   // callh   write
+}
+
+
+/*-------------------------------------------------
+    generate_load - load an operand of the given
+    size, zero-extended
+-------------------------------------------------*/
+
+void m68000_base_device::generate_load(drcuml_block *block, compiler_state *compiler, const m68k_operand &op, int size, uml::parameter dst)
+{
+	switch (op.mode)
+	{
+		case M68KEA_D:
+		case M68KEA_A:
+		{
+			uml::parameter reg = (op.mode == M68KEA_D) ? DREG(op.reg) : generate_areg(compiler, op.reg);
+			if (size == 4)
+				UML_MOV(block, dst, reg);                                           // mov     dst,reg
+			else
+				UML_AND(block, dst, reg, SIZE_MASK(size));                          // and     dst,reg,mask
+			break;
+		}
+
+		case M68KEA_I:
+			UML_MOV(block, dst, op.disp);                                           // mov     dst,imm
+			break;
+
+		default:
+			generate_ea(block, compiler, op, size);
+			generate_read(block, size, I4, dst);
+			break;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_store - store to an operand of the
+    given size; the address of a memory operand
+    must already be in I4
+-------------------------------------------------*/
+
+void m68000_base_device::generate_store(drcuml_block *block, compiler_state *compiler, const m68k_operand &op, int size, uml::parameter src)
+{
+	switch (op.mode)
+	{
+		case M68KEA_D:
+			if (size == 4)
+				UML_MOV(block, DREG(op.reg), src);                                  // mov     dreg,src
+			else
+				UML_ROLINS(block, DREG(op.reg), src, 0, SIZE_MASK(size));           // rolins  dreg,src,0,mask
+			break;
+
+		/* address registers are always written whole */
+		case M68KEA_A:
+			UML_MOV(block, generate_areg(compiler, op.reg), src);                   // mov     areg,src
+			break;
+
+		default:
+			generate_write(block, size, I4, src);
+			break;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_logic_flags - set N and Z from a
+    result of the given size and clear V and C
+-------------------------------------------------*/
+
+void m68000_base_device::generate_logic_flags(drcuml_block *block, int size, uml::parameter value)
+{
+	if (size == 4)
+		UML_TEST(block, value, 0xffffffff);                                         // test    value,0xffffffff
+	else
+		UML_SHL(block, I2, value, SIZE_SHIFT(size));                                // shl     i2,value,shift
+	UML_GETFLGS(block, I2, FLAG_Z | FLAG_S);                                        // getflgs i2,ZS
+	UML_ROLINS(block, CCR, I2, 0, 0x0f);                                            // rolins  ccr,i2,0,NZVC
+}
+
+
+/*-------------------------------------------------
+    generate_arith_flags - capture N, Z, V and C
+    from the last operation into I2, copying C
+    into X if requested; the caller inserts them
+    into the CCR once the result is stored
+-------------------------------------------------*/
+
+void m68000_base_device::generate_arith_flags(drcuml_block *block, bool setx)
+{
+	UML_GETFLGS(block, I2, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);                      // getflgs i2,CVZS
+	if (setx)
+		UML_ROLINS(block, I2, I2, 4, 0x10);                                         // rolins  i2,i2,4,X
+}
+
+
+/*-------------------------------------------------
+    generate_condition - generate code to test a
+    68k condition code other than T and F,
+    returning the UML condition that holds when
+    it is true
+-------------------------------------------------*/
+
+uml::condition_t m68000_base_device::generate_condition(drcuml_block *block, int cond)
+{
+	static const UINT8 s_masks[8] = { 0, 0x05, 0x01, 0x04, 0x02, 0x08, 0, 0 };
+
+	assert(cond >= 2 && cond < 16);
+	switch (cond >> 1)
+	{
+		/* GE/LT: N == V */
+		case 6:
+			UML_SHR(block, I2, CCR, 2);                                             // shr     i2,ccr,2
+			UML_XOR(block, I2, I2, CCR);                                            // xor     i2,i2,ccr
+			UML_TEST(block, I2, 0x02);                                              // test    i2,V
+			break;
+
+		/* GT/LE: N == V and Z clear */
+		case 7:
+			UML_SHR(block, I2, CCR, 2);                                             // shr     i2,ccr,2
+			UML_XOR(block, I2, I2, CCR);                                            // xor     i2,i2,ccr
+			UML_AND(block, I2, I2, 0x02);                                           // and     i2,i2,V
+			UML_ROLINS(block, I2, CCR, 0, 0x04);                                    // rolins  i2,ccr,0,Z
+			UML_TEST(block, I2, 0x06);                                              // test    i2,ZV
+			break;
+
+		default:
+			UML_TEST(block, CCR, s_masks[cond >> 1]);                               // test    ccr,mask
+			break;
+	}
+
+	/* the even codes are true when none of the tested bits are set */
+	return (cond & 1) ? COND_NZ : COND_Z;
+}
+
+
+/*-------------------------------------------------
+    generate_idle_check - give up the rest of
+    the timeslice on a jump to itself, as the
+    interpreter does; a dynamic target in I8 is
+    compared at run time
+-------------------------------------------------*/
+
+void m68000_base_device::generate_idle_check(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, bool dynamic)
+{
+	/* the interpreter checks the cycles left before this instruction's are taken */
+	INT32 before = compiler->cycles - desc->cycles;
+	code_label skip = compiler->labelnum++;
+
+	if (dynamic)
+	{
+		UML_CMP(block, I8, desc->pc);                                               // cmp     i8,desc->pc
+		UML_JMPc(block, COND_NE, skip);                                             // jne     skip
+	}
+	UML_CMP(block, mem(&m_m68k_state->icount), before);                             // cmp     icount,before
+	UML_MOVc(block, COND_G, mem(&m_m68k_state->icount), before);                    // mov     icount,before,g
+	UML_LABEL(block, skip);                                                         // skip:
+}
+
+
+/*-------------------------------------------------
+    generate_push - push a long onto the stack
+-------------------------------------------------*/
+
+void m68000_base_device::generate_push(drcuml_block *block, uml::parameter value)
+{
+	UML_SUB(block, I9, AREG(7), 4);                                                 // sub     i9,a7,4
+	generate_write(block, 4, I9, value);
+	UML_MOV(block, AREG(7), I9);                                                    // mov     a7,i9
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate code for a branch
+    to desc->targetpc, or to I8 if dynamic
+-------------------------------------------------*/
+
+void m68000_base_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int extracycles)
+{
+	compiler_state compiler_temp = *compiler;
+
+	/* conditional branches count the extra cycles only on the taken path */
+	compiler_temp.cycles += extracycles;
+	if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+	{
+		generate_update_cycles(block, &compiler_temp, I8, TRUE);                   // <subtract cycles>
+		UML_HASHJMP(block, compiler->mode, I8, *m_nocode);                          // hashjmp <mode>,i8,nocode
+	}
+	else
+	{
+		generate_update_cycles(block, &compiler_temp, desc->targetpc, TRUE);       // <subtract cycles>
+		if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+			UML_JMP(block, desc->targetpc | 0x80000000);                            // jmp     desc->targetpc | 0x80000000
+		else
+			UML_HASHJMP(block, compiler->mode, desc->targetpc, *m_nocode);          // hashjmp <mode>,desc->targetpc,nocode
+	}
+
+	/* unconditional branches end the sequence, so their cycles are spent */
+	compiler->labelnum = compiler_temp.labelnum;
+	if (desc->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		compiler->cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_conditional_branch - generate code
+    for a branch taken when a 68k condition
+    holds
+-------------------------------------------------*/
+
+void m68000_base_device::generate_conditional_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int cond, int extracycles)
+{
+	code_label skip = compiler->labelnum++;
+	uml::condition_t truecond = generate_condition(block, cond);
+
+	UML_JMPc(block, uml::condition_t(truecond ^ 1), skip);                          // jmp     skip,!cond
+	generate_branch(block, compiler, desc, extracycles);
+	UML_LABEL(block, skip);                                                         // skip:
+}
+
+
+
+/***************************************************************************
+    OPCODE CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a
+    specific opcode
+-------------------------------------------------*/
+
+int m68000_base_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	m68k_insn insn;
+	if (!m68k_decode_insn(desc->opptr.w, desc->length / 2, m_drc_table, desc->pc, insn))
+		return FALSE;
+
+	int size = insn.size;
+	compiler->pending[0] = compiler->pending[1] = 0xff;
+
+	switch (insn.family)
+	{
+		/* moves */
+		case M68KOP_MOVE_D:     case M68KOP_MOVE_AI:    case M68KOP_MOVE_PI:    case M68KOP_MOVE_PI7:
+		case M68KOP_MOVE_PD:    case M68KOP_MOVE_PD7:   case M68KOP_MOVE_DI:    case M68KOP_MOVE_IX:
+		case M68KOP_MOVE_AW:    case M68KOP_MOVE_AL:
+			generate_load(block, compiler, insn.src, size, I5);
+			if (insn.dst.mode != M68KEA_D)
+				generate_ea(block, compiler, insn.dst, size);
+
+			/* long moves to a predecremented address are written low word first */
+			if (insn.dst.mode == M68KEA_PD && size == 4)
+			{
+				UML_ADD(block, I9, I4, 2);                                          // add     i9,i4,2
+				generate_write(block, 2, I9, I5);
+				UML_SHR(block, I3, I5, 16);                                         // shr     i3,i5,16
+				generate_write(block, 2, I4, I3);
+			}
+			else
+				generate_store(block, compiler, insn.dst, size, I5);
+			generate_logic_flags(block, size, I5);
+			break;
+
+		case M68KOP_MOVEA:
+			generate_load(block, compiler, insn.src, size, I5);
+			if (size == 2)
+				UML_SEXT(block, I5, I5, SIZE_WORD);                                 // sext    i5,i5,word
+			generate_store(block, compiler, insn.dst, 4, I5);
+			break;
+
+		case M68KOP_MOVEQ:
+			UML_MOV(block, DREG(insn.dst.reg), insn.imm);                           // mov     dreg,imm
+			UML_AND(block, CCR, CCR, 0x10);                                         // and     ccr,ccr,X
+			if (insn.imm == 0)
+				UML_OR(block, CCR, CCR, 0x04);                                      // or      ccr,ccr,Z
+			else if (insn.imm & 0x80000000)
+				UML_OR(block, CCR, CCR, 0x08);                                      // or      ccr,ccr,N
+			break;
+
+		case M68KOP_LEA:
+			generate_ea(block, compiler, insn.src, 0);
+			UML_MOV(block, AREG(insn.dst.reg), I4);                                 // mov     areg,i4
+			break;
+
+		case M68KOP_PEA:
+			generate_ea(block, compiler, insn.src, 0);
+			generate_push(block, I4);
+			break;
+
+		case M68KOP_EXT:
+			if (size == 2)
+			{
+				UML_SEXT(block, I3, DREG(insn.dst.reg), SIZE_BYTE);                 // sext    i3,dreg,byte
+				UML_ROLINS(block, DREG(insn.dst.reg), I3, 0, 0xffff);               // rolins  dreg,i3,0,0xffff
+			}
+			else
+			{
+				UML_SEXT(block, I3, DREG(insn.dst.reg), SIZE_WORD);                 // sext    i3,dreg,word
+				UML_MOV(block, DREG(insn.dst.reg), I3);                             // mov     dreg,i3
+			}
+			generate_logic_flags(block, size, I3);
+			break;
+
+		case M68KOP_EXTB:
+			UML_SEXT(block, I3, DREG(insn.dst.reg), SIZE_BYTE);                     // sext    i3,dreg,byte
+			UML_MOV(block, DREG(insn.dst.reg), I3);                                 // mov     dreg,i3
+			generate_logic_flags(block, 4, I3);
+			break;
+
+		case M68KOP_SWAP:
+			UML_ROL(block, I3, DREG(insn.dst.reg), 16);                             // rol     i3,dreg,16
+			UML_MOV(block, DREG(insn.dst.reg), I3);                                 // mov     dreg,i3
+			generate_logic_flags(block, 4, I3);
+			break;
+
+		/* shifts by an immediate count; C and X get the last bit shifted out */
+		case M68KOP_LSL_S:
+			if (size == 4)
+				UML_MOV(block, I3, DREG(insn.dst.reg));                             // mov     i3,dreg
+			else
+				UML_SHL(block, I3, DREG(insn.dst.reg), SIZE_SHIFT(size));           // shl     i3,dreg,shift
+			UML_SHL(block, I3, I3, insn.imm);                                       // shl     i3,i3,count
+			UML_GETFLGS(block, I2, FLAG_C | FLAG_Z | FLAG_S);                       // getflgs i2,CZS
+			if (size != 4)
+				UML_SHR(block, I3, I3, SIZE_SHIFT(size));                           // shr     i3,i3,shift
+			generate_store(block, compiler, insn.dst, size, I3);
+			UML_ROLINS(block, I2, I2, 4, 0x10);                                     // rolins  i2,i2,4,X
+			UML_ROLINS(block, CCR, I2, 0, 0x1f);                                    // rolins  ccr,i2,0,XNZVC
+			break;
+
+		case M68KOP_LSR_S:
+			generate_load(block, compiler, insn.dst, size, I3);
+			UML_SHR(block, I3, I3, insn.imm);                                       // shr     i3,i3,count
+			UML_GETFLGS(block, I2, FLAG_C | FLAG_Z | FLAG_S);                       // getflgs i2,CZS
+			generate_store(block, compiler, insn.dst, size, I3);
+			UML_ROLINS(block, I2, I2, 4, 0x10);                                     // rolins  i2,i2,4,X
+			UML_ROLINS(block, CCR, I2, 0, 0x1f);                                    // rolins  ccr,i2,0,XNZVC
+			break;
+
+		case M68KOP_ASR_S:
+			if (size == 4)
+				UML_MOV(block, I3, DREG(insn.dst.reg));                             // mov     i3,dreg
+			else
+				UML_SEXT(block, I3, DREG(insn.dst.reg), (size == 1) ? SIZE_BYTE : SIZE_WORD);
+																					// sext    i3,dreg,size
+			UML_SAR(block, I3, I3, insn.imm);                                       // sar     i3,i3,count
+			UML_GETFLGS(block, I2, FLAG_C | FLAG_Z | FLAG_S);                       // getflgs i2,CZS
+			generate_store(block, compiler, insn.dst, size, I3);
+			UML_ROLINS(block, I2, I2, 4, 0x10);                                     // rolins  i2,i2,4,X
+			UML_ROLINS(block, CCR, I2, 0, 0x1f);                                    // rolins  ccr,i2,0,XNZVC
+			break;
+
+		/* set according to condition */
+		case M68KOP_ST:
+		case M68KOP_SF:
+			if (insn.dst.mode == M68KEA_D)
+			{
+				if (insn.family == M68KOP_ST)
+					UML_OR(block, DREG(insn.dst.reg), DREG(insn.dst.reg), 0xff);    // or      dreg,dreg,0xff
+				else
+					UML_AND(block, DREG(insn.dst.reg), DREG(insn.dst.reg), 0xffffff00);
+																					// and     dreg,dreg,0xffffff00
+			}
+			else
+			{
+				generate_ea(block, compiler, insn.dst, 1);
+				generate_write(block, 1, I4, (insn.family == M68KOP_ST) ? 0xff : 0x00);
+			}
+			break;
+
+		case M68KOP_SCC:
+			if (insn.dst.mode == M68KEA_D)
+			{
+				/* the register form takes longer when the condition holds */
+				code_label notset = compiler->labelnum++;
+				code_label done = compiler->labelnum++;
+				uml::condition_t truecond = generate_condition(block, insn.cond);
+				UML_JMPc(block, uml::condition_t(truecond ^ 1), notset);            // jmp     notset,!cond
+				UML_OR(block, DREG(insn.dst.reg), DREG(insn.dst.reg), 0xff);        // or      dreg,dreg,0xff
+				if (cyc_scc_r_true != 0)
+					UML_SUB(block, mem(&m_m68k_state->icount), mem(&m_m68k_state->icount), cyc_scc_r_true);
+																					// sub     icount,icount,scc_r_true
+				UML_JMP(block, done);                                               // jmp     done
+				UML_LABEL(block, notset);                                           // notset:
+				UML_AND(block, DREG(insn.dst.reg), DREG(insn.dst.reg), 0xffffff00); // and     dreg,dreg,0xffffff00
+				UML_LABEL(block, done);                                             // done:
+			}
+			else
+			{
+				uml::condition_t truecond = generate_condition(block, insn.cond);
+				UML_SETc(block, truecond, I3);                                      // set     i3,cond
+				UML_SUB(block, I3, 0, I3);                                          // sub     i3,0,i3
+				generate_ea(block, compiler, insn.dst, 1);
+				generate_write(block, 1, I4, I3);
+			}
+			break;
+
+		/* branches */
+		case M68KOP_BRA:
+			if (desc->targetpc == desc->pc)
+				generate_idle_check(block, compiler, desc, false);
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		case M68KOP_BSR:
+			generate_push(block, desc->pc + desc->length);
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		/* the not taken cost depends on the displacement size */
+		case M68KOP_BCC:
+			generate_conditional_branch(block, compiler, desc, insn.cond, 0);
+			compiler->cycles += (size == 1) ? cyc_bcc_notake_b : (size == 2) ? cyc_bcc_notake_w : 0;
+			return TRUE;
+
+		case M68KOP_DBT:
+			return TRUE;
+
+		case M68KOP_DBF:
+		case M68KOP_DBCC:
+		{
+			code_label skip = compiler->labelnum++;
+			code_label expired = compiler->labelnum++;
+			int reg = insn.dst.reg;
+
+			if (insn.family == M68KOP_DBCC)
+			{
+				uml::condition_t truecond = generate_condition(block, insn.cond);
+				UML_JMPc(block, truecond, skip);                                    // jmp     skip,cond
+			}
+			UML_SUB(block, I3, DREG(reg), 1);                                       // sub     i3,dreg,1
+			UML_ROLINS(block, DREG(reg), I3, 0, 0xffff);                            // rolins  dreg,i3,0,0xffff
+			UML_AND(block, I3, I3, 0xffff);                                         // and     i3,i3,0xffff
+			UML_CMP(block, I3, 0xffff);                                             // cmp     i3,0xffff
+			UML_JMPc(block, COND_E, expired);                                       // je      expired
+			generate_branch(block, compiler, desc, cyc_dbcc_f_noexp);
+			UML_LABEL(block, expired);                                              // expired:
+			if (cyc_dbcc_f_exp != 0)
+				UML_SUB(block, mem(&m_m68k_state->icount), mem(&m_m68k_state->icount), cyc_dbcc_f_exp);
+																					// sub     icount,icount,dbcc_f_exp
+			UML_LABEL(block, skip);                                                 // skip:
+			return TRUE;
+		}
+
+		case M68KOP_JMP:
+			if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+			{
+				generate_ea(block, compiler, insn.src, 0);
+				UML_MOV(block, I8, I4);                                             // mov     i8,i4
+				generate_idle_check(block, compiler, desc, true);
+			}
+			else if (desc->targetpc == desc->pc)
+				generate_idle_check(block, compiler, desc, false);
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		case M68KOP_JSR:
+			if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+			{
+				generate_ea(block, compiler, insn.src, 0);
+				UML_MOV(block, I8, I4);                                             // mov     i8,i4
+			}
+			generate_push(block, desc->pc + desc->length);
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		case M68KOP_RTS:
+			generate_read(block, 4, AREG(7), I8);
+			UML_ADD(block, AREG(7), AREG(7), 4);                                    // add     a7,a7,4
+			generate_branch(block, compiler, desc, 0);
+			return TRUE;
+
+		/* stack frames */
+		case M68KOP_LINK:
+			UML_SUB(block, I9, AREG(7), 4);                                         // sub     i9,a7,4
+			generate_write(block, 4, I9, (insn.dst.reg == 7) ? I9 : AREG(insn.dst.reg));
+			if (insn.dst.reg != 7)
+				UML_MOV(block, AREG(insn.dst.reg), I9);                             // mov     areg,i9
+			UML_ADD(block, AREG(7), I9, insn.imm);                                  // add     a7,i9,disp
+			break;
+
+		case M68KOP_UNLK:
+			generate_read(block, 4, AREG(insn.dst.reg), I3);
+			if (insn.dst.reg != 7)
+				UML_ADD(block, AREG(7), AREG(insn.dst.reg), 4);                     // add     a7,areg,4
+			UML_MOV(block, AREG(insn.dst.reg), I3);                                 // mov     areg,i3
+			break;
+
+		case M68KOP_MOVEM_RE:
+		case M68KOP_MOVEM_ER:
+			generate_movem(block, compiler, insn);
+			break;
+
+		case M68KOP_NOP:
+			break;
+
+		default:
+			if (!generate_alu(block, compiler, insn))
+				return FALSE;
+			break;
+	}
+
+	generate_commit(block, compiler);
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    generate_alu - generate code for the
+    arithmetic and logical instructions
+-------------------------------------------------*/
+
+int m68000_base_device::generate_alu(drcuml_block *block, compiler_state *compiler, const m68k_insn &insn)
+{
+	int size = insn.size;
+	int shift = SIZE_SHIFT(size);
+
+	switch (insn.family)
+	{
+		/* arithmetic is done at the top of the register so that the host flags match the operand size */
+		case M68KOP_ADD_ER:     case M68KOP_ADD_RE:     case M68KOP_ADDI:
+		case M68KOP_SUB_ER:     case M68KOP_SUB_RE:     case M68KOP_SUBI:
+		case M68KOP_ADDQ:       case M68KOP_SUBQ:
+		case M68KOP_CMP:        case M68KOP_CMPI:
+		{
+			bool add = (insn.family == M68KOP_ADD_ER || insn.family == M68KOP_ADD_RE || insn.family == M68KOP_ADDI || insn.family == M68KOP_ADDQ);
+			bool cmp = (insn.family == M68KOP_CMP || insn.family == M68KOP_CMPI);
+
+			/* quick forms on an address register work on all of it and leave the flags alone */
+			if (insn.dst.mode == M68KEA_A)
+			{
+				uml::parameter reg = generate_areg(compiler, insn.dst.reg);
+				if (add)
+					UML_ADD(block, reg, reg, insn.src.disp);                        // add     areg,areg,imm
+				else
+					UML_SUB(block, reg, reg, insn.src.disp);                        // sub     areg,areg,imm
+				return TRUE;
+			}
+
+			generate_load(block, compiler, insn.src, size, I5);
+			generate_load(block, compiler, insn.dst, size, I6);
+			if (shift != 0)
+			{
+				UML_SHL(block, I5, I5, shift);                                      // shl     i5,i5,shift
+				UML_SHL(block, I6, I6, shift);                                      // shl     i6,i6,shift
+			}
+			if (add)
+				UML_ADD(block, I3, I6, I5);                                         // add     i3,i6,i5
+			else
+				UML_SUB(block, I3, I6, I5);                                         // sub     i3,i6,i5
+			generate_arith_flags(block, !cmp);
+			if (!cmp)
+			{
+				if (shift != 0)
+					UML_SHR(block, I3, I3, shift);                                  // shr     i3,i3,shift
+				generate_store(block, compiler, insn.dst, size, I3);
+			}
+			UML_ROLINS(block, CCR, I2, 0, cmp ? 0x0f : 0x1f);                       // rolins  ccr,i2,0,mask
+			return TRUE;
+		}
+
+		case M68KOP_NEG:
+			generate_load(block, compiler, insn.dst, size, I6);
+			if (shift != 0)
+				UML_SHL(block, I6, I6, shift);                                      // shl     i6,i6,shift
+			UML_SUB(block, I3, 0, I6);                                              // sub     i3,0,i6
+			generate_arith_flags(block, true);
+			if (shift != 0)
+				UML_SHR(block, I3, I3, shift);                                      // shr     i3,i3,shift
+			generate_store(block, compiler, insn.dst, size, I3);
+			UML_ROLINS(block, CCR, I2, 0, 0x1f);                                    // rolins  ccr,i2,0,XNZVC
+			return TRUE;
+
+		/* the address register forms use a sign-extended source and leave the flags alone, except CMPA */
+		case M68KOP_ADDA:
+		case M68KOP_SUBA:
+		case M68KOP_CMPA:
+		{
+			uml::parameter reg = generate_areg(compiler, insn.dst.reg);
+			generate_load(block, compiler, insn.src, size, I5);
+			if (size == 2)
+				UML_SEXT(block, I5, I5, SIZE_WORD);                                 // sext    i5,i5,word
+			if (insn.family == M68KOP_ADDA)
+				UML_ADD(block, reg, reg, I5);                                       // add     areg,areg,i5
+			else if (insn.family == M68KOP_SUBA)
+				UML_SUB(block, reg, reg, I5);                                       // sub     areg,areg,i5
+			else
+			{
+				UML_SUB(block, I3, reg, I5);                                        // sub     i3,areg,i5
+				generate_arith_flags(block, false);
+				UML_ROLINS(block, CCR, I2, 0, 0x0f);                                // rolins  ccr,i2,0,NZVC
+			}
+			return TRUE;
+		}
+
+		case M68KOP_AND_ER:     case M68KOP_AND_RE:     case M68KOP_ANDI:
+		case M68KOP_OR_ER:      case M68KOP_OR_RE:      case M68KOP_ORI:
+		case M68KOP_EOR:        case M68KOP_EORI:
+			generate_load(block, compiler, insn.src, size, I5);
+			generate_load(block, compiler, insn.dst, size, I6);
+			if (insn.family == M68KOP_AND_ER || insn.family == M68KOP_AND_RE || insn.family == M68KOP_ANDI)
+				UML_AND(block, I3, I6, I5);                                         // and     i3,i6,i5
+			else if (insn.family == M68KOP_OR_ER || insn.family == M68KOP_OR_RE || insn.family == M68KOP_ORI)
+				UML_OR(block, I3, I6, I5);                                          // or      i3,i6,i5
+			else
+				UML_XOR(block, I3, I6, I5);                                         // xor     i3,i6,i5
+			generate_store(block, compiler, insn.dst, size, I3);
+			generate_logic_flags(block, size, I3);
+			return TRUE;
+
+		case M68KOP_NOT:
+			generate_load(block, compiler, insn.dst, size, I6);
+			UML_XOR(block, I3, I6, SIZE_MASK(size));                                // xor     i3,i6,mask
+			generate_store(block, compiler, insn.dst, size, I3);
+			generate_logic_flags(block, size, I3);
+			return TRUE;
+
+		/* CLR only writes its operand */
+		case M68KOP_CLR:
+			if (insn.dst.mode != M68KEA_D)
+				generate_ea(block, compiler, insn.dst, size);
+			generate_store(block, compiler, insn.dst, size, 0);
+			UML_AND(block, CCR, CCR, 0x10);                                         // and     ccr,ccr,X
+			UML_OR(block, CCR, CCR, 0x04);                                          // or      ccr,ccr,Z
+			return TRUE;
+
+		case M68KOP_TST:
+			generate_load(block, compiler, insn.src, size, I5);
+			generate_logic_flags(block, size, I5);
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    generate_movem - generate code for MOVEM;
+    the base register is only written once all
+    of the registers have been moved
+-------------------------------------------------*/
+
+int m68000_base_device::generate_movem(drcuml_block *block, compiler_state *compiler, const m68k_insn &insn)
+{
+	int size = insn.size;
+
+	/* registers to a predecremented address go from A7 down to D0 */
+	if (insn.family == M68KOP_MOVEM_RE && insn.dst.mode == M68KEA_PD)
+	{
+		UML_MOV(block, I9, AREG(insn.dst.reg));                                     // mov     i9,areg
+		for (int i = 0; i < 16; i++)
+			if (insn.reglist & (1 << i))
+			{
+				UML_SUB(block, I9, I9, size);                                       // sub     i9,i9,size
+				if (size == 2)
+					generate_write(block, 2, I9, DAREG(15 - i));
+				else
+				{
+					UML_ADD(block, I3, I9, 2);                                      // add     i3,i9,2
+					generate_write(block, 2, I3, DAREG(15 - i));
+					UML_SHR(block, I3, DAREG(15 - i), 16);                          // shr     i3,reg,16
+					generate_write(block, 2, I9, I3);
+				}
+			}
+		UML_MOV(block, AREG(insn.dst.reg), I9);                                     // mov     areg,i9
+		return TRUE;
+	}
+
+	/* everything else goes from D0 up to A7 */
+	const m68k_operand &op = (insn.family == M68KOP_MOVEM_RE) ? insn.dst : insn.src;
+	if (op.mode == M68KEA_PI)
+		UML_MOV(block, I9, AREG(op.reg));                                           // mov     i9,areg
+	else
+	{
+		generate_ea(block, compiler, op, size);
+		UML_MOV(block, I9, I4);                                                     // mov     i9,i4
+	}
+
+	for (int i = 0; i < 16; i++)
+		if (insn.reglist & (1 << i))
+		{
+			if (insn.family == M68KOP_MOVEM_RE)
+				generate_write(block, size, I9, DAREG(i));
+			else
+			{
+				generate_read(block, size, I9, I3);
+				if (size == 2)
+					UML_SEXT(block, DAREG(i), I3, SIZE_WORD);                       // sext    reg,i3,word
+				else
+					UML_MOV(block, DAREG(i), I3);                                   // mov     reg,i3
+			}
+			UML_ADD(block, I9, I9, size);                                           // add     i9,i9,size
+		}
+
+	if (op.mode == M68KEA_PI)
+		UML_MOV(block, AREG(op.reg), I9);                                           // mov     areg,i9
+	return TRUE;
+}
@@ -0,0 +1,739 @@
+// license:BSD-3-Clause
+// copyright-holders:Karl Stenerud
+/***************************************************************************
+
+    m68kfe.cpp
+
+    Front-end for the 68020/68030 recompiler
+
+    Instructions are identified through the same handler table the
+    interpreter dispatches from, so the family, size and addressing
+    mode of every opcode come straight from m68kmake.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "m68kcpu.h"
+#include "m68kops.h"
+#include "m68kfe.h"
+
+
+//**************************************************************************
+//  INSTRUCTION DECODER
+//**************************************************************************
+
+//-------------------------------------------------
+//  fetch_word - fetch the next extension word,
+//  failing if it runs past the available words
+//-------------------------------------------------
+
+static inline bool fetch_word(const UINT16 *words, int avail, int &pos, UINT32 &result)
+{
+	if (pos >= avail)
+		return false;
+	result = words[pos++];
+	return true;
+}
+
+
+//-------------------------------------------------
+//  fetch_long - fetch a 32-bit extension
+//-------------------------------------------------
+
+static inline bool fetch_long(const UINT16 *words, int avail, int &pos, UINT32 &result)
+{
+	UINT32 hi, lo;
+	if (!fetch_word(words, avail, pos, hi) || !fetch_word(words, avail, pos, lo))
+		return false;
+	result = (hi << 16) | lo;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reglist_count - return the number of
+//  registers in a MOVEM register list
+//-------------------------------------------------
+
+static inline int reglist_count(UINT16 reglist)
+{
+	int count = 0;
+	for ( ; reglist != 0; reglist &= reglist - 1)
+		count++;
+	return count;
+}
+
+
+//-------------------------------------------------
+//  decode_ea - decode an addressing mode and its
+//  extension words; only the brief index format
+//  is handled
+//-------------------------------------------------
+
+static bool decode_ea(const UINT16 *words, int avail, int &pos, offs_t pc, int mode, int reg, int size, m68k_operand &op)
+{
+	UINT32 ext;
+
+	memset(&op, 0, sizeof(op));
+	op.index = -1;
+	op.reg = reg;
+
+	switch (mode)
+	{
+		case M68KEA_D:
+		case M68KEA_A:
+		case M68KEA_AI:
+		case M68KEA_PI:
+		case M68KEA_PD:
+			op.mode = mode;
+			return true;
+
+		// the A7 variants only exist so the byte forms can step by two
+		case M68KEA_A7:
+			op.mode = M68KEA_A;
+			op.reg = 7;
+			return true;
+
+		case M68KEA_PI7:
+			op.mode = M68KEA_PI;
+			op.reg = 7;
+			return true;
+
+		case M68KEA_PD7:
+			op.mode = M68KEA_PD;
+			op.reg = 7;
+			return true;
+
+		case M68KEA_DI:
+		case M68KEA_AW:
+			if (!fetch_word(words, avail, pos, ext))
+				return false;
+			op.mode = mode;
+			op.disp = (INT16)ext;
+			return true;
+
+		case M68KEA_AL:
+			op.mode = mode;
+			return fetch_long(words, avail, pos, op.disp);
+
+		// PC-relative modes are relative to the extension word
+		case M68KEA_PCDI:
+			op.mode = mode;
+			op.disp = pc + 2 * pos;
+			if (!fetch_word(words, avail, pos, ext))
+				return false;
+			op.disp += (INT16)ext;
+			return true;
+
+		case M68KEA_IX:
+		case M68KEA_PCIX:
+			op.mode = mode;
+			op.disp = (mode == M68KEA_PCIX) ? (pc + 2 * pos) : 0;
+			if (!fetch_word(words, avail, pos, ext))
+				return false;
+			if (ext & 0x100)
+				return false;
+			op.index = ext >> 12;
+			op.indexlong = (ext >> 11) & 1;
+			op.scale = (ext >> 9) & 3;
+			op.disp += (INT8)ext;
+			return true;
+
+		case M68KEA_I:
+			op.mode = mode;
+			if (size == 4)
+				return fetch_long(words, avail, pos, op.disp);
+			if (!fetch_word(words, avail, pos, op.disp))
+				return false;
+			if (size == 1)
+				op.disp &= 0xff;
+			return true;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  m68k_decode_insn - decode the operands and
+//  length of a single instruction of the given
+//  CPU table; returns false for anything the
+//  recompiler doesn't handle
+//-------------------------------------------------
+
+bool m68k_decode_insn(const UINT16 *words, int avail, int table, offs_t pc, m68k_insn &insn)
+{
+	memset(&insn, 0, sizeof(insn));
+	insn.src.index = insn.dst.index = -1;
+	if (avail < 1)
+		return false;
+
+	const opcode_handler_struct *entry = m68ki_get_opcode_entry(table, words[0]);
+	if (entry == nullptr)
+		return false;
+
+	UINT16 op = words[0];
+	int rx = (op >> 9) & 7;
+	int ry = op & 7;
+	int size = entry->size / 8;
+	int pos = 1;
+	UINT32 value;
+
+	insn.opcode = op;
+	insn.family = entry->family;
+	insn.size = size;
+	insn.cond = (op >> 8) & 15;
+
+	switch (entry->family)
+	{
+		// moves; the source extension words come first
+		case M68KOP_MOVE_D:     case M68KOP_MOVE_AI:    case M68KOP_MOVE_PI:    case M68KOP_MOVE_PI7:
+		case M68KOP_MOVE_PD:    case M68KOP_MOVE_PD7:   case M68KOP_MOVE_DI:    case M68KOP_MOVE_IX:
+		case M68KOP_MOVE_AW:    case M68KOP_MOVE_AL:
+		{
+			static const UINT8 s_dstmode[] = { M68KEA_D, M68KEA_AI, M68KEA_PI, M68KEA_PI7, M68KEA_PD, M68KEA_PD7, M68KEA_DI, M68KEA_IX, M68KEA_AW, M68KEA_AL };
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.src))
+				return false;
+			if (!decode_ea(words, avail, pos, pc, s_dstmode[entry->family - M68KOP_MOVE_D], rx, size, insn.dst))
+				return false;
+			break;
+		}
+
+		case M68KOP_MOVEA:
+		case M68KOP_LEA:
+		case M68KOP_ADDA:
+		case M68KOP_SUBA:
+		case M68KOP_CMPA:
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.src))
+				return false;
+			decode_ea(words, avail, pos, pc, M68KEA_A, rx, 4, insn.dst);
+			break;
+
+		case M68KOP_MOVEQ:
+			insn.imm = (INT8)op;
+			decode_ea(words, avail, pos, pc, M68KEA_D, rx, 4, insn.dst);
+			break;
+
+		// single operand, read only
+		case M68KOP_PEA:
+		case M68KOP_JMP:
+		case M68KOP_JSR:
+		case M68KOP_TST:
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.src))
+				return false;
+			break;
+
+		// single operand, written
+		case M68KOP_CLR:
+		case M68KOP_NOT:
+		case M68KOP_NEG:
+		case M68KOP_SCC:
+		case M68KOP_ST:
+		case M68KOP_SF:
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.dst))
+				return false;
+			break;
+
+		// data register only
+		case M68KOP_EXT:
+		case M68KOP_EXTB:
+		case M68KOP_SWAP:
+			decode_ea(words, avail, pos, pc, M68KEA_D, ry, size, insn.dst);
+			break;
+
+		case M68KOP_LSL_S:
+		case M68KOP_LSR_S:
+		case M68KOP_ASR_S:
+			insn.imm = ((rx - 1) & 7) + 1;
+			decode_ea(words, avail, pos, pc, M68KEA_D, ry, size, insn.dst);
+			break;
+
+		// <ea> to register
+		case M68KOP_ADD_ER:
+		case M68KOP_SUB_ER:
+		case M68KOP_AND_ER:
+		case M68KOP_OR_ER:
+		case M68KOP_CMP:
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.src))
+				return false;
+			decode_ea(words, avail, pos, pc, M68KEA_D, rx, size, insn.dst);
+			break;
+
+		// register to <ea>
+		case M68KOP_ADD_RE:
+		case M68KOP_SUB_RE:
+		case M68KOP_AND_RE:
+		case M68KOP_OR_RE:
+		case M68KOP_EOR:
+			decode_ea(words, avail, pos, pc, M68KEA_D, rx, size, insn.src);
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.dst))
+				return false;
+			break;
+
+		// immediate to <ea>; the immediate precedes the destination extension words
+		case M68KOP_ADDI:
+		case M68KOP_SUBI:
+		case M68KOP_ANDI:
+		case M68KOP_ORI:
+		case M68KOP_EORI:
+		case M68KOP_CMPI:
+			if (!decode_ea(words, avail, pos, pc, M68KEA_I, 0, size, insn.src))
+				return false;
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.dst))
+				return false;
+			break;
+
+		case M68KOP_ADDQ:
+		case M68KOP_SUBQ:
+			insn.src.mode = M68KEA_I;
+			insn.src.disp = ((rx - 1) & 7) + 1;
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, insn.dst))
+				return false;
+			break;
+
+		// branches; the displacement is relative to the word after the opcode
+		case M68KOP_BCC:
+		case M68KOP_BRA:
+		case M68KOP_BSR:
+			if (size == 1)
+				insn.imm = pc + 2 + (INT8)op;
+			else if (size == 2)
+			{
+				if (!fetch_word(words, avail, pos, value))
+					return false;
+				insn.imm = pc + 2 + (INT16)value;
+			}
+			else
+			{
+				if (!fetch_long(words, avail, pos, value))
+					return false;
+				insn.imm = pc + 2 + value;
+			}
+			break;
+
+		case M68KOP_DBT:
+		case M68KOP_DBF:
+		case M68KOP_DBCC:
+			if (!fetch_word(words, avail, pos, value))
+				return false;
+			insn.imm = pc + 2 + (INT16)value;
+			decode_ea(words, avail, pos, pc, M68KEA_D, ry, 2, insn.dst);
+			break;
+
+		case M68KOP_LINK:
+			if (size == 2 ? !fetch_word(words, avail, pos, value) : !fetch_long(words, avail, pos, value))
+				return false;
+			insn.imm = (size == 2) ? (INT16)value : value;
+			decode_ea(words, avail, pos, pc, M68KEA_A, ry, 4, insn.dst);
+			break;
+
+		case M68KOP_UNLK:
+			decode_ea(words, avail, pos, pc, M68KEA_A, ry, 4, insn.dst);
+			break;
+
+		// the register list precedes the address extension words
+		case M68KOP_MOVEM_RE:
+		case M68KOP_MOVEM_ER:
+			if (!fetch_word(words, avail, pos, value))
+				return false;
+			insn.reglist = value;
+			if (!decode_ea(words, avail, pos, pc, entry->ea, ry, size, (entry->family == M68KOP_MOVEM_RE) ? insn.dst : insn.src))
+				return false;
+			break;
+
+		case M68KOP_RTS:
+		case M68KOP_NOP:
+			break;
+
+		default:
+			return false;
+	}
+
+	insn.length = 2 * pos;
+	return true;
+}
+
+
+
+//**************************************************************************
+//  M68K FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  m68k_frontend - constructor
+//-------------------------------------------------
+
+m68k_frontend::m68k_frontend(m68000_base_device *m68k, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*m68k, window_start, window_end, max_sequence),
+		m_m68k(m68k)
+{
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool m68k_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	// odd PCs are left for the interpreter to deal with
+	desc.physpc = desc.pc;
+	if (desc.pc & 1)
+	{
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		desc.length = 2;
+		return describe_interpreted(desc);
+	}
+
+	// code running from anything but memory is left to the interpreter
+	address_space *space = m_m68k->m_ospace;
+	if (space->get_read_ptr(desc.pc) == nullptr)
+	{
+		desc.flags |= OPFLAG_COMPILER_UNMAPPED | OPFLAG_END_SEQUENCE;
+		desc.length = 2;
+		return describe_interpreted(desc);
+	}
+
+	// fetch up to 8 words, stopping at anything unmapped
+	int avail;
+	for (avail = 0; avail < 8; avail++)
+	{
+		offs_t address = desc.pc + 2 * avail;
+		if (avail != 0 && space->get_read_ptr(address) == nullptr)
+			break;
+		desc.opptr.w[avail] = m_m68k->m_odirect->read_word(address, m_m68k->opcode_xor);
+	}
+
+	// decode it; if that fails, let the disassembler size it for the interpreter
+	m68k_insn insn;
+	if (!m68k_decode_insn(desc.opptr.w, avail, m_m68k->m_drc_table, desc.pc, insn))
+	{
+		UINT8 bytes[16];
+		char buffer[256];
+		for (int word = 0; word < 8; word++)
+		{
+			bytes[2 * word + 0] = desc.opptr.w[word] >> 8;
+			bytes[2 * word + 1] = desc.opptr.w[word];
+		}
+		desc.length = m68k_disassemble_raw(buffer, desc.pc, bytes, bytes, (m_m68k->m_drc_table == 3) ? M68K_CPU_TYPE_68030 : M68K_CPU_TYPE_68020) & DASMFLAG_LENGTHMASK;
+		if (desc.length == 0 || desc.length > 2 * avail)
+		{
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			desc.length = 2;
+		}
+		return describe_interpreted(desc);
+	}
+	desc.length = insn.length;
+
+	// reads through the PC go via the instruction fetch path, which the interpreter owns
+	bool pcread = (insn.src.mode == M68KEA_PCDI || insn.src.mode == M68KEA_PCIX || insn.dst.mode == M68KEA_PCDI || insn.dst.mode == M68KEA_PCIX);
+	if (pcread && insn.family != M68KOP_LEA && insn.family != M68KOP_PEA && insn.family != M68KOP_JMP && insn.family != M68KOP_JSR)
+		return describe_interpreted(desc);
+
+	// MOVEM loading its own address or index register is defined by the interpreter
+	if (insn.family == M68KOP_MOVEM_ER && (insn.reglist & REGFLAG_A(insn.src.reg)))
+		return describe_interpreted(desc);
+	if (insn.family == M68KOP_MOVEM_ER && insn.src.index >= 0 && (insn.reglist & (1 << insn.src.index)))
+		return describe_interpreted(desc);
+
+	desc.cycles = m_m68k->cyc_instruction[insn.opcode];
+	return describe_insn(desc, insn);
+}
+
+
+//-------------------------------------------------
+//  describe_interpreted - describe an
+//  instruction that is handed to the interpreter
+//-------------------------------------------------
+
+bool m68k_frontend::describe_interpreted(opcode_desc &desc)
+{
+	// the interpreter may read or write anything, and charges its own cycles
+	desc.regin[0] |= REGFLAG_ALLREGS;
+	desc.regout[0] |= REGFLAG_ALLREGS;
+	desc.regin[1] |= REGFLAG_CCR;
+	desc.regout[1] |= REGFLAG_CCR;
+	desc.flags |= M68KOPFLAG_INTERPRET | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+	desc.cycles = 0;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  describe_operand - account for the registers
+//  and memory touched by an operand
+//-------------------------------------------------
+
+void m68k_frontend::describe_operand(opcode_desc &desc, const m68k_operand &op, int size, bool read, bool write)
+{
+	switch (op.mode)
+	{
+		case M68KEA_D:
+			// narrow writes keep the upper bits
+			if (read || size < 4)
+				desc.regin[0] |= REGFLAG_D(op.reg);
+			if (write)
+				desc.regout[0] |= REGFLAG_D(op.reg);
+			return;
+
+		case M68KEA_A:
+			if (read)
+				desc.regin[0] |= REGFLAG_A(op.reg);
+			if (write)
+				desc.regout[0] |= REGFLAG_A(op.reg);
+			return;
+
+		case M68KEA_AI:
+		case M68KEA_DI:
+		case M68KEA_IX:
+			desc.regin[0] |= REGFLAG_A(op.reg);
+			break;
+
+		case M68KEA_PI:
+		case M68KEA_PD:
+			desc.regin[0] |= REGFLAG_A(op.reg);
+			desc.regout[0] |= REGFLAG_A(op.reg);
+			break;
+
+		case M68KEA_I:
+		case M68KEA_NONE:
+			return;
+	}
+
+	// anything else touches memory, and a bus error may come back
+	if (op.index >= 0)
+		desc.regin[0] |= 1 << op.index;
+	if (read || write)
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+	if (read)
+		desc.flags |= OPFLAG_READS_MEMORY;
+	if (write)
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+}
+
+
+//-------------------------------------------------
+//  describe_condition - account for the flags
+//  read by a condition code
+//-------------------------------------------------
+
+void m68k_frontend::describe_condition(opcode_desc &desc, int cond)
+{
+	static const UINT8 s_condflags[16] =
+	{
+		0, 0,
+		REGFLAG_C | REGFLAG_Z, REGFLAG_C | REGFLAG_Z,
+		REGFLAG_C, REGFLAG_C,
+		REGFLAG_Z, REGFLAG_Z,
+		REGFLAG_V, REGFLAG_V,
+		REGFLAG_N, REGFLAG_N,
+		REGFLAG_N | REGFLAG_V, REGFLAG_N | REGFLAG_V,
+		REGFLAG_N | REGFLAG_V | REGFLAG_Z, REGFLAG_N | REGFLAG_V | REGFLAG_Z
+	};
+	desc.regin[1] |= s_condflags[cond];
+}
+
+
+//-------------------------------------------------
+//  describe_insn - describe a decoded
+//  instruction
+//-------------------------------------------------
+
+bool m68k_frontend::describe_insn(opcode_desc &desc, const m68k_insn &insn)
+{
+	int size = insn.size;
+
+	switch (insn.family)
+	{
+		case M68KOP_MOVE_D:     case M68KOP_MOVE_AI:    case M68KOP_MOVE_PI:    case M68KOP_MOVE_PI7:
+		case M68KOP_MOVE_PD:    case M68KOP_MOVE_PD7:   case M68KOP_MOVE_DI:    case M68KOP_MOVE_IX:
+		case M68KOP_MOVE_AW:    case M68KOP_MOVE_AL:
+			describe_operand(desc, insn.src, size, true, false);
+			describe_operand(desc, insn.dst, size, false, true);
+			desc.regout[1] |= REGFLAG_NZVC;
+			return true;
+
+		case M68KOP_MOVEA:
+			describe_operand(desc, insn.src, size, true, false);
+			describe_operand(desc, insn.dst, 4, false, true);
+			return true;
+
+		case M68KOP_MOVEQ:
+			describe_operand(desc, insn.dst, 4, false, true);
+			desc.regout[1] |= REGFLAG_NZVC;
+			return true;
+
+		case M68KOP_LEA:
+			describe_operand(desc, insn.src, 0, false, false);
+			describe_operand(desc, insn.dst, 4, false, true);
+			return true;
+
+		case M68KOP_PEA:
+			describe_operand(desc, insn.src, 0, false, false);
+			desc.regin[0] |= REGFLAG_A(7);
+			desc.regout[0] |= REGFLAG_A(7);
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case M68KOP_TST:
+			describe_operand(desc, insn.src, size, true, false);
+			desc.regout[1] |= REGFLAG_NZVC;
+			return true;
+
+		case M68KOP_CMP:
+		case M68KOP_CMPA:
+		case M68KOP_CMPI:
+			describe_operand(desc, insn.src, size, true, false);
+			describe_operand(desc, insn.dst, size, true, false);
+			desc.regout[1] |= REGFLAG_NZVC;
+			return true;
+
+		case M68KOP_CLR:
+			describe_operand(desc, insn.dst, size, false, true);
+			desc.regout[1] |= REGFLAG_NZVC;
+			return true;
+
+		case M68KOP_NOT:
+		case M68KOP_EXT:
+		case M68KOP_EXTB:
+		case M68KOP_SWAP:
+			describe_operand(desc, insn.dst, size, true, true);
+			desc.regout[1] |= REGFLAG_NZVC;
+			return true;
+
+		case M68KOP_NEG:
+			describe_operand(desc, insn.dst, size, true, true);
+			desc.regout[1] |= REGFLAG_CCR;
+			return true;
+
+		case M68KOP_LSL_S:
+		case M68KOP_LSR_S:
+		case M68KOP_ASR_S:
+			describe_operand(desc, insn.dst, size, true, true);
+			desc.regout[1] |= REGFLAG_CCR;
+			desc.cycles += insn.imm << m_m68k->cyc_shift;
+			return true;
+
+		case M68KOP_AND_ER:     case M68KOP_OR_ER:
+		case M68KOP_AND_RE:     case M68KOP_OR_RE:      case M68KOP_EOR:
+		case M68KOP_ANDI:       case M68KOP_ORI:        case M68KOP_EORI:
+			describe_operand(desc, insn.src, size, true, false);
+			describe_operand(desc, insn.dst, size, true, true);
+			desc.regout[1] |= REGFLAG_NZVC;
+			return true;
+
+		case M68KOP_ADD_ER:     case M68KOP_SUB_ER:
+		case M68KOP_ADD_RE:     case M68KOP_SUB_RE:
+		case M68KOP_ADDI:       case M68KOP_SUBI:
+			describe_operand(desc, insn.src, size, true, false);
+			describe_operand(desc, insn.dst, size, true, true);
+			desc.regout[1] |= REGFLAG_CCR;
+			return true;
+
+		// the address register forms leave the flags alone
+		case M68KOP_ADDA:
+		case M68KOP_SUBA:
+			describe_operand(desc, insn.src, size, true, false);
+			describe_operand(desc, insn.dst, 4, true, true);
+			return true;
+
+		case M68KOP_ADDQ:
+		case M68KOP_SUBQ:
+			describe_operand(desc, insn.dst, size, true, true);
+			if (insn.dst.mode != M68KEA_A)
+				desc.regout[1] |= REGFLAG_CCR;
+			return true;
+
+		case M68KOP_SCC:
+			describe_condition(desc, insn.cond);
+			// fall through
+		case M68KOP_ST:
+		case M68KOP_SF:
+			describe_operand(desc, insn.dst, 1, false, true);
+			return true;
+
+		case M68KOP_BRA:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = insn.imm;
+			return true;
+
+		case M68KOP_BSR:
+			desc.regin[0] |= REGFLAG_A(7);
+			desc.regout[0] |= REGFLAG_A(7);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_WRITES_MEMORY;
+			desc.targetpc = insn.imm;
+			return true;
+
+		case M68KOP_BCC:
+			describe_condition(desc, insn.cond);
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.targetpc = insn.imm;
+			return true;
+
+		// DBT never branches
+		case M68KOP_DBT:
+			return true;
+
+		case M68KOP_DBF:
+		case M68KOP_DBCC:
+			describe_condition(desc, insn.cond);
+			describe_operand(desc, insn.dst, 2, true, true);
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.targetpc = insn.imm;
+			return true;
+
+		// absolute and PC-relative targets are known now; the rest depend on registers
+		case M68KOP_JMP:
+		case M68KOP_JSR:
+			describe_operand(desc, insn.src, 0, false, false);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			if (insn.src.mode == M68KEA_AW || insn.src.mode == M68KEA_AL || insn.src.mode == M68KEA_PCDI)
+				desc.targetpc = insn.src.disp;
+			else
+				desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			if (insn.family == M68KOP_JSR)
+			{
+				desc.regin[0] |= REGFLAG_A(7);
+				desc.regout[0] |= REGFLAG_A(7);
+				desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_WRITES_MEMORY;
+			}
+			return true;
+
+		case M68KOP_RTS:
+			desc.regin[0] |= REGFLAG_A(7);
+			desc.regout[0] |= REGFLAG_A(7);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_READS_MEMORY;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			return true;
+
+		case M68KOP_LINK:
+			desc.regin[0] |= REGFLAG_A(7) | REGFLAG_A(insn.dst.reg);
+			desc.regout[0] |= REGFLAG_A(7) | REGFLAG_A(insn.dst.reg);
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case M68KOP_UNLK:
+			desc.regin[0] |= REGFLAG_A(7) | REGFLAG_A(insn.dst.reg);
+			desc.regout[0] |= REGFLAG_A(7) | REGFLAG_A(insn.dst.reg);
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_READS_MEMORY;
+			return true;
+
+		// each register moved costs a fixed amount on top of the base time
+		case M68KOP_MOVEM_RE:
+			describe_operand(desc, insn.dst, size, false, true);
+			desc.regin[0] |= (insn.dst.mode == M68KEA_PD) ? BITSWAP16(insn.reglist, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15) : insn.reglist;
+			desc.cycles += reglist_count(insn.reglist) << ((size == 2) ? m_m68k->cyc_movem_w : m_m68k->cyc_movem_l);
+			return true;
+
+		case M68KOP_MOVEM_ER:
+			describe_operand(desc, insn.src, size, true, false);
+			desc.regout[0] |= insn.reglist;
+			desc.cycles += reglist_count(insn.reglist) << ((size == 2) ? m_m68k->cyc_movem_w : m_m68k->cyc_movem_l);
+			return true;
+
+		case M68KOP_NOP:
+			return true;
+	}
+
+	return describe_interpreted(desc);
+}
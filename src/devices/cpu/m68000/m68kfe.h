@@ -0,0 +1,81 @@
+// license:BSD-3-Clause
+// copyright-holders:Karl Stenerud
+/***************************************************************************
+
+    m68kfe.h
+
+    Front-end for the 68020/68030 recompiler
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __M68KFE_H__
+#define __M68KFE_H__
+
+
+//**************************************************************************
+//  MACROS
+//**************************************************************************
+
+// register flags 0
+#define REGFLAG_D(n)                    (1 << (n))
+#define REGFLAG_A(n)                    (1 << (8 + (n)))
+#define REGFLAG_ALLREGS                 0x0000ffff
+
+// register flags 1, laid out as in the CCR
+#define REGFLAG_C                       (1 << 0)
+#define REGFLAG_V                       (1 << 1)
+#define REGFLAG_Z                       (1 << 2)
+#define REGFLAG_N                       (1 << 3)
+#define REGFLAG_X                       (1 << 4)
+#define REGFLAG_NZVC                    (REGFLAG_N | REGFLAG_Z | REGFLAG_V | REGFLAG_C)
+#define REGFLAG_CCR                     (REGFLAG_X | REGFLAG_NZVC)
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// opcode flags
+const UINT32 M68KOPFLAG_INTERPRET   = 0x80000000;   // instruction is handed to the interpreter
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// one operand of a decoded instruction
+struct m68k_operand
+{
+	UINT8       mode;                   // M68KEA_* addressing mode; PI7/PD7 are folded into PI/PD
+	UINT8       reg;                    // register number within the mode, 0-7
+	INT8        index;                  // index register (0-15) for M68KEA_IX/PCIX
+	UINT8       indexlong;              // index register is used as a long
+	UINT8       scale;                  // log2 of the index scale
+	UINT32      disp;                   // displacement, absolute address or immediate value; PC-relative modes hold the base address
+};
+
+// a single decoded instruction
+struct m68k_insn
+{
+	UINT16      opcode;                 // first opcode word
+	UINT16      family;                 // M68KOP_* family from the opcode table
+	UINT8       size;                   // operand size in bytes, or 0 if unsized
+	UINT8       length;                 // total length in bytes
+	UINT8       cond;                   // condition code field for Bcc/DBcc/Scc
+	UINT16      reglist;                // register list for MOVEM
+	UINT32      imm;                    // immediate value, shift count or branch target
+	m68k_operand src;                   // source operand
+	m68k_operand dst;                   // destination operand
+};
+
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+bool m68k_decode_insn(const UINT16 *words, int avail, int table, offs_t pc, m68k_insn &insn);
+
+
+#endif /* __M68KFE_H__ */
@@ -183,6 +183,7 @@ enum
 struct opcode_struct
 {
 	char name[MAX_NAME_LENGTH];           /* opcode handler name */
+	char family[MAX_NAME_LENGTH];         /* name and special processing, shared by all variants */
 	unsigned char size;                   /* Size of operation */
 	char spec_proc[MAX_SPEC_PROC_LENGTH]; /* Special processing mode */
 	char spec_ea[MAX_SPEC_EA_LENGTH];     /* Specified effective addressing mode */
@@ -243,6 +244,8 @@ static void add_opcode_output_table_entry(opcode_struct* op, char* name);
 static int DECL_SPEC compare_nof_true_bits(const void* aptr, const void* bptr);
 static void print_opcode_output_table(FILE* filep);
 static void write_table_entry(FILE* filep, opcode_struct* op);
+static void print_family_enum(FILE* filep);
+static void print_ea_enum(FILE* filep);
 static void set_opcode_struct(opcode_struct* src, opcode_struct* dst, int ea_mode);
 static void generate_opcode_handler(FILE* filep, body_struct* body, replace_struct* replace, opcode_struct* opinfo, int ea_mode);
 static void generate_opcode_ea_variants(FILE* filep, body_struct* body, replace_struct* replace, opcode_struct* op);
@@ -293,6 +296,14 @@ static const ea_info_struct g_ea_info_table[13] =
 };
 
 
+/* Specified EA modes as they appear in the table, in M68KEA_xxx order */
+static const char *const g_spec_ea_table[] =
+{
+	UNSPECIFIED, "d", "a", "ai", "pi", "pi7", "pd", "pd7", "di", "ix", "aw",
+	"al", "pcdi", "pcix", "i", "a7", "ax7", "ay7", "axy7", nullptr
+};
+
+
 static const char *const g_cc_table[16][2] =
 {
 	{ "t",  "T"}, /* 0000 */
@@ -840,10 +851,25 @@ static void print_opcode_output_table(FILE* filep)
 /* Write an entry in the opcode handler table */
 static void write_table_entry(FILE* filep, opcode_struct* op)
 {
+	char family[MAX_NAME_LENGTH+8];
+	char spec_ea[MAX_SPEC_EA_LENGTH+8];
 	int i;
 
-	fprintf(filep, "\t{%-28s, 0x%04x, 0x%04x, {",
-		op->name, op->op_mask, op->op_match);
+	sprintf(family, "M68KOP_%s", op->family);
+	for(i=0;family[i];i++)
+		family[i] = toupper((unsigned char)family[i]);
+
+	for(i=0;g_spec_ea_table[i] != nullptr;i++)
+		if(strcmp(op->spec_ea, g_spec_ea_table[i]) == 0)
+			break;
+	if(g_spec_ea_table[i] == nullptr)
+		error_exit("Unknown EA mode %s in %s", op->spec_ea, op->name);
+	sprintf(spec_ea, "M68KEA_%s", i == 0 ? "NONE" : op->spec_ea);
+	for(i=0;spec_ea[i];i++)
+		spec_ea[i] = toupper((unsigned char)spec_ea[i]);
+
+	fprintf(filep, "\t{%-28s, 0x%04x, 0x%04x, %-18s, %2d, %-13s, {",
+		op->name, op->op_mask, op->op_match, family, op->size, spec_ea);
 
 	for(i=0;i<NUM_CPUS;i++)
 	{
@@ -855,6 +881,49 @@ static void write_table_entry(FILE* filep, opcode_struct* op)
 	fprintf(filep, "}},\n");
 }
 
+/* Write an enum naming each instruction family in the input table */
+static void print_family_enum(FILE* filep)
+{
+	opcode_struct* op;
+	opcode_struct* prev;
+	int i;
+
+	fprintf(filep, "/* Instruction families, used by the recompiler to decode opcodes */\n");
+	fprintf(filep, "enum\n{\n");
+	for(op = g_opcode_input_table;op->name[0] != 0;op++)
+	{
+		for(prev = g_opcode_input_table;prev < op;prev++)
+			if(strcmp(prev->family, op->family) == 0)
+				break;
+		if(prev != op)
+			continue;
+
+		fprintf(filep, "\tM68KOP_");
+		for(i=0;op->family[i];i++)
+			fputc(toupper((unsigned char)op->family[i]), filep);
+		fprintf(filep, ",\n");
+	}
+	fprintf(filep, "\tM68KOP_COUNT\n};\n\n");
+}
+
+/* Write an enum naming each specified EA mode */
+static void print_ea_enum(FILE* filep)
+{
+	int i;
+	int j;
+
+	fprintf(filep, "/* Specified effective addressing modes */\n");
+	fprintf(filep, "enum\n{\n\tM68KEA_NONE,\n");
+	for(i=1;g_spec_ea_table[i] != nullptr;i++)
+	{
+		fprintf(filep, "\tM68KEA_");
+		for(j=0;g_spec_ea_table[i][j];j++)
+			fputc(toupper((unsigned char)g_spec_ea_table[i][j]), filep);
+		fprintf(filep, ",\n");
+	}
+	fprintf(filep, "\tM68KEA_COUNT\n};\n\n");
+}
+
 /* Fill out an opcode struct with a specific addressing mode of the source opcode struct */
 static void set_opcode_struct(opcode_struct* src, opcode_struct* dst, int ea_mode)
 {
@@ -1117,6 +1186,11 @@ static void populate_table(void)
 		ptr += skip_spaces(ptr);
 		ptr += check_strsncpy(op->spec_proc, ptr, MAX_SPEC_PROC_LENGTH);
 
+		/* Family (name and special processing, before cc substitution) */
+		strcpy(op->family, op->name);
+		if(strcmp(op->spec_proc, UNSPECIFIED) != 0)
+			sprintf(op->family+strlen(op->family), "_%s", op->spec_proc);
+
 		/* Specified EA Mode */
 		ptr += skip_spaces(ptr);
 		ptr += check_strsncpy(op->spec_ea, ptr, MAX_SPEC_EA_LENGTH);
@@ -1395,6 +1469,8 @@ int main(int argc, char *argv[])
 			print_opcode_output_table(g_table_file);
 			fprintf(g_table_file, "%s\n\n", table_footer_insert);
 
+			print_family_enum(g_prototype_file);
+			print_ea_enum(g_prototype_file);
 			fprintf(g_prototype_file, "%s\n\n", prototype_footer_insert);
 			fprintf(g_prototype_file, "#endif\n");
 
@@ -82,6 +82,9 @@
 /* size of the execution code cache */
 #define CACHE_SIZE                      (32 * 1024 * 1024)
 
+/* version of the persisted block list; bump when the front-end changes */
+#define DRC_PERSIST_VERSION             1
+
 
 
 static const UINT8 fcc_shift[8] = { 23, 25, 26, 27, 28, 29, 30, 31 };
@@ -201,6 +204,11 @@ void mips3_device::device_stop()
 		m_vtlb = nullptr;
 	}
 
+	if (m_drcpersist != nullptr)
+	{
+		m_drcpersist->save();
+		m_drcpersist = nullptr;
+	}
 	if (m_drcfe != nullptr)
 	{
 		m_drcfe = nullptr;
@@ -403,6 +411,9 @@ void mips3_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* load the list of blocks compiled in a previous run */
+	m_drcpersist = std::make_unique<drc_persistent_cache>(*this, *m_drcuml, *m_drcfe, DRC_PERSIST_VERSION, drc_persistent_cache::compile_delegate(FUNC(mips3_device::code_compile_block), this));
+
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
 
@@ -2725,6 +2736,7 @@ void mips3_device::execute_run()
 			if (execute_result == EXECUTE_MISSING_CODE)
 			{
 				code_compile_block(m_core->mode, m_core->pc);
+				m_drcpersist->block_missing(m_core->mode);
 			}
 			else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			{
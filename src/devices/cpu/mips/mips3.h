@@ -17,6 +17,7 @@
 
 #include "cpu/vtlb.h"
 #include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
 
@@ -281,6 +282,7 @@ public:
 	void clear_fastram(UINT32 select_start);
 	void mips3drc_set_options(UINT32 options);
 	void mips3drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles);
+	void mips3drc_invalidate_code(offs_t start, offs_t end);
 	void burn_cycles(INT32 cycles);
 
 protected:
@@ -411,6 +413,7 @@ private:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                     /* DRC UML generator state */
 	std::unique_ptr<mips3_frontend>    m_drcfe;                      /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_persistent_cache> m_drcpersist;              /* persisted list of compiled blocks */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* internal stuff */
@@ -537,6 +540,7 @@ public:
 	void func_printf_debug();
 	void func_printf_probe();
 	void func_unimplemented();
+	void func_invalidate_icache_line();
 private:
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
@@ -207,6 +207,18 @@ void mips3_device::mips3drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles)
 }
 
 
+/*-------------------------------------------------
+    mips3drc_invalidate_code - unlink any compiled
+    code built from the given physical range
+-------------------------------------------------*/
+
+void mips3_device::mips3drc_invalidate_code(offs_t start, offs_t end)
+{
+	if (m_drcuml != nullptr)
+		m_drcuml->invalidate_code(start, end);
+}
+
+
 
 /***************************************************************************
     CACHE MANAGEMENT
@@ -372,8 +384,17 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 																							// hashjmp <mode>,nextpc,nocode
 			}
 
+			/* note where the code came from so that it can be invalidated */
+			for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+			{
+				block->add_source(curdesc->physpc, curdesc->length);
+				for (const opcode_desc *delay = curdesc->delay.first(); delay != nullptr; delay = delay->next())
+					block->add_source(delay->physpc, delay->length);
+			}
+
 			/* end the sequence */
 			block->end();
+			m_drcpersist->record(mode, desclist);
 			g_profiler.stop();
 			succeeded = true;
 		}
@@ -542,6 +563,25 @@ static void cfunc_unimplemented(void *param)
 }
 
 
+/*-------------------------------------------------
+    cfunc_invalidate_icache_line - unlink any code
+    built from the I-cache line at the virtual
+    address in arg0
+-------------------------------------------------*/
+
+void mips3_device::func_invalidate_icache_line()
+{
+	offs_t address = m_core->arg0;
+	if (memory_translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, address))
+		mips3drc_invalidate_code(address & ~31, address | 31);
+}
+
+static void cfunc_invalidate_icache_line(void *param)
+{
+	((mips3_device *)param)->func_invalidate_icache_line();
+}
+
+
 /***************************************************************************
     STATIC CODEGEN
 ***************************************************************************/
@@ -1823,9 +1863,20 @@ int mips3_device::generate_opcode(drcuml_block *block, compiler_state *compiler,
 			return TRUE;
 
 
-		/* ----- effective no-ops ----- */
+		/* ----- cache management ----- */
 
 		case 0x2f:  /* CACHE - MIPS II */
+			/* Index_Invalidate_I and Hit_Invalidate_I unlink code built from the line */
+			if ((RTREG & 3) == 0 && ((RTREG >> 2) == 0 || (RTREG >> 2) == 4))
+			{
+				UML_ADD(block, mem(&m_core->arg0), R32(RSREG), SIMMVAL);       // add     [arg0],<rsreg>,SIMMVAL
+				UML_CALLC(block, cfunc_invalidate_icache_line, this);          // callc   invalidate_icache_line,mips3
+			}
+			return TRUE;
+
+
+		/* ----- effective no-ops ----- */
+
 		case 0x33:  /* PREF - MIPS IV */
 			return TRUE;
 
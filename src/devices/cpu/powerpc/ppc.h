@@ -16,6 +16,7 @@
 
 #include "cpu/vtlb.h"
 #include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
 
@@ -220,6 +221,7 @@ public:
 	void ppcdrc_set_options(UINT32 options);
 	void ppcdrc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
 	void ppcdrc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles);
+	void ppcdrc_invalidate_code(offs_t start, offs_t end);
 
 	TIMER_CALLBACK_MEMBER(decrementer_int_callback);
 	TIMER_CALLBACK_MEMBER(ppc4xx_buffered_dma_callback);
@@ -231,6 +233,7 @@ public:
 	void ppc_cfunc_printf_debug();
 	void ppc_cfunc_printf_probe();
 	void ppc_cfunc_unimplemented();
+	void ppc_cfunc_invalidate_icache_line();
 	void ppccom_tlb_fill();
 	void ppccom_update_fprf();
 	void ppccom_dcstore_callback();
@@ -539,6 +542,7 @@ protected:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                     /* DRC UML generator state */
 	std::unique_ptr<ppc_frontend>      m_drcfe;                      /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_persistent_cache> m_drcpersist;              /* persisted list of compiled blocks */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* parameters for subroutines */
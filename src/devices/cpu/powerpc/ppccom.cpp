@@ -930,6 +930,9 @@ void ppc_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<ppc_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* load the list of blocks compiled in a previous run */
+	m_drcpersist = std::make_unique<drc_persistent_cache>(*this, *m_drcuml, *m_drcfe, DRC_PERSIST_VERSION, drc_persistent_cache::compile_delegate(FUNC(ppc_device::code_compile_block), this));
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
 	{
@@ -1148,6 +1151,9 @@ void ppc_device::state_string_export(const device_state_entry &entry, std::strin
 
 void ppc_device::device_stop()
 {
+	if (m_drcpersist != nullptr)
+		m_drcpersist->save();
+
 	if (m_vtlb != nullptr)
 		vtlb_free(m_vtlb);
 	m_vtlb = nullptr;
@@ -37,6 +37,9 @@
 /* size of the execution code cache */
 #define CACHE_SIZE                      (32 * 1024 * 1024)
 
+/* version of the persisted block list; bump when the front-end changes */
+#define DRC_PERSIST_VERSION             1
+
 /* compilation boundaries -- how far back/forward does the analysis extend? */
 #define COMPILE_BACKWARDS_BYTES         128
 #define COMPILE_FORWARDS_BYTES          512
@@ -221,7 +221,10 @@ void ppc_device::execute_run()
 
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
+		{
 			code_compile_block(m_core->mode, m_core->pc);
+			m_drcpersist->block_missing(m_core->mode);
+		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
 		else if (execute_result == EXECUTE_RESET_CACHE)
@@ -275,6 +278,18 @@ void ppc_device::ppcdrc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles)
 }
 
 
+/*-------------------------------------------------
+    ppcdrc_invalidate_code - unlink any compiled
+    code built from the given physical range
+-------------------------------------------------*/
+
+void ppc_device::ppcdrc_invalidate_code(offs_t start, offs_t end)
+{
+	if (m_drcuml != nullptr)
+		m_drcuml->invalidate_code(start, end);
+}
+
+
 
 /***************************************************************************
     CACHE MANAGEMENT
@@ -446,8 +461,17 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 					UML_HASHJMP(block, m_core->mode, nextpc, *m_nocode);// hashjmp <mode>,nextpc,nocode
 			}
 
+			/* note where the code came from so that it can be invalidated */
+			for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+			{
+				block->add_source(curdesc->physpc, curdesc->length);
+				for (const opcode_desc *delay = curdesc->delay.first(); delay != nullptr; delay = delay->next())
+					block->add_source(delay->physpc, delay->length);
+			}
+
 			/* end the sequence */
 			block->end();
+			m_drcpersist->record(mode, desclist);
 			g_profiler.stop();
 			succeeded = true;
 		}
@@ -550,6 +574,26 @@ void ppc_device::ppc_cfunc_unimplemented()
 	fatalerror("PC=%08X: Unimplemented op %08X\n", m_core->pc, opcode);
 }
 
+
+/*-------------------------------------------------
+    cfunc_invalidate_icache_line - unlink any code
+    built from the cache line at the effective
+    address in param0
+-------------------------------------------------*/
+
+static void cfunc_invalidate_icache_line(void *param)
+{
+	ppc_device *ppc = (ppc_device *)param;
+	ppc->ppc_cfunc_invalidate_icache_line();
+}
+
+void ppc_device::ppc_cfunc_invalidate_icache_line()
+{
+	offs_t address = m_core->param0;
+	if (ppccom_translate_address_internal(TRANSLATE_FETCH_DEBUG, address) <= 1)
+		ppcdrc_invalidate_code(address & ~(m_cache_line_size - 1), address | (m_cache_line_size - 1));
+}
+
 static void cfunc_ppccom_tlb_fill(void *param)
 {
 	ppc_device *ppc = (ppc_device *)param;
@@ -3189,10 +3233,15 @@ int ppc_device::generate_instruction_1f(drcuml_block *block, compiler_state *com
 			UML_CALLC(block, (c_function)cfunc_ppccom_dcstore_callback, this);
 			return TRUE;
 
+		case 0x3d6: /* ICBI */
+			UML_ADD(block, I0, R32Z(G_RA(op)), R32(G_RB(op)));                          // add     i0,ra,rb
+			UML_MOV(block, mem(&m_core->param0), I0);                                      // mov     [param0],i0
+			UML_CALLC(block, (c_function)cfunc_invalidate_icache_line, this);                // callc   invalidate_icache_line,ppc
+			return TRUE;
+
 		case 0x056: /* DCBF */
 		case 0x0f6: /* DCBTST */
 		case 0x116: /* DCBT */
-		case 0x3d6: /* ICBI */
 		case 0x256: /* SYNC */
 		case 0x356: /* EIEIO */
 		case 0x1d6: /* DCBI */
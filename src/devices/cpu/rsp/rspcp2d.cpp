@@ -3246,6 +3246,140 @@ static void cfunc_vrsqh(void *param)
 }
 
 
+/*-------------------------------------------------
+    generate_vs2_select - return the VS2 operand
+    of a vector opcode with its element selection
+    applied, shuffling into scratch if needed
+-------------------------------------------------*/
+
+const VECTOR_REG *rsp_cop2_drc::generate_vs2_select(drcuml_block *block, UINT32 op)
+{
+	const int el = EL;
+	if (el < 2)
+		return &m_v[VS2REG];
+
+	UINT32 sel = 0;
+	for (int i = 0; i < 8; i++)
+		sel |= vector_elements_2[el][i] << (4 * i);
+	UML_VSHUF(block, &m_vtemp[0], &m_v[VS2REG], sel);                             // vshuf   vtemp0,vs2,sel
+	return &m_vtemp[0];
+}
+
+
+/*-------------------------------------------------
+    generate_set_accum - copy the lanes of a vector
+    into one 16-bit slice of the accumulators
+-------------------------------------------------*/
+
+void rsp_cop2_drc::generate_set_accum(drcuml_block *block, const VECTOR_REG &src, int word)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		UML_LOAD(block, I0, &src.s[0], i, SIZE_WORD, SCALE_x2);                   // load    i0,src,i,word_x2
+		UML_STORE(block, &m_accum[0].w[word], i * 4, I0, SIZE_WORD, SCALE_x2);    // store   accum.w[word],i*4,i0,word_x2
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_vector_logical - generate code for
+    VAND/VNAND/VOR/VNOR/VXOR/VNXOR
+-------------------------------------------------*/
+
+void rsp_cop2_drc::generate_vector_logical(drcuml_block *block, UINT32 op)
+{
+	const VECTOR_REG *vs2 = generate_vs2_select(block, op);
+	VECTOR_REG *vd = &m_v[VDREG];
+
+	switch (op & 0x3f)
+	{
+		case 0x28:  case 0x29:  UML_VAND(block, vd, &m_v[VS1REG], vs2);   break;      // vand    vd,vs1,vs2
+		case 0x2a:  case 0x2b:  UML_VOR(block, vd, &m_v[VS1REG], vs2);    break;      // vor     vd,vs1,vs2
+		case 0x2c:  case 0x2d:  UML_VXOR(block, vd, &m_v[VS1REG], vs2);   break;      // vxor    vd,vs1,vs2
+	}
+	if (op & 1)
+		UML_VXOR(block, vd, vd, &m_vones);                                          // vxor    vd,vd,ones
+
+	// the low accumulator slice receives the result
+	generate_set_accum(block, *vd, 1);
+}
+
+
+/*-------------------------------------------------
+    generate_vadd - generate code for VADD; carry
+    lanes are 0 or 0xffff, so subtracting them
+    adds the carry in
+-------------------------------------------------*/
+
+void rsp_cop2_drc::generate_vadd(drcuml_block *block, UINT32 op)
+{
+	const VECTOR_REG *vs2 = generate_vs2_select(block, op);
+	const VECTOR_REG *vs1 = &m_v[VS1REG];
+	VECTOR_REG *carry = (VECTOR_REG *)m_vflag[CARRY];
+
+	// the accumulator takes the wrapped sum
+	UML_VADDW(block, &m_vtemp[1], vs1, vs2);                                        // vaddw   vtemp1,vs1,vs2
+	UML_VSUBW(block, &m_vtemp[1], &m_vtemp[1], carry);                              // vsubw   vtemp1,vtemp1,carry
+
+	// adding the carry to the smaller operand first can only saturate when both are 0x7fff
+	UML_VMINSW(block, &m_vtemp[2], vs1, vs2);                                       // vminsw  vtemp2,vs1,vs2
+	UML_VMAXSW(block, &m_vtemp[3], vs1, vs2);                                       // vmaxsw  vtemp3,vs1,vs2
+	UML_VSUBSW(block, &m_vtemp[2], &m_vtemp[2], carry);                             // vsubsw  vtemp2,vtemp2,carry
+	UML_VADDSW(block, &m_v[VDREG], &m_vtemp[2], &m_vtemp[3]);                       // vaddsw  vd,vtemp2,vtemp3
+
+	generate_set_accum(block, m_vtemp[1], 1);
+	UML_VXOR(block, carry, carry, carry);                                           // vxor    carry,carry,carry
+	UML_VXOR(block, m_vflag[ZERO], m_vflag[ZERO], m_vflag[ZERO]);                  // vxor    zero,zero,zero
+}
+
+
+/*-------------------------------------------------
+    generate_vsub - generate code for VSUB
+-------------------------------------------------*/
+
+void rsp_cop2_drc::generate_vsub(drcuml_block *block, UINT32 op)
+{
+	const VECTOR_REG *vs2 = generate_vs2_select(block, op);
+	const VECTOR_REG *vs1 = &m_v[VS1REG];
+	VECTOR_REG *carry = (VECTOR_REG *)m_vflag[CARRY];
+
+	// fold the borrow into VS2 both wrapped and saturated; they differ only when VS2 is 0x7fff
+	UML_VSUBW(block, &m_vtemp[1], vs2, carry);                                      // vsubw   vtemp1,vs2,carry
+	UML_VSUBSW(block, &m_vtemp[2], vs2, carry);                                     // vsubsw  vtemp2,vs2,carry
+	UML_VSUBW(block, &m_vtemp[3], vs1, &m_vtemp[1]);                                // vsubw   vtemp3,vs1,vtemp1
+
+	// where the saturated subtrahend fell one short, take one more off the result
+	UML_VCMPGTW(block, &m_vtemp[1], &m_vtemp[2], &m_vtemp[1]);                      // vcmpgtw vtemp1,vtemp2,vtemp1
+	UML_VSUBSW(block, &m_vtemp[2], vs1, &m_vtemp[2]);                               // vsubsw  vtemp2,vs1,vtemp2
+	UML_VADDSW(block, &m_v[VDREG], &m_vtemp[2], &m_vtemp[1]);                       // vaddsw  vd,vtemp2,vtemp1
+
+	generate_set_accum(block, m_vtemp[3], 1);
+	UML_VXOR(block, carry, carry, carry);                                           // vxor    carry,carry,carry
+	UML_VXOR(block, m_vflag[ZERO], m_vflag[ZERO], m_vflag[ZERO]);                  // vxor    zero,zero,zero
+}
+
+
+/*-------------------------------------------------
+    generate_vmudh - generate code for VMUDH; the
+    product lands in the high and middle slices
+-------------------------------------------------*/
+
+void rsp_cop2_drc::generate_vmudh(drcuml_block *block, UINT32 op)
+{
+	const VECTOR_REG *vs2 = generate_vs2_select(block, op);
+	const VECTOR_REG *vs1 = &m_v[VS1REG];
+
+	UML_VMULLW(block, &m_vtemp[1], vs1, vs2);                                       // vmullw  vtemp1,vs1,vs2
+	UML_VMULHW(block, &m_vtemp[2], vs1, vs2);                                       // vmulhw  vtemp2,vs1,vs2
+	UML_VSATW(block, &m_v[VDREG], &m_vtemp[1], &m_vtemp[2]);                        // vsatw   vd,vtemp1,vtemp2
+
+	generate_set_accum(block, m_vtemp[2], 3);
+	generate_set_accum(block, m_vtemp[1], 2);
+	for (int i = 0; i < 8; i++)
+		UML_STORE(block, &m_accum[0].l[0], i * 2, 0, SIZE_DWORD, SCALE_x4);       // store   accum.l[0],i*2,0,dword_x4
+}
+
+
 /*-------------------------------------------------
     generate_vector_opcode - generate code for a
     vector opcode
@@ -3288,8 +3422,7 @@ int rsp_cop2_drc::generate_vector_opcode(drcuml_block *block, rsp_device::compil
 			return TRUE;
 
 		case 0x07:      /* VMUDH */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vmudh, this);
+			generate_vmudh(block, op);
 			return TRUE;
 
 		case 0x08:      /* VMACF */
@@ -3323,13 +3456,11 @@ int rsp_cop2_drc::generate_vector_opcode(drcuml_block *block, rsp_device::compil
 			return TRUE;
 
 		case 0x10:      /* VADD */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vadd, this);
+			generate_vadd(block, op);
 			return TRUE;
 
 		case 0x11:      /* VSUB */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vsub, this);
+			generate_vsub(block, op);
 			return TRUE;
 
 		case 0x13:      /* VABS */
@@ -3413,33 +3544,27 @@ int rsp_cop2_drc::generate_vector_opcode(drcuml_block *block, rsp_device::compil
 			return TRUE;
 
 		case 0x28:      /* VAND */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vand, this);
+			generate_vector_logical(block, op);
 			return TRUE;
 
 		case 0x29:      /* VNAND */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vnand, this);
+			generate_vector_logical(block, op);
 			return TRUE;
 
 		case 0x2a:      /* VOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vor, this);
+			generate_vector_logical(block, op);
 			return TRUE;
 
 		case 0x2b:      /* VNOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vnor, this);
+			generate_vector_logical(block, op);
 			return TRUE;
 
 		case 0x2c:      /* VXOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vxor, this);
+			generate_vector_logical(block, op);
 			return TRUE;
 
 		case 0x2d:      /* VNXOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, cfunc_vnxor, this);
+			generate_vector_logical(block, op);
 			return TRUE;
 
 		case 0x30:      /* VRCP */
@@ -22,7 +22,11 @@ class rsp_cop2_drc : public rsp_cop2
 {
 	friend class rsp_device;
 public:
-	rsp_cop2_drc(rsp_device &rsp, running_machine &machine) : rsp_cop2(rsp, machine) { }
+	rsp_cop2_drc(rsp_device &rsp, running_machine &machine) : rsp_cop2(rsp, machine)
+	{
+		memset(m_vtemp, 0, sizeof(m_vtemp));
+		memset(&m_vones, 0xff, sizeof(m_vones));
+	}
 private:
 	virtual int generate_cop2(drcuml_block *block, rsp_device::compiler_state *compiler, const opcode_desc *desc) override;
 	virtual int generate_lwc2(drcuml_block *block, rsp_device::compiler_state *compiler, const opcode_desc *desc) override;
@@ -104,6 +108,16 @@ public:
 
 private:
 	virtual int     generate_vector_opcode(drcuml_block *block, rsp_device::compiler_state *compiler, const opcode_desc *desc) override;
+
+	const VECTOR_REG *generate_vs2_select(drcuml_block *block, UINT32 op);
+	void            generate_vector_logical(drcuml_block *block, UINT32 op);
+	void            generate_vadd(drcuml_block *block, UINT32 op);
+	void            generate_vsub(drcuml_block *block, UINT32 op);
+	void            generate_vmudh(drcuml_block *block, UINT32 op);
+	void            generate_set_accum(drcuml_block *block, const VECTOR_REG &src, int word);
+
+	VECTOR_REG      m_vtemp[4];         // scratch vectors for inline vector opcodes
+	VECTOR_REG      m_vones;            // all lanes 0xffff, for the inverted logical ops
 };
 
 #endif /* __RSPCP2D_H__ */
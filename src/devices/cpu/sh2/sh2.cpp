@@ -115,6 +115,9 @@
 /* size of the execution code cache */
 #define CACHE_SIZE                  (32 * 1024 * 1024)
 
+/* version of the persisted block list; bump when the front-end changes */
+#define DRC_PERSIST_VERSION         1
+
 /* compilation boundaries -- how far back/forward does the analysis extend? */
 #define COMPILE_BACKWARDS_BYTES         64
 #define COMPILE_FORWARDS_BYTES          256
@@ -199,6 +202,8 @@ sh2_device::sh2_device(const machine_config &mconfig, const char *tag, device_t
 
 void sh2_device::device_stop()
 {
+	if (m_drcpersist != nullptr)
+		m_drcpersist->save();
 }
 
 
@@ -2552,6 +2557,9 @@ void sh2_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<sh2_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* load the list of blocks compiled in a previous run */
+	m_drcpersist = std::make_unique<drc_persistent_cache>(*this, *m_drcuml, *m_drcfe, DRC_PERSIST_VERSION, drc_persistent_cache::compile_delegate(FUNC(sh2_device::code_compile_block), this));
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 16; regnum++)
 	{
@@ -18,6 +18,7 @@
 #define __SH2_H__
 
 #include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
 #include "cpu/drcuml.h"
 
 
@@ -108,6 +109,7 @@ public:
 	void sh2drc_set_options(UINT32 options);
 	void sh2drc_add_pcflush(offs_t address);
 	void sh2drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
+	void sh2drc_invalidate_code(offs_t start, offs_t end);
 
 	void sh2_notify_dma_data_available();
 
@@ -221,6 +223,7 @@ private:
 	drc_cache           m_cache;                  /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                 /* DRC UML generator state */
 	std::unique_ptr<sh2_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_persistent_cache> m_drcpersist;          /* persisted list of compiled blocks */
 	UINT32              m_drcoptions;         /* configurable DRC options */
 
 	internal_sh2_state *m_sh2_state;
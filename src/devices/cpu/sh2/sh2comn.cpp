@@ -366,6 +366,15 @@ void sh2_device::sh2_do_dma(int dma)
 
 
 		LOG(("SH2.%s: DMA %d complete\n", tag(), dma));
+
+		// unlink any recompiled code built from the memory the transfer wrote
+		if (m_isdrc && m_active_dma_incd[dma] != 0)
+		{
+			UINT32 first = m_m[0x61+4*dma] & AM;
+			UINT32 last = m_active_dma_dst[dma];
+			sh2drc_invalidate_code(MIN(first, last), MAX(first, last));
+		}
+
 		m_m[0x62+4*dma] = 0;
 		m_m[0x63+4*dma] |= 2;
 		m_dma_timer_active[dma] = 0;
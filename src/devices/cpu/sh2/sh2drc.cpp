@@ -646,6 +646,7 @@ void sh2_device::execute_run_drc()
 		if (execute_result == EXECUTE_MISSING_CODE)
 		{
 			code_compile_block(0, m_sh2_state->pc);
+			m_drcpersist->block_missing(0);
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 		{
@@ -762,8 +763,17 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 																							// hashjmp <mode>,nextpc,nocode
 			}
 
+			/* note where the code came from so that it can be invalidated */
+			for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+			{
+				block->add_source(curdesc->physpc & AM, curdesc->length);
+				for (const opcode_desc *delay = curdesc->delay.first(); delay != nullptr; delay = delay->next())
+					block->add_source(delay->physpc & AM, delay->length);
+			}
+
 			/* end the sequence */
 			block->end();
+			m_drcpersist->record(mode, desclist);
 			g_profiler.stop();
 			succeeded = true;
 		}
@@ -2981,3 +2991,15 @@ void sh2_device::sh2drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, vo
 		m_fastram_select++;
 	}
 }
+
+
+/*-------------------------------------------------
+    sh2drc_invalidate_code - unlink any compiled
+    code built from the given physical range
+-------------------------------------------------*/
+
+void sh2_device::sh2drc_invalidate_code(offs_t start, offs_t end)
+{
+	if (m_drcuml != nullptr)
+		m_drcuml->invalidate_code(start & AM, end & AM);
+}
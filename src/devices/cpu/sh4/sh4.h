@@ -13,6 +13,10 @@
 #ifndef __SH4_H__
 #define __SH4_H__
 
+#include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
+#include "cpu/drcuml.h"
+
 // doesn't actually seem to improve performance at all
 #define SH4_USE_FASTRAM_OPTIMIZATION 0
 #define SH4_MAX_FASTRAM       3
@@ -169,13 +173,28 @@ typedef void (*sh4_ftcsr_callback)(UINT32);
 #define MCFG_SH4_CLOCK(_clock) \
 	sh34_base_device::set_sh4_clock(*device, _clock);
 
+/* use the interpreter even when the recompiler is enabled (little-endian SH-4 only) */
+#define MCFG_SH4_FORCE_INTERPRETER() \
+	sh34_base_device::set_force_interpreter(*device);
+
+/* use the recompiler whenever -drc is on, without needing -drc_sh4 */
+#define MCFG_SH4_ALLOW_RECOMPILER() \
+	sh34_base_device::set_allow_recompiler(*device);
+
+
+class sh4_frontend;
 
 class sh34_base_device : public cpu_device
 {
+	friend class sh4_frontend;
+
 public:
 	// construction/destruction
 	sh34_base_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, endianness_t endianness, address_map_constructor internal);
 
+	void sh4drc_set_options(UINT32 options);
+	void sh4drc_add_pcflush(offs_t address);
+
 //#if SH4_USE_FASTRAM_OPTIMIZATION
 	void add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
 //#endif
@@ -190,6 +209,8 @@ public:
 	static void set_md7(device_t &device, int md0) { downcast<sh34_base_device &>(device).c_md7 = md0; }
 	static void set_md8(device_t &device, int md0) { downcast<sh34_base_device &>(device).c_md8 = md0; }
 	static void set_sh4_clock(device_t &device, int clock) { downcast<sh34_base_device &>(device).c_clock = clock; }
+	static void set_force_interpreter(device_t &device) { downcast<sh34_base_device &>(device).m_isdrc = false; }
+	static void set_allow_recompiler(device_t &device);
 
 	TIMER_CALLBACK_MEMBER( sh4_refresh_timer_callback );
 	TIMER_CALLBACK_MEMBER( sh4_rtc_timer_callback );
@@ -206,6 +227,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 
 	// device_execute_interface overrides
 	virtual UINT32 execute_min_cycles() const override { return 1; }
@@ -242,29 +264,42 @@ protected:
 	int c_md8;
 	int c_clock;
 
-	UINT32  m_ppc;
-	UINT32  m_pc;
-	UINT32  m_spc;
-	UINT32  m_pr;
-	UINT32  m_sr;
-	UINT32  m_ssr;
-	UINT32  m_gbr;
-	UINT32  m_vbr;
-	UINT32  m_mach;
-	UINT32  m_macl;
-	UINT32  m_r[16];
+	// Data that needs to be stored close to the generated DRC code
+	struct internal_sh4_state
+	{
+		UINT32  ppc;
+		UINT32  pc;
+		UINT32  spc;
+		UINT32  pr;
+		UINT32  sr;
+		UINT32  ssr;
+		UINT32  gbr;
+		UINT32  vbr;
+		UINT32  mach;
+		UINT32  macl;
+		UINT32  r[16];
+		UINT32  sgr;
+		UINT32  fr[16];
+		UINT32  xf[16];
+		UINT32  ea;
+		UINT32  test_irq;
+		UINT32  fpscr;
+		UINT32  fpul;
+		UINT32  dbr;
+		int     icount;
+		int     fpu_sz;
+		int     fpu_pr;
+		UINT32  mode;               // FPU mode the DRC compiles for (PR | SZ << 1)
+		UINT32  target;             // target for jmp/jsr/etc so the delay slot can't kill it
+		UINT32  arg0;               // opcode handed to the interpreter helpers
+	};
+
+	internal_sh4_state *m_sh4_state;
+
 	UINT32  m_rbnk[2][8];
-	UINT32  m_sgr;
-	UINT32  m_fr[16];
-	UINT32  m_xf[16];
-	UINT32  m_ea;
 	UINT32  m_delay;
 	UINT32  m_cpu_off;
 	UINT32  m_pending_irq;
-	UINT32  m_test_irq;
-	UINT32  m_fpscr;
-	UINT32  m_fpul;
-	UINT32  m_dbr;
 
 	UINT32  m_exception_priority[128];
 	int     m_exception_requesting[128];
@@ -343,13 +378,10 @@ protected:
 	int     m_dma_destination_increment[4];
 	int     m_dma_mode[4];
 
-	int     m_sh4_icount;
 	int     m_is_slave;
 	int     m_cpu_clock;
 	int     m_bus_clock;
 	int     m_pm_clock;
-	int     m_fpu_sz;
-	int     m_fpu_pr;
 	int     m_ioport16_pullup;
 	int     m_ioport16_direction;
 	int     m_ioport4_pullup;
@@ -370,6 +402,37 @@ protected:
 
 	UINT64 m_debugger_temp;
 
+	// DRC
+	bool m_isdrc;
+
+	int m_pcfsel;                 // last pcflush entry set
+	UINT32 m_pcflushes[16];           // pcflush entries
+
+	drc_cache           m_cache;                  /* pointer to the DRC code cache */
+	std::unique_ptr<drcuml_state>      m_drcuml;                 /* DRC UML generator state */
+	std::unique_ptr<sh4_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_persistent_cache> m_drcpersist;          /* persisted list of compiled blocks */
+	UINT32              m_drcoptions;         /* configurable DRC options */
+
+	/* internal stuff */
+	UINT8               m_cache_dirty;                /* true if we need to flush the cache */
+
+	/* register mappings */
+	uml::parameter      m_regmap[16];                 /* parameter to register mappings for all 16 integer registers */
+
+	uml::code_handle *  m_entry;                      /* entry point */
+	uml::code_handle *  m_read8;                  /* read byte */
+	uml::code_handle *  m_write8;                 /* write byte */
+	uml::code_handle *  m_read16;                 /* read half */
+	uml::code_handle *  m_write16;                    /* write half */
+	uml::code_handle *  m_read32;                 /* read word */
+	uml::code_handle *  m_write32;                    /* write word */
+
+	uml::code_handle *  m_nocode;                 /* nocode */
+	uml::code_handle *  m_out_of_cycles;              /* out of cycles exception handler */
+
+	UINT8 *             m_sq;                         /* store queue RAM, for direct access from generated code */
+
 
 	void execute_one_0000(const UINT16 opcode);
 	void execute_one_4000(const UINT16 opcode);
@@ -692,6 +755,58 @@ protected:
 	UINT32 sh4_handle_chcr3_addr_r(UINT32 mem_mask) { return m_SH4_CHCR3; }
 	UINT32 sh4_handle_dmaor_addr_r(UINT32 mem_mask) { return m_SH4_DMAOR; }
 
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           checkints;                  /* need to check interrupts before next instruction */
+		uml::code_label  labelnum;                   /* index for local labels */
+		UINT8           mode;                       /* FPU mode (PR | SZ << 1) the block is compiled for */
+	};
+
+	inline UINT32 epc(const opcode_desc *desc);
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	inline void load_fast_iregs(drcuml_block *block);
+	inline void save_fast_iregs(drcuml_block *block);
+
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle **handleptr);
+	const char *log_desc_flags_to_string(UINT32 flags);
+	void log_register_list(drcuml_state *drcuml, const char *string, const UINT32 *reglist, const UINT32 *regnostarlist);
+	void log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent);
+	void log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	void generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	uml::parameter generate_branch_mode(compiler_state *compiler, const opcode_desc *desc);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	int generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, UINT32 ovrpc);
+	int generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_15_0x13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	void generate_fmov_load(drcuml_block *block, compiler_state *compiler, UINT32 n);
+	void generate_fmov_store(drcuml_block *block, compiler_state *compiler, UINT32 m);
+
+public:
+	void func_printf_probe();
+	void func_interpret();
+	void func_check_irq();
+	void func_RTE();
+	void func_PREFM();
+
+protected:
 #if SH4_USE_FASTRAM_OPTIMIZATION
 	/* fast RAM */
 	bool            m_bigendian;
@@ -780,6 +895,28 @@ protected:
 };
 
 
+class sh4_frontend : public drc_frontend
+{
+public:
+	sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+
+	sh34_base_device *m_sh4;
+};
+
+
 extern const device_type SH3LE;
 extern const device_type SH3BE;
 extern const device_type SH4LE;
@@ -797,7 +934,4 @@ extern const device_type SH4BE;
 #define SH4DRC_COMPATIBLE_OPTIONS   (SH4DRC_STRICT_VERIFY | SH4DRC_FLUSH_PC | SH4DRC_STRICT_PCREL)
 #define SH4DRC_FASTEST_OPTIONS  (0)
 
-void sh4drc_set_options(device_t *device, UINT32 options);
-void sh4drc_add_pcflush(device_t *device, offs_t address);
-
 #endif /* __SH4_H__ */
@@ -0,0 +1,1009 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4fe.c
+
+    Front end for SH-4 recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "sh4.h"
+#include "sh4comn.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+sh4_frontend::sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_sh4(device)
+{
+}
+
+/*-------------------------------------------------
+    describe_instruction - build a description
+    of a single instruction
+-------------------------------------------------*/
+
+bool sh4_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT16 opcode;
+
+	/* code is fetched through the external address bus */
+	desc.physpc = desc.pc & AM;
+
+	/* fetch the opcode */
+	opcode = desc.opptr.w[0] = m_sh4->m_direct->read_word(desc.physpc, WORD2_XOR_LE(0));
+
+	/* all instructions are 2 bytes and most are a single cycle */
+	desc.length = 2;
+	desc.cycles = 1;
+
+	switch (opcode>>12)
+	{
+		case  0:
+			return describe_group_0(desc, prev, opcode);
+
+		case  1:    // MOVLS4
+			desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case  2:
+			return describe_group_2(desc, prev, opcode);
+
+		case  3:
+			return describe_group_3(desc, prev, opcode);
+
+		case  4:
+			return describe_group_4(desc, prev, opcode);
+
+		case  5:    // MOVLL4
+			desc.regin[0] |= REGFLAG_R(Rm);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case  6:
+			return describe_group_6(desc, prev, opcode);
+
+		case  7:    // ADDI
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case  8:
+			return describe_group_8(desc, prev, opcode);
+
+		case  9:    // MOVWI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 11:    // BSR
+			desc.regout[1] |= REGFLAG_PR;
+			// (intentional fallthrough - BSR is BRA with the addition of PR = the return address)
+		case 10:    // BRA
+			{
+				INT32 disp = ((INT32)opcode << 20) >> 20;
+
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+				desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+				desc.delayslots = 1;
+				desc.cycles = 2;
+				return true;
+			}
+
+		case 12:
+			return describe_group_12(desc, prev, opcode);
+
+		case 13:    // MOVLI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 14:    // MOVI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 15:
+			return describe_group_15(desc, prev, opcode);
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00: // NOP();
+	case 0x01: // NOP();
+		return true;
+
+	case 0x02:
+		if (opcode & 0x80) // STCRBANK(Rm, Rn);
+		{
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+		}
+
+		switch ((opcode >> 4) & 7)
+		{
+		case 0: // STCSR(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 1: // STCGBR(Rn);
+			desc.regin[1] |= REGFLAG_GBR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 2: // STCVBR(Rn);
+			desc.regin[1] |= REGFLAG_VBR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 3: // STCSSR(Rn);
+			desc.regin[1] |= REGFLAG_SSR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 4: // STCSPC(Rn);
+			desc.regin[1] |= REGFLAG_SPC;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+		}
+		return true;
+
+	case 0x03:
+		switch ((opcode >> 4) & 15)
+		{
+		case 0x0: // BSRF(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 0x2: // BRAF(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 0x8: // PREFM(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case 0xc: // MOVCAL(Rn);
+			desc.regin[0] |= REGFLAG_R(0) | REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+		}
+		return true; // NOP(), OCBI/OCBP/OCBWB are no-ops here as in the interpreter
+
+	case 0x04: // MOVBS0(Rm, Rn);
+	case 0x05: // MOVWS0(Rm, Rn);
+	case 0x06: // MOVLS0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x07: // MULL(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[1] |= REGFLAG_MACL;
+		desc.cycles = 2;
+		return true;
+
+	case 0x08:
+		switch ((opcode >> 4) & 7)
+		{
+		case 0: // CLRT();
+		case 1: // SETT();
+		case 4: // CLRS();
+		case 5: // SETS();
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 2: // CLRMAC();
+			desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+			return true;
+		}
+		return true; // NOP(), LDTLB is a no-op here as in the interpreter
+
+	case 0x09:
+		switch ((opcode >> 4) & 3)
+		{
+		case 1: // DIV0U();
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 2: // MOVT(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+		}
+		return true;
+
+	case 0x0a:
+		switch ((opcode >> 4) & 7)
+		{
+		case 0: // STSMACH(Rn);
+			desc.regin[1] |= REGFLAG_MACH;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 1: // STSMACL(Rn);
+			desc.regin[1] |= REGFLAG_MACL;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 2: // STSPR(Rn);
+			desc.regin[1] |= REGFLAG_PR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 3: // STCSGR(Rn);
+			desc.regin[1] |= REGFLAG_SGR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 5: // STSFPUL(Rn);
+			desc.regin[1] |= REGFLAG_FPUL;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 6: // STSFPSCR(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 7: // STCDBR(Rn);
+			desc.regin[1] |= REGFLAG_DBR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+		}
+		return true;
+
+	case 0x0b:
+		switch ((opcode >> 4) & 3)
+		{
+		case 0: // RTS();
+			desc.regin[1] |= REGFLAG_PR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 1: // SLEEP();
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			return true;
+
+		case 2: // RTE();
+			desc.regin[1] |= REGFLAG_SSR | REGFLAG_SPC;
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_EXPOSE_EXTERNAL_INT;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+		}
+		return true;
+
+	case 0x0c: // MOVBL0(Rm, Rn);
+	case 0x0d: // MOVWL0(Rm, Rn);
+	case 0x0e: // MOVLL0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x0f: // MAC_L(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBS(Rm, Rn);
+	case  1: // MOVWS(Rm, Rn);
+	case  2: // MOVLS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  3: // NOP();
+		return true;
+
+	case  4: // MOVBM(Rm, Rn);
+	case  5: // MOVWM(Rm, Rn);
+	case  6: // MOVLM(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 13: // XTRCT(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case  7: // DIV0S(Rm, Rn);
+	case  8: // TST(Rm, Rn);
+	case 12: // CMPSTR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9: // AND(Rm, Rn);
+	case 10: // XOR(Rm, Rn);
+	case 11: // OR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 14: // MULU(Rm, Rn);
+	case 15: // MULS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.cycles = 2;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // CMPEQ(Rm, Rn);
+	case  2: // CMPHS(Rm, Rn);
+	case  3: // CMPGE(Rm, Rn);
+	case  6: // CMPHI(Rm, Rn);
+	case  7: // CMPGT(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  1: // NOP();
+	case  9: // NOP();
+		return true;
+
+	case  4: // DIV1(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  5: // DMULU(Rm, Rn);
+	case 13: // DMULS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.cycles = 2;
+		return true;
+
+	case  8: // SUB(Rm, Rn);
+	case 12: // ADD(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 10: // SUBC(Rm, Rn);
+	case 11: // SUBV(Rm, Rn);
+	case 14: // ADDC(Rm, Rn);
+	case 15: // ADDV(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+	}
+	return false;
+}
+
+bool sh4_frontend::describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00:
+	case 0x01:
+	case 0x04:
+	case 0x05:
+		switch (opcode & 0x3f)
+		{
+		case 0x00: // SHLL(Rn);
+		case 0x01: // SHLR(Rn);
+		case 0x04: // ROTL(Rn);
+		case 0x05: // ROTR(Rn);
+		case 0x20: // SHAL(Rn);
+		case 0x21: // SHAR(Rn);
+		case 0x10: // DT(Rn);
+		case 0x24: // ROTCL(Rn);
+		case 0x25: // ROTCR(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 0x11: // CMPPZ(Rn);
+		case 0x15: // CMPPL(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+		}
+		return true;
+
+	case 0x02:
+		switch ((opcode >> 4) & 15)
+		{
+		case 0x0: // STSMMACH(Rn);
+			desc.regin[1] |= REGFLAG_MACH;
+			break;
+
+		case 0x1: // STSMMACL(Rn);
+			desc.regin[1] |= REGFLAG_MACL;
+			break;
+
+		case 0x2: // STSMPR(Rn);
+			desc.regin[1] |= REGFLAG_PR;
+			break;
+
+		case 0x3: // STCMSGR(Rn);
+			desc.regin[1] |= REGFLAG_SGR;
+			break;
+
+		case 0x5: // STSMFPUL(Rn);
+			desc.regin[1] |= REGFLAG_FPUL;
+			break;
+
+		case 0x6: // STSMFPSCR(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR;
+			break;
+
+		case 0xf: // STCMDBR(Rn);
+			desc.regin[1] |= REGFLAG_DBR;
+			break;
+
+		default: // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x03:
+		if (opcode & 0x80) // STCMRBANK(Rm, Rn);
+		{
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+		}
+
+		switch ((opcode >> 4) & 7)
+		{
+		case 0: // STCMSR(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.cycles = 2;
+			break;
+
+		case 1: // STCMGBR(Rn);
+			desc.regin[1] |= REGFLAG_GBR;
+			desc.cycles = 2;
+			break;
+
+		case 2: // STCMVBR(Rn);
+			desc.regin[1] |= REGFLAG_VBR;
+			desc.cycles = 2;
+			break;
+
+		case 3: // STCMSSR(Rn);
+			desc.regin[1] |= REGFLAG_SSR;
+			break;
+
+		case 4: // STCMSPC(Rn);
+			desc.regin[1] |= REGFLAG_SPC;
+			break;
+
+		default: // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x06:
+		switch ((opcode >> 4) & 15)
+		{
+		case 0x0: // LDSMMACH(Rn);
+			desc.regout[1] |= REGFLAG_MACH;
+			break;
+
+		case 0x1: // LDSMMACL(Rn);
+			desc.regout[1] |= REGFLAG_MACL;
+			break;
+
+		case 0x2: // LDSMPR(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			break;
+
+		case 0x5: // LDSMFPUL(Rn);
+			desc.regout[1] |= REGFLAG_FPUL;
+			break;
+
+		case 0x6: // LDSMFPSCR(Rn);
+			desc.regout[1] |= REGFLAG_FPSCR;
+			desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0xf: // LDCMDBR(Rn);
+			desc.regout[1] |= REGFLAG_DBR;
+			break;
+
+		default: // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x07:
+		if (opcode & 0x80) // LDCMRBANK(Rm, Rn);
+		{
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+		}
+
+		switch ((opcode >> 4) & 7)
+		{
+		case 0: // LDCMSR(Rn);
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_END_SEQUENCE;
+			break;
+
+		case 1: // LDCMGBR(Rn);
+			desc.regout[1] |= REGFLAG_GBR;
+			desc.cycles = 3;
+			break;
+
+		case 2: // LDCMVBR(Rn);
+			desc.regout[1] |= REGFLAG_VBR;
+			desc.cycles = 3;
+			break;
+
+		case 3: // LDCMSSR(Rn);
+			desc.regout[1] |= REGFLAG_SSR;
+			break;
+
+		case 4: // LDCMSPC(Rn);
+			desc.regout[1] |= REGFLAG_SPC;
+			break;
+
+		default: // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x08: // SHLL2(Rn); SHLL8(Rn); SHLL16(Rn);
+	case 0x09: // SHLR2(Rn); SHLR8(Rn); SHLR16(Rn);
+		if (((opcode >> 4) & 3) == 3)
+			return true;
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0a:
+		switch ((opcode >> 4) & 15)
+		{
+		case 0x0: // LDSMACH(Rn);
+			desc.regout[1] |= REGFLAG_MACH;
+			break;
+
+		case 0x1: // LDSMACL(Rn);
+			desc.regout[1] |= REGFLAG_MACL;
+			break;
+
+		case 0x2: // LDSPR(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			break;
+
+		case 0x5: // LDSFPUL(Rn);
+			desc.regout[1] |= REGFLAG_FPUL;
+			break;
+
+		case 0x6: // LDSFPSCR(Rn);
+			desc.regout[1] |= REGFLAG_FPSCR;
+			desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0xf: // LDCDBR(Rn);
+			desc.regout[1] |= REGFLAG_DBR;
+			break;
+
+		default: // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0b:
+		switch ((opcode >> 4) & 3)
+		{
+		case 0: // JSR(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 1: // TAS(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[1] |= REGFLAG_SR;
+			desc.cycles = 4;
+			desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case 2: // JMP(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			return true;
+		}
+		return true;
+
+	case 0x0c: // SHAD(Rm, Rn);
+	case 0x0d: // SHLD(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0e:
+		if (opcode & 0x80) // LDCRBANK(Rm, Rn);
+		{
+			desc.regin[0] |= REGFLAG_R(Rn);
+			return true;
+		}
+
+		switch ((opcode >> 4) & 7)
+		{
+		case 0: // LDCSR(Rn);
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_END_SEQUENCE;
+			break;
+
+		case 1: // LDCGBR(Rn);
+			desc.regout[1] |= REGFLAG_GBR;
+			break;
+
+		case 2: // LDCVBR(Rn);
+			desc.regout[1] |= REGFLAG_VBR;
+			break;
+
+		case 3: // LDCSSR(Rn);
+			desc.regout[1] |= REGFLAG_SSR;
+			break;
+
+		case 4: // LDCSPC(Rn);
+			desc.regout[1] |= REGFLAG_SPC;
+			break;
+
+		default: // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0f: // MAC_W(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBL(Rm, Rn);
+	case  1: // MOVWL(Rm, Rn);
+	case  2: // MOVLL(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  3: // MOV(Rm, Rn);
+	case  7: // NOT(Rm, Rn);
+	case  8: // SWAPB(Rm, Rn);
+	case  9: // SWAPW(Rm, Rn);
+	case 11: // NEG(Rm, Rn);
+	case 12: // EXTUB(Rm, Rn);
+	case 13: // EXTUW(Rm, Rn);
+	case 14: // EXTSB(Rm, Rn);
+	case 15: // EXTSW(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case  4: // MOVBP(Rm, Rn);
+	case  5: // MOVWP(Rm, Rn);
+	case  6: // MOVLP(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 10: // NEGC(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+	}
+	return false;
+}
+
+bool sh4_frontend::describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	INT32 disp;
+
+	switch ( opcode  & (15<<8) )
+	{
+	case  0 << 8: // MOVBS4(opcode & 0x0f, Rm);
+	case  1 << 8: // MOVWS4(opcode & 0x0f, Rm);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  2<< 8: // NOP();
+	case  3<< 8: // NOP();
+	case  6<< 8: // NOP();
+	case  7<< 8: // NOP();
+	case 10<< 8: // NOP();
+	case 12<< 8: // NOP();
+	case 14<< 8: // NOP();
+		return true;
+
+	case  4<< 8: // MOVBL4(Rm, opcode & 0x0f);
+	case  5<< 8: // MOVWL4(Rm, opcode & 0x0f);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  8<< 8: // CMPIM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9<< 8: // BT(opcode & 0xff);
+	case 11<< 8: // BF(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		desc.cycles = 3;
+		disp = ((INT32)opcode << 24) >> 24;
+		desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+		return true;
+
+	case 13<< 8: // BTS(opcode & 0xff);
+	case 15<< 8: // BFS(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		desc.cycles = 2;
+		disp = ((INT32)opcode << 24) >> 24;
+		desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+		desc.delayslots = 1;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & (15<<8))
+	{
+	case  0<<8: // MOVBSG(opcode & 0xff);
+	case  1<<8: // MOVWSG(opcode & 0xff);
+	case  2<<8: // MOVLSG(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  3<<8: // TRAPA(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(15);
+		desc.regin[1] |= REGFLAG_VBR | REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR | REGFLAG_SSR | REGFLAG_SPC | REGFLAG_SGR;
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		return true;
+
+	case  4<<8: // MOVBLG(opcode & 0xff);
+	case  5<<8: // MOVWLG(opcode & 0xff);
+	case  6<<8: // MOVLLG(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  7<<8: // MOVA(opcode & 0xff);
+		desc.regout[0] |= REGFLAG_R(0);
+		return true;
+
+	case  8<<8: // TSTI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9<<8: // ANDI(opcode & 0xff);
+	case 10<<8: // XORI(opcode & 0xff);
+	case 11<<8: // ORI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(0);
+		return true;
+
+	case 12<<8: // TSTM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_GBR;
+		desc.regout[1] |= REGFLAG_SR;
+		desc.cycles = 3;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 13<<8: // ANDM(opcode & 0xff);
+	case 14<<8: // XORM(opcode & 0xff);
+	case 15<<8: // ORM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.cycles = 3;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // FADD(Rm, Rn);
+	case  1: // FSUB(Rm, Rn);
+	case  2: // FMUL(Rm, Rn);
+	case  3: // FDIV(Rm, Rn);
+	case 12: // FMOVFR(Rm, Rn);
+	case 14: // FMAC(Rm, Rn);
+		return true;
+
+	case  4: // FCMP_EQ(Rm, Rn);
+	case  5: // FCMP_GT(Rm, Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  6: // FMOVS0FR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(0) | REGFLAG_R(Rm);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  7: // FMOVFRS0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(0) | REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  8: // FMOVMRFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  9: // FMOVMRIFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rm);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 10: // FMOVFRMR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 11: // FMOVFRMDR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 13:
+		switch ((opcode >> 4) & 15)
+		{
+		case 0x0: // FSTS(Rn);
+		case 0x2: // FLOAT(Rn);
+		case 0xa: // FCNVSD(Rn);
+			desc.regin[1] |= REGFLAG_FPUL;
+			return true;
+
+		case 0x1: // FLDS(Rn);
+		case 0x3: // FTRC(Rn);
+		case 0xb: // FCNVDS(Rn);
+			desc.regout[1] |= REGFLAG_FPUL;
+			return true;
+
+		case 0xf:
+			if (!(opcode & 0x100)) // FSSCA(Rn);
+			{
+				desc.regin[1] |= REGFLAG_FPUL;
+				return true;
+			}
+			if ((opcode & 0x200) && (opcode & 0xc00) == 0x000) // FSCHG();
+			{
+				desc.regin[1] |= REGFLAG_FPSCR;
+				desc.regout[1] |= REGFLAG_FPSCR;
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+				return true;
+			}
+			if ((opcode & 0x200) && (opcode & 0xc00) == 0x800) // FRCHG();
+			{
+				desc.regin[1] |= REGFLAG_FPSCR;
+				desc.regout[1] |= REGFLAG_FPSCR;
+				return true;
+			}
+			return true; // FTRV(Rn);
+		}
+		return true;
+
+	case 15: // dbreak();
+		return true;
+	}
+
+	return false;
+}
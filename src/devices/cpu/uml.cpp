@@ -13,10 +13,6 @@
     * UML optimizer:
         - constant folding
 
-    * Write a back-end validator:
-        - checks all combinations of memory/register/immediate on all params
-        - checks behavior of all opcodes
-
     * Extend registers to 16? Depends on if PPC can use them
 
     * Support for FPU exceptions
@@ -214,6 +210,23 @@ const opcode_info instruction::s_opcode_info_table[OP_MAX] =
 	OPINFO2(FSQRT,   "f#sqrt",   4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY))
 	OPINFO2(FRECIP,  "f#recip",  4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY))
 	OPINFO2(FRSQRT,  "f#rsqrt",  4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY))
+
+	// Vector Operations
+	OPINFO2(VMOV,    "vmov",     4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VSHUF,   "vshuf",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, 4, IMM))
+	OPINFO3(VADDW,   "vaddw",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VADDSW,  "vaddsw",   4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VSUBW,   "vsubw",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VSUBSW,  "vsubsw",   4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VMINSW,  "vminsw",   4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VMAXSW,  "vmaxsw",   4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VCMPGTW, "vcmpgtw",  4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VAND,    "vand",     4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VOR,     "vor",      4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VXOR,    "vxor",     4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VMULLW,  "vmullw",   4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VMULHW,  "vmulhw",   4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
+	OPINFO3(VSATW,   "vsatw",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, PTR), PINFO(IN, OP, PTR), PINFO(IN, OP, PTR))
 };
 
 
@@ -444,6 +457,12 @@ void uml::instruction::simplify()
 				}
 				break;
 
+			// CARRY: no-op if no flags needed
+			case OP_CARRY:
+				if (m_flags == 0)
+					nop();
+				break;
+
 			// SET: convert to MOV if constant condition
 			case OP_SET:
 				if (m_condition == COND_ALWAYS)
@@ -544,9 +563,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((UINT32)((UINT32)m_param[1].immediate() * (UINT32)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT32)((UINT32)m_param[2].immediate() * (UINT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((UINT64)((UINT64)m_param[1].immediate() * (UINT64)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT64)((UINT64)m_param[2].immediate() * (UINT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -560,41 +579,43 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((INT32)((INT32)m_param[1].immediate() * (INT32)m_param[2].immediate()));
+							convert_to_mov_immediate((INT32)((INT32)m_param[2].immediate() * (INT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((INT64)((INT64)m_param[1].immediate() * (INT64)m_param[2].immediate()));
+							convert_to_mov_immediate((INT64)((INT64)m_param[2].immediate() * (INT64)m_param[3].immediate()));
 					}
 				}
 				break;
 
-			// DIVU: convert simple form to MOV if immediate, or if dividing with 0
+			// DIVU: convert simple form to MOV if immediate, or if dividing with 0; dividing
+			// by zero leaves the destination alone, so that is left to the back-end
 			case OP_DIVU:
-				if (m_param[0] == m_param[1] && !m_param[3].is_immediate_value(0))
+				if (m_param[0] == m_param[1] && m_param[3].is_immediate() && (m_param[3].immediate() & instsizemask[m_size]) != 0)
 				{
 					if (m_param[2].is_immediate_value(0))
 						convert_to_mov_immediate(0);
-					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
+					else if (m_param[2].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((UINT32)((UINT32)m_param[1].immediate() / (UINT32)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT32)((UINT32)m_param[2].immediate() / (UINT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((UINT64)((UINT64)m_param[1].immediate() / (UINT64)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT64)((UINT64)m_param[2].immediate() / (UINT64)m_param[3].immediate()));
 					}
 				}
 				break;
 
-			// DIVS: convert simple form to MOV if immediate, or if dividing with 0
+			// DIVS: convert simple form to MOV if immediate, or if dividing with 0; dividing
+			// by zero or the most negative number by -1 is left to the back-end
 			case OP_DIVS:
-				if (m_param[0] == m_param[1] && !m_param[3].is_immediate_value(0))
+				if (m_param[0] == m_param[1] && m_param[3].is_immediate() && (m_param[3].immediate() & instsizemask[m_size]) != 0)
 				{
 					if (m_param[2].is_immediate_value(0))
 						convert_to_mov_immediate(0);
-					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
+					else if (m_param[2].is_immediate())
 					{
-						if (m_size == 4)
-							convert_to_mov_immediate((INT32)((INT32)m_param[1].immediate() / (INT32)m_param[2].immediate()));
-						else if (m_size == 8)
-							convert_to_mov_immediate((INT64)((INT64)m_param[1].immediate() / (INT64)m_param[2].immediate()));
+						if (m_size == 4 && ((INT32)m_param[2].immediate() != INT32(0x80000000) || (INT32)m_param[3].immediate() != -1))
+							convert_to_mov_immediate((INT32)((INT32)m_param[2].immediate() / (INT32)m_param[3].immediate()));
+						else if (m_size == 8 && ((INT64)m_param[2].immediate() != (INT64)U64(0x8000000000000000) || (INT64)m_param[3].immediate() != -1))
+							convert_to_mov_immediate((INT64)((INT64)m_param[2].immediate() / (INT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -669,7 +690,7 @@ void uml::instruction::simplify()
 			// SHL: convert to MOV if immediate or shifting by 0
 			case OP_SHL:
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
-					convert_to_mov_immediate(m_param[1].immediate() << m_param[2].immediate());
+					convert_to_mov_immediate(m_param[1].immediate() << (m_param[2].immediate() & (8 * m_size - 1)));
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
 				break;
@@ -679,9 +700,9 @@ void uml::instruction::simplify()
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
 				{
 					if (m_size == 4)
-						convert_to_mov_immediate((UINT32)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((UINT32)m_param[1].immediate() >> (m_param[2].immediate() & 31));
 					else if (m_size == 8)
-						convert_to_mov_immediate((UINT64)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((UINT64)m_param[1].immediate() >> (m_param[2].immediate() & 63));
 				}
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
@@ -692,9 +713,9 @@ void uml::instruction::simplify()
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
 				{
 					if (m_size == 4)
-						convert_to_mov_immediate((INT32)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((INT32)m_param[1].immediate() >> (m_param[2].immediate() & 31));
 					else if (m_size == 8)
-						convert_to_mov_immediate((INT64)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((INT64)m_param[1].immediate() >> (m_param[2].immediate() & 63));
 				}
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
@@ -732,6 +753,12 @@ void uml::instruction::simplify()
 					nop();
 				break;
 
+			// FCMP: no-op if no flags needed
+			case OP_FCMP:
+				if (m_flags == 0)
+					nop();
+				break;
+
 			default:
 				break;
 		}
@@ -848,6 +875,66 @@ UINT8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input/param_is_output - return true
+//  if the given parameter is read/written
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_IN) != 0;
+}
+
+bool uml::instruction::param_is_output(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_is_pointer - return true if the given
+//  parameter is the base of a memory area rather
+//  than a memory operand
+//-------------------------------------------------
+
+bool uml::instruction::param_is_pointer(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].typemask & (PTYPES_PTR | PTYPES_STATE) & ~PTYPES_MEM) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_allows - return true if the given
+//  parameter may be of the given type
+//-------------------------------------------------
+
+bool uml::instruction::param_allows(int paramnum, parameter::parameter_type type) const
+{
+	assert(paramnum < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[paramnum].typemask >> type) & 1) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_size - return the size of the operand
+//  accessed through the given parameter
+//-------------------------------------------------
+
+operand_size uml::instruction::param_size(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	UINT8 size = s_opcode_info_table[m_opcode].param[paramnum].size;
+	if (size >= PSIZE_P1 && size - PSIZE_P1 < m_numparams)
+		return m_param[size - PSIZE_P1].size();
+	if (size == PSIZE_4 || size == PSIZE_8)
+		return operand_size(size);
+	return (m_size == 4) ? SIZE_DWORD : SIZE_QWORD;
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
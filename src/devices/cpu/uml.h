@@ -219,6 +219,23 @@ namespace uml
 		OP_FRECIP,                  // FRECIP  dst,src1
 		OP_FRSQRT,                  // FRSQRT  dst,src1
 
+		// vector operations on 128-bit memory operands of eight 16-bit lanes
+		OP_VMOV,                    // VMOV    dst,src1
+		OP_VSHUF,                   // VSHUF   dst,src1,sel
+		OP_VADDW,                   // VADDW   dst,src1,src2
+		OP_VADDSW,                  // VADDSW  dst,src1,src2
+		OP_VSUBW,                   // VSUBW   dst,src1,src2
+		OP_VSUBSW,                  // VSUBSW  dst,src1,src2
+		OP_VMINSW,                  // VMINSW  dst,src1,src2
+		OP_VMAXSW,                  // VMAXSW  dst,src1,src2
+		OP_VCMPGTW,                 // VCMPGTW dst,src1,src2
+		OP_VAND,                    // VAND    dst,src1,src2
+		OP_VOR,                     // VOR     dst,src1,src2
+		OP_VXOR,                    // VXOR    dst,src1,src2
+		OP_VMULLW,                  // VMULLW  dst,src1,src2
+		OP_VMULHW,                  // VMULHW  dst,src1,src2
+		OP_VSATW,                   // VSATW   dst,lo,hi
+
 		OP_MAX
 	};
 
@@ -407,6 +424,7 @@ namespace uml
 		// setters
 		void set_flags(UINT8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, UINT32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, const parameter &param) { assert(paramnum < m_numparams); assert(param_allows(paramnum, param.type())); m_param[paramnum] = param; }
 
 		// misc
 		std::string disasm(drcuml_state *drcuml = nullptr) const;
@@ -415,6 +433,13 @@ namespace uml
 		UINT8 modified_flags() const;
 		void simplify();
 
+		// parameter information
+		bool param_is_input(int paramnum) const;
+		bool param_is_output(int paramnum) const;
+		bool param_is_pointer(int paramnum) const;
+		bool param_allows(int paramnum, parameter::parameter_type type) const;
+		operand_size param_size(int paramnum) const;
+
 		// compile-time opcodes
 		void handle(code_handle &hand) { configure(OP_HANDLE, 4, hand); }
 		void hash(UINT32 mode, UINT32 pc) { configure(OP_HASH, 4, mode, pc); }
@@ -567,6 +592,23 @@ namespace uml
 		void fdrecip(parameter dst, parameter src1) { configure(OP_FRECIP, 8, dst, src1); }
 		void fdrsqrt(parameter dst, parameter src1) { configure(OP_FRSQRT, 8, dst, src1); }
 
+		// 128-bit vector operations
+		void vmov(void *dst, const void *src1) { configure(OP_VMOV, 4, parameter::make_memory(dst), parameter::make_memory(src1)); }
+		void vshuf(void *dst, const void *src1, UINT32 sel) { configure(OP_VSHUF, 4, parameter::make_memory(dst), parameter::make_memory(src1), sel); }
+		void vaddw(void *dst, const void *src1, const void *src2) { configure(OP_VADDW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vaddsw(void *dst, const void *src1, const void *src2) { configure(OP_VADDSW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vsubw(void *dst, const void *src1, const void *src2) { configure(OP_VSUBW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vsubsw(void *dst, const void *src1, const void *src2) { configure(OP_VSUBSW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vminsw(void *dst, const void *src1, const void *src2) { configure(OP_VMINSW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vmaxsw(void *dst, const void *src1, const void *src2) { configure(OP_VMAXSW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vcmpgtw(void *dst, const void *src1, const void *src2) { configure(OP_VCMPGTW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vand(void *dst, const void *src1, const void *src2) { configure(OP_VAND, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vor(void *dst, const void *src1, const void *src2) { configure(OP_VOR, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vxor(void *dst, const void *src1, const void *src2) { configure(OP_VXOR, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vmullw(void *dst, const void *src1, const void *src2) { configure(OP_VMULLW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vmulhw(void *dst, const void *src1, const void *src2) { configure(OP_VMULHW, 4, parameter::make_memory(dst), parameter::make_memory(src1), parameter::make_memory(src2)); }
+		void vsatw(void *dst, const void *lo, const void *hi) { configure(OP_VSATW, 4, parameter::make_memory(dst), parameter::make_memory(lo), parameter::make_memory(hi)); }
+
 		// constants
 		static const int MAX_PARAMS = 4;
 
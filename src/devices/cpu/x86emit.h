@@ -1273,6 +1273,14 @@ inline void emit_op(x86code *&emitptr, UINT32 op, UINT8 opsize, UINT8 reg, UINT8
 	if (opsize == OP_16BIT)
 		emit_byte(emitptr, PREFIX_OPSIZE);
 
+	// mandatory SSE prefixes have to come before the REX byte
+	UINT8 prefix = (op >> 16) & 0xff;
+	if (prefix != 0 && prefix != 0x0f)
+	{
+		emit_byte(emitptr, prefix);
+		op &= ~0xff0000;
+	}
+
 #if (X86EMIT_SIZE == 64)
 {
 	UINT8 rex;
@@ -3181,6 +3189,72 @@ inline void emit_cvttpd2dq_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref m
 inline void emit_roundpd_r128_r128_imm(x86code *&emitptr, UINT8 dreg, UINT8 sreg, UINT8 imm)        { emit_op_modrm_reg(emitptr, OP_ROUNDPD_Vdq_Wdq_Ib, OP_32BIT, dreg, sreg); emit_byte(emitptr, imm); }
 inline void emit_roundpd_r128_m128_imm(x86code *&emitptr, UINT8 dreg, x86_memref memref, UINT8 imm) { emit_op_modrm_mem(emitptr, OP_ROUNDPD_Vdq_Wdq_Ib, OP_32BIT, dreg, memref); emit_byte(emitptr, imm); }
 
+
+
+//**************************************************************************
+//  SSE PACKED INTEGER EMITTERS
+//**************************************************************************
+
+inline void emit_movdqa_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)            { emit_op_modrm_reg(emitptr, OP_MOVDQA_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_movdqu_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)     { emit_op_modrm_mem(emitptr, OP_MOVDQU_Vdq_Wdq, OP_32BIT, dreg, memref); }
+inline void emit_movdqu_m128_r128(x86code *&emitptr, x86_memref memref, UINT8 sreg)     { emit_op_modrm_mem(emitptr, OP_MOVDQU_Wdq_Vdq, OP_32BIT, sreg, memref); }
+
+inline void emit_paddw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)             { emit_op_modrm_reg(emitptr, OP_PADDW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_paddw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)      { emit_op_modrm_mem(emitptr, OP_PADDW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_paddsw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)            { emit_op_modrm_reg(emitptr, OP_PADDSW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_paddsw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)     { emit_op_modrm_mem(emitptr, OP_PADDSW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_psubw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)             { emit_op_modrm_reg(emitptr, OP_PSUBW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_psubw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)      { emit_op_modrm_mem(emitptr, OP_PSUBW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_psubsw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)            { emit_op_modrm_reg(emitptr, OP_PSUBSW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_psubsw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)     { emit_op_modrm_mem(emitptr, OP_PSUBSW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pminsw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)            { emit_op_modrm_reg(emitptr, OP_PMINSW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_pminsw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)     { emit_op_modrm_mem(emitptr, OP_PMINSW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pmaxsw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)            { emit_op_modrm_reg(emitptr, OP_PMAXSW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_pmaxsw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)     { emit_op_modrm_mem(emitptr, OP_PMAXSW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pcmpgtw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)           { emit_op_modrm_reg(emitptr, OP_PCMPGTW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_pcmpgtw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)    { emit_op_modrm_mem(emitptr, OP_PCMPGTW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pand_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)              { emit_op_modrm_reg(emitptr, OP_PAND_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_pand_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)       { emit_op_modrm_mem(emitptr, OP_PAND_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_por_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)               { emit_op_modrm_reg(emitptr, OP_POR_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_por_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)        { emit_op_modrm_mem(emitptr, OP_POR_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pxor_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)              { emit_op_modrm_reg(emitptr, OP_PXOR_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_pxor_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)       { emit_op_modrm_mem(emitptr, OP_PXOR_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pmullw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)            { emit_op_modrm_reg(emitptr, OP_PMULLW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_pmullw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)     { emit_op_modrm_mem(emitptr, OP_PMULLW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pmulhw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)            { emit_op_modrm_reg(emitptr, OP_PMULHW_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_pmulhw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)     { emit_op_modrm_mem(emitptr, OP_PMULHW_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_punpcklwd_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)         { emit_op_modrm_reg(emitptr, OP_PUNPCKLWD_Vdq_Wdq, OP_32BIT, dreg, sreg); }
+inline void emit_punpcklwd_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)  { emit_op_modrm_mem(emitptr, OP_PUNPCKLWD_Vdq_Wdq, OP_32BIT, dreg, memref); }
+
+inline void emit_punpckhwd_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)         { emit_op_modrm_reg(emitptr, OP_PUNPCKHWD_Vdq_Qdq, OP_32BIT, dreg, sreg); }
+inline void emit_punpckhwd_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)  { emit_op_modrm_mem(emitptr, OP_PUNPCKHWD_Vdq_Qdq, OP_32BIT, dreg, memref); }
+
+inline void emit_packssdw_r128_r128(x86code *&emitptr, UINT8 dreg, UINT8 sreg)          { emit_op_modrm_reg(emitptr, OP_PACKSSDW_Vdq_Qdq, OP_32BIT, dreg, sreg); }
+inline void emit_packssdw_r128_m128(x86code *&emitptr, UINT8 dreg, x86_memref memref)   { emit_op_modrm_mem(emitptr, OP_PACKSSDW_Vdq_Qdq, OP_32BIT, dreg, memref); }
+
+inline void emit_pshufd_r128_r128_imm(x86code *&emitptr, UINT8 dreg, UINT8 sreg, UINT8 imm)                 { emit_op_modrm_reg(emitptr, OP_PSHUFD_Vdq_Wdq_Ib, OP_32BIT, dreg, sreg); emit_byte(emitptr, imm); }
+inline void emit_pshufd_r128_m128_imm(x86code *&emitptr, UINT8 dreg, x86_memref memref, UINT8 imm)          { emit_op_modrm_mem(emitptr, OP_PSHUFD_Vdq_Wdq_Ib, OP_32BIT, dreg, memref); emit_byte(emitptr, imm); }
+inline void emit_pshuflw_r128_r128_imm(x86code *&emitptr, UINT8 dreg, UINT8 sreg, UINT8 imm)                { emit_op_modrm_reg(emitptr, OP_PSHUFLW_Vdq_Wdq_Ib, OP_32BIT, dreg, sreg); emit_byte(emitptr, imm); }
+inline void emit_pshuflw_r128_m128_imm(x86code *&emitptr, UINT8 dreg, x86_memref memref, UINT8 imm)         { emit_op_modrm_mem(emitptr, OP_PSHUFLW_Vdq_Wdq_Ib, OP_32BIT, dreg, memref); emit_byte(emitptr, imm); }
+inline void emit_pshufhw_r128_r128_imm(x86code *&emitptr, UINT8 dreg, UINT8 sreg, UINT8 imm)                { emit_op_modrm_reg(emitptr, OP_PSHUFHW_Vdq_Wdq_Ib, OP_32BIT, dreg, sreg); emit_byte(emitptr, imm); }
+inline void emit_pshufhw_r128_m128_imm(x86code *&emitptr, UINT8 dreg, x86_memref memref, UINT8 imm)         { emit_op_modrm_mem(emitptr, OP_PSHUFHW_Vdq_Wdq_Ib, OP_32BIT, dreg, memref); emit_byte(emitptr, imm); }
+
+inline void emit_pextrw_r32_r128_imm(x86code *&emitptr, UINT8 dreg, UINT8 sreg, UINT8 imm)                  { emit_op_modrm_reg(emitptr, OP_PEXTRW_Gw_Vw_Ib, OP_32BIT, dreg, sreg); emit_byte(emitptr, imm); }
+inline void emit_pinsrw_r128_r32_imm(x86code *&emitptr, UINT8 dreg, UINT8 sreg, UINT8 imm)                  { emit_op_modrm_reg(emitptr, OP_PINSRW_Vw_Ew_Ib, OP_32BIT, dreg, sreg); emit_byte(emitptr, imm); }
+inline void emit_pinsrw_r128_m16_imm(x86code *&emitptr, UINT8 dreg, x86_memref memref, UINT8 imm)           { emit_op_modrm_mem(emitptr, OP_PINSRW_Vw_Ew_Ib, OP_32BIT, dreg, memref); emit_byte(emitptr, imm); }
+
 }
 
 #undef X86EMIT_SIZE
@@ -192,4 +192,6 @@ ym2203_device::ym2203_device(const machine_config &mconfig, const char *tag, dev
 	: ay8910_device(mconfig, YM2203, "YM2203", tag, owner, clock, PSG_TYPE_YM, 3, 2, "ym2203", __FILE__),
 		m_irq_handler(*this)
 {
+	// the FM core changes status flags shared with the CPU while it generates samples
+	set_parallel_update(false);
 }
@@ -189,6 +189,8 @@ ym2608_device::ym2608_device(const machine_config &mconfig, const char *tag, dev
 	: ay8910_device(mconfig, YM2608, "YM2608", tag, owner, clock, PSG_TYPE_YM, 1, 2, "ym2608", __FILE__),
 		m_irq_handler(*this)
 {
+	// the FM core changes status flags shared with the CPU while it generates samples
+	set_parallel_update(false);
 }
 
 ROM_START( ym2608 )
@@ -213,12 +213,16 @@ ym2610_device::ym2610_device(const machine_config &mconfig, const char *tag, dev
 	: ay8910_device(mconfig, YM2610, "YM2610", tag, owner, clock, PSG_TYPE_YM, 1, 0, "ym2610", __FILE__)
 	, m_irq_handler(*this)
 {
+	// the FM core changes status flags shared with the CPU while it generates samples
+	set_parallel_update(false);
 }
 
 ym2610_device::ym2610_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source)
 	: ay8910_device(mconfig, type, name, tag, owner, clock, PSG_TYPE_YM, 1, 0, shortname, source)
 	, m_irq_handler(*this)
 {
+	// the FM core changes status flags shared with the CPU while it generates samples
+	set_parallel_update(false);
 }
 
 const device_type YM2610B = &device_creator<ym2610b_device>;
@@ -1163,6 +1163,7 @@ ay8910_device::ay8910_device(const machine_config &mconfig, const char *tag, dev
 	memset(&m_env_table,0,sizeof(m_env_table));
 	memset(&m_vol3d_table,0,sizeof(m_vol3d_table));
 	m_res_load[0] = m_res_load[1] = m_res_load[2] = 1000; //Default values for resistor loads
+	set_parallel_update(true);
 }
 
 ay8910_device::ay8910_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock,
@@ -1205,6 +1206,7 @@ ay8910_device::ay8910_device(const machine_config &mconfig, device_type type, co
 	memset(&m_env_table,0,sizeof(m_env_table));
 	memset(&m_vol3d_table,0,sizeof(m_vol3d_table));
 	m_res_load[0] = m_res_load[1] = m_res_load[2] = 1000; //Default values for resistor loads
+	set_parallel_update(true);
 }
 
 const device_type AY8912 = &device_creator<ay8912_device>;
@@ -30,6 +30,7 @@ dac_device::dac_device(const machine_config &mconfig, const char *tag, device_t
 		m_stream(nullptr),
 		m_output(0)
 {
+	set_parallel_update(true);
 }
 
 
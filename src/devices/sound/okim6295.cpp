@@ -98,6 +98,7 @@ okim6295_device::okim6295_device(const machine_config &mconfig, const char *tag,
 		m_pin7_state(0),
 		m_direct(nullptr)
 {
+	set_parallel_update(true);
 }
 
 
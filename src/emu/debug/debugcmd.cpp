@@ -150,6 +150,9 @@ static void execute_snap(running_machine &machine, int ref, int params, const ch
 static void execute_source(running_machine &machine, int ref, int params, const char **param);
 static void execute_map(running_machine &machine, int ref, int params, const char **param);
 static void execute_memdump(running_machine &machine, int ref, int params, const char **param);
+static void execute_heatmap(running_machine &machine, int ref, int params, const char **param);
+static void execute_heatlist(running_machine &machine, int ref, int params, const char **param);
+static void execute_heatsave(running_machine &machine, int ref, int params, const char **param);
 static void execute_symlist(running_machine &machine, int ref, int params, const char **param);
 static void execute_softreset(running_machine &machine, int ref, int params, const char **param);
 static void execute_hardreset(running_machine &machine, int ref, int params, const char **param);
@@ -390,6 +393,9 @@ void debug_command_init(running_machine &machine)
 	debug_console_register_command(machine, "mapd",      CMDFLAG_NONE, AS_DATA, 1, 1, execute_map);
 	debug_console_register_command(machine, "mapi",      CMDFLAG_NONE, AS_IO, 1, 1, execute_map);
 	debug_console_register_command(machine, "memdump",   CMDFLAG_NONE, 0, 0, 1, execute_memdump);
+	debug_console_register_command(machine, "heatmap",   CMDFLAG_NONE, 0, 1, 2, execute_heatmap);
+	debug_console_register_command(machine, "heatlist",  CMDFLAG_NONE, 0, 0, 1, execute_heatlist);
+	debug_console_register_command(machine, "heatsave",  CMDFLAG_NONE, 0, 1, 1, execute_heatsave);
 
 	debug_console_register_command(machine, "symlist",   CMDFLAG_NONE, 0, 0, 1, execute_symlist);
 
@@ -2921,6 +2927,87 @@ static void execute_memdump(running_machine &machine, int ref, int params, const
 }
 
 
+/*-------------------------------------------------
+    execute_heatmap - execute the heatmap command
+-------------------------------------------------*/
+
+static void execute_heatmap(running_machine &machine, int ref, int params, const char **param)
+{
+	UINT64 enable;
+	if (!debug_command_parameter_number(machine, param[0], &enable))
+		return;
+
+	/* with a CPU, only its spaces; otherwise every space */
+	device_t *cpu = nullptr;
+	if (params > 1 && !debug_command_parameter_cpu(machine, param[1], &cpu))
+		return;
+
+	int count = 0;
+	for (address_space *space = machine.memory().first_space(); space != nullptr; space = space->next())
+		if (cpu == nullptr || &space->device() == cpu)
+		{
+			machine.memory().enable_heatmap(*space, enable != 0);
+			count++;
+		}
+
+	if (enable)
+		debug_console_printf(machine, "Counting accesses in %d address spaces\n", count);
+	else
+		debug_console_printf(machine, "Stopped counting accesses in %d address spaces\n", count);
+}
+
+
+/*-------------------------------------------------
+    execute_heatlist - execute the heatlist command
+-------------------------------------------------*/
+
+static void execute_heatlist(running_machine &machine, int ref, int params, const char **param)
+{
+	UINT64 count = 20;
+	if (!debug_command_parameter_number(machine, param[0], &count))
+		return;
+
+	std::vector<memory_heat_entry> totals, lastframe;
+	machine.memory().heatmap_totals(totals);
+	machine.memory().heatmap_last_frame(lastframe);
+	if (totals.empty())
+	{
+		debug_console_printf(machine, "No accesses counted; use heatmap to start counting\n");
+		return;
+	}
+
+	debug_console_printf(machine, "%" I64FMT "u frames\n", machine.memory().heatmap_frames());
+	for (size_t index = 0; index < totals.size() && index < count; index++)
+	{
+		const memory_heat_entry &entry = totals[index];
+		address_space &space = *entry.m_space;
+
+		/* find the same entry in the last frame */
+		UINT64 last = 0;
+		for (const memory_heat_entry &other : lastframe)
+			if (other.m_space == entry.m_space && other.m_row == entry.m_row && other.m_entry == entry.m_entry)
+				last = other.m_count;
+
+		debug_console_printf(machine, "%s %s %c %s-%s %12" I64FMT "u %10" I64FMT "u  %s\n", space.device().tag(), space.name(), (entry.m_row == ROW_READ) ? 'R' : 'W',
+				core_i64_hex_format(space.byte_to_address(entry.m_bytestart), space.addrchars()), core_i64_hex_format(space.byte_to_address_end(entry.m_byteend), space.addrchars()),
+				entry.m_count, last, entry.m_name.c_str());
+	}
+}
+
+
+/*-------------------------------------------------
+    execute_heatsave - execute the heatsave command
+-------------------------------------------------*/
+
+static void execute_heatsave(running_machine &machine, int ref, int params, const char **param)
+{
+	if (machine.memory().heatmap_save(param[0]))
+		debug_console_printf(machine, "Saved memory access counts to %s\n", param[0]);
+	else
+		debug_console_printf(machine, "Error creating file '%s'\n", param[0]);
+}
+
+
 /*-------------------------------------------------
     execute_symlist - execute the symlist command
 -------------------------------------------------*/
@@ -122,6 +122,9 @@ static const help_item static_help_list[] =
 		"  mapd <address> -- map logical data address to physical address and bank\n"
 		"  mapi <address> -- map logical I/O address to physical address and bank\n"
 		"  memdump [<filename>] -- dump the current memory map to <filename>\n"
+		"  heatmap <bool>[,<cpu>] -- count accesses per memory handler in every space or just <cpu>'s\n"
+		"  heatlist [<count>] -- list the most accessed memory handlers\n"
+		"  heatsave <filename> -- save the memory handler access counts as CSV or JSON\n"
 	},
 	{
 		"execution",
@@ -1222,6 +1225,58 @@ static const help_item static_help_list[] =
 		"memdump\n"
 		"  Dumps memory to memdump.log.\n"
 	},
+	{
+		"heatmap",
+		"\n"
+		"  heatmap <bool>[,<cpu>]\n"
+		"\n"
+		"Starts (1) or stops (0) counting the reads and writes that reach each memory handler and RAM "
+		"bank. With <cpu>, only that CPU's address spaces are counted; otherwise every address space "
+		"is. Starting clears any previous counts. The counts are gathered once per frame, so the "
+		"totals and the last frame can be compared with heatlist. While counting, every access goes "
+		"through the same slow path as a watchpoint; opcode fetches through direct pointers are not "
+		"counted.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"heatmap 1\n"
+		"  Counts accesses in every address space.\n"
+		"\n"
+		"heatmap 1,1\n"
+		"  Counts accesses in the address spaces of CPU 1 only.\n"
+		"\n"
+		"heatmap 0\n"
+		"  Stops counting everywhere.\n"
+	},
+	{
+		"heatlist",
+		"\n"
+		"  heatlist [<count>]\n"
+		"\n"
+		"Lists the <count> memory handlers with the most accesses since counting started, hottest "
+		"first, along with their accesses in the last frame. <count> defaults to 20.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"heatlist\n"
+		"  Lists the 20 most accessed handlers.\n"
+		"\n"
+		"heatlist #50\n"
+		"  Lists the 50 most accessed handlers.\n"
+	},
+	{
+		"heatsave",
+		"\n"
+		"  heatsave <filename>\n"
+		"\n"
+		"Saves the access counts to <filename>: the counts for each of the last 3600 frames, followed "
+		"by the totals. The file is JSON if <filename> ends in .json and CSV otherwise.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"heatsave heat.csv\n"
+		"  Saves the counts as CSV to heat.csv.\n"
+	},
 	{
 		"comadd",
 		"\n"
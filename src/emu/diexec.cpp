@@ -47,9 +47,11 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 		m_vblank_interrupt_screen(nullptr),
 		m_timed_interrupt_period(attotime::zero),
 		m_is_octal(false),
+		m_execute_group(0),
 		m_nextexec(nullptr),
 		m_timedint_timer(nullptr),
 		m_profiler(PROFILER_IDLE),
+		m_profile_ticks(0),
 		m_icountptr(nullptr),
 		m_cycles_running(0),
 		m_cycles_stolen(0),
@@ -95,6 +97,23 @@ void device_execute_interface::static_set_disable(device_t &device)
 }
 
 
+//-------------------------------------------------
+//  static_set_execute_group - configuration
+//  helper to place a device in a group that may
+//  run in parallel with the rest of the system
+//-------------------------------------------------
+
+void device_execute_interface::static_set_execute_group(device_t &device, int group)
+{
+	device_execute_interface *exec;
+	if (!device.interface(exec))
+		throw emu_fatalerror("MCFG_DEVICE_EXECUTE_GROUP called on device '%s' with no execute interface", device.tag());
+	if (group < 0)
+		throw emu_fatalerror("MCFG_DEVICE_EXECUTE_GROUP called on device '%s' with a negative group", device.tag());
+	exec->m_execute_group = group;
+}
+
+
 //-------------------------------------------------
 //  static_set_vblank_int - configuration helper
 //  to set up VBLANK interrupts on the device
@@ -239,6 +258,9 @@ void device_execute_interface::suspend_resume_changed()
 void device_execute_interface::suspend(UINT32 reason, bool eatcycles)
 {
 if (TEMPLOG) printf("suspend %s (%X)\n", device().tag(), reason);
+	// devices in other execution groups may call this from their own thread
+	auto lock = m_scheduler->group_lock();
+
 	// set the suspend reason and eat cycles flag
 	m_nextsuspend |= reason;
 	m_nexteatcycles = eatcycles;
@@ -254,6 +276,8 @@ if (TEMPLOG) printf("suspend %s (%X)\n", device().tag(), reason);
 void device_execute_interface::resume(UINT32 reason)
 {
 if (TEMPLOG) printf("resume %s (%X)\n", device().tag(), reason);
+	auto lock = m_scheduler->group_lock();
+
 	// clear the suspend reason and eat cycles flag
 	m_nextsuspend &= ~reason;
 	suspend_resume_changed();
@@ -268,6 +292,7 @@ if (TEMPLOG) printf("resume %s (%X)\n", device().tag(), reason);
 void device_execute_interface::spin_until_time(const attotime &duration)
 {
 	static int timetrig = 0;
+	auto lock = m_scheduler->group_lock();
 
 	// suspend until the given trigger fires
 	suspend_until_trigger(TRIGGER_SUSPENDTIME + timetrig, true);
@@ -285,6 +310,9 @@ void device_execute_interface::spin_until_time(const attotime &duration)
 
 void device_execute_interface::suspend_until_trigger(int trigid, bool eatcycles)
 {
+	// hold the lock so a trigger can't slip in between the two steps
+	auto lock = m_scheduler->group_lock();
+
 	// suspend the device immediately if it's not already
 	suspend(SUSPEND_REASON_TRIGGER, eatcycles);
 
@@ -299,6 +327,8 @@ void device_execute_interface::suspend_until_trigger(int trigid, bool eatcycles)
 
 void device_execute_interface::trigger(int trigid)
 {
+	auto lock = m_scheduler->group_lock();
+
 	// if we're executing, for an immediate abort
 	abort_timeslice();
 
@@ -777,6 +807,9 @@ if (TEMPLOG) printf("setline(%s,%d,%d,%d)\n", m_execute->device().tag(), m_linen
 		return;
 	}
 
+	// CPUs in other execution groups can drive this line from their own thread
+	auto lock = m_execute->scheduler().group_lock();
+
 	// if we're full of events, flush the queue and log a message
 	int event_index = m_qindex++;
 	if (event_index >= ARRAY_LENGTH(m_queue))
@@ -87,6 +87,8 @@ enum
 
 #define MCFG_DEVICE_DISABLE() \
 	device_execute_interface::static_set_disable(*device);
+#define MCFG_DEVICE_EXECUTE_GROUP(_group) \
+	device_execute_interface::static_set_execute_group(*device, _group);
 #define MCFG_DEVICE_VBLANK_INT_DRIVER(_tag, _class, _func) \
 	device_execute_interface::static_set_vblank_int(*device, device_interrupt_delegate(&_class::_func, #_class "::" #_func, DEVICE_SELF, (_class *)0), _tag);
 #define MCFG_DEVICE_VBLANK_INT_DEVICE(_tag, _devtag, _class, _func) \
@@ -147,9 +149,11 @@ public:
 	UINT32 input_lines() const { return execute_input_lines(); }
 	UINT32 default_irq_vector() const { return execute_default_irq_vector(); }
 	bool is_octal() const { return m_is_octal; }
+	int execute_group() const { return m_execute_group; }
 
 	// static inline configuration helpers
 	static void static_set_disable(device_t &device);
+	static void static_set_execute_group(device_t &device, int group);
 	static void static_set_vblank_int(device_t &device, device_interrupt_delegate function, const char *tag, int rate = 0);
 	static void static_set_periodic_int(device_t &device, device_interrupt_delegate function, const attotime &rate);
 	static void static_set_irq_acknowledge_callback(device_t &device, device_irq_acknowledge_delegate callback);
@@ -186,6 +190,7 @@ public:
 	// time and cycle accounting
 	attotime local_time() const;
 	UINT64 total_cycles() const;
+	const osd_ticks_t &profile_ticks() const { return m_profile_ticks; }
 
 	// required operation overrides
 	void run() { execute_run(); }
@@ -261,6 +266,7 @@ protected:
 	device_interrupt_delegate m_timed_interrupt;        // for interrupts not tied to VBLANK
 	attotime                m_timed_interrupt_period;   // period for periodic interrupts
 	bool                    m_is_octal;                 // to determine if messages/debugger will show octal or hex
+	int                     m_execute_group;            // group for parallel execution (0 = main thread)
 
 	// execution lists
 	device_execute_interface *m_nextexec;               // pointer to the next device to execute, in order
@@ -272,6 +278,7 @@ protected:
 
 	// cycle counting and executing
 	profile_type            m_profiler;                 // profiler tag
+	osd_ticks_t             m_profile_ticks;            // real time spent executing, when reporting
 	int *                   m_icountptr;                // pointer to the icount
 	int                     m_cycles_running;           // number of cycles we are executing
 	int                     m_cycles_stolen;            // number of cycles we artificially stole
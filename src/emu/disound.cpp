@@ -23,7 +23,8 @@
 device_sound_interface::device_sound_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "sound"),
 		m_outputs(0),
-		m_auto_allocated_inputs(0)
+		m_auto_allocated_inputs(0),
+		m_parallel_update(false)
 {
 }
 
@@ -383,6 +384,8 @@ device_mixer_interface::device_mixer_interface(const machine_config &mconfig, de
 		m_outputs(outputs),
 		m_mixer_stream(nullptr)
 {
+	// mixing only reads our inputs
+	set_parallel_update(true);
 }
 
 
@@ -89,6 +89,7 @@ public:
 
 	// configuration access
 	const sound_route *first_route() const { return m_route_list.first(); }
+	bool parallel_update() const { return m_parallel_update; }
 
 	// static inline configuration helpers
 	static sound_route &static_add_route(device_t &device, UINT32 output, const char *target, double gain, UINT32 input = AUTO_ALLOC_INPUT, UINT32 mixoutput = 0);
@@ -110,6 +111,12 @@ public:
 	int inputnum_from_device(device_t &device, int outputnum = 0) const;
 
 protected:
+	// devices whose sound_stream_update only touches their own state and
+	// never raises interrupts, fires callbacks or adjusts timers call this
+	// from their constructor; only their streams are updated off the main
+	// thread with -parallel_sound
+	void set_parallel_update(bool parallel) { m_parallel_update = parallel; }
+
 	// optional operation overrides
 	virtual void interface_validity_check(validity_checker &valid) const override;
 	virtual void interface_pre_start() override;
@@ -120,6 +127,7 @@ protected:
 	simple_list<sound_route> m_route_list;      // list of sound routes
 	int             m_outputs;                  // number of outputs from this instance
 	int             m_auto_allocated_inputs;    // number of auto-allocated inputs targeting us
+	bool            m_parallel_update;          // can our streams be updated on a worker thread?
 };
 
 // iterator
@@ -229,8 +229,7 @@ void gfx_element::set_layout(const gfx_layout &gl, const UINT8 *srcdata)
 	}
 
 	// mark everything dirty
-	m_dirty.resize(m_total_elements);
-	memset(&m_dirty[0], 1, m_total_elements);
+	reset_dirty();
 
 	// allocate a pen usage array for entries with 32 pens or less
 	if (m_color_depth <= 32)
@@ -265,7 +264,7 @@ void gfx_element::set_raw_layout(const UINT8 *srcdata, UINT32 width, UINT32 heig
 void gfx_element::set_source(const UINT8 *source)
 {
 	m_srcdata = source;
-	memset(&m_dirty[0], 1, elements());
+	mark_all_dirty();
 	if (m_layout_is_raw) m_gfxdata = const_cast<UINT8 *>(source);
 }
 
@@ -281,8 +280,7 @@ void gfx_element::set_source_and_total(const UINT8 *source, UINT32 total)
 	m_total_elements = total;
 
 	// mark everything dirty
-	m_dirty.resize(m_total_elements);
-	memset(&m_dirty[0], 1, m_total_elements);
+	reset_dirty();
 
 	// allocate a pen usage array for entries with 32 pens or less
 	if (m_color_depth <= 32)
@@ -325,6 +323,12 @@ void gfx_element::set_source_clip(UINT32 xoffs, UINT32 width, UINT32 yoffs, UINT
 
 void gfx_element::decode(UINT32 code)
 {
+	// bands of a screen update may reach the same dirty element at once; only
+	// the first one to get here decodes it
+	std::lock_guard<std::mutex> lock(m_decode_lock);
+	if (!m_dirty[code].load(std::memory_order_relaxed))
+		return;
+
 	// don't decode GFX_RAW
 	if (!m_layout_is_raw)
 	{
@@ -371,8 +375,34 @@ void gfx_element::decode(UINT32 code)
 		m_pen_usage[code] = usage;
 	}
 
-	// no longer dirty
-	m_dirty[code] = 0;
+	// no longer dirty; publish the decoded data to bands that skip the lock
+	m_dirty[code].store(0, std::memory_order_release);
+}
+
+
+//-------------------------------------------------
+//  mark_all_dirty - force every element to be
+//  decoded again
+//-------------------------------------------------
+
+void gfx_element::mark_all_dirty()
+{
+	for (UINT32 code = 0; code < elements(); code++)
+		m_dirty[code].store(1, std::memory_order_relaxed);
+}
+
+
+//-------------------------------------------------
+//  reset_dirty - size the dirty array for the
+//  current element count and mark it all dirty
+//-------------------------------------------------
+
+void gfx_element::reset_dirty()
+{
+	// atomics can't be moved, so build a fresh array instead of resizing
+	if (m_dirty.size() != m_total_elements)
+		std::vector<std::atomic<UINT8>>(m_total_elements).swap(m_dirty);
+	mark_all_dirty();
 }
 
 
@@ -391,8 +421,7 @@ void gfx_element::opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 {
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_rebase_opaque(color));
 }
 
 void gfx_element::opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -400,8 +429,7 @@ void gfx_element::opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
 {
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_remap_opaque(paldata));
 }
 
 
@@ -434,8 +462,7 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transpen(color, trans_pen));
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -462,8 +489,7 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_remap_transpen(paldata, trans_pen));
 }
 
 
@@ -483,8 +509,7 @@ void gfx_element::transpen_raw(bitmap_ind16 &dest, const rectangle &cliprect,
 		return;
 
 	// render
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transpen(color, trans_pen));
 }
 
 void gfx_element::transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -497,8 +522,7 @@ void gfx_element::transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
 		return;
 
 	// render
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transpen(color, trans_pen));
 }
 
 
@@ -532,8 +556,7 @@ void gfx_element::transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSMASK, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transmask(color, trans_mask));
 }
 
 void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -560,8 +583,7 @@ void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_remap_transmask(paldata, trans_mask));
 }
 
 
@@ -581,8 +603,7 @@ void gfx_element::transtable(bitmap_ind16 &dest, const rectangle &cliprect,
 	color = colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSTABLE16, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_transtable(drawgfx_rebase_opaque(color), pentable, shadowtable));
 }
 
 void gfx_element::transtable(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -595,8 +616,7 @@ void gfx_element::transtable(bitmap_rgb32 &dest, const rectangle &cliprect,
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_transtable(drawgfx_remap_opaque(paldata), pentable, shadowtable));
 }
 
 
@@ -621,8 +641,7 @@ void gfx_element::alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// get final code and color, and grab lookup tables
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, drawgfx_remap_transpen_alpha(paldata, trans_pen, alpha_val));
 }
 
 
@@ -647,8 +666,7 @@ void gfx_element::zoom_opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_rebase_opaque(color));
 }
 
 void gfx_element::zoom_opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -662,8 +680,7 @@ void gfx_element::zoom_opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_remap_opaque(paldata));
 }
 
 
@@ -700,8 +717,7 @@ void gfx_element::zoom_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transpen(color, trans_pen));
 }
 
 void gfx_element::zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -732,8 +748,7 @@ void gfx_element::zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_remap_transpen(paldata, trans_pen));
 }
 
 
@@ -757,8 +772,7 @@ void gfx_element::zoom_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprec
 		return;
 
 	// render
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transpen(color, trans_pen));
 }
 
 void gfx_element::zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -775,8 +789,7 @@ void gfx_element::zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprec
 		return;
 
 	// render
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transpen(color, trans_pen));
 }
 
 
@@ -814,8 +827,7 @@ void gfx_element::zoom_transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSMASK, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_rebase_transmask(color, trans_mask));
 }
 
 void gfx_element::zoom_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -846,8 +858,7 @@ void gfx_element::zoom_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_remap_transmask(paldata, trans_mask));
 }
 
 
@@ -871,8 +882,7 @@ void gfx_element::zoom_transtable(bitmap_ind16 &dest, const rectangle &cliprect,
 	color = colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSTABLE16, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_transtable(drawgfx_rebase_opaque(color), pentable, shadowtable));
 }
 
 void gfx_element::zoom_transtable(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -889,8 +899,7 @@ void gfx_element::zoom_transtable(bitmap_rgb32 &dest, const rectangle &cliprect,
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_transtable(drawgfx_remap_opaque(paldata), pentable, shadowtable));
 }
 
 
@@ -919,8 +928,7 @@ void gfx_element::zoom_alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DECLARE_NO_PRIORITY;
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY);
+	drawgfxzoom_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_dummy_priority_bitmap, drawgfx_remap_transpen_alpha(paldata, trans_pen, alpha_val));
 }
 
 
@@ -945,7 +953,7 @@ void gfx_element::prio_opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_rebase_opaque(color), pmask));
 }
 
 void gfx_element::prio_opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -958,7 +966,7 @@ void gfx_element::prio_opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_remap_opaque(paldata), pmask));
 }
 
 
@@ -995,7 +1003,7 @@ void gfx_element::prio_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_rebase_transpen(color, trans_pen), pmask));
 }
 
 void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1025,7 +1033,7 @@ void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_remap_transpen(paldata, trans_pen), pmask));
 }
 
 
@@ -1048,7 +1056,7 @@ void gfx_element::prio_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprec
 	pmask |= 1 << 31;
 
 	// render
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_rebase_transpen(color, trans_pen), pmask));
 }
 
 void gfx_element::prio_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1064,7 +1072,7 @@ void gfx_element::prio_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprec
 	pmask |= 1 << 31;
 
 	// render
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_rebase_transpen(color, trans_pen), pmask));
 }
 
 
@@ -1101,7 +1109,7 @@ void gfx_element::prio_transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSMASK_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_rebase_transmask(color, trans_mask), pmask));
 }
 
 void gfx_element::prio_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1131,7 +1139,7 @@ void gfx_element::prio_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_remap_transmask(paldata, trans_mask), pmask));
 }
 
 
@@ -1155,7 +1163,7 @@ void gfx_element::prio_transtable(bitmap_ind16 &dest, const rectangle &cliprect,
 	color = colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSTABLE16_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_transtable(drawgfx_rebase_opaque(color), pentable, shadowtable, pmask));
 }
 
 void gfx_element::prio_transtable(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1171,7 +1179,7 @@ void gfx_element::prio_transtable(bitmap_rgb32 &dest, const rectangle &cliprect,
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_transtable(drawgfx_remap_opaque(paldata), pentable, shadowtable, pmask));
 }
 
 
@@ -1200,7 +1208,7 @@ void gfx_element::prio_alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(drawgfx_remap_transpen_alpha(paldata, trans_pen, alpha_val), pmask));
 }
 
 
@@ -1229,7 +1237,7 @@ void gfx_element::prio_zoom_opaque(bitmap_ind16 &dest, const rectangle &cliprect
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_rebase_opaque(color), pmask));
 }
 
 void gfx_element::prio_zoom_opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1246,7 +1254,7 @@ void gfx_element::prio_zoom_opaque(bitmap_rgb32 &dest, const rectangle &cliprect
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	code %= elements();
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_remap_opaque(paldata), pmask));
 }
 
 
@@ -1288,7 +1296,7 @@ void gfx_element::prio_zoom_transpen(bitmap_ind16 &dest, const rectangle &clipre
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_rebase_transpen(color, trans_pen), pmask));
 }
 
 void gfx_element::prio_zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1323,7 +1331,7 @@ void gfx_element::prio_zoom_transpen(bitmap_rgb32 &dest, const rectangle &clipre
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_remap_transpen(paldata, trans_pen), pmask));
 }
 
 
@@ -1352,7 +1360,7 @@ void gfx_element::prio_zoom_transpen_raw(bitmap_ind16 &dest, const rectangle &cl
 	pmask |= 1 << 31;
 
 	// render
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_rebase_transpen(color, trans_pen), pmask));
 }
 
 void gfx_element::prio_zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1373,7 +1381,7 @@ void gfx_element::prio_zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cl
 	pmask |= 1 << 31;
 
 	// render
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_rebase_transpen(color, trans_pen), pmask));
 }
 
 
@@ -1416,7 +1424,7 @@ void gfx_element::prio_zoom_transmask(bitmap_ind16 &dest, const rectangle &clipr
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSMASK_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_rebase_transmask(color, trans_mask), pmask));
 }
 
 void gfx_element::prio_zoom_transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1451,7 +1459,7 @@ void gfx_element::prio_zoom_transmask(bitmap_rgb32 &dest, const rectangle &clipr
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_remap_transmask(paldata, trans_mask), pmask));
 }
 
 
@@ -1480,7 +1488,7 @@ void gfx_element::prio_zoom_transtable(bitmap_ind16 &dest, const rectangle &clip
 	color = colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSTABLE16_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_transtable(drawgfx_rebase_opaque(color), pentable, shadowtable, pmask));
 }
 
 void gfx_element::prio_zoom_transtable(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1501,7 +1509,7 @@ void gfx_element::prio_zoom_transtable(bitmap_rgb32 &dest, const rectangle &clip
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	const pen_t *shadowtable = m_palette->shadow_table();
 	code %= elements();
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32_PRIORITY, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_transtable(drawgfx_remap_opaque(paldata), pentable, shadowtable, pmask));
 }
 
 
@@ -1536,35 +1544,40 @@ void gfx_element::prio_zoom_alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8);
-}
-
-
-#define PIXEL_OP_REMAP_TRANSPEN_PRIORITY_ADDIIVE32(DEST, PRIORITY, SOURCE)                  \
-do                                                                                  \
-{                                                                                   \
-	UINT32 srcdata = (SOURCE);                                                      \
-	if (srcdata != trans_pen)                                                        \
-	{                                                                               \
-		if (((1 << ((PRIORITY) & 0x1f)) & pmask) == 0)                              \
-		{                                                                           \
-			UINT32 srcdata2 = paldata[srcdata];                                     \
-																					\
-			UINT32 add;                                                             \
-			add = (srcdata2 & 0x00ff0000) + (DEST & 0x00ff0000);                    \
-			if (add & 0x01000000) DEST = (DEST & 0xff00ffff) | (0x00ff0000);        \
-			else DEST = (DEST & 0xff00ffff) | (add & 0x00ff0000);                   \
-			add = (srcdata2 & 0x000000ff) + (DEST & 0x000000ff);                    \
-			if (add & 0x00000100) DEST = (DEST & 0xffffff00) | (0x000000ff);        \
-			else DEST = (DEST & 0xffffff00) | (add & 0x000000ff);                   \
-			add = (srcdata2 & 0x0000ff00) + (DEST & 0x0000ff00);                    \
-			if (add & 0x00010000) DEST = (DEST & 0xffff00ff) | (0x0000ff00);        \
-			else DEST = (DEST & 0xffff00ff) | (add & 0x0000ff00);                   \
-		}                                                                           \
-		(PRIORITY) = 31;                                                            \
-	}                                                                               \
-}                                                                                   \
-while (0)
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(drawgfx_remap_transpen_alpha(paldata, trans_pen, alpha_val), pmask));
+}
+
+
+/*-------------------------------------------------
+    remap_transpen_additive - draw every pen but
+    'trans_pen', adding its color to the
+    destination with saturation
+-------------------------------------------------*/
+
+class remap_transpen_additive : public drawgfx_op<remap_transpen_additive>
+{
+public:
+	remap_transpen_additive(const pen_t *paldata, UINT32 trans_pen) : m_paldata(paldata), m_trans_pen(trans_pen) { }
+	bool draws(UINT32 pen) const { return pen != m_trans_pen; }
+	void draw(UINT32 &dest, UINT32 pen) const
+	{
+		UINT32 srcdata2 = m_paldata[pen];
+
+		UINT32 add;
+		add = (srcdata2 & 0x00ff0000) + (dest & 0x00ff0000);
+		if (add & 0x01000000) dest = (dest & 0xff00ffff) | (0x00ff0000);
+		else dest = (dest & 0xff00ffff) | (add & 0x00ff0000);
+		add = (srcdata2 & 0x000000ff) + (dest & 0x000000ff);
+		if (add & 0x00000100) dest = (dest & 0xffffff00) | (0x000000ff);
+		else dest = (dest & 0xffffff00) | (add & 0x000000ff);
+		add = (srcdata2 & 0x0000ff00) + (dest & 0x0000ff00);
+		if (add & 0x00010000) dest = (dest & 0xffff00ff) | (0x0000ff00);
+		else dest = (dest & 0xffff00ff) | (add & 0x0000ff00);
+	}
+
+	const pen_t *m_paldata;
+	UINT32 m_trans_pen;
+};
 
 void gfx_element::prio_transpen_additive(bitmap_rgb32 &dest, const rectangle &cliprect,
 		UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,
@@ -1594,7 +1607,7 @@ void gfx_element::prio_transpen_additive(bitmap_rgb32 &dest, const rectangle &cl
 	pmask |= 1 << 31;
 
 	/* render based on dest bitmap depth */
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY_ADDIIVE32, UINT8);
+	drawgfx_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, priority, drawgfx_pmask(remap_transpen_additive(paldata, trans_pen), pmask));
 }
 
 
@@ -1634,39 +1647,44 @@ void gfx_element::prio_zoom_transpen_additive(bitmap_rgb32 &dest, const rectangl
 	/* high bit of the mask is implicitly on */
 	pmask |= 1 << 31;
 
-	DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY_ADDIIVE32, UINT8);
+	drawgfxzoom_core<UINT8>(dest, cliprect, *this, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_pmask(remap_transpen_additive(paldata, trans_pen), pmask));
 }
 
-//#define MAKE_ARGB_RGB(a, rgb) rgb_t(a, rgb.r(), rgb.g(), rgb.b())
-#define MAKE_ARGB_RGB(a, rgb)   rgb_t(rgb).set_a(a)
-
 // combine in 'alpha' when copying to store in ARGB
-#define PIXEL_OP_REMAP_TRANS0_ALPHASTORE32(DEST, PRIORITY, SOURCE)                                  \
-do                                                                                                  \
-{                                                                                                   \
-	UINT32 srcdata = (SOURCE);                                                                      \
-	if (srcdata != 0)                                                                               \
-		(DEST) = MAKE_ARGB_RGB(alpha,paldata[srcdata]);                                             \
-}                                                                                                   \
-while (0)
+class remap_trans0_alphastore : public drawgfx_op<remap_trans0_alphastore>
+{
+public:
+	remap_trans0_alphastore(const pen_t *paldata, UINT8 alpha) : m_paldata(paldata), m_alpha(alpha) { }
+	bool draws(UINT32 pen) const { return pen != 0; }
+	void draw(UINT32 &dest, UINT32 pen) const { dest = rgb_t(m_paldata[pen]).set_a(m_alpha); }
+
+	const pen_t *m_paldata;
+	UINT8 m_alpha;
+};
+
 // combine in 'alphatable' value to store in ARGB
-#define PIXEL_OP_REMAP_TRANS0_ALPHATABLESTORE32(DEST, PRIORITY, SOURCE)                             \
-do                                                                                                  \
-{                                                                                                   \
-	UINT32 srcdata = (SOURCE);                                                                      \
-	if (srcdata != 0)                                                                               \
-		(DEST) = MAKE_ARGB_RGB(alphatable[srcdata], paldata[srcdata]);                              \
-}                                                                                                   \
-while (0)
-// drawgfxm.h macro to render alpha into 32-bit buffer
-#define PIXEL_OP_REMAP_TRANS0_ALPHATABLE32(DEST, PRIORITY, SOURCE)                                  \
-do                                                                                                  \
-{                                                                                                   \
-	UINT32 srcdata = (SOURCE);                                                                      \
-	if (srcdata != 0)                                                                               \
-		(DEST) = alpha_blend_r32((DEST), paldata[srcdata], alphatable[srcdata]);                    \
-}                                                                                                   \
-while (0)
+class remap_trans0_alphatablestore : public drawgfx_op<remap_trans0_alphatablestore>
+{
+public:
+	remap_trans0_alphatablestore(const pen_t *paldata, const UINT8 *alphatable) : m_paldata(paldata), m_alphatable(alphatable) { }
+	bool draws(UINT32 pen) const { return pen != 0; }
+	void draw(UINT32 &dest, UINT32 pen) const { dest = rgb_t(m_paldata[pen]).set_a(m_alphatable[pen]); }
+
+	const pen_t *m_paldata;
+	const UINT8 *m_alphatable;
+};
+
+// render alpha into 32-bit buffer
+class remap_trans0_alphatable : public drawgfx_op<remap_trans0_alphatable>
+{
+public:
+	remap_trans0_alphatable(const pen_t *paldata, const UINT8 *alphatable) : m_paldata(paldata), m_alphatable(alphatable) { }
+	bool draws(UINT32 pen) const { return pen != 0; }
+	void draw(UINT32 &dest, UINT32 pen) const { dest = alpha_blend_r32(dest, m_paldata[pen], m_alphatable[pen]); }
+
+	const pen_t *m_paldata;
+	const UINT8 *m_alphatable;
+};
 
 /*-------------------------------------------------
     alphastore - render a gfx element with
@@ -1677,7 +1695,6 @@ void gfx_element::alphastore(bitmap_rgb32 &dest, const rectangle &cliprect,
 		UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,
 		int fixedalpha, UINT8 *alphatable)
 {
-	DECLARE_NO_PRIORITY;
 	const pen_t *paldata;
 
 	assert(dest.bpp() == 32);
@@ -1701,14 +1718,9 @@ void gfx_element::alphastore(bitmap_rgb32 &dest, const rectangle &cliprect,
 		return;
 
 	if (fixedalpha >= 0)
-	{
-		UINT8 alpha = fixedalpha;
-		DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANS0_ALPHASTORE32, NO_PRIORITY);
-	}
+		drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, remap_trans0_alphastore(paldata, fixedalpha));
 	else
-	{
-		DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANS0_ALPHATABLESTORE32, NO_PRIORITY);
-	}
+		drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, remap_trans0_alphatablestore(paldata, alphatable));
 }
 
 /*-------------------------------------------------
@@ -1720,8 +1732,6 @@ void gfx_element::alphatable(bitmap_rgb32 &dest, const rectangle &cliprect,
 		UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,
 		int fixedalpha ,UINT8 *alphatable)
 {
-	DECLARE_NO_PRIORITY;
-
 	const pen_t *paldata;
 
 	/* if we have a fixed alpha, call the standard drawgfx_alpha */
@@ -1743,7 +1753,7 @@ void gfx_element::alphatable(bitmap_rgb32 &dest, const rectangle &cliprect,
 	if (has_pen_usage() && (pen_usage(code) & ~(1 << 0)) == 0)
 		return;
 
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANS0_ALPHATABLE32, NO_PRIORITY);
+	drawgfx_core<NO_PRIORITY>(dest, cliprect, *this, code, flipx, flipy, destx, desty, drawgfx_dummy_priority_bitmap, remap_trans0_alphatable(paldata, alphatable));
 }
 
 
@@ -182,20 +182,20 @@ public:
 	void set_source_clip(UINT32 xoffs, UINT32 width, UINT32 yoffs, UINT32 height);
 
 	// operations
-	void mark_dirty(UINT32 code) { if (code < elements()) { m_dirty[code] = 1; m_dirtyseq++; } }
-	void mark_all_dirty() { memset(&m_dirty[0], 1, elements()); }
+	void mark_dirty(UINT32 code) { if (code < elements()) { m_dirty[code].store(1, std::memory_order_relaxed); m_dirtyseq++; } }
+	void mark_all_dirty();
 
 	const UINT8 *get_data(UINT32 code)
 	{
 		assert(code < elements());
-		if (code < m_dirty.size() && m_dirty[code]) decode(code);
+		if (code < m_dirty.size() && is_dirty(code)) decode(code);
 		return m_gfxdata + code * m_char_modulo + m_starty * m_line_modulo + m_startx;
 	}
 
 	UINT32 pen_usage(UINT32 code)
 	{
 		assert(code < m_pen_usage.size());
-		if (m_dirty[code]) decode(code);
+		if (is_dirty(code)) decode(code);
 		return m_pen_usage[code];
 	}
 
@@ -267,6 +267,11 @@ public:
 private:
 	// internal helpers
 	void decode(UINT32 code);
+	void reset_dirty();
+
+	// the acquire pairs with the release in decode(), so a band that sees a
+	// clean element also sees its decoded pixels and pen usage
+	bool is_dirty(UINT32 code) const { return m_dirty[code].load(std::memory_order_acquire) != 0; }
 
 	// internal state
 	palette_device  *m_palette;             // palette used for drawing
@@ -292,7 +297,8 @@ private:
 
 	UINT8 *         m_gfxdata;              // pointer to decoded pixel data, 8bpp
 	dynamic_buffer  m_gfxdata_allocated;    // allocated decoded pixel data, 8bpp
-	dynamic_buffer  m_dirty;                // dirty array for detecting chars that need decoding
+	std::vector<std::atomic<UINT8>> m_dirty; // dirty array for detecting chars that need decoding
+	std::mutex      m_decode_lock;          // serializes decoding from concurrent screen bands
 	std::vector<UINT32>  m_pen_usage;      // bitmask of pens that are used (pens 0-31 only)
 
 	bool            m_layout_is_raw;        // raw layout?
@@ -43,6 +43,10 @@
         MEGA_MACRO(BITMAP_TYPE, PIXEL_OP, PRIORITY_TYPE);
     }
 
+    The gfx element renderers DRAWGFX_CORE and DRAWGFXZOOM_CORE are
+    kept for existing drivers; new code should use drawgfx_core()
+    and drawgfxzoom_core() from drawgfxt.h instead.
+
 *********************************************************************/
 
 #pragma once
@@ -50,10 +54,8 @@
 #ifndef __DRAWGFXM_H__
 #define __DRAWGFXM_H__
 
-/* special priority type meaning "none" */
-struct NO_PRIORITY { char dummy[3]; };
+#include "drawgfxt.h"
 
-extern bitmap_ind8 drawgfx_dummy_priority_bitmap;
 #define DECLARE_NO_PRIORITY bitmap_t &priority = drawgfx_dummy_priority_bitmap;
 
 
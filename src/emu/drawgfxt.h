@@ -0,0 +1,706 @@
+// license:BSD-3-Clause
+// copyright-holders:Nicola Salmoria, Aaron Giles
+/*********************************************************************
+
+    drawgfxt.h
+
+    Templates implementing drawgfx core operations. Drivers can use
+    these if they need custom behavior not provided by the existing
+    drawgfx functions.
+**********************************************************************
+
+    How to use these templates:
+
+    A pixel operation is a small class that draws one source pen to
+    one destination pixel, perhaps updating the priority pixel as
+    well. drawgfx_core() and drawgfxzoom_core() walk a gfx element,
+    apply clipping, flipping and scaling, and call the operation for
+    every pixel that is left:
+
+        drawgfx_core<NO_PRIORITY>(bitmap, cliprect, gfx, code, flipx, flipy,
+                sx, sy, drawgfx_dummy_priority_bitmap,
+                drawgfx_rebase_transpen(color, 0));
+
+    The template argument is the pixel type of the priority bitmap,
+    or NO_PRIORITY if the operation doesn't use it.
+
+    Simple operations derive from drawgfx_op and provide draws(),
+    which says whether a pen is drawn at all, and draw(), which
+    stores it. drawgfx_pmask() wraps any such operation in the usual
+    priority-masked behavior (see drawgfx.h). Operations with other
+    needs provide operator()(dest, priority, pen) directly, with the
+    priority argument being a NO_PRIORITY reference when there is no
+    priority bitmap.
+
+    Unscaled rows go through drawgfx_row(), which can be overloaded
+    for a particular operation to draw a whole row at once; the ones
+    here do that with SIMD for 16bpp rebased pens, the most common
+    sprite path in indexed drivers.
+
+*********************************************************************/
+
+#pragma once
+
+#ifndef __DRAWGFXT_H__
+#define __DRAWGFXT_H__
+
+// use SSE2 on 64-bit x86, where it can be assumed, and NEON where the compiler offers it
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define DRAWGFX_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DRAWGFX_NEON
+#endif
+
+
+/* special priority type meaning "none" */
+struct NO_PRIORITY { char dummy[3]; };
+
+extern bitmap_ind8 drawgfx_dummy_priority_bitmap;
+
+
+
+/***************************************************************************
+    PIXEL OPERATIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    drawgfx_op - base for operations that are
+    fully described by draws() and draw()
+-------------------------------------------------*/
+
+template<class _Op>
+class drawgfx_op
+{
+public:
+	template<typename _PixelType, typename _PriorityType>
+	void operator()(_PixelType &dest, _PriorityType &pri, UINT32 pen) const
+	{
+		const _Op &op = static_cast<const _Op &>(*this);
+		if (op.draws(pen))
+			op.draw(dest, pen);
+	}
+};
+
+
+/*-------------------------------------------------
+    drawgfx_rebase_opaque - draw every pen, adding
+    'color' to the pen value
+-------------------------------------------------*/
+
+class drawgfx_rebase_opaque : public drawgfx_op<drawgfx_rebase_opaque>
+{
+public:
+	drawgfx_rebase_opaque(UINT32 color) : m_color(color) { }
+	bool draws(UINT32 pen) const { return true; }
+	template<typename _PixelType> void draw(_PixelType &dest, UINT32 pen) const { dest = m_color + pen; }
+
+	UINT32 m_color;
+};
+
+
+/*-------------------------------------------------
+    drawgfx_remap_opaque - draw every pen, mapping
+    it via the 'paldata' array
+-------------------------------------------------*/
+
+class drawgfx_remap_opaque : public drawgfx_op<drawgfx_remap_opaque>
+{
+public:
+	drawgfx_remap_opaque(const pen_t *paldata) : m_paldata(paldata) { }
+	bool draws(UINT32 pen) const { return true; }
+	template<typename _PixelType> void draw(_PixelType &dest, UINT32 pen) const { dest = m_paldata[pen]; }
+
+	const pen_t *m_paldata;
+};
+
+
+/*-------------------------------------------------
+    drawgfx_rebase_transpen - draw every pen but
+    'trans_pen', adding 'color' to the pen value
+-------------------------------------------------*/
+
+class drawgfx_rebase_transpen : public drawgfx_op<drawgfx_rebase_transpen>
+{
+public:
+	drawgfx_rebase_transpen(UINT32 color, UINT32 trans_pen) : m_color(color), m_trans_pen(trans_pen) { }
+	bool draws(UINT32 pen) const { return pen != m_trans_pen; }
+	template<typename _PixelType> void draw(_PixelType &dest, UINT32 pen) const { dest = m_color + pen; }
+
+	UINT32 m_color;
+	UINT32 m_trans_pen;
+};
+
+
+/*-------------------------------------------------
+    drawgfx_remap_transpen - draw every pen but
+    'trans_pen', mapping it via the 'paldata' array
+-------------------------------------------------*/
+
+class drawgfx_remap_transpen : public drawgfx_op<drawgfx_remap_transpen>
+{
+public:
+	drawgfx_remap_transpen(const pen_t *paldata, UINT32 trans_pen) : m_paldata(paldata), m_trans_pen(trans_pen) { }
+	bool draws(UINT32 pen) const { return pen != m_trans_pen; }
+	template<typename _PixelType> void draw(_PixelType &dest, UINT32 pen) const { dest = m_paldata[pen]; }
+
+	const pen_t *m_paldata;
+	UINT32 m_trans_pen;
+};
+
+
+/*-------------------------------------------------
+    drawgfx_rebase_transmask - draw every pen not
+    set in 'trans_mask', adding 'color' to the pen
+    value
+-------------------------------------------------*/
+
+class drawgfx_rebase_transmask : public drawgfx_op<drawgfx_rebase_transmask>
+{
+public:
+	drawgfx_rebase_transmask(UINT32 color, UINT32 trans_mask) : m_color(color), m_trans_mask(trans_mask) { }
+	bool draws(UINT32 pen) const { return ((m_trans_mask >> pen) & 1) == 0; }
+	template<typename _PixelType> void draw(_PixelType &dest, UINT32 pen) const { dest = m_color + pen; }
+
+	UINT32 m_color;
+	UINT32 m_trans_mask;
+};
+
+
+/*-------------------------------------------------
+    drawgfx_remap_transmask - draw every pen not
+    set in 'trans_mask', mapping it via the
+    'paldata' array
+-------------------------------------------------*/
+
+class drawgfx_remap_transmask : public drawgfx_op<drawgfx_remap_transmask>
+{
+public:
+	drawgfx_remap_transmask(const pen_t *paldata, UINT32 trans_mask) : m_paldata(paldata), m_trans_mask(trans_mask) { }
+	bool draws(UINT32 pen) const { return ((m_trans_mask >> pen) & 1) == 0; }
+	template<typename _PixelType> void draw(_PixelType &dest, UINT32 pen) const { dest = m_paldata[pen]; }
+
+	const pen_t *m_paldata;
+	UINT32 m_trans_mask;
+};
+
+
+/*-------------------------------------------------
+    drawgfx_remap_transpen_alpha - draw every pen
+    but 'trans_pen', mapping it via the 'paldata'
+    array and alpha blending it against the
+    destination
+-------------------------------------------------*/
+
+class drawgfx_remap_transpen_alpha : public drawgfx_op<drawgfx_remap_transpen_alpha>
+{
+public:
+	drawgfx_remap_transpen_alpha(const pen_t *paldata, UINT32 trans_pen, UINT8 alpha) : m_paldata(paldata), m_trans_pen(trans_pen), m_alpha(alpha) { }
+	bool draws(UINT32 pen) const { return pen != m_trans_pen; }
+	void draw(UINT32 &dest, UINT32 pen) const { dest = alpha_blend_r32(dest, m_paldata[pen], m_alpha); }
+
+	const pen_t *m_paldata;
+	UINT32 m_trans_pen;
+	UINT8 m_alpha;
+};
+
+
+/*-------------------------------------------------
+    drawgfx_transtable - look up each pen in
+    'pentable'; if the entry is DRAWMODE_NONE,
+    don't draw it; if the entry is DRAWMODE_SOURCE,
+    draw it with the source operation; if the entry
+    is DRAWMODE_SHADOW, generate a shadow of the
+    destination pixel using 'shadowtable'; with a
+    priority bitmap, 'pmask' masks both and each
+    pixel is shadowed only once
+-------------------------------------------------*/
+
+template<class _SourceOp>
+class drawgfx_transtable_op
+{
+public:
+	drawgfx_transtable_op(const _SourceOp &source, const UINT8 *pentable, const pen_t *shadowtable, UINT32 pmask = 0)
+		: m_source(source), m_pentable(pentable), m_shadowtable(shadowtable), m_pmask(pmask) { }
+
+	template<typename _PixelType>
+	void operator()(_PixelType &dest, NO_PRIORITY &pri, UINT32 pen) const
+	{
+		UINT32 entry = m_pentable[pen];
+		if (entry != DRAWMODE_NONE)
+		{
+			if (entry == DRAWMODE_SOURCE)
+				m_source.draw(dest, pen);
+			else
+				shadow(dest);
+		}
+	}
+
+	template<typename _PixelType>
+	void operator()(_PixelType &dest, UINT8 &pri, UINT32 pen) const
+	{
+		UINT32 entry = m_pentable[pen];
+		if (entry != DRAWMODE_NONE)
+		{
+			UINT8 pridata = pri;
+			if (entry == DRAWMODE_SOURCE)
+			{
+				if (((1 << (pridata & 0x1f)) & m_pmask) == 0)
+					m_source.draw(dest, pen);
+				pri = 31;
+			}
+			else if ((pridata & 0x80) == 0 && ((1 << (pridata & 0x1f)) & m_pmask) == 0)
+			{
+				shadow(dest);
+				pri = pridata | 0x80;
+			}
+		}
+	}
+
+private:
+	void shadow(UINT16 &dest) const { dest = m_shadowtable[dest]; }
+	void shadow(UINT32 &dest) const { dest = m_shadowtable[rgb_t(dest).as_rgb15()]; }
+
+	_SourceOp m_source;
+	const UINT8 *m_pentable;
+	const pen_t *m_shadowtable;
+	UINT32 m_pmask;
+};
+
+template<class _SourceOp>
+inline drawgfx_transtable_op<_SourceOp> drawgfx_transtable(const _SourceOp &source, const UINT8 *pentable, const pen_t *shadowtable, UINT32 pmask = 0)
+{
+	return drawgfx_transtable_op<_SourceOp>(source, pentable, shadowtable, pmask);
+}
+
+
+/*-------------------------------------------------
+    drawgfx_pmask - draw a pixel with another
+    operation only where the priority bitmap isn't
+    masked by 'pmask', and mark every drawn pixel
+    in the priority bitmap
+-------------------------------------------------*/
+
+template<class _Op>
+class drawgfx_pmask_op
+{
+public:
+	drawgfx_pmask_op(const _Op &op, UINT32 pmask) : m_op(op), m_pmask(pmask) { }
+
+	template<typename _PixelType>
+	void operator()(_PixelType &dest, UINT8 &pri, UINT32 pen) const
+	{
+		if (m_op.draws(pen))
+		{
+			if (((1 << (pri & 0x1f)) & m_pmask) == 0)
+				m_op.draw(dest, pen);
+			pri = 31;
+		}
+	}
+
+	_Op m_op;
+	UINT32 m_pmask;
+};
+
+template<class _Op>
+inline drawgfx_pmask_op<_Op> drawgfx_pmask(const _Op &op, UINT32 pmask)
+{
+	return drawgfx_pmask_op<_Op>(op, pmask);
+}
+
+
+
+/***************************************************************************
+    ROW OPERATIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    drawgfx_priority_row - return the address of
+    a row of the priority bitmap, if there is one
+-------------------------------------------------*/
+
+template<typename _PriorityType>
+inline _PriorityType *drawgfx_priority_row(bitmap_t &priority, INT32 y, INT32 x)
+{
+	return &priority.pixt<_PriorityType>(y, x);
+}
+
+template<>
+inline NO_PRIORITY *drawgfx_priority_row<NO_PRIORITY>(bitmap_t &priority, INT32 y, INT32 x)
+{
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    drawgfx_row - draw count pixels of an
+    unscaled row; with _FlipX, srcptr points to
+    the first pixel drawn and the source is read
+    backwards
+-------------------------------------------------*/
+
+template<bool _FlipX, typename _PixelType, typename _PriorityType, class _PixelOp>
+inline void drawgfx_row(_PixelType *destptr, _PriorityType *priptr, const UINT8 *srcptr, INT32 count, _PixelOp op)
+{
+	const INT32 step = _FlipX ? -1 : 1;
+
+	// unrolled blocks of 4, then the leftovers
+	for ( ; count >= 4; count -= 4, destptr += 4, priptr += 4, srcptr += 4 * step)
+	{
+		op(destptr[0], priptr[0], srcptr[0 * step]);
+		op(destptr[1], priptr[1], srcptr[1 * step]);
+		op(destptr[2], priptr[2], srcptr[2 * step]);
+		op(destptr[3], priptr[3], srcptr[3 * step]);
+	}
+	for ( ; count > 0; count--, srcptr += step)
+		op(*destptr++, *priptr++, *srcptr);
+}
+
+template<bool _FlipX, typename _PixelType, class _PixelOp>
+inline void drawgfx_row(_PixelType *destptr, NO_PRIORITY *priptr, const UINT8 *srcptr, INT32 count, _PixelOp op)
+{
+	const INT32 step = _FlipX ? -1 : 1;
+	NO_PRIORITY none;
+
+	// unrolled blocks of 4, then the leftovers
+	for ( ; count >= 4; count -= 4, destptr += 4, srcptr += 4 * step)
+	{
+		op(destptr[0], none, srcptr[0 * step]);
+		op(destptr[1], none, srcptr[1 * step]);
+		op(destptr[2], none, srcptr[2 * step]);
+		op(destptr[3], none, srcptr[3 * step]);
+	}
+	for ( ; count > 0; count--, srcptr += step)
+		op(*destptr++, none, *srcptr);
+}
+
+
+#if defined(DRAWGFX_SSE2)
+
+/*-------------------------------------------------
+    drawgfx_load_pens - load 8 source pens in
+    drawing order, widened to 16 bits
+-------------------------------------------------*/
+
+template<bool _FlipX>
+inline __m128i drawgfx_load_pens(const UINT8 *srcptr)
+{
+	if (!_FlipX)
+		return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(srcptr)), _mm_setzero_si128());
+
+	// the pens run backwards from srcptr; reverse the 8 words after widening
+	__m128i pens = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(srcptr - 7)), _mm_setzero_si128());
+	pens = _mm_shuffle_epi32(pens, _MM_SHUFFLE(1, 0, 3, 2));
+	pens = _mm_shufflelo_epi16(pens, _MM_SHUFFLE(0, 1, 2, 3));
+	return _mm_shufflehi_epi16(pens, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+#elif defined(DRAWGFX_NEON)
+
+template<bool _FlipX>
+inline uint16x8_t drawgfx_load_pens(const UINT8 *srcptr)
+{
+	if (!_FlipX)
+		return vmovl_u8(vld1_u8(srcptr));
+	return vmovl_u8(vrev64_u8(vld1_u8(srcptr - 7)));
+}
+
+#endif
+
+
+/*-------------------------------------------------
+    drawgfx_row - rebased opaque and transparent
+    pens to a 16bpp bitmap, 8 pixels at a time
+-------------------------------------------------*/
+
+template<bool _FlipX>
+inline void drawgfx_row(UINT16 *destptr, NO_PRIORITY *priptr, const UINT8 *srcptr, INT32 count, drawgfx_rebase_opaque op)
+{
+	INT32 x = 0;
+#if defined(DRAWGFX_SSE2)
+	const __m128i color = _mm_set1_epi16(op.m_color);
+	for ( ; x + 8 <= count; x += 8)
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&destptr[x]), _mm_add_epi16(drawgfx_load_pens<_FlipX>(&srcptr[_FlipX ? -x : x]), color));
+#elif defined(DRAWGFX_NEON)
+	const uint16x8_t color = vdupq_n_u16(op.m_color);
+	for ( ; x + 8 <= count; x += 8)
+		vst1q_u16(&destptr[x], vaddq_u16(drawgfx_load_pens<_FlipX>(&srcptr[_FlipX ? -x : x]), color));
+#endif
+	for ( ; x < count; x++)
+		destptr[x] = op.m_color + srcptr[_FlipX ? -x : x];
+}
+
+template<bool _FlipX>
+inline void drawgfx_row(UINT16 *destptr, NO_PRIORITY *priptr, const UINT8 *srcptr, INT32 count, drawgfx_rebase_transpen op)
+{
+	INT32 x = 0;
+	// pens are at most 0xff, so a larger trans_pen never matches, as in draws()
+#if defined(DRAWGFX_SSE2)
+	const __m128i color = _mm_set1_epi16(op.m_color);
+	const __m128i trans = _mm_set1_epi16((op.m_trans_pen > 0xff) ? 0xffff : op.m_trans_pen);
+	for ( ; x + 8 <= count; x += 8)
+	{
+		__m128i pens = drawgfx_load_pens<_FlipX>(&srcptr[_FlipX ? -x : x]);
+		__m128i transparent = _mm_cmpeq_epi16(pens, trans);
+		__m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&destptr[x]));
+		__m128i result = _mm_or_si128(_mm_and_si128(transparent, old), _mm_andnot_si128(transparent, _mm_add_epi16(pens, color)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&destptr[x]), result);
+	}
+#elif defined(DRAWGFX_NEON)
+	const uint16x8_t color = vdupq_n_u16(op.m_color);
+	const uint16x8_t trans = vdupq_n_u16((op.m_trans_pen > 0xff) ? 0xffff : op.m_trans_pen);
+	for ( ; x + 8 <= count; x += 8)
+	{
+		uint16x8_t pens = drawgfx_load_pens<_FlipX>(&srcptr[_FlipX ? -x : x]);
+		vst1q_u16(&destptr[x], vbslq_u16(vceqq_u16(pens, trans), vld1q_u16(&destptr[x]), vaddq_u16(pens, color)));
+	}
+#endif
+	for ( ; x < count; x++)
+	{
+		UINT32 pen = srcptr[_FlipX ? -x : x];
+		if (op.draws(pen))
+			destptr[x] = op.m_color + pen;
+	}
+}
+
+
+/*-------------------------------------------------
+    drawgfxzoom_row - draw count pixels of a
+    scaled row, stepping the 16.16 source position
+    by dx
+-------------------------------------------------*/
+
+template<typename _PixelType, typename _PriorityType, class _PixelOp>
+inline void drawgfxzoom_row(_PixelType *destptr, _PriorityType *priptr, const UINT8 *srcptr, INT32 srcx, INT32 dx, INT32 count, _PixelOp op)
+{
+	// unrolled blocks of 4, then the leftovers
+	for ( ; count >= 4; count -= 4, destptr += 4, priptr += 4)
+	{
+		op(destptr[0], priptr[0], srcptr[srcx >> 16]);
+		srcx += dx;
+		op(destptr[1], priptr[1], srcptr[srcx >> 16]);
+		srcx += dx;
+		op(destptr[2], priptr[2], srcptr[srcx >> 16]);
+		srcx += dx;
+		op(destptr[3], priptr[3], srcptr[srcx >> 16]);
+		srcx += dx;
+	}
+	for ( ; count > 0; count--, srcx += dx)
+		op(*destptr++, *priptr++, srcptr[srcx >> 16]);
+}
+
+template<typename _PixelType, class _PixelOp>
+inline void drawgfxzoom_row(_PixelType *destptr, NO_PRIORITY *priptr, const UINT8 *srcptr, INT32 srcx, INT32 dx, INT32 count, _PixelOp op)
+{
+	NO_PRIORITY none;
+
+	// unrolled blocks of 4, then the leftovers
+	for ( ; count >= 4; count -= 4, destptr += 4)
+	{
+		op(destptr[0], none, srcptr[srcx >> 16]);
+		srcx += dx;
+		op(destptr[1], none, srcptr[srcx >> 16]);
+		srcx += dx;
+		op(destptr[2], none, srcptr[srcx >> 16]);
+		srcx += dx;
+		op(destptr[3], none, srcptr[srcx >> 16]);
+		srcx += dx;
+	}
+	for ( ; count > 0; count--, srcx += dx)
+		op(*destptr++, none, srcptr[srcx >> 16]);
+}
+
+
+
+/***************************************************************************
+    BASIC DRAWGFX CORE
+***************************************************************************/
+
+/*-------------------------------------------------
+    drawgfx_core - render an unscaled gfx element,
+    calling op for every visible pixel
+-------------------------------------------------*/
+
+template<typename _PriorityType, class _BitmapType, class _PixelOp>
+void drawgfx_core(_BitmapType &dest, const rectangle &cliprect, gfx_element &gfx,
+		UINT32 code, int flipx, int flipy, INT32 destx, INT32 desty,
+		bitmap_t &priority, const _PixelOp &op)
+{
+	assert(dest.valid());
+	assert(drawgfx_priority_row<_PriorityType>(priority, 0, 0) == nullptr || priority.valid());
+	assert(dest.cliprect().contains(cliprect));
+	assert(code < gfx.elements());
+
+	// ignore empty/invalid cliprects
+	if (cliprect.empty())
+		return;
+
+	// compute final pixel in X and exit if we are entirely clipped
+	INT32 destendx = destx + gfx.width() - 1;
+	if (destx > cliprect.max_x || destendx < cliprect.min_x)
+		return;
+
+	// apply left clip
+	INT32 srcx = 0;
+	if (destx < cliprect.min_x)
+	{
+		srcx = cliprect.min_x - destx;
+		destx = cliprect.min_x;
+	}
+
+	// apply right clip
+	if (destendx > cliprect.max_x)
+		destendx = cliprect.max_x;
+
+	// compute final pixel in Y and exit if we are entirely clipped
+	INT32 destendy = desty + gfx.height() - 1;
+	if (desty > cliprect.max_y || destendy < cliprect.min_y)
+		return;
+
+	// apply top clip
+	INT32 srcy = 0;
+	if (desty < cliprect.min_y)
+	{
+		srcy = cliprect.min_y - desty;
+		desty = cliprect.min_y;
+	}
+
+	// apply bottom clip
+	if (destendy > cliprect.max_y)
+		destendy = cliprect.max_y;
+
+	// apply X flipping
+	if (flipx)
+		srcx = gfx.width() - 1 - srcx;
+
+	// apply Y flipping
+	INT32 dy = gfx.rowbytes();
+	if (flipy)
+	{
+		srcy = gfx.height() - 1 - srcy;
+		dy = -dy;
+	}
+
+	g_profiler.start(PROFILER_DRAWGFX);
+
+	// fetch the source data, pointing to the first source pixel of the row
+	const UINT8 *srcdata = gfx.get_data(code) + srcy * gfx.rowbytes() + srcx;
+	INT32 count = destendx + 1 - destx;
+
+	// iterate over pixels in Y
+	for (INT32 cury = desty; cury <= destendy; cury++, srcdata += dy)
+	{
+		typename _BitmapType::pixel_t *destptr = &dest.pix(cury, destx);
+		_PriorityType *priptr = drawgfx_priority_row<_PriorityType>(priority, cury, destx);
+		if (!flipx)
+			drawgfx_row<false>(destptr, priptr, srcdata, count, op);
+		else
+			drawgfx_row<true>(destptr, priptr, srcdata, count, op);
+	}
+
+	g_profiler.stop();
+}
+
+
+
+/***************************************************************************
+    BASIC DRAWGFXZOOM CORE
+***************************************************************************/
+
+/*-------------------------------------------------
+    drawgfxzoom_core - render a gfx element scaled
+    by the 16.16 factors scalex and scaley,
+    calling op for every visible pixel
+-------------------------------------------------*/
+
+template<typename _PriorityType, class _BitmapType, class _PixelOp>
+void drawgfxzoom_core(_BitmapType &dest, const rectangle &cliprect, gfx_element &gfx,
+		UINT32 code, int flipx, int flipy, INT32 destx, INT32 desty,
+		UINT32 scalex, UINT32 scaley, bitmap_t &priority, const _PixelOp &op)
+{
+	assert(dest.valid());
+	assert(drawgfx_priority_row<_PriorityType>(priority, 0, 0) == nullptr || priority.valid());
+	assert(dest.cliprect().contains(cliprect));
+
+	// ignore empty/invalid cliprects
+	if (cliprect.empty())
+		return;
+
+	// compute scaled size
+	UINT32 dstwidth = (scalex * gfx.width() + 0x8000) >> 16;
+	UINT32 dstheight = (scaley * gfx.height() + 0x8000) >> 16;
+	if (dstwidth < 1 || dstheight < 1)
+		return;
+
+	// compute 16.16 source steps in dx and dy
+	INT32 dx = (gfx.width() << 16) / dstwidth;
+	INT32 dy = (gfx.height() << 16) / dstheight;
+
+	// compute final pixel in X and exit if we are entirely clipped
+	INT32 destendx = destx + dstwidth - 1;
+	if (destx > cliprect.max_x || destendx < cliprect.min_x)
+		return;
+
+	// apply left clip
+	INT32 srcx = 0;
+	if (destx < cliprect.min_x)
+	{
+		srcx = (cliprect.min_x - destx) * dx;
+		destx = cliprect.min_x;
+	}
+
+	// apply right clip
+	if (destendx > cliprect.max_x)
+		destendx = cliprect.max_x;
+
+	// compute final pixel in Y and exit if we are entirely clipped
+	INT32 destendy = desty + dstheight - 1;
+	if (desty > cliprect.max_y || destendy < cliprect.min_y)
+		return;
+
+	// apply top clip
+	INT32 srcy = 0;
+	if (desty < cliprect.min_y)
+	{
+		srcy = (cliprect.min_y - desty) * dy;
+		desty = cliprect.min_y;
+	}
+
+	// apply bottom clip
+	if (destendy > cliprect.max_y)
+		destendy = cliprect.max_y;
+
+	// apply X flipping
+	if (flipx)
+	{
+		srcx = (dstwidth - 1) * dx - srcx;
+		dx = -dx;
+	}
+
+	// apply Y flipping
+	if (flipy)
+	{
+		srcy = (dstheight - 1) * dy - srcy;
+		dy = -dy;
+	}
+
+	g_profiler.start(PROFILER_DRAWGFX);
+
+	// fetch the source data
+	const UINT8 *srcdata = gfx.get_data(code);
+	INT32 count = destendx + 1 - destx;
+
+	// iterate over pixels in Y
+	for (INT32 cury = desty; cury <= destendy; cury++, srcy += dy)
+	{
+		typename _BitmapType::pixel_t *destptr = &dest.pix(cury, destx);
+		_PriorityType *priptr = drawgfx_priority_row<_PriorityType>(priority, cury, destx);
+		drawgfxzoom_row(destptr, priptr, srcdata + (srcy >> 16) * gfx.rowbytes(), srcx, dx, count, op);
+	}
+
+	g_profiler.stop();
+}
+
+
+#endif  /* __DRAWGFXT_H__ */
@@ -22,6 +22,7 @@
 #include <list>
 #include <vector>
 #include <memory>
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -106,6 +107,7 @@ typedef device_t * (*machine_config_constructor)(machine_config &config, device_
 #include "video.h"
 
 // sound-related
+#include "resampler.h"
 #include "sound.h"
 #include "speaker.h"
 
@@ -62,6 +62,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
 	{ OPTION_STATE,                                      nullptr,        OPTION_STRING,     "saved state to load" },
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "enable automatic restore at startup, and automatic save at exit time" },
+	{ OPTION_STATE_DELTA,                                "0",         OPTION_BOOLEAN,    "enable incremental save states that store only data changed since the last full save" },
+	{ OPTION_REWIND,                                     "0",         OPTION_INTEGER,    "number of in-memory snapshots to keep for rewinding (0 = disabled)" },
+	{ OPTION_REWIND_INTERVAL,                            "30",        OPTION_INTEGER,    "number of frames between rewind snapshots" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,        OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,        OPTION_STRING,     "record an input file" },
 	{ OPTION_MNGWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
@@ -87,6 +90,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_EXECUTE_GROUPS,                             "0",         OPTION_BOOLEAN,    "run execution groups declared by the driver on separate threads" },
 
 	// rotation options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE ROTATION OPTIONS" },
@@ -128,6 +132,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_RESAMPLER,                                  "linear",    OPTION_STRING,     "stream rate conversion: linear or sinc (windowed sinc, slower but without aliasing)" },
+	{ OPTION_PARALLEL_SOUND,                             "0",         OPTION_BOOLEAN,    "update independent parts of the sound stream graph on separate threads" },
 
 	// input options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -167,6 +173,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DEBUG ";d",                                 "0",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ OPTION_UPDATEINPAUSE,                              "0",         OPTION_BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,        OPTION_STRING,     "script for debugger" },
+	{ OPTION_PROFILE_REPORT,                             nullptr,        OPTION_STRING,     "write a per-frame and aggregate timing report in JSON format to the given file" },
+	{ OPTION_HEATMAP,                                    nullptr,        OPTION_STRING,     "count memory accesses per handler and write them to the given CSV or JSON file at exit" },
 
 	// comm options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE COMM OPTIONS" },
@@ -181,6 +189,12 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_PERSIST,                                "0",         OPTION_BOOLEAN,    "save DRC compiled block list and precompile it on the next run" },
+	{ OPTION_DRC_DISABLE_PASSES,                         "",          OPTION_STRING,     "comma-separated list of UML optimizer passes to disable (constprop, memforward, regalloc, deadcode or all)" },
+	{ OPTION_DRC_PROFILE,                                "0",         OPTION_BOOLEAN,    "count executions of each DRC block for the drchot debugger command" },
+	{ OPTION_DRC_I386,                                   "0",         OPTION_BOOLEAN,    "use the i386 recompiler as well (requires -drc)" },
+	{ OPTION_DRC_M68K,                                   "0",         OPTION_BOOLEAN,    "use the 68020/68030 recompiler as well (requires -drc)" },
+	{ OPTION_DRC_SH4,                                    "0",         OPTION_BOOLEAN,    "use the SH-4 recompiler as well (requires -drc)" },
 	{ OPTION_BIOS,                                       nullptr,        OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
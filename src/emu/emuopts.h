@@ -72,6 +72,9 @@ enum
 // core state/playback options
 #define OPTION_STATE                "state"
 #define OPTION_AUTOSAVE             "autosave"
+#define OPTION_STATE_DELTA          "state_delta"
+#define OPTION_REWIND               "rewind"
+#define OPTION_REWIND_INTERVAL      "rewind_interval"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_MNGWRITE             "mngwrite"
@@ -96,6 +99,7 @@ enum
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_EXECUTE_GROUPS       "execute_groups"
 
 // core rotation options
 #define OPTION_ROTATE               "rotate"
@@ -132,6 +136,8 @@ enum
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
 #define OPTION_VOLUME               "volume"
+#define OPTION_RESAMPLER            "resampler"
+#define OPTION_PARALLEL_SOUND       "parallel_sound"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -168,12 +174,20 @@ enum
 #define OPTION_OSLOG                "oslog"
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
+#define OPTION_PROFILE_REPORT       "profile_report"
+#define OPTION_HEATMAP              "heatmap"
 
 // core misc options
 #define OPTION_DRC                  "drc"
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_PERSIST          "drc_persist"
+#define OPTION_DRC_DISABLE_PASSES   "drc_disable_passes"
+#define OPTION_DRC_PROFILE          "drc_profile"
+#define OPTION_DRC_I386             "drc_i386"
+#define OPTION_DRC_M68K             "drc_m68k"
+#define OPTION_DRC_SH4              "drc_sh4"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -290,6 +304,9 @@ public:
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
+	bool state_delta() const { return bool_value(OPTION_STATE_DELTA); }
+	int rewind() const { return int_value(OPTION_REWIND); }
+	int rewind_interval() const { return int_value(OPTION_REWIND_INTERVAL); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
@@ -314,6 +331,7 @@ public:
 	bool sleep() const { return m_sleep; }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	bool execute_groups() const { return bool_value(OPTION_EXECUTE_GROUPS); }
 
 	// core rotation options
 	bool rotate() const { return bool_value(OPTION_ROTATE); }
@@ -350,6 +368,8 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	const char *resampler() const { return value(OPTION_RESAMPLER); }
+	bool parallel_sound() const { return bool_value(OPTION_PARALLEL_SOUND); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -384,12 +404,20 @@ public:
 	bool oslog() const { return bool_value(OPTION_OSLOG); }
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	const char *profile_report() const { return value(OPTION_PROFILE_REPORT); }
+	const char *heatmap() const { return value(OPTION_HEATMAP); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_persist() const { return bool_value(OPTION_DRC_PERSIST); }
+	const char *drc_disable_passes() const { return value(OPTION_DRC_DISABLE_PASSES); }
+	bool drc_profile() const { return bool_value(OPTION_DRC_PROFILE); }
+	bool drc_i386() const { return bool_value(OPTION_DRC_I386); }
+	bool drc_m68k() const { return bool_value(OPTION_DRC_M68K); }
+	bool drc_sh4() const { return bool_value(OPTION_DRC_SH4); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -369,8 +369,12 @@ void hiscore_init (running_machine &machine)
 		f.close();
 	}
 	
-	timer = machine.scheduler().timer_alloc(FUNC(hiscore_periodic));
-	timer->adjust(machine.first_screen()->frame_period(), 0, machine.first_screen()->frame_period());
+	// screenless systems such as the test drivers have nothing to poll
+	if (machine.first_screen() != nullptr)
+	{
+		timer = machine.scheduler().timer_alloc(FUNC(hiscore_periodic));
+		timer->adjust(machine.first_screen()->frame_period(), 0, machine.first_screen()->frame_period());
+	}
 
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(hiscore_close), &machine));
 }
@@ -960,6 +960,8 @@ void lua_engine::initialize()
 				.addFunction ("soft_reset", &running_machine::schedule_soft_reset)
 				.addFunction ("save", &running_machine::schedule_save)
 				.addFunction ("load", &running_machine::schedule_load)
+				.addFunction ("save_delta", &running_machine::schedule_save_delta)
+				.addFunction ("rewind", &running_machine::schedule_rewind)
 				.addFunction ("system", &running_machine::system)
 				.addProperty <luabridge::LuaRef, void> ("devices", &lua_engine::l_machine_get_devices)
 				.addProperty <luabridge::LuaRef, void> ("screens", &lua_engine::l_machine_get_screens)
@@ -298,6 +298,7 @@ void running_machine::start()
 	save().register_presave(save_prepost_delegate(FUNC(running_machine::presave_all_devices), this));
 	start_all_devices();
 	save().register_postload(save_prepost_delegate(FUNC(running_machine::postload_all_devices), this));
+	save().set_incremental(options().state_delta());
 
 	// if we're coming in with a savegame request, process it now
 	const char *savegame = options().state();
@@ -356,6 +357,21 @@ int running_machine::run(bool firstrun)
 		// devices with timers.
 		m_save.allow_registration(false);
 
+		// set up the in-memory rewind buffer now that the state layout is fixed
+		if (options().rewind() > 0)
+		{
+			m_save.enable_rewind(options().rewind(), options().rewind_interval());
+			add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(rewinder::frame_update), m_save.rewind()));
+		}
+
+		// start the timing report once every device, stream and screen exists
+		if (options().profile_report()[0] != 0)
+			m_profile_report = std::make_unique<profile_report>(*this, options().profile_report());
+
+		// count memory accesses per handler once the devices have installed theirs
+		if (options().heatmap()[0] != 0)
+			memory().heatmap_start(options().heatmap());
+
 		nvram_load();
 		sound().ui_mute(false);
 
@@ -395,6 +411,10 @@ int running_machine::run(bool firstrun)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// take or restore rewind snapshots
+			if (m_save.rewind() != nullptr)
+				m_save.rewind()->update(m_scheduler.can_save());
+
 			g_profiler.stop();
 		}
 
@@ -657,6 +677,60 @@ void running_machine::immediate_save(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  schedule_save_delta - schedule a save of only
+//  the state that changed since the last save or
+//  load of the same file
+//-------------------------------------------------
+
+void running_machine::schedule_save_delta(const char *filename)
+{
+	// specify the filename of the base state
+	set_saveload_filename(filename);
+
+	// note the start time and set a timer for the next timeslice to actually schedule it
+	m_saveload_schedule = SLS_SAVE_DELTA;
+	m_saveload_schedule_time = this->time();
+
+	// we can't be paused since we need to clear out anonymous timers
+	resume();
+}
+
+
+//-------------------------------------------------
+//  immediate_save_delta - save a state delta.
+//-------------------------------------------------
+
+void running_machine::immediate_save_delta(const char *filename)
+{
+	// specify the filename of the base state
+	set_saveload_filename(filename);
+
+	// set up some parameters for handle_saveload()
+	m_saveload_schedule = SLS_SAVE_DELTA;
+	m_saveload_schedule_time = this->time();
+
+	// jump right into the save, anonymous timers can't hurt us!
+	handle_saveload();
+}
+
+
+//-------------------------------------------------
+//  schedule_rewind - schedule a roll back to an
+//  earlier in-memory snapshot
+//-------------------------------------------------
+
+void running_machine::schedule_rewind(int steps)
+{
+	if (m_save.rewind() == nullptr)
+		popmessage("Error: Rewind is not enabled.");
+	else if (steps < 0 || UINT32(steps) >= m_save.rewind()->count())
+		popmessage("Error: Only %d rewind snapshots are available.", m_save.rewind()->count());
+	else
+		m_save.rewind()->schedule_restore(steps);
+}
+
+
 //-------------------------------------------------
 //  schedule_load - schedule a load to occur as
 //  soon as possible
@@ -889,6 +963,10 @@ void running_machine::call_notifiers(machine_notification which)
 
 void running_machine::handle_saveload()
 {
+	// a delta needs a base from this same file; fall back to a full save otherwise
+	if (m_saveload_schedule == SLS_SAVE_DELTA && (!m_save.has_base() || m_saveload_delta_base != m_saveload_pending_file))
+		m_saveload_schedule = SLS_SAVE;
+
 	UINT32 openflags = (m_saveload_schedule == SLS_LOAD) ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 	const char *opnamed = (m_saveload_schedule == SLS_LOAD) ? "loaded" : "saved";
 	const char *opname = (m_saveload_schedule == SLS_LOAD) ? "load" : "save";
@@ -913,11 +991,32 @@ void running_machine::handle_saveload()
 	}
 
 	// open the file
-	filerr = file.open(m_saveload_pending_file.c_str());
+	if (m_saveload_schedule == SLS_SAVE_DELTA)
+		filerr = file.open(delta_filename(m_saveload_pending_file.c_str(), m_save.delta_sequence() + 1).c_str());
+	else
+		filerr = file.open(m_saveload_pending_file.c_str());
 	if (filerr == FILERR_NONE)
 	{
 		// read/write the save state
-		save_error saverr = (m_saveload_schedule == SLS_LOAD) ? m_save.read_file(file) : m_save.write_file(file);
+		save_error saverr;
+		switch (m_saveload_schedule)
+		{
+			case SLS_LOAD:          saverr = m_save.read_file(file);        break;
+			case SLS_SAVE_DELTA:    saverr = m_save.write_delta_file(file); break;
+			default:                saverr = m_save.write_file(file);       break;
+		}
+
+		// a full save replaces the base, so deltas written against the old one must go
+		if (saverr == STATERR_NONE && m_saveload_schedule == SLS_SAVE)
+			remove_delta_chain(m_saveload_pending_file.c_str());
+
+		// a successful full save or load starts a new delta chain; loads then replay any deltas
+		if (saverr == STATERR_NONE && m_save.incremental() && m_saveload_schedule != SLS_SAVE_DELTA)
+		{
+			m_saveload_delta_base = m_saveload_pending_file;
+			if (m_saveload_schedule == SLS_LOAD)
+				load_delta_chain();
+		}
 
 		// handle the result
 		switch (saverr)
@@ -938,6 +1037,10 @@ void running_machine::handle_saveload()
 				popmessage("Error: Unable to %s state due to a write error. Verify there is enough disk space.", opname);
 				break;
 
+			case STATERR_MISSING_BASE:
+				popmessage("Error: Unable to %s state delta without a base state.", opname);
+				break;
+
 			case STATERR_NONE:
 				if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
 					popmessage("State successfully %s.\nWarning: Save states are not officially supported for this game.", opnamed);
@@ -951,7 +1054,7 @@ void running_machine::handle_saveload()
 		}
 
 		// close and perhaps delete the file
-		if (saverr != STATERR_NONE && m_saveload_schedule == SLS_SAVE)
+		if (saverr != STATERR_NONE && m_saveload_schedule != SLS_LOAD)
 			file.remove_on_close();
 	}
 	else
@@ -965,6 +1068,66 @@ cancel:
 }
 
 
+//-------------------------------------------------
+//  delta_filename - build the name of a delta
+//  file in the chain belonging to a base state
+//-------------------------------------------------
+
+std::string running_machine::delta_filename(const char *basename, UINT32 sequence) const
+{
+	std::string result(basename);
+	size_t extpos = result.find_last_of('.');
+	if (extpos != std::string::npos && result.find_first_of("/\\", extpos) == std::string::npos)
+		result.erase(extpos);
+	strcatprintf(result, ".%04u.std", sequence);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  load_delta_chain - apply each delta that
+//  follows a freshly loaded base state, stopping
+//  at the first one that is missing or belongs to
+//  a different chain
+//-------------------------------------------------
+
+void running_machine::load_delta_chain()
+{
+	while (true)
+	{
+		emu_file file(m_saveload_searchpath, OPEN_FLAG_READ);
+		std::string name = delta_filename(m_saveload_delta_base.c_str(), m_save.delta_sequence() + 1);
+		if (file.open(name.c_str()) != FILERR_NONE)
+			break;
+
+		save_error saverr = m_save.read_delta_file(file);
+		if (saverr != STATERR_NONE)
+		{
+			logerror("Stopped applying state deltas at %s (error %d)\n", name.c_str(), int(saverr));
+			break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  remove_delta_chain - delete the deltas that
+//  followed the base state in a file, so they
+//  can't be replayed on top of a newer base
+//-------------------------------------------------
+
+void running_machine::remove_delta_chain(const char *basename)
+{
+	for (UINT32 sequence = 1; ; sequence++)
+	{
+		emu_file file(m_saveload_searchpath, OPEN_FLAG_READ);
+		if (file.open(delta_filename(basename, sequence).c_str()) != FILERR_NONE)
+			break;
+		file.remove_on_close();
+	}
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -181,6 +181,7 @@ public:
 	tilemap_manager &tilemap() const { assert(m_tilemap != nullptr); return *m_tilemap; }
 	debug_view_manager &debug_view() const { assert(m_debug_view != nullptr); return *m_debug_view; }
 	debugger_manager &debugger() const { assert(m_debugger != nullptr); return *m_debugger; }
+	profile_report *report() const { return m_profile_report.get(); }
 	driver_device *driver_data() const { return &downcast<driver_device &>(root_device()); }
 	template<class _DriverClass> _DriverClass *driver_data() const { return &downcast<_DriverClass &>(root_device()); }
 	machine_phase phase() const { return m_current_phase; }
@@ -214,6 +215,7 @@ public:
 	// TODO: Do saves and loads still require scheduling?
 	void immediate_save(const char *filename);
 	void immediate_load(const char *filename);
+	void immediate_save_delta(const char *filename);
 
 	// scheduled operations
 	void schedule_exit();
@@ -221,6 +223,8 @@ public:
 	void schedule_soft_reset();
 	void schedule_save(const char *filename);
 	void schedule_load(const char *filename);
+	void schedule_save_delta(const char *filename);
+	void schedule_rewind(int steps);
 
 	// date & time
 	void base_datetime(system_time &systime);
@@ -262,6 +266,9 @@ private:
 	void set_saveload_filename(const char *filename);
 	std::string get_statename(const char *statename_opt) const;
 	void handle_saveload();
+	std::string delta_filename(const char *basename, UINT32 sequence) const;
+	void load_delta_chain();
+	void remove_delta_chain(const char *basename);
 	void soft_reset(void *ptr = nullptr, INT32 param = 0);
 	void watchdog_fired(void *ptr = nullptr, INT32 param = 0);
 	void watchdog_vblank(screen_device &screen, bool vblank_state);
@@ -303,6 +310,7 @@ private:
 	std::unique_ptr<image_manager> m_image;            // internal data from image.cpp
 	std::unique_ptr<rom_load_manager> m_rom_load;      // internal data from romload.cpp
 	std::unique_ptr<debugger_manager> m_debugger;      // internal data from debugger.cpp
+	std::unique_ptr<profile_report> m_profile_report;  // internal data from profiler.cpp
 
 	// system state
 	machine_phase           m_current_phase;        // current execution phase
@@ -330,12 +338,14 @@ private:
 	{
 		SLS_NONE,
 		SLS_SAVE,
-		SLS_LOAD
+		SLS_LOAD,
+		SLS_SAVE_DELTA
 	};
 	saveload_schedule       m_saveload_schedule;
 	attotime                m_saveload_schedule_time;
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
+	std::string             m_saveload_delta_base;  // base file of the current delta chain
 
 	// notifier callbacks
 	struct notifier_callback_item
@@ -170,6 +170,8 @@
 
 ***************************************************************************/
 
+#include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
 
@@ -199,6 +201,9 @@ const int BANK_ENTRY_UNSPECIFIED = -1;
 // other address map constants
 const int MEMORY_BLOCK_CHUNK = 65536;                   // minimum chunk size of allocated memory blocks
 
+// heat map constants
+const int HEATMAP_FRAMES = 3600;                        // frames of per-frame heat map data kept for saving
+
 // static data access handler constants
 enum
 {
@@ -362,11 +367,23 @@ public:
 	UINT64 read64(address_space &space, offs_t offset, UINT64 mask) const { return m_read.r64(space, offset, mask); }
 
 private:
+	template<typename _UintType> using read_stub = _UintType (handler_entry_read::*)(address_space &, offs_t, _UintType);
+
 	// stubs for converting between address sizes
 	UINT16 read_stub_16(address_space &space, offs_t offset, UINT16 mask);
 	UINT32 read_stub_32(address_space &space, offs_t offset, UINT32 mask);
 	UINT64 read_stub_64(address_space &space, offs_t offset, UINT64 mask);
 
+	// stubs specialized at map time for one subunit, or several of the same width
+	template<typename _UintType, typename _SubType> _UintType read_stub_single(address_space &space, offs_t offset, _UintType mask);
+	template<typename _UintType, typename _SubType> _UintType read_stub_uniform(address_space &space, offs_t offset, _UintType mask);
+	template<typename _UintType, typename _SubType> read_stub<_UintType> pick_stub(read_stub<_UintType> mixed) const;
+
+	// read a subunit through the delegate matching its width
+	UINT8 read_subunit(int index, address_space &space, offs_t offset, UINT8 mask) const { return m_subread[index].r8(space, offset, mask); }
+	UINT16 read_subunit(int index, address_space &space, offs_t offset, UINT16 mask) const { return m_subread[index].r16(space, offset, mask); }
+	UINT32 read_subunit(int index, address_space &space, offs_t offset, UINT32 mask) const { return m_subread[index].r32(space, offset, mask); }
+
 	// stubs for reading I/O ports
 	template<typename _UintType>
 	_UintType read_stub_ioport(address_space &space, offs_t offset, _UintType mask) { return m_ioport->read(); }
@@ -425,11 +442,23 @@ public:
 	void write64(address_space &space, offs_t offset, UINT64 data, UINT64 mask) const { m_write.w64(space, offset, data, mask); }
 
 private:
+	template<typename _UintType> using write_stub = void (handler_entry_write::*)(address_space &, offs_t, _UintType, _UintType);
+
 	// stubs for converting between address sizes
 	void write_stub_16(address_space &space, offs_t offset, UINT16 data, UINT16 mask);
 	void write_stub_32(address_space &space, offs_t offset, UINT32 data, UINT32 mask);
 	void write_stub_64(address_space &space, offs_t offset, UINT64 data, UINT64 mask);
 
+	// stubs specialized at map time for one subunit, or several of the same width
+	template<typename _UintType, typename _SubType> void write_stub_single(address_space &space, offs_t offset, _UintType data, _UintType mask);
+	template<typename _UintType, typename _SubType> void write_stub_uniform(address_space &space, offs_t offset, _UintType data, _UintType mask);
+	template<typename _UintType, typename _SubType> write_stub<_UintType> pick_stub(write_stub<_UintType> mixed) const;
+
+	// write a subunit through the delegate matching its width
+	void write_subunit(int index, address_space &space, offs_t offset, UINT8 data, UINT8 mask) const { m_subwrite[index].w8(space, offset, data, mask); }
+	void write_subunit(int index, address_space &space, offs_t offset, UINT16 data, UINT16 mask) const { m_subwrite[index].w16(space, offset, data, mask); }
+	void write_subunit(int index, address_space &space, offs_t offset, UINT32 data, UINT32 mask) const { m_subwrite[index].w32(space, offset, data, mask); }
+
 	// stubs for writing I/O ports
 	template<typename _UintType>
 	void write_stub_ioport(address_space &space, offs_t offset, _UintType data, _UintType mask) { m_ioport->write(data, mask); }
@@ -522,7 +551,8 @@ public:
 
 	// getters
 	virtual handler_entry &handler(UINT32 index) const = 0;
-	bool watchpoints_enabled() const { return (m_live_lookup == s_watchpoint_table); }
+	bool watchpoints_enabled() const { return m_watchpoints; }
+	bool heatmap_enabled() const { return !m_heat.empty(); }
 
 	// address lookups
 	UINT32 lookup_live(offs_t byteaddress) const { return m_large ? lookup_live_large(byteaddress) : lookup_live_small(byteaddress); }
@@ -556,7 +586,12 @@ public:
 	}
 
 	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	void enable_watchpoints(bool enable = true) { m_watchpoints = enable; update_live_lookup(); }
+
+	// the heat map counts accesses per entry, routing them through the watchpoint table too
+	void enable_heatmap(bool enable = true);
+	void collect_heat(read_or_write readorwrite, std::vector<memory_heat_entry> &entries);
+	void total_heat(read_or_write readorwrite, std::vector<memory_heat_entry> &entries) const;
 
 	// table mapping helpers
 	void map_range(offs_t bytestart, offs_t byteend, offs_t bytemask, offs_t bytemirror, UINT16 staticentry);
@@ -587,11 +622,19 @@ protected:
 	void subtable_close(offs_t l1index);
 	UINT16 *subtable_ptr(UINT16 entry) { return &m_table[level2_index(entry, 0)]; }
 
+	// watchpoint table management
+	void update_live_lookup() { m_live_lookup = (m_watchpoints || !m_heat.empty()) ? s_watchpoint_table : &m_table[0]; }
+	void count_heat(offs_t byteaddress) { if (!m_heat.empty()) m_heat[lookup_live_nowp(byteaddress)].fetch_add(1, std::memory_order_relaxed); }
+	void heat_entry(read_or_write readorwrite, UINT16 entry, UINT64 count, std::vector<memory_heat_entry> &entries) const;
+
 	// internal state
 	std::vector<UINT16>   m_table;                    // pointer to base of table
 	UINT16 *                m_live_lookup;              // current lookup
 	address_space &         m_space;                    // pointer back to the space
 	bool                    m_large;                    // large memory model?
+	bool                    m_watchpoints;              // are watchpoints enabled?
+	std::vector<std::atomic<UINT64>> m_heat;            // accesses per entry since the last collect; empty when the heat map is off
+	std::vector<UINT64>     m_heat_total;               // accesses per entry since the heat map was enabled
 
 	// subtable_data is an internal class with information about each subtable
 	class subtable_data
@@ -634,6 +677,12 @@ private:
 		if (entry >= STATIC_COUNT)
 			if (! --handler_refcount[entry - STATIC_COUNT])
 			{
+				// a freed entry starts over when it is reused
+				if (!m_heat.empty())
+				{
+					m_heat[entry].store(0, std::memory_order_relaxed);
+					m_heat_total[entry] = 0;
+				}
 				handler(entry).deconfigure();
 				handler_next_free[entry - STATIC_COUNT] = handler_free;
 				handler_free = entry;
@@ -697,17 +746,21 @@ private:
 	template<typename _UintType>
 	_UintType watchpoint_r(address_space &space, offs_t offset, _UintType mask)
 	{
-		m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
-
-		UINT16 *oldtable = m_live_lookup;
-		m_live_lookup = &m_table[0];
-		_UintType result;
-		if (sizeof(_UintType) == 1) result = m_space.read_byte(offset);
-		if (sizeof(_UintType) == 2) result = m_space.read_word(offset << 1, mask);
-		if (sizeof(_UintType) == 4) result = m_space.read_dword(offset << 2, mask);
-		if (sizeof(_UintType) == 8) result = m_space.read_qword(offset << 3, mask);
-		m_live_lookup = oldtable;
-		return result;
+		if (m_watchpoints)
+			m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
+		count_heat(offset * sizeof(_UintType));
+
+		// dispatch to the real entry; other threads may be using the
+		// live lookup, so it must not be switched over
+		offs_t byteaddress = offset * sizeof(_UintType);
+		UINT32 entry = lookup_live_nowp(byteaddress);
+		const handler_entry_read &handler = handler_read(entry);
+		offs_t byteoffset = handler.byteoffset(byteaddress);
+		if (entry <= STATIC_BANKMAX) return *reinterpret_cast<_UintType *>(handler.ramptr(byteoffset));
+		if (sizeof(_UintType) == 1) return handler.read8(space, byteoffset, mask);
+		if (sizeof(_UintType) == 2) return handler.read16(space, byteoffset >> 1, mask);
+		if (sizeof(_UintType) == 4) return handler.read32(space, byteoffset >> 2, mask);
+		return handler.read64(space, byteoffset >> 3, mask);
 	}
 
 	// internal state
@@ -767,15 +820,24 @@ private:
 	template<typename _UintType>
 	void watchpoint_w(address_space &space, offs_t offset, _UintType data, _UintType mask)
 	{
-		m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
-
-		UINT16 *oldtable = m_live_lookup;
-		m_live_lookup = &m_table[0];
-		if (sizeof(_UintType) == 1) m_space.write_byte(offset, data);
-		if (sizeof(_UintType) == 2) m_space.write_word(offset << 1, data, mask);
-		if (sizeof(_UintType) == 4) m_space.write_dword(offset << 2, data, mask);
-		if (sizeof(_UintType) == 8) m_space.write_qword(offset << 3, data, mask);
-		m_live_lookup = oldtable;
+		if (m_watchpoints)
+			m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
+		count_heat(offset * sizeof(_UintType));
+
+		// dispatch to the real entry, as for reads
+		offs_t byteaddress = offset * sizeof(_UintType);
+		UINT32 entry = lookup_live_nowp(byteaddress);
+		const handler_entry_write &handler = handler_write(entry);
+		offs_t byteoffset = handler.byteoffset(byteaddress);
+		if (entry <= STATIC_BANKMAX)
+		{
+			_UintType *dest = reinterpret_cast<_UintType *>(handler.ramptr(byteoffset));
+			*dest = (*dest & ~mask) | (data & mask);
+		}
+		else if (sizeof(_UintType) == 1) handler.write8(space, byteoffset, data, mask);
+		else if (sizeof(_UintType) == 2) handler.write16(space, byteoffset >> 1, data, mask);
+		else if (sizeof(_UintType) == 4) handler.write32(space, byteoffset >> 2, data, mask);
+		else if (sizeof(_UintType) == 8) handler.write64(space, byteoffset >> 3, data, mask);
 	}
 
 	// internal state
@@ -1148,6 +1210,80 @@ public:
 		g_profiler.stop();
 	}
 
+	// aligned read of a lane narrower than the bus; RAM and ROM are read in place
+	template<typename _TargetType>
+	_TargetType read_native_lane(offs_t offset, UINT32 offsbits, _TargetType mask)
+	{
+		g_profiler.start(PROFILER_MEMREAD);
+
+		if (TEST_HANDLER) printf("[r%X,%s]", offset, core_i64_hex_format((_NativeType)mask << offsbits, sizeof(_NativeType) * 2));
+
+		// look up the handler
+		offs_t byteaddress = offset & m_bytemask;
+		UINT32 entry = read_lookup(byteaddress);
+		const handler_entry_read &handler = m_read.handler_read(entry);
+
+		// either read just the lane from RAM, or call the delegate with a shifted mask
+		offset = handler.byteoffset(byteaddress);
+		_TargetType result;
+		if (entry <= STATIC_BANKMAX)
+		{
+#ifdef LSB_FIRST
+			UINT32 lanebyte = offsbits / 8;
+#else
+			UINT32 lanebyte = NATIVE_BYTES - sizeof(_TargetType) - offsbits / 8;
+#endif
+			result = *reinterpret_cast<_TargetType *>(handler.ramptr(offset) + lanebyte);
+		}
+		else
+		{
+			_NativeType nativemask = (_NativeType)mask << offsbits;
+			_NativeType native = 0;
+			if (sizeof(_NativeType) == 2) native = handler.read16(*this, offset >> 1, nativemask);
+			else if (sizeof(_NativeType) == 4) native = handler.read32(*this, offset >> 2, nativemask);
+			else if (sizeof(_NativeType) == 8) native = handler.read64(*this, offset >> 3, nativemask);
+			result = native >> offsbits;
+		}
+
+		g_profiler.stop();
+		return result;
+	}
+
+	// aligned write of a lane narrower than the bus; RAM is written in place
+	template<typename _TargetType>
+	void write_native_lane(offs_t offset, UINT32 offsbits, _TargetType data, _TargetType mask)
+	{
+		g_profiler.start(PROFILER_MEMWRITE);
+
+		// look up the handler
+		offs_t byteaddress = offset & m_bytemask;
+		UINT32 entry = write_lookup(byteaddress);
+		const handler_entry_write &handler = m_write.handler_write(entry);
+
+		// either write just the lane to RAM, or call the delegate with shifted data and mask
+		offset = handler.byteoffset(byteaddress);
+		if (entry <= STATIC_BANKMAX)
+		{
+#ifdef LSB_FIRST
+			UINT32 lanebyte = offsbits / 8;
+#else
+			UINT32 lanebyte = NATIVE_BYTES - sizeof(_TargetType) - offsbits / 8;
+#endif
+			_TargetType *dest = reinterpret_cast<_TargetType *>(handler.ramptr(offset) + lanebyte);
+			*dest = (*dest & ~mask) | (data & mask);
+		}
+		else
+		{
+			_NativeType nativedata = (_NativeType)data << offsbits;
+			_NativeType nativemask = (_NativeType)mask << offsbits;
+			if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, nativedata, nativemask);
+			else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, nativedata, nativemask);
+			else if (sizeof(_NativeType) == 8) handler.write64(*this, offset >> 3, nativedata, nativemask);
+		}
+
+		g_profiler.stop();
+	}
+
 	// generic direct read
 	template<typename _TargetType, bool _Aligned>
 	_TargetType read_direct(offs_t address, _TargetType mask)
@@ -1166,6 +1302,8 @@ public:
 			if (_Aligned || (offsbits + TARGET_BITS <= NATIVE_BITS))
 			{
 				if (_Endian != ENDIANNESS_LITTLE) offsbits = NATIVE_BITS - TARGET_BITS - offsbits;
+				if (_Aligned)
+					return read_native_lane<_TargetType>(address & ~NATIVE_MASK, offsbits, mask);
 				return read_native(address & ~NATIVE_MASK, (_NativeType)mask << offsbits) >> offsbits;
 			}
 		}
@@ -1294,6 +1432,8 @@ public:
 			if (_Aligned || (offsbits + TARGET_BITS <= NATIVE_BITS))
 			{
 				if (_Endian != ENDIANNESS_LITTLE) offsbits = NATIVE_BITS - TARGET_BITS - offsbits;
+				if (_Aligned)
+					return write_native_lane<_TargetType>(address & ~NATIVE_MASK, offsbits, data, mask);
 				return write_native(address & ~NATIVE_MASK, (_NativeType)data << offsbits, (_NativeType)mask << offsbits);
 			}
 		}
@@ -1509,7 +1649,9 @@ static void generate_memdump(running_machine &machine);
 memory_manager::memory_manager(running_machine &machine)
 	: m_machine(machine),
 		m_initialized(false),
-		m_banknext(STATIC_BANK1)
+		m_banknext(STATIC_BANK1),
+		m_heatframe_count(0),
+		m_heatmap_notifiers(false)
 {
 	memset(m_bank_ptr, 0, sizeof(m_bank_ptr));
 }
@@ -1595,6 +1737,192 @@ void memory_manager::dump(FILE *file)
 }
 
 
+//-------------------------------------------------
+//  heatmap_start - count accesses in every
+//  address space and save them to the given file
+//  at exit
+//-------------------------------------------------
+
+void memory_manager::heatmap_start(const char *filename)
+{
+	for (address_space *space = m_spacelist.first(); space != nullptr; space = space->next())
+		enable_heatmap(*space);
+	m_heatmap_file.assign(filename);
+}
+
+
+//-------------------------------------------------
+//  enable_heatmap - start or stop counting
+//  accesses in one address space
+//-------------------------------------------------
+
+void memory_manager::enable_heatmap(address_space &space, bool enable)
+{
+	// snapshots are taken once per frame while any space is being counted
+	if (enable && !m_heatmap_notifiers)
+	{
+		machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(memory_manager::heatmap_frame), this));
+		machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(memory_manager::heatmap_exit), this));
+		m_heatmap_notifiers = true;
+	}
+	space.enable_heatmap(enable);
+}
+
+
+//-------------------------------------------------
+//  heatmap_frame - gather the accesses of the
+//  frame that just completed
+//-------------------------------------------------
+
+void memory_manager::heatmap_frame()
+{
+	// nothing to do unless some space is being counted
+	address_space *space;
+	for (space = m_spacelist.first(); space != nullptr; space = space->next())
+		if (space->heatmap_enabled())
+			break;
+	if (space == nullptr)
+		return;
+
+	// reuse the oldest slot once the ring is full
+	if (m_heatframes.size() < HEATMAP_FRAMES)
+		m_heatframes.emplace_back();
+	heat_frame &frame = m_heatframes[m_heatframe_count % HEATMAP_FRAMES];
+	frame.m_frame = m_heatframe_count++;
+	frame.m_time = machine().time();
+	frame.m_entries.clear();
+	for (space = m_spacelist.first(); space != nullptr; space = space->next())
+		if (space->heatmap_enabled())
+			space->heatmap_collect(frame.m_entries);
+}
+
+
+//-------------------------------------------------
+//  heatmap_exit - write the file requested on
+//  the command line
+//-------------------------------------------------
+
+void memory_manager::heatmap_exit()
+{
+	if (!m_heatmap_file.empty() && !heatmap_save(m_heatmap_file.c_str()))
+		osd_printf_error("Unable to write heat map file '%s'\n", m_heatmap_file.c_str());
+}
+
+
+//-------------------------------------------------
+//  heatmap_totals - return the accesses counted
+//  in every space since its heat map started,
+//  hottest first
+//-------------------------------------------------
+
+void memory_manager::heatmap_totals(std::vector<memory_heat_entry> &entries)
+{
+	entries.clear();
+	for (address_space *space = m_spacelist.first(); space != nullptr; space = space->next())
+		if (space->heatmap_enabled())
+			space->heatmap_totals(entries);
+	std::stable_sort(entries.begin(), entries.end(), [](const memory_heat_entry &a, const memory_heat_entry &b) { return a.m_count > b.m_count; });
+}
+
+
+//-------------------------------------------------
+//  heatmap_last_frame - return the accesses
+//  counted during the most recent frame
+//-------------------------------------------------
+
+void memory_manager::heatmap_last_frame(std::vector<memory_heat_entry> &entries) const
+{
+	entries.clear();
+	if (m_heatframe_count != 0)
+		entries = m_heatframes[(m_heatframe_count - 1) % HEATMAP_FRAMES].m_entries;
+}
+
+
+//-------------------------------------------------
+//  heatmap_save - write the totals and the kept
+//  frames as JSON if the file name ends in
+//  .json, or as CSV otherwise
+//-------------------------------------------------
+
+static std::string heatmap_quote(const std::string &name, bool json)
+{
+	// JSON escapes quotes and backslashes; CSV doubles quotes
+	std::string result("\"");
+	for (char ch : name)
+	{
+		if (ch == '"')
+			result.append(json ? "\\\"" : "\"\"");
+		else if (ch == '\\' && json)
+			result.append("\\\\");
+		else if (UINT8(ch) >= 0x20)
+			result.push_back(ch);
+	}
+	result.push_back('"');
+	return result;
+}
+
+bool memory_manager::heatmap_save(const char *filename)
+{
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(filename) != FILERR_NONE)
+		return false;
+
+	std::string name(filename);
+	bool json = (name.length() >= 5 && core_stricmp(name.substr(name.length() - 5).c_str(), ".json") == 0);
+
+	// frames in the order they were taken, followed by the totals
+	std::vector<memory_heat_entry> totals;
+	heatmap_totals(totals);
+	UINT64 first = (m_heatframe_count > HEATMAP_FRAMES) ? m_heatframe_count - HEATMAP_FRAMES : 0;
+
+	auto write_entry = [&file, json](const memory_heat_entry &entry, bool comma, const char *prefix)
+	{
+		address_space &space = *entry.m_space;
+		if (json)
+			file.printf("%s\n\t\t\t{ \"device\": \"%s\", \"space\": \"%s\", \"access\": \"%s\", \"start\": \"%s\", \"end\": \"%s\", \"handler\": %s, \"count\": %" I64FMT "u }",
+					comma ? "," : "", space.device().tag(), space.name(), (entry.m_row == ROW_READ) ? "read" : "write",
+					core_i64_hex_format(space.byte_to_address(entry.m_bytestart), space.addrchars()), core_i64_hex_format(space.byte_to_address_end(entry.m_byteend), space.addrchars()),
+					heatmap_quote(entry.m_name, true).c_str(), entry.m_count);
+		else
+			file.printf("%s,%s,%s,%s,%s,%s,%s,%" I64FMT "u\n",
+					prefix, space.device().tag(), space.name(), (entry.m_row == ROW_READ) ? "read" : "write",
+					core_i64_hex_format(space.byte_to_address(entry.m_bytestart), space.addrchars()), core_i64_hex_format(space.byte_to_address_end(entry.m_byteend), space.addrchars()),
+					heatmap_quote(entry.m_name, false).c_str(), entry.m_count);
+	};
+
+	if (json)
+	{
+		file.printf("{\n\t\"system\": \"%s\",\n\t\"frames\": [", machine().system().name);
+		for (UINT64 framenum = first; framenum < m_heatframe_count; framenum++)
+		{
+			const heat_frame &frame = m_heatframes[framenum % HEATMAP_FRAMES];
+			file.printf("%s\n\t\t{ \"frame\": %" I64FMT "u, \"time\": %s, \"entries\": [", (framenum == first) ? "" : ",", frame.m_frame, frame.m_time.as_string(9));
+			for (size_t index = 0; index < frame.m_entries.size(); index++)
+				write_entry(frame.m_entries[index], index != 0, nullptr);
+			file.puts(" ] }");
+		}
+		file.puts("\n\t],\n\t\"total\": [");
+		for (size_t index = 0; index < totals.size(); index++)
+			write_entry(totals[index], index != 0, nullptr);
+		file.puts(" ]\n}\n");
+	}
+	else
+	{
+		file.puts("frame,device,space,access,start,end,handler,count\n");
+		for (UINT64 framenum = first; framenum < m_heatframe_count; framenum++)
+		{
+			const heat_frame &frame = m_heatframes[framenum % HEATMAP_FRAMES];
+			std::string prefix = strformat("%" I64FMT "u", frame.m_frame);
+			for (const memory_heat_entry &entry : frame.m_entries)
+				write_entry(entry, false, prefix.c_str());
+		}
+		for (const memory_heat_entry &entry : totals)
+			write_entry(entry, false, "total");
+	}
+	return true;
+}
+
+
 //-------------------------------------------------
 //  region_alloc - allocates memory for a region
 //-------------------------------------------------
@@ -1674,6 +2002,7 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_spacenum(spacenum),
 		m_debugger_access(false),
 		m_log_unmap(true),
+		m_heatmap(false),
 		m_direct(std::make_unique<direct_read_data>(*this)),
 		m_name(memory.space_config(spacenum)->name()),
 		m_addrchars((m_config.m_addrbus_width + 3) / 4),
@@ -2197,6 +2526,43 @@ void address_space::dump_map(FILE *file, read_or_write readorwrite)
 	}
 }
 
+//-------------------------------------------------
+//  enable_heatmap - start or stop counting
+//  accesses per handler; while counting, every
+//  access goes through the watchpoint table
+//-------------------------------------------------
+
+void address_space::enable_heatmap(bool enable)
+{
+	m_heatmap = enable;
+	read().enable_heatmap(enable);
+	write().enable_heatmap(enable);
+}
+
+
+//-------------------------------------------------
+//  heatmap_collect - append the accesses counted
+//  since the last collect
+//-------------------------------------------------
+
+void address_space::heatmap_collect(std::vector<memory_heat_entry> &entries)
+{
+	read().collect_heat(ROW_READ, entries);
+	write().collect_heat(ROW_WRITE, entries);
+}
+
+
+//-------------------------------------------------
+//  heatmap_totals - append the accesses counted
+//  since the heat map was enabled
+//-------------------------------------------------
+
+void address_space::heatmap_totals(std::vector<memory_heat_entry> &entries)
+{
+	read().total_heat(ROW_READ, entries);
+	write().total_heat(ROW_WRITE, entries);
+}
+
 
 //**************************************************************************
 //  DYNAMIC ADDRESS SPACE MAPPING
@@ -2688,6 +3054,7 @@ address_table::address_table(address_space &space, bool large)
 	: m_table(1 << LEVEL1_BITS),
 		m_space(space),
 		m_large(large),
+		m_watchpoints(false),
 		m_subtable(SUBTABLE_COUNT),
 		m_subtable_alloc(0)
 {
@@ -3495,6 +3862,82 @@ const char *address_table::handler_name(UINT16 entry) const
 }
 
 
+//-------------------------------------------------
+//  enable_heatmap - start or stop counting
+//  accesses per entry
+//-------------------------------------------------
+
+void address_table::enable_heatmap(bool enable)
+{
+	// the counters are bumped with relaxed atomics, since CPUs in execution
+	// groups can access the same space from several threads at once
+	if (enable)
+	{
+		std::vector<std::atomic<UINT64>> heat(ENTRY_COUNT);
+		for (auto &count : heat)
+			count.store(0, std::memory_order_relaxed);
+		m_heat.swap(heat);
+		m_heat_total.assign(ENTRY_COUNT, 0);
+	}
+	else
+	{
+		m_heat.clear();
+		m_heat_total.clear();
+	}
+	update_live_lookup();
+}
+
+
+//-------------------------------------------------
+//  collect_heat - append the entries accessed
+//  since the last collect and fold them into
+//  the totals
+//-------------------------------------------------
+
+void address_table::collect_heat(read_or_write readorwrite, std::vector<memory_heat_entry> &entries)
+{
+	for (UINT16 entry = 0; entry < m_heat.size(); entry++)
+		if (m_heat[entry].load(std::memory_order_relaxed) != 0)
+		{
+			UINT64 count = m_heat[entry].exchange(0, std::memory_order_relaxed);
+			heat_entry(readorwrite, entry, count, entries);
+			m_heat_total[entry] += count;
+		}
+}
+
+
+//-------------------------------------------------
+//  total_heat - append every entry accessed since
+//  the heat map was enabled
+//-------------------------------------------------
+
+void address_table::total_heat(read_or_write readorwrite, std::vector<memory_heat_entry> &entries) const
+{
+	for (UINT16 entry = 0; entry < m_heat_total.size(); entry++)
+		if (m_heat_total[entry] != 0)
+			heat_entry(readorwrite, entry, m_heat_total[entry], entries);
+}
+
+
+//-------------------------------------------------
+//  heat_entry - describe one entry of the heat
+//  map
+//-------------------------------------------------
+
+void address_table::heat_entry(read_or_write readorwrite, UINT16 entry, UINT64 count, std::vector<memory_heat_entry> &entries) const
+{
+	memory_heat_entry heat;
+	heat.m_space = &m_space;
+	heat.m_row = readorwrite;
+	heat.m_entry = entry;
+	heat.m_bytestart = handler(entry).bytestart();
+	heat.m_byteend = handler(entry).byteend();
+	heat.m_name = handler_name(entry);
+	heat.m_count = count;
+	entries.push_back(std::move(heat));
+}
+
+
 //-------------------------------------------------
 //  address_table_read - constructor
 //-------------------------------------------------
@@ -4378,11 +4821,11 @@ void handler_entry_read::set_delegate(read8_delegate delegate, UINT64 mask)
 			m_subread[i].r8 = delegate;
 		}
 		if (m_datawidth == 16)
-			set_delegate(read16_delegate(&handler_entry_read::read_stub_16, delegate.name(), this));
+			set_delegate(read16_delegate(pick_stub<UINT16, UINT8>(&handler_entry_read::read_stub_16), delegate.name(), this));
 		else if (m_datawidth == 32)
-			set_delegate(read32_delegate(&handler_entry_read::read_stub_32, delegate.name(), this));
+			set_delegate(read32_delegate(pick_stub<UINT32, UINT8>(&handler_entry_read::read_stub_32), delegate.name(), this));
 		else if (m_datawidth == 64)
-			set_delegate(read64_delegate(&handler_entry_read::read_stub_64, delegate.name(), this));
+			set_delegate(read64_delegate(pick_stub<UINT64, UINT8>(&handler_entry_read::read_stub_64), delegate.name(), this));
 	}
 	else
 	{
@@ -4415,9 +4858,9 @@ void handler_entry_read::set_delegate(read16_delegate delegate, UINT64 mask)
 			m_subread[i].r16 = delegate;
 		}
 		if (m_datawidth == 32)
-			set_delegate(read32_delegate(&handler_entry_read::read_stub_32, delegate.name(), this));
+			set_delegate(read32_delegate(pick_stub<UINT32, UINT16>(&handler_entry_read::read_stub_32), delegate.name(), this));
 		else if (m_datawidth == 64)
-			set_delegate(read64_delegate(&handler_entry_read::read_stub_64, delegate.name(), this));
+			set_delegate(read64_delegate(pick_stub<UINT64, UINT16>(&handler_entry_read::read_stub_64), delegate.name(), this));
 	}
 	else
 	{
@@ -4450,7 +4893,7 @@ void handler_entry_read::set_delegate(read32_delegate delegate, UINT64 mask)
 			m_subread[i].r32 = delegate;
 		}
 		if (m_datawidth == 64)
-			set_delegate(read64_delegate(&handler_entry_read::read_stub_64, delegate.name(), this));
+			set_delegate(read64_delegate(pick_stub<UINT64, UINT32>(&handler_entry_read::read_stub_64), delegate.name(), this));
 	}
 	else
 	{
@@ -4585,6 +5028,63 @@ UINT64 handler_entry_read::read_stub_64(address_space &space, offs_t offset, UIN
 }
 
 
+//-------------------------------------------------
+//  pick_stub - choose the stub that builds a
+//  bus-width read from the configured subunits
+//-------------------------------------------------
+
+template<typename _UintType, typename _SubType>
+handler_entry_read::read_stub<_UintType> handler_entry_read::pick_stub(read_stub<_UintType> mixed) const
+{
+	// handlers of different widths need the generic stub, which switches on each width
+	for (int index = 0; index < m_subunits; index++)
+		if (m_subunit_infos[index].m_size != 8 * sizeof(_SubType))
+			return mixed;
+
+	// otherwise drop the loop for a lone handler, or just the switch for several
+	if (m_subunits == 1)
+		return &handler_entry_read::read_stub_single<_UintType, _SubType>;
+	return &handler_entry_read::read_stub_uniform<_UintType, _SubType>;
+}
+
+
+//-------------------------------------------------
+//  read_stub_single - construct a bus-width read
+//  from a single narrower handler
+//-------------------------------------------------
+
+template<typename _UintType, typename _SubType>
+_UintType handler_entry_read::read_stub_single(address_space &space, offs_t offset, _UintType mask)
+{
+	const subunit_info &si = m_subunit_infos[0];
+	_UintType result = space.unmap() & m_invsubmask;
+	_SubType submask = mask >> si.m_shift;
+	if (submask)
+		result |= _UintType(read_subunit(0, space, offset * si.m_multiplier + si.m_offset, submask)) << si.m_shift;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  read_stub_uniform - construct a bus-width read
+//  from several handlers of the same width
+//-------------------------------------------------
+
+template<typename _UintType, typename _SubType>
+_UintType handler_entry_read::read_stub_uniform(address_space &space, offs_t offset, _UintType mask)
+{
+	_UintType result = space.unmap() & m_invsubmask;
+	for (int index = 0; index < m_subunits; index++)
+	{
+		const subunit_info &si = m_subunit_infos[index];
+		_SubType submask = mask >> si.m_shift;
+		if (submask)
+			result |= _UintType(read_subunit(index, space, offset * si.m_multiplier + si.m_offset, submask)) << si.m_shift;
+	}
+	return result;
+}
+
+
 //**************************************************************************
 //  HANDLER ENTRY WRITE
 //**************************************************************************
@@ -4687,11 +5187,11 @@ void handler_entry_write::set_delegate(write8_delegate delegate, UINT64 mask)
 			m_subwrite[i].w8 = delegate;
 		}
 		if (m_datawidth == 16)
-			set_delegate(write16_delegate(&handler_entry_write::write_stub_16, delegate.name(), this));
+			set_delegate(write16_delegate(pick_stub<UINT16, UINT8>(&handler_entry_write::write_stub_16), delegate.name(), this));
 		else if (m_datawidth == 32)
-			set_delegate(write32_delegate(&handler_entry_write::write_stub_32, delegate.name(), this));
+			set_delegate(write32_delegate(pick_stub<UINT32, UINT8>(&handler_entry_write::write_stub_32), delegate.name(), this));
 		else if (m_datawidth == 64)
-			set_delegate(write64_delegate(&handler_entry_write::write_stub_64, delegate.name(), this));
+			set_delegate(write64_delegate(pick_stub<UINT64, UINT8>(&handler_entry_write::write_stub_64), delegate.name(), this));
 	}
 	else
 	{
@@ -4719,9 +5219,9 @@ void handler_entry_write::set_delegate(write16_delegate delegate, UINT64 mask)
 			m_subwrite[i].w16 = delegate;
 		}
 		if (m_datawidth == 32)
-			set_delegate(write32_delegate(&handler_entry_write::write_stub_32, delegate.name(), this));
+			set_delegate(write32_delegate(pick_stub<UINT32, UINT16>(&handler_entry_write::write_stub_32), delegate.name(), this));
 		else if (m_datawidth == 64)
-			set_delegate(write64_delegate(&handler_entry_write::write_stub_64, delegate.name(), this));
+			set_delegate(write64_delegate(pick_stub<UINT64, UINT16>(&handler_entry_write::write_stub_64), delegate.name(), this));
 	}
 	else
 	{
@@ -4749,7 +5249,7 @@ void handler_entry_write::set_delegate(write32_delegate delegate, UINT64 mask)
 			m_subwrite[i].w32 = delegate;
 		}
 		if (m_datawidth == 64)
-			set_delegate(write64_delegate(&handler_entry_write::write_stub_64, delegate.name(), this));
+			set_delegate(write64_delegate(pick_stub<UINT64, UINT32>(&handler_entry_write::write_stub_64), delegate.name(), this));
 	}
 	else
 	{
@@ -4868,3 +5368,56 @@ void handler_entry_write::write_stub_64(address_space &space, offs_t offset, UIN
 		}
 	}
 }
+
+
+//-------------------------------------------------
+//  pick_stub - choose the stub that splits a
+//  bus-width write among the configured subunits
+//-------------------------------------------------
+
+template<typename _UintType, typename _SubType>
+handler_entry_write::write_stub<_UintType> handler_entry_write::pick_stub(write_stub<_UintType> mixed) const
+{
+	// handlers of different widths need the generic stub, which switches on each width
+	for (int index = 0; index < m_subunits; index++)
+		if (m_subunit_infos[index].m_size != 8 * sizeof(_SubType))
+			return mixed;
+
+	// otherwise drop the loop for a lone handler, or just the switch for several
+	if (m_subunits == 1)
+		return &handler_entry_write::write_stub_single<_UintType, _SubType>;
+	return &handler_entry_write::write_stub_uniform<_UintType, _SubType>;
+}
+
+
+//-------------------------------------------------
+//  write_stub_single - pass a bus-width write to
+//  a single narrower handler
+//-------------------------------------------------
+
+template<typename _UintType, typename _SubType>
+void handler_entry_write::write_stub_single(address_space &space, offs_t offset, _UintType data, _UintType mask)
+{
+	const subunit_info &si = m_subunit_infos[0];
+	_SubType submask = mask >> si.m_shift;
+	if (submask)
+		write_subunit(0, space, offset * si.m_multiplier + si.m_offset, _SubType(data >> si.m_shift), submask);
+}
+
+
+//-------------------------------------------------
+//  write_stub_uniform - split a bus-width write
+//  among several handlers of the same width
+//-------------------------------------------------
+
+template<typename _UintType, typename _SubType>
+void handler_entry_write::write_stub_uniform(address_space &space, offs_t offset, _UintType data, _UintType mask)
+{
+	for (int index = 0; index < m_subunits; index++)
+	{
+		const subunit_info &si = m_subunit_infos[index];
+		_SubType submask = mask >> si.m_shift;
+		if (submask)
+			write_subunit(index, space, offset * si.m_multiplier + si.m_offset, _SubType(data >> si.m_shift), submask);
+	}
+}
@@ -106,6 +106,21 @@ struct data_accessors
 };
 
 
+// ======================> memory_heat_entry
+
+// accesses counted by the heat map for one handler table entry
+struct memory_heat_entry
+{
+	address_space *     m_space;            // space the entry belongs to
+	read_or_write       m_row;              // ROW_READ or ROW_WRITE
+	UINT16              m_entry;            // index in the handler table
+	offs_t              m_bytestart;        // first byte address the handler covers
+	offs_t              m_byteend;          // last byte address the handler covers
+	std::string         m_name;             // handler or bank description
+	UINT64              m_count;            // number of accesses
+};
+
+
 // ======================> direct_update_delegate
 
 // direct region update handler
@@ -303,6 +318,12 @@ public:
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
 
+	// access heat map
+	bool heatmap_enabled() const { return m_heatmap; }
+	void enable_heatmap(bool enable = true);
+	void heatmap_collect(std::vector<memory_heat_entry> &entries);
+	void heatmap_totals(std::vector<memory_heat_entry> &entries);
+
 	// general accessors
 	virtual void accessors(data_accessors &accessors) const = 0;
 	virtual void *get_read_ptr(offs_t byteaddress) = 0;
@@ -472,6 +493,7 @@ protected:
 	address_spacenum        m_spacenum;         // address space index
 	bool                    m_debugger_access;  // treat accesses as coming from the debugger
 	bool                    m_log_unmap;        // log unmapped accesses in this space?
+	bool                    m_heatmap;          // counting accesses per handler?
 	std::unique_ptr<direct_read_data> m_direct;    // fast direct-access read info
 	const char *            m_name;             // friendly name of the address space
 	UINT8                   m_addrchars;        // number of characters to use for physical addresses
@@ -732,6 +754,14 @@ public:
 	// dump the internal memory tables to the given file
 	void dump(FILE *file);
 
+	// access heat map
+	void heatmap_start(const char *filename);
+	void enable_heatmap(address_space &space, bool enable = true);
+	bool heatmap_save(const char *filename);
+	UINT64 heatmap_frames() const { return m_heatframe_count; }
+	void heatmap_totals(std::vector<memory_heat_entry> &entries);
+	void heatmap_last_frame(std::vector<memory_heat_entry> &entries) const;
+
 	// pointers to a bank pointer (internal usage only)
 	UINT8 **bank_pointer_addr(UINT8 index) { return &m_bank_ptr[index]; }
 
@@ -746,6 +776,16 @@ private:
 	memory_region *region(const char *tag) { return m_regionlist.find(tag); }
 	memory_share *shared(const char *tag) { return m_sharelist.find(tag); }
 	void bank_reattach();
+	void heatmap_frame();
+	void heatmap_exit();
+
+	// accesses counted during one frame
+	struct heat_frame
+	{
+		UINT64                  m_frame;                // frame number since the heat map started
+		attotime                m_time;                 // emulated time at the end of the frame
+		std::vector<memory_heat_entry> m_entries;       // entries accessed during the frame
+	};
 
 	// internal state
 	running_machine &           m_machine;              // reference to the machine
@@ -762,6 +802,11 @@ private:
 	tagged_list<memory_share>   m_sharelist;            // map for share lookups
 
 	tagged_list<memory_region>  m_regionlist;           // list of memory regions
+
+	std::vector<heat_frame>     m_heatframes;           // ring of the most recent frames of the heat map
+	UINT64                      m_heatframe_count;      // frames since the heat map started
+	bool                        m_heatmap_notifiers;    // frame and exit notifiers registered?
+	std::string                 m_heatmap_file;         // file written at exit, if any
 };
 
 
@@ -44,6 +44,9 @@ struct profile_string
 
 profiler_state g_profiler;
 
+// innermost timing scope on each thread
+thread_local profile_ticks_scope *profile_ticks_scope::s_current = nullptr;
+
 
 
 //**************************************************************************
@@ -52,6 +55,58 @@ profiler_state g_profiler;
 
 #define TEXT_UPDATE_TIME        0.5
 
+static const profile_string s_names[] =
+{
+	{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
+	{ PROFILER_MEM_REMAP,        "Memory Remapping" },
+	{ PROFILER_MEMREAD,          "Memory Read" },
+	{ PROFILER_MEMWRITE,         "Memory Write" },
+	{ PROFILER_VIDEO,            "Video Update" },
+	{ PROFILER_DRAWGFX,          "drawgfx" },
+	{ PROFILER_COPYBITMAP,       "copybitmap" },
+	{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
+	{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
+	{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
+	{ PROFILER_BLIT,             "OSD Blitting" },
+	{ PROFILER_SOUND,            "Sound Generation" },
+	{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
+	//MKCHAMP - INCLUDING THE HISCORE ENGINE TO THE PROFILER
+	{ PROFILER_HISCORE,          "Hiscore" },
+	{ PROFILER_INPUT,            "Input Processing" },
+	{ PROFILER_MOVIE_REC,        "Movie Recording" },
+	{ PROFILER_LOGERROR,         "Error Logging" },
+	{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
+	{ PROFILER_USER1,            "User 1" },
+	{ PROFILER_USER2,            "User 2" },
+	{ PROFILER_USER3,            "User 3" },
+	{ PROFILER_USER4,            "User 4" },
+	{ PROFILER_USER5,            "User 5" },
+	{ PROFILER_USER6,            "User 6" },
+	{ PROFILER_USER7,            "User 7" },
+	{ PROFILER_USER8,            "User 8" },
+	{ PROFILER_PROFILER,         "Profiler" },
+	{ PROFILER_IDLE,             "Idle" }
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  profile_type_name - return the display name
+//  of a non-device profiler type
+//-------------------------------------------------
+
+static const char *profile_type_name(profile_type type)
+{
+	for (auto & name : s_names)
+		if (name.type == type)
+			return name.string;
+	return nullptr;
+}
+
 
 
 //**************************************************************************
@@ -111,6 +166,20 @@ void real_profiler_state::reset(bool enabled)
 
 
 
+//-------------------------------------------------
+//  collect - add the data gathered so far into
+//  an external array, then reset it
+//-------------------------------------------------
+
+void real_profiler_state::collect(osd_ticks_t *dest)
+{
+	for (int curtype = PROFILER_DEVICE_FIRST; curtype <= PROFILER_TOTAL; curtype++)
+		dest[curtype] += m_data[curtype];
+	memset(m_data, 0, sizeof(m_data));
+}
+
+
+
 //-------------------------------------------------
 //  text - return the current text in an std::string
 //-------------------------------------------------
@@ -141,39 +210,6 @@ const char *real_profiler_state::text(running_machine &machine)
 
 void real_profiler_state::update_text(running_machine &machine)
 {
-	static const profile_string names[] =
-	{
-		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
-		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
-		{ PROFILER_MEMREAD,          "Memory Read" },
-		{ PROFILER_MEMWRITE,         "Memory Write" },
-		{ PROFILER_VIDEO,            "Video Update" },
-		{ PROFILER_DRAWGFX,          "drawgfx" },
-		{ PROFILER_COPYBITMAP,       "copybitmap" },
-		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
-		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
-		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
-		{ PROFILER_BLIT,             "OSD Blitting" },
-		{ PROFILER_SOUND,            "Sound Generation" },
-		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
-		//MKCHAMP - INCLUDING THE HISCORE ENGINE TO THE PROFILER
-		{ PROFILER_HISCORE,          "Hiscore" },
-		{ PROFILER_INPUT,            "Input Processing" },
-		{ PROFILER_MOVIE_REC,        "Movie Recording" },
-		{ PROFILER_LOGERROR,         "Error Logging" },
-		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
-		{ PROFILER_USER1,            "User 1" },
-		{ PROFILER_USER2,            "User 2" },
-		{ PROFILER_USER3,            "User 3" },
-		{ PROFILER_USER4,            "User 4" },
-		{ PROFILER_USER5,            "User 5" },
-		{ PROFILER_USER6,            "User 6" },
-		{ PROFILER_USER7,            "User 7" },
-		{ PROFILER_USER8,            "User 8" },
-		{ PROFILER_PROFILER,         "Profiler" },
-		{ PROFILER_IDLE,             "Idle" }
-	};
-
 	// compute the total time for all bits, not including profiler or idle
 	UINT64 computed = 0;
 	profile_type curtype;
@@ -213,13 +249,8 @@ void real_profiler_state::update_text(running_machine &machine)
 			// and then the text
 			if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
 				strcatprintf(m_text, "'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
-			else
-				for (auto & name : names)
-					if (name.type == curtype)
-					{
-						m_text.append(name.string);
-						break;
-					}
+			else if (profile_type_name(curtype) != nullptr)
+				m_text.append(profile_type_name(curtype));
 
 			// followed by a carriage return
 			m_text.append("\n");
@@ -229,3 +260,149 @@ void real_profiler_state::update_text(running_machine &machine)
 	// reset data set to 0
 	memset(m_data, 0, sizeof(m_data));
 }
+
+
+
+//**************************************************************************
+//  PROFILE REPORT
+//**************************************************************************
+
+static const char *const s_group_names[] = { "devices", "streams", "screens" };
+
+//-------------------------------------------------
+//  profile_report - constructor
+//-------------------------------------------------
+
+profile_report::profile_report(running_machine &machine, const char *filename)
+	: m_machine(machine),
+		m_frames(0),
+		m_start_ticks(osd_ticks()),
+		m_last_ticks(m_start_ticks),
+		m_start_time(machine.time())
+{
+	memset(m_frame_data, 0, sizeof(m_frame_data));
+	memset(m_total_data, 0, sizeof(m_total_data));
+
+	// open the output file
+	m_file = std::make_unique<emu_file>(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (m_file->open(filename) != FILERR_NONE)
+		throw emu_fatalerror("Unable to open profile report file '%s'\n", filename);
+
+	// gather the counters for every executing device, sound stream and screen
+	execute_interface_iterator execiter(machine.root_device());
+	for (device_execute_interface *exec = execiter.first(); exec != nullptr; exec = execiter.next())
+		m_counters.emplace_back(0, exec->device().tag(), exec->profile_ticks());
+	for (sound_stream *stream = machine.sound().first_stream(); stream != nullptr; stream = stream->next())
+	{
+		// devices with multiple streams get an index appended after the first
+		int index = 0;
+		for (sound_stream *other = machine.sound().first_stream(); other != stream; other = other->next())
+			if (&other->device() == &stream->device())
+				index++;
+		std::string name(stream->device().tag());
+		if (index != 0)
+			strcatprintf(name, "#%d", index);
+		m_counters.emplace_back(1, std::move(name), stream->profile_ticks());
+	}
+	screen_device_iterator screeniter(machine.root_device());
+	for (screen_device *screen = screeniter.first(); screen != nullptr; screen = screeniter.next())
+		m_counters.emplace_back(2, screen->tag(), screen->profile_ticks());
+
+	// start the profiler if it was compiled in, discarding anything gathered so far
+	g_profiler.enable(true);
+	g_profiler.collect(m_frame_data);
+	memset(m_frame_data, 0, sizeof(m_frame_data));
+
+	m_file->printf("{\n\t\"system\": \"%s\",\n\t\"ticks_per_second\": %" I64FMT "u,\n\t\"frames\": [", machine.system().name, (UINT64)osd_ticks_per_second());
+
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(profile_report::frame_update), this));
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(profile_report::exit), this));
+}
+
+
+//-------------------------------------------------
+//  ~profile_report - destructor
+//-------------------------------------------------
+
+profile_report::~profile_report()
+{
+}
+
+
+//-------------------------------------------------
+//  frame_update - write the entry for the frame
+//  that just completed
+//-------------------------------------------------
+
+void profile_report::frame_update()
+{
+	osd_ticks_t curticks = osd_ticks();
+
+	m_file->printf("%s\n\t\t{ \"frame\": %" I64FMT "u, \"time\": %s, \"ticks\": %" I64FMT "u", (m_frames == 0) ? "" : ",", m_frames, machine().time().as_string(9), (UINT64)(curticks - m_last_ticks));
+	m_last_ticks = curticks;
+	m_frames++;
+
+	// fold the profiler data into the running totals
+	g_profiler.collect(m_frame_data);
+	write_ticks(m_frame_data, false);
+	for (int curtype = PROFILER_DEVICE_FIRST; curtype <= PROFILER_TOTAL; curtype++)
+		m_total_data[curtype] += m_frame_data[curtype];
+	memset(m_frame_data, 0, sizeof(m_frame_data));
+
+	m_file->puts(" }");
+}
+
+
+//-------------------------------------------------
+//  exit - write the aggregate summary and close
+//  the report
+//-------------------------------------------------
+
+void profile_report::exit()
+{
+	// total the memory regions
+	UINT64 regionbytes = 0;
+	for (memory_region *region = machine().memory().first_region(); region != nullptr; region = region->next())
+		regionbytes += region->bytes();
+
+	m_file->printf("\n\t],\n\t\"aggregate\": { \"frames\": %" I64FMT "u, \"time\": %s, \"ticks\": %" I64FMT "u", m_frames, (machine().time() - m_start_time).as_string(9), (UINT64)(osd_ticks() - m_start_ticks));
+	g_profiler.collect(m_total_data);
+	write_ticks(m_total_data, true);
+	m_file->printf(", \"memory\": { \"regions\": %" I64FMT "u, \"state\": %u } }\n}\n", regionbytes, machine().save().state_size());
+
+	g_profiler.enable(false);
+	m_file->close();
+}
+
+
+//-------------------------------------------------
+//  write_ticks - write the profiler categories
+//  and the sampled counters
+//-------------------------------------------------
+
+void profile_report::write_ticks(const osd_ticks_t *profdata, bool aggregate)
+{
+	// profiler categories; device time is reported separately below
+	int count = 0;
+	m_file->puts(", \"profiler\": {");
+	for (profile_type curtype = PROFILER_DRC_COMPILE; curtype < PROFILER_TOTAL; ++curtype)
+		if (profdata[curtype] != 0 && profile_type_name(curtype) != nullptr)
+			m_file->printf("%s \"%s\": %" I64FMT "u", (count++ == 0) ? "" : ",", profile_type_name(curtype), (UINT64)profdata[curtype]);
+	m_file->puts(" }");
+
+	// then one object per counter group
+	for (int group = 0; group < int(ARRAY_LENGTH(s_group_names)); group++)
+	{
+		count = 0;
+		m_file->printf(", \"%s\": {", s_group_names[group]);
+		for (counter &curcounter : m_counters)
+			if (curcounter.m_group == group)
+			{
+				osd_ticks_t ticks = curcounter.m_source - (aggregate ? curcounter.m_base : curcounter.m_last);
+				if (!aggregate)
+					curcounter.m_last = curcounter.m_source;
+				m_file->printf("%s \"%s\": %" I64FMT "u", (count++ == 0) ? "" : ",", curcounter.m_name.c_str(), (UINT64)ticks);
+			}
+		m_file->puts(" }");
+	}
+}
@@ -80,6 +80,9 @@ DECLARE_ENUM_OPERATORS(profile_type)
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+// forward declarations
+class emu_file;
+
 
 // ======================> real_profiler_state
 
@@ -109,6 +112,9 @@ public:
 	void start(profile_type type) { if (enabled()) real_start(type); }
 	void stop() { if (enabled()) real_stop(); }
 
+	// accumulate the current data into an external array and reset
+	void collect(osd_ticks_t *dest);
+
 private:
 	void reset(bool enabled);
 	void update_text(running_machine &machine);
@@ -193,6 +199,9 @@ public:
 	// start/stop
 	void start(profile_type type) { }
 	void stop() { }
+
+	// accumulate the current data into an external array and reset
+	void collect(osd_ticks_t *dest) { }
 };
 
 
@@ -205,6 +214,101 @@ typedef dummy_profiler_state profiler_state;
 #endif
 
 
+// ======================> profile_report
+
+class profile_report
+{
+	DISABLE_COPYING(profile_report);
+
+public:
+	// construction/destruction
+	profile_report(running_machine &machine, const char *filename);
+	~profile_report();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+
+private:
+	// a free-running tick counter owned by a device, stream or screen
+	struct counter
+	{
+		counter(int group, std::string name, const osd_ticks_t &source)
+			: m_group(group),
+				m_name(std::move(name)),
+				m_source(source),
+				m_base(source),
+				m_last(source) { }
+
+		int                 m_group;                    // index into the group names
+		std::string         m_name;                     // name reported for this counter
+		const osd_ticks_t & m_source;                   // counter being sampled
+		osd_ticks_t         m_base;                     // value when the report started
+		osd_ticks_t         m_last;                     // value at the end of the last frame
+	};
+
+	// internal helpers
+	void frame_update();
+	void exit();
+	void write_ticks(const osd_ticks_t *profdata, bool aggregate);
+
+	// internal state
+	running_machine &   m_machine;                  // reference to our machine
+	std::unique_ptr<emu_file> m_file;               // output file
+	std::vector<counter> m_counters;                // list of sampled counters
+	UINT64              m_frames;                   // frames reported so far
+	osd_ticks_t         m_start_ticks;              // real time when the report started
+	osd_ticks_t         m_last_ticks;               // real time at the end of the last frame
+	attotime            m_start_time;               // emulated time when the report started
+	osd_ticks_t         m_frame_data[PROFILER_TOTAL + 1]; // profiler data for the current frame
+	osd_ticks_t         m_total_data[PROFILER_TOTAL + 1]; // profiler data since the report started
+};
+
+
+// ======================> profile_ticks_scope
+
+// adds the ticks spent in a scope to a counter while a report is active; a
+// scope opened inside another one on the same thread (such as a sound stream
+// brought up to date while a CPU is executing) is charged only to the inner
+// counter, so the counters never count the same ticks twice
+class profile_ticks_scope
+{
+public:
+	profile_ticks_scope(profile_report *report, osd_ticks_t &counter)
+		: m_counter((report != nullptr) ? &counter : nullptr),
+			m_parent(nullptr),
+			m_start(0),
+			m_nested(0)
+	{
+		if (m_counter != nullptr)
+		{
+			m_parent = s_current;
+			s_current = this;
+			m_start = osd_ticks();
+		}
+	}
+
+	~profile_ticks_scope()
+	{
+		if (m_counter != nullptr)
+		{
+			osd_ticks_t elapsed = osd_ticks() - m_start;
+			*m_counter += elapsed - m_nested;
+			if (m_parent != nullptr)
+				m_parent->m_nested += elapsed;
+			s_current = m_parent;
+		}
+	}
+
+private:
+	osd_ticks_t *       m_counter;                  // counter to update, or nullptr
+	profile_ticks_scope * m_parent;                 // enclosing scope on this thread
+	osd_ticks_t         m_start;                    // ticks at the start of the scope
+	osd_ticks_t         m_nested;                   // ticks spent in scopes nested inside this one
+
+	static thread_local profile_ticks_scope *s_current; // innermost active scope on this thread
+};
+
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
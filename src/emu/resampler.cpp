@@ -0,0 +1,238 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    resampler.cpp
+
+    Sample rate conversion kernels used by sound streams.
+
+***************************************************************************/
+
+#include "resampler.h"
+#include <math.h>
+
+// use SSE2 on 64-bit x86, where it can be assumed, and NEON where the compiler offers it
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define RESAMPLER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RESAMPLER_NEON
+#endif
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  dot_product - sum taps input samples weighted
+//  by the matching coefficients; taps is always
+//  a multiple of 4
+//-------------------------------------------------
+
+static inline float dot_product(const INT32 *source, const float *coeffs, int taps)
+{
+#if defined(RESAMPLER_SSE2)
+	// two accumulators, so consecutive multiply-adds don't wait on each other
+	__m128 sum0 = _mm_setzero_ps();
+	__m128 sum1 = _mm_setzero_ps();
+	int tap = 0;
+	for ( ; tap + 8 <= taps; tap += 8)
+	{
+		sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[tap])), _mm_loadu_ps(&coeffs[tap])));
+		sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[tap + 4])), _mm_loadu_ps(&coeffs[tap + 4])));
+	}
+	if (tap < taps)
+		sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[tap])), _mm_loadu_ps(&coeffs[tap])));
+	sum0 = _mm_add_ps(sum0, sum1);
+	sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+	sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+	return _mm_cvtss_f32(sum0);
+#elif defined(RESAMPLER_NEON)
+	float32x4_t sum = vdupq_n_f32(0.0f);
+	for (int tap = 0; tap < taps; tap += 4)
+		sum = vmlaq_f32(sum, vcvtq_f32_s32(vld1q_s32(&source[tap])), vld1q_f32(&coeffs[tap]));
+	float32x2_t half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+	return vget_lane_f32(vpadd_f32(half, half), 0);
+#else
+	float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+	for (int tap = 0; tap < taps; tap += 4)
+	{
+		sum0 += float(source[tap + 0]) * coeffs[tap + 0];
+		sum1 += float(source[tap + 1]) * coeffs[tap + 1];
+		sum2 += float(source[tap + 2]) * coeffs[tap + 2];
+		sum3 += float(source[tap + 3]) * coeffs[tap + 3];
+	}
+	return (sum0 + sum1) + (sum2 + sum3);
+#endif
+}
+
+
+
+//**************************************************************************
+//  SINC RESAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  sinc_resampler - constructor; tabulates a
+//  Blackman-windowed sinc for each phase
+//-------------------------------------------------
+
+sinc_resampler::sinc_resampler(UINT32 input_rate, UINT32 output_rate)
+	: m_input_rate(input_rate),
+		m_output_rate(output_rate)
+{
+	// when decimating, the cutoff drops to the output's Nyquist rate and the kernel widens to match
+	double ratio = double(input_rate) / double(output_rate);
+	if (ratio < 1.0)
+		ratio = 1.0;
+	double cutoff = 0.45 / ratio;
+	m_taps = (int(ceil(BASE_TAPS * ratio)) + 3) & ~3;
+	if (m_taps > MAX_TAPS)
+		m_taps = MAX_TAPS;
+
+	// one extra row for a fraction that rounds up to the next sample
+	int half = m_taps / 2;
+	m_coeffs.resize((PHASES + 1) * m_taps);
+	for (int phase = 0; phase <= PHASES; phase++)
+	{
+		float *row = &m_coeffs[phase * m_taps];
+		double frac = double(phase) / double(PHASES);
+		double total = 0;
+		for (int tap = 0; tap < m_taps; tap++)
+		{
+			double dist = double(tap - (half - 1)) - frac;
+			double x = M_PI * dist / double(half);
+			double window = 0.42 + 0.5 * cos(x) + 0.08 * cos(2.0 * x);
+			double sinc = (dist == 0) ? 1.0 : sin(2.0 * M_PI * cutoff * dist) / (2.0 * M_PI * cutoff * dist);
+			double coeff = window * sinc;
+			row[tap] = float(coeff);
+			total += coeff;
+		}
+
+		// normalize each phase to unity gain at DC
+		for (int tap = 0; tap < m_taps; tap++)
+			row[tap] = float(row[tap] / total);
+	}
+}
+
+
+//-------------------------------------------------
+//  resample - fill numsamples of dest, starting
+//  basefrac into source[0] and advancing step
+//  per output sample; the history() samples
+//  before source and enough after it to cover
+//  lookahead() must be readable
+//-------------------------------------------------
+
+void sinc_resampler::resample(const INT32 *source, UINT32 basefrac, UINT32 step, INT32 *dest, UINT32 numsamples, INT64 gain) const
+{
+	const float scale = float(gain) * (1.0f / 256.0f);
+	const int taps = m_taps;
+	const float *coeffs = &m_coeffs[0];
+	const UINT32 round = 1 << (RESAMPLE_FRAC_BITS - PHASE_BITS - 1);
+
+	source -= history();
+	while (numsamples--)
+	{
+		// pick the nearest phase
+		UINT32 phase = (basefrac + round) >> (RESAMPLE_FRAC_BITS - PHASE_BITS);
+		*dest++ = INT32(dot_product(source, &coeffs[phase * taps], taps) * scale);
+
+		// advance
+		basefrac += step;
+		source += basefrac >> RESAMPLE_FRAC_BITS;
+		basefrac &= RESAMPLE_FRAC_MASK;
+	}
+}
+
+
+
+//**************************************************************************
+//  LINEAR RESAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  resample_linear - fill numsamples of dest by
+//  point sampling with a blend at sample
+//  boundaries when upsampling, and averaging the
+//  covered input when downsampling
+//-------------------------------------------------
+
+void resample_linear(const INT32 *source, UINT32 basefrac, UINT32 step, INT32 *dest, UINT32 numsamples, INT64 gain)
+{
+	// if we have equal sample rates, we just need to copy
+	if (step == RESAMPLE_FRAC_ONE)
+	{
+		while (numsamples--)
+		{
+			// compute the sample
+			INT64 sample = *source++;
+			*dest++ = (sample * gain) >> 8;
+		}
+	}
+
+	// input is undersampled: point sample except where our sample period covers a boundary
+	else if (step < RESAMPLE_FRAC_ONE)
+	{
+		while (numsamples != 0)
+		{
+			// fill in with point samples until we hit a boundary
+			int nextfrac;
+			while ((nextfrac = basefrac + step) < RESAMPLE_FRAC_ONE && numsamples--)
+			{
+				*dest++ = (source[0] * gain) >> 8;
+				basefrac = nextfrac;
+			}
+
+			// if we're done, we're done
+			if (INT32(numsamples--) < 0)
+				break;
+
+			// compute starting and ending fractional positions
+			int startfrac = basefrac >> (RESAMPLE_FRAC_BITS - 12);
+			int endfrac = nextfrac >> (RESAMPLE_FRAC_BITS - 12);
+
+			// blend between the two samples accordingly
+			INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac = nextfrac & RESAMPLE_FRAC_MASK;
+			source++;
+		}
+	}
+
+	// input is oversampled: sum the energy
+	else
+	{
+		// use 8 bits to allow some extra headroom
+		int smallstep = step >> (RESAMPLE_FRAC_BITS - 8);
+		while (numsamples--)
+		{
+			INT64 remainder = smallstep;
+			int tpos = 0;
+
+			// compute the sample
+			INT64 scale = (RESAMPLE_FRAC_ONE - basefrac) >> (RESAMPLE_FRAC_BITS - 8);
+			INT64 sample = (INT64) source[tpos++] * scale;
+			remainder -= scale;
+			while (remainder > 0x100)
+			{
+				sample += (INT64) source[tpos++] * (INT64) 0x100;
+				remainder -= 0x100;
+			}
+			sample += (INT64) source[tpos] * remainder;
+			sample /= smallstep;
+
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> RESAMPLE_FRAC_BITS;
+			basefrac &= RESAMPLE_FRAC_MASK;
+		}
+	}
+}
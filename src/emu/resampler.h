@@ -0,0 +1,82 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    resampler.h
+
+    Sample rate conversion kernels used by sound streams.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __RESAMPLER_H__
+#define __RESAMPLER_H__
+
+#include "osdcomm.h"
+#include <vector>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// stream positions are tracked in fractions of an input sample
+const UINT32 RESAMPLE_FRAC_BITS     = 22;
+const UINT32 RESAMPLE_FRAC_ONE      = 1 << RESAMPLE_FRAC_BITS;
+const UINT32 RESAMPLE_FRAC_MASK     = RESAMPLE_FRAC_ONE - 1;
+
+// available resampling methods
+enum stream_resampler_type
+{
+	STREAM_RESAMPLER_LINEAR,            // point sample, blend at boundaries, box filter when decimating
+	STREAM_RESAMPLER_SINC               // polyphase windowed sinc
+};
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> sinc_resampler
+
+// a windowed-sinc filter between one pair of rates, tabulated for a fixed
+// number of phases between consecutive input samples
+class sinc_resampler
+{
+public:
+	static const int PHASE_BITS     = 8;
+	static const int PHASES         = 1 << PHASE_BITS;
+	static const int BASE_TAPS      = 16;   // taps when upsampling; decimation widens the kernel
+	static const int MAX_TAPS       = 128;
+
+	// construction/destruction
+	sinc_resampler(UINT32 input_rate, UINT32 output_rate);
+
+	// getters
+	UINT32 input_rate() const { return m_input_rate; }
+	UINT32 output_rate() const { return m_output_rate; }
+	int taps() const { return m_taps; }
+	int history() const { return m_taps / 2 - 1; }     // input samples read before the current one
+	int lookahead() const { return m_taps / 2; }        // input samples read after the current one
+
+	// operations
+	void resample(const INT32 *source, UINT32 basefrac, UINT32 step, INT32 *dest, UINT32 numsamples, INT64 gain) const;
+
+private:
+	// internal state
+	UINT32              m_input_rate;       // rate being converted from
+	UINT32              m_output_rate;      // rate being converted to
+	int                 m_taps;             // taps per phase, a multiple of 4
+	std::vector<float>  m_coeffs;           // PHASES rows of m_taps coefficients
+};
+
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+void resample_linear(const INT32 *source, UINT32 basefrac, UINT32 step, INT32 *dest, UINT32 numsamples, INT64 gain);
+
+
+#endif  /* __RESAMPLER_H__ */
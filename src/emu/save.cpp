@@ -11,20 +11,57 @@
     Save state file format:
 
     00..07  'MAMESAVE'
-    08      Format version (this is format 2)
+    08      Format version (this is format 3)
     09      Flags
     0A..1B  Game name padded with \0
     1C..1F  Signature
-    20..end Save game data (compressed)
+    20..23  Number of blocks (n)
+    24..    Block table, n entries of:
+              4 bytes  uncompressed length
+              4 bytes  stored length (equal to uncompressed if not compressed)
+    ....    Block data
+
+    The save game data is treated as one contiguous image of all registered
+    entries, cut into blocks that are deflated independently so that they
+    can be compressed and decompressed in parallel. Format 2 files, where
+    the data following the header is a single compressed stream, can still
+    be loaded.
 
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
 
+****************************************************************************
+
+    Delta state file format:
+
+    00..07  'MAMESAVE'
+    08      Format version (this is format 3)
+    09      Flags (SS_DELTA is always set)
+    0A..1B  Game name padded with \0
+    1C..1F  Signature
+    20..23  Base ID (CRC of the uncompressed base state data)
+    24..27  Sequence number within the chain (1 = first delta after base)
+    28..end Delta records (compressed)
+
+    Each delta record is:
+
+    00..03  Entry index (0xffffffff terminates the record list)
+    04..07  Byte offset within the entry
+    08..0B  Byte length of the data that follows
+    0C..end Replacement data
+
+    A delta holds only the blocks that changed since the previous state in
+    the chain was written or loaded; a full state is reconstructed by
+    loading the base and then applying each delta in sequence order.
+
 ***************************************************************************/
 
 #include "emu.h"
 #include "coreutil.h"
 
+#include <algorithm>
+#include <zlib.h>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -40,13 +77,25 @@
 //  CONSTANTS
 //**************************************************************************
 
-const int SAVE_VERSION      = 2;
+const int SAVE_VERSION      = 3;
+const int SAVE_VERSION_STREAM = 2;
 const int HEADER_SIZE       = 32;
 
+// uncompressed bytes in each independently compressed block
+const UINT32 SAVE_BLOCK_SIZE = 1024 * 1024;
+const int DELTA_HEADER_SIZE = 40;
+
+const UINT32 DELTA_BLOCK_SIZE = 256;
+const UINT32 DELTA_END_MARKER = 0xffffffff;
+
+// unchanged bytes absorbed into a rewind literal run rather than splitting it
+const UINT32 REWIND_MAX_GAP = 8;
+
 // Available flags
 enum
 {
-	SS_MSB_FIRST = 0x02
+	SS_MSB_FIRST = 0x02,
+	SS_DELTA     = 0x04
 };
 
 
@@ -61,8 +110,25 @@ enum
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
-		m_illegal_regs(0)
+		m_illegal_regs(0),
+		m_state_size(0),
+		m_incremental(false),
+		m_have_base(false),
+		m_base_id(0),
+		m_delta_sequence(0),
+		m_work_queue(nullptr)
+{
+}
+
+
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
 {
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 }
 
 
@@ -76,7 +142,40 @@ void save_manager::allow_registration(bool allowed)
 	// allow/deny registration
 	m_reg_allowed = allowed;
 	if (!allowed)
+	{
+		// lay out the entries within the flattened state image
+		m_state_size = 0;
+		m_entry_array.clear();
+		for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
+		{
+			entry->m_offset = m_state_size;
+			m_state_size += entry->m_typesize * entry->m_typecount;
+			m_entry_array.push_back(entry);
+		}
 		dump_registry();
+	}
+}
+
+
+//-------------------------------------------------
+//  set_incremental - enable or disable tracking
+//  of a shadow copy of the state so that deltas
+//  can be written and applied
+//-------------------------------------------------
+
+void save_manager::set_incremental(bool enable)
+{
+	m_incremental = enable;
+	m_have_base = false;
+	m_base_id = 0;
+	m_delta_sequence = 0;
+
+	// release the shadow image if we no longer need it
+	if (!enable)
+	{
+		m_shadow.clear();
+		m_shadow.shrink_to_fit();
+	}
 }
 
 
@@ -234,40 +333,121 @@ save_error save_manager::read_file(emu_file &file)
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
 
-	// read the header and turn on compression for the rest of the file
+	// read the header
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	UINT8 header[HEADER_SIZE];
 	if (file.read(header, sizeof(header)) != sizeof(header))
 		return STATERR_READ_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
 
 	// verify the header and report an error if it doesn't match
 	UINT32 sig = signature();
 	if (validate_header(header, machine().system().name, sig, nullptr, "Error: ")  != STATERR_NONE)
 		return STATERR_INVALID_HEADER;
 
+	// deltas can't be loaded without their base
+	if (header[9] & SS_DELTA)
+		return STATERR_INVALID_HEADER;
+
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
-	// read all the data, flipping if necessary
+	// read all the data, either as a single stream or as blocks
+	save_error err = (header[8] == SAVE_VERSION_STREAM) ? read_stream(file) : read_blocks(file);
+	release_blocks();
+	if (err != STATERR_NONE)
+		return err;
+
+	// compute the base ID over the data as it was written, then flip if necessary
+	UINT32 crc = 0;
 	for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
 	{
-		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.read(entry->m_data, totalsize) != totalsize)
-			return STATERR_READ_ERROR;
-
-		// handle flipping
+		if (m_incremental)
+			crc = core_crc32(crc, (UINT8 *)entry->m_data, entry->m_typesize * entry->m_typecount);
 		if (flip)
 			entry->flip_data();
 	}
 
+	// this becomes the base for any subsequent deltas
+	if (m_incremental)
+		capture_base(crc);
+
 	// call the post-load functions
 	dispatch_postload();
 
 	return STATERR_NONE;
 }
 
+
+//-------------------------------------------------
+//  read_stream - read the data of a format 2
+//  file, which is one compressed stream
+//-------------------------------------------------
+
+save_error save_manager::read_stream(emu_file &file)
+{
+	file.compress(FCOMPRESS_MEDIUM);
+	for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
+	{
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		if (file.read(entry->m_data, totalsize) != totalsize)
+			return STATERR_READ_ERROR;
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_blocks - read the block table and data,
+//  then decompress the blocks in parallel
+//-------------------------------------------------
+
+save_error save_manager::read_blocks(emu_file &file)
+{
+	// read the block table
+	UINT32 count;
+	if (file.read(&count, sizeof(count)) != sizeof(count))
+		return STATERR_READ_ERROR;
+	count = LITTLE_ENDIANIZE_INT32(count);
+
+	// every block must be non-empty and they must exactly cover the image
+	m_blocks.clear();
+	UINT32 offset = 0;
+	for (UINT32 blocknum = 0; blocknum < count; blocknum++)
+	{
+		UINT32 sizes[2];
+		if (file.read(sizes, sizeof(sizes)) != sizeof(sizes))
+			return STATERR_READ_ERROR;
+		m_blocks.emplace_back();
+		state_block &block = m_blocks.back();
+		block.m_manager = this;
+		block.m_offset = offset;
+		block.m_length = LITTLE_ENDIANIZE_INT32(sizes[0]);
+		block.m_complength = LITTLE_ENDIANIZE_INT32(sizes[1]);
+		block.m_success = false;
+		if (block.m_length == 0 || block.m_length > m_state_size - offset || block.m_complength > block.m_length)
+			return STATERR_READ_ERROR;
+		offset += block.m_length;
+	}
+	if (offset != m_state_size)
+		return STATERR_READ_ERROR;
+
+	// read the compressed data for all blocks
+	for (state_block &block : m_blocks)
+	{
+		block.m_compressed.resize(block.m_complength);
+		if (block.m_complength != 0 && file.read(&block.m_compressed[0], block.m_complength) != block.m_complength)
+			return STATERR_READ_ERROR;
+	}
+
+	// decompress them straight into the entries
+	process_blocks(decompress_block_static);
+	for (state_block &block : m_blocks)
+		if (!block.m_success)
+			return STATERR_READ_ERROR;
+	return STATERR_NONE;
+}
+
 //-------------------------------------------------
 //  dispatch_presave - invoke all registered
 //  presave callbacks for updates
@@ -299,6 +479,279 @@ save_error save_manager::write_file(emu_file &file)
 	UINT32 sig = signature();
 	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
 
+	// write the header; blocks are compressed individually
+	file.compress(FCOMPRESS_NONE);
+	file.seek(0, SEEK_SET);
+	if (file.write(header, sizeof(header)) != sizeof(header))
+		return STATERR_WRITE_ERROR;
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// write the compressed blocks, then drop the buffers; they are as big as the state
+	save_error err = write_blocks(file);
+	release_blocks();
+	if (err != STATERR_NONE)
+		return err;
+
+	// this becomes the base for any subsequent deltas
+	if (m_incremental)
+	{
+		UINT32 crc = 0;
+		for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
+			crc = core_crc32(crc, (UINT8 *)entry->m_data, entry->m_typesize * entry->m_typecount);
+		capture_base(crc);
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  write_blocks - cut the state image into blocks,
+//  compress them in parallel and write the block
+//  table and data
+//-------------------------------------------------
+
+save_error save_manager::write_blocks(emu_file &file)
+{
+	UINT32 count = (m_state_size + SAVE_BLOCK_SIZE - 1) / SAVE_BLOCK_SIZE;
+	m_blocks.resize(count);
+	for (UINT32 blocknum = 0; blocknum < count; blocknum++)
+	{
+		state_block &block = m_blocks[blocknum];
+		block.m_manager = this;
+		block.m_offset = blocknum * SAVE_BLOCK_SIZE;
+		block.m_length = MIN(SAVE_BLOCK_SIZE, m_state_size - block.m_offset);
+		block.m_complength = 0;
+		block.m_success = false;
+	}
+	process_blocks(compress_block_static);
+
+	// write the block table followed by the data
+	UINT32 rawcount = LITTLE_ENDIANIZE_INT32(count);
+	if (file.write(&rawcount, sizeof(rawcount)) != sizeof(rawcount))
+		return STATERR_WRITE_ERROR;
+	for (state_block &block : m_blocks)
+	{
+		UINT32 sizes[2];
+		sizes[0] = LITTLE_ENDIANIZE_INT32(block.m_length);
+		sizes[1] = LITTLE_ENDIANIZE_INT32(block.m_complength);
+		if (file.write(sizes, sizeof(sizes)) != sizeof(sizes))
+			return STATERR_WRITE_ERROR;
+	}
+	for (state_block &block : m_blocks)
+	{
+		if (!block.m_success)
+			return STATERR_WRITE_ERROR;
+		if (block.m_complength != 0 && file.write(&block.m_compressed[0], block.m_complength) != block.m_complength)
+			return STATERR_WRITE_ERROR;
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  process_blocks - run a callback over every
+//  block, using the work queue when there is
+//  more than one
+//-------------------------------------------------
+
+void save_manager::process_blocks(osd_work_callback callback)
+{
+	if (m_blocks.size() == 1)
+		(*callback)(&m_blocks[0], 0);
+	else if (!m_blocks.empty())
+	{
+		if (m_work_queue == nullptr)
+			m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		osd_work_item_queue_multiple(m_work_queue, callback, m_blocks.size(), &m_blocks[0], sizeof(m_blocks[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+
+		// the wait can return as soon as one worker runs dry, so keep going until all are done
+		while (osd_work_queue_items(m_work_queue) != 0)
+			osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 100);
+	}
+}
+
+
+//-------------------------------------------------
+//  release_blocks - free the block table and the
+//  compressed data once a file has been read or
+//  written
+//-------------------------------------------------
+
+void save_manager::release_blocks()
+{
+	std::vector<state_block>().swap(m_blocks);
+}
+
+
+//-------------------------------------------------
+//  first_block_entry - return the index of the
+//  entry containing the given image offset
+//-------------------------------------------------
+
+UINT32 save_manager::first_block_entry(UINT32 offset) const
+{
+	auto it = std::upper_bound(m_entry_array.begin(), m_entry_array.end(), offset,
+			[] (UINT32 value, const state_entry *entry) { return value < entry->m_offset; });
+	return (it - m_entry_array.begin()) - 1;
+}
+
+
+//-------------------------------------------------
+//  compress_block - deflate the entry data that
+//  falls within a single block
+//-------------------------------------------------
+
+void *save_manager::compress_block_static(void *param, int threadid)
+{
+	state_block &block = *reinterpret_cast<state_block *>(param);
+	block.m_manager->compress_block(block);
+	return nullptr;
+}
+
+void save_manager::compress_block(state_block &block)
+{
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit(&stream, FCOMPRESS_MEDIUM) != Z_OK)
+		return;
+
+	// anything that doesn't shrink is stored raw
+	block.m_compressed.resize(block.m_length);
+	stream.next_out = &block.m_compressed[0];
+	stream.avail_out = block.m_length;
+
+	// feed each piece of each entry overlapping the block
+	bool fits = true;
+	UINT32 offset = block.m_offset;
+	UINT32 end = block.m_offset + block.m_length;
+	for (UINT32 index = first_block_entry(offset); fits && offset < end; index++)
+	{
+		state_entry &entry = *m_entry_array[index];
+		UINT32 entryend = entry.m_offset + entry.m_typesize * entry.m_typecount;
+		UINT32 chunk = MIN(entryend, end) - offset;
+		if (chunk == 0)
+			continue;
+		stream.next_in = (Bytef *)entry.m_data + (offset - entry.m_offset);
+		stream.avail_in = chunk;
+		while (stream.avail_in != 0 && stream.avail_out != 0)
+			if (deflate(&stream, Z_NO_FLUSH) != Z_OK)
+				break;
+		fits = (stream.avail_in == 0);
+		offset += chunk;
+	}
+	if (fits && deflate(&stream, Z_FINISH) == Z_STREAM_END && stream.total_out < block.m_length)
+		block.m_complength = stream.total_out;
+	deflateEnd(&stream);
+
+	// fall back to a straight copy
+	if (block.m_complength == 0)
+	{
+		block.m_complength = block.m_length;
+		offset = block.m_offset;
+		for (UINT32 index = first_block_entry(offset); offset < end; index++)
+		{
+			state_entry &entry = *m_entry_array[index];
+			UINT32 entryend = entry.m_offset + entry.m_typesize * entry.m_typecount;
+			UINT32 chunk = MIN(entryend, end) - offset;
+			memcpy(&block.m_compressed[offset - block.m_offset], (UINT8 *)entry.m_data + (offset - entry.m_offset), chunk);
+			offset += chunk;
+		}
+	}
+	block.m_success = true;
+}
+
+
+//-------------------------------------------------
+//  decompress_block - inflate a block directly
+//  into the entries it overlaps
+//-------------------------------------------------
+
+void *save_manager::decompress_block_static(void *param, int threadid)
+{
+	state_block &block = *reinterpret_cast<state_block *>(param);
+	block.m_manager->decompress_block(block);
+	return nullptr;
+}
+
+void save_manager::decompress_block(state_block &block)
+{
+	bool raw = (block.m_complength == block.m_length);
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (!raw)
+	{
+		if (inflateInit(&stream) != Z_OK)
+			return;
+		stream.next_in = block.m_compressed.empty() ? nullptr : &block.m_compressed[0];
+		stream.avail_in = block.m_complength;
+	}
+
+	// fill each piece of each entry overlapping the block
+	bool success = true;
+	UINT32 offset = block.m_offset;
+	UINT32 end = block.m_offset + block.m_length;
+	for (UINT32 index = first_block_entry(offset); success && offset < end; index++)
+	{
+		state_entry &entry = *m_entry_array[index];
+		UINT32 entryend = entry.m_offset + entry.m_typesize * entry.m_typecount;
+		UINT32 chunk = MIN(entryend, end) - offset;
+		if (chunk == 0)
+			continue;
+		UINT8 *dest = (UINT8 *)entry.m_data + (offset - entry.m_offset);
+		if (raw)
+			memcpy(dest, &block.m_compressed[offset - block.m_offset], chunk);
+		else
+		{
+			stream.next_out = dest;
+			stream.avail_out = chunk;
+			while (stream.avail_out != 0)
+			{
+				int zerr = inflate(&stream, Z_NO_FLUSH);
+				if (zerr != Z_OK && !(zerr == Z_STREAM_END && stream.avail_out == 0))
+				{
+					success = false;
+					break;
+				}
+			}
+		}
+		offset += chunk;
+	}
+
+	if (!raw)
+		inflateEnd(&stream);
+	block.m_success = success;
+}
+
+
+//-------------------------------------------------
+//  write_delta_file - writes only the blocks
+//  that changed since the last state in the
+//  chain to a file
+//-------------------------------------------------
+
+save_error save_manager::write_delta_file(emu_file &file)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// we need a base to compare against
+	if (!m_have_base)
+		return STATERR_MISSING_BASE;
+
+	// generate the header
+	UINT8 header[DELTA_HEADER_SIZE];
+	memset(header, 0, sizeof(header));
+	memcpy(&header[0], emulator_info::get_state_magic_num(), 8);
+	header[8] = SAVE_VERSION;
+	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST) | SS_DELTA;
+	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
+	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(signature());
+	*(UINT32 *)&header[0x20] = LITTLE_ENDIANIZE_INT32(m_base_id);
+	*(UINT32 *)&header[0x24] = LITTLE_ENDIANIZE_INT32(m_delta_sequence + 1);
+
 	// write the header and turn on compression for the rest of the file
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
@@ -309,17 +762,207 @@ save_error save_manager::write_file(emu_file &file)
 	// call the pre-save functions
 	dispatch_presave();
 
-	// then write all the data
-	for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
+	// scan each entry for runs of changed blocks; the shadow only takes
+	// the runs once the whole file is written, so that a failed write
+	// leaves it matching the last delta on disk
+	struct delta_run { UINT8 *shadow; const UINT8 *data; UINT32 length; };
+	std::vector<delta_run> runs;
+	UINT32 index = 0;
+	for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next(), index++)
 	{
 		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.write(entry->m_data, totalsize) != totalsize)
-			return STATERR_WRITE_ERROR;
+		const UINT8 *data = (const UINT8 *)entry->m_data;
+		UINT8 *shadow = &m_shadow[entry->m_offset];
+
+		UINT32 offset = 0;
+		while (offset < totalsize)
+		{
+			// skip over unchanged blocks
+			UINT32 chunk = MIN(DELTA_BLOCK_SIZE, totalsize - offset);
+			if (memcmp(&data[offset], &shadow[offset], chunk) == 0)
+			{
+				offset += chunk;
+				continue;
+			}
+
+			// extend the run until we hit an unchanged block
+			UINT32 runend = offset + chunk;
+			while (runend < totalsize)
+			{
+				chunk = MIN(DELTA_BLOCK_SIZE, totalsize - runend);
+				if (memcmp(&data[runend], &shadow[runend], chunk) == 0)
+					break;
+				runend += chunk;
+			}
+
+			// emit the record
+			UINT32 record[3];
+			record[0] = LITTLE_ENDIANIZE_INT32(index);
+			record[1] = LITTLE_ENDIANIZE_INT32(offset);
+			record[2] = LITTLE_ENDIANIZE_INT32(runend - offset);
+			if (file.write(record, sizeof(record)) != sizeof(record))
+				return STATERR_WRITE_ERROR;
+			if (file.write(&data[offset], runend - offset) != runend - offset)
+				return STATERR_WRITE_ERROR;
+			runs.push_back(delta_run{ &shadow[offset], &data[offset], runend - offset });
+			offset = runend;
+		}
+	}
+
+	// terminate the record list
+	UINT32 marker = LITTLE_ENDIANIZE_INT32(DELTA_END_MARKER);
+	if (file.write(&marker, sizeof(marker)) != sizeof(marker))
+		return STATERR_WRITE_ERROR;
+
+	// fold the runs into the shadow
+	for (auto &run : runs)
+		memcpy(run.shadow, run.data, run.length);
+
+	m_delta_sequence++;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_delta_file - apply a delta on top of the
+//  current base and previously applied deltas
+//-------------------------------------------------
+
+save_error save_manager::read_delta_file(emu_file &file)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// we need a base to apply against
+	if (!m_have_base)
+		return STATERR_MISSING_BASE;
+
+	// read the header and turn on compression for the rest of the file
+	file.compress(FCOMPRESS_NONE);
+	file.seek(0, SEEK_SET);
+	UINT8 header[DELTA_HEADER_SIZE];
+	if (file.read(header, sizeof(header)) != sizeof(header))
+		return STATERR_READ_ERROR;
+	file.compress(FCOMPRESS_MEDIUM);
+
+	// verify the header and make sure the delta is the next one in our chain
+	if (validate_header(header, machine().system().name, signature(), nullptr, "Error: ") != STATERR_NONE)
+		return STATERR_INVALID_HEADER;
+	if (!(header[9] & SS_DELTA))
+		return STATERR_INVALID_HEADER;
+	if (LITTLE_ENDIANIZE_INT32(*(UINT32 *)&header[0x20]) != m_base_id || LITTLE_ENDIANIZE_INT32(*(UINT32 *)&header[0x24]) != m_delta_sequence + 1)
+		return STATERR_INVALID_HEADER;
+
+	// determine whether or not to flip the data when done
+	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
+
+	// records arrive in increasing entry order, so walk the list alongside them
+	state_entry *entry = m_entry_list.first();
+	UINT32 index = 0;
+	while (true)
+	{
+		UINT32 record[3];
+		if (file.read(&record[0], sizeof(record[0])) != sizeof(record[0]))
+			return STATERR_READ_ERROR;
+		record[0] = LITTLE_ENDIANIZE_INT32(record[0]);
+		if (record[0] == DELTA_END_MARKER)
+			break;
+		if (file.read(&record[1], sizeof(record[1]) * 2) != sizeof(record[1]) * 2)
+			return STATERR_READ_ERROR;
+		UINT32 offset = LITTLE_ENDIANIZE_INT32(record[1]);
+		UINT32 length = LITTLE_ENDIANIZE_INT32(record[2]);
+
+		// find the target entry and make sure the record fits inside it
+		while (entry != nullptr && index < record[0])
+		{
+			entry = entry->next();
+			index++;
+		}
+		if (entry == nullptr || index != record[0])
+			return STATERR_READ_ERROR;
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		if (offset > totalsize || length > totalsize - offset || offset % entry->m_typesize != 0 || length % entry->m_typesize != 0)
+			return STATERR_READ_ERROR;
+
+		// read the data straight into place and mirror it into the shadow
+		UINT8 *data = (UINT8 *)entry->m_data + offset;
+		if (file.read(data, length) != length)
+			return STATERR_READ_ERROR;
+		if (flip)
+			entry->flip_data(offset / entry->m_typesize, length / entry->m_typesize);
+		memcpy(&m_shadow[entry->m_offset + offset], data, length);
 	}
+	m_delta_sequence++;
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  write_buffer - snapshot the state into a
+//  caller-supplied buffer with no header or
+//  compression
+//-------------------------------------------------
+
+save_error save_manager::write_buffer(UINT8 *data, UINT32 size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != m_state_size)
+		return STATERR_WRITE_ERROR;
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// then copy all the data
+	for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
+		memcpy(data + entry->m_offset, entry->m_data, entry->m_typesize * entry->m_typecount);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_buffer - restore the state from a buffer
+//  filled by write_buffer
+//-------------------------------------------------
+
+save_error save_manager::read_buffer(const UINT8 *data, UINT32 size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != m_state_size)
+		return STATERR_READ_ERROR;
+
+	// copy all the data
+	for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
+		memcpy(entry->m_data, data + entry->m_offset, entry->m_typesize * entry->m_typecount);
+
+	// call the post-load functions
+	dispatch_postload();
+
 	return STATERR_NONE;
 }
 
 
+//-------------------------------------------------
+//  enable_rewind - allocate the rewind buffer
+//-------------------------------------------------
+
+void save_manager::enable_rewind(UINT32 capacity, UINT32 interval)
+{
+	if (capacity == 0)
+		m_rewind.reset();
+	else
+		m_rewind = std::make_unique<rewinder>(*this, capacity, interval);
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -344,6 +987,23 @@ UINT32 save_manager::signature() const
 }
 
 
+//-------------------------------------------------
+//  capture_base - snapshot the current state as
+//  the base of a new delta chain
+//-------------------------------------------------
+
+void save_manager::capture_base(UINT32 base_id)
+{
+	m_shadow.resize(m_state_size);
+	for (state_entry *entry = m_entry_list.first(); entry != nullptr; entry = entry->next())
+		memcpy(&m_shadow[entry->m_offset], entry->m_data, entry->m_typesize * entry->m_typecount);
+
+	m_have_base = true;
+	m_base_id = base_id;
+	m_delta_sequence = 0;
+}
+
+
 //-------------------------------------------------
 //  dump_registry - dump the registry to the
 //  logfile
@@ -373,7 +1033,7 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 	}
 
 	// check save state version
-	if (header[8] != SAVE_VERSION)
+	if (header[8] != SAVE_VERSION && header[8] != SAVE_VERSION_STREAM)
 	{
 		if (errormsg != nullptr)
 			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
@@ -403,6 +1063,226 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 }
 
 
+//**************************************************************************
+//  REWINDER
+//**************************************************************************
+
+//-------------------------------------------------
+//  rewinder - constructor
+//-------------------------------------------------
+
+rewinder::rewinder(save_manager &save, UINT32 capacity, UINT32 interval)
+	: m_save(save),
+		m_interval(MAX(interval, 1)),
+		m_frames(0),
+		m_capture_pending(false),
+		m_restore_pending(false),
+		m_restore_steps(0),
+		m_have_latest(false),
+		m_latest(save.state_size()),
+		m_scratch(save.state_size()),
+		m_deltas(capacity - 1),
+		m_head(0),
+		m_count(0)
+{
+}
+
+
+//-------------------------------------------------
+//  memory_used - return the number of bytes held
+//  by snapshots
+//-------------------------------------------------
+
+size_t rewinder::memory_used() const
+{
+	size_t result = m_latest.size() + m_scratch.size();
+	for (const dynamic_buffer &delta : m_deltas)
+		result += delta.capacity();
+	return result;
+}
+
+
+//-------------------------------------------------
+//  frame_update - count frames and request a
+//  snapshot once per interval
+//-------------------------------------------------
+
+void rewinder::frame_update()
+{
+	if (++m_frames >= m_interval)
+	{
+		m_frames = 0;
+		m_capture_pending = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  update - perform any pending restore or
+//  capture; called between timeslices
+//-------------------------------------------------
+
+void rewinder::update(bool can_save)
+{
+	// anonymous timers would be lost; try again next time around
+	if (!can_save)
+		return;
+
+	if (m_restore_pending)
+	{
+		m_restore_pending = false;
+		m_capture_pending = false;
+		restore(m_restore_steps);
+	}
+	else if (m_capture_pending)
+	{
+		m_capture_pending = false;
+		capture();
+	}
+}
+
+
+//-------------------------------------------------
+//  capture - take a snapshot, turning the
+//  previous one into a delta
+//-------------------------------------------------
+
+save_error rewinder::capture()
+{
+	save_error err = m_save.write_buffer(&m_scratch[0], m_scratch.size());
+	if (err != STATERR_NONE)
+		return err;
+
+	// the previous snapshot becomes a delta against the new one
+	if (m_have_latest && !m_deltas.empty())
+	{
+		m_head = (m_head + 1) % m_deltas.size();
+		encode_delta(m_deltas[m_head], &m_scratch[0], &m_latest[0], m_scratch.size());
+		if (m_count < m_deltas.size())
+			m_count++;
+	}
+
+	std::swap(m_latest, m_scratch);
+	m_have_latest = true;
+	m_frames = 0;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  restore - roll back to the snapshot taken the
+//  given number of intervals before the latest,
+//  discarding everything newer
+//-------------------------------------------------
+
+save_error rewinder::restore(UINT32 steps)
+{
+	if (!m_have_latest || steps > m_count)
+		return STATERR_READ_ERROR;
+
+	// walk the newest deltas back to the requested snapshot
+	for ( ; steps > 0; steps--)
+	{
+		apply_delta(&m_latest[0], m_deltas[m_head]);
+		m_head = (m_head + m_deltas.size() - 1) % m_deltas.size();
+		m_count--;
+	}
+
+	m_frames = 0;
+	return m_save.read_buffer(&m_latest[0], m_latest.size());
+}
+
+
+//-------------------------------------------------
+//  encode_delta - build a run-length coded XOR of
+//  two snapshots; each run is a varint count of
+//  unchanged bytes, a varint literal length, and
+//  the XORed literal bytes
+//-------------------------------------------------
+
+static inline void append_varint(dynamic_buffer &dest, UINT32 value)
+{
+	while (value >= 0x80)
+	{
+		dest.push_back(UINT8(value | 0x80));
+		value >>= 7;
+	}
+	dest.push_back(UINT8(value));
+}
+
+void rewinder::encode_delta(dynamic_buffer &dest, const UINT8 *newer, const UINT8 *older, UINT32 size)
+{
+	dest.clear();
+
+	UINT32 offset = 0;
+	while (offset < size)
+	{
+		// skip unchanged data, a word at a time where possible
+		UINT32 start = offset;
+		while (offset + 8 <= size && memcmp(&newer[offset], &older[offset], 8) == 0)
+			offset += 8;
+		while (offset < size && newer[offset] == older[offset])
+			offset++;
+		if (offset == size)
+			break;
+
+		// find the end of the changed run, absorbing short unchanged gaps
+		UINT32 litstart = offset;
+		UINT32 litend = offset;
+		while (offset < size && offset - litend <= REWIND_MAX_GAP)
+		{
+			if (newer[offset] != older[offset])
+				litend = offset + 1;
+			offset++;
+		}
+		offset = litend;
+
+		append_varint(dest, litstart - start);
+		append_varint(dest, litend - litstart);
+		for (UINT32 index = litstart; index < litend; index++)
+			dest.push_back(newer[index] ^ older[index]);
+	}
+}
+
+
+//-------------------------------------------------
+//  apply_delta - XOR a delta into a snapshot,
+//  which converts between the two snapshots it
+//  was built from in either direction
+//-------------------------------------------------
+
+static inline UINT32 read_varint(const UINT8 *&src)
+{
+	UINT32 result = 0;
+	int shift = 0;
+	UINT8 byte;
+	do
+	{
+		byte = *src++;
+		result |= UINT32(byte & 0x7f) << shift;
+		shift += 7;
+	}
+	while (byte & 0x80);
+	return result;
+}
+
+void rewinder::apply_delta(UINT8 *image, const dynamic_buffer &delta)
+{
+	if (delta.empty())
+		return;
+
+	const UINT8 *src = &delta[0];
+	const UINT8 *end = src + delta.size();
+	while (src < end)
+	{
+		image += read_varint(src);
+		UINT32 length = read_varint(src);
+		for (UINT32 index = 0; index < length; index++)
+			*image++ ^= *src++;
+	}
+}
+
+
 //-------------------------------------------------
 //  state_callback - constructor
 //-------------------------------------------------
@@ -439,30 +1319,35 @@ state_entry::state_entry(void *data, const char *name, device_t *device, const c
 //-------------------------------------------------
 
 void state_entry::flip_data()
+{
+	flip_data(0, m_typecount);
+}
+
+void state_entry::flip_data(UINT32 first, UINT32 count)
 {
 	UINT16 *data16;
 	UINT32 *data32;
 	UINT64 *data64;
-	int count;
+	UINT32 index;
 
 	switch (m_typesize)
 	{
 		case 2:
-			data16 = (UINT16 *)m_data;
-			for (count = 0; count < m_typecount; count++)
-				data16[count] = FLIPENDIAN_INT16(data16[count]);
+			data16 = (UINT16 *)m_data + first;
+			for (index = 0; index < count; index++)
+				data16[index] = FLIPENDIAN_INT16(data16[index]);
 			break;
 
 		case 4:
-			data32 = (UINT32 *)m_data;
-			for (count = 0; count < m_typecount; count++)
-				data32[count] = FLIPENDIAN_INT32(data32[count]);
+			data32 = (UINT32 *)m_data + first;
+			for (index = 0; index < count; index++)
+				data32[index] = FLIPENDIAN_INT32(data32[index]);
 			break;
 
 		case 8:
-			data64 = (UINT64 *)m_data;
-			for (count = 0; count < m_typecount; count++)
-				data64[count] = FLIPENDIAN_INT64(data64[count]);
+			data64 = (UINT64 *)m_data + first;
+			for (index = 0; index < count; index++)
+				data64[index] = FLIPENDIAN_INT64(data64[index]);
 			break;
 	}
 }
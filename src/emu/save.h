@@ -29,7 +29,8 @@ enum save_error
 	STATERR_ILLEGAL_REGISTRATIONS,
 	STATERR_INVALID_HEADER,
 	STATERR_READ_ERROR,
-	STATERR_WRITE_ERROR
+	STATERR_WRITE_ERROR,
+	STATERR_MISSING_BASE
 };
 
 
@@ -58,6 +59,53 @@ typedef delegate<void ()> save_prepost_delegate;
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class save_manager;
+
+// ======================> rewinder
+
+// ring of in-memory snapshots stored as XOR/RLE deltas
+class rewinder
+{
+public:
+	// construction/destruction
+	rewinder(save_manager &save, UINT32 capacity, UINT32 interval);
+
+	// getters
+	UINT32 capacity() const { return m_deltas.size() + 1; }
+	UINT32 interval() const { return m_interval; }
+	UINT32 count() const { return m_have_latest ? m_count + 1 : 0; }
+	size_t memory_used() const;
+
+	// operations
+	void frame_update();
+	void schedule_restore(UINT32 steps) { m_restore_pending = true; m_restore_steps = steps; }
+	void update(bool can_save);
+	save_error capture();
+	save_error restore(UINT32 steps);
+
+private:
+	// internal helpers
+	static void encode_delta(dynamic_buffer &dest, const UINT8 *newer, const UINT8 *older, UINT32 size);
+	static void apply_delta(UINT8 *image, const dynamic_buffer &delta);
+
+	// internal state
+	save_manager &          m_save;                 // reference to the save manager
+	UINT32                  m_interval;             // frames between snapshots
+	UINT32                  m_frames;               // frames since the last snapshot
+	bool                    m_capture_pending;      // is a snapshot due?
+	bool                    m_restore_pending;      // has a restore been requested?
+	UINT32                  m_restore_steps;        // how many snapshots to step back
+	bool                    m_have_latest;          // does m_latest hold a snapshot?
+	dynamic_buffer          m_latest;               // most recent snapshot, stored in full
+	dynamic_buffer          m_scratch;              // arena for capturing the next snapshot
+	std::vector<dynamic_buffer> m_deltas;           // ring of deltas back to older snapshots
+	UINT32                  m_head;                 // ring index of the newest delta
+	UINT32                  m_count;                // number of valid deltas in the ring
+};
+
+
+// ======================> state_entry
+
 class state_entry
 {
 public:
@@ -69,6 +117,7 @@ public:
 
 	// helpers
 	void flip_data();
+	void flip_data(UINT32 first, UINT32 count);
 
 	// state
 	state_entry *       m_next;                 // pointer to next entry
@@ -92,14 +141,20 @@ class save_manager
 public:
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
 	int registration_count() const { return m_entry_list.count(); }
 	bool registration_allowed() const { return m_reg_allowed; }
+	UINT32 state_size() const { return m_state_size; }
+	bool incremental() const { return m_incremental; }
+	bool has_base() const { return m_have_base; }
+	UINT32 delta_sequence() const { return m_delta_sequence; }
 
 	// registration control
 	void allow_registration(bool allowed = true);
+	void set_incremental(bool enable = true);
 	const char *indexed_item(int index, void *&base, UINT32 &valsize, UINT32 &valcount) const;
 
 	// function registration
@@ -156,10 +211,24 @@ public:
 	static save_error check_file(running_machine &machine, emu_file &file, const char *gamename, void (CLIB_DECL *errormsg)(const char *fmt, ...));
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
+	save_error write_delta_file(emu_file &file);
+	save_error read_delta_file(emu_file &file);
+
+	// in-memory snapshots
+	save_error write_buffer(UINT8 *data, UINT32 size);
+	save_error read_buffer(const UINT8 *data, UINT32 size);
+
+	// rewind support
+	void enable_rewind(UINT32 capacity, UINT32 interval);
+	rewinder *rewind() const { return m_rewind.get(); }
 
 private:
 	// internal helpers
 	UINT32 signature() const;
+	void capture_base(UINT32 base_id);
+	save_error read_stream(emu_file &file);
+	save_error read_blocks(emu_file &file);
+	save_error write_blocks(emu_file &file);
 	void dump_registry() const;
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
 
@@ -178,6 +247,26 @@ private:
 		save_prepost_delegate m_func;               // delegate
 	};
 
+	// independently compressed slice of the state image
+	struct state_block
+	{
+		save_manager *      m_manager;              // owning manager
+		UINT32              m_offset;               // offset of the block within the image
+		UINT32              m_length;               // uncompressed length
+		UINT32              m_complength;           // stored length
+		dynamic_buffer      m_compressed;           // stored data
+		bool                m_success;              // did the last operation succeed?
+	};
+
+	// block compression helpers
+	void process_blocks(osd_work_callback callback);
+	void release_blocks();
+	UINT32 first_block_entry(UINT32 offset) const;
+	static void *compress_block_static(void *param, int threadid);
+	static void *decompress_block_static(void *param, int threadid);
+	void compress_block(state_block &block);
+	void decompress_block(state_block &block);
+
 	// internal state
 	running_machine &       m_machine;              // reference to our machine
 	bool                    m_reg_allowed;          // are registrations allowed?
@@ -186,6 +275,21 @@ private:
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
 	simple_list<state_callback> m_postload_list;    // list of post-load functions
+	UINT32                  m_state_size;           // total size of all registered entries
+	std::vector<state_entry *> m_entry_array;       // entries in image order, for lookup by offset
+
+	// incremental state
+	bool                    m_incremental;          // are we tracking a shadow copy for deltas?
+	bool                    m_have_base;            // does the shadow hold a valid base?
+	UINT32                  m_base_id;              // identifies the base of the current chain
+	UINT32                  m_delta_sequence;       // sequence number of the last delta in the chain
+	dynamic_buffer          m_shadow;               // state as of the last save/load in the chain
+
+	std::unique_ptr<rewinder> m_rewind;             // in-memory rewind buffer, if enabled
+
+	// block compression
+	std::vector<state_block> m_blocks;              // blocks of the file being read or written
+	osd_work_queue *        m_work_queue;           // queue for compressing blocks in parallel
 };
 
 
@@ -48,6 +48,8 @@ emu_timer::emu_timer()
 	: m_machine(nullptr),
 		m_next(nullptr),
 		m_prev(nullptr),
+		m_heapindex(-1),
+		m_sequence(0),
 		m_param(0),
 		m_ptr(nullptr),
 		m_enabled(false),
@@ -160,9 +162,9 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// add or remove the timer from the pending set
+		auto lock = machine().scheduler().group_lock();
+		machine().scheduler().timer_reschedule(*this);
 	}
 	return old;
 }
@@ -178,6 +180,7 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 {
 	// if this is the callback timer, mark it modified
 	device_scheduler &scheduler = machine().scheduler();
+	auto lock = scheduler.group_lock();
 	if (scheduler.m_callback_timer == this)
 		scheduler.m_callback_timer_modified = true;
 
@@ -194,12 +197,11 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move the timer to its new place in the heap
+	scheduler.timer_reschedule(*this);
 
-	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	// if this is now the next timer to fire, abort the current timeslice and resync
+	if (this == scheduler.m_timer_heap.top())
 		scheduler.abort_timeslice();
 }
 
@@ -278,10 +280,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move to our new place in the heap
+	machine().scheduler().timer_reschedule(*this);
 }
 
 
@@ -305,6 +305,10 @@ void emu_timer::dump() const
 //  DEVICE SCHEDULER
 //**************************************************************************
 
+// device executing on the current group thread, if any
+thread_local device_execute_interface *device_scheduler::s_group_executing = nullptr;
+
+
 //-------------------------------------------------
 //  device_scheduler - constructor
 //-------------------------------------------------
@@ -315,15 +319,18 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
 	m_timer_list(nullptr),
+	m_timer_tail(nullptr),
+	m_timer_sequence(0),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
-	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
+	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000),
+	m_group_queue(nullptr),
+	m_groups_running(false)
 {
 	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
-	m_timer_list->adjust(attotime::never);
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -341,6 +348,10 @@ device_scheduler::~device_scheduler()
 	// remove all timers
 	while (m_timer_list != nullptr)
 		m_timer_allocator.reclaim(m_timer_list->release());
+
+	// release the group threads
+	if (m_group_queue != nullptr)
+		osd_work_queue_free(m_group_queue);
 }
 
 
@@ -356,7 +367,8 @@ attotime device_scheduler::time() const
 
 	// if we're executing as a particular CPU, use its local time as a base
 	// otherwise, return the global base time
-	return (m_executing_device != nullptr) ? m_executing_device->local_time() : m_basetime;
+	device_execute_interface *executing = currently_executing();
+	return (executing != nullptr) ? executing->local_time() : m_basetime;
 }
 
 
@@ -405,6 +417,86 @@ inline void device_scheduler::apply_suspend_changes()
 }
 
 
+//-------------------------------------------------
+//  execute_device - run a single device up to
+//  the target time, pulling the target back if
+//  the device stops early
+//-------------------------------------------------
+
+template<bool _Grouped>
+inline void device_scheduler::execute_device(device_execute_interface *exec, attotime &target, bool call_debugger, profile_report *report)
+{
+	// only process if this CPU is executing or truly halted (not yielding)
+	// and if our target is later than the CPU's current time (coarse check)
+	if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
+	{
+		// compute how many attoseconds to execute this CPU
+		attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
+		if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
+			delta += ATTOSECONDS_PER_SECOND;
+		assert(delta == (target - exec->m_localtime).as_attoseconds());
+
+		// if we have enough for at least 1 cycle, do the math
+		if (delta >= exec->m_attoseconds_per_cycle)
+		{
+			// compute how many cycles we want to execute
+			int ran = exec->m_cycles_running = divu_64x32((UINT64)delta >> exec->m_divshift, exec->m_divisor);
+			LOG(("  cpu '%s': %" I64FMT"d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
+
+			// if we're not suspended, actually execute
+			if (exec->m_suspend == 0)
+			{
+				// the profiler is not thread-safe, so grouped devices are only timed by the report
+				if (!_Grouped)
+					g_profiler.start(exec->m_profiler);
+				profile_ticks_scope timing(report, exec->m_profile_ticks);
+
+				// note that this global variable cycles_stolen can be modified
+				// via the call to cpu_execute
+				exec->m_cycles_stolen = 0;
+				if (_Grouped)
+					s_group_executing = exec;
+				else
+					m_executing_device = exec;
+				*exec->m_icountptr = exec->m_cycles_running;
+				if (!call_debugger)
+					exec->run();
+				else
+				{
+					debugger_start_cpu_hook(&exec->device(), target);
+					exec->run();
+					debugger_stop_cpu_hook(&exec->device());
+				}
+
+				// adjust for any cycles we took back
+				assert(ran >= *exec->m_icountptr);
+				ran -= *exec->m_icountptr;
+				assert(ran >= exec->m_cycles_stolen);
+				ran -= exec->m_cycles_stolen;
+				if (!_Grouped)
+					g_profiler.stop();
+			}
+
+			// account for these cycles
+			exec->m_totalcycles += ran;
+
+			// update the local time for this CPU
+			attotime deltatime(0, exec->m_attoseconds_per_cycle * ran);
+			assert(deltatime >= attotime::zero);
+			exec->m_localtime += deltatime;
+			LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec->m_totalcycles, exec->m_localtime.as_string(PRECISION)));
+
+			// if the new local CPU time is less than our target, move the target up, but not before the base
+			if (exec->m_localtime < target)
+			{
+				target = max(exec->m_localtime, m_basetime);
+				LOG(("         (new target)\n"));
+			}
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  timeslice - execute all devices for a single
 //  timeslice
@@ -413,6 +505,7 @@ inline void device_scheduler::apply_suspend_changes()
 void device_scheduler::timeslice()
 {
 	bool call_debugger = ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
+	profile_report *report = machine().report();
 
 	// build the execution list if we don't have one yet
 	if (UNEXPECTED(m_execute_list == nullptr))
@@ -423,14 +516,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < m_timer_heap.top()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (m_timer_heap.top()->m_expire < target)
+			target = m_timer_heap.top()->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -441,71 +534,14 @@ void device_scheduler::timeslice()
 
 		// loop over all CPUs
 		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
-		{
-			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
-			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
-				if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
-
-				// if we have enough for at least 1 cycle, do the math
-				if (delta >= exec->m_attoseconds_per_cycle)
-				{
-					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32((UINT64)delta >> exec->m_divshift, exec->m_divisor);
-					LOG(("  cpu '%s': %" I64FMT"d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
-
-					// if we're not suspended, actually execute
-					if (exec->m_suspend == 0)
-					{
-						g_profiler.start(exec->m_profiler);
-
-						// note that this global variable cycles_stolen can be modified
-						// via the call to cpu_execute
-						exec->m_cycles_stolen = 0;
-						m_executing_device = exec;
-						*exec->m_icountptr = exec->m_cycles_running;
-						if (!call_debugger)
-							exec->run();
-						else
-						{
-							debugger_start_cpu_hook(&exec->device(), target);
-							exec->run();
-							debugger_stop_cpu_hook(&exec->device());
-						}
-
-						// adjust for any cycles we took back
-						assert(ran >= *exec->m_icountptr);
-						ran -= *exec->m_icountptr;
-						assert(ran >= exec->m_cycles_stolen);
-						ran -= exec->m_cycles_stolen;
-						g_profiler.stop();
-					}
-
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime(0, exec->m_attoseconds_per_cycle * ran);
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec->m_totalcycles, exec->m_localtime.as_string(PRECISION)));
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
-					{
-						target = max(exec->m_localtime, m_basetime);
-						LOG(("         (new target)\n"));
-					}
-				}
-			}
-		}
+			if (exec->m_execute_group == 0 || m_groups.empty())
+				execute_device<false>(exec, target, call_debugger, report);
 		m_executing_device = nullptr;
 
+		// then let the groups catch up to where group 0 stopped
+		if (!m_groups.empty())
+			execute_groups(target, report);
+
 		// update the base time
 		m_basetime = target;
 	}
@@ -522,8 +558,9 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice()
 {
-	if (m_executing_device != nullptr)
-		m_executing_device->abort_timeslice();
+	device_execute_interface *executing = currently_executing();
+	if (executing != nullptr)
+		executing->abort_timeslice();
 }
 
 
@@ -533,6 +570,9 @@ void device_scheduler::abort_timeslice()
 
 void device_scheduler::trigger(int trigid, const attotime &after)
 {
+	// devices in execution groups may trigger each other from worker threads
+	auto lock = group_lock();
+
 	// ensure we have a list of executing devices
 	if (m_execute_list == nullptr)
 		rebuild_execute_list();
@@ -558,6 +598,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 	// ignore timeslices > 1 second
 	if (timeslice_time.seconds() > 0)
 		return;
+	auto lock = group_lock();
 	add_scheduling_quantum(timeslice_time, boost_duration);
 }
 
@@ -569,6 +610,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *ptr)
 {
+	auto lock = group_lock();
 	return &m_timer_allocator.alloc()->init(machine(), callback, ptr, false);
 }
 
@@ -581,6 +623,7 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param, void *ptr)
 {
+	auto lock = group_lock();
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, true).adjust(duration, param);
 }
 
@@ -593,6 +636,7 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegate callback, int param, void *ptr)
 {
+	auto lock = group_lock();
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, false).adjust(period, param, period);
 }
 
@@ -604,6 +648,7 @@ void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegat
 
 emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, void *ptr)
 {
+	auto lock = group_lock();
 	return &m_timer_allocator.alloc()->init(device, id, ptr, false);
 }
 
@@ -616,6 +661,7 @@ emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, v
 
 void device_scheduler::timer_set(const attotime &duration, device_t &device, device_timer_id id, int param, void *ptr)
 {
+	auto lock = group_lock();
 	m_timer_allocator.alloc()->init(device, id, ptr, true).adjust(duration, param);
 }
 
@@ -661,25 +707,20 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != nullptr)
+	// temporary timers go away entirely (except our special never-expiring one)
+	emu_timer *next;
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = next)
 	{
-		emu_timer &timer = *m_timer_list;
-
-		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
-
-		// permanent ones get added to our private list
-		else
-			private_list.append(timer_list_remove(timer));
+		next = timer->next();
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != nullptr)
-		timer_list_insert(*timer);
+	// rebuild the heap from the loaded expiration times; walking the list in
+	// allocation order keeps the order of equal expiration times deterministic
+	m_timer_heap.reset();
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = timer->next())
+		timer_reschedule(*timer);
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
@@ -800,59 +841,140 @@ void device_scheduler::rebuild_execute_list()
 
 	// append the suspend list to the end of the active list
 	*active_tailptr = suspend_list;
+
+	// and split out the parallel groups in the same order
+	rebuild_execute_groups();
 }
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  rebuild_execute_groups - gather the devices
+//  that run apart from group 0
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+void device_scheduler::rebuild_execute_groups()
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	for (execute_group &group : m_groups)
+		group.m_devices.clear();
+	m_groups.clear();
 
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
+	// groups are opt-in, and the debugger needs everything on one thread;
+	// otherwise every device runs in its original order
+	if (!machine().options().execute_groups() || (machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+		return;
 
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
+	// assign each grouped device to its group; m_groups is indexed by group number - 1
+	for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		if (exec->m_execute_group != 0)
+		{
+			if (exec->m_execute_group > int(m_groups.size()))
+				m_groups.resize(exec->m_execute_group);
+			m_groups[exec->m_execute_group - 1].m_devices.push_back(exec);
+		}
 
-			curtimer->m_prev = &timer;
-			return timer;
+	// drop empty groups so we don't queue work for nothing
+	int count = 0;
+	for (execute_group &group : m_groups)
+		if (!group.m_devices.empty())
+		{
+			if (&group != &m_groups[count])
+				m_groups[count].m_devices.swap(group.m_devices);
+			m_groups[count++].m_scheduler = this;
 		}
-	}
+	m_groups.resize(count);
+
+	// the main thread runs the first group itself, so only allocate
+	// threads when there is more than one; without them, the groups
+	// simply run one after another
+	if (m_groups.size() > 1 && m_group_queue == nullptr)
+		m_group_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+}
+
+
+//-------------------------------------------------
+//  execute_groups - run every group up to the
+//  point where group 0 stopped, and pull the
+//  target back to the earliest point where any
+//  group stopped
+//-------------------------------------------------
+
+void device_scheduler::execute_groups(attotime &target, profile_report *report)
+{
+	// group 0 has already run, so any synchronization it asked for is in
+	// the target; each group gets its own copy so they can't affect each other
+	for (execute_group &group : m_groups)
+		group.m_target = target;
+
+	m_groups_running = true;
+	bool threaded = m_groups.size() > 1 && m_group_queue != nullptr;
+	if (threaded)
+		osd_work_item_queue_multiple(m_group_queue, execute_group_callback, m_groups.size() - 1, &m_groups[1], sizeof(m_groups[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+
+	// run the first group here, and the rest too if there are no threads
+	for (int index = 0; index < (threaded ? 1 : int(m_groups.size())); index++)
+		for (device_execute_interface *exec : m_groups[index].m_devices)
+			execute_device<false>(exec, m_groups[index].m_target, false, report);
+	m_executing_device = nullptr;
+
+	if (threaded)
+		while (osd_work_queue_items(m_group_queue) != 0)
+			osd_work_queue_wait(m_group_queue, osd_ticks_per_second() * 10);
+	m_groups_running = false;
+
+	for (execute_group &group : m_groups)
+		if (group.m_target < target)
+			target = group.m_target;
+}
+
+
+//-------------------------------------------------
+//  execute_group_callback - run the devices of a
+//  single group on a worker thread
+//-------------------------------------------------
+
+void *device_scheduler::execute_group_callback(void *param, int threadid)
+{
+	execute_group &group = *reinterpret_cast<execute_group *>(param);
+	for (device_execute_interface *exec : group.m_devices)
+		group.m_scheduler->execute_device<true>(exec, group.m_target, false, group.m_scheduler->machine().report());
+	s_group_executing = nullptr;
+	return nullptr;
+}
 
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
+
+//-------------------------------------------------
+//  timer_list_insert - append a new timer to the
+//  list of all timers, and to the heap if it is
+//  enabled
+//-------------------------------------------------
+
+emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+{
+	// link it in at the end
+	timer.m_prev = m_timer_tail;
+	timer.m_next = nullptr;
+	if (m_timer_tail != nullptr)
+		m_timer_tail->m_next = &timer;
 	else
 		m_timer_list = &timer;
+	m_timer_tail = &timer;
 
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
+	timer_reschedule(timer);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list of all timers and from the heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
+	// take it out of the heap
+	if (m_timer_heap.contains(timer))
+		m_timer_heap.remove(timer);
+
 	// remove it from the list
 	if (timer.m_prev != nullptr)
 		timer.m_prev->m_next = timer.m_next;
@@ -861,24 +983,52 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 
 	if (timer.m_next != nullptr)
 		timer.m_next->m_prev = timer.m_prev;
+	else
+		m_timer_tail = timer.m_prev;
 
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_reschedule - move a timer to the right
+//  place in the heap after its enabled state or
+//  expiration time has changed
+//-------------------------------------------------
+
+void device_scheduler::timer_reschedule(emu_timer &timer)
+{
+	// disabled timers are left out of the heap entirely
+	if (!timer.m_enabled)
+	{
+		if (m_timer_heap.contains(timer))
+			m_timer_heap.remove(timer);
+		return;
+	}
+
+	// a fresh sequence number makes equal expiration times fire in the
+	// order they were scheduled, as the old sorted list did
+	timer.m_sequence = m_timer_sequence++;
+	if (m_timer_heap.contains(timer))
+		m_timer_heap.update(timer);
+	else
+		m_timer_heap.insert(timer);
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_heap.top()->m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (m_timer_heap.top()->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *m_timer_heap.top();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -17,6 +17,8 @@
 #ifndef __SCHEDULE_H__
 #define __SCHEDULE_H__
 
+#include <mutex>
+
 
 //**************************************************************************
 //  MACROS
@@ -54,6 +56,7 @@ class emu_timer
 	friend class device_scheduler;
 	friend class simple_list<emu_timer>;
 	friend class fixed_allocator<emu_timer>;
+	friend class intrusive_heap<emu_timer>;
 	friend class resource_pool_object<emu_timer>;
 
 	// construction/destruction
@@ -93,11 +96,14 @@ private:
 	void register_save();
 	void schedule_next_period();
 	void dump() const;
+	bool heap_before(const emu_timer &other) const { return (m_expire < other.m_expire) || (m_expire == other.m_expire && m_sequence < other.m_sequence); }
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in allocation order
+	emu_timer *         m_prev;         // previous timer in allocation order
+	int                 m_heapindex;    // position in the scheduler's heap (-1 if not pending)
+	UINT64              m_sequence;     // scheduling order, breaks ties between equal expire times
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -127,7 +133,7 @@ public:
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
 	emu_timer *first_timer() const { return m_timer_list; }
-	device_execute_interface *currently_executing() const { return m_executing_device; }
+	device_execute_interface *currently_executing() const { return (m_groups_running && s_group_executing != nullptr) ? s_group_executing : m_executing_device; }
 	bool can_save() const;
 
 	// execution
@@ -170,12 +176,18 @@ private:
 	// scheduling helpers
 	void compute_perfect_interleave();
 	void rebuild_execute_list();
+	void rebuild_execute_groups();
+	template<bool _Grouped> void execute_device(device_execute_interface *exec, attotime &target, bool call_debugger, profile_report *report);
+	void execute_groups(attotime &target, profile_report *report);
+	static void *execute_group_callback(void *param, int threadid);
+	std::unique_lock<std::recursive_mutex> group_lock() { return m_groups_running ? std::unique_lock<std::recursive_mutex>(m_group_mutex) : std::unique_lock<std::recursive_mutex>(); }
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
 
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	void timer_reschedule(emu_timer &timer);
 	void execute_timers();
 
 	// internal state
@@ -184,8 +196,11 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// list of all timers, and a heap of the enabled ones ordered by expiration
+	emu_timer *                 m_timer_list;               // head of the list of all timers
+	emu_timer *                 m_timer_tail;               // tail of the list of all timers
+	intrusive_heap<emu_timer>   m_timer_heap;               // enabled timers, soonest first
+	UINT64                      m_timer_sequence;           // next sequence number for the heap
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -210,6 +225,20 @@ private:
 	simple_list<quantum_slot>   m_quantum_list;             // list of active quanta
 	fixed_allocator<quantum_slot> m_quantum_allocator;      // allocator for quanta
 	attoseconds_t               m_quantum_minimum;          // duration of minimum quantum
+
+	// groups of devices executed in parallel; devices in different groups
+	// may only interact through timers, triggers and synchronized input lines
+	struct execute_group
+	{
+		device_scheduler *          m_scheduler;                // owning scheduler
+		std::vector<device_execute_interface *> m_devices;    // devices in this group, in execution order
+		attotime                    m_target;                   // target for the current timeslice
+	};
+	std::vector<execute_group>  m_groups;                   // groups run apart from group 0
+	osd_work_queue *            m_group_queue;              // work queue used to run the groups
+	std::atomic<bool>           m_groups_running;           // true while groups are executing
+	std::recursive_mutex        m_group_mutex;              // protects timers and triggers while groups run
+	static thread_local device_execute_interface *s_group_executing; // device executing on a group thread
 };
 
 
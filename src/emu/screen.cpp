@@ -12,6 +12,7 @@
 #include "emuopts.h"
 #include "png.h"
 #include "rendutil.h"
+#include <thread>
 
 
 
@@ -22,6 +23,10 @@
 #define VERBOSE                     (0)
 #define LOG_PARTIAL_UPDATES(x)      do { if (VERBOSE) logerror x; } while (0)
 
+// band-parallel update limits
+#define MAX_UPDATE_BANDS            8
+#define MIN_UPDATE_BAND_HEIGHT      16
+
 
 
 //**************************************************************************
@@ -78,7 +83,11 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 		m_scanline0_timer(nullptr),
 		m_scanline_timer(nullptr),
 		m_frame_number(0),
-		m_partial_updates_this_frame(0)
+		m_partial_updates_this_frame(0),
+		m_profile_ticks(0),
+		m_max_bands(1),
+		m_updating_bands(false),
+		m_band_queue(nullptr)
 {
 	m_unique_id = m_id_counter;
 	m_id_counter++;
@@ -299,6 +308,10 @@ void screen_device::device_start()
 	}
 	register_screen_bitmap(m_priority);
 
+	// drivers that allow it get one band per hardware thread
+	if (m_video_attributes & VIDEO_UPDATE_PARALLEL)
+		m_max_bands = MAX(1, MIN(MAX_UPDATE_BANDS, int(std::thread::hardware_concurrency())));
+
 	// allocate raw textures
 	m_texture[0] = machine().render().texture_alloc();
 	m_texture[0]->set_osd_data((UINT64)((m_unique_id << 1) | 0));
@@ -392,6 +405,9 @@ void screen_device::device_stop()
 	machine().render().texture_free(m_texture[1]);
 	if (m_burnin.valid())
 		finalize_burnin();
+	if (m_band_queue != nullptr)
+		osd_work_queue_free(m_band_queue);
+	m_band_queue = nullptr;
 }
 
 
@@ -636,12 +652,9 @@ bool screen_device::update_partial(int scanline)
 	g_profiler.start(PROFILER_VIDEO);
 
 	UINT32 flags;
-	screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
-	switch (curbitmap.format())
 	{
-		default:
-		case BITMAP_FORMAT_IND16:   flags = m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);   break;
-		case BITMAP_FORMAT_RGB32:   flags = m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
+		profile_ticks_scope timing(machine().report(), m_profile_ticks);
+		flags = update_bitmap(clip);
 	}
 
 	m_partial_updates_this_frame++;
@@ -656,6 +669,95 @@ bool screen_device::update_partial(int scanline)
 }
 
 
+//-------------------------------------------------
+//  update_bitmap - call the driver's update for
+//  the given rows of the current bitmap, split
+//  into bands when the driver allows it
+//-------------------------------------------------
+
+UINT32 screen_device::update_bitmap(const rectangle &clip)
+{
+	// the profiler and the debugger both expect updates on the main thread
+	if (m_max_bands > 1 && !g_profiler.enabled() && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		int bands = MIN(m_max_bands, clip.height() / MIN_UPDATE_BAND_HEIGHT);
+		if (bands > 1)
+			return update_bands(clip, bands);
+	}
+
+	screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
+	switch (curbitmap.format())
+	{
+		default:
+		case BITMAP_FORMAT_IND16:   return m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);
+		case BITMAP_FORMAT_RGB32:   return m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);
+	}
+}
+
+
+//-------------------------------------------------
+//  update_bands - split the rows of an update
+//  into bands and update them on the work queue
+//-------------------------------------------------
+
+UINT32 screen_device::update_bands(const rectangle &clip, int bands)
+{
+	// allocate the queue the first time it's needed
+	if (m_band_queue == nullptr)
+	{
+		m_band_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (m_band_queue == nullptr)
+		{
+			m_max_bands = 1;
+			return update_bitmap(clip);
+		}
+	}
+
+	// divide the rows as evenly as possible
+	m_bands.resize(bands);
+	for (int band = 0; band < bands; band++)
+	{
+		m_bands[band].m_screen = this;
+		m_bands[band].m_clip = clip;
+		m_bands[band].m_clip.min_y = clip.min_y + clip.height() * band / bands;
+		m_bands[band].m_clip.max_y = clip.min_y + clip.height() * (band + 1) / bands - 1;
+		m_bands[band].m_flags = 0;
+	}
+
+	m_updating_bands = true;
+	osd_work_item_queue_multiple(m_band_queue, update_band_callback, bands, &m_bands[0], sizeof(m_bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (osd_work_queue_items(m_band_queue) != 0)
+		osd_work_queue_wait(m_band_queue, osd_ticks_per_second() * 10);
+	m_updating_bands = false;
+
+	// the bitmap is unchanged only if no band changed it
+	UINT32 flags = ~0;
+	for (auto &band : m_bands)
+		flags &= band.m_flags;
+	return flags;
+}
+
+
+//-------------------------------------------------
+//  update_band_callback - update a single band on
+//  a worker thread
+//-------------------------------------------------
+
+void *screen_device::update_band_callback(void *param, int threadid)
+{
+	update_band &band = *reinterpret_cast<update_band *>(param);
+	screen_device &screen = *band.m_screen;
+	screen_bitmap &curbitmap = screen.m_bitmap[screen.m_curbitmap];
+	switch (curbitmap.format())
+	{
+		default:
+		case BITMAP_FORMAT_IND16:   band.m_flags = screen.m_screen_update_ind16(screen, curbitmap.as_ind16(), band.m_clip);   break;
+		case BITMAP_FORMAT_RGB32:   band.m_flags = screen.m_screen_update_rgb32(screen, curbitmap.as_rgb32(), band.m_clip);   break;
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  update_now - perform an update from the last
 //  beam position up to the current beam position
@@ -713,13 +815,8 @@ void screen_device::update_now()
 			{
 				g_profiler.start(PROFILER_VIDEO);
 
-				screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
-				switch (curbitmap.format())
-				{
-					default:
-					case BITMAP_FORMAT_IND16: m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);   break;
-					case BITMAP_FORMAT_RGB32: m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
-				}
+				profile_ticks_scope timing(machine().report(), m_profile_ticks);
+				update_bitmap(clip);
 
 				m_partial_updates_this_frame++;
 				g_profiler.stop();
@@ -753,12 +850,9 @@ void screen_device::update_now()
 		LOG_PARTIAL_UPDATES(("doing scanline partial draw: Y %d X %d-%d\n", clip.max_y, clip.min_x, clip.max_x));
 
 		UINT32 flags;
-		screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
-		switch (curbitmap.format())
 		{
-			default:
-			case BITMAP_FORMAT_IND16:   flags = m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);   break;
-			case BITMAP_FORMAT_RGB32:   flags = m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
+			profile_ticks_scope timing(machine().report(), m_profile_ticks);
+			flags = update_bitmap(clip);
 		}
 
 		m_partial_updates_this_frame++;
@@ -62,6 +62,10 @@ const UINT32 UPDATE_HAS_NOT_CHANGED = 0x0001;   // the video has not changed
 // calls VIDEO_UPDATE for every visible scanline, even for skipped frames
 #define VIDEO_UPDATE_SCANLINE           0x0100
 
+// VIDEO_UPDATE only reads machine state and may be called concurrently for
+// disjoint horizontal bands of the cliprect
+#define VIDEO_UPDATE_PARALLEL           0x0200
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -224,6 +228,8 @@ public:
 
 	// updating
 	int partial_updates() const { return m_partial_updates_this_frame; }
+	const osd_ticks_t &profile_ticks() const { return m_profile_ticks; }
+	bool updating_bands() const { return m_updating_bands; }
 	bool update_partial(int scanline);
 	void update_now();
 	void reset_partial_updates();
@@ -265,6 +271,9 @@ private:
 	void vblank_end();
 	void finalize_burnin();
 	void load_effect_overlay(const char *filename);
+	UINT32 update_bitmap(const rectangle &clip);
+	UINT32 update_bands(const rectangle &clip, int bands);
+	static void *update_band_callback(void *param, int threadid);
 
 	// inline configuration data
 	screen_type_enum    m_type;                     // type of screen
@@ -316,6 +325,19 @@ private:
 	emu_timer *         m_scanline_timer;           // scanline timer
 	UINT64              m_frame_number;             // the current frame number
 	UINT32              m_partial_updates_this_frame;// partial update counter this frame
+	osd_ticks_t         m_profile_ticks;            // real time spent updating, when reporting
+
+	// band-parallel updates
+	struct update_band
+	{
+		screen_device *     m_screen;                   // screen being updated
+		rectangle           m_clip;                     // rows of this band
+		UINT32              m_flags;                    // flags returned by the update
+	};
+	int                 m_max_bands;                // most bands to split an update into
+	bool                m_updating_bands;           // are bands being updated right now?
+	osd_work_queue *    m_band_queue;               // work queue for the bands
+	std::vector<update_band> m_bands;               // parameters for each band
 
 	// VBLANK callbacks
 	class callback_item
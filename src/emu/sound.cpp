@@ -53,6 +53,7 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 		m_next(nullptr),
 		m_sample_rate(sample_rate),
 		m_new_sample_rate(0),
+		m_resampler(device.machine().sound().default_resampler()),
 		m_attoseconds_per_sample(0),
 		m_max_samples_per_update(0),
 		m_input(inputs),
@@ -64,7 +65,8 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 		m_output_sampindex(0),
 		m_output_update_sampindex(0),
 		m_output_base_sampindex(0),
-		m_callback(std::move(callback))
+		m_callback(std::move(callback)),
+		m_profile_ticks(0)
 {
 	// get the device's sound interface
 	device_sound_interface *sound;
@@ -251,6 +253,7 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	// update the dependent info
 	if (input.m_source != nullptr)
 		input.m_source->m_dependents++;
+	m_device.machine().sound().m_subgraphs_dirty = true;
 
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
@@ -283,12 +286,16 @@ void sound_stream::update()
 		update_sampindex -= m_sample_rate;
 	}
 
-	// generate samples to get us up to the appropriate time
-	g_profiler.start(PROFILER_SOUND);
+	// generate samples to get us up to the appropriate time; the profiler isn't
+	// thread-safe, so leave it alone while subgraphs are updated in parallel
+	bool profile = !m_device.machine().sound().m_subgraphs_running;
+	if (profile)
+		g_profiler.start(PROFILER_SOUND);
 	assert(m_output_sampindex - m_output_base_sampindex >= 0);
 	assert(update_sampindex - m_output_base_sampindex <= m_output_bufalloc);
 	generate_samples(update_sampindex - m_output_sampindex);
-	g_profiler.stop();
+	if (profile)
+		g_profiler.stop();
 
 	// remember this info for next time
 	m_output_sampindex = update_sampindex;
@@ -373,6 +380,23 @@ void sound_stream::set_output_gain(int outputnum, float gain)
 }
 
 
+//-------------------------------------------------
+//  set_resampler - choose how inputs running at
+//  other rates are converted to ours, overriding
+//  the -resampler option
+//-------------------------------------------------
+
+void sound_stream::set_resampler(stream_resampler_type type)
+{
+	if (type != m_resampler)
+	{
+		update();
+		m_resampler = type;
+		recompute_sample_rate_data();
+	}
+}
+
+
 //-------------------------------------------------
 //  update_with_accounting - do a regular update,
 //  but also do periodic accounting
@@ -503,6 +527,20 @@ void sound_stream::recompute_sample_rate_data()
 			else if (input.m_source->m_stream->m_sample_rate == m_sample_rate)
 				latency = 0;
 
+			// the sinc kernel reads ahead of the current sample by half its width; fall
+			// back to linear if that would take more than an update's worth of latency
+			input.m_sinc = nullptr;
+			if (m_resampler == STREAM_RESAMPLER_SINC && input.m_source->m_stream->m_sample_rate != m_sample_rate)
+			{
+				const sinc_resampler *sinc = m_device.machine().sound().find_sinc_resampler(input.m_source->m_stream->m_sample_rate, m_sample_rate);
+				attoseconds_t sinc_latency = latency + sinc->lookahead() * new_attosecs_per_sample;
+				if (MAX(input.m_latency_attoseconds, sinc_latency) < update_attoseconds)
+				{
+					input.m_sinc = sinc;
+					latency = sinc_latency;
+				}
+			}
+
 			// we generally don't want to tweak the latency, so we just keep the greatest
 			// one we've computed thus far
 			input.m_latency_attoseconds = MAX(input.m_latency_attoseconds, latency);
@@ -638,7 +676,10 @@ void sound_stream::generate_samples(int samples)
 
 	// run the callback
 	VPRINTF(("  callback(%p, %d)\n", (void *)this, samples));
-	m_callback(*this, inputs, outputs, samples);
+	{
+		profile_ticks_scope timing(m_device.machine().report(), m_profile_ticks);
+		m_callback(*this, inputs, outputs, samples);
+	}
 	VPRINTF(("  callback done\n"));
 }
 
@@ -686,78 +727,14 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	// compute the stepping fraction
 	UINT32 step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
 
-	// if we have equal sample rates, we just need to copy
-	if (step == FRAC_ONE)
-	{
-		while (numsamples--)
-		{
-			// compute the sample
-			INT64 sample = *source++;
-			*dest++ = (sample * gain) >> 8;
-		}
-	}
-
-	// input is undersampled: point sample except where our sample period covers a boundary
-	else if (step < FRAC_ONE)
-	{
-		while (numsamples != 0)
-		{
-			// fill in with point samples until we hit a boundary
-			int nextfrac;
-			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
-			{
-				*dest++ = (source[0] * gain) >> 8;
-				basefrac = nextfrac;
-			}
-
-			// if we're done, we're done
-			if (INT32(numsamples--) < 0)
-				break;
-
-			// compute starting and ending fractional positions
-			int startfrac = basefrac >> (FRAC_BITS - 12);
-			int endfrac = nextfrac >> (FRAC_BITS - 12);
-
-			// blend between the two samples accordingly
-			INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac = nextfrac & FRAC_MASK;
-			source++;
-		}
-	}
-
-	// input is oversampled: sum the energy
+	// the sinc kernel also reads behind the current sample; use it when enough history is
+	// still buffered and the rates haven't changed under it
+	const sinc_resampler *sinc = input.m_sinc;
+	if (step != FRAC_ONE && sinc != nullptr && sinc->input_rate() == input_stream.m_sample_rate && sinc->output_rate() == m_sample_rate &&
+		basesample - sinc->history() >= input_stream.m_output_base_sampindex)
+		sinc->resample(source, basefrac, step, dest, numsamples, gain);
 	else
-	{
-		// use 8 bits to allow some extra headroom
-		int smallstep = step >> (FRAC_BITS - 8);
-		while (numsamples--)
-		{
-			INT64 remainder = smallstep;
-			int tpos = 0;
-
-			// compute the sample
-			INT64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
-			INT64 sample = (INT64) source[tpos++] * scale;
-			remainder -= scale;
-			while (remainder > 0x100)
-			{
-				sample += (INT64) source[tpos++] * (INT64) 0x100;
-				remainder -= 0x100;
-			}
-			sample += (INT64) source[tpos] * remainder;
-			sample /= smallstep;
-
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac += step;
-			source += basefrac >> FRAC_BITS;
-			basefrac &= FRAC_MASK;
-		}
-	}
+		resample_linear(source, basefrac, step, dest, numsamples, gain);
 
 	return &input.m_resample[0];
 }
@@ -776,7 +753,8 @@ sound_stream::stream_input::stream_input()
 	: m_source(nullptr),
 		m_latency_attoseconds(0),
 		m_gain(0x100),
-		m_user_gain(0x100)
+		m_user_gain(0x100),
+		m_sinc(nullptr)
 {
 }
 
@@ -825,6 +803,20 @@ sound_manager::sound_manager(running_machine &machine)
 	const char *wavfile = machine.options().wav_write();
 	const char *avifile = machine.options().avi_write();
 
+	// pick the default resampler for new streams
+	const char *resampler = machine.options().resampler();
+	m_default_resampler = STREAM_RESAMPLER_LINEAR;
+	if (strcmp(resampler, "sinc") == 0)
+		m_default_resampler = STREAM_RESAMPLER_SINC;
+	else if (strcmp(resampler, "linear") != 0)
+		osd_printf_warning("Unknown resampler '%s', using linear\n", resampler);
+
+	// parallel updates are partitioned lazily, once the streams are wired up
+	m_parallel = machine.options().parallel_sound() && (machine.debug_flags & DEBUG_FLAG_ENABLED) == 0;
+	m_subgraphs_dirty = true;
+	m_subgraphs_running = false;
+	m_subgraph_queue = nullptr;
+
 	// handle -nosound and lower sample rate if not recording WAV or AVI
 	if (m_nosound_mode && wavfile[0] == 0 && avifile[0] == 0)
 		machine.m_sample_rate = 11025;
@@ -864,6 +856,9 @@ sound_manager::~sound_manager()
 	if (m_wavfile != nullptr)
 		wav_close(m_wavfile);
 	m_wavfile = nullptr;
+
+	if (m_subgraph_queue != nullptr)
+		osd_work_queue_free(m_subgraph_queue);
 }
 
 
@@ -873,6 +868,7 @@ sound_manager::~sound_manager()
 
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback)
 {
+	m_subgraphs_dirty = true;
 	return &m_stream_list.append(*global_alloc(sound_stream(device, inputs, outputs, sample_rate, callback)));
 }
 
@@ -914,6 +910,150 @@ bool sound_manager::indexed_mixer_input(int index, mixer_input &info) const
 }
 
 
+//-------------------------------------------------
+//  rebuild_subgraphs - partition the streams into
+//  sets that share no inputs, outputs or owning
+//  devices with each other, stopping at the
+//  speakers
+//-------------------------------------------------
+
+void sound_manager::rebuild_subgraphs()
+{
+	m_subgraphs_dirty = false;
+	m_subgraphs.clear();
+
+	// number the streams and give each its own set
+	std::unordered_map<sound_stream *, int> index;
+	std::vector<int> parent;
+	for (sound_stream *stream = m_stream_list.first(); stream != nullptr; stream = stream->next())
+	{
+		index.emplace(stream, int(parent.size()));
+		parent.push_back(int(parent.size()));
+	}
+	auto find = [&parent](int set) { while (parent[set] != set) set = parent[set] = parent[parent[set]]; return set; };
+	auto merge = [&parent, &find](int a, int b) { a = find(a); b = find(b); if (a != b) parent[MAX(a, b)] = MIN(a, b); };
+
+	// merge the sets of every stream and its sources, and of streams on the same
+	// device, whose callbacks share the device's state; the speakers' mixer
+	// streams are where otherwise independent chips meet, so they are left out
+	// and mixed on the main thread once the subgraphs are up to date
+	std::unordered_map<device_t *, int> device_stream;
+	for (sound_stream *stream = m_stream_list.first(); stream != nullptr; stream = stream->next())
+	{
+		if (stream->device().type() == SPEAKER)
+			continue;
+		auto first = device_stream.emplace(&stream->device(), index[stream]);
+		if (!first.second)
+			merge(first.first->second, index[stream]);
+		for (auto &input : stream->m_input)
+			if (input.m_source != nullptr)
+				merge(index[stream], index[input.m_source->m_stream]);
+	}
+
+	// a set may only leave the main thread if every device in it has declared
+	// that its stream callbacks have no side effects
+	std::vector<bool> parallel(parent.size(), true);
+	int streamnum = 0;
+	for (sound_stream *stream = m_stream_list.first(); stream != nullptr; stream = stream->next(), streamnum++)
+	{
+		device_sound_interface *sound;
+		if (stream->device().type() == SPEAKER || !stream->device().interface(sound) || !sound->parallel_update())
+			parallel[find(streamnum)] = false;
+	}
+
+	// gather the sets in stream list order, so the partition doesn't depend on pointers
+	std::vector<int> subgraph(parent.size(), -1);
+	int serial = 0;
+	streamnum = 0;
+	for (sound_stream *stream = m_stream_list.first(); stream != nullptr; stream = stream->next(), streamnum++)
+	{
+		int set = find(streamnum);
+		if (!parallel[set])
+		{
+			// count each set left to the speakers once
+			if (stream->device().type() != SPEAKER && subgraph[set] < 0)
+			{
+				subgraph[set] = 0;
+				serial++;
+			}
+			continue;
+		}
+		if (subgraph[set] < 0)
+		{
+			subgraph[set] = m_subgraphs.size();
+			m_subgraphs.emplace_back();
+		}
+		m_subgraphs[subgraph[set]].m_streams.push_back(stream);
+	}
+	if (!parent.empty())
+		osd_printf_verbose("Sound: %d independent subgraphs updated in parallel, %d left to the main thread\n", int(m_subgraphs.size()), serial);
+
+	// a single subgraph gains nothing from another thread
+	if (m_subgraphs.size() < 2)
+		m_subgraphs.clear();
+	else if (m_subgraph_queue == nullptr)
+	{
+		m_subgraph_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (m_subgraph_queue == nullptr)
+			m_subgraphs.clear();
+	}
+}
+
+
+//-------------------------------------------------
+//  update_subgraphs - update every subgraph to
+//  the current time on the work queue, and wait
+//  for them all to finish
+//-------------------------------------------------
+
+void sound_manager::update_subgraphs()
+{
+	if (m_subgraphs_dirty)
+		rebuild_subgraphs();
+	if (m_subgraphs.empty())
+		return;
+
+	// each subgraph only touches its own streams, so the samples come out the
+	// same whichever thread generates them
+	m_subgraphs_running = true;
+	osd_work_item_queue_multiple(m_subgraph_queue, update_subgraph_callback, m_subgraphs.size(), &m_subgraphs[0], sizeof(m_subgraphs[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (osd_work_queue_items(m_subgraph_queue) != 0)
+		osd_work_queue_wait(m_subgraph_queue, osd_ticks_per_second() * 10);
+	m_subgraphs_running = false;
+}
+
+
+//-------------------------------------------------
+//  update_subgraph_callback - update the streams
+//  of a single subgraph on a worker thread
+//-------------------------------------------------
+
+void *sound_manager::update_subgraph_callback(void *param, int threadid)
+{
+	stream_subgraph &subgraph = *reinterpret_cast<stream_subgraph *>(param);
+	for (sound_stream *stream : subgraph.m_streams)
+		stream->update();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  find_sinc_resampler - return the shared sinc
+//  kernel between a pair of rates, building it
+//  the first time it is asked for
+//-------------------------------------------------
+
+const sinc_resampler *sound_manager::find_sinc_resampler(UINT32 input_rate, UINT32 output_rate)
+{
+	for (auto &sinc : m_sinc_resamplers)
+		if (sinc->input_rate() == input_rate && sinc->output_rate() == output_rate)
+			return sinc.get();
+
+	m_sinc_resamplers.push_back(std::make_unique<sinc_resampler>(input_rate, output_rate));
+	return m_sinc_resamplers.back().get();
+}
+
+
 //-------------------------------------------------
 //  mute - mute sound output
 //-------------------------------------------------
@@ -1036,6 +1176,11 @@ void sound_manager::update()
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring independent parts of the graph up to date concurrently; the speakers
+	// below then only mix what they produced, in the usual order
+	if (m_parallel)
+		update_subgraphs();
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	speaker_device_iterator iter(machine().root_device());
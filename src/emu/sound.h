@@ -86,11 +86,12 @@ class sound_stream
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
 		INT16               m_gain;                 // gain to apply to this input
 		INT16               m_user_gain;            // user-controlled gain to apply to this input
+		const sinc_resampler *m_sinc;               // windowed-sinc kernel for this input, or nullptr
 	};
 
 	// constants
 	static const int OUTPUT_BUFFER_UPDATES      = 5;
-	static const UINT32 FRAC_BITS               = 22;
+	static const UINT32 FRAC_BITS               = RESAMPLE_FRAC_BITS;
 	static const UINT32 FRAC_ONE                = 1 << FRAC_BITS;
 	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
 
@@ -112,6 +113,8 @@ public:
 	float user_gain(int inputnum) const;
 	float input_gain(int inputnum) const;
 	float output_gain(int outputnum) const;
+	const osd_ticks_t &profile_ticks() const { return m_profile_ticks; }
+	stream_resampler_type resampler() const { return m_resampler; }
 
 	// operations
 	void set_input(int inputnum, sound_stream *input_stream, int outputnum = 0, float gain = 1.0f);
@@ -123,6 +126,7 @@ public:
 	void set_user_gain(int inputnum, float gain);
 	void set_input_gain(int inputnum, float gain);
 	void set_output_gain(int outputnum, float gain);
+	void set_resampler(stream_resampler_type type);
 
 private:
 	// helpers called by our friends only
@@ -146,6 +150,7 @@ private:
 	UINT32              m_sample_rate;                // sample rate of this stream
 	UINT32              m_new_sample_rate;            // newly-set sample rate for the stream
 	bool                m_synchronous;                // synchronous stream that runs at the rate of its input
+	stream_resampler_type m_resampler;                // how inputs at other rates are converted
 
 	// timing information
 	attoseconds_t       m_attoseconds_per_sample;     // number of attoseconds per sample
@@ -171,6 +176,7 @@ private:
 
 	// callback information
 	stream_update_delegate  m_callback;                   // callback function
+	osd_ticks_t         m_profile_ticks;              // real time spent in the callback, when reporting
 };
 
 
@@ -215,6 +221,7 @@ public:
 
 	// user gain controls
 	bool indexed_mixer_input(int index, mixer_input &info) const;
+	stream_resampler_type default_resampler() const { return m_default_resampler; }
 
 private:
 	// internal helpers
@@ -226,6 +233,16 @@ private:
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
 
 	void update();
+	const sinc_resampler *find_sinc_resampler(UINT32 input_rate, UINT32 output_rate);
+	void rebuild_subgraphs();
+	void update_subgraphs();
+	static void *update_subgraph_callback(void *param, int threadid);
+
+	// a set of streams connected to each other and to no other stream
+	struct stream_subgraph
+	{
+		std::vector<sound_stream *> m_streams;      // member streams, in stream list order
+	};
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -244,6 +261,15 @@ private:
 
 	// streams data
 	simple_list<sound_stream> m_stream_list;    // list of streams
+	stream_resampler_type m_default_resampler;  // resampler for new streams, from the options
+	std::vector<std::unique_ptr<sinc_resampler>> m_sinc_resamplers; // kernels shared by inputs with the same rates
+
+	// parallel update data
+	bool                m_parallel;             // update independent subgraphs on worker threads
+	bool                m_subgraphs_dirty;      // streams were added or rewired since the last partition
+	bool                m_subgraphs_running;    // worker threads are updating subgraphs
+	std::vector<stream_subgraph> m_subgraphs;   // independent parts of the stream graph
+	osd_work_queue *    m_subgraph_queue;       // queue for subgraph updates
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
 };
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "tilerast.h"
 
 
 //**************************************************************************
@@ -95,236 +96,6 @@ inline bool tilemap_t::gfx_elements_changed()
 }
 
 
-//**************************************************************************
-//  SCANLINE RASTERIZERS
-//**************************************************************************
-
-//-------------------------------------------------
-//  scanline_draw_opaque_null - draw to a NULL
-//  bitmap, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline
-	for (int i = 0; i < count; i++)
-		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_null - draw to a NULL
-//  bitmap using a mask, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline, checking the mask
-	for (int i = 0; i < count; i++)
-		if ((maskptr[i] & mask) == value)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_ind16 - draw to a 16bpp
-//  indexed bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode)
-{
-	// special case for no palette offset
-	int pal = pcode >> 16;
-	if (pal == 0)
-	{
-		// use memcpy which should be well-optimized for the platform
-		memcpy(dest, source, count * 2);
-
-		// skip the rest if not changing priority
-		if (pcode == 0xff00)
-			return;
-
-		// update priority across the scanline
-		for (int i = 0; i < count; i++)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-	}
-
-	// priority case
-	else if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = source[i] + pal;
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = source[i] + pal;
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_ind16 - draw to a 16bpp
-//  indexed bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
-{
-	int pal = pcode >> 16;
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = source[i] + pal;
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = source[i] + pal;
-	}
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32 - draw to a 32bpp
-//  RGB bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32 - draw to a 32bpp
-//  RGB bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32_alpha - draw to a
-//  32bpp RGB bitmap with alpha blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32_alpha - draw to a
-//  32bpp RGB bitmap using a mask and alpha
-//  blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
 //**************************************************************************
 //  TILEMAP CREATION AND CONFIGURATION
 //**************************************************************************
@@ -945,8 +716,16 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	blit_parameters blit;
 	configure_blit_parameters(blit, screen.priority(), cliprect, flags, priority, priority_mask);
 
-	// flush the dirty state to all tiles as appropriate
-	realize_all_dirty_tiles();
+	// flush the dirty state to all tiles as appropriate; bands drawn concurrently
+	// can't render tiles as they reach them, so they bring the whole pixmap up to
+	// date first
+	if (screen.updating_bands())
+	{
+		std::lock_guard<std::mutex> lock(m_update_lock);
+		pixmap_update();
+	}
+	else
+		realize_all_dirty_tiles();
 
 	// flip the tilemap around the center of the visible area
 	rectangle visarea = screen.visible_area();
@@ -1083,7 +862,13 @@ g_profiler.start(PROFILER_TILEMAP_DRAW_ROZ);
 	configure_blit_parameters(blit, screen.priority(), cliprect, flags, priority, priority_mask);
 
 	// get the full pixmap for the tilemap
-	pixmap();
+	if (screen.updating_bands())
+	{
+		std::lock_guard<std::mutex> lock(m_update_lock);
+		pixmap_update();
+	}
+	else
+		pixmap();
 
 	// then do the roz copy
 	draw_roz_core(screen, dest, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
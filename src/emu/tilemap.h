@@ -592,16 +592,6 @@ private:
 	INT32 effective_colscroll(int index, UINT32 screen_height);
 	bool gfx_elements_changed();
 
-	// inline scanline rasterizers
-	void scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-	void scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-
 	// internal helpers
 	void postload();
 	void mappings_create();
@@ -655,6 +645,7 @@ private:
 	UINT32                      m_palette_offset;       // palette offset
 	UINT32                      m_gfx_used;             // bitmask of gfx items used
 	UINT32                      m_gfx_dirtyseq[MAX_GFX_ELEMENTS]; // dirtyseq values from last check
+	std::mutex                  m_update_lock;          // serializes pixmap updates from concurrent bands
 
 	// scroll information
 	UINT32                      m_scrollrows;           // number of independently scrolled rows
@@ -0,0 +1,463 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    tilerast.cpp
+
+    Scanline rasterizers used to copy tilemap pixmaps to the screen.
+
+***************************************************************************/
+
+#include "tilerast.h"
+#include <string.h>
+
+// use SSE2 on 64-bit x86, where it can be assumed, and NEON where the compiler offers it
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define TILERAST_SSE2
+#define TILERAST_VECTOR
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TILERAST_NEON
+#define TILERAST_VECTOR
+#endif
+
+// pixels covered by one mask test or priority update
+#define VECTOR_PIXELS       16
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  priority_apply - update a single priority
+//  bitmap pixel
+//-------------------------------------------------
+
+static inline UINT8 priority_apply(UINT8 pri, UINT32 pcode)
+{
+	return (pri & (pcode >> 8)) | pcode;
+}
+
+
+//-------------------------------------------------
+//  alpha_blend - blend two 8-8-8 RGB pixels, the
+//  same way as alpha_blend_r32
+//-------------------------------------------------
+
+static inline UINT32 alpha_blend(UINT32 d, UINT32 s, UINT8 level)
+{
+	int alphad = 256 - level;
+	return ((((s & 0x0000ff) * level + (d & 0x0000ff) * alphad) >> 8)) |
+			((((s & 0x00ff00) * level + (d & 0x00ff00) * alphad) >> 8) & 0x00ff00) |
+			((((s & 0xff0000) * level + (d & 0xff0000) * alphad) >> 8) & 0xff0000);
+}
+
+
+#if defined(TILERAST_SSE2)
+
+// one byte per pixel, 0xff where the pixel is drawn
+typedef __m128i vector_mask;
+
+//-------------------------------------------------
+//  mask_test - compare VECTOR_PIXELS flags map
+//  entries against the mask and value
+//-------------------------------------------------
+
+static inline vector_mask mask_test(const UINT8 *maskptr, UINT8 mask, UINT8 value)
+{
+	__m128i flags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(maskptr));
+	return _mm_cmpeq_epi8(_mm_and_si128(flags, _mm_set1_epi8(mask)), _mm_set1_epi8(value));
+}
+
+//-------------------------------------------------
+//  mask_bits - gather a mask into one bit per
+//  pixel, pixel 0 in bit 0
+//-------------------------------------------------
+
+static inline UINT32 mask_bits(vector_mask m)
+{
+	return _mm_movemask_epi8(m);
+}
+
+
+//-------------------------------------------------
+//  priority_apply_vector - update VECTOR_PIXELS
+//  priority bitmap pixels, optionally only where
+//  the mask is set
+//-------------------------------------------------
+
+static inline void priority_apply_vector(UINT8 *pri, UINT32 pcode)
+{
+	__m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pri));
+	__m128i result = _mm_or_si128(_mm_and_si128(old, _mm_set1_epi8(pcode >> 8)), _mm_set1_epi8(pcode));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(pri), result);
+}
+
+static inline void priority_apply_vector(UINT8 *pri, UINT32 pcode, vector_mask m)
+{
+	__m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pri));
+	__m128i result = _mm_or_si128(_mm_and_si128(old, _mm_set1_epi8(pcode >> 8)), _mm_set1_epi8(pcode));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(pri), _mm_or_si128(_mm_and_si128(m, result), _mm_andnot_si128(m, old)));
+}
+
+
+//-------------------------------------------------
+//  offset_pens_vector - copy VECTOR_PIXELS pens
+//  with the palette offset added, optionally only
+//  where the mask is set
+//-------------------------------------------------
+
+static inline void offset_pens_vector(UINT16 *dest, const UINT16 *source, UINT16 pal)
+{
+	__m128i offset = _mm_set1_epi16(pal);
+	for (int half = 0; half < 2; half++)
+	{
+		__m128i pens = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[half * 8]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[half * 8]), _mm_add_epi16(pens, offset));
+	}
+}
+
+static inline void offset_pens_vector(UINT16 *dest, const UINT16 *source, UINT16 pal, vector_mask m)
+{
+	__m128i offset = _mm_set1_epi16(pal);
+	__m128i wordmask[2] = { _mm_unpacklo_epi8(m, m), _mm_unpackhi_epi8(m, m) };
+	for (int half = 0; half < 2; half++)
+	{
+		__m128i pens = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[half * 8])), offset);
+		__m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&dest[half * 8]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[half * 8]), _mm_or_si128(_mm_and_si128(wordmask[half], pens), _mm_andnot_si128(wordmask[half], old)));
+	}
+}
+
+
+//-------------------------------------------------
+//  blend_4 - alpha blend 4 RGB pixels into the
+//  destination
+//-------------------------------------------------
+
+static inline void blend_4(UINT32 *dest, const UINT32 *source, UINT8 alpha)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i srclevel = _mm_set1_epi16(alpha);
+	const __m128i dstlevel = _mm_set1_epi16(256 - alpha);
+	__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+	__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest));
+
+	// each channel sum is at most 255 * 256, so it fits in 16 bits
+	__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), srclevel), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), dstlevel));
+	__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), srclevel), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), dstlevel));
+	__m128i result = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_and_si128(result, _mm_set1_epi32(0x00ffffff)));
+}
+
+#elif defined(TILERAST_NEON)
+
+// one byte per pixel, 0xff where the pixel is drawn
+typedef uint8x16_t vector_mask;
+
+static inline vector_mask mask_test(const UINT8 *maskptr, UINT8 mask, UINT8 value)
+{
+	return vceqq_u8(vandq_u8(vld1q_u8(maskptr), vdupq_n_u8(mask)), vdupq_n_u8(value));
+}
+
+static inline UINT32 mask_bits(vector_mask m)
+{
+	// weight each byte by its bit, then add them up within each half
+	static const UINT8 weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t bits = vandq_u8(m, vld1q_u8(weights));
+	uint8x8_t sum = vpadd_u8(vget_low_u8(bits), vget_high_u8(bits));
+	sum = vpadd_u8(sum, sum);
+	sum = vpadd_u8(sum, sum);
+	return vget_lane_u8(sum, 0) | (vget_lane_u8(sum, 1) << 8);
+}
+
+static inline void priority_apply_vector(UINT8 *pri, UINT32 pcode)
+{
+	vst1q_u8(pri, vorrq_u8(vandq_u8(vld1q_u8(pri), vdupq_n_u8(pcode >> 8)), vdupq_n_u8(pcode)));
+}
+
+static inline void priority_apply_vector(UINT8 *pri, UINT32 pcode, vector_mask m)
+{
+	uint8x16_t old = vld1q_u8(pri);
+	vst1q_u8(pri, vbslq_u8(m, vorrq_u8(vandq_u8(old, vdupq_n_u8(pcode >> 8)), vdupq_n_u8(pcode)), old));
+}
+
+static inline void offset_pens_vector(UINT16 *dest, const UINT16 *source, UINT16 pal)
+{
+	vst1q_u16(&dest[0], vaddq_u16(vld1q_u16(&source[0]), vdupq_n_u16(pal)));
+	vst1q_u16(&dest[8], vaddq_u16(vld1q_u16(&source[8]), vdupq_n_u16(pal)));
+}
+
+static inline void offset_pens_vector(UINT16 *dest, const UINT16 *source, UINT16 pal, vector_mask m)
+{
+	// sign extension widens each 0xff mask byte to 0xffff
+	uint16x8_t lomask = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_low_u8(m))));
+	uint16x8_t himask = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_high_u8(m))));
+	vst1q_u16(&dest[0], vbslq_u16(lomask, vaddq_u16(vld1q_u16(&source[0]), vdupq_n_u16(pal)), vld1q_u16(&dest[0])));
+	vst1q_u16(&dest[8], vbslq_u16(himask, vaddq_u16(vld1q_u16(&source[8]), vdupq_n_u16(pal)), vld1q_u16(&dest[8])));
+}
+
+static inline void blend_4(UINT32 *dest, const UINT32 *source, UINT8 alpha)
+{
+	uint8x16_t s = vreinterpretq_u8_u32(vld1q_u32(source));
+	uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dest));
+
+	// each channel sum is at most 255 * 256, so it fits in 16 bits
+	uint16x8_t lo = vaddq_u16(vmulq_n_u16(vmovl_u8(vget_low_u8(s)), alpha), vmulq_n_u16(vmovl_u8(vget_low_u8(d)), 256 - alpha));
+	uint16x8_t hi = vaddq_u16(vmulq_n_u16(vmovl_u8(vget_high_u8(s)), alpha), vmulq_n_u16(vmovl_u8(vget_high_u8(d)), 256 - alpha));
+	uint32x4_t result = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+	vst1q_u32(dest, vandq_u32(result, vdupq_n_u32(0x00ffffff)));
+}
+
+#endif
+
+
+
+//**************************************************************************
+//  SCANLINE RASTERIZERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  scanline_draw_opaque_null - draw to a NULL
+//  bitmap, setting priority only
+//-------------------------------------------------
+
+void scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if ((pcode & 0xffff) == 0xff00)
+		return;
+
+	// update priority across the scanline
+	int i = 0;
+#if defined(TILERAST_VECTOR)
+	for ( ; i + VECTOR_PIXELS <= count; i += VECTOR_PIXELS)
+		priority_apply_vector(&pri[i], pcode);
+#endif
+	for ( ; i < count; i++)
+		pri[i] = priority_apply(pri[i], pcode);
+}
+
+
+//-------------------------------------------------
+//  scanline_draw_masked_null - draw to a NULL
+//  bitmap using a mask, setting priority only
+//-------------------------------------------------
+
+void scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if ((pcode & 0xffff) == 0xff00)
+		return;
+
+	// update priority across the scanline, checking the mask
+	int i = 0;
+#if defined(TILERAST_VECTOR)
+	for ( ; i + VECTOR_PIXELS <= count; i += VECTOR_PIXELS)
+		priority_apply_vector(&pri[i], pcode, mask_test(&maskptr[i], mask, value));
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			pri[i] = priority_apply(pri[i], pcode);
+}
+
+
+
+//-------------------------------------------------
+//  scanline_draw_opaque_ind16 - draw to a 16bpp
+//  indexed bitmap
+//-------------------------------------------------
+
+void scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode)
+{
+	// special case for no palette offset
+	int pal = pcode >> 16;
+	if (pal == 0)
+	{
+		// use memcpy which should be well-optimized for the platform
+		memcpy(dest, source, count * 2);
+	}
+	else
+	{
+		int i = 0;
+#if defined(TILERAST_VECTOR)
+		for ( ; i + VECTOR_PIXELS <= count; i += VECTOR_PIXELS)
+			offset_pens_vector(&dest[i], &source[i], pal);
+#endif
+		for ( ; i < count; i++)
+			dest[i] = source[i] + pal;
+	}
+
+	// then update priority across the scanline
+	scanline_draw_opaque_null(count, pri, pcode);
+}
+
+
+//-------------------------------------------------
+//  scanline_draw_masked_ind16 - draw to a 16bpp
+//  indexed bitmap using a mask
+//-------------------------------------------------
+
+void scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	int pal = pcode >> 16;
+	bool priority = (pcode & 0xffff) != 0xff00;
+
+	int i = 0;
+#if defined(TILERAST_VECTOR)
+	for ( ; i + VECTOR_PIXELS <= count; i += VECTOR_PIXELS)
+	{
+		vector_mask m = mask_test(&maskptr[i], mask, value);
+		if (mask_bits(m) == 0)
+			continue;
+		offset_pens_vector(&dest[i], &source[i], pal, m);
+		if (priority)
+			priority_apply_vector(&pri[i], pcode, m);
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+		{
+			dest[i] = source[i] + pal;
+			if (priority)
+				pri[i] = priority_apply(pri[i], pcode);
+		}
+}
+
+
+
+//-------------------------------------------------
+//  scanline_draw_opaque_rgb32 - draw to a 32bpp
+//  RGB bitmap
+//-------------------------------------------------
+
+void scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+
+	// pen lookups are gathers, which don't pay off as vector code
+	for (int i = 0; i < count; i++)
+		dest[i] = clut[source[i]];
+
+	// then update priority across the scanline
+	scanline_draw_opaque_null(count, pri, pcode);
+}
+
+
+//-------------------------------------------------
+//  scanline_draw_masked_rgb32 - draw to a 32bpp
+//  RGB bitmap using a mask
+//-------------------------------------------------
+
+void scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+	bool priority = (pcode & 0xffff) != 0xff00;
+
+	int i = 0;
+#if defined(TILERAST_VECTOR)
+	// test the mask a vector at a time, skipping transparent runs and
+	// drawing solid ones without per-pixel tests
+	for ( ; i + VECTOR_PIXELS <= count; i += VECTOR_PIXELS)
+	{
+		vector_mask m = mask_test(&maskptr[i], mask, value);
+		UINT32 bits = mask_bits(m);
+		if (bits == 0)
+			continue;
+		if (bits == 0xffff)
+		{
+			for (int j = i; j < i + VECTOR_PIXELS; j++)
+				dest[j] = clut[source[j]];
+			if (priority)
+				priority_apply_vector(&pri[i], pcode);
+		}
+		else
+		{
+			for (int j = i; bits != 0; j++, bits >>= 1)
+				if (bits & 1)
+					dest[j] = clut[source[j]];
+			if (priority)
+				priority_apply_vector(&pri[i], pcode, m);
+		}
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+		{
+			dest[i] = clut[source[i]];
+			if (priority)
+				pri[i] = priority_apply(pri[i], pcode);
+		}
+}
+
+
+//-------------------------------------------------
+//  scanline_draw_opaque_rgb32_alpha - draw to a
+//  32bpp RGB bitmap with alpha blending
+//-------------------------------------------------
+
+void scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+
+	// the pen lookups dominate here and the compiler already schedules
+	// the scalar blend well; blend_4 only pays off in the masked case,
+	// where whole vectors of transparent pixels are skipped
+	for (int i = 0; i < count; i++)
+		dest[i] = alpha_blend(dest[i], clut[source[i]], alpha);
+
+	// then update priority across the scanline
+	scanline_draw_opaque_null(count, pri, pcode);
+}
+
+
+//-------------------------------------------------
+//  scanline_draw_masked_rgb32_alpha - draw to a
+//  32bpp RGB bitmap using a mask and alpha
+//  blending
+//-------------------------------------------------
+
+void scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+	bool priority = (pcode & 0xffff) != 0xff00;
+
+	int i = 0;
+#if defined(TILERAST_VECTOR)
+	UINT32 lookup[VECTOR_PIXELS];
+	for ( ; i + VECTOR_PIXELS <= count; i += VECTOR_PIXELS)
+	{
+		vector_mask m = mask_test(&maskptr[i], mask, value);
+		UINT32 bits = mask_bits(m);
+		if (bits == 0)
+			continue;
+		if (bits == 0xffff)
+		{
+			for (int j = 0; j < VECTOR_PIXELS; j++)
+				lookup[j] = clut[source[i + j]];
+			for (int j = 0; j < VECTOR_PIXELS; j += 4)
+				blend_4(&dest[i + j], &lookup[j], alpha);
+			if (priority)
+				priority_apply_vector(&pri[i], pcode);
+		}
+		else
+		{
+			for (int j = i; bits != 0; j++, bits >>= 1)
+				if (bits & 1)
+					dest[j] = alpha_blend(dest[j], clut[source[j]], alpha);
+			if (priority)
+				priority_apply_vector(&pri[i], pcode, m);
+		}
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+		{
+			dest[i] = alpha_blend(dest[i], clut[source[i]], alpha);
+			if (priority)
+				pri[i] = priority_apply(pri[i], pcode);
+		}
+}
@@ -0,0 +1,51 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    tilerast.h
+
+    Scanline rasterizers used to copy tilemap pixmaps to the screen.
+
+****************************************************************************
+
+    Each rasterizer copies count pixels from a row of the tilemap pixmap
+    to a row of the destination, optionally only where the flags map
+    matches (masked variants), and updates the priority bitmap for every
+    pixel it draws.
+
+    The priority code pcode carries the palette offset in its upper 16
+    bits, the mask ANDed into the priority bitmap in bits 8-15 and the
+    value ORed into it in bits 0-7.  A low half of 0xff00 leaves the
+    priority bitmap alone.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __TILERAST_H__
+#define __TILERAST_H__
+
+#include "osdcomm.h"
+#include "palette.h"
+
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+// priority bitmap only
+void scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode);
+void scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
+
+// 16bpp indexed destination
+void scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode);
+void scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
+
+// 32bpp RGB destination
+void scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode);
+void scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode);
+void scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
+void scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
+
+
+#endif  /* __TILERAST_H__ */
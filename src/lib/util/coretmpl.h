@@ -16,6 +16,7 @@
 #include "osdcore.h"
 #include "corealloc.h"
 
+#include <assert.h>
 #include <vector>
 
 #if defined(_MSC_VER) && (_MSC_VER < 1900)
@@ -317,4 +318,117 @@ private:
 };
 
 
+// ======================> intrusive_heap
+
+// an intrusive_heap is a binary min-heap of object pointers; each object
+// owns an 'm_heapindex' member recording its position (-1 when it is not
+// in the heap) and a 'heap_before' method that orders it against another
+template<class _ElementType>
+class intrusive_heap
+{
+	// we don't support deep copying
+	intrusive_heap(const intrusive_heap &);
+	intrusive_heap &operator=(const intrusive_heap &);
+
+public:
+	// construction/destruction
+	intrusive_heap() { }
+
+	// getters
+	bool empty() const { return m_items.empty(); }
+	int count() const { return m_items.size(); }
+	_ElementType *top() const { assert(!m_items.empty()); return m_items[0]; }
+	bool contains(const _ElementType &object) const { return object.m_heapindex >= 0; }
+
+	// add an object to the heap
+	void insert(_ElementType &object)
+	{
+		assert(object.m_heapindex < 0);
+		m_items.push_back(&object);
+		sift_up(m_items.size() - 1);
+	}
+
+	// remove an object from anywhere in the heap
+	void remove(_ElementType &object)
+	{
+		assert(object.m_heapindex >= 0 && m_items[object.m_heapindex] == &object);
+		int index = object.m_heapindex;
+		object.m_heapindex = -1;
+
+		// move the last item into the hole and restore the ordering from there
+		_ElementType *last = m_items.back();
+		m_items.pop_back();
+		if (last != &object)
+		{
+			place(*last, index);
+			update(*last);
+		}
+	}
+
+	// restore the ordering after an object's key has changed
+	void update(_ElementType &object)
+	{
+		int index = object.m_heapindex;
+		if (index > 0 && object.heap_before(*m_items[(index - 1) / 2]))
+			sift_up(index);
+		else
+			sift_down(index);
+	}
+
+	// empty the heap
+	void reset()
+	{
+		for (_ElementType *item : m_items)
+			item->m_heapindex = -1;
+		m_items.clear();
+	}
+
+private:
+	// store an object at the given position
+	void place(_ElementType &object, int index)
+	{
+		m_items[index] = &object;
+		object.m_heapindex = index;
+	}
+
+	// move an object towards the root until its parent comes before it
+	void sift_up(int index)
+	{
+		_ElementType &object = *m_items[index];
+		while (index > 0)
+		{
+			int parent = (index - 1) / 2;
+			if (!object.heap_before(*m_items[parent]))
+				break;
+			place(*m_items[parent], index);
+			index = parent;
+		}
+		place(object, index);
+	}
+
+	// move an object towards the leaves until it comes before both children
+	void sift_down(int index)
+	{
+		_ElementType &object = *m_items[index];
+		int count = m_items.size();
+		while (true)
+		{
+			int child = index * 2 + 1;
+			if (child >= count)
+				break;
+			if (child + 1 < count && m_items[child + 1]->heap_before(*m_items[child]))
+				child++;
+			if (!m_items[child]->heap_before(object))
+				break;
+			place(*m_items[child], index);
+			index = child;
+		}
+		place(object, index);
+	}
+
+	// internal state
+	std::vector<_ElementType *> m_items;    // heap-ordered array of objects
+};
+
+
 #endif
@@ -581,6 +581,7 @@ static MACHINE_CONFIG_START( 1942, _1942_state )
 	MCFG_SCREEN_SIZE(32*8, 32*8)
 	MCFG_SCREEN_VISIBLE_AREA(0*8, 32*8-1, 2*8, 30*8-1)
 	MCFG_SCREEN_UPDATE_DRIVER(_1942_state, screen_update_1942)
+	MCFG_SCREEN_VIDEO_ATTRIBUTES(VIDEO_UPDATE_PARALLEL)   /* update only reads video RAM, so bands can be drawn at once */
 	MCFG_SCREEN_PALETTE("palette")
 
 	/* sound hardware */
@@ -649,6 +650,7 @@ static MACHINE_CONFIG_START( 1942p, _1942_state )
 	MCFG_SCREEN_SIZE(32*8, 32*8)
 	MCFG_SCREEN_VISIBLE_AREA(0*8, 32*8-1, 2*8, 30*8-1)
 	MCFG_SCREEN_UPDATE_DRIVER(_1942_state, screen_update_1942p)
+	MCFG_SCREEN_VIDEO_ATTRIBUTES(VIDEO_UPDATE_PARALLEL)   /* update only reads video RAM, so bands can be drawn at once */
 	MCFG_SCREEN_PALETTE("palette")
 
 
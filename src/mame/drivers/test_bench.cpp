@@ -0,0 +1,500 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*
+
+    Core primitive benchmarks
+
+    Times the parts of the core that need a running machine and so
+    cannot live in the standalone benchmarks target:
+
+        timer_adjust        emu_timer::adjust on a set of pending timers
+        timer_fire          a periodic emu_timer firing, including the
+                            scheduler work between firings
+        stream_resample     sound_stream::update of a 48000Hz stream
+                            fed by a 44100Hz one, per output sample
+        tilemap_opaque      tilemap_t::draw of a clean 64x32 tilemap
+        tilemap_transpen    the same with a transparent pen
+        tilemap_dirty       the same with every tile marked dirty first
+        render_primitives   render_target::get_primitives on a 640x480
+                            target with the screen and a few hundred
+                            extra rectangles and lines
+
+    Run with -video none -sound none; the driver prints one line per
+    benchmark, then the same results as a single line of JSON, and
+    exits.  address_space dispatch is timed by testmem and the drawgfx
+    kernels by testgfx, which print the same JSON line; attotime, CHD
+    hunk reads and standalone copies of the timer heap and tilemap
+    scanline kernels are in the benchmarks target.
+
+*/
+
+#include "emu.h"
+#include "render.h"
+
+// frame size
+#define FRAME_WIDTH             384
+#define FRAME_HEIGHT            256
+
+// emu_timer benchmarks
+#define ADJUST_TIMERS           64
+#define ADJUST_LOOPS            1000000
+#define FIRE_TIMERS             64
+#define FIRE_SECONDS            1
+
+// sound_stream benchmark
+#define SOURCE_RATE             44100
+#define SINK_RATE               48000
+#define STREAM_UPDATES          600
+
+// tilemap benchmark
+#define TILEMAP_COLS            64
+#define TILEMAP_ROWS            32
+#define TILEMAP_FRAMES          200
+
+// render_target benchmark
+#define TARGET_WIDTH            640
+#define TARGET_HEIGHT           480
+#define TARGET_ITEMS            200
+#define TARGET_FRAMES           2000
+
+// tile set
+#define GFX_ELEMENTS            256
+#define GFX_COLORS              64
+
+
+enum
+{
+	TIMER_START,
+	TIMER_ADJUST,
+	TIMER_FIRE,
+	TIMER_FIRE_DONE,
+	TIMER_STREAM,
+	TIMER_STREAM_DONE
+};
+
+enum
+{
+	BENCH_TIMER_ADJUST,
+	BENCH_TIMER_FIRE,
+	BENCH_STREAM_RESAMPLE,
+	BENCH_TILEMAP_OPAQUE,
+	BENCH_TILEMAP_TRANSPEN,
+	BENCH_TILEMAP_DIRTY,
+	BENCH_RENDER_PRIMITIVES,
+	BENCH_COUNT
+};
+
+static const char *const bench_names[BENCH_COUNT] =
+{
+	"timer_adjust", "timer_fire", "stream_resample",
+	"tilemap_opaque", "tilemap_transpen", "tilemap_dirty",
+	"render_primitives"
+};
+
+static const char *const bench_units[BENCH_COUNT] =
+{
+	"adjust", "firing", "sample", "frame", "frame", "frame", "frame"
+};
+
+
+// 4bpp packed tiles, two pixels per byte
+static const gfx_layout layout_8x8 =
+{
+	8, 8,
+	GFX_ELEMENTS,
+	4,
+	{ 0, 1, 2, 3 },
+	{ STEP8(0, 4) },
+	{ STEP8(0, 8*4) },
+	8*8*4
+};
+
+//-------------------------------------------------
+//  bench_stream_device - a source stream at one
+//  rate feeding a sink stream at another, so
+//  that every sink update resamples its input
+//-------------------------------------------------
+
+class bench_stream_device : public device_t,
+							public device_sound_interface
+{
+public:
+	bench_stream_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
+
+	void update() { m_sink->update(); }
+	UINT64 samples() const { return m_samples; }
+	INT64 sum() const { return m_sum; }
+
+protected:
+	// device-level overrides
+	virtual void device_start() override;
+
+	// sound stream update overrides
+	virtual void sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples) override;
+
+private:
+	void source_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples);
+
+	sound_stream *m_sink;
+	UINT64 m_samples;
+	INT64 m_sum;
+};
+
+const device_type BENCH_STREAM = &device_creator<bench_stream_device>;
+
+bench_stream_device::bench_stream_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+	: device_t(mconfig, BENCH_STREAM, "Benchmark stream pair", tag, owner, clock, "bench_stream", __FILE__),
+		device_sound_interface(mconfig, *this),
+		m_sink(nullptr),
+		m_samples(0),
+		m_sum(0)
+{
+}
+
+void bench_stream_device::device_start()
+{
+	// the sink goes first so that it is the device's output 0
+	m_sink = stream_alloc(1, 1, SINK_RATE);
+	sound_stream *source = machine().sound().stream_alloc(*this, 0, 1, SOURCE_RATE, stream_update_delegate(FUNC(bench_stream_device::source_update), this));
+	m_sink->set_input(0, source);
+}
+
+
+//-------------------------------------------------
+//  source_update - produce a sawtooth for the
+//  resampler to work on
+//-------------------------------------------------
+
+void bench_stream_device::source_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
+{
+	stream_sample_t *dest = outputs[0];
+	for (int sample = 0; sample < samples; sample++)
+		dest[sample] = ((sample * 331) & 0xffff) - 0x8000;
+}
+
+
+//-------------------------------------------------
+//  sound_stream_update - pass the resampled input
+//  through and keep a sum so the work is not
+//  optimized away
+//-------------------------------------------------
+
+void bench_stream_device::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
+{
+	for (int sample = 0; sample < samples; sample++)
+	{
+		outputs[0][sample] = inputs[0][sample];
+		m_sum += inputs[0][sample];
+	}
+	m_samples += samples;
+}
+
+
+static GFXDECODE_START( test_bench )
+GFXDECODE_END
+
+
+class test_bench_state : public driver_device
+{
+public:
+	test_bench_state(const machine_config &mconfig, device_type type, const char *tag)
+		: driver_device(mconfig, type, tag),
+			m_screen(*this, "screen"),
+			m_gfxdecode(*this, "gfxdecode"),
+			m_palette(*this, "palette"),
+			m_stream(*this, "stream") { }
+
+	UINT32 screen_update(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect) { return 0; }
+
+protected:
+	virtual void machine_start() override;
+	virtual void device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr) override;
+
+private:
+	TILE_GET_INFO_MEMBER(get_tile_info);
+
+	void bench_timer_adjust();
+	void bench_tilemap();
+	void bench_render();
+	void report();
+
+	required_device<screen_device> m_screen;
+	required_device<gfxdecode_device> m_gfxdecode;
+	required_device<palette_device> m_palette;
+	required_device<bench_stream_device> m_stream;
+
+	std::vector<UINT8> m_tiles;
+	std::vector<UINT16> m_tileram;
+	tilemap_t *m_tilemap;
+	std::vector<emu_timer *> m_fire_timers;
+	emu_timer *m_stream_timer;
+
+	osd_ticks_t m_phase_start;
+	osd_ticks_t m_stream_ticks;
+	UINT64 m_stream_samples;
+	UINT64 m_fires;
+	double m_results[BENCH_COUNT];
+};
+
+
+//-------------------------------------------------
+//  get_tile_info - one random tile per cell
+//-------------------------------------------------
+
+TILE_GET_INFO_MEMBER(test_bench_state::get_tile_info)
+{
+	UINT16 data = m_tileram[tile_index];
+	SET_TILE_INFO_MEMBER(0, data & 0xff, data >> 8, 0);
+}
+
+
+//-------------------------------------------------
+//  bench_timer_adjust - move a set of timers to
+//  new pseudo-random expiry times
+//-------------------------------------------------
+
+void test_bench_state::bench_timer_adjust()
+{
+	std::vector<emu_timer *> timers;
+	for (int index = 0; index < ADJUST_TIMERS; index++)
+	{
+		timers.push_back(timer_alloc(TIMER_ADJUST));
+		timers.back()->adjust(attotime::from_usec(1000 + index));
+	}
+
+	UINT32 seed = 1;
+	osd_ticks_t start = osd_ticks();
+	for (int loop = 0; loop < ADJUST_LOOPS; loop++)
+	{
+		seed = seed * 1103515245 + 12345;
+		timers[loop % ADJUST_TIMERS]->adjust(attotime::from_usec(1000 + (seed >> 16) % 1000));
+	}
+	osd_ticks_t ticks = osd_ticks() - start;
+
+	for (emu_timer *timer : timers)
+		timer->enable(false);
+	m_results[BENCH_TIMER_ADJUST] = double(ticks) * 1e9 / double(osd_ticks_per_second()) / ADJUST_LOOPS;
+}
+
+
+//-------------------------------------------------
+//  bench_tilemap - draw the tilemap clean, with a
+//  transparent pen, and with every tile dirty
+//-------------------------------------------------
+
+void test_bench_state::bench_tilemap()
+{
+	bitmap_ind16 dest(FRAME_WIDTH, FRAME_HEIGHT);
+	const rectangle &clip = dest.cliprect();
+	const double ns_per_tick = 1e9 / double(osd_ticks_per_second());
+
+	// draw once so that the clean variants start clean
+	m_tilemap->draw(*m_screen, dest, clip, TILEMAP_DRAW_OPAQUE);
+
+	osd_ticks_t start = osd_ticks();
+	for (int frame = 0; frame < TILEMAP_FRAMES; frame++)
+	{
+		m_tilemap->set_scrollx(0, frame);
+		m_tilemap->set_scrolly(0, frame / 2);
+		m_tilemap->draw(*m_screen, dest, clip, TILEMAP_DRAW_OPAQUE);
+	}
+	m_results[BENCH_TILEMAP_OPAQUE] = double(osd_ticks() - start) * ns_per_tick / TILEMAP_FRAMES;
+
+	start = osd_ticks();
+	for (int frame = 0; frame < TILEMAP_FRAMES; frame++)
+	{
+		m_tilemap->set_scrollx(0, frame);
+		m_tilemap->set_scrolly(0, frame / 2);
+		m_tilemap->draw(*m_screen, dest, clip, 0);
+	}
+	m_results[BENCH_TILEMAP_TRANSPEN] = double(osd_ticks() - start) * ns_per_tick / TILEMAP_FRAMES;
+
+	start = osd_ticks();
+	for (int frame = 0; frame < TILEMAP_FRAMES; frame++)
+	{
+		m_tilemap->mark_all_dirty();
+		m_tilemap->draw(*m_screen, dest, clip, 0);
+	}
+	m_results[BENCH_TILEMAP_DIRTY] = double(osd_ticks() - start) * ns_per_tick / TILEMAP_FRAMES;
+}
+
+
+//-------------------------------------------------
+//  bench_render - build the primitive list of a
+//  hidden target over and over
+//-------------------------------------------------
+
+void test_bench_state::bench_render()
+{
+	render_target *target = machine().render().target_alloc(nullptr, RENDER_CREATE_HIDDEN);
+	target->set_bounds(TARGET_WIDTH, TARGET_HEIGHT);
+
+	// give the screen container something beyond the screen itself
+	render_container &container = m_screen->container();
+	for (int item = 0; item < TARGET_ITEMS; item++)
+	{
+		float x = float(machine().rand() % 1000) / 1000.0f;
+		float y = float(machine().rand() % 1000) / 1000.0f;
+		rgb_t color(0x80, machine().rand(), machine().rand(), machine().rand());
+		container.add_rect(x * 0.9f, y * 0.9f, x * 0.9f + 0.1f, y * 0.9f + 0.1f, color, PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+		container.add_line(x, y, 1.0f - x, 1.0f - y, 1.0f / TARGET_HEIGHT, color, PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+	}
+
+	int primitives = 0;
+	osd_ticks_t start = osd_ticks();
+	for (int frame = 0; frame < TARGET_FRAMES; frame++)
+	{
+		render_primitive_list &list = target->get_primitives();
+		list.acquire_lock();
+		primitives = 0;
+		for (render_primitive *prim = list.first(); prim != nullptr; prim = prim->next())
+			primitives++;
+		list.release_lock();
+	}
+	osd_ticks_t ticks = osd_ticks() - start;
+
+	container.empty();
+	machine().render().target_free(target);
+	osd_printf_verbose("render target built %d primitives per frame\n", primitives);
+	m_results[BENCH_RENDER_PRIMITIVES] = double(ticks) * 1e9 / double(osd_ticks_per_second()) / TARGET_FRAMES;
+}
+
+
+//-------------------------------------------------
+//  report - print the results, then the same
+//  results as JSON
+//-------------------------------------------------
+
+void test_bench_state::report()
+{
+	std::string json;
+	for (int bench = 0; bench < BENCH_COUNT; bench++)
+	{
+		osd_printf_info("%-18s %12.2fns/%s\n", bench_names[bench], m_results[bench], bench_units[bench]);
+		strcatprintf(json, "%s { \"name\": \"%s\", \"unit\": \"%s\", \"ns\": %.2f }", (bench == 0) ? "" : ",", bench_names[bench], bench_units[bench], m_results[bench]);
+	}
+	osd_printf_info("{ \"benchmarks\": [%s ] }\n", json.c_str());
+
+	// keep the stream results live
+	osd_printf_verbose("checksum %s\n", core_i64_hex_format(m_stream->sum(), 16));
+	machine().schedule_exit();
+}
+
+
+//-------------------------------------------------
+//  device_timer - step through the benchmarks
+//  that need emulated time to pass
+//-------------------------------------------------
+
+void test_bench_state::device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr)
+{
+	switch (id)
+	{
+		case TIMER_START:
+			bench_timer_adjust();
+			bench_tilemap();
+			bench_render();
+
+			// a spread of periods so that the firings interleave
+			m_fires = 0;
+			for (int index = 0; index < FIRE_TIMERS; index++)
+			{
+				m_fire_timers.push_back(timer_alloc(TIMER_FIRE));
+				m_fire_timers.back()->adjust(attotime::zero, 0, attotime::from_hz(10000 + 97 * index));
+			}
+			timer_set(attotime::from_seconds(FIRE_SECONDS), TIMER_FIRE_DONE);
+			m_phase_start = osd_ticks();
+			break;
+
+		case TIMER_FIRE:
+			m_fires++;
+			break;
+
+		case TIMER_FIRE_DONE:
+		{
+			osd_ticks_t ticks = osd_ticks() - m_phase_start;
+			for (emu_timer *fire : m_fire_timers)
+				fire->enable(false);
+			m_results[BENCH_TIMER_FIRE] = double(ticks) * 1e9 / double(osd_ticks_per_second()) / double(m_fires);
+
+			m_stream_ticks = 0;
+			m_stream_samples = 0;
+
+			// the sound manager brings every stream up to date at the end
+			// of each frame, so update halfway between frames
+			m_stream_timer = timer_alloc(TIMER_STREAM);
+			m_stream_timer->adjust(attotime::from_hz(120), 0, attotime::from_hz(60));
+			timer_set(attotime::from_hz(60) * STREAM_UPDATES, TIMER_STREAM_DONE);
+			break;
+		}
+
+		case TIMER_STREAM:
+		{
+			UINT64 samples = m_stream->samples();
+			osd_ticks_t start = osd_ticks();
+			m_stream->update();
+			m_stream_ticks += osd_ticks() - start;
+			m_stream_samples += m_stream->samples() - samples;
+			break;
+		}
+
+		case TIMER_STREAM_DONE:
+			m_stream_timer->enable(false);
+			m_results[BENCH_STREAM_RESAMPLE] = double(m_stream_ticks) * 1e9 / double(osd_ticks_per_second()) / double(m_stream_samples);
+			report();
+			break;
+	}
+}
+
+
+void test_bench_state::machine_start()
+{
+	// random colors and tiles; pen 0 is transparent in about a quarter
+	// of the pixels
+	for (int pen = 0; pen < m_palette->entries(); pen++)
+		m_palette->set_pen_color(pen, rgb_t(machine().rand(), machine().rand(), machine().rand()));
+	m_tiles.resize(GFX_ELEMENTS * 8 * 8 / 2);
+	for (auto &pixels : m_tiles)
+	{
+		UINT8 data = machine().rand();
+		if ((machine().rand() & 3) == 0) data &= 0xf0;
+		if ((machine().rand() & 3) == 0) data &= 0x0f;
+		pixels = data;
+	}
+	m_gfxdecode->set_gfx(0, std::make_unique<gfx_element>(*m_palette, layout_8x8, &m_tiles[0], 0, GFX_COLORS, 0));
+
+	m_tileram.resize(TILEMAP_COLS * TILEMAP_ROWS);
+	for (auto &tile : m_tileram)
+		tile = machine().rand() & ((GFX_COLORS - 1) << 8 | 0xff);
+	m_tilemap = &machine().tilemap().create(*m_gfxdecode, tilemap_get_info_delegate(FUNC(test_bench_state::get_tile_info), this), TILEMAP_SCAN_ROWS, 8, 8, TILEMAP_COLS, TILEMAP_ROWS);
+	m_tilemap->set_transparent_pen(0);
+
+	for (auto &result : m_results)
+		result = 0;
+
+	// the render and stream benchmarks need the machine to be fully up
+	synchronize(TIMER_START);
+}
+
+static MACHINE_CONFIG_START( test_bench, test_bench_state )
+	MCFG_SCREEN_ADD("screen", RASTER)
+	MCFG_SCREEN_REFRESH_RATE(60)
+	MCFG_SCREEN_SIZE(FRAME_WIDTH, FRAME_HEIGHT)
+	MCFG_SCREEN_VISIBLE_AREA(0, FRAME_WIDTH - 1, 0, FRAME_HEIGHT - 1)
+	MCFG_SCREEN_UPDATE_DRIVER(test_bench_state, screen_update)
+	MCFG_SCREEN_PALETTE("palette")
+
+	MCFG_GFXDECODE_ADD("gfxdecode", "palette", test_bench)
+	MCFG_PALETTE_ADD("palette", GFX_COLORS * 16)
+
+	// the speaker keeps the streams up to date between the timed updates,
+	// as it would for a sound chip
+	MCFG_SPEAKER_STANDARD_MONO("mono")
+	MCFG_DEVICE_ADD("stream", BENCH_STREAM, 0)
+	MCFG_SOUND_ROUTE(0, "mono", 1.0)
+MACHINE_CONFIG_END
+
+ROM_START( testbnch )
+ROM_END
+
+COMP( 2016, testbnch,  0,        0,      test_bench, 0, driver_device, 0,      "MAMEdev",   "Core primitive benchmarks", 0 )
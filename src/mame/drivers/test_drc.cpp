@@ -0,0 +1,64 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*
+
+    UML back-end conformance test
+
+    Runs the same UML blocks through the C back-end and the native
+    back-end for this host and reports any difference in the resulting
+    machine state: first edge values for each opcode, then randomly
+    generated blocks, then random blocks with and without the UML
+    optimizer passes.  Finally the speed of the generated code is
+    reported for both back-ends.  Run with -video none; the driver
+    exits once the tests have finished and fails if any test did not
+    match.
+
+*/
+
+#include "emu.h"
+#include "cpu/drcbetest.h"
+
+// random blocks to run after the edge value tests; the seed is fixed so
+// that failures can be reproduced
+#define FUZZ_SEED       1
+#define FUZZ_BLOCKS     20000
+
+// random blocks to run with the optimizer off and on
+#define OPTIMIZER_FUZZ_SEED     2
+#define OPTIMIZER_FUZZ_BLOCKS   20000
+
+// loop iterations for the generated code benchmark
+#define BENCHMARK_ITERATIONS    1000000
+
+class test_drc_state : public driver_device
+{
+public:
+	test_drc_state(const machine_config &mconfig, device_type type, const char *tag)
+		: driver_device(mconfig, type, tag) { }
+
+protected:
+	virtual void machine_start() override;
+};
+
+void test_drc_state::machine_start()
+{
+	drcbe_conformance tester(*this);
+	tester.run_all();
+	tester.run_fuzz(FUZZ_SEED, FUZZ_BLOCKS);
+	tester.run_optimizer_fuzz(OPTIMIZER_FUZZ_SEED, OPTIMIZER_FUZZ_BLOCKS);
+
+	osd_printf_info("%d UML conformance tests, %d failures\n", tester.tests(), tester.failures());
+	if (tester.failures() != 0)
+		throw emu_fatalerror("UML back-end conformance test failed");
+
+	tester.run_benchmark(BENCHMARK_ITERATIONS);
+	machine().schedule_exit();
+}
+
+static MACHINE_CONFIG_START( test_drc, test_drc_state )
+MACHINE_CONFIG_END
+
+ROM_START( testdrc )
+ROM_END
+
+COMP( 2016, testdrc,   0,        0,      test_drc,    0, driver_device, 0,      "MAMEdev",   "UML back-end conformance test", MACHINE_NO_SOUND_HW )
@@ -0,0 +1,450 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*
+
+    drawgfx kernel test
+
+    Draws the same frame of sprites with each gfx_element drawing
+    function and with the drawgfxm.h macros those functions used to be
+    built from, and checks that the bitmaps and priority bitmaps come
+    out identical.  Then reports the time per sprite for every variant,
+    with 8x8 and 16x16 elements and both bitmap depths, one line per
+    variant and then all of them as a single line of JSON in the same
+    form as testbnch.  Run with -video none; the driver exits once the
+    tests have finished and fails if any variant drew something
+    different.
+
+    Sprites are 4bpp with about a quarter of their pixels transparent,
+    land at random positions (so some are clipped by the frame edges)
+    with random flips, and are scaled between half and double size in
+    the zoom variants.
+
+*/
+
+#include "emu.h"
+#include "drawgfxm.h"
+
+// frame size and contents
+#define FRAME_WIDTH             384
+#define FRAME_HEIGHT            256
+#define FRAME_SPRITES           1000
+
+// frames per timed loop
+#define BENCHMARK_FRAMES        40
+
+// element set
+#define GFX_ELEMENTS            256
+#define GFX_COLORS              256
+
+// drawing parameters
+#define TRANS_PEN               0
+#define TRANS_MASK              0x8001
+#define ALPHA_LEVEL             0x80
+#define PRIORITY_MASK           0xaa
+
+
+enum
+{
+	VARIANT_OPAQUE,
+	VARIANT_TRANSPEN,
+	VARIANT_TRANSMASK,
+	VARIANT_TRANSTABLE,
+	VARIANT_ALPHA,
+	VARIANT_PRIO_OPAQUE,
+	VARIANT_PRIO_TRANSPEN,
+	VARIANT_PRIO_TRANSTABLE,
+	VARIANT_PRIO_ALPHA,
+	VARIANT_ZOOM_OPAQUE,
+	VARIANT_ZOOM_TRANSPEN,
+	VARIANT_ZOOM_TRANSTABLE,
+	VARIANT_PRIO_ZOOM_TRANSPEN,
+	VARIANT_PRIO_ZOOM_ALPHA,
+	VARIANT_COUNT
+};
+
+static const char *const variant_names[VARIANT_COUNT] =
+{
+	"opaque", "transpen", "transmask", "transtable", "alpha",
+	"prio_opaque", "prio_transpen", "prio_transtable", "prio_alpha",
+	"zoom_opaque", "zoom_transpen", "zoom_transtable",
+	"prio_zoom_transpen", "prio_zoom_alpha"
+};
+
+static bool variant_rgb32_only(int variant)
+{
+	return variant == VARIANT_ALPHA || variant == VARIANT_PRIO_ALPHA || variant == VARIANT_PRIO_ZOOM_ALPHA;
+}
+
+
+struct test_sprite
+{
+	UINT32 code, color;
+	int flipx, flipy;
+	INT32 x, y;
+	UINT32 scalex, scaley;
+};
+
+
+//-------------------------------------------------
+//  test_gfx_element - a gfx element that can
+//  also draw itself with the legacy macros
+//-------------------------------------------------
+
+class test_gfx_element : public gfx_element
+{
+public:
+	test_gfx_element(palette_device &palette, const gfx_layout &gl, const UINT8 *srcdata)
+		: gfx_element(palette, gl, srcdata, 0, GFX_COLORS, 0) { }
+
+	void draw(bitmap_ind16 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable);
+	void draw(bitmap_rgb32 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable);
+	void draw_legacy(bitmap_ind16 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable);
+	void draw_legacy(bitmap_rgb32 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable);
+};
+
+
+//-------------------------------------------------
+//  draw - draw a sprite with one of the
+//  gfx_element functions
+//-------------------------------------------------
+
+void test_gfx_element::draw(bitmap_ind16 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable)
+{
+	const rectangle &clip = dest.cliprect();
+	const test_sprite &s = sprite;
+	switch (variant)
+	{
+		case VARIANT_OPAQUE:            opaque(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y); break;
+		case VARIANT_TRANSPEN:          transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, TRANS_PEN); break;
+		case VARIANT_TRANSMASK:         transmask(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, TRANS_MASK); break;
+		case VARIANT_TRANSTABLE:        transtable(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pentable); break;
+		case VARIANT_PRIO_OPAQUE:       prio_opaque(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pribitmap, PRIORITY_MASK); break;
+		case VARIANT_PRIO_TRANSPEN:     prio_transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pribitmap, PRIORITY_MASK, TRANS_PEN); break;
+		case VARIANT_PRIO_TRANSTABLE:   prio_transtable(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pribitmap, PRIORITY_MASK, pentable); break;
+		case VARIANT_ZOOM_OPAQUE:       zoom_opaque(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley); break;
+		case VARIANT_ZOOM_TRANSPEN:     zoom_transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley, TRANS_PEN); break;
+		case VARIANT_ZOOM_TRANSTABLE:   zoom_transtable(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley, pentable); break;
+		case VARIANT_PRIO_ZOOM_TRANSPEN: prio_zoom_transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley, pribitmap, PRIORITY_MASK, TRANS_PEN); break;
+	}
+}
+
+void test_gfx_element::draw(bitmap_rgb32 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable)
+{
+	const rectangle &clip = dest.cliprect();
+	const test_sprite &s = sprite;
+	switch (variant)
+	{
+		case VARIANT_OPAQUE:            opaque(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y); break;
+		case VARIANT_TRANSPEN:          transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, TRANS_PEN); break;
+		case VARIANT_TRANSMASK:         transmask(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, TRANS_MASK); break;
+		case VARIANT_TRANSTABLE:        transtable(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pentable); break;
+		case VARIANT_ALPHA:             alpha(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, TRANS_PEN, ALPHA_LEVEL); break;
+		case VARIANT_PRIO_OPAQUE:       prio_opaque(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pribitmap, PRIORITY_MASK); break;
+		case VARIANT_PRIO_TRANSPEN:     prio_transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pribitmap, PRIORITY_MASK, TRANS_PEN); break;
+		case VARIANT_PRIO_TRANSTABLE:   prio_transtable(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pribitmap, PRIORITY_MASK, pentable); break;
+		case VARIANT_PRIO_ALPHA:        prio_alpha(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, pribitmap, PRIORITY_MASK, TRANS_PEN, ALPHA_LEVEL); break;
+		case VARIANT_ZOOM_OPAQUE:       zoom_opaque(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley); break;
+		case VARIANT_ZOOM_TRANSPEN:     zoom_transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley, TRANS_PEN); break;
+		case VARIANT_ZOOM_TRANSTABLE:   zoom_transtable(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley, pentable); break;
+		case VARIANT_PRIO_ZOOM_TRANSPEN: prio_zoom_transpen(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley, pribitmap, PRIORITY_MASK, TRANS_PEN); break;
+		case VARIANT_PRIO_ZOOM_ALPHA:   prio_zoom_alpha(dest, clip, s.code, s.color, s.flipx, s.flipy, s.x, s.y, s.scalex, s.scaley, pribitmap, PRIORITY_MASK, TRANS_PEN, ALPHA_LEVEL); break;
+	}
+}
+
+
+//-------------------------------------------------
+//  draw_legacy - draw a sprite with the macros
+//  the matching gfx_element function was built
+//  from; the pen usage shortcuts of the real
+//  functions don't change what gets drawn
+//-------------------------------------------------
+
+void test_gfx_element::draw_legacy(bitmap_ind16 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable)
+{
+	const rectangle &cliprect = dest.cliprect();
+	UINT32 code = sprite.code % elements();
+	UINT32 color = colorbase() + granularity() * (sprite.color % colors());
+	int flipx = sprite.flipx, flipy = sprite.flipy;
+	INT32 destx = sprite.x, desty = sprite.y;
+	UINT32 scalex = sprite.scalex, scaley = sprite.scaley;
+	UINT32 trans_pen = TRANS_PEN, trans_mask = TRANS_MASK;
+	UINT32 pmask = PRIORITY_MASK | (1 << 31);
+	const pen_t *shadowtable = palette().shadow_table();
+
+	switch (variant)
+	{
+		case VARIANT_OPAQUE:            { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY); break; }
+		case VARIANT_TRANSPEN:          { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY); break; }
+		case VARIANT_TRANSMASK:         { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSMASK, NO_PRIORITY); break; }
+		case VARIANT_TRANSTABLE:        { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSTABLE16, NO_PRIORITY); break; }
+		case VARIANT_PRIO_OPAQUE:       { bitmap_ind8 &priority = pribitmap; DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE_PRIORITY, UINT8); break; }
+		case VARIANT_PRIO_TRANSPEN:     { bitmap_ind8 &priority = pribitmap; DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8); break; }
+		case VARIANT_PRIO_TRANSTABLE:   { bitmap_ind8 &priority = pribitmap; DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSTABLE16_PRIORITY, UINT8); break; }
+		case VARIANT_ZOOM_OPAQUE:       { DECLARE_NO_PRIORITY; DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY); break; }
+		case VARIANT_ZOOM_TRANSPEN:     { DECLARE_NO_PRIORITY; DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY); break; }
+		case VARIANT_ZOOM_TRANSTABLE:   { DECLARE_NO_PRIORITY; DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSTABLE16, NO_PRIORITY); break; }
+		case VARIANT_PRIO_ZOOM_TRANSPEN: { bitmap_ind8 &priority = pribitmap; DRAWGFXZOOM_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8); break; }
+	}
+}
+
+void test_gfx_element::draw_legacy(bitmap_rgb32 &dest, int variant, const test_sprite &sprite, bitmap_ind8 &pribitmap, const UINT8 *pentable)
+{
+	const rectangle &cliprect = dest.cliprect();
+	UINT32 code = sprite.code % elements();
+	const pen_t *paldata = palette().pens() + colorbase() + granularity() * (sprite.color % colors());
+	int flipx = sprite.flipx, flipy = sprite.flipy;
+	INT32 destx = sprite.x, desty = sprite.y;
+	UINT32 scalex = sprite.scalex, scaley = sprite.scaley;
+	UINT32 trans_pen = TRANS_PEN, trans_mask = TRANS_MASK;
+	UINT8 alpha_val = ALPHA_LEVEL;
+	UINT32 pmask = PRIORITY_MASK | (1 << 31);
+	const pen_t *shadowtable = palette().shadow_table();
+
+	switch (variant)
+	{
+		case VARIANT_OPAQUE:            { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE, NO_PRIORITY); break; }
+		case VARIANT_TRANSPEN:          { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY); break; }
+		case VARIANT_TRANSMASK:         { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY); break; }
+		case VARIANT_TRANSTABLE:        { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32, NO_PRIORITY); break; }
+		case VARIANT_ALPHA:             { DECLARE_NO_PRIORITY; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY); break; }
+		case VARIANT_PRIO_OPAQUE:       { bitmap_ind8 &priority = pribitmap; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE_PRIORITY, UINT8); break; }
+		case VARIANT_PRIO_TRANSPEN:     { bitmap_ind8 &priority = pribitmap; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8); break; }
+		case VARIANT_PRIO_TRANSTABLE:   { bitmap_ind8 &priority = pribitmap; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32_PRIORITY, UINT8); break; }
+		case VARIANT_PRIO_ALPHA:        { bitmap_ind8 &priority = pribitmap; DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8); break; }
+		case VARIANT_ZOOM_OPAQUE:       { DECLARE_NO_PRIORITY; DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE, NO_PRIORITY); break; }
+		case VARIANT_ZOOM_TRANSPEN:     { DECLARE_NO_PRIORITY; DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY); break; }
+		case VARIANT_ZOOM_TRANSTABLE:   { DECLARE_NO_PRIORITY; DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32, NO_PRIORITY); break; }
+		case VARIANT_PRIO_ZOOM_TRANSPEN: { bitmap_ind8 &priority = pribitmap; DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8); break; }
+		case VARIANT_PRIO_ZOOM_ALPHA:   { bitmap_ind8 &priority = pribitmap; DRAWGFXZOOM_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8); break; }
+	}
+}
+
+
+// 4bpp packed layouts, two pixels per byte
+static const gfx_layout layout_8x8 =
+{
+	8, 8,
+	GFX_ELEMENTS,
+	4,
+	{ 0, 1, 2, 3 },
+	{ STEP8(0, 4) },
+	{ STEP8(0, 8*4) },
+	8*8*4
+};
+
+static const gfx_layout layout_16x16 =
+{
+	16, 16,
+	GFX_ELEMENTS,
+	4,
+	{ 0, 1, 2, 3 },
+	{ STEP16(0, 4) },
+	{ STEP16(0, 16*4) },
+	16*16*4
+};
+
+
+class test_gfx_state : public driver_device
+{
+public:
+	test_gfx_state(const machine_config &mconfig, device_type type, const char *tag)
+		: driver_device(mconfig, type, tag),
+			m_palette(*this, "palette"),
+			m_failures(0) { }
+
+	UINT32 screen_update(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect) { return 0; }
+
+protected:
+	virtual void machine_start() override;
+
+private:
+	void build_frame(const gfx_layout &layout, std::vector<test_sprite> &sprites);
+	void reset_bitmaps(bitmap_ind16 &dest, bitmap_ind8 &priority);
+	void reset_bitmaps(bitmap_rgb32 &dest, bitmap_ind8 &priority);
+	template<class _BitmapType> void draw_frame(test_gfx_element &gfx, _BitmapType &dest, bitmap_ind8 &priority, int variant, bool legacy, const std::vector<test_sprite> &sprites);
+	template<class _BitmapType> void test_variant(test_gfx_element &gfx, int variant, const char *what, const std::vector<test_sprite> &sprites);
+
+	required_device<palette_device> m_palette;
+	UINT8 m_pentable[16];
+	int m_failures;
+	std::string m_json;
+};
+
+
+//-------------------------------------------------
+//  build_frame - place a frame's worth of
+//  sprites, some of them off the edges
+//-------------------------------------------------
+
+void test_gfx_state::build_frame(const gfx_layout &layout, std::vector<test_sprite> &sprites)
+{
+	sprites.resize(FRAME_SPRITES);
+	for (auto &sprite : sprites)
+	{
+		sprite.code = machine().rand() % GFX_ELEMENTS;
+		sprite.color = machine().rand() % GFX_COLORS;
+		sprite.flipx = machine().rand() & 1;
+		sprite.flipy = machine().rand() & 1;
+		sprite.x = int(machine().rand() % (FRAME_WIDTH + 2 * layout.width)) - 2 * layout.width;
+		sprite.y = int(machine().rand() % (FRAME_HEIGHT + 2 * layout.height)) - 2 * layout.height;
+		sprite.scalex = 0x8000 + machine().rand() % 0x18000;
+		sprite.scaley = 0x8000 + machine().rand() % 0x18000;
+	}
+}
+
+
+//-------------------------------------------------
+//  reset_bitmaps - fill the destination and
+//  priority bitmaps with the same pattern before
+//  every frame
+//-------------------------------------------------
+
+void test_gfx_state::reset_bitmaps(bitmap_ind16 &dest, bitmap_ind8 &priority)
+{
+	for (int y = 0; y < FRAME_HEIGHT; y++)
+		for (int x = 0; x < FRAME_WIDTH; x++)
+		{
+			dest.pix16(y, x) = (y * FRAME_WIDTH + x) & 0x0fff;
+			priority.pix8(y, x) = (x ^ y) & 0x87;
+		}
+}
+
+void test_gfx_state::reset_bitmaps(bitmap_rgb32 &dest, bitmap_ind8 &priority)
+{
+	for (int y = 0; y < FRAME_HEIGHT; y++)
+		for (int x = 0; x < FRAME_WIDTH; x++)
+		{
+			dest.pix32(y, x) = (y * FRAME_WIDTH + x) * 0x010203;
+			priority.pix8(y, x) = (x ^ y) & 0x87;
+		}
+}
+
+
+//-------------------------------------------------
+//  draw_frame - draw every sprite of a frame with
+//  one variant
+//-------------------------------------------------
+
+template<class _BitmapType>
+void test_gfx_state::draw_frame(test_gfx_element &gfx, _BitmapType &dest, bitmap_ind8 &priority, int variant, bool legacy, const std::vector<test_sprite> &sprites)
+{
+	for (auto &sprite : sprites)
+	{
+		if (legacy)
+			gfx.draw_legacy(dest, variant, sprite, priority, m_pentable);
+		else
+			gfx.draw(dest, variant, sprite, priority, m_pentable);
+	}
+}
+
+
+//-------------------------------------------------
+//  test_variant - check one variant against the
+//  macros, then time both
+//-------------------------------------------------
+
+template<class _BitmapType>
+void test_gfx_state::test_variant(test_gfx_element &gfx, int variant, const char *what, const std::vector<test_sprite> &sprites)
+{
+	_BitmapType dest(FRAME_WIDTH, FRAME_HEIGHT), expect(FRAME_WIDTH, FRAME_HEIGHT);
+	bitmap_ind8 priority(FRAME_WIDTH, FRAME_HEIGHT), expect_priority(FRAME_WIDTH, FRAME_HEIGHT);
+
+	// compare a frame drawn both ways
+	reset_bitmaps(dest, priority);
+	reset_bitmaps(expect, expect_priority);
+	draw_frame(gfx, dest, priority, variant, false, sprites);
+	draw_frame(gfx, expect, expect_priority, variant, true, sprites);
+	for (int y = 0; y < FRAME_HEIGHT; y++)
+		if (memcmp(&dest.pix(y), &expect.pix(y), FRAME_WIDTH * sizeof(typename _BitmapType::pixel_t)) != 0 ||
+			memcmp(&priority.pix8(y), &expect_priority.pix8(y), FRAME_WIDTH) != 0)
+		{
+			osd_printf_error("%s %s: row %d differs from the legacy macros\n", what, variant_names[variant], y);
+			m_failures++;
+			break;
+		}
+
+	// time both; the bitmaps are left as they are between frames, which
+	// changes nothing about the work done
+	const double us_per_tick = 1e6 / double(osd_ticks_per_second());
+	osd_ticks_t start = osd_ticks();
+	for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
+		draw_frame(gfx, dest, priority, variant, false, sprites);
+	osd_ticks_t ticks = osd_ticks() - start;
+
+	start = osd_ticks();
+	for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
+		draw_frame(gfx, expect, expect_priority, variant, true, sprites);
+	osd_ticks_t legacy_ticks = osd_ticks() - start;
+
+	double us = double(ticks) * us_per_tick / (BENCHMARK_FRAMES * FRAME_SPRITES);
+	double legacy_us = double(legacy_ticks) * us_per_tick / (BENCHMARK_FRAMES * FRAME_SPRITES);
+	osd_printf_info("%-13s %-19s %7.3fus/sprite  legacy %7.3fus/sprite  %5.2fx\n", what, variant_names[variant],
+			us, legacy_us, (ticks != 0) ? double(legacy_ticks) / double(ticks) : 0.0);
+
+	// JSON names are the element size, depth and variant, e.g. 8x8_ind16_transpen
+	std::string name(what);
+	strreplacechr(name, ' ', '_');
+	strcatprintf(m_json, "%s { \"name\": \"%s_%s\", \"unit\": \"sprite\", \"ns\": %.2f }", m_json.empty() ? "" : ",", name.c_str(), variant_names[variant], us * 1000.0);
+	strcatprintf(m_json, ", { \"name\": \"%s_%s_legacy\", \"unit\": \"sprite\", \"ns\": %.2f }", name.c_str(), variant_names[variant], legacy_us * 1000.0);
+}
+
+
+void test_gfx_state::machine_start()
+{
+	// random colors; pens 1 and 2 shadow, pen 0 is transparent
+	for (int pen = 0; pen < m_palette->entries(); pen++)
+		m_palette->set_pen_color(pen, rgb_t(machine().rand(), machine().rand(), machine().rand()));
+	for (int pen = 0; pen < ARRAY_LENGTH(m_pentable); pen++)
+		m_pentable[pen] = (pen == 0) ? DRAWMODE_NONE : (pen <= 2) ? DRAWMODE_SHADOW : DRAWMODE_SOURCE;
+
+	// about a quarter of the pixels are transparent
+	std::vector<UINT8> source(GFX_ELEMENTS * 16 * 16 / 2);
+	for (auto &pixels : source)
+	{
+		UINT8 data = machine().rand();
+		if ((machine().rand() & 3) == 0) data &= 0xf0;
+		if ((machine().rand() & 3) == 0) data &= 0x0f;
+		pixels = data;
+	}
+
+	static const gfx_layout *const layouts[] = { &layout_8x8, &layout_16x16 };
+	for (auto layout : layouts)
+	{
+		test_gfx_element gfx(*m_palette, *layout, &source[0]);
+		std::vector<test_sprite> sprites;
+		build_frame(*layout, sprites);
+
+		std::string ind16 = strformat("%dx%d ind16", layout->width, layout->height);
+		std::string rgb32 = strformat("%dx%d rgb32", layout->width, layout->height);
+		for (int variant = 0; variant < VARIANT_COUNT; variant++)
+		{
+			if (!variant_rgb32_only(variant))
+				test_variant<bitmap_ind16>(gfx, variant, ind16.c_str(), sprites);
+			test_variant<bitmap_rgb32>(gfx, variant, rgb32.c_str(), sprites);
+		}
+	}
+
+	osd_printf_info("{ \"benchmarks\": [%s ] }\n", m_json.c_str());
+	osd_printf_info("drawgfx kernel test, %d failures\n", m_failures);
+	if (m_failures != 0)
+		throw emu_fatalerror("drawgfx kernel test failed");
+
+	machine().schedule_exit();
+}
+
+static MACHINE_CONFIG_START( test_gfx, test_gfx_state )
+	// the palette only builds RGB pens when there is an RGB32 screen
+	MCFG_SCREEN_ADD("screen", RASTER)
+	MCFG_SCREEN_REFRESH_RATE(60)
+	MCFG_SCREEN_SIZE(FRAME_WIDTH, FRAME_HEIGHT)
+	MCFG_SCREEN_VISIBLE_AREA(0, FRAME_WIDTH - 1, 0, FRAME_HEIGHT - 1)
+	MCFG_SCREEN_UPDATE_DRIVER(test_gfx_state, screen_update)
+
+	MCFG_PALETTE_ADD("palette", GFX_COLORS * 16)
+	MCFG_PALETTE_ENABLE_SHADOWS()
+MACHINE_CONFIG_END
+
+ROM_START( testgfx )
+ROM_END
+
+COMP( 2016, testgfx,   0,        0,      test_gfx, 0, driver_device, 0,      "MAMEdev",   "drawgfx kernel test", MACHINE_NO_SOUND_HW )
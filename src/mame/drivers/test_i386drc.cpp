@@ -0,0 +1,1027 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*
+
+    i386 recompiler comparison test
+
+    Two i386 CPUs run the same generated program, one using the
+    recompiler and one forced to use the interpreter.  The program is a
+    long series of short random instruction streams, each followed by a
+    checkpoint that stores the general registers and arithmetic flags.
+    The first half runs with paging off and the second half with paging
+    on, where some memory operands touch pages that a page fault handler
+    maps in on demand.  Once both CPUs have finished, their memory is
+    compared.  Run with -video none; the driver exits once the test has
+    finished and fails if the two CPUs disagree.
+
+    Memory map, identical for both CPUs:
+
+        00001000    GDT
+        00002000    IDT
+        00003000    page directory
+        00004000    page table for the first 4MB
+        00007f00    GDTR and IDTR images
+        00008000    real mode boot code
+        00008100    protected mode entry
+        00008200    page fault handler
+        00008300    handler for any other exception
+        00020000    top of stack
+        00100000    generated instruction streams
+        00200000    data, addressed through ESI
+        00208000    data pages that start out not present
+        00300000    checkpoints
+        003ffff0    set to 1 when the program has finished
+        003ffff4    set if an unexpected exception was taken
+        ffff0000    reset vector
+
+*/
+
+#include "emu.h"
+#include "cpu/i386/i386.h"
+#include "includes/drccomp.h"
+
+// instruction streams to generate; the seed is fixed so that failures
+// can be reproduced
+#define TEST_SEED           1
+#define TEST_CASES          2000
+#define TEST_CASE_LENGTH    24
+
+// memory layout
+#define RAM_SIZE            DRCCOMP_RAM_SIZE
+#define BOOT_SIZE           0x10000
+#define GDT_BASE            0x001000
+#define IDT_BASE            0x002000
+#define PAGE_DIRECTORY      0x003000
+#define PAGE_TABLE          0x004000
+#define DESCRIPTOR_BASE     0x007f00
+#define BOOT_BASE           0x008000
+#define ENTRY_BASE          0x008100
+#define PAGE_FAULT_BASE     0x008200
+#define FAIL_BASE           0x008300
+#define STACK_TOP           0x020000
+#define CODE_BASE           0x100000
+#define CODE_END            0x200000
+#define DATA_BASE           0x200000
+#define DATA_SIZE           0x010000
+#define LAZY_BASE           0x208000
+#define LAZY_PAGES          8
+#define CHECKPOINT_BASE     DRCCOMP_CHECKPOINT_BASE
+#define CHECKPOINT_SIZE     64
+#define DONE_ADDRESS        DRCCOMP_DONE_ADDRESS
+#define FAIL_ADDRESS        DRCCOMP_FAIL_ADDRESS
+
+// EFLAGS bits compared at each checkpoint: CF, PF, AF, ZF, SF and OF
+#define ARITH_FLAGS         0x08d5
+
+// register numbers
+#define REG_EAX     0
+#define REG_ECX     1
+#define REG_EDX     2
+#define REG_EBX     3
+#define REG_ESP     4
+#define REG_EBP     5
+#define REG_ESI     6
+#define REG_EDI     7
+
+// registers stored at each checkpoint, in order
+static const char *const s_regnames[] = { "EAX", "ECX", "EDX", "EBX", "ESP", "EBP", "ESI", "EDI", "EFLAGS" };
+
+class test_i386drc_state : public drc_compare_state
+{
+public:
+	test_i386drc_state(const machine_config &mconfig, device_type type, const char *tag)
+		: drc_compare_state(mconfig, type, tag, "i386", TEST_CASES, CHECKPOINT_SIZE, s_regnames, ARRAY_LENGTH(s_regnames)),
+		m_drc_boot(*this, "drc_boot"),
+		m_interp_boot(*this, "interp_boot") { }
+
+protected:
+	virtual void machine_start() override;
+
+private:
+	// random numbers
+	UINT32 random32();
+	int random(int limit) { return random32() % limit; }
+	UINT32 random_value();
+	int random_dst_reg(int size);
+	int random_src_reg();
+	int random_size();
+
+	// code emission
+	void emit8(UINT8 data) { m_image[m_pc++] = data; }
+	void emit16(UINT16 data) { emit8(data); emit8(data >> 8); }
+	void emit32(UINT32 data) { emit16(data); emit16(data >> 16); }
+	void emit_imm(int size);
+	void emit_operand(int reg, int size, bool dest);
+	void emit_lea_operand(int reg);
+	UINT32 random_offset(int size);
+
+	// program generation
+	void build_program();
+	void emit_simple_insn();
+	void emit_control_insn();
+	void emit_test_case(int index);
+	void emit_checkpoint(int index);
+
+	required_shared_ptr<UINT32> m_drc_boot;
+	required_shared_ptr<UINT32> m_interp_boot;
+
+	UINT32 m_pc;
+	UINT32 m_seed;
+	bool m_paging;
+	bool m_lazy_used;
+};
+
+
+//-------------------------------------------------
+//  random32 - return the next value from a
+//  xorshift generator
+//-------------------------------------------------
+
+UINT32 test_i386drc_state::random32()
+{
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+	return m_seed;
+}
+
+
+//-------------------------------------------------
+//  random_value - return a random operand,
+//  favouring values at the edges of the flags
+//-------------------------------------------------
+
+UINT32 test_i386drc_state::random_value()
+{
+	static const UINT32 s_edges[] = { 0x00000000, 0x00000001, 0x0000007f, 0x00000080, 0x000000ff, 0x00007fff, 0x00008000, 0x0000ffff, 0x7fffffff, 0x80000000, 0xffffffff };
+	if (random(4) == 0)
+		return s_edges[random(ARRAY_LENGTH(s_edges))];
+	return random32();
+}
+
+
+//-------------------------------------------------
+//  random_dst_reg - pick a register that may be
+//  written; ESP and ESI are left alone
+//-------------------------------------------------
+
+int test_i386drc_state::random_dst_reg(int size)
+{
+	static const int s_regs[] = { REG_EAX, REG_ECX, REG_EDX, REG_EBX, REG_EBP, REG_EDI };
+	if (size == 1)
+		return random(8);
+	return s_regs[random(ARRAY_LENGTH(s_regs))];
+}
+
+
+//-------------------------------------------------
+//  random_src_reg - pick a register to read
+//-------------------------------------------------
+
+int test_i386drc_state::random_src_reg()
+{
+	return random(8);
+}
+
+
+//-------------------------------------------------
+//  random_size - pick an operand size, mostly
+//  32 bits
+//-------------------------------------------------
+
+int test_i386drc_state::random_size()
+{
+	int choice = random(8);
+	return (choice == 0) ? 1 : (choice == 1) ? 2 : 4;
+}
+
+
+//-------------------------------------------------
+//  emit_imm - emit a random immediate
+//-------------------------------------------------
+
+void test_i386drc_state::emit_imm(int size)
+{
+	UINT32 value = random_value();
+	if (size == 1)
+		emit8(value);
+	else if (size == 2)
+		emit16(value);
+	else
+		emit32(value);
+}
+
+
+//-------------------------------------------------
+//  random_offset - pick an offset into the data
+//  area for an access of the given size
+//-------------------------------------------------
+
+UINT32 test_i386drc_state::random_offset(int size)
+{
+	UINT32 offset;
+
+	// with paging on, sometimes touch a page that isn't present yet
+	if (m_paging && random(8) == 0)
+	{
+		offset = LAZY_BASE - DATA_BASE + random(LAZY_PAGES * 0x1000 - 4);
+		m_lazy_used = true;
+	}
+	else
+		offset = random(LAZY_BASE - DATA_BASE - 4);
+
+	// mostly aligned, sometimes not
+	if (random(8) != 0)
+		offset &= ~(size - 1);
+	return offset;
+}
+
+
+//-------------------------------------------------
+//  emit_operand - emit a mod r/m byte and any
+//  SIB byte and displacement for a random r/m
+//  operand
+//-------------------------------------------------
+
+void test_i386drc_state::emit_operand(int reg, int size, bool dest)
+{
+	switch (random(5))
+	{
+		case 0:
+		case 1:
+			// register
+			emit8(0xc0 | (reg << 3) | (dest ? random_dst_reg(size) : random_src_reg()));
+			break;
+
+		case 2:
+			// [esi+disp32]
+			emit8(0x80 | (reg << 3) | REG_ESI);
+			emit32(random_offset(size));
+			break;
+
+		case 3:
+			// [esi+disp8]
+			emit8(0x40 | (reg << 3) | REG_ESI);
+			emit8(random(0x80) & ~(size - 1));
+			break;
+
+		case 4:
+			// [disp32], or [esi+disp32] through a SIB byte
+			if (random(2))
+			{
+				emit8(0x05 | (reg << 3));
+				emit32(DATA_BASE + random_offset(size));
+			}
+			else
+			{
+				emit8(0x84 | (reg << 3));
+				emit8(0x20 | REG_ESI);
+				emit32(random_offset(size));
+			}
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_lea_operand - emit a random memory
+//  operand for LEA, which never accesses it
+//-------------------------------------------------
+
+void test_i386drc_state::emit_lea_operand(int reg)
+{
+	int mod = random(3);
+	int rm = random(8);
+	emit8((mod << 6) | (reg << 3) | rm);
+	if (rm == 4)
+	{
+		UINT8 sib = random(256);
+		emit8(sib);
+		if ((sib & 7) == 5 && mod == 0)
+			emit32(random_value());
+	}
+	else if (rm == 5 && mod == 0)
+		emit32(random_value());
+	if (mod == 1)
+		emit8(random(256));
+	else if (mod == 2)
+		emit32(random_value());
+}
+
+
+//-------------------------------------------------
+//  emit_simple_insn - emit a random instruction
+//  that doesn't branch
+//-------------------------------------------------
+
+void test_i386drc_state::emit_simple_insn()
+{
+	int size = random_size();
+	int wide = (size == 1) ? 0 : 1;
+
+	switch (random(20))
+	{
+		case 0:
+		case 1:
+		case 2:
+		{
+			// ALU operations in all forms
+			int aluop = random(8);
+			if (size == 2)
+				emit8(0x66);
+			switch (random(4))
+			{
+				case 0:
+					emit8((aluop << 3) | wide);
+					emit_operand(random_src_reg(), size, true);
+					break;
+
+				case 1:
+					emit8((aluop << 3) | 2 | wide);
+					emit_operand(random_dst_reg(size), size, false);
+					break;
+
+				case 2:
+					if (size != 1 && random(2))
+					{
+						emit8(0x83);
+						emit_operand(aluop, size, true);
+						emit8(random_value());
+					}
+					else
+					{
+						emit8(0x80 | wide);
+						emit_operand(aluop, size, true);
+						emit_imm(size);
+					}
+					break;
+
+				case 3:
+					emit8((aluop << 3) | 4 | wide);
+					emit_imm(size);
+					break;
+			}
+			break;
+		}
+
+		case 3:
+			// TEST
+			if (size == 2)
+				emit8(0x66);
+			switch (random(3))
+			{
+				case 0:
+					emit8(0x84 | wide);
+					emit_operand(random_src_reg(), size, false);
+					break;
+
+				case 1:
+					emit8(0xa8 | wide);
+					emit_imm(size);
+					break;
+
+				case 2:
+					emit8(0xf6 | wide);
+					emit_operand(0, size, false);
+					emit_imm(size);
+					break;
+			}
+			break;
+
+		case 4:
+			// INC/DEC
+			if (size == 1)
+			{
+				emit8(0xfe);
+				emit_operand(random(2), 1, true);
+			}
+			else
+			{
+				if (size == 2)
+					emit8(0x66);
+				if (random(2))
+					emit8(0x40 | (random(2) << 3) | random_dst_reg(size));
+				else
+				{
+					emit8(0xff);
+					emit_operand(random(2), size, true);
+				}
+			}
+			break;
+
+		case 5:
+		case 6:
+			// MOV
+			if (size == 2)
+				emit8(0x66);
+			switch (random(6))
+			{
+				case 0:
+					emit8(0x88 | wide);
+					emit_operand(random_src_reg(), size, true);
+					break;
+
+				case 1:
+					emit8(0x8a | wide);
+					emit_operand(random_dst_reg(size), size, false);
+					break;
+
+				case 2:
+					emit8(0xc6 | wide);
+					emit_operand(0, size, true);
+					emit_imm(size);
+					break;
+
+				case 3:
+					emit8(0xb0 | (wide << 3) | random_dst_reg(size));
+					emit_imm(size);
+					break;
+
+				case 4:
+				case 5:
+					emit8(0xa0 | (random(2) << 1) | wide);
+					emit32(DATA_BASE + random_offset(size));
+					break;
+			}
+			break;
+
+		case 7:
+			// MOVZX/MOVSX
+			emit8(0x0f);
+			emit8(0xb6 | (random(2) << 3) | random(2));
+			emit_operand(random_dst_reg(4), 2, false);
+			break;
+
+		case 8:
+			// LEA
+			emit8(0x8d);
+			emit_lea_operand(random_dst_reg(4));
+			break;
+
+		case 9:
+			// XCHG
+			if (size == 2)
+				emit8(0x66);
+			if (size != 1 && random(2))
+				emit8(0x90 | random_dst_reg(size));
+			else
+			{
+				emit8(0x86 | wide);
+				emit_operand(random_dst_reg(size), size, true);
+			}
+			break;
+
+		case 10:
+		case 11:
+		{
+			// shifts; SHL, SHR and SAR by a constant are compiled, the rest are interpreted
+			static const int s_shiftops[] = { 4, 5, 7, 4, 5, 7, 0, 1, 2, 3, 6 };
+			int shiftop = s_shiftops[random(ARRAY_LENGTH(s_shiftops))];
+			if (size == 2)
+				emit8(0x66);
+			switch (random(4))
+			{
+				case 0:
+				case 1:
+					emit8(0xc0 | wide);
+					emit_operand(shiftop, size, true);
+					emit8((random(8) == 0) ? random(256) : random(32));
+					break;
+
+				case 2:
+					emit8(0xd0 | wide);
+					emit_operand(shiftop, size, true);
+					break;
+
+				case 3:
+					emit8(0xd2 | wide);
+					emit_operand(shiftop, size, true);
+					break;
+			}
+			break;
+		}
+
+		case 12:
+			// IMUL
+			switch (random(3))
+			{
+				case 0:
+					emit8(0x0f);
+					emit8(0xaf);
+					emit_operand(random_dst_reg(4), 4, false);
+					break;
+
+				case 1:
+					emit8(0x69);
+					emit_operand(random_dst_reg(4), 4, false);
+					emit_imm(4);
+					break;
+
+				case 2:
+					emit8(0x6b);
+					emit_operand(random_dst_reg(4), 4, false);
+					emit_imm(1);
+					break;
+			}
+			break;
+
+		case 13:
+			// SETcc
+			emit8(0x0f);
+			emit8(0x90 | random(16));
+			emit_operand(0, 1, true);
+			break;
+
+		case 14:
+			// CWDE, CDQ, NOT, NEG
+			switch (random(4))
+			{
+				case 0:
+					emit8(0x98);
+					break;
+
+				case 1:
+					emit8(0x99);
+					break;
+
+				case 2:
+				case 3:
+					if (size == 2)
+						emit8(0x66);
+					emit8(0xf6 | wide);
+					emit_operand(random(2) + 2, size, true);
+					break;
+			}
+			break;
+
+		case 15:
+		case 16:
+			// stack operations, balanced
+			switch (random(4))
+			{
+				case 0:
+					emit8(0x50 | random_src_reg());
+					emit8(0x58 | random_dst_reg(4));
+					break;
+
+				case 1:
+					if (random(2))
+					{
+						emit8(0x68);
+						emit_imm(4);
+					}
+					else
+					{
+						emit8(0x6a);
+						emit_imm(1);
+					}
+					emit8(0x58 | random_dst_reg(4));
+					break;
+
+				case 2:
+					emit8(0xff);
+					emit_operand(6, 4, false);
+					emit8(0x8f);
+					emit_operand(0, 4, true);
+					break;
+
+				case 3:
+					// PUSHFD is interpreted, which hands the flags over mid-stream
+					emit8(0x9c);
+					emit8(0x58 | random_dst_reg(4));
+					break;
+			}
+			break;
+
+		case 17:
+			// flag instructions and others that are left to the interpreter
+			switch (random(6))
+			{
+				case 0:
+				{
+					static const UINT8 s_flagops[] = { 0xf5, 0xf8, 0xf9 };
+					emit8(s_flagops[random(3)]);                // CMC, CLC, STC
+					break;
+				}
+
+				case 1:
+					emit8(0x9f);                                // LAHF
+					break;
+
+				case 2:
+					emit8(0x9e);                                // SAHF
+					break;
+
+				case 3:
+					emit8(0x0f);                                // BT reg,reg
+					emit8(0xa3);
+					emit8(0xc0 | (random_src_reg() << 3) | random_src_reg());
+					break;
+
+				case 4:
+					emit8(0x0f);                                // BSF/BSR
+					emit8(0xbc | random(2));
+					emit8(0xc0 | (random_dst_reg(4) << 3) | random_src_reg());
+					break;
+
+				case 5:
+					emit8(0x12 | wide);                         // ADC reg,r/m
+					emit_operand(random_dst_reg(size), size, false);
+					break;
+			}
+			break;
+
+		default:
+			// NOP
+			emit8(0x90);
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_control_insn - emit a random branch
+//  along with whatever it needs to terminate
+//-------------------------------------------------
+
+void test_i386drc_state::emit_control_insn()
+{
+	UINT32 patch;
+
+	switch (random(9))
+	{
+		case 0:
+		case 1:
+			// Jcc rel8 over the next instruction
+			patch = m_pc;
+			m_pc += 2;
+			emit_simple_insn();
+			m_image[patch] = 0x70 | random(16);
+			m_image[patch + 1] = m_pc - (patch + 2);
+			break;
+
+		case 2:
+			// Jcc rel32 over the next instruction
+			patch = m_pc;
+			m_pc += 6;
+			emit_simple_insn();
+			m_image[patch] = 0x0f;
+			m_image[patch + 1] = 0x80 | random(16);
+			m_image[patch + 2] = m_pc - (patch + 6);
+			break;
+
+		case 3:
+			// CALL rel32 to a subroutine that follows, with RET or RET imm16
+		{
+			bool retimm = random(2);
+			if (retimm)
+			{
+				emit8(0x6a);
+				emit_imm(1);
+			}
+			emit8(0xe8);
+			emit32(2);
+			patch = m_pc;
+			m_pc += 2;
+			emit_simple_insn();
+			if (retimm)
+			{
+				emit8(0xc2);
+				emit16(4);
+			}
+			else
+				emit8(0xc3);
+			m_image[patch] = 0xeb;
+			m_image[patch + 1] = m_pc - (patch + 2);
+			break;
+		}
+
+		case 4:
+			// CALL reg to a subroutine that follows
+		{
+			emit8(0xb8 | REG_EDI);
+			UINT32 target = m_pc;
+			m_pc += 4;
+			emit8(0xff);
+			emit8(0xd0 | REG_EDI);
+			patch = m_pc;
+			m_pc += 2;
+			UINT32 sub = m_pc;
+			emit_simple_insn();
+			emit8(0xc3);
+			m_image[patch] = 0xeb;
+			m_image[patch + 1] = m_pc - (patch + 2);
+			for (int byte = 0; byte < 4; byte++)
+				m_image[target + byte] = sub >> (8 * byte);
+			break;
+		}
+
+		case 5:
+			// JMP or CALL through memory
+		{
+			bool call = random(2);
+			UINT32 offset = random_offset(4) & ~3;
+			emit8(0xc7);
+			emit8(0x80 | REG_ESI);
+			emit32(offset);
+			UINT32 target = m_pc;
+			m_pc += 4;
+			emit8(0xff);
+			emit8(0x80 | ((call ? 2 : 4) << 3) | REG_ESI);
+			emit32(offset);
+			if (call)
+			{
+				patch = m_pc;
+				m_pc += 2;
+				UINT32 sub = m_pc;
+				emit_simple_insn();
+				emit8(0xc3);
+				m_image[patch] = 0xeb;
+				m_image[patch + 1] = m_pc - (patch + 2);
+				for (int byte = 0; byte < 4; byte++)
+					m_image[target + byte] = sub >> (8 * byte);
+			}
+			else
+			{
+				emit_simple_insn();
+				for (int byte = 0; byte < 4; byte++)
+					m_image[target + byte] = m_pc >> (8 * byte);
+			}
+			break;
+		}
+
+		case 6:
+			// a short counted loop
+		{
+			emit8(0xb8 | REG_ECX);
+			emit32(1 + random(4));
+			UINT32 top = m_pc;
+			emit8(0x83);
+			emit8(0xc0 | REG_EDI);
+			emit_imm(1);
+			emit8(0xe2);
+			emit8(top - (m_pc + 1));
+			break;
+		}
+
+		case 7:
+			// JECXZ over the next instruction
+			patch = m_pc;
+			m_pc += 2;
+			emit_simple_insn();
+			m_image[patch] = 0xe3;
+			m_image[patch + 1] = m_pc - (patch + 2);
+			break;
+
+		case 8:
+			// a stack frame torn down by LEAVE
+			emit8(0x50 | REG_EBP);
+			emit8(0x89);
+			emit8(0xc0 | (REG_ESP << 3) | REG_EBP);
+			emit8(0x6a);
+			emit_imm(1);
+			emit8(0x68);
+			emit_imm(4);
+			emit8(0xc9);
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_checkpoint - store the registers and
+//  flags where they can be compared
+//-------------------------------------------------
+
+void test_i386drc_state::emit_checkpoint(int index)
+{
+	UINT32 base = CHECKPOINT_BASE + index * CHECKPOINT_SIZE;
+
+	// mov [base+4*reg],reg
+	emit8(0xa3);
+	emit32(base);
+	for (int reg = 1; reg < 8; reg++)
+	{
+		emit8(0x89);
+		emit8(0x05 | (reg << 3));
+		emit32(base + 4 * reg);
+	}
+
+	// pushfd; pop eax; and eax,ARITH_FLAGS; mov [base+32],eax
+	emit8(0x9c);
+	emit8(0x58 | REG_EAX);
+	emit8(0x25);
+	emit32(ARITH_FLAGS);
+	emit8(0xa3);
+	emit32(base + 32);
+}
+
+
+//-------------------------------------------------
+//  emit_test_case - emit one instruction stream
+//  and its checkpoint
+//-------------------------------------------------
+
+void test_i386drc_state::emit_test_case(int index)
+{
+	m_case_pc.push_back(m_pc);
+	m_lazy_used = false;
+
+	// start from random flags and registers
+	emit8(0x68);
+	emit32((random32() & ARITH_FLAGS) | 0x02);
+	emit8(0x9d);
+	for (int reg = 0; reg < 8; reg++)
+		if (reg != REG_ESP && reg != REG_ESI)
+		{
+			emit8(0xb8 | reg);
+			emit32(random_value());
+		}
+
+	for (int insn = 0; insn < TEST_CASE_LENGTH; insn++)
+	{
+		if (random(6) == 0)
+			emit_control_insn();
+		else
+			emit_simple_insn();
+	}
+	emit_checkpoint(index);
+
+	// unmap any pages the fault handler mapped in, and flush the TLB
+	if (m_lazy_used)
+	{
+		for (int page = 0; page < LAZY_PAGES; page++)
+		{
+			emit8(0x81);
+			emit8(0x25);
+			emit32(PAGE_TABLE + ((LAZY_BASE >> 12) + page) * 4);
+			emit32(~1);
+		}
+		emit8(0x0f); emit8(0x20); emit8(0xd8);
+		emit8(0x0f); emit8(0x22); emit8(0xd8);
+	}
+
+	if (m_pc > CODE_END - 0x1000)
+		fatalerror("testi386drc: generated program is too large\n");
+}
+
+
+//-------------------------------------------------
+//  build_program - generate the whole program
+//-------------------------------------------------
+
+void test_i386drc_state::build_program()
+{
+	m_image.assign(RAM_SIZE + BOOT_SIZE, 0);
+	m_seed = TEST_SEED;
+	m_paging = false;
+
+	// GDT: null, flat code and flat data
+	static const UINT8 s_gdt[] =
+	{
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xff, 0xff, 0x00, 0x00, 0x00, 0x9a, 0xcf, 0x00,
+		0xff, 0xff, 0x00, 0x00, 0x00, 0x92, 0xcf, 0x00
+	};
+	memcpy(&m_image[GDT_BASE], s_gdt, sizeof(s_gdt));
+
+	// IDT: the page fault handler, and the failure handler for everything else
+	for (int vector = 0; vector < 32; vector++)
+	{
+		UINT32 handler = (vector == 14) ? PAGE_FAULT_BASE : FAIL_BASE;
+		m_pc = IDT_BASE + vector * 8;
+		emit16(handler);
+		emit16(0x08);
+		emit8(0x00);
+		emit8(0x8e);
+		emit16(handler >> 16);
+	}
+
+	// page directory and table, identity mapping the first 4MB
+	m_pc = PAGE_DIRECTORY;
+	emit32(PAGE_TABLE | 3);
+	m_pc = PAGE_TABLE;
+	for (int page = 0; page < 1024; page++)
+		emit32((page << 12) | ((page >= (LAZY_BASE >> 12) && page < (LAZY_BASE >> 12) + LAZY_PAGES) ? 2 : 3));
+
+	// GDTR and IDTR
+	m_pc = DESCRIPTOR_BASE;
+	emit16(sizeof(s_gdt) - 1);
+	emit32(GDT_BASE);
+	m_pc = DESCRIPTOR_BASE + 8;
+	emit16(32 * 8 - 1);
+	emit32(IDT_BASE);
+
+	// reset vector: jmp 0000:BOOT_BASE
+	m_pc = RAM_SIZE + 0xfff0;
+	emit8(0xea);
+	emit16(BOOT_BASE);
+	emit16(0x0000);
+
+	// real mode: load the descriptor tables and enter protected mode
+	m_pc = BOOT_BASE;
+	emit8(0xfa);                                                        // cli
+	emit8(0x0f); emit8(0x01); emit8(0x16); emit16(DESCRIPTOR_BASE);     // lgdt [DESCRIPTOR_BASE]
+	emit8(0x0f); emit8(0x01); emit8(0x1e); emit16(DESCRIPTOR_BASE + 8); // lidt [DESCRIPTOR_BASE+8]
+	emit8(0x0f); emit8(0x20); emit8(0xc0);                              // mov eax,cr0
+	emit8(0x0c); emit8(0x01);                                           // or al,1
+	emit8(0x0f); emit8(0x22); emit8(0xc0);                              // mov cr0,eax
+	emit8(0x66); emit8(0xea); emit32(ENTRY_BASE); emit16(0x08);         // jmp 08:ENTRY_BASE
+
+	// protected mode: flat segments, stack and data pointer
+	m_pc = ENTRY_BASE;
+	emit8(0x66); emit8(0xb8); emit16(0x10);                             // mov ax,10h
+	emit8(0x8e); emit8(0xd8);                                           // mov ds,ax
+	emit8(0x8e); emit8(0xc0);                                           // mov es,ax
+	emit8(0x8e); emit8(0xd0);                                           // mov ss,ax
+	emit8(0x8e); emit8(0xe0);                                           // mov fs,ax
+	emit8(0x8e); emit8(0xe8);                                           // mov gs,ax
+	emit8(0xbc); emit32(STACK_TOP);                                     // mov esp,STACK_TOP
+	emit8(0xbe); emit32(DATA_BASE);                                     // mov esi,DATA_BASE
+	emit8(0xe9); emit32(CODE_BASE - (m_pc + 4));                        // jmp CODE_BASE
+
+	// page fault handler: mark the page present and retry
+	m_pc = PAGE_FAULT_BASE;
+	emit8(0x50);                                                        // push eax
+	emit8(0x0f); emit8(0x20); emit8(0xd0);                              // mov eax,cr2
+	emit8(0xc1); emit8(0xe8); emit8(0x0c);                              // shr eax,12
+	emit8(0x83); emit8(0x0c); emit8(0x85); emit32(PAGE_TABLE); emit8(0x01);
+																		// or dword [PAGE_TABLE+eax*4],1
+	emit8(0x0f); emit8(0x20); emit8(0xd8);                              // mov eax,cr3
+	emit8(0x0f); emit8(0x22); emit8(0xd8);                              // mov cr3,eax
+	emit8(0x58);                                                        // pop eax
+	emit8(0x83); emit8(0xc4); emit8(0x04);                              // add esp,4
+	emit8(0xcf);                                                        // iretd
+
+	// any other exception is a failure
+	m_pc = FAIL_BASE;
+	emit8(0xc7); emit8(0x05); emit32(FAIL_ADDRESS); emit32(0xdeadbeef); // mov dword [FAIL_ADDRESS],0deadbeefh
+	emit8(0xc7); emit8(0x05); emit32(DONE_ADDRESS); emit32(1);          // mov dword [DONE_ADDRESS],1
+	emit8(0xf4);                                                        // hlt
+	emit8(0xeb); emit8(0xfd);                                           // jmp $-1
+
+	// random data
+	for (int offs = 0; offs < DATA_SIZE; offs++)
+		m_image[DATA_BASE + offs] = random(256);
+
+	// the test cases, with paging turned on halfway through
+	m_pc = CODE_BASE;
+	for (int index = 0; index < TEST_CASES; index++)
+	{
+		if (index == TEST_CASES / 2)
+		{
+			emit8(0xb8); emit32(PAGE_DIRECTORY);                        // mov eax,PAGE_DIRECTORY
+			emit8(0x0f); emit8(0x22); emit8(0xd8);                      // mov cr3,eax
+			emit8(0x0f); emit8(0x20); emit8(0xc0);                      // mov eax,cr0
+			emit8(0x0d); emit32(0x80000000);                            // or eax,80000000h
+			emit8(0x0f); emit8(0x22); emit8(0xc0);                      // mov cr0,eax
+			emit8(0xeb); emit8(0x00);                                   // jmp $+2
+			m_paging = true;
+		}
+		emit_test_case(index);
+	}
+
+	// done
+	emit8(0xc7); emit8(0x05); emit32(DONE_ADDRESS); emit32(1);          // mov dword [DONE_ADDRESS],1
+	emit8(0xf4);                                                        // hlt
+	emit8(0xeb); emit8(0xfd);                                           // jmp $-1
+}
+
+
+void test_i386drc_state::machine_start()
+{
+	build_program();
+
+	// the boot area at the top of the address space follows the RAM image
+	for (offs_t offs = 0; offs < BOOT_SIZE / 4; offs++)
+	{
+		const UINT8 *src = &m_image[RAM_SIZE + offs * 4];
+		m_drc_boot[offs] = m_interp_boot[offs] = src[0] | (src[1] << 8) | (src[2] << 16) | (src[3] << 24);
+	}
+	start_comparison();
+}
+
+static ADDRESS_MAP_START( drc_map, AS_PROGRAM, 32, test_i386drc_state )
+	AM_RANGE(0x00000000, 0x003fffff) AM_RAM
+	AM_RANGE(0xffff0000, 0xffffffff) AM_RAM AM_SHARE("drc_boot")
+ADDRESS_MAP_END
+
+static ADDRESS_MAP_START( interp_map, AS_PROGRAM, 32, test_i386drc_state )
+	AM_RANGE(0x00000000, 0x003fffff) AM_RAM
+	AM_RANGE(0xffff0000, 0xffffffff) AM_RAM AM_SHARE("interp_boot")
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( test_i386drc, test_i386drc_state )
+	MCFG_CPU_ADD("drc", I386, 16000000)
+	MCFG_CPU_PROGRAM_MAP(drc_map)
+	MCFG_I386_ALLOW_RECOMPILER()
+
+	MCFG_CPU_ADD("interp", I386, 16000000)
+	MCFG_CPU_PROGRAM_MAP(interp_map)
+	MCFG_I386_FORCE_INTERPRETER()
+MACHINE_CONFIG_END
+
+ROM_START( testi386 )
+ROM_END
+
+COMP( 2016, testi386,  0,        0,      test_i386drc, 0, driver_device, 0,      "MAMEdev",   "i386 recompiler comparison test", MACHINE_NO_SOUND_HW )
@@ -0,0 +1,798 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*
+
+    68020 recompiler comparison test
+
+    Two 68020 CPUs run the same generated program, one using the
+    recompiler and one forced to use the interpreter.  The program is a
+    long series of short random instruction streams, each followed by a
+    checkpoint that stores all of the registers and the status register.
+    The streams mix the instructions the recompiler handles with a few
+    it hands back to the interpreter, and use every addressing mode the
+    front-end decodes, including misaligned accesses.  Once both CPUs
+    have finished, their memory is compared.  Run with -video none; the
+    driver exits once the test has finished and fails if the two CPUs
+    disagree.
+
+    Memory map, identical for both CPUs:
+
+        00000000    exception vectors
+        00001000    handler for any exception
+        00004000    data, addressed through absolute short addresses
+        00020000    top of stack
+        00100000    generated instruction streams
+        00200000    data, addressed through A0, A2 and A5
+        00300000    checkpoints
+        003ffff0    set to 1 when the program has finished
+        003ffff4    set if an exception was taken
+
+    Register use within the instruction streams:
+
+        D0-D7       random values, freely written
+        A0          data pointer, used with postincrement
+        A1          small index, never written
+        A2          data pointer, used with predecrement
+        A3-A4       random values, freely written
+        A5          middle of the data area, never written
+        A6          frame pointer for LINK and UNLK
+        A7          stack pointer
+
+*/
+
+#include "emu.h"
+#include "cpu/m68000/m68000.h"
+#include "includes/drccomp.h"
+
+// instruction streams to generate; the seed is fixed so that failures
+// can be reproduced
+#define TEST_SEED           1
+#define TEST_CASES          2000
+#define TEST_CASE_LENGTH    24
+
+// memory layout
+#define RAM_SIZE            DRCCOMP_RAM_SIZE
+#define FAIL_BASE           0x001000
+#define ABSW_BASE           0x004000
+#define ABSW_SIZE           0x004000
+#define STACK_TOP           0x020000
+#define CODE_BASE           0x100000
+#define CODE_END            0x200000
+#define DATA_BASE           0x200000
+#define DATA_SIZE           0x010000
+#define CHECKPOINT_BASE     DRCCOMP_CHECKPOINT_BASE
+#define CHECKPOINT_SIZE     80
+#define DONE_ADDRESS        DRCCOMP_DONE_ADDRESS
+#define FAIL_ADDRESS        DRCCOMP_FAIL_ADDRESS
+
+// effective address modes
+#define EA_D(reg)           (0x00 | (reg))
+#define EA_A(reg)           (0x08 | (reg))
+#define EA_AI(reg)          (0x10 | (reg))
+#define EA_PI(reg)          (0x18 | (reg))
+#define EA_PD(reg)          (0x20 | (reg))
+#define EA_DI(reg)          (0x28 | (reg))
+#define EA_IX(reg)          (0x30 | (reg))
+#define EA_AW               0x38
+#define EA_AL               0x39
+#define EA_PCDI             0x3a
+#define EA_PCIX             0x3b
+#define EA_I                0x3c
+
+// registers stored at each checkpoint, in order
+static const char *const s_regnames[] = { "D0", "D1", "D2", "D3", "D4", "D5", "D6", "D7", "A0", "A1", "A2", "A3", "A4", "A5", "A6", "A7", "SR" };
+
+class test_m68kdrc_state : public drc_compare_state
+{
+public:
+	test_m68kdrc_state(const machine_config &mconfig, device_type type, const char *tag)
+		: drc_compare_state(mconfig, type, tag, "68020", TEST_CASES, CHECKPOINT_SIZE, s_regnames, ARRAY_LENGTH(s_regnames)) { }
+
+protected:
+	virtual void machine_start() override;
+
+private:
+	// an effective address and its extension words
+	struct operand
+	{
+		UINT8 field;
+		int count;
+		UINT16 ext[2];
+	};
+
+	// random numbers
+	UINT32 random32();
+	int random(int limit) { return random32() % limit; }
+	UINT32 random_value();
+	int random_size();
+	int random_dst_areg() { return 3 + random(2); }
+	UINT16 random_reglist();
+
+	// code emission
+	void emit16(UINT16 data) { m_image[m_pc++] = data >> 8; m_image[m_pc++] = data; }
+	void emit32(UINT32 data) { emit16(data >> 16); emit16(data); }
+	void emit_operand(const operand &op);
+	void patch16(UINT32 address, UINT16 data) { m_image[address] = data >> 8; m_image[address + 1] = data; }
+
+	// operand generation
+	void make_operand(operand &op, UINT8 field) { op.field = field; op.count = 0; }
+	void make_memory_operand(operand &op, int size, bool control);
+	void make_dst_operand(operand &op, int size);
+	void make_src_operand(operand &op, int size, bool areg);
+
+	// program generation
+	void build_program();
+	void emit_simple_insn();
+	void emit_control_insn();
+	void emit_test_case(int index);
+	void emit_checkpoint(int index);
+
+
+	UINT32 m_pc;
+	UINT32 m_seed;
+};
+
+
+//-------------------------------------------------
+//  random32 - return the next value from a
+//  xorshift generator
+//-------------------------------------------------
+
+UINT32 test_m68kdrc_state::random32()
+{
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+	return m_seed;
+}
+
+
+//-------------------------------------------------
+//  random_value - return a random operand,
+//  favouring values at the edges of the flags
+//-------------------------------------------------
+
+UINT32 test_m68kdrc_state::random_value()
+{
+	static const UINT32 s_edges[] = { 0x00000000, 0x00000001, 0x0000007f, 0x00000080, 0x000000ff, 0x00007fff, 0x00008000, 0x0000ffff, 0x7fffffff, 0x80000000, 0xffffffff };
+	if (random(4) == 0)
+		return s_edges[random(ARRAY_LENGTH(s_edges))];
+	return random32();
+}
+
+
+//-------------------------------------------------
+//  random_size - pick an operand size in bytes
+//-------------------------------------------------
+
+int test_m68kdrc_state::random_size()
+{
+	static const int s_sizes[] = { 1, 2, 4 };
+	return s_sizes[random(3)];
+}
+
+
+//-------------------------------------------------
+//  random_reglist - pick a MOVEM register list
+//  from the registers that may be written, in
+//  the normal D0-A7 order
+//-------------------------------------------------
+
+UINT16 test_m68kdrc_state::random_reglist()
+{
+	UINT16 reglist;
+	do
+		reglist = random32() & 0x18ff;
+	while (reglist == 0);
+	return reglist;
+}
+
+
+//-------------------------------------------------
+//  emit_operand - emit the extension words of
+//  an operand
+//-------------------------------------------------
+
+void test_m68kdrc_state::emit_operand(const operand &op)
+{
+	for (int word = 0; word < op.count; word++)
+		emit16(op.ext[word]);
+}
+
+
+//-------------------------------------------------
+//  make_memory_operand - pick a random memory
+//  operand that can be written, or one that can
+//  be used with LEA and friends if control is
+//  set
+//-------------------------------------------------
+
+void test_m68kdrc_state::make_memory_operand(operand &op, int size, bool control)
+{
+	switch (random(control ? 5 : 7))
+	{
+		case 0:
+			make_operand(op, EA_AI(5));
+			break;
+
+		case 1:
+			make_operand(op, EA_DI(5));
+			op.ext[op.count++] = random32();
+			break;
+
+		case 2:
+			// brief format index through A1, scaled, or a data register as a word
+			make_operand(op, EA_IX(5));
+			if (random(2))
+				op.ext[op.count++] = 0x9800 | (random(4) << 9) | random(0x80);
+			else
+				op.ext[op.count++] = (random(8) << 12) | (random32() & 0xff);
+			break;
+
+		case 3:
+			make_operand(op, EA_AW);
+			op.ext[op.count++] = ABSW_BASE + random(ABSW_SIZE - 4);
+			break;
+
+		case 4:
+		{
+			UINT32 address = DATA_BASE + random(DATA_SIZE - 4);
+			make_operand(op, EA_AL);
+			op.ext[op.count++] = address >> 16;
+			op.ext[op.count++] = address;
+			break;
+		}
+
+		case 5:
+			make_operand(op, EA_PI(0));
+			break;
+
+		case 6:
+			make_operand(op, EA_PD(2));
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  make_dst_operand - pick a data register or a
+//  writable memory operand
+//-------------------------------------------------
+
+void test_m68kdrc_state::make_dst_operand(operand &op, int size)
+{
+	if (random(3) == 0)
+		make_operand(op, EA_D(random(8)));
+	else
+		make_memory_operand(op, size, false);
+}
+
+
+//-------------------------------------------------
+//  make_src_operand - pick any readable operand;
+//  address registers only if areg is set and the
+//  size isn't a byte
+//-------------------------------------------------
+
+void test_m68kdrc_state::make_src_operand(operand &op, int size, bool areg)
+{
+	switch (random(8))
+	{
+		case 0:
+		case 1:
+			make_operand(op, EA_D(random(8)));
+			break;
+
+		case 2:
+			if (areg && size != 1)
+				make_operand(op, EA_A(random(8)));
+			else
+				make_operand(op, EA_D(random(8)));
+			break;
+
+		case 3:
+		{
+			UINT32 value = random_value();
+			make_operand(op, EA_I);
+			if (size == 4)
+				op.ext[op.count++] = value >> 16;
+			op.ext[op.count++] = (size == 1) ? (value & 0xff) : value;
+			break;
+		}
+
+		// reads through the PC stay within the code already emitted
+		case 4:
+			make_operand(op, EA_PCDI);
+			op.ext[op.count++] = -random(0x100);
+			break;
+
+		default:
+			make_memory_operand(op, size, false);
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_simple_insn - emit a random instruction
+//  that doesn't branch
+//-------------------------------------------------
+
+void test_m68kdrc_state::emit_simple_insn()
+{
+	static const UINT16 s_movesize[] = { 0, 0x1000, 0x3000, 0, 0x2000 };
+	int size = random_size();
+	int sizefield = (size == 1) ? 0x00 : (size == 2) ? 0x40 : 0x80;
+	operand src, dst;
+
+	switch (random(24))
+	{
+		case 0:
+		case 1:
+		case 2:
+			// MOVE in all forms
+			make_src_operand(src, size, true);
+			make_dst_operand(dst, size);
+			emit16(s_movesize[size] | ((dst.field & 7) << 9) | ((dst.field & 0x38) << 3) | src.field);
+			emit_operand(src);
+			emit_operand(dst);
+			break;
+
+		case 3:
+			// MOVEA
+			size = random(2) ? 2 : 4;
+			make_src_operand(src, size, true);
+			emit16(s_movesize[size] | (random_dst_areg() << 9) | 0x0040 | src.field);
+			emit_operand(src);
+			break;
+
+		case 4:
+			// MOVEQ
+			emit16(0x7000 | (random(8) << 9) | (random_value() & 0xff));
+			break;
+
+		case 5:
+		case 6:
+		{
+			// ADD, SUB, AND, OR and CMP from an operand to a data register
+			static const UINT16 s_ops[] = { 0xd000, 0x9000, 0xc000, 0x8000, 0xb000 };
+			int op = random(ARRAY_LENGTH(s_ops));
+			make_src_operand(src, size, op < 2 || op == 4);
+			emit16(s_ops[op] | (random(8) << 9) | sizefield | src.field);
+			emit_operand(src);
+			break;
+		}
+
+		case 7:
+		{
+			// ADD, SUB, AND, OR and EOR from a data register to memory; EOR also to a register
+			static const UINT16 s_ops[] = { 0xd100, 0x9100, 0xc100, 0x8100, 0xb100 };
+			int op = random(ARRAY_LENGTH(s_ops));
+			if (op == 4)
+				make_dst_operand(dst, size);
+			else
+				make_memory_operand(dst, size, false);
+			emit16(s_ops[op] | (random(8) << 9) | sizefield | dst.field);
+			emit_operand(dst);
+			break;
+		}
+
+		case 8:
+		case 9:
+		{
+			// ORI, ANDI, SUBI, ADDI, EORI and CMPI
+			static const UINT16 s_ops[] = { 0x0000, 0x0200, 0x0400, 0x0600, 0x0a00, 0x0c00 };
+			UINT32 value = random_value();
+			make_dst_operand(dst, size);
+			emit16(s_ops[random(ARRAY_LENGTH(s_ops))] | sizefield | dst.field);
+			if (size == 4)
+				emit32(value);
+			else
+				emit16((size == 1) ? (value & 0xff) : value);
+			emit_operand(dst);
+			break;
+		}
+
+		case 10:
+			// ADDQ and SUBQ, including to an address register
+			if (size != 1 && random(4) == 0)
+				make_operand(dst, EA_A(random_dst_areg()));
+			else
+				make_dst_operand(dst, size);
+			emit16(0x5000 | (random(8) << 9) | (random(2) << 8) | sizefield | dst.field);
+			emit_operand(dst);
+			break;
+
+		case 11:
+		{
+			// ADDA, SUBA and CMPA
+			static const UINT16 s_ops[] = { 0xd0c0, 0x90c0, 0xb0c0 };
+			int op = random(ARRAY_LENGTH(s_ops));
+			size = random(2) ? 2 : 4;
+			make_src_operand(src, size, true);
+			emit16(s_ops[op] | ((size == 4) ? 0x100 : 0) | (((op == 2) ? random(8) : random_dst_areg()) << 9) | src.field);
+			emit_operand(src);
+			break;
+		}
+
+		case 12:
+		{
+			// NEG, NOT and CLR
+			static const UINT16 s_ops[] = { 0x4400, 0x4600, 0x4200 };
+			make_dst_operand(dst, size);
+			emit16(s_ops[random(ARRAY_LENGTH(s_ops))] | sizefield | dst.field);
+			emit_operand(dst);
+			break;
+		}
+
+		case 13:
+			// TST
+			make_src_operand(src, size, false);
+			if (src.field == EA_I)
+				make_operand(src, EA_D(random(8)));
+			emit16(0x4a00 | sizefield | src.field);
+			emit_operand(src);
+			break;
+
+		case 14:
+		{
+			// EXT.W, EXT.L, EXTB.L and SWAP
+			static const UINT16 s_ops[] = { 0x4880, 0x48c0, 0x49c0, 0x4840 };
+			emit16(s_ops[random(ARRAY_LENGTH(s_ops))] | random(8));
+			break;
+		}
+
+		case 15:
+		{
+			// ASR, LSR and LSL by an immediate count
+			static const UINT16 s_ops[] = { 0xe000, 0xe008, 0xe108 };
+			emit16(s_ops[random(ARRAY_LENGTH(s_ops))] | (random(8) << 9) | sizefield | random(8));
+			break;
+		}
+
+		case 16:
+			// Scc, ST and SF
+			make_dst_operand(dst, 1);
+			emit16(0x50c0 | (random(16) << 8) | dst.field);
+			emit_operand(dst);
+			break;
+
+		case 17:
+			// LEA
+			make_memory_operand(src, 4, true);
+			if (random(4) == 0)
+			{
+				make_operand(src, EA_PCDI);
+				src.ext[src.count++] = random32();
+			}
+			emit16(0x41c0 | (random_dst_areg() << 9) | src.field);
+			emit_operand(src);
+			break;
+
+		case 18:
+			// PEA, popped straight back off
+			make_memory_operand(src, 4, true);
+			emit16(0x4840 | src.field);
+			emit_operand(src);
+			emit16(0x201f | (random_dst_areg() << 9) | 0x0040);
+			break;
+
+		case 19:
+		case 20:
+		{
+			// MOVEM in each direction, to and from memory and the stack pointers
+			UINT16 reglist = random_reglist();
+			UINT16 sizebit = random(2) ? 0x40 : 0x00;
+			switch (random(3))
+			{
+				case 0:
+					// registers to memory predecremented; the list is reversed
+					emit16(0x4880 | sizebit | EA_PD(2));
+					emit16(BITSWAP16(reglist, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15));
+					break;
+
+				case 1:
+					make_memory_operand(dst, 4, true);
+					emit16(0x4880 | sizebit | dst.field);
+					emit16(reglist);
+					emit_operand(dst);
+					break;
+
+				case 2:
+					if (random(2))
+						make_operand(src, EA_PI(0));
+					else
+						make_memory_operand(src, 4, true);
+					emit16(0x4c80 | sizebit | src.field);
+					emit16(reglist);
+					emit_operand(src);
+					break;
+			}
+			break;
+		}
+
+		case 21:
+			// some instructions that are always interpreted: MULU, ROL, ADDX and BTST
+			switch (random(4))
+			{
+				case 0: emit16(0xc0c0 | (random(8) << 9) | random(8)); break;
+				case 1: emit16(0xe198 | (random(8) << 9) | random(8)); break;
+				case 2: emit16(0xd180 | (random(8) << 9) | random(8)); break;
+				case 3: emit16(0x0800 | random(8)); emit16(random(32)); break;
+			}
+			break;
+
+		default:
+			// NOP
+			emit16(0x4e71);
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_control_insn - emit a random branch
+//  along with whatever it needs to terminate
+//-------------------------------------------------
+
+void test_m68kdrc_state::emit_control_insn()
+{
+	UINT32 patch;
+
+	switch (random(10))
+	{
+		case 0:
+		case 1:
+			// Bcc.B over the next instruction
+			patch = m_pc;
+			m_pc += 2;
+			emit_simple_insn();
+			patch16(patch, 0x6000 | ((2 + random(14)) << 8) | (m_pc - (patch + 2)));
+			break;
+
+		case 2:
+			// Bcc.W or Bcc.L over the next instruction
+		{
+			bool islong = random(2);
+			patch = m_pc;
+			m_pc += islong ? 6 : 4;
+			emit_simple_insn();
+			UINT32 disp = m_pc - (patch + 2);
+			UINT32 end = m_pc;
+			m_pc = patch;
+			emit16(0x6000 | ((2 + random(14)) << 8) | (islong ? 0xff : 0x00));
+			if (islong)
+				emit32(disp);
+			else
+				emit16(disp);
+			m_pc = end;
+			break;
+		}
+
+		case 3:
+			// BRA.B over the next instruction
+			patch = m_pc;
+			m_pc += 2;
+			emit_simple_insn();
+			patch16(patch, 0x6000 | (m_pc - (patch + 2)));
+			break;
+
+		case 4:
+			// BSR.B to a subroutine that follows
+			emit16(0x6102);
+			patch = m_pc;
+			m_pc += 2;
+			emit_simple_insn();
+			emit16(0x4e75);
+			patch16(patch, 0x6000 | (m_pc - (patch + 2)));
+			break;
+
+		case 5:
+			// JSR to a subroutine that follows, either directly or through A3
+		{
+			bool indirect = random(2);
+			UINT32 target = m_pc + (indirect ? 2 : 0);
+			m_pc += indirect ? 6 : 4;
+			patch = m_pc;
+			m_pc += 2;
+			UINT32 sub = m_pc;
+			emit_simple_insn();
+			emit16(0x4e75);
+			patch16(patch, 0x6000 | (m_pc - (patch + 2)));
+			UINT32 end = m_pc;
+			m_pc = target - (indirect ? 2 : 0);
+			if (indirect)
+			{
+				emit16(0x47fa);                         // lea (sub,pc),a3
+				emit16(sub - m_pc);
+				emit16(0x4e93);                         // jsr (a3)
+			}
+			else
+			{
+				emit16(0x4eba);                         // jsr (sub,pc)
+				emit16(sub - m_pc);
+			}
+			m_pc = end;
+			break;
+		}
+
+		case 6:
+			// JMP through A3 over the next instruction
+		{
+			UINT32 start = m_pc;
+			m_pc += 6;
+			emit_simple_insn();
+			UINT32 end = m_pc;
+			m_pc = start;
+			emit16(0x47fa);                             // lea (end,pc),a3
+			emit16(end - m_pc);
+			emit16(0x4ed3);                             // jmp (a3)
+			m_pc = end;
+			break;
+		}
+
+		case 7:
+		case 8:
+			// a short counted loop, ended by DBF or by DBcc
+		{
+			int counter = random(8);
+			int reg = (counter + 1 + random(7)) & 7;
+			emit16(0x7000 | (counter << 9) | random(4));    // moveq #n,counter
+			UINT32 top = m_pc;
+			emit16(0x5080 | ((1 + random(7)) << 9) | reg);  // addq.l #n,reg
+			emit16(0x50c8 | (((random(2) == 0) ? 1 : 2 + random(14)) << 8) | counter);
+			emit16(top - m_pc);
+			break;
+		}
+
+		case 9:
+			// a stack frame, word or long sized
+			if (random(2))
+			{
+				emit16(0x4e56);                             // link.w a6,#-n
+				emit16(-2 * (1 + random(8)));
+			}
+			else
+			{
+				emit16(0x480e);                             // link.l a6,#-n
+				emit32(-2 * (1 + random(8)));
+			}
+			emit16(0x2f00 | random(8));                     // move.l dn,-(a7)
+			emit16(0x4e5e);                                 // unlk a6
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_checkpoint - store the registers and
+//  the status register where they can be
+//  compared
+//-------------------------------------------------
+
+void test_m68kdrc_state::emit_checkpoint(int index)
+{
+	UINT32 base = CHECKPOINT_BASE + index * CHECKPOINT_SIZE;
+
+	// movem.l d0-a7,base.l
+	emit16(0x48f9);
+	emit16(0xffff);
+	emit32(base);
+
+	// move.w sr,base+64.l
+	emit16(0x40f9);
+	emit32(base + 64);
+}
+
+
+//-------------------------------------------------
+//  emit_test_case - emit one instruction stream
+//  and its checkpoint
+//-------------------------------------------------
+
+void test_m68kdrc_state::emit_test_case(int index)
+{
+	m_case_pc.push_back(m_pc);
+
+	// start from random flags and registers
+	emit16(0x44fc);                                                     // move #n,ccr
+	emit16(random(0x20));
+	for (int reg = 0; reg < 8; reg++)
+	{
+		emit16(0x203c | (reg << 9));                                    // move.l #n,dn
+		emit32(random_value());
+	}
+	emit16(0x207c);                                                     // movea.l #n,a0
+	emit32(DATA_BASE + 0x1000 + random(0x100));
+	emit16(0x227c);                                                     // movea.l #n,a1
+	emit32(random(0x100));
+	emit16(0x247c);                                                     // movea.l #n,a2
+	emit32(DATA_BASE + 0xe000 + random(0x100));
+	emit16(0x267c);                                                     // movea.l #n,a3
+	emit32(random_value());
+	emit16(0x287c);                                                     // movea.l #n,a4
+	emit32(random_value());
+
+	for (int insn = 0; insn < TEST_CASE_LENGTH; insn++)
+	{
+		if (random(6) == 0)
+			emit_control_insn();
+		else
+			emit_simple_insn();
+	}
+	emit_checkpoint(index);
+
+	if (m_pc > CODE_END - 0x1000)
+		fatalerror("testm68k: generated program is too large\n");
+}
+
+
+//-------------------------------------------------
+//  build_program - generate the whole program
+//-------------------------------------------------
+
+void test_m68kdrc_state::build_program()
+{
+	m_image.assign(RAM_SIZE, 0);
+	m_seed = TEST_SEED;
+
+	// reset vectors, and every exception goes to the failure handler
+	m_pc = 0;
+	emit32(STACK_TOP);
+	emit32(CODE_BASE);
+	for (int vector = 2; vector < 256; vector++)
+		emit32(FAIL_BASE);
+
+	// any exception is a failure
+	m_pc = FAIL_BASE;
+	emit16(0x23fc); emit32(0xdeadbeef); emit32(FAIL_ADDRESS);           // move.l #$deadbeef,FAIL_ADDRESS
+	emit16(0x23fc); emit32(1); emit32(DONE_ADDRESS);                    // move.l #1,DONE_ADDRESS
+	emit16(0x60fe);                                                     // bra.s *
+
+	// random data
+	for (int offs = 0; offs < ABSW_SIZE; offs++)
+		m_image[ABSW_BASE + offs] = random(256);
+	for (int offs = 0; offs < DATA_SIZE; offs++)
+		m_image[DATA_BASE + offs] = random(256);
+
+	// the test cases
+	m_pc = CODE_BASE;
+	emit16(0x2a7c);                                                     // movea.l #n,a5
+	emit32(DATA_BASE + DATA_SIZE / 2);
+	for (int index = 0; index < TEST_CASES; index++)
+		emit_test_case(index);
+
+	// done
+	emit16(0x23fc); emit32(1); emit32(DONE_ADDRESS);                    // move.l #1,DONE_ADDRESS
+	emit16(0x60fe);                                                     // bra.s *
+}
+
+
+void test_m68kdrc_state::machine_start()
+{
+	build_program();
+	start_comparison();
+}
+
+static ADDRESS_MAP_START( drc_map, AS_PROGRAM, 32, test_m68kdrc_state )
+	AM_RANGE(0x00000000, 0x003fffff) AM_RAM
+ADDRESS_MAP_END
+
+static ADDRESS_MAP_START( interp_map, AS_PROGRAM, 32, test_m68kdrc_state )
+	AM_RANGE(0x00000000, 0x003fffff) AM_RAM
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( test_m68kdrc, test_m68kdrc_state )
+	MCFG_CPU_ADD("drc", M68020, 16000000)
+	MCFG_CPU_PROGRAM_MAP(drc_map)
+	MCFG_M68K_ALLOW_RECOMPILER()
+
+	MCFG_CPU_ADD("interp", M68020, 16000000)
+	MCFG_CPU_PROGRAM_MAP(interp_map)
+	MCFG_M68K_FORCE_INTERPRETER()
+MACHINE_CONFIG_END
+
+ROM_START( testm68k )
+ROM_END
+
+COMP( 2016, testm68k,  0,        0,      test_m68kdrc, 0, driver_device, 0,      "MAMEdev",   "68020 recompiler comparison test", MACHINE_NO_SOUND_HW )
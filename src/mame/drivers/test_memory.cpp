@@ -0,0 +1,323 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*
+
+    Memory system dispatch test
+
+    Builds one address space for each data bus width in both
+    endiannesses and checks that accesses of every size agree with the
+    bytes stored in RAM, and that byte handlers installed on a wider
+    bus see the right offsets.  Then reports the time per access for
+    RAM, a handler of the bus width, and a byte handler spread across
+    every lane of the bus, one line per size and then all of them as a
+    single line of JSON in the same form as testbnch.  Run with -video
+    none; the driver exits once the tests have finished and fails if
+    any access returned the wrong value.
+
+    Memory map, identical for every space:
+
+        00000000    RAM
+        00010000    handler of the bus width
+        00020000    byte handler on every lane
+
+*/
+
+#include "emu.h"
+#include "machine/bankdev.h"
+
+// accesses per timed loop
+#define BENCHMARK_ACCESSES      4000000
+
+// bytes checked at the start of each RAM region
+#define CHECK_BYTES             256
+
+// region bases
+#define RAM_BASE                0x00000
+#define NATIVE_BASE             0x10000
+#define BYTE_BASE               0x20000
+#define REGION_MASK             0x0ffff
+
+// one space per bus width, little endian then big endian
+#define TEST_SPACES             8
+
+class test_memory_state : public driver_device
+{
+public:
+	test_memory_state(const machine_config &mconfig, device_type type, const char *tag)
+		: driver_device(mconfig, type, tag),
+			m_failures(0),
+			m_sink(0) { }
+
+	DECLARE_READ8_MEMBER(read8);
+	DECLARE_WRITE8_MEMBER(write8);
+	DECLARE_READ16_MEMBER(read16);
+	DECLARE_WRITE16_MEMBER(write16);
+	DECLARE_READ32_MEMBER(read32);
+	DECLARE_WRITE32_MEMBER(write32);
+	DECLARE_READ64_MEMBER(read64);
+	DECLARE_WRITE64_MEMBER(write64);
+
+protected:
+	virtual void machine_start() override;
+
+private:
+	void install(address_space &space);
+	void check(address_space &space);
+	void benchmark(address_space &space, offs_t base, const char *what);
+
+	UINT64 expected(address_space &space, const UINT8 *bytes, offs_t address, int size);
+	UINT64 read_sized(address_space &space, offs_t address, int size);
+
+	address_space &test_space(int index);
+
+	int m_failures;
+	UINT64 m_sink;
+	std::string m_json;
+};
+
+
+//-------------------------------------------------
+//  handlers - return a value derived from the
+//  offset, so lane routing can be checked
+//-------------------------------------------------
+
+READ8_MEMBER(test_memory_state::read8) { return offset ^ 0x5a; }
+WRITE8_MEMBER(test_memory_state::write8) { m_sink += data; }
+READ16_MEMBER(test_memory_state::read16) { return offset; }
+WRITE16_MEMBER(test_memory_state::write16) { m_sink += data & mem_mask; }
+READ32_MEMBER(test_memory_state::read32) { return offset; }
+WRITE32_MEMBER(test_memory_state::write32) { m_sink += data & mem_mask; }
+READ64_MEMBER(test_memory_state::read64) { return offset; }
+WRITE64_MEMBER(test_memory_state::write64) { m_sink += data & mem_mask; }
+
+
+//-------------------------------------------------
+//  install - map RAM and the handlers into a
+//  space
+//-------------------------------------------------
+
+void test_memory_state::install(address_space &space)
+{
+	space.install_ram(RAM_BASE, RAM_BASE + REGION_MASK);
+
+	switch (space.data_width())
+	{
+		case 8:
+			space.install_readwrite_handler(NATIVE_BASE, NATIVE_BASE + REGION_MASK, read8_delegate(FUNC(test_memory_state::read8), this), write8_delegate(FUNC(test_memory_state::write8), this));
+			break;
+		case 16:
+			space.install_readwrite_handler(NATIVE_BASE, NATIVE_BASE + REGION_MASK, read16_delegate(FUNC(test_memory_state::read16), this), write16_delegate(FUNC(test_memory_state::write16), this));
+			break;
+		case 32:
+			space.install_readwrite_handler(NATIVE_BASE, NATIVE_BASE + REGION_MASK, read32_delegate(FUNC(test_memory_state::read32), this), write32_delegate(FUNC(test_memory_state::write32), this));
+			break;
+		case 64:
+			space.install_readwrite_handler(NATIVE_BASE, NATIVE_BASE + REGION_MASK, read64_delegate(FUNC(test_memory_state::read64), this), write64_delegate(FUNC(test_memory_state::write64), this));
+			break;
+	}
+
+	// a byte handler on every lane of a wider bus goes through the subunit stubs
+	if (space.data_width() > 8)
+		space.install_readwrite_handler(BYTE_BASE, BYTE_BASE + REGION_MASK, read8_delegate(FUNC(test_memory_state::read8), this), write8_delegate(FUNC(test_memory_state::write8), this), U64(0xffffffffffffffff));
+}
+
+
+//-------------------------------------------------
+//  expected - assemble a value from the bytes
+//  that were stored, in the space's byte order
+//-------------------------------------------------
+
+UINT64 test_memory_state::expected(address_space &space, const UINT8 *bytes, offs_t address, int size)
+{
+	UINT64 result = 0;
+	for (int byte = 0; byte < size; byte++)
+	{
+		int shift = (space.endianness() == ENDIANNESS_LITTLE) ? 8 * byte : 8 * (size - 1 - byte);
+		result |= UINT64(bytes[address + byte]) << shift;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  read_sized - aligned read of 1, 2, 4 or 8
+//  bytes
+//-------------------------------------------------
+
+UINT64 test_memory_state::read_sized(address_space &space, offs_t address, int size)
+{
+	switch (size)
+	{
+		case 1: return space.read_byte(address);
+		case 2: return space.read_word(address);
+		case 4: return space.read_dword(address);
+		default: return space.read_qword(address);
+	}
+}
+
+
+//-------------------------------------------------
+//  check - compare every aligned access against
+//  the bytes behind it, after filling RAM with
+//  each access size in turn
+//-------------------------------------------------
+
+void test_memory_state::check(address_space &space)
+{
+	UINT8 bytes[CHECK_BYTES];
+	for (int size = 1; size <= 8; size *= 2)
+	{
+		// fill with writes of this size
+		for (offs_t address = 0; address < CHECK_BYTES; address++)
+			bytes[address] = machine().rand();
+		for (offs_t address = 0; address < CHECK_BYTES; address += size)
+		{
+			UINT64 data = expected(space, bytes, address, size);
+			switch (size)
+			{
+				case 1: space.write_byte(RAM_BASE + address, data); break;
+				case 2: space.write_word(RAM_BASE + address, data); break;
+				case 4: space.write_dword(RAM_BASE + address, data); break;
+				default: space.write_qword(RAM_BASE + address, data); break;
+			}
+		}
+
+		// read back with every size
+		for (int readsize = 1; readsize <= 8; readsize *= 2)
+			for (offs_t address = 0; address < CHECK_BYTES; address += readsize)
+			{
+				UINT64 result = read_sized(space, RAM_BASE + address, readsize);
+				UINT64 expect = expected(space, bytes, address, readsize);
+				if (result != expect)
+				{
+					osd_printf_error("%s: %d-byte read at %X after %d-byte writes is %s, expected %s\n", space.device().tag(), readsize, address, size,
+							core_i64_hex_format(result, 2 * readsize), core_i64_hex_format(expect, 2 * readsize));
+					m_failures++;
+				}
+			}
+	}
+
+	// each byte of the byte handler region sees its own offset
+	if (space.data_width() > 8)
+		for (offs_t address = 0; address < CHECK_BYTES; address++)
+			if (space.read_byte(BYTE_BASE + address) != UINT8(address ^ 0x5a))
+			{
+				osd_printf_error("%s: byte handler read at %X is %02X, expected %02X\n", space.device().tag(), address, space.read_byte(BYTE_BASE + address), UINT8(address ^ 0x5a));
+				m_failures++;
+			}
+}
+
+
+//-------------------------------------------------
+//  benchmark - time each access size against one
+//  region of a space
+//-------------------------------------------------
+
+void test_memory_state::benchmark(address_space &space, offs_t base, const char *what)
+{
+	static const char *const sizes[] = { "byte", "word", "dword", "qword" };
+	const double ns_per_tick = 1e9 / double(osd_ticks_per_second());
+
+	for (int sizeindex = 0, size = 1; size <= 8; sizeindex++, size *= 2)
+	{
+		const offs_t step = size;
+		UINT64 sum = 0;
+
+		osd_ticks_t start = osd_ticks();
+		for (UINT32 access = 0; access < BENCHMARK_ACCESSES; access++)
+		{
+			offs_t address = base + ((access * step) & REGION_MASK);
+			switch (size)
+			{
+				case 1: sum += space.read_byte(address); break;
+				case 2: sum += space.read_word(address); break;
+				case 4: sum += space.read_dword(address); break;
+				default: sum += space.read_qword(address); break;
+			}
+		}
+		osd_ticks_t reads = osd_ticks() - start;
+
+		start = osd_ticks();
+		for (UINT32 access = 0; access < BENCHMARK_ACCESSES; access++)
+		{
+			offs_t address = base + ((access * step) & REGION_MASK);
+			switch (size)
+			{
+				case 1: space.write_byte(address, access); break;
+				case 2: space.write_word(address, access); break;
+				case 4: space.write_dword(address, access); break;
+				default: space.write_qword(address, access); break;
+			}
+		}
+		osd_ticks_t writes = osd_ticks() - start;
+
+		m_sink += sum;
+		double readns = double(reads) * ns_per_tick / BENCHMARK_ACCESSES;
+		double writens = double(writes) * ns_per_tick / BENCHMARK_ACCESSES;
+		osd_printf_info("%s %-5s %-6s read %6.2fns write %6.2fns\n", space.device().tag(), what, sizes[sizeindex], readns, writens);
+		strcatprintf(m_json, "%s { \"name\": \"%s_%s_%s_read\", \"unit\": \"access\", \"ns\": %.2f }", m_json.empty() ? "" : ",", space.device().basetag(), what, sizes[sizeindex], readns);
+		strcatprintf(m_json, ", { \"name\": \"%s_%s_%s_write\", \"unit\": \"access\", \"ns\": %.2f }", space.device().basetag(), what, sizes[sizeindex], writens);
+	}
+}
+
+
+//-------------------------------------------------
+//  test_space - return the address space of one
+//  of the test devices
+//-------------------------------------------------
+
+address_space &test_memory_state::test_space(int index)
+{
+	static const char *const tags[TEST_SPACES] = { "space0", "space1", "space2", "space3", "space4", "space5", "space6", "space7" };
+	return machine().device<address_map_bank_device>(tags[index])->space(AS_PROGRAM);
+}
+
+
+void test_memory_state::machine_start()
+{
+	for (int index = 0; index < TEST_SPACES; index++)
+		install(test_space(index));
+
+	for (int index = 0; index < TEST_SPACES; index++)
+		check(test_space(index));
+
+	osd_printf_info("memory dispatch test, %d failures\n", m_failures);
+	if (m_failures != 0)
+		throw emu_fatalerror("Memory dispatch test failed");
+
+	for (int index = 0; index < TEST_SPACES; index++)
+	{
+		address_space &space = test_space(index);
+		benchmark(space, RAM_BASE, "ram");
+		benchmark(space, NATIVE_BASE, "native");
+		if (space.data_width() > 8)
+			benchmark(space, BYTE_BASE, "byte");
+	}
+	osd_printf_info("{ \"benchmarks\": [%s ] }\n", m_json.c_str());
+
+	// keep the handler results live
+	osd_printf_verbose("checksum %s\n", core_i64_hex_format(m_sink, 16));
+	machine().schedule_exit();
+}
+
+#define MCFG_TEST_SPACE_ADD(_tag, _endianness, _width) \
+	MCFG_DEVICE_ADD(_tag, ADDRESS_MAP_BANK, 0) \
+	MCFG_ADDRESS_MAP_BANK_ENDIANNESS(_endianness) \
+	MCFG_ADDRESS_MAP_BANK_DATABUS_WIDTH(_width) \
+	MCFG_ADDRESS_MAP_BANK_ADDRBUS_WIDTH(32)
+
+static MACHINE_CONFIG_START( test_memory, test_memory_state )
+	MCFG_TEST_SPACE_ADD("space0", ENDIANNESS_LITTLE, 8)
+	MCFG_TEST_SPACE_ADD("space1", ENDIANNESS_LITTLE, 16)
+	MCFG_TEST_SPACE_ADD("space2", ENDIANNESS_LITTLE, 32)
+	MCFG_TEST_SPACE_ADD("space3", ENDIANNESS_LITTLE, 64)
+	MCFG_TEST_SPACE_ADD("space4", ENDIANNESS_BIG, 8)
+	MCFG_TEST_SPACE_ADD("space5", ENDIANNESS_BIG, 16)
+	MCFG_TEST_SPACE_ADD("space6", ENDIANNESS_BIG, 32)
+	MCFG_TEST_SPACE_ADD("space7", ENDIANNESS_BIG, 64)
+MACHINE_CONFIG_END
+
+ROM_START( testmem )
+ROM_END
+
+COMP( 2016, testmem,   0,        0,      test_memory, 0, driver_device, 0,      "MAMEdev",   "Memory system dispatch test", MACHINE_NO_SOUND_HW )
@@ -0,0 +1,799 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*
+
+    SH-4 recompiler comparison test
+
+    Two little-endian SH-4 CPUs run the same generated program, one using
+    the recompiler and one forced to use the interpreter.  The program is
+    a long series of short random instruction streams, each followed by a
+    checkpoint that stores the general, system and single-precision
+    floating point registers.  The streams cover the ALU, shift, multiply
+    and divide-step instructions, every data addressing mode, the GBR
+    and PC relative forms, delayed branches, and the MAC and FPSCR
+    instructions the recompiler hands back to the interpreter.  Once
+    both CPUs have finished, their memory is compared.  Run with
+    -video none; the driver exits once the test has finished and fails
+    if the two CPUs disagree.
+
+    The program runs with SR.RB set throughout so that no bank switch
+    happens, and avoids the floating point instructions whose results
+    depend on the host's rounding (FDIV, FSQRT and FTRC).
+
+    Memory map, identical for both CPUs:
+
+        00000000    boot code, entered through the reset vector
+        00000100    handler for general exceptions (VBR + 0x100)
+        00000400    handler for TLB misses (VBR + 0x400)
+        00000600    handler for interrupts (VBR + 0x600)
+        00010000    scratch area addressed through GBR
+        00020000    top of stack
+        00040000    generated instruction streams
+        00200000    data, addressed through R8, R9 and R10
+        00300000    checkpoints
+        003ffff0    set to 1 when the program has finished
+        003ffff4    set if an exception was taken
+
+    Register use within the instruction streams:
+
+        R0          random value, also the index for @(R0,Rn) forms
+        R1-R7       random values, freely written
+        R8          middle of the data area, never written
+        R9          data pointer, used with postincrement
+        R10         data pointer, used with predecrement
+        R11-R14     random values, freely written
+        R15         stack pointer
+
+*/
+
+#include "emu.h"
+#include "cpu/sh4/sh4.h"
+#include "includes/drccomp.h"
+
+// instruction streams to generate; the seed is fixed so that failures
+// can be reproduced
+#define TEST_SEED           1
+#define TEST_CASES          2000
+#define TEST_CASE_LENGTH    24
+
+// memory layout
+#define RAM_SIZE            DRCCOMP_RAM_SIZE
+#define GENERAL_VECTOR      0x000100
+#define TLBMISS_VECTOR      0x000400
+#define IRQ_VECTOR          0x000600
+#define SCRATCH_BASE        0x010000
+#define STACK_TOP           0x020000
+#define CODE_BASE           0x040000
+#define CODE_END            0x200000
+#define DATA_BASE           0x200000
+#define DATA_SIZE           0x010000
+#define CHECKPOINT_BASE     DRCCOMP_CHECKPOINT_BASE
+#define CHECKPOINT_SIZE     160
+#define DONE_ADDRESS        DRCCOMP_DONE_ADDRESS
+#define FAIL_ADDRESS        DRCCOMP_FAIL_ADDRESS
+
+// privileged mode, register bank 1, exceptions enabled, interrupts masked
+#define INITIAL_SR          0x600000f0
+
+// registers stored at each checkpoint, in order
+static const char *const s_regnames[] =
+{
+	"R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7", "R8", "R9", "R10", "R11", "R12", "R13", "R14", "R15",
+	"SR", "MACH", "MACL", "PR", "FPUL", "FPSCR",
+	"FR0", "FR1", "FR2", "FR3", "FR4", "FR5", "FR6", "FR7", "FR8", "FR9", "FR10", "FR11", "FR12", "FR13", "FR14", "FR15"
+};
+
+class test_sh4drc_state : public drc_compare_state
+{
+public:
+	test_sh4drc_state(const machine_config &mconfig, device_type type, const char *tag)
+		: drc_compare_state(mconfig, type, tag, "SH-4", TEST_CASES, CHECKPOINT_SIZE, s_regnames, ARRAY_LENGTH(s_regnames)) { }
+
+protected:
+	virtual void machine_start() override;
+
+private:
+	// random numbers
+	UINT32 random32();
+	int random(int limit) { return random32() % limit; }
+	UINT32 random_value();
+	UINT32 random_float();
+	int random_dst_reg();
+	int random_src_reg() { return random(16); }
+	int random_fpreg() { return random(16); }
+
+	// code emission
+	void emit16(UINT16 data) { m_image[m_pc++] = data; m_image[m_pc++] = data >> 8; }
+	void emit32(UINT32 data) { emit16(data); emit16(data >> 16); }
+	void emit_table(const UINT32 *values, int count);
+	void emit_index(int size);
+	void emit_done(UINT32 value, UINT32 address);
+	void patch16(UINT32 address, UINT16 data) { m_image[address] = data; m_image[address + 1] = data >> 8; }
+
+	// program generation
+	void build_program();
+	void emit_alu_insn();
+	void emit_simple_insn();
+	void emit_control_insn();
+	void emit_test_case(int index);
+	void emit_checkpoint(int index);
+
+
+	UINT32 m_pc;
+	UINT32 m_seed;
+};
+
+
+//-------------------------------------------------
+//  random32 - return the next value from a
+//  xorshift generator
+//-------------------------------------------------
+
+UINT32 test_sh4drc_state::random32()
+{
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+	return m_seed;
+}
+
+
+//-------------------------------------------------
+//  random_value - return a random operand,
+//  favouring values at the edges of the flags
+//-------------------------------------------------
+
+UINT32 test_sh4drc_state::random_value()
+{
+	static const UINT32 s_edges[] = { 0x00000000, 0x00000001, 0x0000007f, 0x00000080, 0x000000ff, 0x00007fff, 0x00008000, 0x0000ffff, 0x7fffffff, 0x80000000, 0xffffffff };
+	if (random(4) == 0)
+		return s_edges[random(ARRAY_LENGTH(s_edges))];
+	return random32();
+}
+
+
+//-------------------------------------------------
+//  random_float - return the bits of a random
+//  single-precision value that every host
+//  handles in the same way
+//-------------------------------------------------
+
+UINT32 test_sh4drc_state::random_float()
+{
+	static const UINT32 s_edges[] = { 0x00000000, 0x80000000, 0x3f800000, 0xbf800000, 0x7f7fffff, 0xff7fffff, 0x7f800000, 0xff800000 };
+	if (random(8) == 0)
+		return s_edges[random(ARRAY_LENGTH(s_edges))];
+
+	float value = float(INT32(random32() % 0x20000) - 0x10000) / float(1 << random(8));
+	UINT32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+
+//-------------------------------------------------
+//  random_dst_reg - pick a register that may be
+//  freely written
+//-------------------------------------------------
+
+int test_sh4drc_state::random_dst_reg()
+{
+	static const int s_regs[] = { 0, 1, 2, 3, 4, 5, 6, 7, 11, 12, 13, 14 };
+	return s_regs[random(ARRAY_LENGTH(s_regs))];
+}
+
+
+//-------------------------------------------------
+//  emit_table - emit a table of values and leave
+//  R0 pointing at it, with a branch around it
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_table(const UINT32 *values, int count)
+{
+	UINT32 start = m_pc;
+	UINT32 table = (start + 6 + 3) & ~3;
+	UINT32 skip = table + count * 4;
+
+	emit16(0xc700 | ((table - ((start + 4) & ~3)) / 4));               // mova @(table,pc),r0
+	emit16(0xa000 | (((skip - (start + 6)) / 2) & 0xfff));              // bra skip
+	emit16(0x0009);                                                     // nop
+	m_pc = table;
+	for (int index = 0; index < count; index++)
+		emit32(values[index]);
+}
+
+
+//-------------------------------------------------
+//  emit_index - load R0 with a random offset into
+//  the data area, aligned to the access size
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_index(int size)
+{
+	emit16(0xe000 | ((random(0x100) & ~(size - 1)) & 0xff));           // mov #n,r0
+}
+
+
+//-------------------------------------------------
+//  emit_done - store a value to an address and
+//  stop
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_done(UINT32 value, UINT32 address)
+{
+	const UINT32 values[] = { value, address, 1, DONE_ADDRESS };
+	emit_table(values, ARRAY_LENGTH(values));
+	emit16(0x6106);                                                     // mov.l @r0+,r1
+	emit16(0x6206);                                                     // mov.l @r0+,r2
+	emit16(0x2212);                                                     // mov.l r1,@r2
+	emit16(0x6106);                                                     // mov.l @r0+,r1
+	emit16(0x6202);                                                     // mov.l @r0,r2
+	emit16(0x2212);                                                     // mov.l r1,@r2
+	emit16(0xaffe);                                                     // bra *
+	emit16(0x0009);                                                     // nop
+}
+
+
+//-------------------------------------------------
+//  emit_alu_insn - emit a single register or
+//  immediate instruction, which is also safe in
+//  a delay slot
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_alu_insn()
+{
+	// two register forms, nmmm
+	static const UINT16 s_regreg[] =
+	{
+		0x300c, 0x300e, 0x300f, 0x3008, 0x300a, 0x300b,                 // add, addc, addv, sub, subc, subv
+		0x2009, 0x200b, 0x200a, 0x2008,                                 // and, or, xor, tst
+		0x3000, 0x3002, 0x3003, 0x3006, 0x3007, 0x200c,                 // cmp/eq, cmp/hs, cmp/ge, cmp/hi, cmp/gt, cmp/str
+		0x6003, 0x6007, 0x600b, 0x600a,                                 // mov, not, neg, negc
+		0x600e, 0x600f, 0x600c, 0x600d,                                 // exts.b, exts.w, extu.b, extu.w
+		0x6008, 0x6009, 0x200d,                                         // swap.b, swap.w, xtrct
+		0x400c, 0x400d                                                  // shad, shld
+	};
+
+	// one register forms, n
+	static const UINT16 s_reg[] =
+	{
+		0x4000, 0x4001, 0x4020, 0x4021, 0x4004, 0x4005, 0x4024, 0x4025, // shll, shlr, shal, shar, rotl, rotr, rotcl, rotcr
+		0x4008, 0x4018, 0x4028, 0x4009, 0x4019, 0x4029,                 // shll2, shll8, shll16, shlr2, shlr8, shlr16
+		0x4010, 0x4011, 0x4015, 0x0029                                  // dt, cmp/pz, cmp/pl, movt
+	};
+
+	// immediate forms on R0, ii
+	static const UINT16 s_imm[] = { 0x8800, 0xc900, 0xcb00, 0xca00, 0xc800 };  // cmp/eq, and, or, xor, tst
+
+	switch (random(6))
+	{
+		case 0:
+		case 1:
+			emit16(s_regreg[random(ARRAY_LENGTH(s_regreg))] | (random_dst_reg() << 8) | (random_src_reg() << 4));
+			break;
+
+		case 2:
+			emit16(s_reg[random(ARRAY_LENGTH(s_reg))] | (random_dst_reg() << 8));
+			break;
+
+		case 3:
+			emit16(s_imm[random(ARRAY_LENGTH(s_imm))] | random(0x100));
+			break;
+
+		case 4:
+			emit16(0x7000 | (random_dst_reg() << 8) | random(0x100));      // add #n,rn
+			break;
+
+		case 5:
+			emit16(0xe000 | (random_dst_reg() << 8) | random(0x100));      // mov #n,rn
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_simple_insn - emit an instruction that
+//  does not branch, with any setup it needs
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_simple_insn()
+{
+	// load and store sizes, as shifts
+	int shift = random(3);
+	int size = 1 << shift;
+
+	switch (random(24))
+	{
+		case 0:
+		case 1:
+		case 2:
+		case 3:
+		case 4:
+			emit_alu_insn();
+			break;
+
+		case 5:
+			switch (random(5))
+			{
+				case 0: emit16(0x0007 | (random_src_reg() << 8) | (random_src_reg() << 4)); break;    // mul.l rm,rn
+				case 1: emit16(0x200f | (random_src_reg() << 8) | (random_src_reg() << 4)); break;    // muls.w rm,rn
+				case 2: emit16(0x200e | (random_src_reg() << 8) | (random_src_reg() << 4)); break;    // mulu.w rm,rn
+				case 3: emit16(0x300d | (random_src_reg() << 8) | (random_src_reg() << 4)); break;    // dmuls.l rm,rn
+				case 4: emit16(0x3005 | (random_src_reg() << 8) | (random_src_reg() << 4)); break;    // dmulu.l rm,rn
+			}
+			break;
+
+		case 6:
+			switch (random(5))
+			{
+				case 0: emit16(0x000a | (random_dst_reg() << 8)); break;        // sts mach,rn
+				case 1: emit16(0x001a | (random_dst_reg() << 8)); break;        // sts macl,rn
+				case 2: emit16(0x400a | (random_src_reg() << 8)); break;        // lds rm,mach
+				case 3: emit16(0x401a | (random_src_reg() << 8)); break;        // lds rm,macl
+				case 4: emit16(0x0028); break;                                  // clrmac
+			}
+			break;
+
+		case 7:
+			switch (random(3))
+			{
+				case 0: emit16(0x2007 | (random_dst_reg() << 8) | (random_src_reg() << 4)); break;    // div0s rm,rn
+				case 1: emit16(0x0019); break;                                                      // div0u
+				case 2: emit16(0x3004 | (random_dst_reg() << 8) | (random_src_reg() << 4)); break;    // div1 rm,rn
+			}
+			break;
+
+		case 8:
+			switch (random(5))
+			{
+				case 0: emit16(0x0008); break;                                  // clrt
+				case 1: emit16(0x0018); break;                                  // sett
+				case 2: emit16(0x0048); break;                                  // clrs
+				case 3: emit16(0x0058); break;                                  // sets
+				case 4: emit16(0x0002 | (random_dst_reg() << 8)); break;        // stc sr,rn
+			}
+			break;
+
+		// loads
+		case 9:
+			switch (random(4))
+			{
+				case 0: emit16(0x6080 | (random_dst_reg() << 8) | shift); break;                      // mov.x @r8,rn
+				case 1: emit16(0x6094 | (random_dst_reg() << 8) | shift); break;                      // mov.x @r9+,rn
+				case 2: emit_index(size); emit16(0x008c | (random_dst_reg() << 8) | shift); break;    // mov.x @(r0,r8),rn
+				case 3: emit16(0x5080 | (random_dst_reg() << 8) | random(16)); break;                 // mov.l @(disp,r8),rn
+			}
+			break;
+
+		case 10:
+			switch (random(4))
+			{
+				case 0: emit16(0x8480 | (shift == 2 ? 0 : shift << 8) | random(16)); break;           // mov.b/w @(disp,r8),r0
+				case 1: emit16(0xc400 | (shift << 8) | random(0x100)); break;                         // mov.x @(disp,gbr),r0
+				case 2: emit16(0x9000 | (random_dst_reg() << 8) | random(0x100)); break;              // mov.w @(disp,pc),rn
+				case 3: emit16(0xd000 | (random_dst_reg() << 8) | random(0x100)); break;              // mov.l @(disp,pc),rn
+			}
+			break;
+
+		case 11:
+			emit16(0xc700 | random(0x100));                                // mova @(disp,pc),r0
+			break;
+
+		// stores
+		case 12:
+			switch (random(3))
+			{
+				case 0: emit16(0x2800 | (random_src_reg() << 4) | shift); break;                      // mov.x rm,@r8
+				case 1: emit16(0x2a04 | (random_src_reg() << 4) | shift); break;                      // mov.x rm,@-r10
+				case 2: emit_index(size); emit16(0x0804 | (random_src_reg() << 4) | shift); break;    // mov.x rm,@(r0,r8)
+			}
+			break;
+
+		case 13:
+			switch (random(3))
+			{
+				case 0: emit16(0x1800 | (random_src_reg() << 4) | random(16)); break;                 // mov.l rm,@(disp,r8)
+				case 1: emit16(0x8080 | (shift == 2 ? 0 : shift << 8) | random(16)); break;           // mov.b/w r0,@(disp,r8)
+				case 2: emit16(0xc000 | (shift << 8) | random(0x100)); break;                         // mov.x r0,@(disp,gbr)
+			}
+			break;
+
+		case 14:
+			switch (random(5))
+			{
+				case 0: emit16(0x481b); break;                                  // tas.b @r8
+				case 1: emit_index(1); emit16(0xcd00 | random(0x100)); break;   // and.b #n,@(r0,gbr)
+				case 2: emit_index(1); emit16(0xcf00 | random(0x100)); break;   // or.b #n,@(r0,gbr)
+				case 3: emit_index(1); emit16(0xce00 | random(0x100)); break;   // xor.b #n,@(r0,gbr)
+				case 4: emit_index(1); emit16(0xcc00 | random(0x100)); break;   // tst.b #n,@(r0,gbr)
+			}
+			break;
+
+		case 15:
+			emit16(0x2f06 | (random_src_reg() << 4));                      // mov.l rm,@-r15
+			emit16(0x60f6 | (random_dst_reg() << 8));                      // mov.l @r15+,rn
+			break;
+
+		// handed back to the interpreter
+		case 16:
+			if (random(2))
+				emit16(0x099f);                                             // mac.l @r9+,@r9+
+			else
+				emit16(0x499f);                                             // mac.w @r9+,@r9+
+			break;
+
+		// floating point
+		case 17:
+		case 18:
+		case 19:
+		{
+			// two register forms, nm
+			static const UINT16 s_fregfreg[] =
+			{
+				0xf000, 0xf001, 0xf002, 0xf004, 0xf005, 0xf00c, 0xf00e  // fadd, fsub, fmul, fcmp/eq, fcmp/gt, fmov, fmac
+			};
+			switch (random(8))
+			{
+				case 0:
+				case 1:
+				case 2:
+					emit16(s_fregfreg[random(ARRAY_LENGTH(s_fregfreg))] | (random_fpreg() << 8) | (random_fpreg() << 4));
+					break;
+				case 3: emit16(0xf04d | (random_fpreg() << 8)); break;          // fneg frn
+				case 4: emit16(0xf05d | (random_fpreg() << 8)); break;          // fabs frn
+				case 5: emit16((random(2) ? 0xf08d : 0xf09d) | (random_fpreg() << 8)); break;    // fldi0/fldi1 frn
+				case 6:
+					emit16(0x405a | (random_src_reg() << 8));                  // lds rm,fpul
+					emit16(0xf02d | (random_fpreg() << 8));                    // float fpul,frn
+					break;
+				case 7:
+					emit16(0xf01d | (random_fpreg() << 8));                    // flds frm,fpul
+					emit16(0x005a | (random_dst_reg() << 8));                  // sts fpul,rn
+					break;
+			}
+			break;
+		}
+
+		case 20:
+			switch (random(6))
+			{
+				case 0: emit16(0xf088 | (random_fpreg() << 8)); break;                      // fmov.s @r8,frn
+				case 1: emit16(0xf80a | (random_fpreg() << 4)); break;                      // fmov.s frm,@r8
+				case 2: emit16(0xf099 | (random_fpreg() << 8)); break;                      // fmov.s @r9+,frn
+				case 3: emit16(0xfa0b | (random_fpreg() << 4)); break;                      // fmov.s frm,@-r10
+				case 4: emit_index(4); emit16(0xf086 | (random_fpreg() << 8)); break;       // fmov.s @(r0,r8),frn
+				case 5: emit_index(4); emit16(0xf807 | (random_fpreg() << 4)); break;       // fmov.s frm,@(r0,r8)
+			}
+			break;
+
+		case 21:
+		{
+			int reg = random_dst_reg();
+			emit16(0x006a | (reg << 8));                                    // sts fpscr,rn
+			emit16(0x406a | (reg << 8));                                    // lds rn,fpscr
+			break;
+		}
+
+		default:
+			emit16(0x0009);                                                 // nop
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_control_insn - emit a branch, a call or
+//  a short loop
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_control_insn()
+{
+	UINT32 patch, patch2, target;
+
+	switch (random(9))
+	{
+		// conditional branch over an instruction
+		case 0:
+		case 1:
+			patch = m_pc;
+			m_pc += 2;
+			emit_simple_insn();
+			patch16(patch, (random(2) ? 0x8900 : 0x8b00) | (((m_pc - (patch + 4)) / 2) & 0xff));     // bt/bf
+			break;
+
+		// delayed conditional branch over an instruction
+		case 2:
+			patch = m_pc;
+			m_pc += 2;
+			emit_alu_insn();
+			emit_simple_insn();
+			patch16(patch, (random(2) ? 0x8d00 : 0x8f00) | (((m_pc - (patch + 4)) / 2) & 0xff));     // bt/s / bf/s
+			break;
+
+		// unconditional branch over an instruction
+		case 3:
+			patch = m_pc;
+			m_pc += 2;
+			emit_alu_insn();
+			emit_simple_insn();
+			patch16(patch, 0xa000 | (((m_pc - (patch + 4)) / 2) & 0xfff));                        // bra
+			break;
+
+		// call to a subroutine placed out of line
+		case 4:
+			patch = m_pc;
+			m_pc += 2;
+			emit_alu_insn();
+			patch2 = m_pc;
+			m_pc += 2;
+			emit16(0x0009);                                                 // nop
+			patch16(patch, 0xb000 | (((m_pc - (patch + 4)) / 2) & 0xfff));  // bsr
+			emit_simple_insn();
+			emit16(0x000b);                                                 // rts
+			emit_alu_insn();
+			patch16(patch2, 0xa000 | (((m_pc - (patch2 + 4)) / 2) & 0xfff));    // bra
+			emit16(0x0009);                                                 // nop
+			break;
+
+		// call through a register to an aligned subroutine
+		case 5:
+			patch = m_pc;
+			m_pc += 2;
+			emit16(0x400b);                                                 // jsr @r0
+			emit16(0x0009);                                                 // nop
+			patch2 = m_pc;
+			m_pc += 2;
+			emit16(0x0009);                                                 // nop
+			while (m_pc & 3)
+				emit16(0x0009);                                             // nop
+			patch16(patch, 0xc700 | ((m_pc - ((patch + 4) & ~3)) / 4));    // mova @(sub,pc),r0
+			emit_simple_insn();
+			emit16(0x000b);                                                 // rts
+			emit16(0x0009);                                                 // nop
+			patch16(patch2, 0xa000 | (((m_pc - (patch2 + 4)) / 2) & 0xfff));    // bra
+			emit16(0x0009);                                                 // nop
+			break;
+
+		// jump through a register over an instruction
+		case 6:
+			patch = m_pc;
+			m_pc += 2;
+			emit16(0x402b);                                                 // jmp @r0
+			emit16(0x0009);                                                 // nop
+			emit_simple_insn();
+			while (m_pc & 3)
+				emit16(0x0009);                                             // nop
+			patch16(patch, 0xc700 | ((m_pc - ((patch + 4) & ~3)) / 4));    // mova @(target,pc),r0
+			break;
+
+		// PC relative jump or call through a register
+		case 7:
+		{
+			int reg = 1 + random(7);
+			patch = m_pc;
+			m_pc += 2;
+			if (random(2))
+			{
+				emit16(0x0023 | (reg << 8));                                // braf rn
+				emit16(0x0009);                                             // nop
+				emit_simple_insn();
+				target = m_pc;
+			}
+			else
+			{
+				emit16(0x0003 | (reg << 8));                                // bsrf rn
+				emit16(0x0009);                                             // nop
+				patch2 = m_pc;
+				m_pc += 2;
+				emit16(0x0009);                                             // nop
+				target = m_pc;
+				emit_simple_insn();
+				emit16(0x000b);                                             // rts
+				emit16(0x0009);                                             // nop
+				patch16(patch2, 0xa000 | (((m_pc - (patch2 + 4)) / 2) & 0xfff));    // bra
+				emit16(0x0009);                                             // nop
+			}
+			patch16(patch, 0xe000 | (reg << 8) | ((target - (patch + 6)) & 0xff));  // mov #n,rn
+			break;
+		}
+
+		// short counted loop
+		case 8:
+		{
+			int count = random_dst_reg();
+			int reg;
+			do
+				reg = random_dst_reg();
+			while (reg == count);
+			emit16(0xe000 | (count << 8) | (1 + random(4)));               // mov #n,rn
+			target = m_pc;
+			emit16(0x7000 | (reg << 8) | random(0x100));                   // add #n,rm
+			emit16(0x4010 | (count << 8));                                  // dt rn
+			emit16(0x8b00 | ((INT32(target - (m_pc + 4)) / 2) & 0xff));   // bf loop
+			break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_checkpoint - emit code to store all of
+//  the registers for a test case
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_checkpoint(int index)
+{
+	UINT32 base = CHECKPOINT_BASE + index * CHECKPOINT_SIZE;
+
+	// R1-R15 relative to R0, then R0 itself by way of the GBR scratch area
+	emit16(0xc200);                                                     // mov.l r0,@(0,gbr)
+	emit_table(&base, 1);
+	emit16(0x6002);                                                     // mov.l @r0,r0
+	for (int reg = 1; reg < 16; reg++)
+		emit16(0x1000 | (reg << 4) | reg);                              // mov.l rm,@(disp,r0)
+	emit16(0x6103);                                                     // mov r0,r1
+	emit16(0xc600);                                                     // mov.l @(0,gbr),r0
+	emit16(0x2102);                                                     // mov.l r0,@r1
+
+	// the rest downwards from the end of the block
+	emit16(0x714c);                                                     // add #76,r1
+	emit16(0x714c);                                                     // add #76,r1
+	for (int reg = 15; reg >= 0; reg--)
+		emit16(0xf10b | (reg << 4));                                    // fmov.s frm,@-r1
+	emit16(0x4162);                                                     // sts.l fpscr,@-r1
+	emit16(0x4152);                                                     // sts.l fpul,@-r1
+	emit16(0x4122);                                                     // sts.l pr,@-r1
+	emit16(0x4112);                                                     // sts.l macl,@-r1
+	emit16(0x4102);                                                     // sts.l mach,@-r1
+	emit16(0x4103);                                                     // stc.l sr,@-r1
+}
+
+
+//-------------------------------------------------
+//  emit_test_case - emit one random instruction
+//  stream and its checkpoint
+//-------------------------------------------------
+
+void test_sh4drc_state::emit_test_case(int index)
+{
+	// registers loaded from the table, in table order
+	static const int s_regs[] = { 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14 };
+	UINT32 values[2 + 16 + ARRAY_LENGTH(s_regs) + 1];
+	int count = 0;
+
+	m_case_pc.push_back(m_pc);
+
+	// start from random flags and registers
+	emit16(random(2) ? 0x0018 : 0x0008);                                // sett/clrt
+	emit16(random(2) ? 0x0058 : 0x0048);                                // sets/clrs
+	values[count++] = random_value();
+	values[count++] = random_value();
+	for (int reg = 0; reg < 16; reg++)
+		values[count++] = random_float();
+	for (int reg : s_regs)
+	{
+		if (reg == 9)
+			values[count++] = DATA_BASE + 0x1000 + random(0x100) * 4;
+		else if (reg == 10)
+			values[count++] = DATA_BASE + 0xe000 + random(0x100) * 4;
+		else
+			values[count++] = random_value();
+	}
+	values[count++] = random_value();
+	emit_table(values, count);
+
+	emit16(0x4006);                                                     // lds.l @r0+,mach
+	emit16(0x4016);                                                     // lds.l @r0+,macl
+	for (int reg = 0; reg < 16; reg++)
+		emit16(0xf009 | (reg << 8));                                    // fmov.s @r0+,frn
+	for (int reg : s_regs)
+		emit16(0x6006 | (reg << 8));                                    // mov.l @r0+,rn
+	emit16(0x6002);                                                     // mov.l @r0,r0
+
+	for (int insn = 0; insn < TEST_CASE_LENGTH; insn++)
+	{
+		if (random(6) == 0)
+			emit_control_insn();
+		else
+			emit_simple_insn();
+	}
+	emit_checkpoint(index);
+
+	if (m_pc > CODE_END - 0x1000)
+		fatalerror("testsh4: generated program is too large\n");
+}
+
+
+//-------------------------------------------------
+//  build_program - generate the whole program
+//-------------------------------------------------
+
+void test_sh4drc_state::build_program()
+{
+	m_image.assign(RAM_SIZE, 0);
+	m_seed = TEST_SEED;
+
+	// set up the machine state and enter the test cases
+	const UINT32 boot[] = { INITIAL_SR, SCRATCH_BASE, STACK_TOP, DATA_BASE + DATA_SIZE / 2, CODE_BASE };
+	m_pc = 0;
+	emit_table(boot, ARRAY_LENGTH(boot));
+	emit16(0x6106);                                                     // mov.l @r0+,r1
+	emit16(0x410e);                                                     // ldc r1,sr
+	emit16(0x6106);                                                     // mov.l @r0+,r1
+	emit16(0x411e);                                                     // ldc r1,gbr
+	emit16(0x6f06);                                                     // mov.l @r0+,r15
+	emit16(0x6806);                                                     // mov.l @r0+,r8
+	emit16(0x6102);                                                     // mov.l @r0,r1
+	emit16(0x412b);                                                     // jmp @r1
+	emit16(0x0009);                                                     // nop
+
+	// any exception is a failure
+	m_pc = GENERAL_VECTOR;
+	emit_done(0xdeadbeef, FAIL_ADDRESS);
+	m_pc = TLBMISS_VECTOR;
+	emit_done(0xdeadbeef, FAIL_ADDRESS);
+	m_pc = IRQ_VECTOR;
+	emit_done(0xdeadbeef, FAIL_ADDRESS);
+
+	// random data
+	for (int offs = 0; offs < DATA_SIZE; offs++)
+		m_image[DATA_BASE + offs] = random(256);
+
+	// the test cases
+	m_pc = CODE_BASE;
+	for (int index = 0; index < TEST_CASES; index++)
+		emit_test_case(index);
+
+	// done
+	emit_done(1, DONE_ADDRESS);
+}
+
+
+void test_sh4drc_state::machine_start()
+{
+	build_program();
+	start_comparison();
+}
+
+static ADDRESS_MAP_START( drc_map, AS_PROGRAM, 64, test_sh4drc_state )
+	AM_RANGE(0x00000000, 0x003fffff) AM_RAM
+ADDRESS_MAP_END
+
+static ADDRESS_MAP_START( interp_map, AS_PROGRAM, 64, test_sh4drc_state )
+	AM_RANGE(0x00000000, 0x003fffff) AM_RAM
+ADDRESS_MAP_END
+
+static MACHINE_CONFIG_START( test_sh4drc, test_sh4drc_state )
+	MCFG_CPU_ADD("drc", SH4LE, 200000000)
+	MCFG_SH4_MD0(1)
+	MCFG_SH4_MD1(0)
+	MCFG_SH4_MD2(1)
+	MCFG_SH4_MD3(0)
+	MCFG_SH4_MD4(0)
+	MCFG_SH4_MD5(1)
+	MCFG_SH4_MD6(0)
+	MCFG_SH4_MD7(1)
+	MCFG_SH4_MD8(0)
+	MCFG_SH4_CLOCK(200000000)
+	MCFG_CPU_PROGRAM_MAP(drc_map)
+	MCFG_SH4_ALLOW_RECOMPILER()
+
+	MCFG_CPU_ADD("interp", SH4LE, 200000000)
+	MCFG_SH4_MD0(1)
+	MCFG_SH4_MD1(0)
+	MCFG_SH4_MD2(1)
+	MCFG_SH4_MD3(0)
+	MCFG_SH4_MD4(0)
+	MCFG_SH4_MD5(1)
+	MCFG_SH4_MD6(0)
+	MCFG_SH4_MD7(1)
+	MCFG_SH4_MD8(0)
+	MCFG_SH4_CLOCK(200000000)
+	MCFG_CPU_PROGRAM_MAP(interp_map)
+	MCFG_SH4_FORCE_INTERPRETER()
+MACHINE_CONFIG_END
+
+ROM_START( testsh4 )
+ROM_END
+
+COMP( 2016, testsh4,   0,        0,      test_sh4drc, 0, driver_device, 0,      "MAMEdev",   "SH-4 recompiler comparison test", MACHINE_NO_SOUND_HW )
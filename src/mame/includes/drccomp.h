@@ -0,0 +1,69 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drccomp.h
+
+    Shared harness for the recompiler comparison tests.  Two CPUs of the
+    same type, tagged "drc" and "interp", run the same program image from
+    their own RAM at the bottom of their program space.  The program
+    stores a block of registers at a checkpoint after each test case,
+    writes a nonzero value to the done address once it has finished, and
+    writes a nonzero value to the fail address if it took an unexpected
+    exception.  Once both CPUs are done their memory is compared, and any
+    difference fails the test.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCCOMP_H__
+#define __DRCCOMP_H__
+
+
+// memory layout shared by every comparison test
+#define DRCCOMP_RAM_SIZE            0x400000
+#define DRCCOMP_CHECKPOINT_BASE     0x300000
+#define DRCCOMP_DONE_ADDRESS        0x3ffff0
+#define DRCCOMP_FAIL_ADDRESS        0x3ffff4
+
+
+class drc_compare_state : public driver_device
+{
+public:
+	drc_compare_state(const machine_config &mconfig, device_type type, const char *tag, const char *cpuname, int cases, int checkpoint_size, const char *const *regnames, int regcount)
+		: driver_device(mconfig, type, tag),
+		m_drccpu(*this, "drc"),
+		m_interpcpu(*this, "interp"),
+		m_cpuname(cpuname),
+		m_cases(cases),
+		m_checkpoint_size(checkpoint_size),
+		m_regnames(regnames),
+		m_regcount(regcount) { }
+
+protected:
+	virtual void device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr) override;
+
+	// copy the image to both CPUs and start waiting for them to finish
+	void start_comparison();
+
+	required_device<cpu_device> m_drccpu;
+	required_device<cpu_device> m_interpcpu;
+
+	// the program image, and the address each test case starts at
+	std::vector<UINT8> m_image;
+	std::vector<UINT32> m_case_pc;
+
+private:
+	void check_results();
+
+	const char *m_cpuname;
+	int m_cases;
+	int m_checkpoint_size;
+	const char *const *m_regnames;
+	int m_regcount;
+	emu_timer *m_check_timer;
+	int m_checks;
+};
+
+#endif  /* __DRCCOMP_H__ */
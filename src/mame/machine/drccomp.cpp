@@ -0,0 +1,91 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drccomp.cpp
+
+    Shared harness for the recompiler comparison tests.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "includes/drccomp.h"
+
+
+//-------------------------------------------------
+//  start_comparison - give both CPUs identical
+//  copies of the program image and check every
+//  10ms whether they have finished; the image is
+//  written a byte at a time so that the bus width
+//  and byte order are the CPU's business
+//-------------------------------------------------
+
+void drc_compare_state::start_comparison()
+{
+	address_space &drc = m_drccpu->space(AS_PROGRAM);
+	address_space &interp = m_interpcpu->space(AS_PROGRAM);
+
+	for (offs_t address = 0; address < DRCCOMP_RAM_SIZE; address++)
+	{
+		drc.write_byte(address, m_image[address]);
+		interp.write_byte(address, m_image[address]);
+	}
+
+	m_checks = 0;
+	m_check_timer = timer_alloc(0);
+	m_check_timer->adjust(attotime::from_msec(10), 0, attotime::from_msec(10));
+}
+
+
+//-------------------------------------------------
+//  device_timer - wait for both CPUs to finish
+//-------------------------------------------------
+
+void drc_compare_state::device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr)
+{
+	if (m_drccpu->space(AS_PROGRAM).read_dword(DRCCOMP_DONE_ADDRESS) != 0 && m_interpcpu->space(AS_PROGRAM).read_dword(DRCCOMP_DONE_ADDRESS) != 0)
+	{
+		m_check_timer->adjust(attotime::never);
+		check_results();
+	}
+	else if (++m_checks >= 1000)
+		throw emu_fatalerror("%s recompiler test did not finish", m_cpuname);
+}
+
+
+//-------------------------------------------------
+//  check_results - compare the memory of the two
+//  CPUs once both have finished
+//-------------------------------------------------
+
+void drc_compare_state::check_results()
+{
+	address_space &drc = m_drccpu->space(AS_PROGRAM);
+	address_space &interp = m_interpcpu->space(AS_PROGRAM);
+	int mismatches = 0;
+
+	for (offs_t address = 0; address < DRCCOMP_RAM_SIZE; address += 4)
+	{
+		UINT32 drcdata = drc.read_dword(address);
+		UINT32 interpdata = interp.read_dword(address);
+		if (drcdata != interpdata)
+		{
+			if (mismatches++ >= 20)
+				continue;
+			int index = int(address - DRCCOMP_CHECKPOINT_BASE) / m_checkpoint_size;
+			int slot = int(address - DRCCOMP_CHECKPOINT_BASE) % m_checkpoint_size / 4;
+			if (address >= DRCCOMP_CHECKPOINT_BASE && index < m_cases && slot < m_regcount)
+				osd_printf_error("Test case %d at %08X: %s is %08X with the recompiler, %08X with the interpreter\n",
+						index, m_case_pc[index], m_regnames[slot], drcdata, interpdata);
+			else
+				osd_printf_error("Memory at %08X is %08X with the recompiler, %08X with the interpreter\n", address, drcdata, interpdata);
+		}
+	}
+
+	osd_printf_info("%d %s test cases, %d mismatches\n", m_cases, m_cpuname, mismatches);
+	if (drc.read_dword(DRCCOMP_FAIL_ADDRESS) != 0 || interp.read_dword(DRCCOMP_FAIL_ADDRESS) != 0)
+		throw emu_fatalerror("%s recompiler test took an unexpected exception", m_cpuname);
+	if (mismatches != 0)
+		throw emu_fatalerror("%s recompiler test failed", m_cpuname);
+	machine().schedule_exit();
+}
@@ -29,7 +29,7 @@
 
 #include "emu.h"
 #include "includes/suna8.h"
-#include "drawgfxm.h"
+#include "drawgfxt.h"
 
 /***************************************************************************
     For Debug: there's no tilemap, just sprites.
@@ -176,31 +176,31 @@ VIDEO_START_MEMBER(suna8_state,suna8_starfigh)          { suna8_vh_start_common(
 
 ***************************************************************************/
 
-#define PIXEL_OP_REBASE_TRANSPEN_PRIORITY_MASK(DEST, PRIORITY, SOURCE)              \
-do                                                                                  \
-{                                                                                   \
-	UINT32 srcdata = (SOURCE);                                                      \
-	if (srcdata != trans_pen)                                                       \
-	{                                                                               \
-		if ((PRIORITY) == 0)                                                        \
-			(DEST) = color + srcdata;                                               \
-	}                                                                               \
-}                                                                                   \
-while (0)
-
-class mygfx_element : public gfx_element
+// draw every pen but trans_pen, only where the priority bitmap is clear
+class rebase_transpen_priority_mask
 {
 public:
-	void prio_mask_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
-			UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,
-			bitmap_ind8 &priority, UINT32 trans_pen)
+	rebase_transpen_priority_mask(UINT32 color, UINT32 trans_pen) : m_color(color), m_trans_pen(trans_pen) { }
+
+	void operator()(UINT16 &dest, UINT8 &pri, UINT32 pen) const
 	{
-		color = colorbase() + granularity() * (color % colors());
-		code %= elements();
-		DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY_MASK, UINT8);
+		if (pen != m_trans_pen && pri == 0)
+			dest = m_color + pen;
 	}
+
+	UINT32 m_color;
+	UINT32 m_trans_pen;
 };
 
+static void prio_mask_transpen(gfx_element &gfx, bitmap_ind16 &dest, const rectangle &cliprect,
+		UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,
+		bitmap_ind8 &priority, UINT32 trans_pen)
+{
+	color = gfx.colorbase() + gfx.granularity() * (color % gfx.colors());
+	code %= gfx.elements();
+	drawgfx_core<UINT8>(dest, cliprect, gfx, code, flipx, flipy, destx, desty, priority, rebase_transpen_priority_mask(color, trans_pen));
+}
+
 /***************************************************************************
 
                           [ Sprites Format ]
@@ -434,7 +434,7 @@ void suna8_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap, cons
 				int color = (((attr >> 2) & 0xf) ^ colorbank) + 0x10 * m_palettebank;    // player2 in hardhea2 and sparkman
 
 				if (read_mask)
-					((mygfx_element*)(m_gfxdecode->gfx(which)))->prio_mask_transpen(bitmap, cliprect,
+					prio_mask_transpen(*m_gfxdecode->gfx(which), bitmap, cliprect,
 								code, color, tile_flipx, tile_flipy, sx, sy, screen.priority(), 0xf);
 				else
 					m_gfxdecode->gfx(which)->transpen(bitmap, cliprect,
@@ -19,6 +19,7 @@
 #endif
 #endif
 #include <mutex>
+#include <deque>
 
 // MAME headers
 #include "osdcore.h"
@@ -48,9 +49,14 @@ typedef void *PVOID;
 
 #define ENV_PROCESSORS               "OSDPROCESSORS"
 #define ENV_WORKQUEUEMAXTHREADS      "OSDWORKQUEUEMAXTHREADS"
+#define ENV_WORKQUEUEMODE            "OSDWORKQUEUEMODE"
 
 #define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
 
+// bounds for the adaptive spin of work-stealing threads before they park
+#define STEAL_SPIN_MIN          (osd_ticks_per_second() / 1000000)
+#define STEAL_SPIN_MAX          (osd_ticks_per_second() / 2000)
+
 //============================================================
 //  MACROS
 //============================================================
@@ -98,8 +104,14 @@ struct work_thread_info
 	osd_event *         wakeevent;      // wake event for the thread
 	volatile INT32      active;         // are we actively processing work?
 
+	// work-stealing mode only
+	std::mutex *        dequelock;      // lock protecting this thread's deque
+	std::deque<osd_work_item *> *deque; // items assigned to this thread
+	osd_ticks_t         spinlimit;      // how long to spin for more work before parking
+
 #if KEEP_STATISTICS
 	INT32               itemsdone;
+	INT32               itemsstolen;
 	osd_ticks_t         actruntime;
 	osd_ticks_t         runtime;
 	osd_ticks_t         spintime;
@@ -123,6 +135,11 @@ struct osd_work_queue
 	work_thread_info *  thread;         // array of thread information
 	osd_event   *       doneevent;      // event signalled when work is complete
 
+	// work-stealing mode only
+	int                 stealing;       // use per-thread deques with work stealing?
+	volatile INT32      pending;        // items sitting in deques, not yet started
+	volatile INT32      nextthread;     // rotating first thread for distributing items
+
 #if KEEP_STATISTICS
 	volatile INT32      itemsqueued;    // total items queued
 	volatile INT32      setevents;      // number of times we called SetEvent
@@ -158,6 +175,11 @@ static int effective_num_processors(void);
 static void * worker_thread_entry(void *param);
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
 static bool queue_has_list_items(osd_work_queue *queue);
+static bool use_work_stealing(void);
+static void * steal_thread_entry(void *param);
+static void steal_thread_process(osd_work_queue *queue, work_thread_info *thread);
+static osd_work_item *steal_next_item(osd_work_queue *queue, work_thread_info *thread);
+static void steal_execute_item(osd_work_queue *queue, work_thread_info *thread, osd_work_item *item);
 
 
 //============================================================
@@ -182,6 +204,7 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	// initialize basic queue members
 	queue->tailptr = (osd_work_item **)&queue->list;
 	queue->flags = flags;
+	queue->stealing = use_work_stealing();
 
 	// allocate events for the queue
 	queue->doneevent = osd_event_alloc(TRUE, TRUE);     // manual reset, signalled
@@ -222,6 +245,19 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 		goto error;
 	memset(queue->thread, 0, allocthreadnum * sizeof(queue->thread[0]));
 
+	// in work-stealing mode, every thread (including the caller of a multi queue) owns a deque
+	if (queue->stealing)
+	{
+		for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
+		{
+			work_thread_info *thread = &queue->thread[threadnum];
+			thread->queue = queue;
+			thread->dequelock = new std::mutex();
+			thread->deque = new std::deque<osd_work_item *>();
+			thread->spinlimit = STEAL_SPIN_MIN;
+		}
+	}
+
 	// iterate over threads
 	for (threadnum = 0; threadnum < queue->threads; threadnum++)
 	{
@@ -236,7 +272,7 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 			goto error;
 
 		// create the thread
-		thread->handle = osd_thread_create(worker_thread_entry, thread);
+		thread->handle = osd_thread_create(queue->stealing ? steal_thread_entry : worker_thread_entry, thread);
 		if (thread->handle == NULL)
 			goto error;
 
@@ -294,7 +330,10 @@ int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 		end_timing(thread->waittime);
 
 		// process what we can as a worker thread
-		worker_thread_process(queue, thread);
+		if (queue->stealing)
+			steal_thread_process(queue, thread);
+		else
+			worker_thread_process(queue, thread);
 
 		// if we're a high frequency queue, spin until done
 		if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->items != 0)
@@ -364,20 +403,21 @@ void osd_work_queue_free(osd_work_queue *queue)
 				osd_event_free(thread->wakeevent);
 		}
 
-#if KEEP_STATISTICS
 		int allocthreadnum;
 		if (queue->flags & WORK_QUEUE_FLAG_MULTI)
 			allocthreadnum = queue->threads + 1;
 		else
 			allocthreadnum = queue->threads;
 
+#if KEEP_STATISTICS
 		// output per-thread statistics
+		printf("Work queue mode: %s\n", queue->stealing ? "stealing" : "shared");
 		for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
 		{
 			work_thread_info *thread = &queue->thread[threadnum];
 			osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
-			printf("Thread %d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
-					threadnum, thread->itemsdone,
+			printf("Thread %d:  items=%9d stolen=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
+					threadnum, thread->itemsdone, thread->itemsstolen,
 					(double)thread->runtime * 100.0 / (double)total,
 					(double)thread->actruntime * 100.0 / (double)total,
 					(double)thread->spintime * 100.0 / (double)total,
@@ -385,6 +425,23 @@ void osd_work_queue_free(osd_work_queue *queue)
 					(UINT32) total);
 		}
 #endif
+
+		// free the per-thread deques, along with anything left in them
+		for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
+		{
+			work_thread_info *thread = &queue->thread[threadnum];
+			if (thread->deque != NULL)
+			{
+				for (osd_work_item *item : *thread->deque)
+				{
+					if (item->event != NULL)
+						osd_event_free(item->event);
+					osd_free(item);
+				}
+				delete thread->deque;
+			}
+			delete thread->dequelock;
+		}
 	}
 
 	// free the list
@@ -483,6 +540,53 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		parambase = (UINT8 *)parambase + paramstep;
 	}
 
+	// in work-stealing mode, hand the items out to the per-thread deques instead
+	if (queue->stealing)
+	{
+		// with no threads, just do the work now
+		if (queue->threads == 0)
+		{
+			atomic_add32(&queue->items, numitems);
+			while (itemlist != NULL)
+			{
+				osd_work_item *item = itemlist;
+				itemlist = item->next;
+				steal_execute_item(queue, &queue->thread[0], item);
+			}
+			return (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? NULL : lastitem;
+		}
+
+		// spread the items in contiguous runs across the worker deques, starting at a rotating thread
+		int threads = queue->threads;
+		int first = (UINT32)atomic_increment32(&queue->nextthread) % threads;
+		atomic_add32(&queue->items, numitems);
+		itemnum = 0;
+		while (itemlist != NULL)
+		{
+			osd_work_item *item = itemlist;
+			itemlist = item->next;
+			work_thread_info *thread = &queue->thread[(first + (INT64)itemnum++ * threads / numitems) % threads];
+			thread->dequelock->lock();
+			thread->deque->push_back(item);
+			thread->dequelock->unlock();
+		}
+		atomic_add32(&queue->pending, numitems);
+		add_to_stat(&queue->itemsqueued, numitems);
+
+		// wake parked threads; they will steal whatever was not handed to them
+		for (int threadnum = 0; threadnum < threads && numitems > 0; threadnum++)
+		{
+			work_thread_info *thread = &queue->thread[(first + threadnum) % threads];
+			if (!thread->active)
+			{
+				osd_event_set(thread->wakeevent);
+				add_to_stat(&queue->setevents, 1);
+				numitems--;
+			}
+		}
+		return (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? NULL : lastitem;
+	}
+
 	// enqueue the whole thing within the critical section
 	{
 		queue->lock->lock();
@@ -598,6 +702,18 @@ void osd_work_item_release(osd_work_item *item)
 }
 
 
+//============================================================
+//  use_work_stealing
+//============================================================
+
+static bool use_work_stealing(void)
+{
+	// the OSDWORKQUEUEMODE environment variable selects the backend: "shared" (default) or "steal"
+	const char *mode = osd_getenv(ENV_WORKQUEUEMODE);
+	return (mode != NULL && strcmp(mode, "steal") == 0);
+}
+
+
 //============================================================
 //  effective_num_processors
 //============================================================
@@ -789,3 +905,162 @@ bool queue_has_list_items(osd_work_queue *queue)
 	queue->lock->unlock();
 	return has_list_items;
 }
+
+
+//============================================================
+//  steal_thread_entry
+//============================================================
+
+static void *steal_thread_entry(void *param)
+{
+	work_thread_info *thread = (work_thread_info *)param;
+	osd_work_queue *queue = thread->queue;
+
+#if defined(SDLMAME_MACOSX)
+	void *arp = NewAutoreleasePool();
+#endif
+
+	atomic_exchange32(&thread->active, TRUE);
+	atomic_increment32(&queue->livethreads);
+
+	// loop until we exit
+	while (!queue->exiting)
+	{
+		// process everything we can find, our own or stolen
+		steal_thread_process(queue, thread);
+
+		// spin briefly in case more work shows up; grow the spin when it pays off, shrink it when not
+		begin_timing(thread->spintime);
+		osd_ticks_t stopspin = osd_ticks() + thread->spinlimit;
+		while (queue->pending == 0 && !queue->exiting && osd_ticks() < stopspin)
+			osd_yield_processor();
+		end_timing(thread->spintime);
+		if (queue->pending != 0)
+		{
+			thread->spinlimit = MIN(thread->spinlimit * 2, STEAL_SPIN_MAX);
+			add_to_stat(&queue->spinloops, 1);
+			continue;
+		}
+		thread->spinlimit = MAX(thread->spinlimit / 2, STEAL_SPIN_MIN);
+
+		// park; re-check after going inactive so that we can't miss a wakeup
+		atomic_exchange32(&thread->active, FALSE);
+		atomic_decrement32(&queue->livethreads);
+		if (queue->pending == 0 && !queue->exiting)
+		{
+			begin_timing(thread->waittime);
+			osd_event_wait(thread->wakeevent, OSD_EVENT_WAIT_INFINITE);
+			end_timing(thread->waittime);
+		}
+		atomic_exchange32(&thread->active, TRUE);
+		atomic_increment32(&queue->livethreads);
+	}
+
+	atomic_exchange32(&thread->active, FALSE);
+	atomic_decrement32(&queue->livethreads);
+
+#if defined(SDLMAME_MACOSX)
+	ReleaseAutoreleasePool(arp);
+#endif
+
+	return NULL;
+}
+
+
+//============================================================
+//  steal_thread_process
+//============================================================
+
+static void steal_thread_process(osd_work_queue *queue, work_thread_info *thread)
+{
+	begin_timing(thread->runtime);
+
+	osd_work_item *item;
+	while ((item = steal_next_item(queue, thread)) != NULL)
+		steal_execute_item(queue, thread, item);
+
+	end_timing(thread->runtime);
+}
+
+
+//============================================================
+//  steal_next_item
+//============================================================
+
+static osd_work_item *steal_next_item(osd_work_queue *queue, work_thread_info *thread)
+{
+	int threadnum = thread - queue->thread;
+	int slots = (queue->flags & WORK_QUEUE_FLAG_MULTI) ? queue->threads + 1 : queue->threads;
+	osd_work_item *item = NULL;
+
+	// nothing anywhere?
+	if (queue->pending == 0)
+		return NULL;
+
+	// take from the front of our own deque first
+	thread->dequelock->lock();
+	if (!thread->deque->empty())
+	{
+		item = thread->deque->front();
+		thread->deque->pop_front();
+	}
+	thread->dequelock->unlock();
+
+	// otherwise steal from the back of someone else's, starting with our neighbour
+	for (int victimnum = 1; item == NULL && victimnum < slots; victimnum++)
+	{
+		work_thread_info *victim = &queue->thread[(threadnum + victimnum) % slots];
+		victim->dequelock->lock();
+		if (!victim->deque->empty())
+		{
+			item = victim->deque->back();
+			victim->deque->pop_back();
+		}
+		victim->dequelock->unlock();
+		if (item != NULL)
+			add_to_stat(&thread->itemsstolen, 1);
+	}
+
+	if (item != NULL)
+		atomic_decrement32(&queue->pending);
+	return item;
+}
+
+
+//============================================================
+//  steal_execute_item
+//============================================================
+
+static void steal_execute_item(osd_work_queue *queue, work_thread_info *thread, osd_work_item *item)
+{
+	// call the callback and stash the result
+	begin_timing(thread->actruntime);
+	item->result = (*item->callback)(item->param, thread - queue->thread);
+	end_timing(thread->actruntime);
+
+	atomic_exchange32(&item->done, TRUE);
+	add_to_stat(&thread->itemsdone, 1);
+
+	// if it's an auto-release item, release it
+	if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
+		osd_work_item_release(item);
+
+	// set the result and signal the event
+	else
+	{
+		queue->lock->lock();
+		if (item->event != NULL)
+		{
+			osd_event_set(item->event);
+			add_to_stat(&item->queue->setevents, 1);
+		}
+		queue->lock->unlock();
+	}
+
+	// only count the item as finished once it is completely out of our hands
+	if (atomic_decrement32(&queue->items) == 0 && queue->waiting)
+	{
+		osd_event_set(queue->doneevent);
+		add_to_stat(&queue->setevents, 1);
+	}
+}